@@ -0,0 +1,45 @@
+/*
+ ============================================================================
+ Name        : FaultInject_Hooks.h
+ Module Name : FaultInject
+ Author      : Ahmed Ali
+ Date        : 22 Sept. 2024
+ Description : Fault injection hooks of the MCAL, HAL and application paths. The
+               FaultInject module of the Control layer is only included when
+               FAULT_INJECTION is 1, so the drivers do not depend on it otherwise.
+ ============================================================================
+ */
+
+#ifndef FAULT_INJECT_HOOKS_H_
+#define FAULT_INJECT_HOOKS_H_
+
+#include "Std_Types.h"
+
+/*
+ * Set to 1 (here or as a predefined symbol of the build) to install the injection hooks in
+ * ADC_ReadChannel, LM35_getTemperature, the button pin reads and the GPIO handlers. When 0 the hooks
+ * compile to the value they are given and the module is not needed.
+ */
+#ifndef FAULT_INJECTION
+#define FAULT_INJECTION                 0
+#endif
+
+#if (FAULT_INJECTION == 1)
+#include "FaultInject.h"
+
+#define FAULT_INJECT_ADC(ucChannel, usValue)                FaultInject_Adc((ucChannel), (usValue))
+#define FAULT_INJECT_TEMPERATURE(ucChannel, ucValue)        FaultInject_Temperature((ucChannel), (ucValue))
+#define FAULT_INJECT_BUTTON_LEVEL(ucButton, ucLevel)        FaultInject_ButtonLevel((ucButton), (ucLevel))
+#define FAULT_INJECT_BUTTON_EDGE(ucButton)                  FaultInject_ButtonEdge(ucButton)
+#define FAULT_INJECT_BUTTON_EVENT(ucButton, ulTimeStamp)    FaultInject_ButtonEvent((ucButton), (ulTimeStamp))
+#define FAULT_INJECT_DETECTED(ucChannel, ulTimeStamp)       FaultInject_Detected((ucChannel), (ulTimeStamp))
+#else
+#define FAULT_INJECT_ADC(ucChannel, usValue)                (usValue)
+#define FAULT_INJECT_TEMPERATURE(ucChannel, ucValue)        (ucValue)
+#define FAULT_INJECT_BUTTON_LEVEL(ucButton, ucLevel)        (ucLevel)
+#define FAULT_INJECT_BUTTON_EDGE(ucButton)                  FALSE
+#define FAULT_INJECT_BUTTON_EVENT(ucButton, ulTimeStamp)
+#define FAULT_INJECT_DETECTED(ucChannel, ulTimeStamp)
+#endif
+
+#endif /* FAULT_INJECT_HOOKS_H_ */
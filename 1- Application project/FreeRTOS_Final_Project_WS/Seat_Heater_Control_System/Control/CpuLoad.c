@@ -0,0 +1,282 @@
+/*
+ ============================================================================
+ Name        : CpuLoad.c
+ Module Name : CpuLoad
+ Author      : Ahmed Ali
+ Date        : 22 Sept. 2024
+ Description : Source file for the sliding window CPU load measurement from the idle hook
+ ============================================================================
+ */
+
+#include "CpuLoad.h"
+
+#ifdef CPU_LOAD_HOST
+/* Host build of the CPU load test: single threaded, the host gives the cycle count */
+extern uint32 CpuLoad_HostCycles(void);
+#define CPU_LOAD_CYCLES()               CpuLoad_HostCycles()
+#define CPU_LOAD_LOCK(ulSaved)          ((ulSaved) = 0)
+#define CPU_LOAD_UNLOCK(ulSaved)        ((void) (ulSaved))
+#else
+#include "FreeRTOS.h"
+#include "tm4c123gh6pm_registers.h"
+/* Only raises BASEPRI, so valid from the tasks and the ISRs */
+#define CPU_LOAD_CYCLES()               DWT_CYCCNT_REG
+#define CPU_LOAD_LOCK(ulSaved)          (ulSaved) = portSET_INTERRUPT_MASK_FROM_ISR()
+#define CPU_LOAD_UNLOCK(ulSaved)        portCLEAR_INTERRUPT_MASK_FROM_ISR(ulSaved)
+#endif
+
+/* Cycles of an idle loop before it is timed */
+#define CPU_LOAD_NOT_TIMED              0xFFFFFFFFUL
+
+/* A complete second: its cycles, the turns of the idle loop and the ISR cycles */
+typedef struct
+{
+    uint32 ulCycles;
+    uint32 ulLoops;
+    uint32 ulIsr;
+} CpuLoad_SecondType;
+
+/*******************************************************************************
+ *                              Global Variables                               *
+ *******************************************************************************/
+
+/* Free running counts, only differences are used */
+static uint32 CpuLoad_ulIdleLoops;
+static uint32 CpuLoad_ulIsrCycles;
+
+static uint32 CpuLoad_ulIsrStart;
+static uint8 CpuLoad_ucIsrNesting;
+
+/* Counts at the last tick and at the start of the current second */
+static uint32 CpuLoad_ulTickCycles;
+static uint32 CpuLoad_ulTickLoops;
+static uint32 CpuLoad_ulTickIsr;
+static uint32 CpuLoad_ulSecondCycles;
+static uint32 CpuLoad_ulSecondLoops;
+static uint32 CpuLoad_ulSecondIsr;
+static uint32 CpuLoad_ulTicks;
+static uint32 CpuLoad_ulTicksPerSecond = 1;
+static boolean CpuLoad_bStarted;
+
+/* Cycles of an idle loop, in units of 2^-CPU_LOAD_LOOP_SHIFT cycles: the least of a tick picks the idle ticks */
+static uint32 CpuLoad_ulTickLeast = CPU_LOAD_NOT_TIMED;
+static uint32 CpuLoad_ulLoopCycles = CPU_LOAD_NOT_TIMED;
+
+/* Idle ticks summed for the next timing of the idle loop */
+static uint64 CpuLoad_ullIdleOutside;
+static uint32 CpuLoad_ulIdleTurns;
+static uint32 CpuLoad_ulIdleTicks;
+
+static CpuLoad_SecondType CpuLoad_axSecond[CPU_LOAD_MAX_SECONDS];
+static uint8 CpuLoad_ucHead; /* Next second written */
+static uint8 CpuLoad_ucSeconds;
+
+/*******************************************************************************
+ *                              Public Functions                               *
+ *******************************************************************************/
+
+void CpuLoad_Init(uint32 ulTicksPerSecond)
+{
+    CpuLoad_ulTicksPerSecond = (ulTicksPerSecond > 0) ? ulTicksPerSecond : 1U;
+    CpuLoad_ulTicks = 0;
+    CpuLoad_ulTickLeast = CPU_LOAD_NOT_TIMED;
+    CpuLoad_ulLoopCycles = CPU_LOAD_NOT_TIMED;
+    CpuLoad_ullIdleOutside = 0;
+    CpuLoad_ulIdleTurns = 0;
+    CpuLoad_ulIdleTicks = 0;
+    CpuLoad_ucHead = 0;
+    CpuLoad_ucSeconds = 0;
+    CpuLoad_ucIsrNesting = 0;
+
+    /* The cycle counter may not run yet, the first tick takes the reference counts */
+    CpuLoad_bStarted = FALSE;
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+void CpuLoad_Idle(void)
+{
+    CpuLoad_ulIdleLoops++;
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+void CpuLoad_IsrEnter(void)
+{
+    uint32 ulSaved;
+
+    CPU_LOAD_LOCK(ulSaved);
+    if (CpuLoad_ucIsrNesting == 0U)
+    {
+        CpuLoad_ulIsrStart = CPU_LOAD_CYCLES();
+    }
+    CpuLoad_ucIsrNesting++;
+    CPU_LOAD_UNLOCK(ulSaved);
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+void CpuLoad_IsrExit(void)
+{
+    uint32 ulSaved;
+
+    CPU_LOAD_LOCK(ulSaved);
+    if (CpuLoad_ucIsrNesting > 0U)
+    {
+        CpuLoad_ucIsrNesting--;
+        if (CpuLoad_ucIsrNesting == 0U)
+        {
+            CpuLoad_ulIsrCycles += CPU_LOAD_CYCLES() - CpuLoad_ulIsrStart;
+        }
+    }
+    CPU_LOAD_UNLOCK(ulSaved);
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+/*
+ * Between two ticks the time that is neither an ISR nor a task is spent in turns of the idle loop, so
+ * the ticks with no task give the cycles of a turn. The ratio of the time outside the ISRs to the turns
+ * counted is off by up to a turn in a single tick, as a turn runs across the ticks: the least ratio is
+ * only low enough to pick the idle ticks (a tick that also ran a task gives a larger ratio), and the
+ * turn is timed over CPU_LOAD_CALIBRATION_TICKS idle ticks, where these errors cancel.
+ */
+void CpuLoad_Tick(uint32 ulTickIsrCycles)
+{
+    uint32 ulSaved;
+    uint32 ulNow;
+    uint32 ulLoops;
+    uint32 ulIsr;
+    uint32 ulOutside;
+    uint32 ulTurns;
+    uint32 ulLoopCycles;
+    CpuLoad_SecondType *pxSecond;
+
+    CPU_LOAD_LOCK(ulSaved);
+    ulNow = CPU_LOAD_CYCLES();
+    ulLoops = CpuLoad_ulIdleLoops;
+    CpuLoad_ulIsrCycles += ulTickIsrCycles;
+    ulIsr = CpuLoad_ulIsrCycles;
+    CPU_LOAD_UNLOCK(ulSaved);
+
+    if (CpuLoad_bStarted == FALSE)
+    {
+        CpuLoad_ulTickCycles = ulNow;
+        CpuLoad_ulTickLoops = ulLoops;
+        CpuLoad_ulTickIsr = ulIsr;
+        CpuLoad_ulSecondCycles = ulNow;
+        CpuLoad_ulSecondLoops = ulLoops;
+        CpuLoad_ulSecondIsr = ulIsr;
+        CpuLoad_bStarted = TRUE;
+        return;
+    }
+
+    ulTurns = (ulLoops - CpuLoad_ulTickLoops) & 0xFFFFFFFFUL;
+    ulOutside = ((ulNow - CpuLoad_ulTickCycles) - (ulIsr - CpuLoad_ulTickIsr)) & 0xFFFFFFFFUL;
+    if ((ulTurns > 0U) && (ulOutside <= (0xFFFFFFFFUL >> CPU_LOAD_LOOP_SHIFT)))
+    {
+        ulLoopCycles = (ulOutside << CPU_LOAD_LOOP_SHIFT) / ulTurns;
+        if (ulLoopCycles < CpuLoad_ulTickLeast)
+        {
+            /* The ticks summed so far may have run a task */
+            CpuLoad_ulTickLeast = ulLoopCycles;
+            CpuLoad_ullIdleOutside = 0;
+            CpuLoad_ulIdleTurns = 0;
+            CpuLoad_ulIdleTicks = 0;
+        }
+        if (ulLoopCycles <= (CpuLoad_ulTickLeast + (2U * CpuLoad_ulTickLeast) / ulTurns))
+        {
+            CpuLoad_ullIdleOutside += ulOutside;
+            CpuLoad_ulIdleTurns += ulTurns;
+            CpuLoad_ulIdleTicks++;
+            if (CpuLoad_ulIdleTicks >= CPU_LOAD_CALIBRATION_TICKS)
+            {
+                ulLoopCycles = (uint32) ((CpuLoad_ullIdleOutside << CPU_LOAD_LOOP_SHIFT) / CpuLoad_ulIdleTurns);
+                CpuLoad_ullIdleOutside = 0;
+                CpuLoad_ulIdleTurns = 0;
+                CpuLoad_ulIdleTicks = 0;
+
+                CPU_LOAD_LOCK(ulSaved);
+                CpuLoad_ulLoopCycles = ulLoopCycles;
+                CPU_LOAD_UNLOCK(ulSaved);
+            }
+        }
+    }
+    CpuLoad_ulTickCycles = ulNow;
+    CpuLoad_ulTickLoops = ulLoops;
+    CpuLoad_ulTickIsr = ulIsr;
+
+    CpuLoad_ulTicks++;
+    if (CpuLoad_ulTicks >= CpuLoad_ulTicksPerSecond)
+    {
+        CpuLoad_ulTicks = 0;
+
+        pxSecond = &CpuLoad_axSecond[CpuLoad_ucHead];
+        pxSecond->ulCycles = (ulNow - CpuLoad_ulSecondCycles) & 0xFFFFFFFFUL;
+        pxSecond->ulLoops = (ulLoops - CpuLoad_ulSecondLoops) & 0xFFFFFFFFUL;
+        pxSecond->ulIsr = (ulIsr - CpuLoad_ulSecondIsr) & 0xFFFFFFFFUL;
+        CpuLoad_ucHead = (uint8) ((CpuLoad_ucHead + 1U) % CPU_LOAD_MAX_SECONDS);
+        if (CpuLoad_ucSeconds < CPU_LOAD_MAX_SECONDS)
+        {
+            CpuLoad_ucSeconds++;
+        }
+
+        CpuLoad_ulSecondCycles = ulNow;
+        CpuLoad_ulSecondLoops = ulLoops;
+        CpuLoad_ulSecondIsr = ulIsr;
+    }
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+Std_ReturnType CpuLoad_Read(uint8 ucSeconds, CpuLoad_WindowType *pxWindow)
+{
+    uint32 ulSaved;
+    uint32 ulLoopCycles;
+    uint64 ullCycles = 0;
+    uint64 ullLoops = 0;
+    uint64 ullIsr = 0;
+    uint64 ullIdle;
+    uint8 ucSecond;
+    uint8 ucIndex;
+
+    if ((ucSeconds == 0U) || (ucSeconds > CPU_LOAD_MAX_SECONDS))
+    {
+        return E_NOT_OK;
+    }
+
+    /* The tick closes the seconds */
+    CPU_LOAD_LOCK(ulSaved);
+    ulLoopCycles = CpuLoad_ulLoopCycles;
+    if ((ucSeconds > CpuLoad_ucSeconds) || (ulLoopCycles == CPU_LOAD_NOT_TIMED))
+    {
+        CPU_LOAD_UNLOCK(ulSaved);
+        return E_NOT_OK;
+    }
+    for (ucSecond = 1; ucSecond <= ucSeconds; ucSecond++)
+    {
+        ucIndex = (uint8) ((CpuLoad_ucHead + CPU_LOAD_MAX_SECONDS - ucSecond) % CPU_LOAD_MAX_SECONDS);
+        ullCycles += CpuLoad_axSecond[ucIndex].ulCycles;
+        ullLoops += CpuLoad_axSecond[ucIndex].ulLoops;
+        ullIsr += CpuLoad_axSecond[ucIndex].ulIsr;
+    }
+    CPU_LOAD_UNLOCK(ulSaved);
+
+    if (ullCycles == 0U)
+    {
+        return E_NOT_OK;
+    }
+    if (ullIsr > ullCycles)
+    {
+        ullIsr = ullCycles;
+    }
+    ullIdle = (ullLoops * ulLoopCycles) >> CPU_LOAD_LOOP_SHIFT;
+    if (ullIdle > (ullCycles - ullIsr))
+    {
+        ullIdle = ullCycles - ullIsr;
+    }
+
+    pxWindow->usLoad = (uint16) (((ullCycles - ullIdle) * 1000U) / ullCycles);
+    pxWindow->usIsrLoad = (uint16) ((ullIsr * 1000U) / ullCycles);
+    return E_OK;
+}
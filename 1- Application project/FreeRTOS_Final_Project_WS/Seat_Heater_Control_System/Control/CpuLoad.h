@@ -0,0 +1,101 @@
+/*
+ ============================================================================
+ Name        : CpuLoad.h
+ Module Name : CpuLoad
+ Author      : Ahmed Ali
+ Date        : 22 Sept. 2024
+ Description : Header file for the sliding window CPU load measurement from the idle hook
+ ============================================================================
+ */
+
+#ifndef CPU_LOAD_H_
+#define CPU_LOAD_H_
+
+#include "Std_Types.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/*
+ * Set to 1 (here or as a predefined symbol of the build) to measure the CPU load with the idle and
+ * tick hooks of the kernel (configUSE_IDLE_HOOK and configUSE_TICK_HOOK follow it) and the ISR hooks
+ * of the application interrupts. When 0 the hooks compile to nothing.
+ */
+#ifndef CPU_LOAD_MONITOR
+#define CPU_LOAD_MONITOR                0
+#endif
+
+/* Seconds kept, the longest window */
+#define CPU_LOAD_MAX_SECONDS            60U
+
+/* The cycles of an idle loop are kept in units of 2^-CPU_LOAD_LOOP_SHIFT cycles */
+#define CPU_LOAD_LOOP_SHIFT             8U
+
+/* Idle ticks (with no task) over which an idle loop is timed */
+#define CPU_LOAD_CALIBRATION_TICKS      256U
+
+#if (CPU_LOAD_MONITOR == 1)
+#define CPU_LOAD_ISR_ENTER()            CpuLoad_IsrEnter()
+#define CPU_LOAD_ISR_EXIT()             CpuLoad_IsrExit()
+#else
+#define CPU_LOAD_ISR_ENTER()
+#define CPU_LOAD_ISR_EXIT()
+#endif
+
+/*******************************************************************************
+ *                              Types Declaration                              *
+ *******************************************************************************/
+
+/* Load of a window, in 0.1 % of its time */
+typedef struct
+{
+    uint16 usLoad; /* Time outside the idle loop: the tasks, the ISRs and the kernel */
+    uint16 usIsrLoad; /* Time in the application ISRs and the tick interrupt, part of usLoad */
+} CpuLoad_WindowType;
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Clear the windows, ulTicksPerSecond kernel ticks make a second. Called before the scheduler starts.
+ */
+void CpuLoad_Init(uint32 ulTicksPerSecond);
+
+/*
+ * Description :
+ * Idle hook: counts one turn of the idle loop, its only cost.
+ */
+void CpuLoad_Idle(void);
+
+/*
+ * Description :
+ * Called first by an application ISR, the outermost of nested ISRs is timed.
+ */
+void CpuLoad_IsrEnter(void);
+
+/*
+ * Description :
+ * Called last by an application ISR.
+ */
+void CpuLoad_IsrExit(void);
+
+/*
+ * Description :
+ * Tick hook, ulTickIsrCycles is the time the tick interrupt has run. The cycles of an idle loop are
+ * timed over the ticks that ran no task (idle time over turns of the idle loop), and every second is
+ * closed.
+ */
+void CpuLoad_Tick(uint32 ulTickIsrCycles);
+
+/*
+ * Description :
+ * Read the load of the last ucSeconds complete seconds. Returns E_NOT_OK while fewer seconds are
+ * complete, before the idle loop is timed (after CPU_LOAD_CALIBRATION_TICKS idle ticks), or for
+ * ucSeconds 0 or above CPU_LOAD_MAX_SECONDS.
+ */
+Std_ReturnType CpuLoad_Read(uint8 ucSeconds, CpuLoad_WindowType *pxWindow);
+
+#endif /* CPU_LOAD_H_ */
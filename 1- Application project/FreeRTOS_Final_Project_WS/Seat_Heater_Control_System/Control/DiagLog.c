@@ -0,0 +1,195 @@
+/*
+ ============================================================================
+ Name        : DiagLog.c
+ Module Name : DiagLog
+ Author      : Ahmed Ali
+ Date        : 22 Sept. 2024
+ Description : Source file for the lock-free circular log of the diagnostic failures
+ ============================================================================
+ */
+
+#include "DiagLog.h"
+
+/* Slot states of a sequence number */
+#define DIAG_LOG_COMPLETE(ulSequence)   (((ulSequence) & DIAG_LOG_SEQUENCE_MASK) << 1)
+#define DIAG_LOG_WRITING(ulSequence)    (DIAG_LOG_COMPLETE(ulSequence) | 1UL)
+
+/*
+ * Atomic compare and swap, and memory barrier.
+ * The TM4C123 is a single Cortex-M4 core: LDREX/STREX make the swap atomic against preemption,
+ * and the core does not reorder its own memory accesses, so the barrier only has to stop the compiler,
+ * which the volatile accesses already do. The GCC builtins are used by the host builds.
+ */
+#if defined(__TI_ARM__)
+static boolean DiagLog_CompareAndSwap(volatile uint32 *pulValue, uint32 ulExpected, uint32 ulDesired)
+{
+    do
+    {
+        if ((uint32) __ldrex((void *) pulValue) != ulExpected)
+        {
+            return FALSE;
+        }
+    } while (__strex(ulDesired, (void *) pulValue) != 0);
+    return TRUE;
+}
+#define DIAG_LOG_BARRIER()
+#elif defined(__GNUC__)
+static boolean DiagLog_CompareAndSwap(volatile uint32 *pulValue, uint32 ulExpected, uint32 ulDesired)
+{
+    return __atomic_compare_exchange_n(pulValue, &ulExpected, ulDesired, FALSE, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST) ? TRUE : FALSE;
+}
+#define DIAG_LOG_BARRIER()              __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#else
+#error "DiagLog needs an atomic compare and swap for this compiler"
+#endif
+
+/*******************************************************************************
+ *                              Private Functions                              *
+ *******************************************************************************/
+
+/* TRUE when sequence number ulA is before ulB, in serial number arithmetic */
+static boolean DiagLog_Before(uint32 ulA, uint32 ulB)
+{
+    return ((((ulA - ulB) & DIAG_LOG_SEQUENCE_MASK) != 0) && ((((ulA - ulB) >> 30) & 1UL) != 0)) ? TRUE : FALSE;
+}
+
+/*******************************************************************************
+ *                              Public Functions                               *
+ *******************************************************************************/
+
+Std_ReturnType DiagLog_Init(DiagLog_Type *pxLog, DiagLog_SlotType *pxSlots, uint32 ulCapacity)
+{
+    uint32 i;
+
+    if ((ulCapacity == 0) || ((ulCapacity & (ulCapacity - 1)) != 0))
+    {
+        return E_NOT_OK;
+    }
+
+    for (i = 0; i < ulCapacity; i++)
+    {
+        pxSlots[i].ulState = 0;
+    }
+    pxLog->pxSlots = pxSlots;
+    pxLog->ulMask = ulCapacity - 1;
+    pxLog->ulHead = DIAG_LOG_FIRST_SEQUENCE;
+
+    return E_OK;
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+/*
+ * A producer takes the next sequence number, then claims its slot by swapping the slot state from a
+ * complete older entry to "writing". The claim fails when another producer is still writing the slot,
+ * or has already put a newer entry in it: both only happen when a whole capacity of entries was appended
+ * while this producer was preempted, and it then takes a new sequence number instead of waiting, so the
+ * skipped number is never used. Readers see the slot state change and discard what they copied.
+ */
+uint32 DiagLog_Append(DiagLog_Type *pxLog, const DiagLog_EntryType *pxEntry)
+{
+    DiagLog_SlotType *pxSlot;
+    uint32 ulSequence;
+    uint32 ulState;
+
+    for (;;)
+    {
+        do
+        {
+            ulSequence = pxLog->ulHead;
+        } while (DiagLog_CompareAndSwap(&pxLog->ulHead, ulSequence, DIAG_LOG_NEXT(ulSequence)) == FALSE);
+
+        pxSlot = &pxLog->pxSlots[ulSequence & pxLog->ulMask];
+        ulState = pxSlot->ulState;
+        if (((ulState & 1UL) == 0) && ((ulState == 0) || (DiagLog_Before(ulState >> 1, ulSequence) == TRUE)) &&
+            (DiagLog_CompareAndSwap(&pxSlot->ulState, ulState, DIAG_LOG_WRITING(ulSequence)) == TRUE))
+        {
+            break;
+        }
+    }
+
+    DIAG_LOG_BARRIER();
+    pxSlot->aulWord[0] = pxEntry->ulTimeStamp;
+    pxSlot->aulWord[1] = (uint32) pxEntry->ucFailureCode | ((uint32) pxEntry->ucFailureSeat << 8) | ((uint32) pxEntry->ucHeatingLevel << 16);
+    DIAG_LOG_BARRIER();
+    pxSlot->ulState = DIAG_LOG_COMPLETE(ulSequence);
+
+    return ulSequence;
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+uint32 DiagLog_Head(const DiagLog_Type *pxLog)
+{
+    return pxLog->ulHead;
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+/* Sequence lock read: the slot state is the same before and after the copy only if no producer wrote in between */
+Std_ReturnType DiagLog_Read(const DiagLog_Type *pxLog, uint32 ulSequence, DiagLog_EntryType *pxEntry)
+{
+    const DiagLog_SlotType *pxSlot = &pxLog->pxSlots[ulSequence & pxLog->ulMask];
+    uint32 ulState;
+    uint32 ulWord0;
+    uint32 ulWord1;
+
+    if (ulSequence == 0)
+    {
+        return E_NOT_OK;
+    }
+
+    ulState = pxSlot->ulState;
+    if (ulState != DIAG_LOG_COMPLETE(ulSequence))
+    {
+        return E_NOT_OK;
+    }
+    DIAG_LOG_BARRIER();
+    ulWord0 = pxSlot->aulWord[0];
+    ulWord1 = pxSlot->aulWord[1];
+    DIAG_LOG_BARRIER();
+    if (pxSlot->ulState != ulState)
+    {
+        return E_NOT_OK;
+    }
+
+    pxEntry->ulTimeStamp = ulWord0;
+    pxEntry->ucFailureCode = (uint8) ulWord1;
+    pxEntry->ucFailureSeat = (uint8) (ulWord1 >> 8);
+    pxEntry->ucHeatingLevel = (uint8) (ulWord1 >> 16);
+
+    return E_OK;
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+uint32 DiagLog_Snapshot(const DiagLog_Type *pxLog, DiagLog_RecordType *pxRecords, uint32 ulMax)
+{
+    uint32 ulHead = pxLog->ulHead;
+    uint32 ulSpan = pxLog->ulMask + 1;
+    uint32 ulCount = 0;
+    uint32 ulSequence;
+
+    /* The last capacity (or ulMax) sequence numbers, not before the first one */
+    if (((ulHead - DIAG_LOG_FIRST_SEQUENCE) & DIAG_LOG_SEQUENCE_MASK) < ulSpan)
+    {
+        ulSpan = (ulHead - DIAG_LOG_FIRST_SEQUENCE) & DIAG_LOG_SEQUENCE_MASK;
+    }
+    if (ulMax < ulSpan)
+    {
+        ulSpan = ulMax;
+    }
+
+    ulSequence = (ulHead - ulSpan) & DIAG_LOG_SEQUENCE_MASK;
+    for (; ulSpan > 0; ulSpan--)
+    {
+        if (DiagLog_Read(pxLog, ulSequence, &pxRecords[ulCount].xEntry) == E_OK)
+        {
+            pxRecords[ulCount].ulSequence = ulSequence;
+            ulCount++;
+        }
+        ulSequence = DIAG_LOG_NEXT(ulSequence);
+    }
+
+    return ulCount;
+}
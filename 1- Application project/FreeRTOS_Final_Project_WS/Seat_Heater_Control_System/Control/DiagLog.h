@@ -0,0 +1,111 @@
+/*
+ ============================================================================
+ Name        : DiagLog.h
+ Module Name : DiagLog
+ Author      : Ahmed Ali
+ Date        : 22 Sept. 2024
+ Description : Header file for the lock-free circular log of the diagnostic failures
+ ============================================================================
+ */
+
+#ifndef DIAG_LOG_H_
+#define DIAG_LOG_H_
+
+#include "Std_Types.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/*
+ * Sequence numbers start at 1 and increase by one per appended entry, 0 is never used.
+ * They are 31 bits wide and compared in serial number arithmetic, so they wrap after 2^31 entries.
+ */
+#define DIAG_LOG_FIRST_SEQUENCE         1U
+#define DIAG_LOG_SEQUENCE_MASK          0x7FFFFFFFUL
+
+/* Sequence number after ulSequence, skipping 0 when it wraps */
+#define DIAG_LOG_NEXT(ulSequence) \
+    ((((ulSequence) + 1UL) & DIAG_LOG_SEQUENCE_MASK) == 0 ? DIAG_LOG_FIRST_SEQUENCE : (((ulSequence) + 1UL) & DIAG_LOG_SEQUENCE_MASK))
+
+/*******************************************************************************
+ *                              Types Declaration                              *
+ *******************************************************************************/
+
+/* One failure */
+typedef struct
+{
+    uint32 ulTimeStamp; /* Timestamp of the failure event */
+    uint8 ucFailureCode; /* Code indicating the type of failure */
+    uint8 ucFailureSeat; /* Identifier for the seat where the failure occurred */
+    uint8 ucHeatingLevel; /* Heating level at the time of the failure */
+} DiagLog_EntryType;
+
+/* An entry read back with its sequence number */
+typedef struct
+{
+    uint32 ulSequence;
+    DiagLog_EntryType xEntry;
+} DiagLog_RecordType;
+
+/*
+ * Storage of one entry. ulState is (sequence << 1) | 1 while a producer writes the entry and
+ * sequence << 1 once it is complete, 0 for a slot never written.
+ */
+typedef struct
+{
+    volatile uint32 ulState;
+    volatile uint32 aulWord[2];
+} DiagLog_SlotType;
+
+/* A log over a caller provided slot array */
+typedef struct
+{
+    DiagLog_SlotType *pxSlots;
+    uint32 ulMask; /* Capacity - 1 */
+    volatile uint32 ulHead; /* Sequence number of the next entry */
+} DiagLog_Type;
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Set up an empty log over ulCapacity slots. Returns E_NOT_OK unless ulCapacity is a power of two.
+ * Must be called before any producer or reader runs.
+ */
+Std_ReturnType DiagLog_Init(DiagLog_Type *pxLog, DiagLog_SlotType *pxSlots, uint32 ulCapacity);
+
+/*
+ * Description :
+ * Append an entry and return its sequence number. Once the log is full the oldest entry is overwritten.
+ * Lock-free: any number of tasks and interrupts may append at the same time, and a producer only
+ * retries when another one has appended meanwhile. O(1) without contention.
+ */
+uint32 DiagLog_Append(DiagLog_Type *pxLog, const DiagLog_EntryType *pxEntry);
+
+/*
+ * Description :
+ * Returns the sequence number the next entry will get: DiagLog_Head() - DIAG_LOG_FIRST_SEQUENCE
+ * entries were appended since the log was set up.
+ */
+uint32 DiagLog_Head(const DiagLog_Type *pxLog);
+
+/*
+ * Description :
+ * Read the entry of a sequence number. Returns E_NOT_OK when it was overwritten, is still being
+ * written, or was never appended. The entry is read without stopping the producers, and a read
+ * that overlaps a write of the same slot is detected and fails instead of returning a torn entry.
+ */
+Std_ReturnType DiagLog_Read(const DiagLog_Type *pxLog, uint32 ulSequence, DiagLog_EntryType *pxEntry);
+
+/*
+ * Description :
+ * Copy up to ulMax of the most recent complete entries to pxRecords, oldest first, and return their
+ * number. Every record is consistent; entries overwritten or still being written during the copy
+ * are left out. O(capacity).
+ */
+uint32 DiagLog_Snapshot(const DiagLog_Type *pxLog, DiagLog_RecordType *pxRecords, uint32 ulMax);
+
+#endif /* DIAG_LOG_H_ */
@@ -0,0 +1,124 @@
+/*
+ ============================================================================
+ Name        : Dtc.c
+ Module Name : Dtc
+ Author      : Ahmed Ali
+ Date        : 22 Sept. 2024
+ Description : Source file for the diagnostic trouble code manager
+ ============================================================================
+ */
+
+#include "Dtc.h"
+
+/*******************************************************************************
+ *                              Global Variables                               *
+ *******************************************************************************/
+
+/* Indexed by seat and code, a record is in use when its status has DTC_STATUS_CONFIRMED */
+static Dtc_RecordType Dtc_axRecord[DTC_NUMBER_OF_SEATS][DTC_NUMBER_OF_CODES];
+static uint8 Dtc_ucAgingCycles;
+
+/*******************************************************************************
+ *                              Public Functions                               *
+ *******************************************************************************/
+
+void Dtc_Init(uint8 ucAgingCycles)
+{
+    uint8 ucSeat;
+    uint8 ucCode;
+
+    for (ucSeat = 0; ucSeat < DTC_NUMBER_OF_SEATS; ucSeat++)
+    {
+        for (ucCode = 0; ucCode < DTC_NUMBER_OF_CODES; ucCode++)
+        {
+            Dtc_axRecord[ucSeat][ucCode].ucStatus = 0;
+        }
+    }
+    Dtc_ucAgingCycles = ucAgingCycles;
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+boolean Dtc_ReportFailed(uint8 ucSeat, uint8 ucCode, uint32 ulTimeStamp, const Dtc_FreezeFrameType *pxFreezeFrame)
+{
+    Dtc_RecordType *pxRecord;
+    boolean bNew;
+
+    if ((ucSeat >= DTC_NUMBER_OF_SEATS) || (ucCode >= DTC_NUMBER_OF_CODES))
+    {
+        return FALSE;
+    }
+
+    pxRecord = &Dtc_axRecord[ucSeat][ucCode];
+    bNew = ((pxRecord->ucStatus & DTC_STATUS_CONFIRMED) == 0) ? TRUE : FALSE;
+
+    if (bNew == TRUE)
+    {
+        pxRecord->ulFirstTimeStamp = ulTimeStamp;
+        pxRecord->usOccurrences = 0;
+        pxRecord->xFreezeFrame = *pxFreezeFrame;
+    }
+
+    /* Still failed since the last report is the same occurrence */
+    if (((pxRecord->ucStatus & DTC_STATUS_TEST_FAILED) == 0) && (pxRecord->usOccurrences < DTC_MAX_OCCURRENCES))
+    {
+        pxRecord->usOccurrences++;
+    }
+    pxRecord->ulLastTimeStamp = ulTimeStamp;
+    pxRecord->ucAgingCounter = 0;
+    pxRecord->ucStatus = DTC_STATUS_TEST_FAILED | DTC_STATUS_CONFIRMED;
+
+    return bNew;
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+void Dtc_ReportPassed(uint8 ucSeat, uint8 ucCode)
+{
+    if ((ucSeat < DTC_NUMBER_OF_SEATS) && (ucCode < DTC_NUMBER_OF_CODES))
+    {
+        Dtc_axRecord[ucSeat][ucCode].ucStatus &= (uint8) ~DTC_STATUS_TEST_FAILED;
+    }
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+void Dtc_Age(void)
+{
+    Dtc_RecordType *pxRecord;
+    uint8 ucSeat;
+    uint8 ucCode;
+
+    for (ucSeat = 0; ucSeat < DTC_NUMBER_OF_SEATS; ucSeat++)
+    {
+        for (ucCode = 0; ucCode < DTC_NUMBER_OF_CODES; ucCode++)
+        {
+            pxRecord = &Dtc_axRecord[ucSeat][ucCode];
+            if ((pxRecord->ucStatus != DTC_STATUS_CONFIRMED) || (Dtc_ucAgingCycles == 0))
+            {
+                continue;
+            }
+
+            pxRecord->ucAgingCounter++;
+            if (pxRecord->ucAgingCounter >= Dtc_ucAgingCycles)
+            {
+                /* Healed */
+                pxRecord->ucStatus = 0;
+            }
+        }
+    }
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+Std_ReturnType Dtc_Read(uint8 ucSeat, uint8 ucCode, Dtc_RecordType *pxRecord)
+{
+    if ((ucSeat >= DTC_NUMBER_OF_SEATS) || (ucCode >= DTC_NUMBER_OF_CODES) ||
+        ((Dtc_axRecord[ucSeat][ucCode].ucStatus & DTC_STATUS_CONFIRMED) == 0))
+    {
+        return E_NOT_OK;
+    }
+
+    *pxRecord = Dtc_axRecord[ucSeat][ucCode];
+    return E_OK;
+}
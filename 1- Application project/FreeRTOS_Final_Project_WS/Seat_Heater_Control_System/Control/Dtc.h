@@ -0,0 +1,99 @@
+/*
+ ============================================================================
+ Name        : Dtc.h
+ Module Name : Dtc
+ Author      : Ahmed Ali
+ Date        : 22 Sept. 2024
+ Description : Header file for the diagnostic trouble code manager
+ ============================================================================
+ */
+
+#ifndef DTC_H_
+#define DTC_H_
+
+#include "Std_Types.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/* One trouble code per seat and failure code, at a fixed index of the table */
+#define DTC_NUMBER_OF_SEATS             2U
+
+#define DTC_CODE_OVER_RANGE             0U
+#define DTC_CODE_UNDER_RANGE            1U
+#define DTC_NUMBER_OF_CODES             2U
+
+/* Status bits */
+#define DTC_STATUS_TEST_FAILED          0x01U  /* The failure is present now */
+#define DTC_STATUS_CONFIRMED            0x08U  /* The trouble code is stored */
+
+/* The occurrence counter saturates at this value */
+#define DTC_MAX_OCCURRENCES             0xFFFFU
+
+/*******************************************************************************
+ *                              Types Declaration                              *
+ *******************************************************************************/
+
+/* Conditions at the first occurrence of a trouble code */
+typedef struct
+{
+    uint8 ucTemperature;
+    uint8 ucHeatingLevel;
+    uint8 ucHeaterState;
+    uint8 ucCpuLoad; /* in % */
+} Dtc_FreezeFrameType;
+
+typedef struct
+{
+    uint32 ulFirstTimeStamp;
+    uint32 ulLastTimeStamp;
+    uint16 usOccurrences;
+    uint8 ucStatus;
+    uint8 ucAgingCounter; /* Aging cycles without the failure since it was last present */
+    Dtc_FreezeFrameType xFreezeFrame;
+} Dtc_RecordType;
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Clear every trouble code. A stored code is cleared after ucAgingCycles aging cycles without its failure,
+ * 0 keeps it until the next Dtc_Init.
+ */
+void Dtc_Init(uint8 ucAgingCycles);
+
+/*
+ * Description :
+ * Report a failure. The first occurrence stores the trouble code with pxFreezeFrame and the timestamp, the
+ * next ones only update the last timestamp and the occurrence counter, and restart the aging, so a flapping
+ * failure always uses a single record. Returns TRUE when the trouble code was not stored before.
+ * O(1). The caller serializes the calls to the module.
+ */
+boolean Dtc_ReportFailed(uint8 ucSeat, uint8 ucCode, uint32 ulTimeStamp, const Dtc_FreezeFrameType *pxFreezeFrame);
+
+/*
+ * Description :
+ * Report that the failure is not present anymore, the trouble code stays stored and starts aging.
+ * O(1). The caller serializes the calls to the module.
+ */
+void Dtc_ReportPassed(uint8 ucSeat, uint8 ucCode);
+
+/*
+ * Description :
+ * End an aging cycle: every stored trouble code whose failure is not present ages by one cycle, and is
+ * cleared once it reaches the aging cycles given to Dtc_Init. O(seats x codes).
+ * The caller serializes the calls to the module.
+ */
+void Dtc_Age(void);
+
+/*
+ * Description :
+ * Copy the record of a trouble code. Returns E_NOT_OK when it is not stored or out of range.
+ * The caller serializes the calls to the module.
+ */
+Std_ReturnType Dtc_Read(uint8 ucSeat, uint8 ucCode, Dtc_RecordType *pxRecord);
+
+#endif /* DTC_H_ */
@@ -0,0 +1,147 @@
+/*
+ ============================================================================
+ Name        : FaultExport.c
+ Module Name : FaultExport
+ Author      : Ahmed Ali
+ Date        : 22 Sept. 2024
+ Description : Source file for the compact binary export of the fault log
+ ============================================================================
+ */
+
+#include "FaultExport.h"
+
+/* Entries are built after room for the longest header */
+#define FAULT_EXPORT_ENTRIES_OFFSET     FAULT_EXPORT_HEADER_MAX_BYTES
+
+/*******************************************************************************
+ *                              Private Functions                              *
+ *******************************************************************************/
+
+/* Write a varint and return its length */
+static uint8 FaultExport_Varint(uint32 ulValue, uint8 *pucBytes)
+{
+    uint8 ucLength = 0;
+
+    ulValue &= 0xFFFFFFFFUL;
+    while (ulValue >= 0x80U)
+    {
+        pucBytes[ucLength++] = (uint8) ((ulValue & 0x7FU) | 0x80U);
+        ulValue >>= 7;
+    }
+    pucBytes[ucLength++] = (uint8) ulValue;
+
+    return ucLength;
+}
+
+/* Index of a raw code in a pair of the dictionary, 2 when it is not there */
+static uint8 FaultExport_Lookup(const uint8 *pucPair, uint8 ucValue)
+{
+    return (pucPair[0] == ucValue) ? 0U : ((pucPair[1] == ucValue) ? 1U : 2U);
+}
+
+/*******************************************************************************
+ *                              Public Functions                               *
+ *******************************************************************************/
+
+void FaultExport_Start(FaultExport_BlockType *pxBlock, const FaultExport_DictionaryType *pxDictionary)
+{
+    pxBlock->pxDictionary = pxDictionary;
+    pxBlock->usLength = 0;
+    pxBlock->ucCount = 0;
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+Std_ReturnType FaultExport_Add(FaultExport_BlockType *pxBlock, const DiagLog_RecordType *pxRecord)
+{
+    uint8 *pucEntry = &pxBlock->aucBytes[FAULT_EXPORT_ENTRIES_OFFSET + pxBlock->usLength];
+    uint8 ucSeat = FaultExport_Lookup(pxBlock->pxDictionary->aucSeat, pxRecord->xEntry.ucFailureSeat);
+    uint8 ucCode = FaultExport_Lookup(pxBlock->pxDictionary->aucCode, pxRecord->xEntry.ucFailureCode);
+    uint32 ulDelta;
+
+    if ((ucSeat > 1U) || (ucCode > 1U) || (pxRecord->xEntry.ucHeatingLevel > FAULT_EXPORT_LEVEL_MASK) ||
+        (pxBlock->ucCount >= FAULT_EXPORT_BLOCK_ENTRIES) ||
+        ((pxBlock->ucCount > 0) && (pxRecord->ulSequence != ((pxBlock->ulFirstSequence + pxBlock->ucCount) & 0xFFFFFFFFUL))))
+    {
+        return E_NOT_OK;
+    }
+
+    if (pxBlock->ucCount == 0)
+    {
+        pxBlock->ulFirstSequence = pxRecord->ulSequence;
+        pxBlock->ulFirstTimeStamp = pxRecord->xEntry.ulTimeStamp;
+        pxBlock->ulLastTimeStamp = pxRecord->xEntry.ulTimeStamp;
+    }
+
+    /* The timer counts up, the delta to the last entry is small and positive, and wraps with the timer */
+    ulDelta = (pxRecord->xEntry.ulTimeStamp - pxBlock->ulLastTimeStamp) & 0xFFFFFFFFUL;
+    pxBlock->ulLastTimeStamp = pxRecord->xEntry.ulTimeStamp;
+
+    pucEntry[0] = (uint8) (pxRecord->xEntry.ucHeatingLevel | ((ucSeat != 0U) ? FAULT_EXPORT_SEAT_BIT : 0U) |
+                           ((ucCode != 0U) ? FAULT_EXPORT_CODE_BIT : 0U) |
+                           ((ulDelta & ((1U << FAULT_EXPORT_DELTA_BITS) - 1U)) << FAULT_EXPORT_DELTA_SHIFT));
+    ulDelta >>= FAULT_EXPORT_DELTA_BITS;
+    pxBlock->usLength++;
+    if (ulDelta != 0)
+    {
+        pucEntry[0] |= FAULT_EXPORT_MORE_BIT;
+        pxBlock->usLength += FaultExport_Varint(ulDelta, &pucEntry[1]);
+    }
+    pxBlock->ucCount++;
+
+    return E_OK;
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+uint16 FaultExport_Finish(FaultExport_BlockType *pxBlock, const uint8 **ppucBytes)
+{
+    uint8 aucHeader[FAULT_EXPORT_HEADER_MAX_BYTES];
+    uint8 ucHeaderLength;
+    uint16 usStart;
+    uint16 usEnd;
+    uint16 usCrc;
+    uint8 i;
+
+    aucHeader[0] = pxBlock->ucCount;
+    ucHeaderLength = 1U;
+    ucHeaderLength += FaultExport_Varint(pxBlock->ulFirstSequence, &aucHeader[ucHeaderLength]);
+    ucHeaderLength += FaultExport_Varint(pxBlock->ulFirstTimeStamp, &aucHeader[ucHeaderLength]);
+
+    /* Header right in front of the entries */
+    usStart = (uint16) (FAULT_EXPORT_ENTRIES_OFFSET - ucHeaderLength);
+    for (i = 0; i < ucHeaderLength; i++)
+    {
+        pxBlock->aucBytes[usStart + i] = aucHeader[i];
+    }
+
+    usEnd = (uint16) (FAULT_EXPORT_ENTRIES_OFFSET + pxBlock->usLength);
+    usCrc = FaultExport_Crc16(&pxBlock->aucBytes[usStart], (uint16) (usEnd - usStart));
+    pxBlock->aucBytes[usEnd] = (uint8) (usCrc >> 8);
+    pxBlock->aucBytes[usEnd + 1U] = (uint8) usCrc;
+
+    pxBlock->usLength = 0;
+    pxBlock->ucCount = 0;
+
+    *ppucBytes = &pxBlock->aucBytes[usStart];
+    return (uint16) (usEnd + FAULT_EXPORT_CRC_BYTES - usStart);
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+uint16 FaultExport_Crc16(const uint8 *pucBytes, uint16 usLength)
+{
+    uint16 usCrc = 0xFFFFU;
+    uint8 ucBit;
+
+    for (; usLength > 0; usLength--)
+    {
+        usCrc ^= (uint16) ((uint16) *pucBytes++ << 8);
+        for (ucBit = 0; ucBit < 8U; ucBit++)
+        {
+            usCrc = ((usCrc & 0x8000U) != 0) ? (uint16) ((usCrc << 1) ^ 0x1021U) : (uint16) (usCrc << 1);
+        }
+    }
+
+    return usCrc;
+}
@@ -0,0 +1,106 @@
+/*
+ ============================================================================
+ Name        : FaultExport.h
+ Module Name : FaultExport
+ Author      : Ahmed Ali
+ Date        : 22 Sept. 2024
+ Description : Header file for the compact binary export of the fault log
+ ============================================================================
+ */
+
+#ifndef FAULT_EXPORT_H_
+#define FAULT_EXPORT_H_
+
+#include "Std_Types.h"
+#include "DiagLog.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/*
+ * An export is a sequence of blocks, each one decodable on its own:
+ * - entry count (1 byte, 1 to FAULT_EXPORT_BLOCK_ENTRIES), a count of 0 ends the export
+ * - sequence number of the first entry, varint, the next entries have the next sequence numbers
+ * - timestamp of the first entry, varint
+ * - one entry after the other: an entry byte, followed by the rest of the timestamp delta as a varint
+ *   when bit 7 of the entry byte is set
+ * - CRC-16/CCITT-FALSE of all the bytes above, most significant byte first
+ * Varints are little endian groups of 7 bits, bit 7 set on every byte but the last one.
+ * The timestamps stay exact at the timer resolution (0.1 ms), so an entry of a flapping sensor, failing
+ * 0.2 to 2 s after the previous one, takes 3 bytes: about 3.5 bytes per record with the block overhead,
+ * 2.3x fewer than the 8 byte log entries rather than the 3-4x a lossy timestamp would allow.
+ */
+#define FAULT_EXPORT_BLOCK_ENTRIES      32U
+
+/* Entry byte: bits 0-1 heating level, bit 2 seat, bit 3 failure code, bits 4-6 the low bits of the delta */
+#define FAULT_EXPORT_LEVEL_MASK         0x03U
+#define FAULT_EXPORT_SEAT_BIT           0x04U
+#define FAULT_EXPORT_CODE_BIT           0x08U
+#define FAULT_EXPORT_DELTA_SHIFT        4U
+#define FAULT_EXPORT_DELTA_BITS         3U
+#define FAULT_EXPORT_MORE_BIT           0x80U
+
+#define FAULT_EXPORT_VARINT_MAX_BYTES   5U  /* 32 bits */
+#define FAULT_EXPORT_HEADER_MAX_BYTES   (1U + (2U * FAULT_EXPORT_VARINT_MAX_BYTES))
+#define FAULT_EXPORT_ENTRY_MAX_BYTES    (1U + FAULT_EXPORT_VARINT_MAX_BYTES)
+#define FAULT_EXPORT_CRC_BYTES          2U
+#define FAULT_EXPORT_BLOCK_MAX_BYTES    (FAULT_EXPORT_HEADER_MAX_BYTES + (FAULT_EXPORT_BLOCK_ENTRIES * FAULT_EXPORT_ENTRY_MAX_BYTES) + \
+                                         FAULT_EXPORT_CRC_BYTES)
+
+/*******************************************************************************
+ *                              Types Declaration                              *
+ *******************************************************************************/
+
+/* Raw seat and failure codes of the entry byte bits, sent to the decoder before the blocks */
+typedef struct
+{
+    uint8 aucSeat[2];
+    uint8 aucCode[2];
+} FaultExport_DictionaryType;
+
+/* A block being built, the header is written in front of the entries when the block is finished */
+typedef struct
+{
+    const FaultExport_DictionaryType *pxDictionary;
+    uint8 aucBytes[FAULT_EXPORT_BLOCK_MAX_BYTES];
+    uint16 usLength; /* Entry bytes */
+    uint8 ucCount;
+    uint32 ulFirstSequence;
+    uint32 ulFirstTimeStamp;
+    uint32 ulLastTimeStamp;
+} FaultExport_BlockType;
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Start an empty block, entries are coded with the seats and failure codes of pxDictionary.
+ */
+void FaultExport_Start(FaultExport_BlockType *pxBlock, const FaultExport_DictionaryType *pxDictionary);
+
+/*
+ * Description :
+ * Add a record to the block. Returns E_NOT_OK when the block is full or the sequence number does not
+ * follow the last entry: the block must then be finished and the record added to the next one. A record
+ * that an empty block refuses has a seat, failure code or heating level out of the dictionary.
+ */
+Std_ReturnType FaultExport_Add(FaultExport_BlockType *pxBlock, const DiagLog_RecordType *pxRecord);
+
+/*
+ * Description :
+ * Write the header and the CRC of a block with at least one entry, point *ppucBytes to the coded block
+ * and return its length, at most FAULT_EXPORT_BLOCK_MAX_BYTES. The bytes stay valid until the next
+ * FaultExport_Add, which starts a new block.
+ */
+uint16 FaultExport_Finish(FaultExport_BlockType *pxBlock, const uint8 **ppucBytes);
+
+/*
+ * Description :
+ * CRC-16/CCITT-FALSE (polynomial 0x1021, initial value 0xFFFF) of a byte array.
+ */
+uint16 FaultExport_Crc16(const uint8 *pucBytes, uint16 usLength);
+
+#endif /* FAULT_EXPORT_H_ */
@@ -0,0 +1,500 @@
+/*
+ ============================================================================
+ Name        : FaultInject.c
+ Module Name : FaultInject
+ Author      : Ahmed Ali
+ Date        : 22 Sept. 2024
+ Description : Source file for the fault injection of the sensor, ADC and button paths
+ ============================================================================
+ */
+
+#include "FaultInject.h"
+
+#define FAULT_INJECT_ADC_MAX            0xFFFU
+#define FAULT_INJECT_TEMPERATURE_MAX    0xFFU
+
+/* Elapsed time of a spike or drop that does not come again */
+#define FAULT_INJECT_NEVER              0xFFFFFFFFUL
+
+/*******************************************************************************
+ *                              Global Variables                               *
+ *******************************************************************************/
+
+/*
+ * The steps only change while no scenario runs. While it runs, the results of a sensor step are only
+ * written by the task of its channel, and the start of a chatter step by the tick while the button task
+ * counts its events, so the hooks need no lock.
+ */
+static FaultInject_StepType FaultInject_axStep[FAULT_INJECT_MAX_STEPS];
+static FaultInject_ResultType FaultInject_axResult[FAULT_INJECT_MAX_STEPS];
+static uint32 FaultInject_aulNext[FAULT_INJECT_MAX_STEPS]; /* Elapsed ticks of the next spike, drop or toggle */
+static uint8 FaultInject_ucSteps;
+
+static volatile boolean FaultInject_bRunning = FALSE;
+static volatile uint32 FaultInject_ulNow;
+static uint32 FaultInject_ulRunStart;
+static uint32 FaultInject_ulRunEnd; /* Elapsed ticks of the end of the last step and its grace time */
+
+static uint32 FaultInject_aulSeed[FAULT_INJECT_CHANNELS];
+static uint16 FaultInject_ausLastAdc[FAULT_INJECT_CHANNELS];
+static uint8 FaultInject_aucLastTemperature[FAULT_INJECT_CHANNELS];
+static uint32 FaultInject_aulFalsePositives[FAULT_INJECT_CHANNELS];
+static uint32 FaultInject_aulCleanSamples[FAULT_INJECT_CHANNELS];
+
+static volatile boolean FaultInject_abChatter[FAULT_INJECT_BUTTONS];
+static volatile uint8 FaultInject_aucButtonLevel[FAULT_INJECT_BUTTONS];
+static volatile boolean FaultInject_abEdge[FAULT_INJECT_BUTTONS];
+
+/*******************************************************************************
+ *                              Private Functions                              *
+ *******************************************************************************/
+
+static uint32 FaultInject_Elapsed(uint32 ulTimeStamp)
+{
+    return (ulTimeStamp - FaultInject_ulRunStart) & 0xFFFFFFFFUL;
+}
+
+static uint32 FaultInject_Begin(const FaultInject_StepType *pxStep)
+{
+    return pxStep->ulAt * FAULT_INJECT_TICKS_PER_MS;
+}
+
+static uint32 FaultInject_End(const FaultInject_StepType *pxStep)
+{
+    return (pxStep->ulAt + pxStep->ulDuration) * FAULT_INJECT_TICKS_PER_MS;
+}
+
+static boolean FaultInject_IsSensor(uint8 ucTarget)
+{
+    return (ucTarget <= FAULT_INJECT_TARGET_LM35_1) ? TRUE : FALSE;
+}
+
+/* Sensor channel of a sensor target */
+static uint8 FaultInject_Channel(uint8 ucTarget)
+{
+    return (uint8) (ucTarget % FAULT_INJECT_CHANNELS);
+}
+
+/* Xorshift32, one generator per channel as the channels are sampled by different tasks */
+static uint32 FaultInject_Random(uint8 ucChannel)
+{
+    uint32 ulState = FaultInject_aulSeed[ucChannel];
+
+    ulState ^= (ulState << 13) & 0xFFFFFFFFUL;
+    ulState ^= ulState >> 17;
+    ulState ^= (ulState << 5) & 0xFFFFFFFFUL;
+    FaultInject_aulSeed[ucChannel] = ulState;
+
+    return ulState;
+}
+
+/* Returns TRUE when a periodic spike or drop fires at this sample, and schedules the next one */
+static boolean FaultInject_Fire(uint8 ucStep, uint32 ulElapsed)
+{
+    if (ulElapsed < FaultInject_aulNext[ucStep])
+    {
+        return FALSE;
+    }
+
+    FaultInject_aulNext[ucStep] = (FaultInject_axStep[ucStep].ulPeriod == 0) ? FAULT_INJECT_NEVER :
+                                  (FaultInject_aulNext[ucStep] + (FaultInject_axStep[ucStep].ulPeriod * FAULT_INJECT_TICKS_PER_MS));
+    return TRUE;
+}
+
+/*
+ * Applies the active steps of a sensor target to a sample, usLast is the previous sample read by the
+ * task (the value of a dropped conversion). Returns TRUE when a step of the channel is active or in its
+ * grace time, so the sample is not a fault free one.
+ */
+static boolean FaultInject_Sensor(uint8 ucTarget, uint16 *pusValue, uint16 usLast, uint16 usMax)
+{
+    const FaultInject_StepType *pxStep;
+    uint32 ulElapsed = FaultInject_Elapsed(FaultInject_ulNow);
+    uint32 ulNoise;
+    sint32 slValue;
+    boolean bCovered = FALSE;
+    boolean bApplied;
+    uint8 ucStep;
+
+    for (ucStep = 0; ucStep < FaultInject_ucSteps; ucStep++)
+    {
+        pxStep = &FaultInject_axStep[ucStep];
+        if ((FaultInject_IsSensor(pxStep->ucTarget) == FALSE) ||
+            (FaultInject_Channel(pxStep->ucTarget) != FaultInject_Channel(ucTarget)) || (ulElapsed < FaultInject_Begin(pxStep)))
+        {
+            continue;
+        }
+        if (ulElapsed < (FaultInject_End(pxStep) + FAULT_INJECT_GRACE_TIME))
+        {
+            bCovered = TRUE;
+        }
+        if ((pxStep->ucTarget != ucTarget) || (ulElapsed >= FaultInject_End(pxStep)))
+        {
+            continue;
+        }
+
+        bApplied = TRUE;
+        switch (pxStep->ucFault)
+        {
+        case FAULT_INJECT_STUCK:
+            *pusValue = pxStep->usValue;
+            break;
+        case FAULT_INJECT_SPIKE:
+            if (FaultInject_Fire(ucStep, ulElapsed) == TRUE)
+            {
+                *pusValue = pxStep->usValue;
+            }
+            else
+            {
+                bApplied = FALSE;
+            }
+            break;
+        case FAULT_INJECT_NOISE:
+            ulNoise = FaultInject_Random(FaultInject_Channel(ucTarget)) % (((uint32) pxStep->usValue * 2U) + 1U);
+            slValue = (sint32) *pusValue + (sint32) ulNoise - (sint32) pxStep->usValue;
+            *pusValue = (slValue < 0) ? 0U : ((slValue > (sint32) usMax) ? usMax : (uint16) slValue);
+            break;
+        case FAULT_INJECT_DROP:
+        default:
+            if (FaultInject_Fire(ucStep, ulElapsed) == TRUE)
+            {
+                *pusValue = usLast;
+            }
+            else
+            {
+                bApplied = FALSE;
+            }
+            break;
+        }
+
+        if ((bApplied == TRUE) && (FaultInject_axResult[ucStep].bStarted == FALSE))
+        {
+            /* The latency includes the wait for the first sample of the task */
+            FaultInject_axResult[ucStep].ulStart = (FaultInject_ulRunStart + FaultInject_Begin(pxStep)) & 0xFFFFFFFFUL;
+            FaultInject_axResult[ucStep].bStarted = TRUE;
+        }
+    }
+
+    return bCovered;
+}
+
+/* Step of a target whose window (with the grace time) holds ulTimeStamp, the latest started one */
+static uint8 FaultInject_Cause(uint8 ucTarget, uint8 ucOtherTarget, uint32 ulTimeStamp)
+{
+    const FaultInject_StepType *pxStep;
+    uint32 ulElapsed = FaultInject_Elapsed(ulTimeStamp);
+    uint8 ucCause = FAULT_INJECT_MAX_STEPS;
+    uint8 ucStep;
+
+    for (ucStep = 0; ucStep < FaultInject_ucSteps; ucStep++)
+    {
+        pxStep = &FaultInject_axStep[ucStep];
+        if (((pxStep->ucTarget == ucTarget) || (pxStep->ucTarget == ucOtherTarget)) && (FaultInject_axResult[ucStep].bStarted == TRUE) &&
+            (ulElapsed >= FaultInject_Begin(pxStep)) && (ulElapsed < (FaultInject_End(pxStep) + FAULT_INJECT_GRACE_TIME)) &&
+            ((ucCause == FAULT_INJECT_MAX_STEPS) || (pxStep->ulAt >= FaultInject_axStep[ucCause].ulAt)))
+        {
+            ucCause = ucStep;
+        }
+    }
+
+    return ucCause;
+}
+
+static void FaultInject_Count(uint8 ucStep, uint32 ulTimeStamp)
+{
+    FaultInject_ResultType *pxResult = &FaultInject_axResult[ucStep];
+
+    if (pxResult->usDetections == 0)
+    {
+        pxResult->ulDetection = ulTimeStamp;
+    }
+    if (pxResult->usDetections < 0xFFFFU)
+    {
+        pxResult->usDetections++;
+    }
+}
+
+/*******************************************************************************
+ *                              Public Functions                               *
+ *******************************************************************************/
+
+void FaultInject_Clear(void)
+{
+    uint8 ucButton;
+
+    FaultInject_bRunning = FALSE;
+    FaultInject_ucSteps = 0;
+    for (ucButton = 0; ucButton < FAULT_INJECT_BUTTONS; ucButton++)
+    {
+        FaultInject_abChatter[ucButton] = FALSE;
+        FaultInject_abEdge[ucButton] = FALSE;
+    }
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+Std_ReturnType FaultInject_Add(const FaultInject_StepType *pxStep)
+{
+    if ((FaultInject_bRunning == TRUE) || (FaultInject_ucSteps >= FAULT_INJECT_MAX_STEPS) ||
+        (pxStep->ucTarget >= FAULT_INJECT_TARGET_COUNT) || (pxStep->ucFault >= FAULT_INJECT_FAULT_COUNT) ||
+        ((pxStep->ucFault == FAULT_INJECT_CHATTER) == (FaultInject_IsSensor(pxStep->ucTarget) == TRUE)))
+    {
+        return E_NOT_OK;
+    }
+
+    FaultInject_axStep[FaultInject_ucSteps++] = *pxStep;
+    return E_OK;
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+void FaultInject_Run(uint32 ulNow, uint32 ulSeed)
+{
+    uint8 ucStep;
+    uint8 ucChannel;
+
+    FaultInject_bRunning = FALSE;
+    FaultInject_ulRunStart = ulNow;
+    FaultInject_ulNow = ulNow;
+    FaultInject_ulRunEnd = 0;
+
+    for (ucStep = 0; ucStep < FaultInject_ucSteps; ucStep++)
+    {
+        FaultInject_axResult[ucStep].bStarted = FALSE;
+        FaultInject_axResult[ucStep].usDetections = 0;
+        FaultInject_aulNext[ucStep] = FaultInject_Begin(&FaultInject_axStep[ucStep]);
+        if (FaultInject_End(&FaultInject_axStep[ucStep]) > FaultInject_ulRunEnd)
+        {
+            FaultInject_ulRunEnd = FaultInject_End(&FaultInject_axStep[ucStep]);
+        }
+    }
+    FaultInject_ulRunEnd += FAULT_INJECT_GRACE_TIME;
+
+    for (ucChannel = 0; ucChannel < FAULT_INJECT_CHANNELS; ucChannel++)
+    {
+        FaultInject_aulSeed[ucChannel] = ((ulSeed ^ (0x9E3779B9UL * (ucChannel + 1U))) & 0xFFFFFFFFUL) | 1U;
+        FaultInject_aulFalsePositives[ucChannel] = 0;
+        FaultInject_aulCleanSamples[ucChannel] = 0;
+    }
+
+    FaultInject_bRunning = TRUE;
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+uint8 FaultInject_Tick(uint32 ulNow)
+{
+    const FaultInject_StepType *pxStep;
+    boolean abActive[FAULT_INJECT_BUTTONS] = { FALSE };
+    uint32 ulElapsed;
+    uint32 ulToggle;
+    uint8 ucEdges = 0;
+    uint8 ucButton;
+    uint8 ucStep;
+
+    if (FaultInject_bRunning == FALSE)
+    {
+        return 0;
+    }
+
+    FaultInject_ulNow = ulNow;
+    ulElapsed = FaultInject_Elapsed(ulNow);
+
+    for (ucStep = 0; ucStep < FaultInject_ucSteps; ucStep++)
+    {
+        pxStep = &FaultInject_axStep[ucStep];
+        if ((pxStep->ucFault != FAULT_INJECT_CHATTER) || (ulElapsed < FaultInject_Begin(pxStep)) || (ulElapsed >= FaultInject_End(pxStep)))
+        {
+            continue;
+        }
+
+        ucButton = (uint8) (pxStep->ucTarget - FAULT_INJECT_TARGET_SW1);
+        abActive[ucButton] = TRUE;
+        ulToggle = ((pxStep->usValue == 0) ? 1UL : (uint32) pxStep->usValue) * FAULT_INJECT_TICKS_PER_MS;
+
+        if (FaultInject_axResult[ucStep].bStarted == FALSE)
+        {
+            /* The chatter starts with a press */
+            FaultInject_axResult[ucStep].ulStart = (FaultInject_ulRunStart + FaultInject_Begin(pxStep)) & 0xFFFFFFFFUL;
+            FaultInject_axResult[ucStep].bStarted = TRUE;
+            FaultInject_aulNext[ucStep] = ulElapsed + ulToggle;
+            FaultInject_aucButtonLevel[ucButton] = 1U;
+            FaultInject_abChatter[ucButton] = TRUE;
+            ucEdges |= (uint8) (1U << ucButton);
+        }
+        else if (ulElapsed >= FaultInject_aulNext[ucStep])
+        {
+            FaultInject_aulNext[ucStep] += ulToggle;
+            FaultInject_aucButtonLevel[ucButton] ^= 1U;
+            ucEdges |= (uint8) (1U << ucButton);
+        }
+    }
+
+    for (ucButton = 0; ucButton < FAULT_INJECT_BUTTONS; ucButton++)
+    {
+        /* The step is over: release the button and give the pin back */
+        if ((FaultInject_abChatter[ucButton] == TRUE) && (abActive[ucButton] == FALSE))
+        {
+            if (FaultInject_aucButtonLevel[ucButton] != 0U)
+            {
+                FaultInject_aucButtonLevel[ucButton] = 0U;
+                ucEdges |= (uint8) (1U << ucButton);
+            }
+            else
+            {
+                FaultInject_abChatter[ucButton] = FALSE;
+            }
+        }
+        if ((ucEdges & (1U << ucButton)) != 0U)
+        {
+            FaultInject_abEdge[ucButton] = TRUE;
+        }
+    }
+
+    if (ulElapsed >= FaultInject_ulRunEnd)
+    {
+        FaultInject_bRunning = FALSE;
+    }
+
+    return ucEdges;
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+boolean FaultInject_IsRunning(void)
+{
+    return FaultInject_bRunning;
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+uint8 FaultInject_StepCount(void)
+{
+    return FaultInject_ucSteps;
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+Std_ReturnType FaultInject_Result(uint8 ucStep, FaultInject_StepType *pxStep, FaultInject_ResultType *pxResult)
+{
+    if (ucStep >= FaultInject_ucSteps)
+    {
+        return E_NOT_OK;
+    }
+
+    *pxStep = FaultInject_axStep[ucStep];
+    *pxResult = FaultInject_axResult[ucStep];
+    return E_OK;
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+void FaultInject_Summary(FaultInject_SummaryType *pxSummary)
+{
+    uint8 ucChannel;
+
+    pxSummary->ulFalsePositives = 0;
+    pxSummary->ulCleanSamples = 0;
+    for (ucChannel = 0; ucChannel < FAULT_INJECT_CHANNELS; ucChannel++)
+    {
+        pxSummary->ulFalsePositives += FaultInject_aulFalsePositives[ucChannel];
+        pxSummary->ulCleanSamples += FaultInject_aulCleanSamples[ucChannel];
+    }
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+uint16 FaultInject_Adc(uint8 ucChannel, uint16 usValue)
+{
+    if ((FaultInject_bRunning == FALSE) || (ucChannel >= FAULT_INJECT_CHANNELS))
+    {
+        return usValue;
+    }
+
+    FaultInject_Sensor((uint8) (FAULT_INJECT_TARGET_ADC0 + ucChannel), &usValue, FaultInject_ausLastAdc[ucChannel], FAULT_INJECT_ADC_MAX);
+    FaultInject_ausLastAdc[ucChannel] = usValue;
+
+    return usValue;
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+uint8 FaultInject_Temperature(uint8 ucChannel, uint8 ucValue)
+{
+    uint16 usValue = ucValue;
+
+    if ((FaultInject_bRunning == FALSE) || (ucChannel >= FAULT_INJECT_CHANNELS))
+    {
+        return ucValue;
+    }
+
+    if (FaultInject_Sensor((uint8) (FAULT_INJECT_TARGET_LM35_0 + ucChannel), &usValue, FaultInject_aucLastTemperature[ucChannel],
+                           FAULT_INJECT_TEMPERATURE_MAX) == FALSE)
+    {
+        FaultInject_aulCleanSamples[ucChannel]++;
+    }
+    FaultInject_aucLastTemperature[ucChannel] = (uint8) usValue;
+
+    return (uint8) usValue;
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+uint8 FaultInject_ButtonLevel(uint8 ucButton, uint8 ucLevel)
+{
+    return ((ucButton < FAULT_INJECT_BUTTONS) && (FaultInject_abChatter[ucButton] == TRUE)) ? FaultInject_aucButtonLevel[ucButton] : ucLevel;
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+boolean FaultInject_ButtonEdge(uint8 ucButton)
+{
+    if ((ucButton >= FAULT_INJECT_BUTTONS) || (FaultInject_abEdge[ucButton] == FALSE))
+    {
+        return FALSE;
+    }
+
+    FaultInject_abEdge[ucButton] = FALSE;
+    return TRUE;
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+void FaultInject_ButtonEvent(uint8 ucButton, uint32 ulTimeStamp)
+{
+    uint8 ucTarget = (uint8) (FAULT_INJECT_TARGET_SW1 + ucButton);
+    uint8 ucStep;
+
+    if ((FaultInject_bRunning == FALSE) || (ucButton >= FAULT_INJECT_BUTTONS))
+    {
+        return;
+    }
+
+    ucStep = FaultInject_Cause(ucTarget, ucTarget, ulTimeStamp);
+    if (ucStep < FAULT_INJECT_MAX_STEPS)
+    {
+        FaultInject_Count(ucStep, ulTimeStamp);
+    }
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+void FaultInject_Detected(uint8 ucChannel, uint32 ulTimeStamp)
+{
+    uint8 ucStep;
+
+    if ((FaultInject_bRunning == FALSE) || (ucChannel >= FAULT_INJECT_CHANNELS))
+    {
+        return;
+    }
+
+    ucStep = FaultInject_Cause((uint8) (FAULT_INJECT_TARGET_ADC0 + ucChannel), (uint8) (FAULT_INJECT_TARGET_LM35_0 + ucChannel), ulTimeStamp);
+    if (ucStep < FAULT_INJECT_MAX_STEPS)
+    {
+        FaultInject_Count(ucStep, ulTimeStamp);
+    }
+    else
+    {
+        FaultInject_aulFalsePositives[ucChannel]++;
+    }
+}
@@ -0,0 +1,186 @@
+/*
+ ============================================================================
+ Name        : FaultInject.h
+ Module Name : FaultInject
+ Author      : Ahmed Ali
+ Date        : 22 Sept. 2024
+ Description : Header file for the fault injection of the sensor, ADC and button paths
+ ============================================================================
+ */
+
+#ifndef FAULT_INJECT_H_
+#define FAULT_INJECT_H_
+
+#include "Std_Types.h"
+#include "FaultInject_Hooks.h" /* FAULT_INJECTION and the hooks */
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/* Steps of a scenario */
+#define FAULT_INJECT_MAX_STEPS          16U
+
+/* Sensor channels (ADC channels and LM35 channels are the seat numbers) and buttons (Button_IdType) */
+#define FAULT_INJECT_CHANNELS           2U
+#define FAULT_INJECT_BUTTONS            3U
+
+/*
+ * A sensor failure detected up to this long after the end of a step is still caused by it: the sensor
+ * task needs one more period to see the valid reading again. In timer ticks (0.1 msec).
+ */
+#define FAULT_INJECT_GRACE_TIME         2000UL
+
+/* Timer ticks (0.1 msec) of a millisecond, the scenario times are given in milliseconds */
+#define FAULT_INJECT_TICKS_PER_MS       10UL
+
+/*******************************************************************************
+ *                              Types Declaration                              *
+ *******************************************************************************/
+
+/* Where a fault is injected */
+typedef enum
+{
+    FAULT_INJECT_TARGET_ADC0, /* ADC code of the driver sensor */
+    FAULT_INJECT_TARGET_ADC1, /* ADC code of the passenger sensor */
+    FAULT_INJECT_TARGET_LM35_0, /* Temperature of the driver sensor */
+    FAULT_INJECT_TARGET_LM35_1, /* Temperature of the passenger sensor */
+    FAULT_INJECT_TARGET_SW1,
+    FAULT_INJECT_TARGET_SW2,
+    FAULT_INJECT_TARGET_SW3,
+    FAULT_INJECT_TARGET_COUNT
+} FaultInject_TargetType;
+
+/* What is injected, usValue and ulPeriod of the step */
+typedef enum
+{
+    FAULT_INJECT_STUCK, /* Every sample reads usValue */
+    FAULT_INJECT_SPIKE, /* One sample reads usValue, then one every ulPeriod (0: only the first) */
+    FAULT_INJECT_NOISE, /* Every sample is moved by a random amount of at most +/- usValue */
+    FAULT_INJECT_DROP, /* One conversion is dropped, then one every ulPeriod: the previous sample is read again */
+    FAULT_INJECT_CHATTER, /* Buttons only: the pin toggles every usValue msec, the step ends released */
+    FAULT_INJECT_FAULT_COUNT
+} FaultInject_FaultType;
+
+typedef struct
+{
+    uint32 ulAt; /* Start after FaultInject_Run, in msec */
+    uint32 ulDuration; /* In msec */
+    uint32 ulPeriod; /* In msec */
+    uint16 usValue;
+    uint8 ucTarget;
+    uint8 ucFault;
+} FaultInject_StepType;
+
+/*
+ * Outcome of a step. For a sensor step the detections are the sensor failures it caused, for a chatter
+ * step the button events reported while it ran (each one a false press).
+ */
+typedef struct
+{
+    uint32 ulStart; /* Timestamp of the start of the step, valid once it injected a sample or an edge (bStarted) */
+    uint32 ulDetection; /* Timestamp of the first detection, valid when usDetections is not 0 */
+    uint16 usDetections;
+    boolean bStarted;
+} FaultInject_ResultType;
+
+/* Sensor failures without an injected fault, and the samples they are counted over */
+typedef struct
+{
+    uint32 ulFalsePositives;
+    uint32 ulCleanSamples;
+} FaultInject_SummaryType;
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Stop any run and remove every step.
+ */
+void FaultInject_Clear(void);
+
+/*
+ * Description :
+ * Add a step to the scenario. Returns E_NOT_OK when the scenario is full, while it runs, or for a target
+ * and fault that do not go together (chatter is for buttons only, the other faults for sensors only).
+ */
+Std_ReturnType FaultInject_Add(const FaultInject_StepType *pxStep);
+
+/*
+ * Description :
+ * Start the scenario at ulNow (timer ticks) and clear the results. ulSeed seeds the noise, so a run can
+ * be repeated.
+ */
+void FaultInject_Run(uint32 ulNow, uint32 ulSeed);
+
+/*
+ * Description :
+ * Advance the time of the hooks to ulNow, at least every millisecond while a run is active.
+ * Returns a bit per button (bit n for button n) whose injected level changed: the caller triggers the
+ * GPIO interrupt of each of them, where FAULT_INJECT_BUTTON_EDGE reports the edge.
+ */
+uint8 FaultInject_Tick(uint32 ulNow);
+
+/*
+ * Description :
+ * Returns TRUE while a scenario runs, until the grace time after its last step.
+ */
+boolean FaultInject_IsRunning(void);
+
+/*
+ * Description :
+ * Returns the number of steps of the scenario.
+ */
+uint8 FaultInject_StepCount(void);
+
+/*
+ * Description :
+ * Read a step and its outcome. Returns E_NOT_OK for a step out of range.
+ */
+Std_ReturnType FaultInject_Result(uint8 ucStep, FaultInject_StepType *pxStep, FaultInject_ResultType *pxResult);
+
+/*
+ * Description :
+ * Read the false positives of the run.
+ */
+void FaultInject_Summary(FaultInject_SummaryType *pxSummary);
+
+/*
+ * Description :
+ * ADC code of a sensor channel after the active ADC steps of the channel.
+ */
+uint16 FaultInject_Adc(uint8 ucChannel, uint16 usValue);
+
+/*
+ * Description :
+ * Temperature of a sensor channel after the active LM35 steps, counts the fault free samples.
+ */
+uint8 FaultInject_Temperature(uint8 ucChannel, uint8 ucValue);
+
+/*
+ * Description :
+ * Pin level of a button (1 pressed), the injected one while a chatter step of the button runs.
+ */
+uint8 FaultInject_ButtonLevel(uint8 ucButton, uint8 ucLevel);
+
+/*
+ * Description :
+ * Returns TRUE once for each injected edge of a button, called from its GPIO handler.
+ */
+boolean FaultInject_ButtonEdge(uint8 ucButton);
+
+/*
+ * Description :
+ * A debounced button event at ulTimeStamp, counted against the chatter step of the button.
+ */
+void FaultInject_ButtonEvent(uint8 ucButton, uint32 ulTimeStamp);
+
+/*
+ * Description :
+ * A sensor failure detected at ulTimeStamp, timestamp of its xFailureLog entry.
+ */
+void FaultInject_Detected(uint8 ucChannel, uint32 ulTimeStamp);
+
+#endif /* FAULT_INJECT_H_ */
@@ -0,0 +1,284 @@
+/*
+ ============================================================================
+ Name        : FaultQuery.c
+ Module Name : FaultQuery
+ Author      : Ahmed Ali
+ Date        : 22 Sept. 2024
+ Description : Source file for the time indexed queries over the persistent fault log
+ ============================================================================
+ */
+
+#include "FaultQuery.h"
+
+/* List of a seat and failure code */
+#define FAULT_QUERY_KEY(ucSeat, ucCode) (((ucSeat) * FAULT_QUERY_MAX_CODES) + (ucCode))
+
+/*******************************************************************************
+ *                              Types Declaration                              *
+ *******************************************************************************/
+
+/*
+ * Ring of the records of a list in time order. ulAdded and ulRemoved count the records added and dropped,
+ * the live ones are from ulRemoved to ulAdded - 1 and a record numbered n is at n % FAULT_STORE_RECORDS.
+ * Only the low byte of the sequence numbers is kept: the store holds the last FAULT_STORE_RECORDS records,
+ * fewer than 256, so it is enough to rebuild them from the newest one.
+ */
+typedef struct
+{
+    uint8 aucSequence[FAULT_STORE_RECORDS];
+    uint32 ulAdded;
+    uint32 ulRemoved;
+    uint32 ulLastTimeStamp;
+} FaultQuery_ListType;
+
+/*******************************************************************************
+ *                              Global Variables                               *
+ *******************************************************************************/
+
+static FaultQuery_ListType FaultQuery_axList[FAULT_QUERY_KEYS];
+static uint8 FaultQuery_aucSeat[FAULT_QUERY_MAX_SEATS];
+static uint8 FaultQuery_aucCode[FAULT_QUERY_MAX_CODES];
+static uint32 FaultQuery_ulNewest; /* Sequence number of the last inserted record */
+
+/*******************************************************************************
+ *                              Private Functions                              *
+ *******************************************************************************/
+
+/* Sequence number of record n of a list */
+static uint32 FaultQuery_Sequence(const FaultQuery_ListType *pxList, uint32 ulRecord)
+{
+    return (FaultQuery_ulNewest - ((FaultQuery_ulNewest - pxList->aucSequence[ulRecord % FAULT_STORE_RECORDS]) & 0xFFU)) & 0xFFFFFFFFUL;
+}
+
+/* First record of a list from ulLow with a timestamp after ulTimeStamp, or at it when bInclusive is TRUE */
+static Std_ReturnType FaultQuery_Search(const FaultQuery_ListType *pxList, uint32 ulTimeStamp, boolean bInclusive, uint32 *pulRecord)
+{
+    DiagLog_RecordType xRecord;
+    uint32 ulLow = pxList->ulRemoved;
+    uint32 ulHigh = pxList->ulAdded;
+    uint32 ulMiddle;
+
+    while (ulLow < ulHigh)
+    {
+        ulMiddle = ulLow + ((ulHigh - ulLow) / 2U);
+        if (FaultStore_ReadSequence(FaultQuery_Sequence(pxList, ulMiddle), &xRecord) != E_OK)
+        {
+            return E_NOT_OK;
+        }
+        if ((xRecord.xEntry.ulTimeStamp < ulTimeStamp) || ((bInclusive == FALSE) && (xRecord.xEntry.ulTimeStamp == ulTimeStamp)))
+        {
+            ulLow = ulMiddle + 1U;
+        }
+        else
+        {
+            ulHigh = ulMiddle;
+        }
+    }
+
+    *pulRecord = ulLow;
+    return E_OK;
+}
+
+/* Range of records of a list from ulFrom to ulTo, the lists out of the filter get an empty range */
+static Std_ReturnType FaultQuery_Range(uint8 ucSeat, uint8 ucCode, uint32 ulFrom, uint32 ulTo, uint32 *pulBegin, uint32 *pulEnd)
+{
+    uint8 ucKey;
+
+    if (((ucSeat >= FAULT_QUERY_MAX_SEATS) && (ucSeat != FAULT_QUERY_ALL)) || ((ucCode >= FAULT_QUERY_MAX_CODES) && (ucCode != FAULT_QUERY_ALL)))
+    {
+        return E_NOT_OK;
+    }
+
+    for (ucKey = 0; ucKey < FAULT_QUERY_KEYS; ucKey++)
+    {
+        pulBegin[ucKey] = 0;
+        pulEnd[ucKey] = 0;
+        if (((ucSeat != FAULT_QUERY_ALL) && ((ucKey / FAULT_QUERY_MAX_CODES) != ucSeat)) ||
+            ((ucCode != FAULT_QUERY_ALL) && ((ucKey % FAULT_QUERY_MAX_CODES) != ucCode)) || (ulFrom > ulTo))
+        {
+            continue;
+        }
+        if ((FaultQuery_Search(&FaultQuery_axList[ucKey], ulFrom, TRUE, &pulBegin[ucKey]) != E_OK) ||
+            (FaultQuery_Search(&FaultQuery_axList[ucKey], ulTo, FALSE, &pulEnd[ucKey]) != E_OK))
+        {
+            return E_NOT_OK;
+        }
+    }
+
+    return E_OK;
+}
+
+/*******************************************************************************
+ *                              Public Functions                               *
+ *******************************************************************************/
+
+void FaultQuery_Init(const uint8 *pucSeats, const uint8 *pucCodes)
+{
+    uint8 i;
+
+    for (i = 0; i < FAULT_QUERY_MAX_SEATS; i++)
+    {
+        FaultQuery_aucSeat[i] = pucSeats[i];
+    }
+    for (i = 0; i < FAULT_QUERY_MAX_CODES; i++)
+    {
+        FaultQuery_aucCode[i] = pucCodes[i];
+    }
+    for (i = 0; i < FAULT_QUERY_KEYS; i++)
+    {
+        FaultQuery_axList[i].ulAdded = 0;
+        FaultQuery_axList[i].ulRemoved = 0;
+    }
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+void FaultQuery_Insert(uint32 ulSequence, const DiagLog_EntryType *pxEntry)
+{
+    FaultQuery_ListType *pxList;
+    uint8 ucSeat;
+    uint8 ucCode;
+    uint8 ucKey;
+
+    FaultQuery_ulNewest = ulSequence;
+
+    /* The append overwrote the record FAULT_STORE_RECORDS before it, it can only be the first of a list */
+    for (ucKey = 0; ucKey < FAULT_QUERY_KEYS; ucKey++)
+    {
+        pxList = &FaultQuery_axList[ucKey];
+        if ((pxList->ulRemoved != pxList->ulAdded) &&
+            (((ulSequence - FaultQuery_Sequence(pxList, pxList->ulRemoved)) & 0xFFFFFFFFUL) >= FAULT_STORE_RECORDS))
+        {
+            pxList->ulRemoved++;
+        }
+    }
+
+    for (ucSeat = 0; (ucSeat < FAULT_QUERY_MAX_SEATS) && (FaultQuery_aucSeat[ucSeat] != pxEntry->ucFailureSeat); ucSeat++)
+    {
+    }
+    for (ucCode = 0; (ucCode < FAULT_QUERY_MAX_CODES) && (FaultQuery_aucCode[ucCode] != pxEntry->ucFailureCode); ucCode++)
+    {
+    }
+    if ((ucSeat == FAULT_QUERY_MAX_SEATS) || (ucCode == FAULT_QUERY_MAX_CODES))
+    {
+        return;
+    }
+
+    pxList = &FaultQuery_axList[FAULT_QUERY_KEY(ucSeat, ucCode)];
+    pxList->aucSequence[pxList->ulAdded % FAULT_STORE_RECORDS] = (uint8) ulSequence;
+    pxList->ulAdded++;
+    pxList->ulLastTimeStamp = pxEntry->ulTimeStamp;
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+Std_ReturnType FaultQuery_Count(uint8 ucSeat, uint8 ucCode, uint32 ulFrom, uint32 ulTo, uint16 *pusCount)
+{
+    uint32 aulBegin[FAULT_QUERY_KEYS];
+    uint32 aulEnd[FAULT_QUERY_KEYS];
+    uint8 ucKey;
+
+    if (FaultQuery_Range(ucSeat, ucCode, ulFrom, ulTo, aulBegin, aulEnd) != E_OK)
+    {
+        return E_NOT_OK;
+    }
+
+    *pusCount = 0;
+    for (ucKey = 0; ucKey < FAULT_QUERY_KEYS; ucKey++)
+    {
+        *pusCount += (uint16) (aulEnd[ucKey] - aulBegin[ucKey]);
+    }
+
+    return E_OK;
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+Std_ReturnType FaultQuery_First(uint8 ucSeat, uint8 ucCode, uint32 ulFrom, uint32 ulTo, FaultQuery_CursorType *pxCursor)
+{
+    return FaultQuery_Range(ucSeat, ucCode, ulFrom, ulTo, pxCursor->aulNext, pxCursor->aulEnd);
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+/* The lists are in sequence order each, the next record is the oldest of their next ones */
+Std_ReturnType FaultQuery_Next(FaultQuery_CursorType *pxCursor, DiagLog_RecordType *pxRecord)
+{
+    const FaultQuery_ListType *pxList;
+    uint8 ucKey;
+    uint8 ucNext = FAULT_QUERY_KEYS;
+    uint32 ulAge;
+    uint32 ulOldest = 0;
+
+    for (ucKey = 0; ucKey < FAULT_QUERY_KEYS; ucKey++)
+    {
+        pxList = &FaultQuery_axList[ucKey];
+
+        /* Skip the records overwritten since the last call */
+        if (pxCursor->aulNext[ucKey] < pxList->ulRemoved)
+        {
+            pxCursor->aulNext[ucKey] = pxList->ulRemoved;
+        }
+        if (pxCursor->aulNext[ucKey] >= pxCursor->aulEnd[ucKey])
+        {
+            continue;
+        }
+
+        ulAge = (FaultQuery_ulNewest - FaultQuery_Sequence(pxList, pxCursor->aulNext[ucKey])) & 0xFFFFFFFFUL;
+        if ((ucNext == FAULT_QUERY_KEYS) || (ulAge > ulOldest))
+        {
+            ucNext = ucKey;
+            ulOldest = ulAge;
+        }
+    }
+
+    if (ucNext == FAULT_QUERY_KEYS)
+    {
+        return E_NOT_OK;
+    }
+
+    return FaultStore_ReadSequence(FaultQuery_Sequence(&FaultQuery_axList[ucNext], pxCursor->aulNext[ucNext]++), pxRecord);
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+Std_ReturnType FaultQuery_Summary(uint8 ucSeat, FaultQuery_SummaryType *pxSummary)
+{
+    const FaultQuery_ListType *pxList;
+    DiagLog_RecordType xRecord;
+    boolean bAny = FALSE;
+    uint8 ucCode;
+
+    if (ucSeat >= FAULT_QUERY_MAX_SEATS)
+    {
+        return E_NOT_OK;
+    }
+
+    pxSummary->ulFirstTimeStamp = 0;
+    pxSummary->ulLastTimeStamp = 0;
+    for (ucCode = 0; ucCode < FAULT_QUERY_MAX_CODES; ucCode++)
+    {
+        pxList = &FaultQuery_axList[FAULT_QUERY_KEY(ucSeat, ucCode)];
+        pxSummary->ausCount[ucCode] = (uint16) (pxList->ulAdded - pxList->ulRemoved);
+        if (pxSummary->ausCount[ucCode] == 0)
+        {
+            continue;
+        }
+
+        if (FaultStore_ReadSequence(FaultQuery_Sequence(pxList, pxList->ulRemoved), &xRecord) != E_OK)
+        {
+            return E_NOT_OK;
+        }
+        if ((bAny == FALSE) || (xRecord.xEntry.ulTimeStamp < pxSummary->ulFirstTimeStamp))
+        {
+            pxSummary->ulFirstTimeStamp = xRecord.xEntry.ulTimeStamp;
+        }
+        if ((bAny == FALSE) || (pxList->ulLastTimeStamp > pxSummary->ulLastTimeStamp))
+        {
+            pxSummary->ulLastTimeStamp = pxList->ulLastTimeStamp;
+        }
+        bAny = TRUE;
+    }
+
+    return E_OK;
+}
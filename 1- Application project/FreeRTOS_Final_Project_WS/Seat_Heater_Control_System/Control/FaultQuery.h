@@ -0,0 +1,102 @@
+/*
+ ============================================================================
+ Name        : FaultQuery.h
+ Module Name : FaultQuery
+ Author      : Ahmed Ali
+ Date        : 22 Sept. 2024
+ Description : Header file for the time indexed queries over the persistent fault log
+ ============================================================================
+ */
+
+#ifndef FAULT_QUERY_H_
+#define FAULT_QUERY_H_
+
+#include "Std_Types.h"
+#include "DiagLog.h"
+#include "FaultStore.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/* Seats and failure codes of the index, each pair has its own list of records */
+#define FAULT_QUERY_MAX_SEATS           2U
+#define FAULT_QUERY_MAX_CODES           2U
+#define FAULT_QUERY_KEYS                (FAULT_QUERY_MAX_SEATS * FAULT_QUERY_MAX_CODES)
+
+/* Seat or code filter matching all of them */
+#define FAULT_QUERY_ALL                 0xFFU
+
+/*******************************************************************************
+ *                              Types Declaration                              *
+ *******************************************************************************/
+
+/* Records of a seat in the index */
+typedef struct
+{
+    uint16 ausCount[FAULT_QUERY_MAX_CODES]; /* Per failure code */
+    uint32 ulFirstTimeStamp; /* Valid when a count is not 0 */
+    uint32 ulLastTimeStamp;
+} FaultQuery_SummaryType;
+
+/* Position of a query returning records, see FaultQuery_First */
+typedef struct
+{
+    uint32 aulNext[FAULT_QUERY_KEYS]; /* Next record of each list, as a count of records added to the list */
+    uint32 aulEnd[FAULT_QUERY_KEYS];
+} FaultQuery_CursorType;
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Start an empty index. pucSeats and pucCodes hold the raw seat and failure codes of the records, their
+ * position is the seat and code number of the queries. Only the records appended after this call are
+ * indexed: the timer of the timestamps restarts at every reset, so older records are not in time order
+ * with the new ones.
+ */
+void FaultQuery_Init(const uint8 *pucSeats, const uint8 *pucCodes);
+
+/*
+ * Description :
+ * Add the record just appended to the fault store, with its sequence number, and drop the records the
+ * append overwrote. O(seats x codes). Records with a seat or code out of the index are left out.
+ * The records of a seat must come in time order, which the diagnostic tasks keep.
+ */
+void FaultQuery_Insert(uint32 ulSequence, const DiagLog_EntryType *pxEntry);
+
+/*
+ * Description :
+ * Count the records of a seat and failure code (or FAULT_QUERY_ALL) with a timestamp from ulFrom to ulTo
+ * included. O(log n) EEPROM reads, by a binary search on the timestamps of each list.
+ * Returns E_NOT_OK for a filter out of range or an EEPROM error.
+ * The caller serializes the calls with FaultQuery_Insert and any other EEPROM access.
+ */
+Std_ReturnType FaultQuery_Count(uint8 ucSeat, uint8 ucCode, uint32 ulFrom, uint32 ulTo, uint16 *pusCount);
+
+/*
+ * Description :
+ * Start a query returning the records of FaultQuery_Count, O(log n). FaultQuery_Next then returns them
+ * in sequence order, O(1) each, so the whole query is O(log n + k) for k records. Records appended after
+ * this call are not returned, records overwritten meanwhile are skipped.
+ * The caller serializes the calls with FaultQuery_Insert and any other EEPROM access, but does not have
+ * to hold the EEPROM between them.
+ */
+Std_ReturnType FaultQuery_First(uint8 ucSeat, uint8 ucCode, uint32 ulFrom, uint32 ulTo, FaultQuery_CursorType *pxCursor);
+
+/*
+ * Description :
+ * Read the next record of a query. Returns E_NOT_OK once all of them were returned, or on an EEPROM error.
+ */
+Std_ReturnType FaultQuery_Next(FaultQuery_CursorType *pxCursor, DiagLog_RecordType *pxRecord);
+
+/*
+ * Description :
+ * Summary of the records of a seat, from the counters kept by FaultQuery_Insert and one EEPROM read
+ * per failure code for the first timestamp. Returns E_NOT_OK for a seat out of range or an EEPROM error.
+ */
+Std_ReturnType FaultQuery_Summary(uint8 ucSeat, FaultQuery_SummaryType *pxSummary);
+
+#endif /* FAULT_QUERY_H_ */
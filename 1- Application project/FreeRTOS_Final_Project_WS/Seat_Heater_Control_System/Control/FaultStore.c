@@ -0,0 +1,205 @@
+/*
+ ============================================================================
+ Name        : FaultStore.c
+ Module Name : FaultStore
+ Author      : Ahmed Ali
+ Date        : 22 Sept. 2024
+ Description : Source file for the persistent fault log, a wear levelled ring of records in the EEPROM
+ ============================================================================
+ */
+
+#include "FaultStore.h"
+
+/* Words of a record */
+#define FAULT_STORE_WORD_SEQUENCE       0U
+#define FAULT_STORE_WORD_TIMESTAMP      1U
+#define FAULT_STORE_WORD_FAILURE        2U
+#define FAULT_STORE_WORD_CHECK          3U
+
+/*******************************************************************************
+ *                              Global Variables                               *
+ *******************************************************************************/
+
+static boolean FaultStore_bReady = FALSE;
+static uint16 FaultStore_usNext; /* Record written by the next append */
+static uint16 FaultStore_usCount;
+static uint32 FaultStore_ulNextSequence;
+
+/*******************************************************************************
+ *                              Private Functions                              *
+ *******************************************************************************/
+
+static uint16 FaultStore_Address(uint16 usRecord)
+{
+    return (uint16) (FAULT_STORE_EEPROM_ADDRESS + (usRecord * FAULT_STORE_RECORD_WORDS));
+}
+
+/* Complement of the sum of the other words, so an erased record never passes */
+static uint32 FaultStore_Check(const uint32 *pulRecord)
+{
+    return ~(pulRecord[FAULT_STORE_WORD_SEQUENCE] + pulRecord[FAULT_STORE_WORD_TIMESTAMP] + pulRecord[FAULT_STORE_WORD_FAILURE]);
+}
+
+/*******************************************************************************
+ *                              Public Functions                               *
+ *******************************************************************************/
+
+/*
+ * Records are appended in ring order with consecutive sequence numbers, so from record 0 the sequence
+ * numbers increase up to the newest record, then drop to the oldest one (or to erased records before
+ * the first wrap). The newest record is the last one whose sequence number is at least the one of
+ * record 0. A torn record still holds the sequence number it had before, as that word is written last,
+ * so it does not break the order.
+ */
+Std_ReturnType FaultStore_Init(void)
+{
+    uint32 ulFirst;
+    uint32 ulSequence;
+    uint16 usLow = 0;
+    uint16 usHigh = FAULT_STORE_RECORDS - 1U;
+    uint16 usMiddle;
+
+    FaultStore_bReady = FALSE;
+
+    if (EEPROM_Read(FaultStore_Address(0), &ulFirst, 1) != E_OK)
+    {
+        return E_NOT_OK;
+    }
+
+    if (ulFirst == FAULT_STORE_ERASED)
+    {
+        FaultStore_usNext = 0;
+        FaultStore_usCount = 0;
+        FaultStore_ulNextSequence = 1;
+        FaultStore_bReady = TRUE;
+        return E_OK;
+    }
+
+    while (usLow < usHigh)
+    {
+        usMiddle = (uint16) ((usLow + usHigh + 1U) / 2U);
+        if (EEPROM_Read(FaultStore_Address(usMiddle), &ulSequence, 1) != E_OK)
+        {
+            return E_NOT_OK;
+        }
+        if ((ulSequence != FAULT_STORE_ERASED) && (ulSequence >= ulFirst))
+        {
+            usLow = usMiddle;
+        }
+        else
+        {
+            usHigh = (uint16) (usMiddle - 1U);
+        }
+    }
+
+    if (EEPROM_Read(FaultStore_Address(usLow), &ulSequence, 1) != E_OK)
+    {
+        return E_NOT_OK;
+    }
+    FaultStore_ulNextSequence = ulSequence + 1U;
+    FaultStore_usNext = (uint16) ((usLow + 1U) % FAULT_STORE_RECORDS);
+
+    /* Before the first wrap the records after the newest one are still erased */
+    if (EEPROM_Read(FaultStore_Address(FaultStore_usNext), &ulSequence, 1) != E_OK)
+    {
+        return E_NOT_OK;
+    }
+    FaultStore_usCount = (ulSequence == FAULT_STORE_ERASED) ? (uint16) (usLow + 1U) : (uint16) FAULT_STORE_RECORDS;
+
+    FaultStore_bReady = TRUE;
+    return E_OK;
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+Std_ReturnType FaultStore_Append(const DiagLog_EntryType *pxEntry)
+{
+    uint32 aulRecord[FAULT_STORE_RECORD_WORDS];
+    uint16 usAddress = FaultStore_Address(FaultStore_usNext);
+
+    if (FaultStore_bReady == FALSE)
+    {
+        return E_NOT_OK;
+    }
+
+    aulRecord[FAULT_STORE_WORD_SEQUENCE] = FaultStore_ulNextSequence;
+    aulRecord[FAULT_STORE_WORD_TIMESTAMP] = pxEntry->ulTimeStamp;
+    aulRecord[FAULT_STORE_WORD_FAILURE] = (uint32) pxEntry->ucFailureCode | ((uint32) pxEntry->ucFailureSeat << 8) |
+                                          ((uint32) pxEntry->ucHeatingLevel << 16);
+    aulRecord[FAULT_STORE_WORD_CHECK] = FaultStore_Check(aulRecord);
+
+    /* Payload first, the sequence number commits the record */
+    if ((EEPROM_Write(usAddress + FAULT_STORE_WORD_TIMESTAMP, &aulRecord[FAULT_STORE_WORD_TIMESTAMP], FAULT_STORE_RECORD_WORDS - 1U) != E_OK) ||
+        (EEPROM_Write(usAddress + FAULT_STORE_WORD_SEQUENCE, &aulRecord[FAULT_STORE_WORD_SEQUENCE], 1) != E_OK))
+    {
+        return E_NOT_OK;
+    }
+
+    FaultStore_ulNextSequence++;
+    FaultStore_usNext = (uint16) ((FaultStore_usNext + 1U) % FAULT_STORE_RECORDS);
+    if (FaultStore_usCount < FAULT_STORE_RECORDS)
+    {
+        FaultStore_usCount++;
+    }
+
+    return E_OK;
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+uint16 FaultStore_Count(void)
+{
+    return (FaultStore_bReady == TRUE) ? FaultStore_usCount : 0U;
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+Std_ReturnType FaultStore_Read(uint16 usIndex, DiagLog_RecordType *pxRecord)
+{
+    uint32 aulRecord[FAULT_STORE_RECORD_WORDS];
+    uint16 usRecord;
+
+    if ((FaultStore_bReady == FALSE) || (usIndex >= FaultStore_usCount))
+    {
+        return E_NOT_OK;
+    }
+
+    /* The oldest record is the next one to be overwritten once the ring is full, record 0 before */
+    usRecord = (FaultStore_usCount < FAULT_STORE_RECORDS) ? usIndex : (uint16) ((FaultStore_usNext + usIndex) % FAULT_STORE_RECORDS);
+
+    if ((EEPROM_Read(FaultStore_Address(usRecord), aulRecord, FAULT_STORE_RECORD_WORDS) != E_OK) ||
+        (aulRecord[FAULT_STORE_WORD_SEQUENCE] == FAULT_STORE_ERASED) || (aulRecord[FAULT_STORE_WORD_CHECK] != FaultStore_Check(aulRecord)))
+    {
+        return E_NOT_OK;
+    }
+
+    pxRecord->ulSequence = aulRecord[FAULT_STORE_WORD_SEQUENCE];
+    pxRecord->xEntry.ulTimeStamp = aulRecord[FAULT_STORE_WORD_TIMESTAMP];
+    pxRecord->xEntry.ucFailureCode = (uint8) aulRecord[FAULT_STORE_WORD_FAILURE];
+    pxRecord->xEntry.ucFailureSeat = (uint8) (aulRecord[FAULT_STORE_WORD_FAILURE] >> 8);
+    pxRecord->xEntry.ucHeatingLevel = (uint8) (aulRecord[FAULT_STORE_WORD_FAILURE] >> 16);
+
+    return E_OK;
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+uint32 FaultStore_NextSequence(void)
+{
+    return FaultStore_ulNextSequence;
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+Std_ReturnType FaultStore_ReadSequence(uint32 ulSequence, DiagLog_RecordType *pxRecord)
+{
+    uint32 ulAge = (FaultStore_ulNextSequence - ulSequence) & 0xFFFFFFFFUL; /* 1 for the newest record */
+
+    if ((FaultStore_bReady == FALSE) || (ulAge == 0) || (ulAge > FaultStore_usCount) ||
+        (FaultStore_Read((uint16) (FaultStore_usCount - ulAge), pxRecord) != E_OK) || (pxRecord->ulSequence != ulSequence))
+    {
+        return E_NOT_OK;
+    }
+
+    return E_OK;
+}
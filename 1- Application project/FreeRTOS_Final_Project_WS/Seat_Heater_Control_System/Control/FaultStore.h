@@ -0,0 +1,85 @@
+/*
+ ============================================================================
+ Name        : FaultStore.h
+ Module Name : FaultStore
+ Author      : Ahmed Ali
+ Date        : 22 Sept. 2024
+ Description : Header file for the persistent fault log, a wear levelled ring of records in the EEPROM
+ ============================================================================
+ */
+
+#ifndef FAULT_STORE_H_
+#define FAULT_STORE_H_
+
+#include "Std_Types.h"
+#include "DiagLog.h"
+#include "eeprom.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/*
+ * EEPROM layout: the first block is left to the Settings module, the other blocks hold a ring of
+ * 4 word records, 4 per block: sequence number, timestamp, failure (code, seat, heating level) and a
+ * check word. The ring is written in order, so every block wears at the same rate.
+ */
+#define FAULT_STORE_EEPROM_ADDRESS      EEPROM_BLOCK_WORDS  /* Word address */
+#define FAULT_STORE_RECORD_WORDS        4U
+#define FAULT_STORE_RECORDS             ((EEPROM_SIZE_WORDS - FAULT_STORE_EEPROM_ADDRESS) / FAULT_STORE_RECORD_WORDS)
+
+/* Value of an erased EEPROM word, a sequence number is never that */
+#define FAULT_STORE_ERASED              0xFFFFFFFFUL
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Find the newest record of the ring (EEPROM_Init must have succeeded) with a binary search over the
+ * sequence numbers, O(log records) EEPROM reads. A record torn by a reset while it was written is
+ * skipped, the next append overwrites it.
+ * Returns E_NOT_OK if the EEPROM can not be read, the store is then unusable.
+ */
+Std_ReturnType FaultStore_Init(void);
+
+/*
+ * Description :
+ * Write an entry over the oldest record of the ring, and give it the next sequence number, which keeps
+ * increasing across resets. Busy waits for the EEPROM program cycles, a few milliseconds at most.
+ * The sequence number is written last, so a reset in the middle leaves a record that fails its check.
+ * The caller serializes the calls with any other EEPROM access.
+ */
+Std_ReturnType FaultStore_Append(const DiagLog_EntryType *pxEntry);
+
+/*
+ * Description :
+ * Returns the number of records in the ring, at most FAULT_STORE_RECORDS.
+ */
+uint16 FaultStore_Count(void);
+
+/*
+ * Description :
+ * Read a record, index 0 is the oldest. Returns E_NOT_OK for an index out of range, a torn or
+ * corrupted record, or an EEPROM error.
+ * The caller serializes the calls with any other EEPROM access.
+ */
+Std_ReturnType FaultStore_Read(uint16 usIndex, DiagLog_RecordType *pxRecord);
+
+/*
+ * Description :
+ * Returns the sequence number the next append will get. The records appended since FaultStore_Init have
+ * consecutive sequence numbers, the newest one is FaultStore_NextSequence() - 1.
+ */
+uint32 FaultStore_NextSequence(void);
+
+/*
+ * Description :
+ * Read the record of a sequence number, O(1). Returns E_NOT_OK when it was overwritten, was never
+ * appended, or in the cases of FaultStore_Read.
+ * The caller serializes the calls with any other EEPROM access.
+ */
+Std_ReturnType FaultStore_ReadSequence(uint32 ulSequence, DiagLog_RecordType *pxRecord);
+
+#endif /* FAULT_STORE_H_ */
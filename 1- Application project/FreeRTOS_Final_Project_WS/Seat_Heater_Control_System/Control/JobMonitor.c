@@ -0,0 +1,150 @@
+/*
+ ============================================================================
+ Name        : JobMonitor.c
+ Module Name : JobMonitor
+ Author      : Ahmed Ali
+ Date        : 22 Sept. 2024
+ Description : Source file for the deadline and release jitter monitor of the periodic jobs
+ ============================================================================
+ */
+
+#include "JobMonitor.h"
+#include "Trace.h"
+
+/*******************************************************************************
+ *                              Global Variables                               *
+ *******************************************************************************/
+
+static JobMonitor_StatsType JobMonitor_axStats[JOB_MONITOR_MAX_JOBS];
+static JobMonitor_JobType JobMonitor_axRunning[JOB_MONITOR_MAX_JOBS];
+static boolean JobMonitor_abRunning[JOB_MONITOR_MAX_JOBS];
+static uint32 JobMonitor_ulCyclesPerUs = 1;
+
+/*******************************************************************************
+ *                              Public Functions                               *
+ *******************************************************************************/
+
+void JobMonitor_Init(uint32 ulCyclesPerUs)
+{
+    uint8 ucJob;
+
+    JobMonitor_ulCyclesPerUs = (ulCyclesPerUs > 0) ? ulCyclesPerUs : 1U;
+    for (ucJob = 0; ucJob < JOB_MONITOR_MAX_JOBS; ucJob++)
+    {
+        JobMonitor_SetPeriod(ucJob, 0);
+    }
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+void JobMonitor_SetPeriod(uint8 ucJob, uint32 ulPeriod)
+{
+    JobMonitor_StatsType *pxStats;
+    uint8 ucBucket;
+
+    if (ucJob >= JOB_MONITOR_MAX_JOBS)
+    {
+        return;
+    }
+
+    pxStats = &JobMonitor_axStats[ucJob];
+    pxStats->xLast.ulRelease = 0;
+    pxStats->xLast.ulStart = 0;
+    pxStats->xLast.ulEnd = 0;
+    pxStats->xWorst = pxStats->xLast;
+    pxStats->ullJitterSum = 0;
+    pxStats->ulPeriod = ulPeriod;
+    pxStats->ulJobs = 0;
+    pxStats->ulMisses = 0;
+    pxStats->ulJitterMax = 0;
+    for (ucBucket = 0; ucBucket < JOB_MONITOR_HISTOGRAM_SIZE; ucBucket++)
+    {
+        pxStats->ausJitterHistogram[ucBucket] = 0;
+    }
+    JobMonitor_abRunning[ucJob] = FALSE;
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+void JobMonitor_Start(uint8 ucJob, uint32 ulRelease, uint32 ulStart)
+{
+    if (ucJob >= JOB_MONITOR_MAX_JOBS)
+    {
+        return;
+    }
+
+    JobMonitor_axRunning[ucJob].ulRelease = ulRelease;
+    JobMonitor_axRunning[ucJob].ulStart = ulStart;
+    JobMonitor_abRunning[ucJob] = TRUE;
+    TRACE_RECORD(TRACE_EVENT_JOB_START, ucJob);
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+boolean JobMonitor_End(uint8 ucJob, uint32 ulEnd)
+{
+    JobMonitor_StatsType *pxStats;
+    JobMonitor_JobType *pxJob;
+    uint32 ulJitter;
+    uint32 ulResponse;
+    uint32 ulValue;
+    uint8 ucBucket = 0;
+    boolean bMissed;
+
+    if ((ucJob >= JOB_MONITOR_MAX_JOBS) || (JobMonitor_abRunning[ucJob] == FALSE))
+    {
+        return FALSE;
+    }
+
+    pxStats = &JobMonitor_axStats[ucJob];
+    pxJob = &JobMonitor_axRunning[ucJob];
+    pxJob->ulEnd = ulEnd;
+    JobMonitor_abRunning[ucJob] = FALSE;
+
+    ulJitter = (pxJob->ulStart - pxJob->ulRelease) & 0xFFFFFFFFUL;
+    ulResponse = (ulEnd - pxJob->ulRelease) & 0xFFFFFFFFUL;
+    bMissed = (ulResponse > pxStats->ulPeriod) ? TRUE : FALSE;
+
+    pxStats->ulJobs++;
+    pxStats->ullJitterSum += ulJitter;
+    if (ulJitter > pxStats->ulJitterMax)
+    {
+        pxStats->ulJitterMax = ulJitter;
+    }
+    if ((pxStats->ulJobs == 1U) || (ulResponse > ((pxStats->xWorst.ulEnd - pxStats->xWorst.ulRelease) & 0xFFFFFFFFUL)))
+    {
+        pxStats->xWorst = *pxJob;
+    }
+    pxStats->xLast = *pxJob;
+
+    /* log2 bucket: number of significant bits */
+    for (ulValue = ulJitter / JobMonitor_ulCyclesPerUs; (ulValue != 0) && (ucBucket < (JOB_MONITOR_HISTOGRAM_SIZE - 1U)); ulValue >>= 1)
+    {
+        ucBucket++;
+    }
+    if (pxStats->ausJitterHistogram[ucBucket] < 0xFFFFU)
+    {
+        pxStats->ausJitterHistogram[ucBucket]++;
+    }
+
+    TRACE_RECORD(TRACE_EVENT_JOB_END, ucJob);
+    if (bMissed == TRUE)
+    {
+        pxStats->ulMisses++;
+        TRACE_RECORD(TRACE_EVENT_DEADLINE_MISS, ucJob);
+    }
+    return bMissed;
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+Std_ReturnType JobMonitor_Read(uint8 ucJob, JobMonitor_StatsType *pxStats)
+{
+    if (ucJob >= JOB_MONITOR_MAX_JOBS)
+    {
+        return E_NOT_OK;
+    }
+
+    *pxStats = JobMonitor_axStats[ucJob];
+    return E_OK;
+}
@@ -0,0 +1,90 @@
+/*
+ ============================================================================
+ Name        : JobMonitor.h
+ Module Name : JobMonitor
+ Author      : Ahmed Ali
+ Date        : 22 Sept. 2024
+ Description : Header file for the deadline and release jitter monitor of the periodic jobs
+ ============================================================================
+ */
+
+#ifndef JOB_MONITOR_H_
+#define JOB_MONITOR_H_
+
+#include "Std_Types.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/* Monitored periodic jobs */
+#define JOB_MONITOR_MAX_JOBS            8U
+
+/* Jitter histogram bucket i counts the jitters of i significant bits in usec, the last one counts the rest */
+#define JOB_MONITOR_HISTOGRAM_SIZE      16U
+
+/*******************************************************************************
+ *                              Types Declaration                              *
+ *******************************************************************************/
+
+/* Times of a job, cycle counts */
+typedef struct
+{
+    uint32 ulRelease; /* The job may start: its period boundary */
+    uint32 ulStart; /* The job started running */
+    uint32 ulEnd; /* The job completed */
+} JobMonitor_JobType;
+
+/*
+ * Statistics of a periodic job, in CPU cycles unless noted. The deadline of a job is its next release,
+ * the jitter is the delay from its release to its start and the response time from its release to its
+ * completion.
+ */
+typedef struct
+{
+    JobMonitor_JobType xLast; /* Last completed job */
+    JobMonitor_JobType xWorst; /* Completed job of the longest response time */
+    uint64 ullJitterSum;
+    uint32 ulPeriod;
+    uint32 ulJobs; /* Completed jobs */
+    uint32 ulMisses; /* Jobs completed after their deadline */
+    uint32 ulJitterMax;
+    uint16 ausJitterHistogram[JOB_MONITOR_HISTOGRAM_SIZE];
+} JobMonitor_StatsType;
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Clear every job. ulCyclesPerUs scales the jitter histogram.
+ */
+void JobMonitor_Init(uint32 ulCyclesPerUs);
+
+/*
+ * Description :
+ * Monitor ucJob with a period of ulPeriod cycles, its statistics are cleared.
+ */
+void JobMonitor_SetPeriod(uint8 ucJob, uint32 ulPeriod);
+
+/*
+ * Description :
+ * A job of ucJob released at ulRelease starts at ulStart.
+ */
+void JobMonitor_Start(uint8 ucJob, uint32 ulRelease, uint32 ulStart);
+
+/*
+ * Description :
+ * The running job of ucJob completes at ulEnd. Returns TRUE when it missed its deadline.
+ */
+boolean JobMonitor_End(uint8 ucJob, uint32 ulEnd);
+
+/*
+ * Description :
+ * Read the statistics of a job. Returns E_NOT_OK for a job out of range. The calls of a job must not
+ * run while it reads (a critical section).
+ */
+Std_ReturnType JobMonitor_Read(uint8 ucJob, JobMonitor_StatsType *pxStats);
+
+#endif /* JOB_MONITOR_H_ */
@@ -0,0 +1,260 @@
+/*
+ ============================================================================
+ Name        : LockProfile.c
+ Module Name : LockProfile
+ Author      : Ahmed Ali
+ Date        : 22 Sept. 2024
+ Description : Source file for the mutex contention and blocking time profiler
+ ============================================================================
+ */
+
+#include "LockProfile.h"
+
+#ifdef LOCK_PROFILE_HOST
+/* Host build of the lock profiler test: single threaded, the host gives the cycle count */
+extern uint32 LockProfile_HostCycles(void);
+#define LOCK_PROFILE_CYCLES()           LockProfile_HostCycles()
+#define LOCK_PROFILE_LOCK(ulSaved)      ((ulSaved) = 0)
+#define LOCK_PROFILE_UNLOCK(ulSaved)    ((void) (ulSaved))
+#else
+#include "FreeRTOS.h"
+#include "tm4c123gh6pm_registers.h"
+/* The take failed hook runs outside the kernel critical sections */
+#define LOCK_PROFILE_CYCLES()           DWT_CYCCNT_REG
+#define LOCK_PROFILE_LOCK(ulSaved)      (ulSaved) = portSET_INTERRUPT_MASK_FROM_ISR()
+#define LOCK_PROFILE_UNLOCK(ulSaved)    portCLEAR_INTERRUPT_MASK_FROM_ISR(ulSaved)
+#endif
+
+typedef struct
+{
+    void *pvMutex;
+    uint32 ulTakenAt; /* Cycle count of the take, while held */
+    boolean bHeld;
+} LockProfile_MutexType;
+
+typedef struct
+{
+    uint32 ulWaitSince; /* Cycle count of the first block of the take, while waiting */
+    boolean bWaiting;
+} LockProfile_TaskType;
+
+/*******************************************************************************
+ *                              Global Variables                               *
+ *******************************************************************************/
+
+static LockProfile_MutexType LockProfile_axMutex[LOCK_PROFILE_MAX_MUTEXES];
+static LockProfile_StatsType LockProfile_axStats[LOCK_PROFILE_MAX_MUTEXES];
+static LockProfile_TaskType LockProfile_axTask[LOCK_PROFILE_MAX_TASKS];
+static uint8 LockProfile_ucMutexes;
+
+/* Slot of the mutex of the last block, the priority inheritance hook follows it in the same take */
+static uint8 LockProfile_ucBlocking = LOCK_PROFILE_MAX_MUTEXES;
+
+/*******************************************************************************
+ *                              Private Functions                              *
+ *******************************************************************************/
+
+/* Slot of a mutex, LOCK_PROFILE_MAX_MUTEXES when it is not profiled. Only a few mutexes are profiled. */
+static uint8 LockProfile_Find(const void *pvMutex)
+{
+    uint8 ucIndex;
+
+    for (ucIndex = 0; ucIndex < LockProfile_ucMutexes; ucIndex++)
+    {
+        if (LockProfile_axMutex[ucIndex].pvMutex == pvMutex)
+        {
+            return ucIndex;
+        }
+    }
+    return LOCK_PROFILE_MAX_MUTEXES;
+}
+
+static LockProfile_TaskType *LockProfile_Task(uint32 ulTask)
+{
+    return &LockProfile_axTask[(ulTask < LOCK_PROFILE_MAX_TASKS) ? ulTask : 0U];
+}
+
+static void LockProfile_ClearStats(LockProfile_StatsType *pxStats)
+{
+    pxStats->ullWaitSum = 0;
+    pxStats->ullHoldSum = 0;
+    pxStats->ulAcquisitions = 0;
+    pxStats->ulContended = 0;
+    pxStats->ulTimeouts = 0;
+    pxStats->ulInherits = 0;
+    pxStats->ulWaitMax = 0;
+    pxStats->ulHoldMax = 0;
+}
+
+/*******************************************************************************
+ *                              Public Functions                               *
+ *******************************************************************************/
+
+void LockProfile_Created(void *pvMutex)
+{
+    /* The mutexes are created before the scheduler starts or by one task at a time */
+    if ((pvMutex == NULL_PTR) || (LockProfile_ucMutexes >= LOCK_PROFILE_MAX_MUTEXES))
+    {
+        return;
+    }
+
+    LockProfile_axMutex[LockProfile_ucMutexes].pvMutex = pvMutex;
+    LockProfile_axMutex[LockProfile_ucMutexes].bHeld = FALSE;
+    LockProfile_ClearStats(&LockProfile_axStats[LockProfile_ucMutexes]);
+    LockProfile_ucMutexes++;
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+void LockProfile_Blocking(void *pvMutex, uint32 ulTask)
+{
+    LockProfile_TaskType *pxTask = LockProfile_Task(ulTask);
+    uint32 ulSaved;
+    uint8 ucIndex;
+
+    LOCK_PROFILE_LOCK(ulSaved);
+    ucIndex = LockProfile_Find(pvMutex);
+    LockProfile_ucBlocking = ucIndex;
+
+    /* A task woken by a give may find the mutex taken again and block once more in the same take */
+    if ((ucIndex < LOCK_PROFILE_MAX_MUTEXES) && (pxTask->bWaiting == FALSE))
+    {
+        pxTask->ulWaitSince = LOCK_PROFILE_CYCLES();
+        pxTask->bWaiting = TRUE;
+    }
+    LOCK_PROFILE_UNLOCK(ulSaved);
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+void LockProfile_Taken(void *pvMutex, uint32 ulTask)
+{
+    LockProfile_TaskType *pxTask = LockProfile_Task(ulTask);
+    LockProfile_StatsType *pxStats;
+    uint32 ulSaved;
+    uint32 ulNow;
+    uint32 ulWait;
+    uint8 ucIndex;
+
+    LOCK_PROFILE_LOCK(ulSaved);
+    ucIndex = LockProfile_Find(pvMutex);
+    if (ucIndex < LOCK_PROFILE_MAX_MUTEXES)
+    {
+        pxStats = &LockProfile_axStats[ucIndex];
+        ulNow = LOCK_PROFILE_CYCLES();
+
+        pxStats->ulAcquisitions++;
+        if (pxTask->bWaiting == TRUE)
+        {
+            ulWait = (ulNow - pxTask->ulWaitSince) & 0xFFFFFFFFUL;
+            pxStats->ulContended++;
+            pxStats->ullWaitSum += ulWait;
+            if (ulWait > pxStats->ulWaitMax)
+            {
+                pxStats->ulWaitMax = ulWait;
+            }
+            pxTask->bWaiting = FALSE;
+        }
+
+        LockProfile_axMutex[ucIndex].ulTakenAt = ulNow;
+        LockProfile_axMutex[ucIndex].bHeld = TRUE;
+    }
+    LOCK_PROFILE_UNLOCK(ulSaved);
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+void LockProfile_TakeFailed(void *pvMutex, uint32 ulTask)
+{
+    LockProfile_TaskType *pxTask = LockProfile_Task(ulTask);
+    uint32 ulSaved;
+    uint8 ucIndex;
+
+    LOCK_PROFILE_LOCK(ulSaved);
+    ucIndex = LockProfile_Find(pvMutex);
+
+    /* A take without a block time fails without waiting, it is not a timeout */
+    if ((ucIndex < LOCK_PROFILE_MAX_MUTEXES) && (pxTask->bWaiting == TRUE))
+    {
+        LockProfile_axStats[ucIndex].ulTimeouts++;
+        pxTask->bWaiting = FALSE;
+    }
+    LOCK_PROFILE_UNLOCK(ulSaved);
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+void LockProfile_Given(void *pvMutex)
+{
+    LockProfile_StatsType *pxStats;
+    uint32 ulSaved;
+    uint32 ulHold;
+    uint8 ucIndex;
+
+    LOCK_PROFILE_LOCK(ulSaved);
+    ucIndex = LockProfile_Find(pvMutex);
+
+    /* The kernel gives a new mutex once at its creation, it was not held */
+    if ((ucIndex < LOCK_PROFILE_MAX_MUTEXES) && (LockProfile_axMutex[ucIndex].bHeld == TRUE))
+    {
+        pxStats = &LockProfile_axStats[ucIndex];
+        ulHold = (LOCK_PROFILE_CYCLES() - LockProfile_axMutex[ucIndex].ulTakenAt) & 0xFFFFFFFFUL;
+        pxStats->ullHoldSum += ulHold;
+        if (ulHold > pxStats->ulHoldMax)
+        {
+            pxStats->ulHoldMax = ulHold;
+        }
+        LockProfile_axMutex[ucIndex].bHeld = FALSE;
+    }
+    LOCK_PROFILE_UNLOCK(ulSaved);
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+void LockProfile_Inherited(void)
+{
+    if (LockProfile_ucBlocking < LOCK_PROFILE_MAX_MUTEXES)
+    {
+        LockProfile_axStats[LockProfile_ucBlocking].ulInherits++;
+    }
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+void LockProfile_Clear(void)
+{
+    uint32 ulSaved;
+    uint8 ucIndex;
+
+    LOCK_PROFILE_LOCK(ulSaved);
+    for (ucIndex = 0; ucIndex < LockProfile_ucMutexes; ucIndex++)
+    {
+        LockProfile_ClearStats(&LockProfile_axStats[ucIndex]);
+    }
+    LOCK_PROFILE_UNLOCK(ulSaved);
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+uint8 LockProfile_Count(void)
+{
+    return LockProfile_ucMutexes;
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+Std_ReturnType LockProfile_Read(uint8 ucIndex, void **ppvMutex, LockProfile_StatsType *pxStats)
+{
+    uint32 ulSaved;
+
+    if (ucIndex >= LockProfile_ucMutexes)
+    {
+        return E_NOT_OK;
+    }
+
+    LOCK_PROFILE_LOCK(ulSaved);
+    *ppvMutex = LockProfile_axMutex[ucIndex].pvMutex;
+    *pxStats = LockProfile_axStats[ucIndex];
+    LOCK_PROFILE_UNLOCK(ulSaved);
+    return E_OK;
+}
@@ -0,0 +1,134 @@
+/*
+ ============================================================================
+ Name        : LockProfile.h
+ Module Name : LockProfile
+ Author      : Ahmed Ali
+ Date        : 22 Sept. 2024
+ Description : Header file for the mutex contention and blocking time profiler
+ ============================================================================
+ */
+
+#ifndef LOCK_PROFILE_H_
+#define LOCK_PROFILE_H_
+
+#include "Std_Types.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/*
+ * Set to 1 (here or as a predefined symbol of the build) to profile the mutexes from the kernel trace
+ * hooks of FreeRTOSConfig.h. When 0 the hooks compile to nothing.
+ */
+#ifndef LOCK_PROFILER
+#define LOCK_PROFILER                   0
+#endif
+
+/* Profiled mutexes, in their creation order. The mutexes created once they are used are not profiled. */
+#define LOCK_PROFILE_MAX_MUTEXES        12U
+
+/* Waiting tasks, indexed by the application task tag. The tags out of range share slot 0. */
+#define LOCK_PROFILE_MAX_TASKS          16U
+
+/* Kernel queue type of a mutex (queueQUEUE_TYPE_MUTEX), the hooks ignore the other queues */
+#define LOCK_PROFILE_MUTEX_TYPE         1U
+
+#if (LOCK_PROFILER == 1)
+#define LOCK_PROFILE_CREATED(pvMutex)                   LockProfile_Created(pvMutex)
+#define LOCK_PROFILE_BLOCKING(ucType, pvMutex, ulTask)  do{ if ((ucType) == LOCK_PROFILE_MUTEX_TYPE) { LockProfile_Blocking((pvMutex), (ulTask)); } }while(0)
+#define LOCK_PROFILE_TAKEN(ucType, pvMutex, ulTask)     do{ if ((ucType) == LOCK_PROFILE_MUTEX_TYPE) { LockProfile_Taken((pvMutex), (ulTask)); } }while(0)
+#define LOCK_PROFILE_FAILED(ucType, pvMutex, ulTask)    do{ if ((ucType) == LOCK_PROFILE_MUTEX_TYPE) { LockProfile_TakeFailed((pvMutex), (ulTask)); } }while(0)
+#define LOCK_PROFILE_GIVEN(ucType, pvMutex)             do{ if ((ucType) == LOCK_PROFILE_MUTEX_TYPE) { LockProfile_Given(pvMutex); } }while(0)
+#define LOCK_PROFILE_INHERITED()                        LockProfile_Inherited()
+#else
+#define LOCK_PROFILE_CREATED(pvMutex)
+#define LOCK_PROFILE_BLOCKING(ucType, pvMutex, ulTask)
+#define LOCK_PROFILE_TAKEN(ucType, pvMutex, ulTask)
+#define LOCK_PROFILE_FAILED(ucType, pvMutex, ulTask)
+#define LOCK_PROFILE_GIVEN(ucType, pvMutex)
+#define LOCK_PROFILE_INHERITED()
+#endif
+
+/*******************************************************************************
+ *                              Types Declaration                              *
+ *******************************************************************************/
+
+/*
+ * Statistics of a mutex, times in CPU cycles. The wait of an acquisition runs from the first time the
+ * task blocked on the mutex until it takes it, the hold from the take until the give.
+ */
+typedef struct
+{
+    uint64 ullWaitSum;
+    uint64 ullHoldSum;
+    uint32 ulAcquisitions;
+    uint32 ulContended; /* Acquisitions that waited */
+    uint32 ulTimeouts; /* Takes that gave up after waiting */
+    uint32 ulInherits; /* Priority inheritances of the holder caused by a waiting task */
+    uint32 ulWaitMax;
+    uint32 ulHoldMax;
+} LockProfile_StatsType;
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Kernel hook of a mutex creation (traceCREATE_MUTEX): profile it in the next free slot.
+ */
+void LockProfile_Created(void *pvMutex);
+
+/*
+ * Description :
+ * Kernel hook (traceBLOCKING_ON_QUEUE_RECEIVE): the task of tag ulTask blocks on the mutex. Its wait
+ * starts unless it already blocked on it for the same take.
+ */
+void LockProfile_Blocking(void *pvMutex, uint32 ulTask);
+
+/*
+ * Description :
+ * Kernel hook (traceQUEUE_RECEIVE): the task of tag ulTask takes the mutex.
+ */
+void LockProfile_Taken(void *pvMutex, uint32 ulTask);
+
+/*
+ * Description :
+ * Kernel hook (traceQUEUE_RECEIVE_FAILED): the take of the task of tag ulTask timed out.
+ */
+void LockProfile_TakeFailed(void *pvMutex, uint32 ulTask);
+
+/*
+ * Description :
+ * Kernel hook (traceQUEUE_SEND): the holder gives the mutex back.
+ */
+void LockProfile_Given(void *pvMutex);
+
+/*
+ * Description :
+ * Kernel hook (traceTASK_PRIORITY_INHERIT): the holder of the mutex the running task just blocked on
+ * inherits its priority.
+ */
+void LockProfile_Inherited(void);
+
+/*
+ * Description :
+ * Clear the statistics of every mutex, the mutexes held and the waits in progress are kept.
+ */
+void LockProfile_Clear(void);
+
+/*
+ * Description :
+ * Returns the number of profiled mutexes.
+ */
+uint8 LockProfile_Count(void);
+
+/*
+ * Description :
+ * Read the handle and the statistics of a profiled mutex, ucIndex 0 is the first created.
+ * Returns E_NOT_OK for an index out of range.
+ */
+Std_ReturnType LockProfile_Read(uint8 ucIndex, void **ppvMutex, LockProfile_StatsType *pxStats);
+
+#endif /* LOCK_PROFILE_H_ */
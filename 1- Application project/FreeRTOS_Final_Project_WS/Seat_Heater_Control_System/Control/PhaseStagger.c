@@ -0,0 +1,35 @@
+/*
+ ============================================================================
+ Name        : PhaseStagger.c
+ Module Name : PhaseStagger
+ Author      : Ahmed Ali
+ Date        : 22 Sept. 2024
+ Description : Source file for the placement of the heater on-times in the PWM period
+ ============================================================================
+ */
+
+#include "PhaseStagger.h"
+
+/*******************************************************************************
+ *                              Public Functions                               *
+ *******************************************************************************/
+
+/*
+ * Wrap-around packing: the period is filled like a cylinder, so the on-time of a seat that does not
+ * fit before the end of the period continues from its start. Each layer of the cylinder has at most
+ * one heater on at a time, and there are ceil(total / period) layers.
+ */
+void PhaseStagger_Place(const uint8 *pucDuty, uint8 ucSeats, uint8 *pucStart)
+{
+    uint8 ucPosition = 0;
+    uint8 ucDuty;
+    uint8 i;
+
+    for (i = 0; i < ucSeats; i++)
+    {
+        ucDuty = (pucDuty[i] > PHASE_STAGGER_PERIOD) ? PHASE_STAGGER_PERIOD : pucDuty[i];
+
+        pucStart[i] = ucPosition;
+        ucPosition = (uint8) ((ucPosition + ucDuty) % PHASE_STAGGER_PERIOD);
+    }
+}
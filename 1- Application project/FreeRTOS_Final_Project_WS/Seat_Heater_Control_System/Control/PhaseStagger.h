@@ -0,0 +1,36 @@
+/*
+ ============================================================================
+ Name        : PhaseStagger.h
+ Module Name : PhaseStagger
+ Author      : Ahmed Ali
+ Date        : 22 Sept. 2024
+ Description : Header file for the placement of the heater on-times in the PWM period
+ ============================================================================
+ */
+
+#ifndef PHASE_STAGGER_H_
+#define PHASE_STAGGER_H_
+
+#include "Std_Types.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/* Duties and window starts are in percent of the PWM period */
+#define PHASE_STAGGER_PERIOD            100U
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Place the on-time of each heater in the PWM period: the on-times follow each other in seat order
+ * around the period, and one that runs past the end of the period wraps to its start. Every seat
+ * keeps its duty, and at any instant at most ceil(sum of the duties / PHASE_STAGGER_PERIOD) heaters
+ * are on, the fewest possible for these duties. pucStart receives the start of each on-time.
+ */
+void PhaseStagger_Place(const uint8 *pucDuty, uint8 ucSeats, uint8 *pucStart);
+
+#endif /* PHASE_STAGGER_H_ */
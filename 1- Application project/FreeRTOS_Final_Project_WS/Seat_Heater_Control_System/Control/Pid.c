@@ -0,0 +1,206 @@
+/*
+ ============================================================================
+ Name        : Pid.c
+ Module Name : Pid
+ Author      : Ahmed Ali
+ Date        : 22 Sept. 2024
+ Description : Source file for the fixed point PID controller and its relay auto-tuner
+ ============================================================================
+ */
+
+#include "Pid.h"
+
+/* Pi in Q16.16 */
+#define PID_PI_Q16                  205887L
+
+/*******************************************************************************
+ *                              Private Functions                              *
+ *******************************************************************************/
+
+static Pid_Q16Type Pid_Clamp(sint64 llValue, Pid_Q16Type lMin, Pid_Q16Type lMax)
+{
+    if (llValue > lMax)
+    {
+        return lMax;
+    }
+    if (llValue < lMin)
+    {
+        return lMin;
+    }
+    return (Pid_Q16Type) llValue;
+}
+
+/*******************************************************************************
+ *                              Public Functions                               *
+ *******************************************************************************/
+
+void Pid_Init(Pid_StateType *pxPid, Pid_Q16Type lKp, Pid_Q16Type lKi, Pid_Q16Type lKd, Pid_Q16Type lOutMin, Pid_Q16Type lOutMax)
+{
+    pxPid->lKp = lKp;
+    pxPid->lKi = lKi;
+    pxPid->lKd = lKd;
+    pxPid->lOutMin = lOutMin;
+    pxPid->lOutMax = lOutMax;
+    Pid_Reset(pxPid, 0);
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+void Pid_Reset(Pid_StateType *pxPid, Pid_Q16Type lMeasurement)
+{
+    pxPid->lIntegrator = 0;
+    pxPid->lDerivative = 0;
+    pxPid->lPrevMeasurement = lMeasurement;
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+Pid_Q16Type Pid_Update(Pid_StateType *pxPid, Pid_Q16Type lSetpoint, Pid_Q16Type lMeasurement)
+{
+    Pid_Q16Type lError = lSetpoint - lMeasurement;
+    Pid_Q16Type lProportional = PID_Q16_MUL(pxPid->lKp, lError);
+    Pid_Q16Type lIntegrator;
+    Pid_Q16Type lDerivative;
+    sint64 llOutput;
+
+    /* Derivative on measurement, so a setpoint change does not kick the output, low pass filtered
+     * because the sensor has a 1 degree resolution */
+    lDerivative = -PID_Q16_MUL(pxPid->lKd, lMeasurement - pxPid->lPrevMeasurement);
+    pxPid->lDerivative += PID_Q16_MUL(PID_DERIVATIVE_ALPHA, lDerivative - pxPid->lDerivative);
+    pxPid->lPrevMeasurement = lMeasurement;
+
+    /* Integrator clamped to the output range */
+    lIntegrator = Pid_Clamp((sint64) pxPid->lIntegrator + PID_Q16_MUL(pxPid->lKi, lError), pxPid->lOutMin, pxPid->lOutMax);
+
+    llOutput = (sint64) lProportional + lIntegrator + pxPid->lDerivative;
+
+    /* Conditional integration: keep the previous integral while the output saturates in the direction of the error */
+    if (llOutput > pxPid->lOutMax)
+    {
+        if (lError > 0)
+        {
+            lIntegrator = pxPid->lIntegrator;
+        }
+    }
+    else if (llOutput < pxPid->lOutMin)
+    {
+        if (lError < 0)
+        {
+            lIntegrator = pxPid->lIntegrator;
+        }
+    }
+    pxPid->lIntegrator = lIntegrator;
+
+    return Pid_Clamp(llOutput, pxPid->lOutMin, pxPid->lOutMax);
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+void Pid_AutoTuneStart(Pid_AutoTuneType *pxTune, Pid_Q16Type lOutputLow, Pid_Q16Type lOutputHigh, Pid_Q16Type lHysteresis)
+{
+    pxTune->lOutputLow = lOutputLow;
+    pxTune->lOutputHigh = lOutputHigh;
+    pxTune->lHysteresis = lHysteresis;
+    pxTune->lMax = 0;
+    pxTune->lMin = 0;
+    pxTune->lAmplitudeSum = 0;
+    pxTune->ulPeriodSum = 0;
+    pxTune->usSamples = 0;
+    pxTune->ucCycles = 0;
+    pxTune->bRelayHigh = TRUE;
+    pxTune->eStatus = PID_AUTOTUNE_RUNNING;
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+/*
+ * Relay feedback: the output is switched low above setpoint + hysteresis and high below
+ * setpoint - hysteresis, which makes the measurement oscillate at the ultimate period of the plant.
+ * A cycle starts at each low to high switch; the first one (from the initial heat up) is not measured.
+ */
+Pid_Q16Type Pid_AutoTuneStep(Pid_AutoTuneType *pxTune, Pid_Q16Type lSetpoint, Pid_Q16Type lMeasurement)
+{
+    if (pxTune->eStatus != PID_AUTOTUNE_RUNNING)
+    {
+        return pxTune->lOutputLow;
+    }
+
+    pxTune->usSamples++;
+    if (lMeasurement > pxTune->lMax)
+    {
+        pxTune->lMax = lMeasurement;
+    }
+    if (lMeasurement < pxTune->lMin)
+    {
+        pxTune->lMin = lMeasurement;
+    }
+
+    if ((pxTune->bRelayHigh == TRUE) && (lMeasurement > (lSetpoint + pxTune->lHysteresis)))
+    {
+        pxTune->bRelayHigh = FALSE;
+    }
+    else if ((pxTune->bRelayHigh == FALSE) && (lMeasurement < (lSetpoint - pxTune->lHysteresis)))
+    {
+        pxTune->bRelayHigh = TRUE;
+
+        if (pxTune->ucCycles > 0)
+        {
+            pxTune->ulPeriodSum += pxTune->usSamples;
+            pxTune->lAmplitudeSum += pxTune->lMax - pxTune->lMin;
+        }
+        pxTune->ucCycles++;
+        if (pxTune->ucCycles > PID_AUTOTUNE_CYCLES)
+        {
+            pxTune->eStatus = PID_AUTOTUNE_DONE;
+        }
+
+        pxTune->usSamples = 0;
+        pxTune->lMax = lMeasurement;
+        pxTune->lMin = lMeasurement;
+    }
+
+    if (pxTune->usSamples > PID_AUTOTUNE_MAX_SAMPLES)
+    {
+        pxTune->eStatus = PID_AUTOTUNE_FAILED;
+    }
+
+    return (pxTune->bRelayHigh == TRUE) ? pxTune->lOutputHigh : pxTune->lOutputLow;
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+/*
+ * Ultimate gain Ku = 4 * d / (pi * a), with d the relay amplitude and a the oscillation amplitude,
+ * and ultimate period Pu in samples. Tyreus-Luyben PI rule: Kp = Ku / 3.2, Ti = 2.2 Pu, converted to
+ * the per sample gains of Pid_StateType. No derivative: the seat period is hundreds of samples, so a
+ * Td proportional to it turns every 1 degree step of the sensor into a full scale output kick.
+ */
+Std_ReturnType Pid_AutoTuneApply(const Pid_AutoTuneType *pxTune, Pid_StateType *pxPid)
+{
+    sint64 llRelayAmplitude;
+    sint64 llAmplitude;
+    sint64 llKu;
+    sint64 llKp;
+
+    if ((pxTune->eStatus != PID_AUTOTUNE_DONE) || (pxTune->lAmplitudeSum <= 0) || (pxTune->ulPeriodSum == 0))
+    {
+        return E_NOT_OK;
+    }
+
+    llRelayAmplitude = ((sint64) pxTune->lOutputHigh - pxTune->lOutputLow) / 2;
+    llAmplitude = (sint64) pxTune->lAmplitudeSum / (2 * PID_AUTOTUNE_CYCLES); /* Half of the mean peak to peak */
+    if (llAmplitude == 0)
+    {
+        return E_NOT_OK;
+    }
+
+    llKu = (4 * llRelayAmplitude * PID_Q16_ONE) / ((PID_PI_Q16 * llAmplitude) >> 16);
+    llKp = (llKu * 10) / 32;
+
+    pxPid->lKp = (Pid_Q16Type) llKp;
+    pxPid->lKi = (Pid_Q16Type) ((llKp * PID_AUTOTUNE_CYCLES * 10) / (22 * pxTune->ulPeriodSum));
+    pxPid->lKd = 0;
+    Pid_Reset(pxPid, pxPid->lPrevMeasurement);
+
+    return E_OK;
+}
@@ -0,0 +1,112 @@
+/*
+ ============================================================================
+ Name        : Pid.h
+ Module Name : Pid
+ Author      : Ahmed Ali
+ Date        : 22 Sept. 2024
+ Description : Header file for the fixed point PID controller and its relay auto-tuner
+ ============================================================================
+ */
+
+#ifndef PID_H_
+#define PID_H_
+
+#include "Std_Types.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/* Q16.16 fixed point helpers */
+#define PID_Q16_ONE                 65536L
+#define PID_Q16(x)                  ((Pid_Q16Type) ((x) * 65536.0))         /* Constant to Q16.16, evaluated at compile time */
+#define PID_INT_TO_Q16(x)           ((Pid_Q16Type) (x) * PID_Q16_ONE)
+#define PID_Q16_TO_INT(x)           ((sint32) (((x) + (PID_Q16_ONE / 2)) / PID_Q16_ONE)) /* Rounded, x >= 0 */
+#define PID_Q16_MUL(a, b)           ((Pid_Q16Type) (((sint64) (a) * (sint64) (b)) >> 16))
+
+/* Derivative low pass filter coefficient: the filtered derivative moves by this fraction per sample */
+#define PID_DERIVATIVE_ALPHA        PID_Q16(0.5)
+
+/* Relay auto-tune: number of oscillation cycles averaged, and the give up limit in samples per cycle */
+#define PID_AUTOTUNE_CYCLES         3U
+#define PID_AUTOTUNE_MAX_SAMPLES    4800U
+
+/*******************************************************************************
+ *                              Types Declaration                              *
+ *******************************************************************************/
+
+/* Q16.16 signed fixed point value */
+typedef sint32 Pid_Q16Type;
+
+/*
+ * PID controller state.
+ * The gains are per sample: lKi is Kp * Ts / Ti and lKd is Kp * Td / Ts, so the update does not
+ * depend on the sample period.
+ */
+typedef struct
+{
+    Pid_Q16Type lKp;
+    Pid_Q16Type lKi;
+    Pid_Q16Type lKd;
+    Pid_Q16Type lOutMin;
+    Pid_Q16Type lOutMax;
+    Pid_Q16Type lIntegrator; /* Integral term, kept within the output limits */
+    Pid_Q16Type lDerivative; /* Filtered derivative term */
+    Pid_Q16Type lPrevMeasurement;
+} Pid_StateType;
+
+/* Relay auto-tune progress */
+typedef enum
+{
+    PID_AUTOTUNE_RUNNING,
+    PID_AUTOTUNE_DONE,
+    PID_AUTOTUNE_FAILED
+} Pid_AutoTuneStatusType;
+
+/* Relay auto-tune state */
+typedef struct
+{
+    Pid_Q16Type lOutputLow; /* Relay output levels */
+    Pid_Q16Type lOutputHigh;
+    Pid_Q16Type lHysteresis; /* Relay switches at setpoint +/- hysteresis */
+    Pid_Q16Type lMax; /* Measurement extremes of the current cycle */
+    Pid_Q16Type lMin;
+    Pid_Q16Type lAmplitudeSum; /* Sum of the peak to peak amplitudes of the measured cycles */
+    uint32 ulPeriodSum; /* Sum of the periods of the measured cycles, in samples */
+    uint16 usSamples; /* Samples since the start of the current cycle */
+    uint8 ucCycles; /* Relay cycles started, the first one is not measured */
+    boolean bRelayHigh;
+    Pid_AutoTuneStatusType eStatus;
+} Pid_AutoTuneType;
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/* Set the gains and output limits of a controller and reset it */
+void Pid_Init(Pid_StateType *pxPid, Pid_Q16Type lKp, Pid_Q16Type lKi, Pid_Q16Type lKd, Pid_Q16Type lOutMin, Pid_Q16Type lOutMax);
+
+/* Clear the integral and derivative terms, lMeasurement avoids a derivative kick on the next update */
+void Pid_Reset(Pid_StateType *pxPid, Pid_Q16Type lMeasurement);
+
+/*
+ * Run one controller sample and return the output, within the output limits.
+ * Derivative on measurement (no kick on setpoint changes), integrator clamped to the output limits
+ * and frozen while the output saturates in the direction of the error. No loops or divisions: the
+ * execution time is constant.
+ */
+Pid_Q16Type Pid_Update(Pid_StateType *pxPid, Pid_Q16Type lSetpoint, Pid_Q16Type lMeasurement);
+
+/* Start a relay feedback auto-tune between lOutputLow and lOutputHigh */
+void Pid_AutoTuneStart(Pid_AutoTuneType *pxTune, Pid_Q16Type lOutputLow, Pid_Q16Type lOutputHigh, Pid_Q16Type lHysteresis);
+
+/* Run one auto-tune sample and return the relay output, check eStatus for completion */
+Pid_Q16Type Pid_AutoTuneStep(Pid_AutoTuneType *pxTune, Pid_Q16Type lSetpoint, Pid_Q16Type lMeasurement);
+
+/*
+ * Compute the controller gains from a completed auto-tune (Tyreus-Luyben PI rule)
+ * and load them in pxPid. Returns E_NOT_OK and leaves pxPid unchanged if the auto-tune failed.
+ */
+Std_ReturnType Pid_AutoTuneApply(const Pid_AutoTuneType *pxTune, Pid_StateType *pxPid);
+
+#endif /* PID_H_ */
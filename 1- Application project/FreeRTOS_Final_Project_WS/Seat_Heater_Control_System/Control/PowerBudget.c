@@ -0,0 +1,175 @@
+/*
+ ============================================================================
+ Name        : PowerBudget.c
+ Module Name : PowerBudget
+ Author      : Ahmed Ali
+ Date        : 22 Sept. 2024
+ Description : Source file for the vehicle power budget manager of the seat heaters
+ ============================================================================
+ */
+
+#include "PowerBudget.h"
+
+/* Share of the requests of a priority class that is served: ulNumerator / ulDenominator */
+typedef struct
+{
+    uint32 ulNumerator;
+    uint32 ulDenominator;
+} PowerBudget_ShareType;
+
+/*******************************************************************************
+ *                              Global Variables                               *
+ *******************************************************************************/
+
+static const PowerBudget_SeatConfigType *PowerBudget_pxSeats;
+static uint8 PowerBudget_ucSeats;
+static uint16 PowerBudget_usBudget;
+static PowerBudget_SeatStatusType PowerBudget_axStatus[POWER_BUDGET_MAX_SEATS];
+
+/*******************************************************************************
+ *                              Private Functions                              *
+ *******************************************************************************/
+
+/*
+ * Serve the priority classes in order from the budget: a class gets all its requests while the
+ * remaining budget covers them, the first class that does not fit shares the rest in proportion to
+ * its requests, and the classes after it get nothing.
+ */
+static void PowerBudget_Shares(PowerBudget_ShareType *pxShares)
+{
+    uint32 aulClassRequests[POWER_BUDGET_PRIORITIES] = { 0 };
+    uint32 ulRemaining = PowerBudget_usBudget;
+    uint8 i;
+
+    for (i = 0; i < PowerBudget_ucSeats; i++)
+    {
+        aulClassRequests[PowerBudget_pxSeats[i].ucPriority] += PowerBudget_axStatus[i].usRequested;
+    }
+
+    for (i = 0; i < POWER_BUDGET_PRIORITIES; i++)
+    {
+        if (aulClassRequests[i] <= ulRemaining)
+        {
+            pxShares[i].ulNumerator = 1U;
+            pxShares[i].ulDenominator = 1U;
+            ulRemaining -= aulClassRequests[i];
+        }
+        else
+        {
+            pxShares[i].ulNumerator = ulRemaining;
+            pxShares[i].ulDenominator = aulClassRequests[i];
+            ulRemaining = 0;
+        }
+    }
+}
+
+/* Share of the budget of a seat, rounded down so the shares never add up above the budget */
+static uint16 PowerBudget_Target(const PowerBudget_ShareType *pxShares, uint8 ucSeat)
+{
+    const PowerBudget_ShareType *pxShare = &pxShares[PowerBudget_pxSeats[ucSeat].ucPriority];
+
+    return (uint16) ((PowerBudget_axStatus[ucSeat].usRequested * pxShare->ulNumerator) / pxShare->ulDenominator);
+}
+
+/*******************************************************************************
+ *                              Public Functions                               *
+ *******************************************************************************/
+
+Std_ReturnType PowerBudget_Init(const PowerBudget_SeatConfigType *pxSeats, uint8 ucSeats, uint16 usBudget)
+{
+    uint8 i;
+
+    if (ucSeats > POWER_BUDGET_MAX_SEATS)
+    {
+        return E_NOT_OK;
+    }
+    for (i = 0; i < ucSeats; i++)
+    {
+        if (pxSeats[i].ucPriority >= POWER_BUDGET_PRIORITIES)
+        {
+            return E_NOT_OK;
+        }
+    }
+
+    PowerBudget_pxSeats = pxSeats;
+    PowerBudget_ucSeats = ucSeats;
+    PowerBudget_usBudget = usBudget;
+    for (i = 0; i < POWER_BUDGET_MAX_SEATS; i++)
+    {
+        PowerBudget_axStatus[i].usRequested = 0;
+        PowerBudget_axStatus[i].usGranted = 0;
+        PowerBudget_axStatus[i].ulAllocations = 0;
+        PowerBudget_axStatus[i].ulCurtailed = 0;
+    }
+
+    return E_OK;
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+uint16 PowerBudget_Allocate(uint8 ucSeat, uint16 usRequested)
+{
+    PowerBudget_ShareType axShares[POWER_BUDGET_PRIORITIES];
+    PowerBudget_SeatStatusType *pxStatus = &PowerBudget_axStatus[ucSeat];
+    uint32 ulOthers = 0;
+    uint16 usGranted;
+    uint8 i;
+
+    if (usRequested > PowerBudget_pxSeats[ucSeat].usRatedPower)
+    {
+        usRequested = PowerBudget_pxSeats[ucSeat].usRatedPower;
+    }
+    pxStatus->usRequested = usRequested;
+
+    PowerBudget_Shares(axShares);
+    usGranted = PowerBudget_Target(axShares, ucSeat);
+
+    /* Only the power the other seats do not hold yet */
+    for (i = 0; i < PowerBudget_ucSeats; i++)
+    {
+        if (i != ucSeat)
+        {
+            ulOthers += PowerBudget_axStatus[i].usGranted;
+        }
+    }
+    if ((ulOthers + usGranted) > PowerBudget_usBudget)
+    {
+        usGranted = (ulOthers >= PowerBudget_usBudget) ? 0U : (uint16) (PowerBudget_usBudget - ulOthers);
+    }
+
+    pxStatus->usGranted = usGranted;
+    pxStatus->ulAllocations++;
+    if (usGranted < usRequested)
+    {
+        pxStatus->ulCurtailed++;
+    }
+
+    return usGranted;
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+uint32 PowerBudget_PendingSeats(void)
+{
+    PowerBudget_ShareType axShares[POWER_BUDGET_PRIORITIES];
+    uint32 ulPending = 0;
+    uint8 i;
+
+    PowerBudget_Shares(axShares);
+    for (i = 0; i < PowerBudget_ucSeats; i++)
+    {
+        if (PowerBudget_axStatus[i].usGranted != PowerBudget_Target(axShares, i))
+        {
+            ulPending |= (1UL << i);
+        }
+    }
+
+    return ulPending;
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+const PowerBudget_SeatStatusType *PowerBudget_GetStatus(uint8 ucSeat)
+{
+    return &PowerBudget_axStatus[ucSeat];
+}
@@ -0,0 +1,80 @@
+/*
+ ============================================================================
+ Name        : PowerBudget.h
+ Module Name : PowerBudget
+ Author      : Ahmed Ali
+ Date        : 22 Sept. 2024
+ Description : Header file for the vehicle power budget manager of the seat heaters
+ ============================================================================
+ */
+
+#ifndef POWER_BUDGET_H_
+#define POWER_BUDGET_H_
+
+#include "Std_Types.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/* Heated zones sharing the supply */
+#define POWER_BUDGET_MAX_SEATS          6U
+
+/* Priority classes, 0 is served first */
+#define POWER_BUDGET_PRIORITIES         4U
+
+/*******************************************************************************
+ *                              Types Declaration                              *
+ *******************************************************************************/
+
+/* Configuration of one seat */
+typedef struct
+{
+    uint16 usRatedPower; /* Heater power at full output in W, a request is limited to it */
+    uint8 ucPriority; /* Priority class, 0 to POWER_BUDGET_PRIORITIES - 1 */
+} PowerBudget_SeatConfigType;
+
+/* Allocation status of one seat, for the reports */
+typedef struct
+{
+    uint16 usRequested; /* Last requested power in W */
+    uint16 usGranted; /* Last granted power in W, the seat must not draw more until its next allocation */
+    uint32 ulAllocations; /* Number of allocations */
+    uint32 ulCurtailed; /* Allocations that granted less than the request */
+} PowerBudget_SeatStatusType;
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Set up the budget in W for ucSeats seats, with no power requested or granted.
+ * Returns E_NOT_OK for more than POWER_BUDGET_MAX_SEATS seats or a priority out of range.
+ */
+Std_ReturnType PowerBudget_Init(const PowerBudget_SeatConfigType *pxSeats, uint8 ucSeats, uint16 usBudget);
+
+/*
+ * Description :
+ * Record the power requested by a seat for its next control period and return the power granted to it.
+ * The budget is shared by priority class, and proportionally to the requests within a class when it
+ * can not serve them all. The grant is also limited to what the other seats are not currently granted,
+ * so the total stays within the budget while they have not reallocated yet. O(seats).
+ * The caller serializes the calls.
+ */
+uint16 PowerBudget_Allocate(uint8 ucSeat, uint16 usRequested);
+
+/*
+ * Description :
+ * Returns a bit mask of the seats whose grant differs from their share of the budget, they should
+ * reallocate to give back power or to take the power released by the others. O(seats).
+ */
+uint32 PowerBudget_PendingSeats(void);
+
+/*
+ * Description :
+ * Returns the allocation status of a seat.
+ */
+const PowerBudget_SeatStatusType *PowerBudget_GetStatus(uint8 ucSeat);
+
+#endif /* POWER_BUDGET_H_ */
@@ -0,0 +1,178 @@
+/*
+ ============================================================================
+ Name        : RunStats.c
+ Module Name : RunStats
+ Author      : Ahmed Ali
+ Date        : 22 Sept. 2024
+ Description : Source file for the per task run time accounting with the DWT cycle counter
+ ============================================================================
+ */
+
+#include "RunStats.h"
+#include "FreeRTOS.h"
+#include "tm4c123gh6pm_registers.h"
+
+/* State of the activation in progress of a slot */
+typedef struct
+{
+    uint64 ullSwitchedIn; /* RunStats_Now() at the last switch in */
+    uint32 ulRelease; /* Cycle counter when the activation started */
+    uint32 ulExecution; /* Run so far */
+    boolean bActive;
+} RunStats_ActivationType;
+
+/*******************************************************************************
+ *                              Global Variables                               *
+ *******************************************************************************/
+
+/* The hooks run in the context switch or with the kernel interrupts masked, so they need no lock */
+static RunStats_TaskType RunStats_axTask[RUN_STATS_MAX_SLOTS];
+static RunStats_ActivationType RunStats_axActivation[RUN_STATS_MAX_SLOTS];
+
+static uint64 RunStats_ullNow;
+static uint32 RunStats_ulLastCycles;
+
+/*******************************************************************************
+ *                              Private Functions                              *
+ *******************************************************************************/
+
+static uint32 RunStats_Slot(uint32 ulSlot)
+{
+    return (ulSlot < RUN_STATS_MAX_SLOTS) ? ulSlot : 0U;
+}
+
+static void RunStats_Start(RunStats_ActivationType *pxActivation, uint32 ulCycles)
+{
+    pxActivation->ulRelease = ulCycles;
+    pxActivation->ulExecution = 0;
+    pxActivation->bActive = TRUE;
+}
+
+/*******************************************************************************
+ *                              Public Functions                               *
+ *******************************************************************************/
+
+void RunStats_Init(void)
+{
+    uint8 ucSlot;
+
+    CORE_DEBUG_DEMCR_REG |= (1UL << 24); /* TRCENA */
+    DWT_CTRL_REG |= (1UL << 0); /* CYCCNTENA */
+
+    for (ucSlot = 0; ucSlot < RUN_STATS_MAX_SLOTS; ucSlot++)
+    {
+        RunStats_axTask[ucSlot].ullTotal = 0;
+        RunStats_axTask[ucSlot].ullExecutionSum = 0;
+        RunStats_axTask[ucSlot].ullResponseSum = 0;
+        RunStats_axTask[ucSlot].ulActivations = 0;
+        RunStats_axTask[ucSlot].ulExecutionMin = 0xFFFFFFFFUL;
+        RunStats_axTask[ucSlot].ulExecutionMax = 0;
+        RunStats_axTask[ucSlot].ulResponseMin = 0xFFFFFFFFUL;
+        RunStats_axTask[ucSlot].ulResponseMax = 0;
+        RunStats_axActivation[ucSlot].bActive = FALSE;
+    }
+
+    RunStats_ullNow = 0;
+    RunStats_ulLastCycles = DWT_CYCCNT_REG;
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+uint64 RunStats_Now(void)
+{
+    UBaseType_t uxSavedInterruptStatus;
+    uint32 ulCycles;
+    uint64 ullNow;
+
+    /* Also read by tasks (uxTaskGetSystemState), the extension must not be interleaved with a hook */
+    uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+    ulCycles = DWT_CYCCNT_REG;
+    RunStats_ullNow += (ulCycles - RunStats_ulLastCycles) & 0xFFFFFFFFUL;
+    RunStats_ulLastCycles = ulCycles;
+    ullNow = RunStats_ullNow;
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(uxSavedInterruptStatus);
+
+    return ullNow;
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+void RunStats_Ready(uint32 ulSlot)
+{
+    RunStats_ActivationType *pxActivation = &RunStats_axActivation[RunStats_Slot(ulSlot)];
+
+    /* A running activation is only moved between ready lists (priority inheritance) */
+    if (pxActivation->bActive == FALSE)
+    {
+        RunStats_Start(pxActivation, DWT_CYCCNT_REG);
+    }
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+void RunStats_SwitchedIn(uint32 ulSlot)
+{
+    RunStats_ActivationType *pxActivation = &RunStats_axActivation[RunStats_Slot(ulSlot)];
+
+    pxActivation->ullSwitchedIn = RunStats_Now();
+
+    /* Tasks made ready before they had their tag (at their creation) start here */
+    if (pxActivation->bActive == FALSE)
+    {
+        RunStats_Start(pxActivation, RunStats_ulLastCycles);
+    }
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+void RunStats_SwitchedOut(uint32 ulSlot, boolean bReady)
+{
+    uint32 ulIndex = RunStats_Slot(ulSlot);
+    RunStats_ActivationType *pxActivation = &RunStats_axActivation[ulIndex];
+    RunStats_TaskType *pxTask = &RunStats_axTask[ulIndex];
+    uint64 ullRun = RunStats_Now() - pxActivation->ullSwitchedIn;
+    uint32 ulResponse;
+
+    pxTask->ullTotal += ullRun;
+    pxActivation->ulExecution += (uint32) ullRun;
+
+    if ((bReady == TRUE) || (pxActivation->bActive == FALSE))
+    {
+        return;
+    }
+
+    ulResponse = (RunStats_ulLastCycles - pxActivation->ulRelease) & 0xFFFFFFFFUL;
+    pxTask->ulActivations++;
+    pxTask->ullExecutionSum += pxActivation->ulExecution;
+    pxTask->ullResponseSum += ulResponse;
+    if (pxActivation->ulExecution < pxTask->ulExecutionMin)
+    {
+        pxTask->ulExecutionMin = pxActivation->ulExecution;
+    }
+    if (pxActivation->ulExecution > pxTask->ulExecutionMax)
+    {
+        pxTask->ulExecutionMax = pxActivation->ulExecution;
+    }
+    if (ulResponse < pxTask->ulResponseMin)
+    {
+        pxTask->ulResponseMin = ulResponse;
+    }
+    if (ulResponse > pxTask->ulResponseMax)
+    {
+        pxTask->ulResponseMax = ulResponse;
+    }
+    pxActivation->bActive = FALSE;
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+Std_ReturnType RunStats_Read(uint8 ucSlot, RunStats_TaskType *pxStats)
+{
+    if (ucSlot >= RUN_STATS_MAX_SLOTS)
+    {
+        return E_NOT_OK;
+    }
+
+    *pxStats = RunStats_axTask[ucSlot];
+    return E_OK;
+}
@@ -0,0 +1,112 @@
+/*
+ ============================================================================
+ Name        : RunStats.h
+ Module Name : RunStats
+ Author      : Ahmed Ali
+ Date        : 22 Sept. 2024
+ Description : Header file for the per task run time accounting with the DWT cycle counter
+ ============================================================================
+ */
+
+#ifndef RUN_STATS_H_
+#define RUN_STATS_H_
+
+#include "Std_Types.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/*
+ * Accounting slots, indexed by the application task tag of a task. Slot 0 collects the tasks without
+ * a tag (the time before the startup hook tags the idle and timer tasks), like a tag out of range.
+ */
+#define RUN_STATS_MAX_SLOTS             16U
+
+/*
+ * Set to 1 (here or as a predefined symbol of the build) to account the activations of every task
+ * from the kernel trace hooks of FreeRTOSConfig.h, for the RUNTIME lines of mainRUNTIME_PROFILING.
+ * When 0 the hooks compile to nothing and only the run time counter is kept.
+ */
+#ifndef RUN_STATS_ACTIVATIONS
+#define RUN_STATS_ACTIVATIONS           0
+#endif
+
+#if (RUN_STATS_ACTIVATIONS == 1)
+#define RUN_STATS_READY(ulSlot)                 RunStats_Ready(ulSlot)
+#define RUN_STATS_SWITCHED_IN(ulSlot)           RunStats_SwitchedIn(ulSlot)
+#define RUN_STATS_SWITCHED_OUT(ulSlot, bReady)  RunStats_SwitchedOut((ulSlot), (bReady))
+#else
+#define RUN_STATS_READY(ulSlot)
+#define RUN_STATS_SWITCHED_IN(ulSlot)
+#define RUN_STATS_SWITCHED_OUT(ulSlot, bReady)
+#endif
+
+/*******************************************************************************
+ *                              Types Declaration                              *
+ *******************************************************************************/
+
+/*
+ * Run time of a slot, in CPU cycles. An activation runs from the task becoming ready (or its first
+ * switch in) until it leaves the Running state without staying ready, i.e. blocks, waits for a delay
+ * or is suspended: its execution time is the time it ran in between, its response time the elapsed
+ * time. A task that blocks on a mutex or a queue in the middle of its job ends an activation there.
+ */
+typedef struct
+{
+    uint64 ullTotal; /* Time in the Running state */
+    uint64 ullExecutionSum; /* Of the completed activations */
+    uint64 ullResponseSum;
+    uint32 ulActivations; /* Completed activations */
+    uint32 ulExecutionMin;
+    uint32 ulExecutionMax;
+    uint32 ulResponseMin;
+    uint32 ulResponseMax;
+} RunStats_TaskType;
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Enable the DWT cycle counter and clear every slot. Called by the kernel before the scheduler starts
+ * (portCONFIGURE_TIMER_FOR_RUN_TIME_STATS).
+ */
+void RunStats_Init(void);
+
+/*
+ * Description :
+ * Returns the cycles since RunStats_Init, the 32 bit cycle counter extended to 64 bits. It must be
+ * called at least once per counter period (268 s at 16 MHz), which every context switch does. This
+ * is the run time counter of the kernel (portGET_RUN_TIME_COUNTER_VALUE).
+ */
+uint64 RunStats_Now(void);
+
+/*
+ * Description :
+ * Trace hook: the task of ulSlot became ready, its activation starts unless one is already running.
+ */
+void RunStats_Ready(uint32 ulSlot);
+
+/*
+ * Description :
+ * Trace hook: the task of ulSlot is switched in.
+ */
+void RunStats_SwitchedIn(uint32 ulSlot);
+
+/*
+ * Description :
+ * Trace hook: the task of ulSlot is switched out, bReady is TRUE when it stays in its ready list
+ * (preempted or yielding), otherwise its activation is complete.
+ */
+void RunStats_SwitchedOut(uint32 ulSlot, boolean bReady);
+
+/*
+ * Description :
+ * Read the run time of a slot. Returns E_NOT_OK for a slot out of range. The caller must keep the
+ * kernel from switching tasks while it reads (a critical section).
+ */
+Std_ReturnType RunStats_Read(uint8 ucSlot, RunStats_TaskType *pxStats);
+
+#endif /* RUN_STATS_H_ */
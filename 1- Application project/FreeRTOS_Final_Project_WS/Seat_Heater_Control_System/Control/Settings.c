@@ -0,0 +1,242 @@
+/*
+ ============================================================================
+ Name        : Settings.c
+ Module Name : Settings
+ Author      : Ahmed Ali
+ Date        : 22 Sept. 2024
+ Description : Source file for the per seat heater settings, kept in the EEPROM
+ ============================================================================
+ */
+
+#include "Settings.h"
+#include "eeprom.h"
+
+/* Heater states, in the order of the decision table rows */
+#define SETTINGS_STATE_OFF              0U
+#define SETTINGS_STATE_LOW              1U
+#define SETTINGS_STATE_MEDIUM           2U
+#define SETTINGS_STATE_HIGH             3U
+
+/* Layout of the EEPROM block, a whole number of words */
+typedef struct
+{
+    uint16 usMagic;
+    uint8 ucVersion;
+    uint8 ucSeats;
+    Settings_SeatType axSeat[SETTINGS_NUMBER_OF_SEATS];
+    uint32 ulChecksum; /* Complement of the sum of the words before it */
+} Settings_BlockType;
+
+#define SETTINGS_BLOCK_WORDS            (sizeof(Settings_BlockType) / sizeof(uint32))
+
+typedef union
+{
+    Settings_BlockType xBlock;
+    uint32 aulWords[SETTINGS_BLOCK_WORDS];
+} Settings_EepromType;
+
+/*******************************************************************************
+ *                              Global Variables                               *
+ *******************************************************************************/
+
+Settings_SeatType Settings_axSeat[SETTINGS_NUMBER_OF_SEATS];
+uint8 Settings_aucNextState[SETTINGS_NUMBER_OF_SEATS][SETTINGS_NUMBER_OF_STATES][SETTINGS_TABLE_COLUMNS];
+
+/* The EEPROM can be used, set by Settings_Init only */
+static boolean Settings_bStorage = FALSE;
+
+/*******************************************************************************
+ *                              Private Functions                              *
+ *******************************************************************************/
+
+/* Heater state for a temperature difference, without memory: below the low threshold is off */
+static uint8 Settings_StateForDiff(const Settings_SeatType *pxSeat, uint8 ucDiff)
+{
+    if (ucDiff >= pxSeat->aucThreshold[2])
+    {
+        return SETTINGS_STATE_HIGH;
+    }
+    if (ucDiff >= pxSeat->aucThreshold[1])
+    {
+        return SETTINGS_STATE_MEDIUM;
+    }
+    if (ucDiff >= pxSeat->aucThreshold[0])
+    {
+        return SETTINGS_STATE_LOW;
+    }
+    return SETTINGS_STATE_OFF;
+}
+
+/*
+ * Build the decision table of a seat. Below the low threshold the heater keeps its state (the seat
+ * coasts until it is warmer than desired), otherwise it steps up as soon as the difference reaches a
+ * threshold, but only steps down once the difference is below the threshold by the hysteresis.
+ * With no hysteresis this is the plain threshold ladder.
+ */
+static void Settings_BuildTable(uint8 ucSeat)
+{
+    const Settings_SeatType *pxSeat = &Settings_axSeat[ucSeat];
+    uint8 ucState;
+    uint8 ucDiff;
+    uint8 ucUp;
+    uint8 ucDown;
+
+    for (ucState = 0; ucState < SETTINGS_NUMBER_OF_STATES; ucState++)
+    {
+        for (ucDiff = 0; ucDiff <= SETTINGS_MAX_DIFF; ucDiff++)
+        {
+            ucUp = Settings_StateForDiff(pxSeat, ucDiff);
+            if (ucDiff < pxSeat->aucThreshold[0])
+            {
+                ucUp = ucState;
+            }
+            else if (ucUp < ucState)
+            {
+                ucDown = Settings_StateForDiff(pxSeat, ucDiff + pxSeat->ucHysteresis);
+                ucUp = (ucDown < ucState) ? ucDown : ucState;
+            }
+            Settings_aucNextState[ucSeat][ucState][ucDiff] = ucUp;
+        }
+        Settings_aucNextState[ucSeat][ucState][SETTINGS_OFF_COLUMN] = SETTINGS_STATE_OFF;
+    }
+}
+
+static uint32 Settings_Checksum(const Settings_EepromType *pxEeprom)
+{
+    uint32 ulSum = 0;
+    uint8 i;
+
+    for (i = 0; i < (SETTINGS_BLOCK_WORDS - 1U); i++)
+    {
+        ulSum += pxEeprom->aulWords[i];
+    }
+    return ~ulSum;
+}
+
+/*******************************************************************************
+ *                              Public Functions                               *
+ *******************************************************************************/
+
+Std_ReturnType Settings_Init(const Settings_SeatType *pxDefaults)
+{
+    Settings_EepromType xEeprom;
+    Std_ReturnType xStatus;
+    uint8 ucSeat;
+
+    xStatus = EEPROM_Read(SETTINGS_EEPROM_ADDRESS, xEeprom.aulWords, SETTINGS_BLOCK_WORDS);
+    if ((xStatus != E_OK) || (xEeprom.xBlock.usMagic != SETTINGS_EEPROM_MAGIC)
+            || (xEeprom.xBlock.ucVersion != SETTINGS_EEPROM_VERSION) || (xEeprom.xBlock.ucSeats != SETTINGS_NUMBER_OF_SEATS)
+            || (xEeprom.xBlock.ulChecksum != Settings_Checksum(&xEeprom)))
+    {
+        xStatus = E_NOT_OK;
+    }
+
+    for (ucSeat = 0; ucSeat < SETTINGS_NUMBER_OF_SEATS; ucSeat++)
+    {
+        if ((xStatus != E_OK) || (Settings_Validate(&xEeprom.xBlock.axSeat[ucSeat]) != E_OK))
+        {
+            xStatus = E_NOT_OK;
+        }
+    }
+
+    for (ucSeat = 0; ucSeat < SETTINGS_NUMBER_OF_SEATS; ucSeat++)
+    {
+        Settings_axSeat[ucSeat] = (xStatus == E_OK) ? xEeprom.xBlock.axSeat[ucSeat] : *pxDefaults;
+        Settings_BuildTable(ucSeat);
+    }
+    Settings_bStorage = TRUE;
+
+    return xStatus;
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+void Settings_InitDefaults(const Settings_SeatType *pxDefaults)
+{
+    uint8 ucSeat;
+
+    for (ucSeat = 0; ucSeat < SETTINGS_NUMBER_OF_SEATS; ucSeat++)
+    {
+        Settings_axSeat[ucSeat] = *pxDefaults;
+        Settings_BuildTable(ucSeat);
+    }
+    Settings_bStorage = FALSE;
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+Std_ReturnType Settings_Validate(const Settings_SeatType *pxSeat)
+{
+    uint8 ucLevel;
+
+    if (pxSeat->aucDesiredTemperature[0] != 0)
+    {
+        return E_NOT_OK;
+    }
+    for (ucLevel = 1; ucLevel < SETTINGS_NUMBER_OF_LEVELS; ucLevel++)
+    {
+        if ((pxSeat->aucDesiredTemperature[ucLevel] == 0) || (pxSeat->aucDesiredTemperature[ucLevel] > SETTINGS_MAX_DESIRED_TEMP))
+        {
+            return E_NOT_OK;
+        }
+    }
+
+    if ((pxSeat->aucThreshold[0] == 0) || (pxSeat->aucThreshold[0] >= pxSeat->aucThreshold[1])
+            || (pxSeat->aucThreshold[1] >= pxSeat->aucThreshold[2]) || (pxSeat->aucThreshold[2] > SETTINGS_MAX_DIFF))
+    {
+        return E_NOT_OK;
+    }
+
+    if (pxSeat->ucHysteresis > SETTINGS_MAX_HYSTERESIS)
+    {
+        return E_NOT_OK;
+    }
+
+    return E_OK;
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+Std_ReturnType Settings_Apply(uint8 ucSeat, const Settings_SeatType *pxSeat)
+{
+    if ((ucSeat >= SETTINGS_NUMBER_OF_SEATS) || (Settings_Validate(pxSeat) != E_OK))
+    {
+        return E_NOT_OK;
+    }
+
+    Settings_axSeat[ucSeat] = *pxSeat;
+    Settings_BuildTable(ucSeat);
+
+    return E_OK;
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+Std_ReturnType Settings_Save(void)
+{
+    Settings_EepromType xEeprom;
+    uint8 ucSeat;
+    uint8 i;
+
+    if (Settings_bStorage == FALSE)
+    {
+        return E_NOT_OK;
+    }
+
+    /* Clear the padding of the block too, so the same settings always give the same words */
+    for (i = 0; i < SETTINGS_BLOCK_WORDS; i++)
+    {
+        xEeprom.aulWords[i] = 0;
+    }
+
+    xEeprom.xBlock.usMagic = SETTINGS_EEPROM_MAGIC;
+    xEeprom.xBlock.ucVersion = SETTINGS_EEPROM_VERSION;
+    xEeprom.xBlock.ucSeats = SETTINGS_NUMBER_OF_SEATS;
+    for (ucSeat = 0; ucSeat < SETTINGS_NUMBER_OF_SEATS; ucSeat++)
+    {
+        xEeprom.xBlock.axSeat[ucSeat] = Settings_axSeat[ucSeat];
+    }
+    xEeprom.xBlock.ulChecksum = Settings_Checksum(&xEeprom);
+
+    return EEPROM_Write(SETTINGS_EEPROM_ADDRESS, xEeprom.aulWords, SETTINGS_BLOCK_WORDS);
+}
@@ -0,0 +1,125 @@
+/*
+ ============================================================================
+ Name        : Settings.h
+ Module Name : Settings
+ Author      : Ahmed Ali
+ Date        : 22 Sept. 2024
+ Description : Header file for the per seat heater settings, kept in the EEPROM
+ ============================================================================
+ */
+
+#ifndef SETTINGS_H_
+#define SETTINGS_H_
+
+#include "Std_Types.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+#define SETTINGS_SEAT_DRIVER            0U
+#define SETTINGS_SEAT_PASSENGER         1U
+#define SETTINGS_NUMBER_OF_SEATS        2U
+
+/* Heating levels (off, low, medium, high) and heater states (off, low, medium, high) */
+#define SETTINGS_NUMBER_OF_LEVELS       4U
+#define SETTINGS_NUMBER_OF_STATES       4U
+
+/* Temperature difference thresholds of the low, medium and high heater states */
+#define SETTINGS_NUMBER_OF_THRESHOLDS   3U
+
+/*
+ * Heater decision table columns: the temperature difference 0 to SETTINGS_MAX_DIFF (larger
+ * differences use the last one), then the column of a disabled heater or a seat warmer than desired.
+ */
+#define SETTINGS_TABLE_COLUMNS          16U
+#define SETTINGS_MAX_DIFF               (SETTINGS_TABLE_COLUMNS - 2U)
+#define SETTINGS_OFF_COLUMN             (SETTINGS_TABLE_COLUMNS - 1U)
+
+/* Limits of the settings, checked by Settings_Validate */
+#define SETTINGS_MAX_DESIRED_TEMP       45U  /* Top of the LM35 range */
+#define SETTINGS_MAX_HYSTERESIS         5U
+
+/*
+ * EEPROM layout. A change of Settings_SeatType or of the block must increment the version,
+ * a block with another version is not loaded and the defaults are used.
+ */
+#define SETTINGS_EEPROM_ADDRESS         0U       /* Word address */
+#define SETTINGS_EEPROM_MAGIC           0x5348U  /* "SH" */
+#define SETTINGS_EEPROM_VERSION         1U
+
+/*******************************************************************************
+ *                              Types Declaration                              *
+ *******************************************************************************/
+
+/* Settings of one seat */
+typedef struct
+{
+    uint8 aucDesiredTemperature[SETTINGS_NUMBER_OF_LEVELS]; /* Per heating level in deg C, 0 for the off level */
+    uint8 aucThreshold[SETTINGS_NUMBER_OF_THRESHOLDS]; /* Temperature difference for the low, medium, high states */
+    uint8 ucHysteresis; /* Extra difference needed to step the heater state down, in deg C */
+} Settings_SeatType;
+
+/*******************************************************************************
+ *                              Global Variables                               *
+ *******************************************************************************/
+
+/* Live settings and the heater decision tables built from them, written by the Settings_Init functions and Settings_Apply only */
+extern Settings_SeatType Settings_axSeat[SETTINGS_NUMBER_OF_SEATS];
+extern uint8 Settings_aucNextState[SETTINGS_NUMBER_OF_SEATS][SETTINGS_NUMBER_OF_STATES][SETTINGS_TABLE_COLUMNS];
+
+/*******************************************************************************
+ *                              Access Macros                                  *
+ *******************************************************************************/
+
+/* Desired temperature of a heating level */
+#define SETTINGS_DESIRED_TEMPERATURE(ucSeat, ucLevel) (Settings_axSeat[(ucSeat)].aucDesiredTemperature[(ucLevel)])
+
+/* Temperature difference of the high state threshold of a seat, and its hysteresis */
+#define SETTINGS_HIGH_THRESHOLD(ucSeat) (Settings_axSeat[(ucSeat)].aucThreshold[SETTINGS_NUMBER_OF_THRESHOLDS - 1U])
+#define SETTINGS_HYSTERESIS(ucSeat)     (Settings_axSeat[(ucSeat)].ucHysteresis)
+
+/* Next heater state from the current state and a decision table column */
+#define SETTINGS_NEXT_HEATER_STATE(ucSeat, ucState, ucColumn) (Settings_aucNextState[(ucSeat)][(ucState)][(ucColumn)])
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Load the settings of both seats from the EEPROM (EEPROM_Init must have succeeded) and build the
+ * decision tables. If the block is missing, from another layout version or corrupted, pxDefaults is
+ * used for both seats and E_NOT_OK is returned.
+ */
+Std_ReturnType Settings_Init(const Settings_SeatType *pxDefaults);
+
+/*
+ * Description :
+ * Use pxDefaults for both seats and build the decision tables without any access to the EEPROM, when
+ * EEPROM_Init failed. Settings_Save is refused until Settings_Init is called.
+ */
+void Settings_InitDefaults(const Settings_SeatType *pxDefaults);
+
+/*
+ * Description :
+ * Check the settings of one seat: off level at 0, desired temperatures up to SETTINGS_MAX_DESIRED_TEMP,
+ * 0 < low < medium < high <= SETTINGS_MAX_DIFF thresholds and the hysteresis up to SETTINGS_MAX_HYSTERESIS.
+ */
+Std_ReturnType Settings_Validate(const Settings_SeatType *pxSeat);
+
+/*
+ * Description :
+ * Validate and apply the settings of one seat to the live table, without saving them.
+ * The caller keeps the heater and button tasks out while the table is rebuilt.
+ */
+Std_ReturnType Settings_Apply(uint8 ucSeat, const Settings_SeatType *pxSeat);
+
+/*
+ * Description :
+ * Save the live settings to the EEPROM. Only the words that changed are programmed.
+ * E_NOT_OK is returned without any EEPROM access if the settings came from Settings_InitDefaults.
+ */
+Std_ReturnType Settings_Save(void);
+
+#endif /* SETTINGS_H_ */
@@ -0,0 +1,191 @@
+/*
+ ============================================================================
+ Name        : Trace.c
+ Module Name : Trace
+ Author      : Ahmed Ali
+ Date        : 22 Sept. 2024
+ Description : Source file for the binary kernel event trace recorder
+ ============================================================================
+ */
+
+#include "Trace.h"
+
+#ifdef TRACE_HOST
+/* Host build of the trace converter self test: single threaded, the host gives the cycle count */
+extern uint32 Trace_HostCycles(void);
+#define TRACE_CYCLES()                  Trace_HostCycles()
+#define TRACE_LOCK(ulSaved)             ((ulSaved) = 0)
+#define TRACE_UNLOCK(ulSaved)           ((void) (ulSaved))
+#else
+#include "FreeRTOS.h"
+#include "tm4c123gh6pm_registers.h"
+/* Only raises BASEPRI, so valid from the kernel hooks, the tasks and the ISRs */
+#define TRACE_CYCLES()                  DWT_CYCCNT_REG
+#define TRACE_LOCK(ulSaved)             (ulSaved) = portSET_INTERRUPT_MASK_FROM_ISR()
+#define TRACE_UNLOCK(ulSaved)           portCLEAR_INTERRUPT_MASK_FROM_ISR(ulSaved)
+#endif
+
+typedef struct
+{
+    const char *pcName;
+    uint8 ucType;
+} Trace_QueueType;
+
+/*******************************************************************************
+ *                              Global Variables                               *
+ *******************************************************************************/
+
+static Trace_RecordType Trace_axBuffer[TRACE_BUFFER_RECORDS];
+static uint16 Trace_usHead; /* Next record written */
+static uint16 Trace_usCount;
+static uint32 Trace_ulLost;
+
+/* Cycle count of the time of the last record, the remainder below a time unit is carried to the next one */
+static uint32 Trace_ulLastCycles;
+static boolean Trace_bRunning = FALSE;
+
+static Trace_QueueType Trace_axQueue[TRACE_MAX_QUEUES];
+static uint8 Trace_ucQueues;
+
+/*******************************************************************************
+ *                              Private Functions                              *
+ *******************************************************************************/
+
+static void Trace_Put(uint16 usDelta, uint8 ucEvent, uint8 ucObject)
+{
+    Trace_RecordType *pxRecord = &Trace_axBuffer[Trace_usHead];
+
+    pxRecord->usDelta = usDelta;
+    pxRecord->ucEvent = ucEvent;
+    pxRecord->ucObject = ucObject;
+
+    Trace_usHead = (Trace_usHead + 1U) % TRACE_BUFFER_RECORDS;
+    if (Trace_usCount < TRACE_BUFFER_RECORDS)
+    {
+        Trace_usCount++;
+    }
+    else
+    {
+        Trace_ulLost++;
+    }
+}
+
+/*******************************************************************************
+ *                              Public Functions                               *
+ *******************************************************************************/
+
+void Trace_Start(void)
+{
+    uint32 ulSaved;
+
+    TRACE_LOCK(ulSaved);
+    Trace_usHead = 0;
+    Trace_usCount = 0;
+    Trace_ulLost = 0;
+    Trace_ulLastCycles = TRACE_CYCLES();
+    Trace_bRunning = TRUE;
+    TRACE_UNLOCK(ulSaved);
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+void Trace_Stop(void)
+{
+    Trace_bRunning = FALSE;
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+boolean Trace_IsRunning(void)
+{
+    return Trace_bRunning;
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+/*
+ * The delta of a record fits 16 bits unless nothing was recorded for 65 msec (at 16 MHz), every
+ * context switch records one. The cycle counter wraps every 268 s, a longer silence is not seen.
+ */
+void Trace_Record(uint8 ucEvent, uint8 ucObject)
+{
+    uint32 ulSaved;
+    uint32 ulDelta;
+
+    if (Trace_bRunning == FALSE)
+    {
+        return;
+    }
+
+    TRACE_LOCK(ulSaved);
+    ulDelta = ((TRACE_CYCLES() - Trace_ulLastCycles) & 0xFFFFFFFFUL) >> TRACE_TIME_SHIFT;
+    Trace_ulLastCycles += ulDelta << TRACE_TIME_SHIFT;
+
+    if (ulDelta > 0xFFFFUL)
+    {
+        Trace_Put((uint16) (ulDelta >> 16), TRACE_EVENT_TIME, 0);
+    }
+    Trace_Put((uint16) ulDelta, ucEvent, ucObject);
+    TRACE_UNLOCK(ulSaved);
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+uint16 Trace_Count(uint32 *pulLost)
+{
+    *pulLost = Trace_ulLost;
+    return Trace_usCount;
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+Std_ReturnType Trace_Read(uint16 usIndex, Trace_RecordType *pxRecord)
+{
+    if (usIndex >= Trace_usCount)
+    {
+        return E_NOT_OK;
+    }
+
+    *pxRecord = Trace_axBuffer[(Trace_usHead + TRACE_BUFFER_RECORDS - Trace_usCount + usIndex) % TRACE_BUFFER_RECORDS];
+    return E_OK;
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+uint8 Trace_QueueCreated(uint8 ucType)
+{
+    /* The queues are created before the scheduler starts or by one task at a time */
+    if (Trace_ucQueues >= TRACE_MAX_QUEUES)
+    {
+        return 0;
+    }
+
+    Trace_axQueue[Trace_ucQueues].pcName = NULL_PTR;
+    Trace_axQueue[Trace_ucQueues].ucType = ucType;
+    Trace_ucQueues++;
+    return Trace_ucQueues;
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+void Trace_QueueName(uint8 ucQueue, const char *pcName)
+{
+    if ((ucQueue > 0) && (ucQueue <= Trace_ucQueues))
+    {
+        Trace_axQueue[ucQueue - 1U].pcName = pcName;
+    }
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+Std_ReturnType Trace_QueueInfo(uint8 ucQueue, uint8 *pucType, const char **ppcName)
+{
+    if ((ucQueue == 0) || (ucQueue > Trace_ucQueues))
+    {
+        return E_NOT_OK;
+    }
+
+    *pucType = Trace_axQueue[ucQueue - 1U].ucType;
+    *ppcName = Trace_axQueue[ucQueue - 1U].pcName;
+    return E_OK;
+}
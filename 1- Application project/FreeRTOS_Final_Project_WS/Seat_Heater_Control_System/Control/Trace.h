@@ -0,0 +1,152 @@
+/*
+ ============================================================================
+ Name        : Trace.h
+ Module Name : Trace
+ Author      : Ahmed Ali
+ Date        : 22 Sept. 2024
+ Description : Header file for the binary kernel event trace recorder
+ ============================================================================
+ */
+
+#ifndef TRACE_H_
+#define TRACE_H_
+
+#include "Std_Types.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/*
+ * Set to 1 (here or as a predefined symbol of the build) to record the kernel trace hooks of
+ * FreeRTOSConfig.h and the application ISRs. When 0 the hooks compile to nothing and the module is
+ * not needed.
+ */
+#ifndef TRACE_RECORDER
+#define TRACE_RECORDER                  0
+#endif
+
+/* Records of the ring buffer, 4 bytes each. The oldest records are overwritten when it is full. */
+#define TRACE_BUFFER_RECORDS            1024U
+
+/* The timestamps are kept in units of 2^TRACE_TIME_SHIFT CPU cycles, 1 usec at 16 MHz */
+#define TRACE_TIME_SHIFT                4U
+
+/* Set to 1 to also record every tick interrupt, about 1000 records per second */
+#define TRACE_TICKS                     0
+
+/* Queue numbers given by Trace_QueueCreated, 0 is the number of a queue created without one */
+#define TRACE_MAX_QUEUES                32U
+
+/* Event of a record, the object is given for each one */
+#define TRACE_EVENT_TIME                0U  /* Adds usDelta * 65536 to the time of the next record */
+#define TRACE_EVENT_TASK_SWITCHED_IN    1U  /* Task tag */
+#define TRACE_EVENT_TASK_READY          2U  /* Task tag */
+#define TRACE_EVENT_TASK_DELAY          3U  /* Task tag of the running task */
+#define TRACE_EVENT_TASK_NOTIFY_WAIT    4U  /* Task tag of the running task, it blocks on its notification */
+#define TRACE_EVENT_TASK_NOTIFY         5U  /* Task tag of the notified task */
+#define TRACE_EVENT_QUEUE_SEND          6U  /* Queue number, also the give of a semaphore or a mutex */
+#define TRACE_EVENT_QUEUE_SEND_FAILED   7U  /* Queue number */
+#define TRACE_EVENT_QUEUE_RECEIVE       8U  /* Queue number, also the take of a semaphore or a mutex */
+#define TRACE_EVENT_QUEUE_RECEIVE_FAILED 9U /* Queue number */
+#define TRACE_EVENT_QUEUE_BLOCK_SEND    10U /* Queue number, the running task blocks */
+#define TRACE_EVENT_QUEUE_BLOCK_RECEIVE 11U /* Queue number, the running task blocks */
+#define TRACE_EVENT_ISR_ENTER           12U /* IRQ number */
+#define TRACE_EVENT_ISR_EXIT            13U /* IRQ number */
+#define TRACE_EVENT_TICK                14U /* Low byte of the tick count */
+#define TRACE_EVENT_PRIORITY_INHERIT    15U /* Task tag of the mutex holder */
+#define TRACE_EVENT_PRIORITY_DISINHERIT 16U /* Task tag of the mutex holder */
+#define TRACE_EVENT_JOB_START           17U /* Periodic job number (JobMonitor) */
+#define TRACE_EVENT_JOB_END             18U /* Periodic job number */
+#define TRACE_EVENT_DEADLINE_MISS       19U /* Periodic job number, the job completed after its next release */
+#define TRACE_EVENT_HEATER_INPUT        20U /* Seat, its temperature reading or desired temperature changed */
+#define TRACE_EVENT_HEATER_OUTPUT       21U /* Seat, its heater task wrote a new duty cycle or heater LEDs */
+
+#if (TRACE_RECORDER == 1)
+#define TRACE_RECORD(ucEvent, ucObject)     Trace_Record((ucEvent), (uint8) (ucObject))
+#define TRACE_ISR_ENTER(ucIrq)              Trace_Record(TRACE_EVENT_ISR_ENTER, (ucIrq))
+#define TRACE_ISR_EXIT(ucIrq)               Trace_Record(TRACE_EVENT_ISR_EXIT, (ucIrq))
+#else
+#define TRACE_RECORD(ucEvent, ucObject)
+#define TRACE_ISR_ENTER(ucIrq)
+#define TRACE_ISR_EXIT(ucIrq)
+#endif
+
+/*******************************************************************************
+ *                              Types Declaration                              *
+ *******************************************************************************/
+
+/*
+ * A record, usDelta is the time since the previous record in units of 2^TRACE_TIME_SHIFT cycles.
+ * A longer time is split: a TRACE_EVENT_TIME record with the high 16 bits comes first.
+ */
+typedef struct
+{
+    uint16 usDelta;
+    uint8 ucEvent;
+    uint8 ucObject;
+} Trace_RecordType;
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Clear the buffer and start recording.
+ */
+void Trace_Start(void);
+
+/*
+ * Description :
+ * Stop recording, the buffer is kept until the next start.
+ */
+void Trace_Stop(void);
+
+/*
+ * Description :
+ * Returns TRUE while recording.
+ */
+boolean Trace_IsRunning(void);
+
+/*
+ * Description :
+ * Record an event, from a task, an ISR or a kernel hook. Nothing is recorded while stopped.
+ */
+void Trace_Record(uint8 ucEvent, uint8 ucObject);
+
+/*
+ * Description :
+ * Returns the number of records in the buffer, and in pulLost the number of records overwritten
+ * since the start.
+ */
+uint16 Trace_Count(uint32 *pulLost);
+
+/*
+ * Description :
+ * Read a record, usIndex 0 is the oldest. Returns E_NOT_OK for an index out of range.
+ * Read the buffer once recording is stopped.
+ */
+Std_ReturnType Trace_Read(uint16 usIndex, Trace_RecordType *pxRecord);
+
+/*
+ * Description :
+ * Kernel hook of a queue creation (traceQUEUE_CREATE), also the semaphores and mutexes.
+ * Returns the number of the new queue, stored as its queue number, 0 once TRACE_MAX_QUEUES are used.
+ */
+uint8 Trace_QueueCreated(uint8 ucType);
+
+/*
+ * Description :
+ * Kernel hook of vQueueAddToRegistry (traceQUEUE_REGISTRY_ADD): the name of a queue in the dump.
+ */
+void Trace_QueueName(uint8 ucQueue, const char *pcName);
+
+/*
+ * Description :
+ * Read the kernel type (queueQUEUE_TYPE_...) and name (NULL when it has none) of a queue number.
+ * Returns E_NOT_OK for a number not given.
+ */
+Std_ReturnType Trace_QueueInfo(uint8 ucQueue, uint8 *pucType, const char **ppcName);
+
+#endif /* TRACE_H_ */
@@ -19,7 +19,10 @@
 #define FREERTOS_CONFIG_H
 
 #include "Std_Types.h"
-#include "GPTM.h"
+#include "RunStats.h"
+#include "Trace.h"
+#include "LockProfile.h"
+#include "CpuLoad.h"
 
 /******************************************************************************/
 /* Scheduling behavior related definitions. **********************************/
@@ -62,10 +65,23 @@
  * section. */
 #define configTOTAL_HEAP_SIZE                 ((size_t)(8192))
 
+/* Set configSUPPORT_STATIC_ALLOCATION to 1 to create every kernel object from
+ * RAM allocated at compile time (see mainCREATE_* in main.c); the RAM budget report
+ * of all the objects is generated on the host. Set configSUPPORT_DYNAMIC_ALLOCATION
+ * to 0 to remove the FreeRTOS heap completely, heap_1.c is then excluded from the
+ * build (see .cproject) and configTOTAL_HEAP_SIZE is not used. */
+#define configSUPPORT_STATIC_ALLOCATION        1
+#define configSUPPORT_DYNAMIC_ALLOCATION       0
+
 /* Set the following configUSE_* constants to 1 to include the named feature in
  * the build, or 0 to exclude the named feature from the build. */
 #define configUSE_MUTEXES                      1
 #define configUSE_APPLICATION_TASK_TAG         1
+#define configUSE_TRACE_FACILITY               1
+
+/* Queues, semaphores and mutexes named for the kernel aware debuggers and the trace dump: the
+ * application objects (mainCREATE_* in main.c) and the timer command queue. */
+#define configQUEUE_REGISTRY_SIZE              16
 
 /******************************************************************************/
 /* Definitions that include or exclude functionality. *************************/
@@ -77,6 +93,9 @@
 #define INCLUDE_vTaskDelay                      1
 #define INCLUDE_xTimerPendFunctionCall          1
 #define INCLUDE_vTaskDelayUntil                 1
+#define INCLUDE_uxTaskGetStackHighWaterMark     1
+#define INCLUDE_xTaskGetIdleTaskHandle          1
+#define INCLUDE_xTimerGetTimerDaemonTaskHandle  1
 
 /******************************************************************************/
 /* Software timer related definitions. ****************************************/
@@ -111,9 +130,10 @@
 /* Set the following configUSE_* constants to 1 to include the named hook
  * functionality in the build.  Set to 0 to exclude the hook functionality from the
  * build.  The application writer is responsible for providing the hook function
- * for any set to 1. */
-#define configUSE_IDLE_HOOK                   0
-#define configUSE_TICK_HOOK                   0
+ * for any set to 1. The idle and tick hooks measure the CPU load windows (CpuLoad module). */
+#define configUSE_IDLE_HOOK                   CPU_LOAD_MONITOR
+#define configUSE_TICK_HOOK                   CPU_LOAD_MONITOR
+#define configUSE_DAEMON_TASK_STARTUP_HOOK    1
 
 /******************************************************************************/
 /* ARM Cortex-M Specific Definitions. *****************************************/
@@ -147,29 +167,127 @@
 /* Normal assert() semantics without relying on the provision of an assert.h header file. */
 #define configASSERT( x ) if( ( x ) == 0 ) { taskDISABLE_INTERRUPTS(); for( ;; ); }
 
+/* Check for stack overflow on every context switch using both the stack pointer
+ * limit and the fill pattern at the end of the stack (method 2). The application
+ * must provide vApplicationStackOverflowHook(). */
+#define configCHECK_FOR_STACK_OVERFLOW        2
+
 /******************************************************************************/
 /* RTOS Runtime Measurements. *************************************************/
 /******************************************************************************/
 
 /* Define number of tasks in systems */
-#define mainTOTAL_NUMBER_OF_TASKS           10
-
-/* Arrays to store timestamp for runtime measurements (NOTE: the + 1 for the idle task) */
-extern uint32 ullTasksOutTime[mainTOTAL_NUMBER_OF_TASKS + 1];
-extern uint32 ullTasksInTime[mainTOTAL_NUMBER_OF_TASKS + 1];
-extern uint32 ullTasksTotalTime[mainTOTAL_NUMBER_OF_TASKS + 1];
-
-#define traceTASK_SWITCHED_IN()                                    \
-do{                                                                \
-    uint32 taskInTag = (uint32)(pxCurrentTCB->pxTaskTag);          \
-    ullTasksInTime[taskInTag] = GPTM_WTimer0Read();                \
-}while(0);
-
-#define traceTASK_SWITCHED_OUT()                                                                 \
-do{                                                                                              \
-    uint32 taskOutTag = (uint32)(pxCurrentTCB->pxTaskTag);                                       \
-    ullTasksOutTime[taskOutTag] = GPTM_WTimer0Read();                                            \
-    ullTasksTotalTime[taskOutTag] += ullTasksOutTime[taskOutTag] - ullTasksInTime[taskOutTag];   \
-}while(0);
+#define mainTOTAL_NUMBER_OF_TASKS           12
+
+/*
+ * Application task tags, the RunStats slot of each task: 1 to mainTOTAL_NUMBER_OF_TASKS for the
+ * application tasks, then the timer service and idle tasks, tagged by the daemon startup hook.
+ * Untagged tasks share slot 0.
+ */
+#define mainRUNTIME_TAG_TIMER               (mainTOTAL_NUMBER_OF_TASKS + 1)
+#define mainRUNTIME_TAG_IDLE                (mainTOTAL_NUMBER_OF_TASKS + 2)
+
+#if (mainRUNTIME_TAG_IDLE >= RUN_STATS_MAX_SLOTS)
+#error "RUN_STATS_MAX_SLOTS is too small for the task tags"
+#endif
+
+/*
+ * The run time counter is the DWT cycle counter extended to 64 bits (RunStats module), so the kernel
+ * run time of every task and the total do not wrap, at the CPU clock resolution.
+ */
+#define configGENERATE_RUN_TIME_STATS               1
+#define configRUN_TIME_COUNTER_TYPE                 uint64
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()    RunStats_Init()
+#define portGET_RUN_TIME_COUNTER_VALUE()            RunStats_Now()
+
+/*
+ * Per task accounting of the activations (RUN_STATS_ACTIVATIONS): execution and response times. These
+ * hooks are expanded in tasks.c, a task switched out while still in its ready list was preempted or
+ * yielded. The ready and switched in hooks also record the event trace when TRACE_RECORDER is 1.
+ */
+#define traceMOVED_TASK_TO_READY_STATE(pxTCB)                                                                  \
+do{                                                                                                            \
+    RUN_STATS_READY((uint32) ((pxTCB)->pxTaskTag));                                                            \
+    TRACE_RECORD(TRACE_EVENT_TASK_READY, (uint32) ((pxTCB)->pxTaskTag));                                       \
+}while(0)
+
+#define traceTASK_SWITCHED_IN()                                                                                \
+do{                                                                                                            \
+    RUN_STATS_SWITCHED_IN((uint32) (pxCurrentTCB->pxTaskTag));                                                 \
+    TRACE_RECORD(TRACE_EVENT_TASK_SWITCHED_IN, (uint32) (pxCurrentTCB->pxTaskTag));                            \
+}while(0)
+
+#define traceTASK_SWITCHED_OUT()                                                                               \
+    RUN_STATS_SWITCHED_OUT((uint32) (pxCurrentTCB->pxTaskTag),                                                 \
+                           (listIS_CONTAINED_WITHIN(&(pxReadyTasksLists[pxCurrentTCB->uxPriority]),           \
+                                                    &(pxCurrentTCB->xStateListItem)) != pdFALSE) ? TRUE : FALSE)
+
+/*
+ * Mutex profiling (LockProfile module), these hooks are expanded in queue.c and tasks.c. A mutex take
+ * and give are a queue receive and send, the waiting task is known by its tag. The hooks also record
+ * the event trace when TRACE_RECORDER is 1.
+ */
+#define traceCREATE_MUTEX(pxNewQueue)           LOCK_PROFILE_CREATED(pxNewQueue)
+
+#define traceQUEUE_SEND(pxQueue)                                                                               \
+do{                                                                                                            \
+    LOCK_PROFILE_GIVEN((pxQueue)->ucQueueType, (pxQueue));                                                     \
+    TRACE_RECORD(TRACE_EVENT_QUEUE_SEND, (pxQueue)->uxQueueNumber);                                            \
+}while(0)
+
+#define traceQUEUE_RECEIVE(pxQueue)                                                                            \
+do{                                                                                                            \
+    LOCK_PROFILE_TAKEN((pxQueue)->ucQueueType, (pxQueue), (uint32) xTaskGetApplicationTaskTag(NULL));         \
+    TRACE_RECORD(TRACE_EVENT_QUEUE_RECEIVE, (pxQueue)->uxQueueNumber);                                         \
+}while(0)
+
+#define traceQUEUE_RECEIVE_FAILED(pxQueue)                                                                     \
+do{                                                                                                            \
+    LOCK_PROFILE_FAILED((pxQueue)->ucQueueType, (pxQueue), (uint32) xTaskGetApplicationTaskTag(NULL));        \
+    TRACE_RECORD(TRACE_EVENT_QUEUE_RECEIVE_FAILED, (pxQueue)->uxQueueNumber);                                  \
+}while(0)
+
+#define traceBLOCKING_ON_QUEUE_RECEIVE(pxQueue)                                                                \
+do{                                                                                                            \
+    LOCK_PROFILE_BLOCKING((pxQueue)->ucQueueType, (pxQueue), (uint32) xTaskGetApplicationTaskTag(NULL));      \
+    TRACE_RECORD(TRACE_EVENT_QUEUE_BLOCK_RECEIVE, (pxQueue)->uxQueueNumber);                                   \
+}while(0)
+
+#define traceTASK_PRIORITY_INHERIT(pxTCBOfMutexHolder, uxInheritedPriority)                                    \
+do{                                                                                                            \
+    LOCK_PROFILE_INHERITED();                                                                                  \
+    TRACE_RECORD(TRACE_EVENT_PRIORITY_INHERIT, (uint32) ((pxTCBOfMutexHolder)->pxTaskTag));                    \
+}while(0)
+
+#if (TRACE_RECORDER == 1)
+/*
+ * Kernel event trace (Trace module). The tasks are recorded by their tag, the queues by the number
+ * given at their creation. A semaphore or mutex take and give are a queue receive and send, the
+ * queue type tells them apart in the dump.
+ */
+#define traceQUEUE_CREATE(pxNewQueue)           ((pxNewQueue)->uxQueueNumber = Trace_QueueCreated((pxNewQueue)->ucQueueType))
+#define traceQUEUE_REGISTRY_ADD(xQueue, pcQueueName) Trace_QueueName((uint8) uxQueueGetQueueNumber(xQueue), (pcQueueName))
+
+#define traceQUEUE_SEND_FAILED(pxQueue)         TRACE_RECORD(TRACE_EVENT_QUEUE_SEND_FAILED, (pxQueue)->uxQueueNumber)
+#define traceQUEUE_SEND_FROM_ISR(pxQueue)       TRACE_RECORD(TRACE_EVENT_QUEUE_SEND, (pxQueue)->uxQueueNumber)
+#define traceQUEUE_SEND_FROM_ISR_FAILED(pxQueue) TRACE_RECORD(TRACE_EVENT_QUEUE_SEND_FAILED, (pxQueue)->uxQueueNumber)
+#define traceQUEUE_RECEIVE_FROM_ISR(pxQueue)    TRACE_RECORD(TRACE_EVENT_QUEUE_RECEIVE, (pxQueue)->uxQueueNumber)
+#define traceQUEUE_RECEIVE_FROM_ISR_FAILED(pxQueue) TRACE_RECORD(TRACE_EVENT_QUEUE_RECEIVE_FAILED, (pxQueue)->uxQueueNumber)
+#define traceBLOCKING_ON_QUEUE_SEND(pxQueue)    TRACE_RECORD(TRACE_EVENT_QUEUE_BLOCK_SEND, (pxQueue)->uxQueueNumber)
+
+#define traceTASK_DELAY()                       TRACE_RECORD(TRACE_EVENT_TASK_DELAY, (uint32) (pxCurrentTCB->pxTaskTag))
+#define traceTASK_DELAY_UNTIL(xTimeToWake)      TRACE_RECORD(TRACE_EVENT_TASK_DELAY, (uint32) (pxCurrentTCB->pxTaskTag))
+#define traceTASK_NOTIFY_TAKE_BLOCK(uxIndex)    TRACE_RECORD(TRACE_EVENT_TASK_NOTIFY_WAIT, (uint32) (pxCurrentTCB->pxTaskTag))
+#define traceTASK_NOTIFY_WAIT_BLOCK(uxIndex)    TRACE_RECORD(TRACE_EVENT_TASK_NOTIFY_WAIT, (uint32) (pxCurrentTCB->pxTaskTag))
+#define traceTASK_NOTIFY(uxIndex)               TRACE_RECORD(TRACE_EVENT_TASK_NOTIFY, (uint32) (pxTCB->pxTaskTag))
+#define traceTASK_NOTIFY_FROM_ISR(uxIndex)      TRACE_RECORD(TRACE_EVENT_TASK_NOTIFY, (uint32) (pxTCB->pxTaskTag))
+#define traceTASK_NOTIFY_GIVE_FROM_ISR(uxIndex) TRACE_RECORD(TRACE_EVENT_TASK_NOTIFY, (uint32) (pxTCB->pxTaskTag))
+#define traceTASK_PRIORITY_DISINHERIT(pxTCBOfMutexHolder, uxOriginalPriority) \
+    TRACE_RECORD(TRACE_EVENT_PRIORITY_DISINHERIT, (uint32) ((pxTCBOfMutexHolder)->pxTaskTag))
+
+#if (TRACE_TICKS == 1)
+#define traceTASK_INCREMENT_TICK(xTickCount)    TRACE_RECORD(TRACE_EVENT_TICK, (xTickCount))
+#endif
+#endif
 
 #endif /* FREERTOS_CONFIG_H */
@@ -9,25 +9,113 @@
  */
 
 #include "Button.h"
+#include "FaultInject_Hooks.h"
+
+#ifdef BUTTON_HOST
+/* Host build of the bouncy edge replay test: the host gives the pin levels */
+extern uint8 Button_HostLevel(Button_IdType xButton);
+#else
 #include "NVIC.h"
 #include "tm4c123gh6pm_registers.h"
+#endif
+
+/*******************************************************************************
+ *                              Private Definitions                            *
+ *******************************************************************************/
+
+#define BUTTON_RELEASED     0U
+#define BUTTON_PRESSED      1U
+
+#define BUTTON_EDGE_QUEUE_MASK      (BUTTON_EDGE_QUEUE_SIZE - 1U)
+
+/* One captured edge: the pin level after the edge and when it happened */
+typedef struct
+{
+    uint32 ulTimeStamp;
+    uint8 ucLevel;
+} Button_EdgeType;
+
+/*
+ * Lock free single producer single consumer queue: only the ISR writes ucHead and only the task
+ * writes ucTail, so neither side needs a critical section. Everything is volatile so the edge is
+ * stored before ucHead publishes it.
+ */
+typedef struct
+{
+    volatile Button_EdgeType axEdges[BUTTON_EDGE_QUEUE_SIZE];
+    volatile uint8 ucHead;
+    volatile uint8 ucTail;
+    volatile boolean bOverflow; /* An edge was dropped, the task resynchronizes from the pin */
+} Button_EdgeQueueType;
+
+/* Debounce and hold state, owned by the task */
+typedef struct
+{
+    uint32 ulLastEdgeTime; /* Time of the last raw edge */
+    uint32 ulHoldTime; /* Time of the accepted press, then of the last hold event */
+    uint8 ucRawLevel; /* Level after the last raw edge */
+    uint8 ucStableLevel; /* Debounced level */
+    boolean bLongPress; /* The long press of the current press was reported */
+    boolean bSettled; /* No edge for the debounce time at the last process */
+} Button_StateType;
+
+/*******************************************************************************
+ *                              Private Variables                              *
+ *******************************************************************************/
+
+static Button_EdgeQueueType axEdgeQueues[BUTTON_COUNT];
+static Button_StateType axStates[BUTTON_COUNT];
+
+/*******************************************************************************
+ *                              Private Functions                              *
+ *******************************************************************************/
+
+/* Buttons are active low with pull ups */
+static uint8 Button_ReadLevel(Button_IdType xButton)
+{
+#ifdef BUTTON_HOST
+    return FAULT_INJECT_BUTTON_LEVEL((uint8) xButton, Button_HostLevel(xButton));
+#else
+    uint32 ulPins;
+
+    switch (xButton)
+    {
+    case BUTTON_SW1:
+        ulPins = GPIO_PORTF_DATA_REG & PF4;
+        break;
+    case BUTTON_SW2:
+        ulPins = GPIO_PORTF_DATA_REG & PF0;
+        break;
+    case BUTTON_SW3:
+    default:
+        ulPins = GPIO_PORTB_DATA_REG & PB1;
+        break;
+    }
+
+    return FAULT_INJECT_BUTTON_LEVEL((uint8) xButton, (ulPins == 0U) ? BUTTON_PRESSED : BUTTON_RELEASED);
+#endif
+}
+
+/*******************************************************************************
+ *                              Public Functions                               *
+ *******************************************************************************/
+
+#ifndef BUTTON_HOST
 
 /* GPIO configuration and interrupt initialization for Port F (PF0, PF4) and Port B (PB1) */
 void GPIO_SetupButtonsInterrupt(void)
 {
-    /* Enable falling edge trigger for PF0 and PF4 */
+    /* Enable both edges trigger for PF0 and PF4, the debounce needs the press and the release */
     GPIO_PORTF_IS_REG &= ~(PF0 | PF4); /* Edge-sensitive */
-    GPIO_PORTF_IBE_REG &= ~(PF0 | PF4); /* Not both edges */
-    GPIO_PORTF_IEV_REG &= ~(PF0 | PF4); /* Falling edge */
+    GPIO_PORTF_IBE_REG |= (PF0 | PF4); /* Both edges */
     GPIO_PORTF_ICR_REG |= (PF0 | PF4); /* Clear any prior interrupts */
     GPIO_PORTF_IM_REG |= (PF0 | PF4); /* Enable PF0 and PF4 interrupts */
 
-    /* Enable falling edge trigger for PB1 */
+    /* Enable both edges trigger for PB1 */
     GPIO_PORTB_IS_REG &= ~PB1; /* Edge-sensitive */
-    GPIO_PORTB_IBE_REG &= ~PB1; /* Not both edges */
-    GPIO_PORTB_IEV_REG &= ~PB1; /* Falling edge */
+    GPIO_PORTB_IBE_REG |= PB1; /* Both edges */
     GPIO_PORTB_ICR_REG |= PB1; /* Clear any prior interrupt */
-    GPIO_PORTB_IM_REG |= PB1; /* Enable PB0 interrupt */
+    GPIO_PORTB_IM_REG |= PB1; /* Enable PB1 interrupt */
 
     /* Enable NVIC GPIO PORTF IRQ and set its priority */
     NVIC_EnableIRQ(GPIO_PORTF_IRQ_NUM);
@@ -37,3 +125,121 @@ void GPIO_SetupButtonsInterrupt(void)
     NVIC_EnableIRQ(GPIO_PORTB_IRQ_NUM);
     NVIC_SetPriorityIRQ(GPIO_PORTB_IRQ_NUM, GPIO_PORTB_INTERRUPT_PRIORITY);
 }
+
+#endif
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+boolean Button_CaptureEdge(Button_IdType xButton, uint32 ulTimeStamp)
+{
+    Button_EdgeQueueType *pxQueue = &axEdgeQueues[xButton];
+    uint8 ucHead = pxQueue->ucHead;
+    uint8 ucTail = pxQueue->ucTail;
+
+    if ((uint8) (ucHead - ucTail) >= BUTTON_EDGE_QUEUE_SIZE)
+    {
+        pxQueue->bOverflow = TRUE;
+        return FALSE; /* The task is already awake, the queue is not empty */
+    }
+
+    pxQueue->axEdges[ucHead & BUTTON_EDGE_QUEUE_MASK].ulTimeStamp = ulTimeStamp;
+    pxQueue->axEdges[ucHead & BUTTON_EDGE_QUEUE_MASK].ucLevel = Button_ReadLevel(xButton);
+    pxQueue->ucHead = (uint8) (ucHead + 1U);
+
+    return (ucHead == ucTail) ? TRUE : FALSE;
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+/*
+ * The edges are replayed in order with their own timestamps, so the result does not depend on how late
+ * the task runs: a level is accepted when it lasted BUTTON_DEBOUNCE_TIME before the next edge (or before
+ * ulNow), and the hold time of a press only counts while the raw level is still pressed.
+ */
+Button_EventType Button_Process(Button_IdType xButton, uint32 ulNow)
+{
+    Button_EdgeQueueType *pxQueue = &axEdgeQueues[xButton];
+    Button_StateType *pxState = &axStates[xButton];
+
+    for (;;)
+    {
+        boolean bEdgePending = (pxQueue->ucHead != pxQueue->ucTail) ? TRUE : FALSE;
+        uint32 ulNextTime = ulNow;
+        uint32 ulHoldEnd;
+
+        if (bEdgePending == TRUE)
+        {
+            ulNextTime = pxQueue->axEdges[pxQueue->ucTail & BUTTON_EDGE_QUEUE_MASK].ulTimeStamp;
+        }
+
+        /* Accept the raw level once it has been stable for the debounce time */
+        if ((pxState->ucRawLevel != pxState->ucStableLevel) && ((uint32) (ulNextTime - pxState->ulLastEdgeTime) >= BUTTON_DEBOUNCE_TIME))
+        {
+            pxState->ucStableLevel = pxState->ucRawLevel;
+
+            if (pxState->ucStableLevel == BUTTON_PRESSED)
+            {
+                pxState->ulHoldTime = pxState->ulLastEdgeTime + BUTTON_DEBOUNCE_TIME;
+                pxState->bLongPress = FALSE;
+            }
+            else if (pxState->bLongPress == FALSE)
+            {
+                return BUTTON_EVENT_CLICK;
+            }
+            continue;
+        }
+
+        /* Hold events while the press is stable */
+        if (pxState->ucStableLevel == BUTTON_PRESSED)
+        {
+            ulHoldEnd = (pxState->ucRawLevel == BUTTON_PRESSED) ? ulNextTime : pxState->ulLastEdgeTime;
+
+            if ((pxState->bLongPress == FALSE) && ((uint32) (ulHoldEnd - pxState->ulHoldTime) >= BUTTON_LONG_PRESS_TIME))
+            {
+                pxState->bLongPress = TRUE;
+                pxState->ulHoldTime += BUTTON_LONG_PRESS_TIME;
+                return BUTTON_EVENT_LONG_PRESS;
+            }
+
+            if ((pxState->bLongPress == TRUE) && ((uint32) (ulHoldEnd - pxState->ulHoldTime) >= BUTTON_REPEAT_TIME))
+            {
+                pxState->ulHoldTime += BUTTON_REPEAT_TIME;
+                return BUTTON_EVENT_REPEAT;
+            }
+        }
+
+        if (bEdgePending == FALSE)
+        {
+            break;
+        }
+
+        /* Consume the edge */
+        pxState->bSettled = FALSE;
+        pxState->ucRawLevel = pxQueue->axEdges[pxQueue->ucTail & BUTTON_EDGE_QUEUE_MASK].ucLevel;
+        pxState->ulLastEdgeTime = ulNextTime;
+        pxQueue->ucTail = (uint8) (pxQueue->ucTail + 1U);
+    }
+
+    /* Edges were lost, restart the debounce from the current pin level */
+    if (pxQueue->bOverflow == TRUE)
+    {
+        pxQueue->bOverflow = FALSE;
+        pxState->ucRawLevel = Button_ReadLevel(xButton);
+        pxState->ulLastEdgeTime = ulNow;
+    }
+
+    /* A bounce can leave the raw level released between two edges, the press is not over before it settles */
+    pxState->bSettled = ((uint32) (ulNow - pxState->ulLastEdgeTime) >= BUTTON_DEBOUNCE_TIME) ? TRUE : FALSE;
+
+    return BUTTON_EVENT_NONE;
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+boolean Button_IsIdle(Button_IdType xButton)
+{
+    const Button_StateType *pxState = &axStates[xButton];
+
+    return ((axEdgeQueues[xButton].ucHead == axEdgeQueues[xButton].ucTail) && (pxState->ucRawLevel == BUTTON_RELEASED)
+            && (pxState->ucStableLevel == BUTTON_RELEASED) && (pxState->bSettled == TRUE)) ? TRUE : FALSE;
+}
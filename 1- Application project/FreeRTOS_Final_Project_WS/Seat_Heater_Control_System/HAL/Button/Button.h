@@ -28,6 +28,42 @@
 #define GPIO_PORTB_IRQ_NUM                  1
 #define GPIO_PORTB_INTERRUPT_PRIORITY       5
 
+/*
+ * Button timing, in edge timestamp ticks (GPTM WTimer0, 0.1 msec per tick).
+ * A level must stay stable for BUTTON_DEBOUNCE_TIME before it is accepted, a press held for
+ * BUTTON_LONG_PRESS_TIME reports a long press, and holding it further reports a repeat every
+ * BUTTON_REPEAT_TIME.
+ */
+#define BUTTON_MS_TO_TICKS(ms)              ((uint32) (ms) * 10UL)
+#define BUTTON_DEBOUNCE_TIME                BUTTON_MS_TO_TICKS(20)
+#define BUTTON_LONG_PRESS_TIME              BUTTON_MS_TO_TICKS(1000)
+#define BUTTON_REPEAT_TIME                  BUTTON_MS_TO_TICKS(500)
+
+/* Number of edges each button can buffer between the ISR and its task, must be a power of 2 */
+#define BUTTON_EDGE_QUEUE_SIZE              16
+
+/*******************************************************************************
+ *                              Types Declaration                              *
+ *******************************************************************************/
+
+/* Buttons of the system */
+typedef enum
+{
+    BUTTON_SW1, /* PF4: Driver seat button on the steering wheel */
+    BUTTON_SW2, /* PF0: Passenger seat button */
+    BUTTON_SW3, /* PB1: Driver seat button on the seat */
+    BUTTON_COUNT
+} Button_IdType;
+
+/* Events reported by the debounce state machine */
+typedef enum
+{
+    BUTTON_EVENT_NONE,
+    BUTTON_EVENT_CLICK, /* Pressed and released before the long press time */
+    BUTTON_EVENT_LONG_PRESS, /* Held for the long press time, reported once per press */
+    BUTTON_EVENT_REPEAT /* Still held after a long press, reported every repeat time */
+} Button_EventType;
+
 /*******************************************************************************
  *                      Functions Prototypes                                   *
  *******************************************************************************/
@@ -35,4 +71,23 @@
 /* GPIO configuration and interrupt initialization for Port F (PF0, PF4) and Port B (PB1) */
 void GPIO_SetupButtonsInterrupt(void);
 
+/*
+ * Called from the GPIO ISR for every edge of a button: samples the pin level and stores it with its
+ * timestamp in the button's single producer single consumer edge queue.
+ * Returns TRUE when the queue was empty, which is the only case the consuming task has to be woken.
+ */
+boolean Button_CaptureEdge(Button_IdType xButton, uint32 ulTimeStamp);
+
+/*
+ * Called from the button's task: consumes the captured edges and runs the debounce state machine up to
+ * ulNow. Returns one event per call, so it is called until it returns BUTTON_EVENT_NONE.
+ */
+Button_EventType Button_Process(Button_IdType xButton, uint32 ulNow);
+
+/*
+ * Returns TRUE when the button is released, stable, had no edge for the debounce time at the last
+ * Button_Process and has no pending edges, so its task can block.
+ */
+boolean Button_IsIdle(Button_IdType xButton);
+
 #endif /* BUTTON_H_ */
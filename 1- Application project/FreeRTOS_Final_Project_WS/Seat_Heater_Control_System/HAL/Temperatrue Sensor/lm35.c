@@ -10,6 +10,7 @@
 
 #include "lm35.h"
 #include "adc.h"
+#include "FaultInject_Hooks.h"
 
 /*
  * Description :
@@ -22,5 +23,5 @@ uint8 LM35_getTemperature(uint8 channel_num)
     /* Calculate temperature from 0V-3.3V mapped to 0C-45C */
     uint8 temperature = (uint8) (((uint32) adc_value * SENSOR_MAX_TEMPERATURE * ADC_REFERENCE_VOLTAGE) / (ADC_MAXIMUM_VALUE * SENSOR_MAX_VOLT_VALUE));
 
-    return temperature;
+    return FAULT_INJECT_TEMPERATURE(channel_num, temperature);
 }
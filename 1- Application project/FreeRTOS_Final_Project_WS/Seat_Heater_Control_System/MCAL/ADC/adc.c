@@ -10,6 +10,7 @@
 
 #include "adc.h"
 #include "tm4c123gh6pm_registers.h"
+#include "FaultInject_Hooks.h"
 
 /*
  * Description :
@@ -125,5 +126,5 @@ uint16 ADC_ReadChannel(uint8 channel_num)
         /* Clear the interrupt flag for ADC1 */
         ADC1_ISC_REG |= SAMPLE_SEQ_0_MASK;
     }
-    return ADC_Value;
+    return FAULT_INJECT_ADC(channel_num, ADC_Value);
 }
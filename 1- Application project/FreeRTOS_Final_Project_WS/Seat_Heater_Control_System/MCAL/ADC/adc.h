@@ -77,5 +77,5 @@ void ADC_Init(void);
  * The function starts the conversion, waits for it to complete,
  * and returns the digital result.
  */
-//uint16 ADC_ReadChannel(uint8 channel_num);
+uint16 ADC_ReadChannel(uint8 channel_num);
 #endif /* ADC_H_ */
@@ -0,0 +1,124 @@
+/*
+ ============================================================================
+ Name        : eeprom.c
+ Module Name : EEPROM
+ Author      : Ahmed Ali
+ Date        : 22 Sept. 2024
+ Description : Source file for the TM4C123GH6PM Microcontroller EEPROM driver
+ ============================================================================
+ */
+
+#include "eeprom.h"
+#include "tm4c123gh6pm_registers.h"
+
+/*
+ * Description :
+ * Busy wait until the EEPROM module is not working on a program or erase.
+ */
+static void EEPROM_WaitDone(void)
+{
+    while (EEPROM_EEDONE_REG & EEPROM_EEDONE_WORKING)
+        ;
+}
+
+/*
+ * Description :
+ * Select the block and the offset of a word address.
+ */
+static void EEPROM_Select(uint16 address)
+{
+    EEPROM_EEBLOCK_REG = address / EEPROM_BLOCK_WORDS;
+    EEPROM_EEOFFSET_REG = address % EEPROM_BLOCK_WORDS;
+}
+
+/*
+ * Description :
+ * Function responsible for enabling the EEPROM module, following the initialization sequence
+ * of the datasheet (wait for the power up recovery, then reset the module).
+ * Returns E_NOT_OK if the module reports a failed recovery, the EEPROM must not be used then.
+ */
+Std_ReturnType EEPROM_Init(void)
+{
+    /* Enable EEPROM clock */
+    SYSCTL_RCGCEEPROM_REG |= EEPROM_RCGC_R0;
+    while (!(SYSCTL_PREEPROM_REG & EEPROM_RCGC_R0))
+        ;
+
+    /* Wait for the recovery of an operation interrupted by a power loss */
+    EEPROM_WaitDone();
+    if (EEPROM_EESUPP_REG & (EEPROM_EESUPP_ERETRY | EEPROM_EESUPP_PRETRY))
+    {
+        return E_NOT_OK;
+    }
+
+    /* Reset the module and wait for it to be ready again */
+    SYSCTL_SREEPROM_REG |= EEPROM_RCGC_R0;
+    SYSCTL_SREEPROM_REG &= ~EEPROM_RCGC_R0;
+    while (!(SYSCTL_PREEPROM_REG & EEPROM_RCGC_R0))
+        ;
+    EEPROM_WaitDone();
+    if (EEPROM_EESUPP_REG & (EEPROM_EESUPP_ERETRY | EEPROM_EESUPP_PRETRY))
+    {
+        return E_NOT_OK;
+    }
+
+    return E_OK;
+}
+
+/*
+ * Description :
+ * Read count words starting at the word address.
+ * Returns E_NOT_OK if the range is outside the EEPROM.
+ */
+Std_ReturnType EEPROM_Read(uint16 address, uint32 *data, uint16 count)
+{
+    uint16 i;
+
+    if (((uint32) address + count) > EEPROM_SIZE_WORDS)
+    {
+        return E_NOT_OK;
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        EEPROM_Select(address + i);
+        data[i] = EEPROM_EERDWR_REG;
+    }
+
+    return E_OK;
+}
+
+/*
+ * Description :
+ * Write count words starting at the word address, busy waiting for each word to be programmed
+ * (a few milliseconds when the block must be erased). Words that already hold the value are not
+ * written, which saves both the time and the endurance of the block.
+ * Returns E_NOT_OK if the range is outside the EEPROM or a write is refused.
+ */
+Std_ReturnType EEPROM_Write(uint16 address, const uint32 *data, uint16 count)
+{
+    uint16 i;
+
+    if (((uint32) address + count) > EEPROM_SIZE_WORDS)
+    {
+        return E_NOT_OK;
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        EEPROM_Select(address + i);
+        if (EEPROM_EERDWR_REG == data[i])
+        {
+            continue;
+        }
+
+        EEPROM_EERDWR_REG = data[i];
+        EEPROM_WaitDone();
+        if (EEPROM_EEDONE_REG & (EEPROM_EEDONE_NOPERM | EEPROM_EEDONE_WRBUSY))
+        {
+            return E_NOT_OK;
+        }
+    }
+
+    return E_OK;
+}
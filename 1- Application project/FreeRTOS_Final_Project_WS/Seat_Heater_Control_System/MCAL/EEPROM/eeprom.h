@@ -0,0 +1,64 @@
+/*
+ ============================================================================
+ Name        : eeprom.h
+ Module Name : EEPROM
+ Author      : Ahmed Ali
+ Date        : 22 Sept. 2024
+ Description : Header file for the TM4C123GH6PM Microcontroller EEPROM driver
+ ============================================================================
+ */
+
+#ifndef EEPROM_H_
+#define EEPROM_H_
+
+#include "Std_Types.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/* 2KB EEPROM: 32 blocks of 16 words, addressed here by word (0 to 511) */
+#define EEPROM_BLOCK_WORDS          16U
+#define EEPROM_SIZE_WORDS           512U
+
+/* Clock gating and peripheral ready bit of the EEPROM module */
+#define EEPROM_RCGC_R0              0x01
+
+/* EEDONE: WORKING is set while a program or erase is in progress, the others report the last write */
+#define EEPROM_EEDONE_WORKING       0x01
+#define EEPROM_EEDONE_NOPERM        0x10
+#define EEPROM_EEDONE_WRBUSY        0x20
+
+/* EESUPP: a program or erase that must be retried after the power up */
+#define EEPROM_EESUPP_ERETRY        0x04
+#define EEPROM_EESUPP_PRETRY        0x08
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Function responsible for enabling the EEPROM module, following the initialization sequence
+ * of the datasheet (wait for the power up recovery, then reset the module).
+ * Returns E_NOT_OK if the module reports a failed recovery, the EEPROM must not be used then.
+ */
+Std_ReturnType EEPROM_Init(void);
+
+/*
+ * Description :
+ * Read count words starting at the word address.
+ * Returns E_NOT_OK if the range is outside the EEPROM.
+ */
+Std_ReturnType EEPROM_Read(uint16 address, uint32 *data, uint16 count);
+
+/*
+ * Description :
+ * Write count words starting at the word address, busy waiting for each word to be programmed
+ * (a few milliseconds when the block must be erased). Words that already hold the value are not
+ * written, which saves both the time and the endurance of the block.
+ * Returns E_NOT_OK if the range is outside the EEPROM or a write is refused.
+ */
+Std_ReturnType EEPROM_Write(uint16 address, const uint32 *data, uint16 count);
+
+#endif /* EEPROM_H_ */
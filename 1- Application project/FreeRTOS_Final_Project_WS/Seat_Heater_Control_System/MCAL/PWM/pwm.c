@@ -0,0 +1,171 @@
+/*
+ ============================================================================
+ Name        : pwm.c
+ Module Name : PWM
+ Author      : Ahmed Ali
+ Date        : 22 Sept. 2024
+ Description : Source file for the TM4C123GH6PM Microcontroller PWM driver
+ ============================================================================
+ */
+
+#include "pwm.h"
+#include "tm4c123gh6pm_registers.h"
+
+/*
+ * Description :
+ * Returns the generator action register value and the compare values for an on-time window.
+ * In count-down mode the time t into the period is the counter value PWM_LOAD_VALUE - t: the output
+ * rises on the compare A match and falls on the compare B match. An edge at the start of the period
+ * is made by the load action, so the output does not glitch for one PWM clock at the compare match,
+ * and 0% and 100% are made by the load action alone. A window that runs past the end of the period
+ * is high from the load to compare B and again from compare A.
+ */
+static uint32 PWM_GeneratorAction(uint8 start, uint8 duty, uint32 *compare_a, uint32 *compare_b)
+{
+    uint32 rise;
+    uint32 fall;
+
+    *compare_a = PWM_LOAD_VALUE;
+    *compare_b = PWM_LOAD_VALUE;
+
+    if (duty == 0)
+    {
+        return PWM_GEN_ACTLOAD_LOW;
+    }
+    else if (duty >= PWM_DUTY_MAX)
+    {
+        return PWM_GEN_ACTLOAD_HIGH;
+    }
+
+    rise = ((PWM_LOAD_VALUE + 1UL) * (start % PWM_DUTY_MAX)) / PWM_DUTY_MAX;
+    fall = rise + (((PWM_LOAD_VALUE + 1UL) * duty) / PWM_DUTY_MAX);
+
+    if (rise == 0)
+    {
+        *compare_b = PWM_LOAD_VALUE - fall;
+        return PWM_GEN_ACTLOAD_HIGH | PWM_GEN_ACTCMPBD_LOW;
+    }
+
+    *compare_a = PWM_LOAD_VALUE - rise;
+    if (fall <= PWM_LOAD_VALUE)
+    {
+        *compare_b = PWM_LOAD_VALUE - fall;
+        return PWM_GEN_ACTLOAD_LOW | PWM_GEN_ACTCMPAD_HIGH | PWM_GEN_ACTCMPBD_LOW;
+    }
+    else if (fall == (PWM_LOAD_VALUE + 1UL))
+    {
+        /* Ends with the period */
+        return PWM_GEN_ACTLOAD_LOW | PWM_GEN_ACTCMPAD_HIGH;
+    }
+    else
+    {
+        /* Wraps to the start of the period */
+        *compare_b = PWM_LOAD_VALUE - (fall - (PWM_LOAD_VALUE + 1UL));
+        return PWM_GEN_ACTLOAD_HIGH | PWM_GEN_ACTCMPAD_HIGH | PWM_GEN_ACTCMPBD_LOW;
+    }
+}
+
+/*
+ * Description :
+ * Function responsible for initializing the PWM outputs of the heaters.
+ * It must be called after Port_Init, as it moves PF3 and PB4 from DIO to their PWM function.
+ * Both outputs start at 0% duty.
+ */
+void PWM_Init(void)
+{
+    /* Enable PWM0 and PWM1 clock */
+    SYSCTL_RCGCPWM_REG |= PWM_RCGC_PWM0_PWM1;
+    while ((SYSCTL_PRPWM_REG & PWM_RCGC_PWM0_PWM1) != PWM_RCGC_PWM0_PWM1)
+        ;
+
+    /* Select the PWM function on PF3 (M1PWM7) and PB4 (M0PWM2) */
+    GPIO_PORTF_AFSEL_REG |= PWM_PF3_MASK;
+    GPIO_PORTF_PCTL_REG = (GPIO_PORTF_PCTL_REG & ~PWM_PF3_PCTL_MASK) | PWM_PF3_PCTL_M1PWM7;
+    GPIO_PORTB_AFSEL_REG |= PWM_PB4_MASK;
+    GPIO_PORTB_PCTL_REG = (GPIO_PORTB_PCTL_REG & ~PWM_PB4_PCTL_MASK) | PWM_PB4_PCTL_M0PWM2;
+
+    /********** Configure PWM1 generator 3 (driver heater) **********/
+    /* Disable the generator, count-down mode, compare and generator action updates on a global synchronization */
+    PWM1_3_CTL_REG = PWM_CTL_CMPAUPD_GLOBAL | PWM_CTL_CMPBUPD_GLOBAL | PWM_CTL_GENAUPD_GLOBAL | PWM_CTL_GENBUPD_GLOBAL;
+    PWM1_3_LOAD_REG = PWM_LOAD_VALUE;
+    PWM1_3_CMPA_REG = PWM_LOAD_VALUE;
+    PWM1_3_CMPB_REG = PWM_LOAD_VALUE;
+    PWM1_3_GENB_REG = PWM_GEN_ACTLOAD_LOW;
+    PWM1_ENABLE_REG |= PWM_ENABLE_PWM7EN;
+
+    /********** Configure PWM0 generator 1 (passenger heater) **********/
+    PWM0_1_CTL_REG = PWM_CTL_CMPAUPD_GLOBAL | PWM_CTL_CMPBUPD_GLOBAL | PWM_CTL_GENAUPD_GLOBAL | PWM_CTL_GENBUPD_GLOBAL;
+    PWM0_1_LOAD_REG = PWM_LOAD_VALUE;
+    PWM0_1_CMPA_REG = PWM_LOAD_VALUE;
+    PWM0_1_CMPB_REG = PWM_LOAD_VALUE;
+    PWM0_1_GENA_REG = PWM_GEN_ACTLOAD_LOW;
+    PWM0_ENABLE_REG |= PWM_ENABLE_PWM2EN;
+
+    /* Start both generators back to back: they run from the same clock, so their periods stay aligned
+     * within the few clocks between the two stores. The values above are applied at the first period end */
+    PWM1_CTL_REG |= PWM_CTL_GLOBALSYNC3;
+    PWM0_CTL_REG |= PWM_CTL_GLOBALSYNC1;
+    PWM1_3_CTL_REG |= PWM_CTL_ENABLE;
+    PWM0_1_CTL_REG |= PWM_CTL_ENABLE;
+}
+
+/*
+ * Description :
+ * Set the duty cycle of a PWM output in percent (0 to 100, larger values are clamped), on from the
+ * start of the period.
+ * The new duty is only queued, PWM_Update applies it.
+ */
+void PWM_SetDutyCycle(PWM_ChannelType channel, uint8 duty)
+{
+    PWM_SetDutyWindow(channel, 0, duty);
+}
+
+/*
+ * Description :
+ * Set the duty cycle of a PWM output in percent, with its on-time starting start percent into the
+ * period (0 to 99). An on-time that runs past the end of the period wraps to its start.
+ * The periods of both outputs are aligned, so the on-times of the heaters can be staggered.
+ * The new window is only queued, PWM_Update applies it. If the previous update of the output is
+ * still pending, it is waited for first, as the registers written meanwhile would be applied with it.
+ */
+void PWM_SetDutyWindow(PWM_ChannelType channel, uint8 start, uint8 duty)
+{
+    uint32 compare_a;
+    uint32 compare_b;
+    uint32 action;
+
+    action = PWM_GeneratorAction(start, duty, &compare_a, &compare_b);
+
+    if (channel == PWM_CHANNEL_GREEN1)
+    {
+        while ((PWM1_CTL_REG & PWM_CTL_GLOBALSYNC3) != 0)
+            ;
+        PWM1_3_CMPA_REG = compare_a;
+        PWM1_3_CMPB_REG = compare_b;
+        PWM1_3_GENB_REG = action;
+    }
+    else if (channel == PWM_CHANNEL_GREEN2)
+    {
+        while ((PWM0_CTL_REG & PWM_CTL_GLOBALSYNC1) != 0)
+            ;
+        PWM0_1_CMPA_REG = compare_a;
+        PWM0_1_CMPB_REG = compare_b;
+        PWM0_1_GENA_REG = action;
+    }
+}
+
+/*
+ * Description :
+ * Apply the windows queued on both outputs at the end of the same PWM period. Every register of a
+ * window is latched together, so no period runs with a mix of the old and the new windows.
+ * The two outputs are in different PWM modules, each with its own synchronization request, so the
+ * requests are not made in the last PWM_SYNC_MARGIN clocks of a period of either output: both are
+ * then applied at the same period end. The caller must keep interrupts out.
+ */
+void PWM_Update(void)
+{
+    while ((PWM1_3_COUNT_REG < PWM_SYNC_MARGIN) || (PWM0_1_COUNT_REG < PWM_SYNC_MARGIN))
+        ;
+    PWM1_CTL_REG |= PWM_CTL_GLOBALSYNC3;
+    PWM0_CTL_REG |= PWM_CTL_GLOBALSYNC1;
+}
@@ -0,0 +1,118 @@
+/*
+ ============================================================================
+ Name        : pwm.h
+ Module Name : PWM
+ Author      : Ahmed Ali
+ Date        : 22 Sept. 2024
+ Description : Header file for the TM4C123GH6PM Microcontroller PWM driver
+ ============================================================================
+ */
+
+#ifndef PWM_H_
+#define PWM_H_
+
+#include "Std_Types.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/* The PWM modules are clocked by the system clock (no PWM clock divider) */
+#define PWM_CLOCK_HZ            16000000UL
+
+/* PWM frequency of the heater outputs, fast enough for the LEDs not to flicker */
+#define PWM_FREQUENCY_HZ        1000UL
+
+/* Counter reload value, the period is PWM_LOAD_VALUE + 1 PWM clocks (must fit in 16 bits) */
+#define PWM_LOAD_VALUE          ((PWM_CLOCK_HZ / PWM_FREQUENCY_HZ) - 1UL)
+
+/* Maximum duty cycle in percent */
+#define PWM_DUTY_MAX            100U
+
+/* Pin masks */
+#define PWM_PF3_MASK            0x08  /* M1PWM7 */
+#define PWM_PB4_MASK            0x10  /* M0PWM2 */
+
+/* Port Control (PCTL) values selecting the PWM function on the pins */
+#define PWM_PF3_PCTL_MASK       0x0000F000
+#define PWM_PF3_PCTL_M1PWM7     0x00005000
+#define PWM_PB4_PCTL_MASK       0x000F0000
+#define PWM_PB4_PCTL_M0PWM2     0x00040000
+
+/* Generator actions in count-down mode, the same bits in GENA and GENB */
+#define PWM_GEN_ACTLOAD_LOW     0x008
+#define PWM_GEN_ACTLOAD_HIGH    0x00C
+#define PWM_GEN_ACTCMPAD_HIGH   0x0C0
+#define PWM_GEN_ACTCMPBD_LOW    0x800
+
+/* Generator control: enable, and compare and generator action updates at the end of the period after a global synchronization */
+#define PWM_CTL_ENABLE          0x01
+#define PWM_CTL_CMPAUPD_GLOBAL  0x010
+#define PWM_CTL_CMPBUPD_GLOBAL  0x020
+#define PWM_CTL_GENAUPD_GLOBAL  0x0C0
+#define PWM_CTL_GENBUPD_GLOBAL  0x300
+
+/* Module control: global synchronization request of a generator, cleared by the module once applied */
+#define PWM_CTL_GLOBALSYNC1     0x02  /* PWM0 generator 1 */
+#define PWM_CTL_GLOBALSYNC3     0x08  /* PWM1 generator 3 */
+
+/* Counter values before the end of the period where PWM_Update waits, longer than its two synchronization stores */
+#define PWM_SYNC_MARGIN         64UL
+
+/* Output enable bits */
+#define PWM_ENABLE_PWM2EN       0x04
+#define PWM_ENABLE_PWM7EN       0x80
+
+/* Clock gating bits of the PWM modules */
+#define PWM_RCGC_PWM0_PWM1      0x03
+
+/*******************************************************************************
+ *                              Types Declaration                              *
+ *******************************************************************************/
+
+/* PWM outputs, one heater per seat (the green LED of the seat simulates the heating element) */
+typedef enum
+{
+    PWM_CHANNEL_GREEN1, /* Driver seat heater: PF3, M1PWM7 (PWM1 generator 3 B) */
+    PWM_CHANNEL_GREEN2 /* Passenger seat heater: PB4, M0PWM2 (PWM0 generator 1 A) */
+} PWM_ChannelType;
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Function responsible for initializing the PWM outputs of the heaters.
+ * It must be called after Port_Init, as it moves PF3 and PB4 from DIO to their PWM function.
+ * Both outputs start at 0% duty.
+ */
+void PWM_Init(void);
+
+/*
+ * Description :
+ * Set the duty cycle of a PWM output in percent (0 to 100, larger values are clamped), on from the
+ * start of the period.
+ * The new duty is only queued, PWM_Update applies it.
+ */
+void PWM_SetDutyCycle(PWM_ChannelType channel, uint8 duty);
+
+/*
+ * Description :
+ * Set the duty cycle of a PWM output in percent, with its on-time starting start percent into the
+ * period (0 to 99). An on-time that runs past the end of the period wraps to its start.
+ * The periods of both outputs are aligned, so the on-times of the heaters can be staggered.
+ * The new window is only queued, PWM_Update applies it. If the previous update of the output is
+ * still pending, it is waited for first (at most one PWM period).
+ */
+void PWM_SetDutyWindow(PWM_ChannelType channel, uint8 start, uint8 duty);
+
+/*
+ * Description :
+ * Apply the windows queued on both outputs at the end of the same PWM period. Every register of a
+ * window is latched together, so no period runs with a mix of the old and the new windows.
+ * The caller must keep interrupts out, so no period ends between the synchronization of the two outputs.
+ */
+void PWM_Update(void);
+
+#endif /* PWM_H_ */
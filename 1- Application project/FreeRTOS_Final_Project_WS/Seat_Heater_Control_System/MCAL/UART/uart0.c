@@ -12,6 +12,7 @@
 
 #include "uart0.h"
 #include "tm4c123gh6pm_registers.h"
+#include "NVIC.h"
 
 /*******************************************************************************
  *                         Private Functions Definitions                       *
@@ -87,6 +88,25 @@ uint8 UART0_ReceiveByte(void)
     return UART0_DR_REG; /* Read the byte */
 }
 
+boolean UART0_TryReceiveByte(uint8 *pData)
+{
+    if (UART0_FR_REG & UART_FR_RXFE_MASK)
+    {
+        return FALSE; /* Nothing received */
+    }
+    *pData = UART0_DR_REG; /* Read the byte, this also clears the receive interrupt */
+    return TRUE;
+}
+
+void UART0_EnableReceiveInterrupt(void) /* UART0_Handler must be in the vector table */
+{
+    UART0_IM_REG |= UART_IM_RXIM_MASK; /* Interrupt on each received byte (FIFOs are disabled) */
+
+    /* Enable NVIC UART0 IRQ and set its priority */
+    NVIC_EnableIRQ(UART0_IRQ_NUM);
+    NVIC_SetPriorityIRQ(UART0_IRQ_NUM, UART0_INTERRUPT_PRIORITY);
+}
+
 void UART0_SendString(const uint8 *pData)
 {
     uint32 uCounter = 0;
@@ -28,6 +28,11 @@
 #define UART_CTL_RXE_MASK        0x00000200
 #define UART_FR_TXFE_MASK        0x00000080
 #define UART_FR_RXFE_MASK        0x00000010
+#define UART_IM_RXIM_MASK        0x00000010
+
+/* UART0 receive interrupt, the priority must allow the handler to use the FreeRTOS API */
+#define UART0_IRQ_NUM            5
+#define UART0_INTERRUPT_PRIORITY 5
 
 /*******************************************************************************
  *                            Functions Prototypes                             *
@@ -39,6 +44,10 @@ extern void UART0_SendByte(uint8 data);
 
 extern uint8 UART0_ReceiveByte(void);
 
+extern boolean UART0_TryReceiveByte(uint8 *pData);
+
+extern void UART0_EnableReceiveInterrupt(void);
+
 extern void UART0_SendString(const uint8 *pData);
 
 extern void UART0_SendInteger(sint64 sNumber);
@@ -29,6 +29,8 @@
  GPIO registers (PORTB)
  *****************************************************************************/
 #define GPIO_PORTB_DATA_REG       (*((volatile uint32 *)0x400053FC))
+/* Masked data access: only the pins set in ucMask are read or written (address bits 9:2) */
+#define GPIO_PORTB_DATA_MASKED_REG(ucMask)  (*((volatile uint32 *)(0x40005000UL + ((uint32) (ucMask) << 2))))
 #define GPIO_PORTB_DIR_REG        (*((volatile uint32 *)0x40005400))
 #define GPIO_PORTB_AFSEL_REG      (*((volatile uint32 *)0x40005420))
 #define GPIO_PORTB_PUR_REG        (*((volatile uint32 *)0x40005510))
@@ -117,6 +119,8 @@
  GPIO registers (PORTF)
  *****************************************************************************/
 #define GPIO_PORTF_DATA_REG       (*((volatile uint32 *)0x400253FC))
+/* Masked data access: only the pins set in ucMask are read or written (address bits 9:2) */
+#define GPIO_PORTF_DATA_MASKED_REG(ucMask)  (*((volatile uint32 *)(0x40025000UL + ((uint32) (ucMask) << 2))))
 #define GPIO_PORTF_DIR_REG        (*((volatile uint32 *)0x40025400))
 #define GPIO_PORTF_AFSEL_REG      (*((volatile uint32 *)0x40025420))
 #define GPIO_PORTF_PUR_REG        (*((volatile uint32 *)0x40025510))
@@ -142,6 +146,13 @@
 #define SYSTICK_RELOAD_REG        (*((volatile uint32 *)0xE000E014))
 #define SYSTICK_CURRENT_REG       (*((volatile uint32 *)0xE000E018))
 
+/*****************************************************************************
+ Data Watchpoint and Trace Registers
+ *****************************************************************************/
+#define CORE_DEBUG_DEMCR_REG      (*((volatile uint32 *)0xE000EDFC))
+#define DWT_CTRL_REG              (*((volatile uint32 *)0xE0001000))
+#define DWT_CYCCNT_REG            (*((volatile uint32 *)0xE0001004))
+
 /*****************************************************************************
  NVIC Registers
  *****************************************************************************/
@@ -191,6 +202,7 @@
 #define NVIC_DIS2_REG             (*((volatile uint32 *)0xE000E188))
 #define NVIC_DIS3_REG             (*((volatile uint32 *)0xE000E18C))
 #define NVIC_DIS4_REG             (*((volatile uint32 *)0xE000E190))
+#define NVIC_SW_TRIG_REG          (*((volatile uint32 *)0xE000EF00))
 
 /*****************************************************************************
  System Control Block Registers
@@ -576,4 +588,36 @@
 #define WTIMER0_TAR_REG           (*((volatile uint32 *)0x40036048))
 #define WTIMER0_TBR_REG           (*((volatile uint32 *)0x4003604C))
 
+/*****************************************************************************
+ PWM Registers (PWM0 Generator 1, PWM1 Generator 3)
+ *****************************************************************************/
+#define PWM0_CTL_REG              (*((volatile uint32 *)0x40028000))
+#define PWM0_ENABLE_REG           (*((volatile uint32 *)0x40028008))
+#define PWM0_1_CTL_REG            (*((volatile uint32 *)0x40028080))
+#define PWM0_1_COUNT_REG          (*((volatile uint32 *)0x40028088))
+#define PWM0_1_LOAD_REG           (*((volatile uint32 *)0x40028090))
+#define PWM0_1_CMPA_REG           (*((volatile uint32 *)0x40028098))
+#define PWM0_1_CMPB_REG           (*((volatile uint32 *)0x4002809C))
+#define PWM0_1_GENA_REG           (*((volatile uint32 *)0x400280A0))
+
+#define PWM1_CTL_REG              (*((volatile uint32 *)0x40029000))
+#define PWM1_ENABLE_REG           (*((volatile uint32 *)0x40029008))
+#define PWM1_3_CTL_REG            (*((volatile uint32 *)0x40029100))
+#define PWM1_3_COUNT_REG          (*((volatile uint32 *)0x40029108))
+#define PWM1_3_LOAD_REG           (*((volatile uint32 *)0x40029110))
+#define PWM1_3_CMPA_REG           (*((volatile uint32 *)0x40029118))
+#define PWM1_3_CMPB_REG           (*((volatile uint32 *)0x4002911C))
+#define PWM1_3_GENB_REG           (*((volatile uint32 *)0x40029124))
+
+/*****************************************************************************
+ EEPROM Registers
+ *****************************************************************************/
+#define EEPROM_EESIZE_REG         (*((volatile uint32 *)0x400AF000))
+#define EEPROM_EEBLOCK_REG        (*((volatile uint32 *)0x400AF004))
+#define EEPROM_EEOFFSET_REG       (*((volatile uint32 *)0x400AF008))
+#define EEPROM_EERDWR_REG         (*((volatile uint32 *)0x400AF010))
+#define EEPROM_EERDWRINC_REG      (*((volatile uint32 *)0x400AF014))
+#define EEPROM_EEDONE_REG         (*((volatile uint32 *)0x400AF018))
+#define EEPROM_EESUPP_REG         (*((volatile uint32 *)0x400AF01C))
+
 #endif
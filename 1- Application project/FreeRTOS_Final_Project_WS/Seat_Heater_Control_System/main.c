@@ -12,8 +12,8 @@
 #include "FreeRTOS.h"
 #include "task.h"
 #include "semphr.h"
-#include "event_groups.h"
 #include "queue.h"
+#include "timers.h"
 
 /* MCAL includes. */
 #include "adc.h"
@@ -22,20 +22,35 @@
 #include "Port.h"
 #include "Mcu.h"
 #include "GPTM.h"
+#include "pwm.h"
+#include "eeprom.h"
 
 /* HAL includes. */
 #include "lm35.h"
 #include "Button.h"
 #include "Led.h"
 
+/* Control includes. */
+#include "Pid.h"
+#include "Settings.h"
+#include "PowerBudget.h"
+#include "PhaseStagger.h"
+#include "DiagLog.h"
+#include "FaultStore.h"
+#include "Dtc.h"
+#include "FaultExport.h"
+#include "FaultQuery.h"
+#include "FaultInject.h"
+#include "RunStats.h"
+#include "Trace.h"
+#include "JobMonitor.h"
+#include "LockProfile.h"
+#include "CpuLoad.h"
+
 /* Other includes. */
+#include <string.h>
 #include "tm4c123gh6pm_registers.h"
 
-/* Event bits for button interrupts: SW1 and SW3 for the driver, SW2 for the passenger */
-#define mainSW1_INTERRUPT_BIT       (1UL << 0UL) /* Bit for SW1 */
-#define mainSW2_INTERRUPT_BIT       (1UL << 0UL) /* Bit for SW2 */
-#define mainSW3_INTERRUPT_BIT       (1UL << 1UL) /* Bit for SW3 */
-
 /* Heater state definitions for the heating system */
 #define mainHEATER_STATE_OFF        0  /* Heater is off */
 #define mainHEATER_STATE_LOW        1  /* Low intensity */
@@ -52,7 +67,7 @@
 #define mainTEMP_MAX_VALID_RANGE    40 /* Max: 40C */
 #define mainTEMP_MIN_VALID_RANGE    5  /* Min: 5C */
 
-/* Desired temperature levels for the heating system */
+/* Default desired temperature levels for the heating system, the live ones are in the Settings module */
 #define mainDESIRED_TEMP_OFF        0   /* Off (0C) */
 #define mainDESIRED_TEMP_LOW        25  /* Low (25C) */
 #define mainDESIRED_TEMP_MEDIUM     30  /* Medium (30C) */
@@ -64,8 +79,34 @@
 #define mainDRIVER_SEAT_FAIL        0x66
 #define mainPASSENGER_SEAT_FAIL     0x77
 
-/* Diagnostic array size and element count */
-#define mainDIAGNOSTIC_SIZE         5   /* Max size of the diagnostic array */
+/* Diagnostic log capacity, a power of two: once it is full the oldest failures are overwritten */
+#define mainDIAGNOSTIC_SIZE         16  /* Max number of failures kept in the diagnostic log */
+
+#if ((mainDIAGNOSTIC_SIZE & (mainDIAGNOSTIC_SIZE - 1)) != 0)
+#error "mainDIAGNOSTIC_SIZE must be a power of two"
+#endif
+
+/*
+ * Persistent fault log: every mainFAULT_STORE_TASK_DELAY the fault store task copies up to
+ * mainFAULT_STORE_BATCH new entries of the diagnostic log to the EEPROM (FaultStore module), so the
+ * fault history survives a reset and the diagnostic tasks never wait for an EEPROM program cycle.
+ * The batch must keep up with the sensor faults, one per seat per second at most, and the diagnostic
+ * log must hold the entries of a whole delay.
+ */
+#define mainFAULT_STORE_TASK_DELAY  pdMS_TO_TICKS(5000)
+#define mainFAULT_STORE_BATCH       10
+
+#if (mainFAULT_STORE_BATCH > mainDIAGNOSTIC_SIZE)
+#error "The diagnostic log must hold a whole mainFAULT_STORE_BATCH"
+#endif
+
+/*
+ * Diagnostic trouble codes (Dtc module): one record per seat and failure code with its occurrences and
+ * a freeze frame, so a flapping sensor only adds its first failure to the diagnostic log. The fault store
+ * task ends an aging cycle every mainFAULT_STORE_TASK_DELAY, a trouble code whose failure stays away for
+ * mainDTC_AGING_CYCLES cycles (10 minutes) is cleared, and its next failure is logged again.
+ */
+#define mainDTC_AGING_CYCLES        120
 
 /*
  * Task delays for periodic tasks in the system:
@@ -79,11 +120,316 @@
 #define mainDISPLAY_TASK_DELAY          pdMS_TO_TICKS(500)
 #define mainRUNTIME_TASK_DELAY          (5000U)
 
+/*
+ * Heater control mode:
+ * - 0: Polling, the heater tasks recompute the heater state every mainHEATER_TASK_DELAY.
+ * - 1: Event driven, the heater tasks sleep until the sensor task reports a changed reading
+ *      or the button task reports a changed desired temperature. mainHEATER_WATCHDOG_DELAY
+ *      is the slow refresh period used when nothing has changed.
+ */
+#define mainHEATER_EVENT_DRIVEN         1
+#define mainHEATER_WATCHDOG_DELAY       pdMS_TO_TICKS(2500)
+
+/*
+ * Heater output:
+ * - 0: Discrete, the heater state is shown on the green and blue LEDs of the seat.
+ * - 1: PWM, the green LED of the seat is the heating element, driven by the PWM module. The heater
+ *      is on while the heater state of the seat is, so it keeps heating below the desired temperature
+ *      until the seat is warmer than it, as the discrete output does. The duty cycle is then a holding
+ *      duty plus a part proportional to the temperature difference, 100% from the high state threshold
+ *      of the seat below the desired temperature, and it only follows a fall of the difference once it
+ *      is more than the hysteresis of the seat. So the thresholds and the hysteresis of the settings
+ *      console act on both outputs. The holding duty starts at the power of the low state and
+ *      integrates the temperature difference over time (mainHEATER_HOLD_RATE), so the seat settles at
+ *      the desired temperature instead of below it (host thermal simulator, 4- Host tools/Thermal_Simulator).
+ *      The heater task only writes the duty registers. The LEDs then show the heating as green
+ *      brightness instead of the low/medium/high colours. The duty and window programming of the PWM
+ *      driver is checked on the host against a model of the PWM generators (4- Host tools/Pwm_Output).
+ */
+#define mainHEATER_PWM                  1
+#define mainHEATER_HOLD_DUTY            (PWM_DUTY_MAX / 3U)  /* Power of the low state */
+#define mainHEATER_HOLD_RATE            (50L * (sint32) configTICK_RATE_HZ)  /* Degree ticks per 1% of holding duty */
+
+/*
+ * Heater closed loop control (PWM output only):
+ * - 0: Proportional duty cycle as above.
+ * - 1: Fixed point PID controller per seat, sampled every mainHEATER_TASK_DELAY, so the heater
+ *      tasks must be periodic (mainHEATER_EVENT_DRIVEN 0). mainPID_KP/KI/KD are the per sample
+ *      gains in percent of duty per degree, tuned on the host thermal simulator (no derivative, the
+ *      1 degree sensor steps make it kick the output). When mainPID_AUTO_TUNE is 1, the first heating
+ *      of each seat runs a relay auto-tune around the desired temperature (mainPID_TUNE_HYSTERESIS
+ *      degrees) and replaces the gains with the measured ones; the default gains are kept if it fails.
+ *      The run time report has a PID line per seat with the CPU cycles of each Pid_Update call.
+ */
+#define mainHEATER_PID                  0
+#define mainPID_KP                      PID_Q16(15.0)
+#define mainPID_KI                      PID_Q16(0.02)
+#define mainPID_KD                      PID_Q16(0.0)
+#define mainPID_AUTO_TUNE               1
+#define mainPID_TUNE_HYSTERESIS         PID_INT_TO_Q16(1)
+
+#if (mainHEATER_PID == 1) && (mainHEATER_PWM == 0)
+#error "mainHEATER_PID needs the PWM heater output (mainHEATER_PWM 1)"
+#endif
+
+#if (mainHEATER_PID == 1) && (mainHEATER_EVENT_DRIVEN == 1)
+#error "mainHEATER_PID needs a fixed sample period (mainHEATER_EVENT_DRIVEN 0)"
+#endif
+
+/*
+ * Vehicle power budget:
+ * When mainPOWER_BUDGET is 1, each heater task requests the power of its duty cycle (PWM output) or
+ * heater state (LED output, low/medium/high is 1/3, 2/3 and all of the rated power) every control
+ * period, and drives the power granted by the PowerBudget module instead. mainPOWER_BUDGET_WATTS is
+ * shared by priority (0 first), and in proportion to the requests between seats of the same priority.
+ * A seat only gets power the other seats have given back, so the heaters never draw more than the
+ * budget together; in event driven mode the seats that must give back or can take power are woken.
+ * mainHEATER_RATED_WATTS is the power of one heater at 100% duty. The default budget covers both
+ * heaters at high, so two seats are only curtailed when it is lowered.
+ */
+#define mainPOWER_BUDGET                1
+#define mainPOWER_BUDGET_WATTS          120
+#define mainHEATER_RATED_WATTS          60
+#define mainDRIVER_POWER_PRIORITY       0
+#define mainPASSENGER_POWER_PRIORITY    0
+
+/*
+ * Heater switching (PWM output only):
+ * When mainHEATER_STAGGER is 1, the on-time of each heater starts where the on-time of the previous
+ * seat ends in the PWM period (PhaseStagger module), instead of every heater switching on at the start
+ * of the period. The supply current then steps by one seat load at a time, and two heaters are only
+ * on together when the duties add up to more than 100%. Each seat keeps its duty.
+ */
+#define mainHEATER_STAGGER              1
+
+#if (mainHEATER_STAGGER == 1) && (mainHEATER_PWM == 0)
+#error "mainHEATER_STAGGER needs the PWM heater output (mainHEATER_PWM 1)"
+#endif
+
+/*
+ * Button handling:
+ * The ISRs only timestamp the edges into the Button module queues, the button tasks run the debounce.
+ * A button task blocks until the first edge of a press and then polls every mainBUTTON_POLL_DELAY
+ * (shorter than BUTTON_DEBOUNCE_TIME) until the button is released and stable again.
+ * A click steps the heating level and a long press turns the seat heating off. When
+ * mainBUTTON_AUTO_REPEAT is 1, holding the button after the long press steps the level again every
+ * BUTTON_REPEAT_TIME.
+ */
+#define mainBUTTON_POLL_DELAY           pdMS_TO_TICKS(10)
+#define mainBUTTON_AUTO_REPEAT          1
+
+/*
+ * Settings console on UART0.
+ * The desired temperature of each heating level, the heater state thresholds and the hysteresis of
+ * each seat start from the default macros and are kept in the EEPROM. Commands, one per line:
+ * - get: print the settings of both seats.
+ * - set <d|p> <field> <value>: change a setting of the driver or passenger seat, field is low, medium
+ *   or high (desired temperatures), tlow, tmedium or thigh (thresholds) or hyst.
+ * - defaults: restore the defaults of both seats.
+ * - faults: print the persistent fault log, "FAULTS,<records>,<lost>" then one line per record, oldest
+ *   first: "FAULT,<sequence>,<timestamp>,<seat code>,<failure code>,<heating level>".
+ * - dtc: print the stored trouble codes, one line each: "DTC,<seat>,<code>,<status>,<occurrences>,
+ *   <first timestamp>,<last timestamp>,<aging cycles>,<temperature>,<heating level>,<heater state>,<cpu load>",
+ *   then "DTC,END". The seat is 0 (driver) or 1 (passenger), the code 0 (over range) or 1 (under range).
+ * - export: send the persistent fault log in the compact binary format of the FaultExport module, about
+ *   3.5 bytes per record instead of about 30 for "faults", after the line "EXPORT,<records>,<driver seat code>,
+ *   <passenger seat code>,<over range code>,<under range code>". Decode it with the fault export host tool.
+ * - query <d|p|*> <o|u|*> [<from> <to>]: print the records of the persistent fault log of a seat (or both)
+ *   and failure code (over range, under range or both) with a timestamp from <from> to <to> (the whole log
+ *   without them), in "faults" lines, then "QUERY,<records>". O(log n) EEPROM reads plus one per record.
+ * - count <d|p|*> <o|u|*> [<from> <to>]: print the number of such records, "COUNT,<records>".
+ * - summary: print one line per seat, "SUMMARY,<seat>,<over range records>,<under range records>,
+ *   <first timestamp>,<last timestamp>", from the index kept up to date by the fault store task.
+ * - deadlines: with mainDEADLINE_MONITOR, print the "DEADLINE" lines of the periodic jobs (see
+ *   prvDeadlineReportSend) then "DEADLINE,END".
+ * - locks: with LOCK_PROFILER, print the "LOCK" lines of the mutexes (see prvLockReportSend) then "LOCK,END".
+ *   "locks clear" also clears the statistics once printed, for the contention of the next interval.
+ * - load: with CPU_LOAD_MONITOR, print the "CPULOAD" line of the recent CPU load (see prvCpuLoadReportSend).
+ * The queries only cover the records stored since the last reset, as the timestamps restart with the timer.
+ * With FAULT_INJECTION set to 1 (FaultInject module), a fault injection scenario is loaded and run with:
+ * - inject clear: remove every step, "INJECT,<steps>".
+ * - inject add <target> <fault> <value> <period> <at> <duration>: add a step, "INJECT,<steps>". The target
+ *   is adc0, adc1 (ADC codes), lm0, lm1 (temperatures) of the driver and passenger sensors, or sw1, sw2, sw3;
+ *   the fault is stuck, spike, noise, drop or chatter (see FaultInject_FaultType); times are in ms from the run.
+ * - inject run [<seed>]: start the scenario, "INJECT,RUN,<timestamp>".
+ * - inject report: once the scenario is over, one line per step "INJECT,STEP,<step>,<target>,<fault>,<started>,
+ *   <start timestamp>,<detections>,<latency>", the latency from the start of the step to the timestamp of the
+ *   first xFailureLog entry it caused, in timer ticks, then "INJECT,END,<false positives>,<fault free samples>".
+ *   The fault injection host tool writes the commands from a scenario file and reads the report.
+ * With TRACE_RECORDER set to 1 (Trace module), the kernel event trace is recorded with:
+ * - trace start: clear the trace buffer and start recording, trace stop: stop recording. Both answer
+ *   "TRACE,<recording>,<records>,<lost records>".
+ * - trace dump: stop recording and send "TRACE,DUMP,<records>,<lost records>,<cpu clock>,<time shift>", the
+ *   names "TRACE,TASK,<tag>,<name>", "TRACE,QUEUE,<number>,<type>,<name>", "TRACE,ISR,<irq>,<name>" and, with
+ *   mainDEADLINE_MONITOR, "TRACE,JOB,<job>,<name>", then
+ *   "TRACE,DATA,<records>" followed by 4 bytes per record, oldest first, and "TRACE,END". The trace converter
+ *   host tool turns it into a Chrome / Perfetto trace.
+ *   The sensor and button tasks also record each change of a heater input, and the heater tasks each write of a
+ *   heater output (TRACE_EVENT_HEATER_INPUT / OUTPUT): the heater wakeup host tool counts the heater task wakeups
+ *   and measures the input to actuator latency from them.
+ * Every change is saved to the EEPROM, and the other commands are answered with the settings or ERROR.
+ */
+#define mainCONSOLE_LINE_SIZE           48
+#define mainCONSOLE_RX_QUEUE_LENGTH     16
+
+/*
+ * Task stack depths (in words, not in bytes!).
+ * Run a build with mainSTACK_PROFILING set to 1, capture the "STACK," lines of the UART output
+ * and feed them to the stack sizing host tool to get recommended values for these macros.
+ */
+#define mainSENSOR_TASK_STACK_SIZE          64
+#define mainBUTTON_TASK_STACK_SIZE          64
+#define mainDIAGNOSTIC_TASK_STACK_SIZE      64
+#define mainHEATER_TASK_STACK_SIZE          128
+#define mainDISPLAY_TASK_STACK_SIZE         64
+#define mainRUNTIME_TASK_STACK_SIZE         96
+#define mainCONSOLE_TASK_STACK_SIZE         128
+#define mainFAULT_STORE_TASK_STACK_SIZE     96
+
+/*
+ * Profiling switches. They are all 0 by default: their lines are sent with the CPU load by the run time
+ * task, over the 9600 baud UART and while it holds the display mutex, and some of them add kernel hooks.
+ * Set one to 1 here, or predefine it in the build options (e.g. mainSTACK_PROFILING=1), for a profiling
+ * build. RUN_STATS_ACTIVATIONS (for mainRUNTIME_PROFILING), LOCK_PROFILER, CPU_LOAD_MONITOR and
+ * TRACE_RECORDER are set the same way in their headers.
+ */
+
+/* Set to 1 to report the stack high water mark of every task with the CPU load */
+#ifndef mainSTACK_PROFILING
+#define mainSTACK_PROFILING                 0
+#endif
+
+/*
+ * Set to 1 to report the run time of every task with the CPU load, from the kernel run time counters
+ * and the RunStats activations (see FreeRTOSConfig.h), one line per task:
+ * "RUNTIME,<task>,<run time>,<CPU %>,<activations>,<execution min>,<mean>,<max>,<response min>,<mean>,<max>"
+ * with the times in us since the scheduler started. It follows RUN_STATS_ACTIVATIONS (RunStats.h), which
+ * compiles in the activation hooks, so set that one to enable it.
+ */
+#ifndef mainRUNTIME_PROFILING
+#define mainRUNTIME_PROFILING               RUN_STATS_ACTIVATIONS
+#endif
+
+#if (mainRUNTIME_PROFILING == 1) && (RUN_STATS_ACTIVATIONS == 0)
+#error "mainRUNTIME_PROFILING needs the activation hooks, set RUN_STATS_ACTIVATIONS to 1 (RunStats.h)"
+#endif
+
+/*
+ * Set to 1 to measure the input to actuator latencies with the DWT cycle counter and report them
+ * with the CPU load. Each path starts at an input and records the stages reached after it:
+ * - Button paths: from the last button edge seen by the port ISR (or a long press/repeat event) to
+ *   the button task wakeup, to the new heating level and to the heater LED write.
+ * - Sensor paths: from the ADC sample to the changed reading being reported, to the heater task
+ *   wakeup and to the heater LED write.
+ * A stage is only recorded when it is armed by the previous one, and a path is not restarted while
+ * its later stages are pending, so every sample belongs to one input. When disabled the probes
+ * compile to nothing.
+ */
+#ifndef mainLATENCY_PROFILING
+#define mainLATENCY_PROFILING               0
+#endif
+
+#define mainLATENCY_PATH_DRIVER_BUTTON      0
+#define mainLATENCY_PATH_PASSENGER_BUTTON   1
+#define mainLATENCY_PATH_DRIVER_SENSOR      2
+#define mainLATENCY_PATH_PASSENGER_SENSOR   3
+#define mainLATENCY_NUMBER_OF_PATHS         4
+
+#define mainLATENCY_STAGE_WAKE              0
+#define mainLATENCY_STAGE_DECISION          1
+#define mainLATENCY_STAGE_ACTUATOR          2
+#define mainLATENCY_NUMBER_OF_STAGES        3
+
+#define mainLATENCY_BIT(xStage)             (1U << (xStage))
+
+/* Histogram bucket i counts the latencies of i significant bits in us, the last one counts the rest */
+#define mainLATENCY_HISTOGRAM_SIZE          24
+
+#if (mainLATENCY_PROFILING == 1)
+#define mainLATENCY_START(xPath, uxStages)              prvLatencyStart((xPath), (uxStages))
+#define mainLATENCY_MARK(xPath, xStage, uxNextStages)   prvLatencyMark((xPath), (xStage), (uxNextStages))
+#define mainLATENCY_DISARM(xPath, uxStages)             prvLatencyDisarm((xPath), (uxStages))
+#else
+#define mainLATENCY_START(xPath, uxStages)
+#define mainLATENCY_MARK(xPath, xStage, uxNextStages)
+#define mainLATENCY_DISARM(xPath, uxStages)
+#endif
+
+/*
+ * Set to 1 to monitor the periodic jobs with the JobMonitor module. A job is released at its period
+ * boundary (the wake time of vTaskDelayUntil), and its release, start and completion are recorded with
+ * the DWT cycle counter: a job that completes after the next release misses its deadline, the delay
+ * from the release to the start is its release jitter. The deadline misses and a jitter histogram of
+ * every job are reported with the CPU load and by the console "deadlines" command, and with
+ * TRACE_RECORDER the jobs and the misses are also in the event trace. The first job of each task
+ * is not counted, and the heater tasks are only periodic when mainHEATER_EVENT_DRIVEN is 0.
+ */
+#ifndef mainDEADLINE_MONITOR
+#define mainDEADLINE_MONITOR                0
+#endif
+
+#define mainJOB_DRIVER_SENSOR               0   /* The sensors timer when mainUSE_SOFTWARE_TIMERS is 1 */
+#define mainJOB_PASSENGER_SENSOR            1
+#define mainJOB_DRIVER_HEATER               2
+#define mainJOB_PASSENGER_HEATER            3
+#define mainJOB_DISPLAY                     4
+#define mainJOB_RUNTIME                     5
+#define mainJOB_FAULT_STORE                 6
+#define mainNUMBER_OF_JOBS                  7
+
+/* The SysTick runs from the CPU clock, so the ticks are exactly this many cycles apart */
+#define mainJOB_CYCLES_PER_TICK             (configCPU_CLOCK_HZ / configTICK_RATE_HZ)
+
+#if (mainDEADLINE_MONITOR == 1)
+#define mainJOB_START(ucJob, xRelease)      prvJobStart((ucJob), (xRelease))
+#define mainJOB_END(ucJob)                  prvJobEnd(ucJob)
+#else
+#define mainJOB_START(ucJob, xRelease)
+#define mainJOB_END(ucJob)
+#endif
+
+/*
+ * Set to 1 to run the sensor processing of both seats as one software timer callback on the
+ * timer service (daemon) task instead of two sensor tasks. This saves two TCBs and stacks (676
+ * bytes of static RAM, ram_report -x mainUSE_SOFTWARE_TIMERS=1) and one context switch per
+ * sensor period (sensor_timer_test). Only the sensor jobs are converted, as a timer callback
+ * must not block: the button tasks wait for the notifications of their interrupts, the
+ * diagnostic and console tasks for their semaphores and queues, the heater tasks for their
+ * notifications and mutexes, and the fault store task waits for the EEPROM programming. The
+ * display and run time jobs hold the UART for hundreds of ms, which would delay every other
+ * timer callback.
+ */
+#define mainUSE_SOFTWARE_TIMERS             0
+
 /* Define thresholds for temperature differences */
 #define mainTEMP_DIFF_LOW_THRESHOLD         2   /* Threshold for low heating state (2C) */
 #define mainTEMP_DIFF_MEDIUM_THRESHOLD      5   /* Threshold for medium heating state (5C) */
 #define mainTEMP_DIFF_HIGH_THRESHOLD        10  /* Threshold for high heating state (10C) */
 
+/*
+ * Hysteresis of the heater states: the heater steps up as soon as the temperature difference reaches a
+ * threshold, but only steps down once it is this much below it, so it does not toggle on the 1 degree
+ * sensor steps. Below mainTEMP_DIFF_LOW_THRESHOLD the heater keeps its state until the seat is warmer
+ * than desired. The Settings module builds the decision table of each seat from these values.
+ */
+#define mainTEMP_HYSTERESIS                 1   /* Default hysteresis (1C) */
+
+#if (mainTEMP_DIFF_HIGH_THRESHOLD > SETTINGS_MAX_DIFF)
+#error "mainTEMP_DIFF_HIGH_THRESHOLD does not fit in the heater decision table"
+#endif
+
+/*
+ * Heater LEDs of each seat (green: low, blue: medium, both: high), written in one store through the
+ * address mask of the GPIO data register so the other pins of the port are not touched.
+ */
+#define mainDRIVER_GREEN_PIN                (1U << DioConf_LED_GREEN1_CHANNEL_NUM)
+#define mainDRIVER_BLUE_PIN                 (1U << DioConf_LED_BLUE1_CHANNEL_NUM)
+#define mainDRIVER_HEATER_LEDS_REG          GPIO_PORTF_DATA_MASKED_REG(mainDRIVER_GREEN_PIN | mainDRIVER_BLUE_PIN)
+
+#define mainPASSENGER_GREEN_PIN             (1U << DioConf_LED_GREEN2_CHANNEL_NUM)
+#define mainPASSENGER_BLUE_PIN              (1U << DioConf_LED_BLUE2_CHANNEL_NUM)
+#define mainPASSENGER_HEATER_LEDS_REG       GPIO_PORTB_DATA_MASKED_REG(mainPASSENGER_GREEN_PIN | mainPASSENGER_BLUE_PIN)
+
 /* Define the total number of heating levels */
 #define mainTOTAL_HEATING_LEVELS            4  /* Total heating levels available */
 
@@ -96,14 +442,8 @@ void Delay_MS(unsigned long long n)
         ;
 }
 
-/* Structure to log failure information for temperature sensors */
-typedef struct xFailureLog
-{
-    uint32 uiTimeStamp; /* Timestamp of the failure event */
-    uint8 ucFailureCode; /* Code indicating the type of failure */
-    uint8 ucFailureSeat; /* Identifier for the seat where the failure occurred */
-    uint8 ucHeatingLevel; /* Current heating level at the time of failure */
-} xFailureLog;
+/* Structure to log failure information for temperature sensors, as stored in the diagnostic log */
+typedef DiagLog_EntryType xFailureLog;
 
 /* Global Variables for heating system state management */
 
@@ -135,18 +475,224 @@ uint8 ucPassengerHeaterState = mainHEATER_STATE_OFF;
 uint8 ucDriverErrorFlag = pdFALSE;
 uint8 ucPassengerErrorFlag = pdFALSE;
 
-/* Diagnostic array section in RAM */
-xFailureLog xDiagnosticArray[mainDIAGNOSTIC_SIZE];
-uint8 ucDiagnosticIndex = 0;
+/* Diagnostic log section in RAM, appended by both diagnostic tasks without a lock */
+DiagLog_SlotType xDiagnosticArray[mainDIAGNOSTIC_SIZE];
+DiagLog_Type xDiagnosticLog;
+
+/* Diagnostic log entries overwritten before the fault store task copied them to the EEPROM */
+uint32 ulFaultStoreLost = 0;
 
-/* Arrays for storing runtime measurements of tasks (includes +1 for the Idle Task) */
-uint32 ullTasksOutTime[mainTOTAL_NUMBER_OF_TASKS + 1]; /* Timestamps for task exit times */
-uint32 ullTasksInTime[mainTOTAL_NUMBER_OF_TASKS + 1]; /* Timestamps for task entry times */
-uint32 ullTasksTotalTime[mainTOTAL_NUMBER_OF_TASKS + 1]; /* Total execution time for each task */
+/* Last CPU load measured by the run time task, in %, for the trouble code freeze frames */
+uint8 ucCpuLoad = 0;
+
+#if (mainLATENCY_PROFILING == 1)
+/* Latency statistics of one stage of a path, in us */
+typedef struct xLatencyStats
+{
+    uint32 ulCount; /* Number of recorded latencies */
+    uint32 ulMin; /* Shortest latency */
+    uint32 ulMax; /* Longest latency */
+    uint64 ullSum; /* Sum of the latencies, for the mean */
+    uint16 usHistogram[mainLATENCY_HISTOGRAM_SIZE]; /* log2 histogram */
+} xLatencyStats;
+
+/* Latency path: the cycle count of its input, the stages still expected for it and their statistics */
+typedef struct xLatencyPath
+{
+    uint32 ulStartCycles;
+    uint8 ucArmedStages;
+    xLatencyStats xStages[mainLATENCY_NUMBER_OF_STAGES];
+} xLatencyPath;
+
+xLatencyPath xLatencyPaths[mainLATENCY_NUMBER_OF_PATHS];
+#endif
+
+#if (mainDEADLINE_MONITOR == 1)
+/* Names of the monitored jobs, for the deadline report and the event trace */
+static const char *const pcJobNames[mainNUMBER_OF_JOBS] =
+{
+#if (mainUSE_SOFTWARE_TIMERS == 1)
+    "Sensors", "",
+#else
+    "Driver Sensor", "Passenger Sensor",
+#endif
+    "Driver Heater", "Passenger Heater", "Display Screen", "Run Time", "Fault Store"
+};
+#endif
+
+/* Default settings of a seat, used when the EEPROM holds no valid settings */
+static const Settings_SeatType xDefaultSeatSettings =
+{
+    { mainDESIRED_TEMP_OFF, mainDESIRED_TEMP_LOW, mainDESIRED_TEMP_MEDIUM, mainDESIRED_TEMP_HIGH },
+    { mainTEMP_DIFF_LOW_THRESHOLD, mainTEMP_DIFF_MEDIUM_THRESHOLD, mainTEMP_DIFF_HIGH_THRESHOLD },
+    mainTEMP_HYSTERESIS
+};
+
+/*
+ * Seat and failure codes of the fault log export, sent to the decoder with the export. Their positions
+ * are also the seat and failure code numbers of the fault log queries.
+ */
+static const FaultExport_DictionaryType xFaultExportDictionary =
+{
+    { mainDRIVER_SEAT_FAIL, mainPASSENGER_SEAT_FAIL },
+    { mainTEMP_OVER_RANGE_FAIL, mainTEMP_UNDER_RANGE_FAIL }
+};
+
+#if (mainPOWER_BUDGET == 1)
+/* Power budget configuration of the seats, indexed by the Settings seat numbers */
+static const PowerBudget_SeatConfigType xPowerBudgetSeats[SETTINGS_NUMBER_OF_SEATS] =
+{
+    { mainHEATER_RATED_WATTS, mainDRIVER_POWER_PRIORITY },
+    { mainHEATER_RATED_WATTS, mainPASSENGER_POWER_PRIORITY }
+};
+#endif
+
+#if (mainHEATER_STAGGER == 1)
+/* Duty cycle of each heater, the on-times of all the seats are placed from them */
+uint8 ucHeaterDuty[SETTINGS_NUMBER_OF_SEATS];
+#endif
+
+#if (mainHEATER_PWM == 0)
+/* Heater LED pins of each heater state */
+static const uint8 ucDriverHeaterLeds[4] =
+{
+    0, mainDRIVER_GREEN_PIN, mainDRIVER_BLUE_PIN, mainDRIVER_GREEN_PIN | mainDRIVER_BLUE_PIN
+};
+
+static const uint8 ucPassengerHeaterLeds[4] =
+{
+    0, mainPASSENGER_GREEN_PIN, mainPASSENGER_BLUE_PIN, mainPASSENGER_GREEN_PIN | mainPASSENGER_BLUE_PIN
+};
+#endif
+
+#if (mainHEATER_PWM == 1)
+/* Holding duty of a seat heater, written by its heater task */
+typedef struct xHeaterHold
+{
+    sint32 lDiffTicks; /* Temperature difference integrated since the heating started, in degree ticks */
+    TickType_t xLastUpdate;
+    sint8 cDiff; /* Temperature difference at the last update, it holds until the next one */
+    uint8 ucDiff; /* Temperature difference of the proportional part, after the hysteresis */
+} xHeaterHold;
+
+xHeaterHold xHeaterHolds[SETTINGS_NUMBER_OF_SEATS];
+#endif
+
+#if (mainHEATER_PID == 1)
+/* Heater controllers and their auto-tune state, owned by the heater tasks */
+Pid_StateType xDriverHeaterPid;
+Pid_StateType xPassengerHeaterPid;
+Pid_AutoTuneType xDriverHeaterPidTune;
+Pid_AutoTuneType xPassengerHeaterPidTune;
+
+/* CPU cycles of the Pid_Update calls of a seat (DWT cycle counter), written by its heater task */
+typedef struct xPidCycles
+{
+    uint32 ulCount;
+    uint32 ulMin;
+    uint32 ulMax;
+    uint64 ullSum;
+} xPidCycles;
+
+xPidCycles xHeaterPidCycles[SETTINGS_NUMBER_OF_SEATS];
+#endif
 
 /* The HW setup function */
 static void prvSetupHardware(void);
 
+#if (mainSTACK_PROFILING == 1)
+/* Stack high water mark report */
+static void prvStackReportLine(const char *pcStackSizeMacro, TaskHandle_t xTask, uint32 ulStackDepth);
+static void prvStackReportSend(void);
+#endif
+
+#if (mainRUNTIME_PROFILING == 1)
+/* Run time report of every task */
+static void prvRunTimeReportSend(uint64 ullTotalTime);
+#endif
+
+#if (mainLATENCY_PROFILING == 1)
+/* Latency probes and report */
+static void prvLatencyStart(uint8 ucPath, uint8 ucStages);
+static void prvLatencyMark(uint8 ucPath, uint8 ucStage, uint8 ucNextStages);
+static void prvLatencyDisarm(uint8 ucPath, uint8 ucStages);
+static void prvLatencyReportSend(void);
+#endif
+
+#if (mainDEADLINE_MONITOR == 1)
+/* Periodic job monitor and report */
+static void prvJobStart(uint8 ucJob, TickType_t xRelease);
+static void prvJobEnd(uint8 ucJob);
+static void prvDeadlineReportSend(void);
+#endif
+
+#if (LOCK_PROFILER == 1)
+/* Mutex contention report */
+static void prvLockReportSend(void);
+#endif
+
+#if (CPU_LOAD_MONITOR == 1)
+/* CPU load windows report */
+static void prvCpuLoadReportSend(void);
+#endif
+
+#if (mainHEATER_PWM == 1)
+/* Heater duty cycle of a seat for the current temperature and heater state */
+static uint8 prvHeaterDutyCycle(uint8 ucSeat, uint8 ucHeatingLevel, uint8 ucErrorFlag, uint8 ucDesiredTemperature, uint8 ucTemperature,
+                                uint8 ucHeaterState);
+
+/* Heater PWM output of a seat */
+static void prvHeaterSetDuty(uint8 ucSeat, uint8 ucDuty);
+#endif
+
+#if (mainHEATER_PID == 1)
+/* Heater duty cycle from the PID controller (or the auto-tune relay) of a seat, and its cycles report */
+static uint8 prvHeaterPidDutyCycle(uint8 ucSeat, Pid_StateType *pxPid, Pid_AutoTuneType *pxTune, uint8 ucHeatingLevel, uint8 ucErrorFlag,
+                                   uint8 ucDesiredTemperature, uint8 ucTemperature);
+static void prvPidReportSend(void);
+#endif
+
+#if (mainPOWER_BUDGET == 1)
+/* Heater power grants and report */
+static uint16 prvHeaterPowerGrant(uint8 ucSeat, uint16 usRequested);
+#if (mainHEATER_PWM == 1)
+static uint8 prvHeaterBudgetDuty(uint8 ucSeat, uint8 ucDuty);
+#else
+static uint8 prvHeaterBudgetState(uint8 ucSeat, uint8 ucHeaterState);
+#endif
+static void prvPowerReportSend(void);
+#endif
+
+/* Heater state from the decision table of a seat */
+static uint8 prvHeaterState(uint8 ucSeat, uint8 ucHeatingLevel, uint8 ucErrorFlag, uint8 ucDesiredTemperature, uint8 ucTemperature, uint8 ucHeaterState);
+
+/* New heating level for a button event */
+static uint8 prvNextHeatingLevel(uint8 ucHeatingLevel, Button_EventType xEvent);
+
+/* Settings console */
+static char *prvConsoleToken(char **ppcCursor);
+static Std_ReturnType prvConsoleCommand(char *pcLine);
+static Std_ReturnType prvConsoleApply(uint8 ucSeat, const Settings_SeatType *pxSeat);
+static void prvConsoleReport(Std_ReturnType xStatus);
+static Std_ReturnType prvConsoleSave(void);
+static void prvConsoleFaults(void);
+static void prvConsoleDtc(void);
+static void prvConsoleExport(void);
+static void prvConsoleExportBlock(FaultExport_BlockType *pxBlock);
+static void prvConsoleQuery(char *pcLine);
+static Std_ReturnType prvConsoleFilter(const char *pcSeat, const char *pcCode, uint8 *pucSeat, uint8 *pucCode);
+static Std_ReturnType prvConsoleNumber(const char *pcValue, uint32 *pulValue);
+static void prvConsoleFaultLine(const DiagLog_RecordType *pxRecord);
+static void prvConsoleSummary(void);
+
+/* Trouble codes, the Dtc module calls are serialized with critical sections */
+static void prvDtcReportFailed(uint8 ucSeat, const xFailureLog *pxLog, uint8 ucTemperature, uint8 ucHeaterState);
+static void prvDtcReportPassed(uint8 ucSeat);
+
+/* Sensor processing, run by the sensor tasks or by the sensors software timer */
+static void prvDriverSensorProcess(TickType_t xBlockTime);
+static void prvPassengerSensorProcess(TickType_t xBlockTime);
+
 /* FreeRTOS tasks */
 void vDriverSensorProcessTask(void *pvParameters);
 void vPassengerSensorsProcessTask(void *pvParameters);
@@ -163,6 +709,9 @@ void vPassengerHeatersProcessTask(void *pvParameters);
 void vDisplayScreenTask(void *pvParameters);
 void vRunTimeMeasurementsTask(void *pvParameters);
 
+void vConsoleTask(void *pvParameters);
+void vFaultStoreTask(void *pvParameters);
+
 /* Tasks Handles */
 TaskHandle_t xDriverSensorsProcessHandle;
 TaskHandle_t xPassengerSensorsProcessHandle;
@@ -179,9 +728,8 @@ TaskHandle_t xPassengerDiagnosticHandle;
 TaskHandle_t xDisplayScreenHandle;
 TaskHandle_t xRunTimeMeasurementsHandle;
 
-/* FreeRTOS Events Group */
-EventGroupHandle_t xDriverButtonsEventGroup;
-EventGroupHandle_t xPassengerButtonEventGroup;
+TaskHandle_t xConsoleHandle;
+TaskHandle_t xFaultStoreHandle;
 
 /* FreeRTOS Mutexes */
 xSemaphoreHandle xDisplayScreenMutex;
@@ -197,6 +745,9 @@ xSemaphoreHandle xPassengerTempValueMutex;
 xSemaphoreHandle xDriverHeaterStateMutex;
 xSemaphoreHandle xPassengerHeaterStateMutex;
 
+/* EEPROM access, the settings console and the fault store task both write it */
+xSemaphoreHandle xEepromMutex;
+
 /* FreeRTOS Binary Semaphores */
 xSemaphoreHandle xDriverErrorReportSemaphore;
 xSemaphoreHandle xPassengerErrorReportSemaphore;
@@ -205,6 +756,96 @@ xSemaphoreHandle xPassengerErrorReportSemaphore;
 QueueHandle_t xDriverDiagnosticQueue;
 QueueHandle_t xPassengerDiagnosticQueue;
 
+QueueHandle_t xConsoleRxQueue;
+
+#if (mainUSE_SOFTWARE_TIMERS == 1)
+/* FreeRTOS Software Timers */
+TimerHandle_t xSensorsTimer;
+
+static void prvSensorsTimerCallback(TimerHandle_t xTimer);
+#endif
+
+#if (FAULT_INJECTION == 1)
+/* Runs every tick while a fault injection scenario runs */
+TimerHandle_t xFaultInjectTimer;
+
+static void prvFaultInjectTimerCallback(TimerHandle_t xTimer);
+static void prvConsoleInject(char *pcLine);
+static void prvConsoleInjectReport(void);
+#endif
+
+#if (TRACE_RECORDER == 1)
+/* Kernel event trace console */
+static void prvConsoleTrace(char *pcLine);
+static void prvConsoleTraceDump(void);
+#endif
+
+/*
+ * Kernel object creation.
+ * When configSUPPORT_STATIC_ALLOCATION is 1 every object gets its own static control block
+ * (and stack or storage area) so no heap is needed and the RAM cost of each object is known
+ * at compile time. The RAM budget report of every object and the total is generated on the host
+ * from these calls (4- Host tools/Ram_Report), so the firmware does not carry it.
+ * Otherwise the objects are created from the FreeRTOS heap as before.
+ * The queues, semaphores and mutexes are added to the queue registry under their handle name
+ * (see configQUEUE_REGISTRY_SIZE).
+ */
+#if (configSUPPORT_STATIC_ALLOCATION == 1)
+
+#define mainCREATE_TASK(pxTaskCode, pcName, usStackDepth, uxPriority, pxHandle)                                          \
+do{                                                                                                                      \
+    static StackType_t xStack[(usStackDepth)];                                                                           \
+    static StaticTask_t xTaskBuffer;                                                                                     \
+    *(pxHandle) = xTaskCreateStatic((pxTaskCode), (pcName), (usStackDepth), NULL, (uxPriority), xStack, &xTaskBuffer);   \
+}while(0)
+
+#define mainCREATE_MUTEX(xHandle)                                                                                        \
+do{                                                                                                                      \
+    static StaticSemaphore_t xSemaphoreBuffer;                                                                           \
+    (xHandle) = xSemaphoreCreateMutexStatic(&xSemaphoreBuffer);                                                          \
+    vQueueAddToRegistry((xHandle), #xHandle);                                                                            \
+}while(0)
+
+#define mainCREATE_BINARY_SEMAPHORE(xHandle)                                                                             \
+do{                                                                                                                      \
+    static StaticSemaphore_t xSemaphoreBuffer;                                                                           \
+    (xHandle) = xSemaphoreCreateBinaryStatic(&xSemaphoreBuffer);                                                         \
+    vQueueAddToRegistry((xHandle), #xHandle);                                                                            \
+}while(0)
+
+#define mainCREATE_QUEUE(xHandle, uxQueueLength, uxItemSize)                                                             \
+do{                                                                                                                      \
+    static uint8 ucQueueStorage[(uxQueueLength) * (uxItemSize)];                                                         \
+    static StaticQueue_t xQueueBuffer;                                                                                   \
+    (xHandle) = xQueueCreateStatic((uxQueueLength), (uxItemSize), ucQueueStorage, &xQueueBuffer);                        \
+    vQueueAddToRegistry((xHandle), #xHandle);                                                                            \
+}while(0)
+
+#define mainCREATE_TIMER(xHandle, pcName, xPeriod, pxCallbackFunction)                                                  \
+do{                                                                                                                      \
+    static StaticTimer_t xTimerBuffer;                                                                                   \
+    (xHandle) = xTimerCreateStatic((pcName), (xPeriod), pdTRUE, NULL, (pxCallbackFunction), &xTimerBuffer);              \
+}while(0)
+
+/* Memory of the kernel owned tasks, handed to the kernel by the vApplicationGet...TaskMemory() callbacks */
+static StaticTask_t xIdleTaskBuffer;
+static StackType_t xIdleTaskStack[configMINIMAL_STACK_SIZE];
+static StaticTask_t xTimerTaskBuffer;
+static StackType_t xTimerTaskStack[configTIMER_TASK_STACK_DEPTH];
+
+#else
+
+#define mainCREATE_TASK(pxTaskCode, pcName, usStackDepth, uxPriority, pxHandle) \
+    xTaskCreate((pxTaskCode), (pcName), (usStackDepth), NULL, (uxPriority), (pxHandle))
+#define mainCREATE_MUTEX(xHandle)                                   ((xHandle) = xSemaphoreCreateMutex(), vQueueAddToRegistry((xHandle), #xHandle))
+#define mainCREATE_BINARY_SEMAPHORE(xHandle)                        ((xHandle) = xSemaphoreCreateBinary(), vQueueAddToRegistry((xHandle), #xHandle))
+#define mainCREATE_QUEUE(xHandle, uxQueueLength, uxItemSize) \
+    ((xHandle) = xQueueCreate((uxQueueLength), (uxItemSize)), vQueueAddToRegistry((xHandle), #xHandle))
+#define mainCREATE_TIMER(xHandle, pcName, xPeriod, pxCallbackFunction) \
+    ((xHandle) = xTimerCreate((pcName), (xPeriod), pdTRUE, NULL, (pxCallbackFunction)))
+
+#endif
+
 /*-------------------------------------------------------------------------------------------------------------------------------------*/
 
 int main(void)
@@ -217,29 +858,52 @@ int main(void)
     prvSetupHardware();
 
     /* Create a mutexs */
-    xDisplayScreenMutex = xSemaphoreCreateMutex();
+    mainCREATE_MUTEX(xDisplayScreenMutex);
 
-    xDriverDesiredTempMutex = xSemaphoreCreateMutex();
-    xDriverHeaterStateMutex = xSemaphoreCreateMutex();
-    xDriverHeatingLevelMutex = xSemaphoreCreateMutex();
-    xDriverTempValueMutex = xSemaphoreCreateMutex();
+    mainCREATE_MUTEX(xDriverDesiredTempMutex);
+    mainCREATE_MUTEX(xDriverHeaterStateMutex);
+    mainCREATE_MUTEX(xDriverHeatingLevelMutex);
+    mainCREATE_MUTEX(xDriverTempValueMutex);
 
-    xPassengerDesiredTempMutex = xSemaphoreCreateMutex();
-    xPassengerHeaterStateMutex = xSemaphoreCreateMutex();
-    xPassengerHeatingLevelMutex = xSemaphoreCreateMutex();
-    xPassengerTempValueMutex = xSemaphoreCreateMutex();
+    mainCREATE_MUTEX(xPassengerDesiredTempMutex);
+    mainCREATE_MUTEX(xPassengerHeaterStateMutex);
+    mainCREATE_MUTEX(xPassengerHeatingLevelMutex);
+    mainCREATE_MUTEX(xPassengerTempValueMutex);
 
-    /* Create event groups */
-    xDriverButtonsEventGroup = xEventGroupCreate();
-    xPassengerButtonEventGroup = xEventGroupCreate();
+    mainCREATE_MUTEX(xEepromMutex);
 
     /* Create binary semaphores */
-    xDriverErrorReportSemaphore = xSemaphoreCreateBinary();
-    xPassengerErrorReportSemaphore = xSemaphoreCreateBinary();
+    mainCREATE_BINARY_SEMAPHORE(xDriverErrorReportSemaphore);
+    mainCREATE_BINARY_SEMAPHORE(xPassengerErrorReportSemaphore);
+
+#if (mainHEATER_PID == 1)
+    /* Heater controllers, output in percent of duty cycle */
+    Pid_Init(&xDriverHeaterPid, mainPID_KP, mainPID_KI, mainPID_KD, 0, PID_INT_TO_Q16(PWM_DUTY_MAX));
+    Pid_Init(&xPassengerHeaterPid, mainPID_KP, mainPID_KI, mainPID_KD, 0, PID_INT_TO_Q16(PWM_DUTY_MAX));
+#if (mainPID_AUTO_TUNE == 1)
+    Pid_AutoTuneStart(&xDriverHeaterPidTune, 0, PID_INT_TO_Q16(PWM_DUTY_MAX), mainPID_TUNE_HYSTERESIS);
+    Pid_AutoTuneStart(&xPassengerHeaterPidTune, 0, PID_INT_TO_Q16(PWM_DUTY_MAX), mainPID_TUNE_HYSTERESIS);
+#else
+    xDriverHeaterPidTune.eStatus = PID_AUTOTUNE_DONE;
+    xPassengerHeaterPidTune.eStatus = PID_AUTOTUNE_DONE;
+#endif
+#endif
+
+#if (mainPOWER_BUDGET == 1)
+    PowerBudget_Init(xPowerBudgetSeats, SETTINGS_NUMBER_OF_SEATS, mainPOWER_BUDGET_WATTS);
+#endif
+
+    /* Empty diagnostic log, before the diagnostic tasks can append to it */
+    DiagLog_Init(&xDiagnosticLog, xDiagnosticArray, mainDIAGNOSTIC_SIZE);
+    Dtc_Init(mainDTC_AGING_CYCLES);
 
     /* Create diagnostic queues */
-    xDriverDiagnosticQueue = xQueueCreate(3, sizeof(xFailureLog));
-    xPassengerDiagnosticQueue = xQueueCreate(3, sizeof(xFailureLog));
+    mainCREATE_QUEUE(xDriverDiagnosticQueue, 3, sizeof(xFailureLog));
+    mainCREATE_QUEUE(xPassengerDiagnosticQueue, 3, sizeof(xFailureLog));
+
+    /* Create the console queue, then let the UART0 receive interrupt fill it */
+    mainCREATE_QUEUE(xConsoleRxQueue, mainCONSOLE_RX_QUEUE_LENGTH, sizeof(uint8));
+    UART0_EnableReceiveInterrupt();
 
     /*
      * Create FreeRTOS tasks for system functionalities, each with a specific role.
@@ -254,25 +918,41 @@ int main(void)
      * - Passenger Heater: Controls the passengers heating system based on temperature readings.
      * - Display Screen: Updates the display with temperature and heater status information.
      * - Run Time Measurements: Collects and reports runtime data for monitoring CPU load and task performance.
+     * - Console: Reads and changes the seat settings over UART.
      */
-    xTaskCreate(vDriverSensorProcessTask, "Driver Sensor", 64, NULL, 4, &xDriverSensorsProcessHandle);
-    xTaskCreate(vPassengerSensorsProcessTask, "Passenger Sensor", 64, NULL, 4, &xPassengerSensorsProcessHandle);
-
-    xTaskCreate(vDriverButtonsProcessTask, "Driver Button", 64, NULL, 3, &xDriverButtonsProcessHandle);
-    xTaskCreate(vPassengerButtonProcessTask, "Passenger Button", 64, NULL, 3, &xPassengerButtonProcessHandle);
-
-    xTaskCreate(vDriverDiagnosticTask, "Driver Diagnostic", 64, NULL, 2, &xDriverDiagnosticHandle);
-    xTaskCreate(vPassengerDiagnosticTask, "Passenger Diagnostic", 64, NULL, 2, &xPassengerDiagnosticHandle);
-
-    xTaskCreate(vDriverHeaterProcessTask, "Driver Heater", 128, NULL, 1, &xDriverHeaterProcessHandle);
-    xTaskCreate(vPassengerHeatersProcessTask, "Passenger Heater", 128, NULL, 1, &xPassengerHeaterProcessHandle);
-
-    xTaskCreate(vDisplayScreenTask, "Display Screen", 64, NULL, 1, &xDisplayScreenHandle);
-    xTaskCreate(vRunTimeMeasurementsTask, "Run Time", 64, NULL, 1, &xRunTimeMeasurementsHandle);
-
-    /* Set application task tags for runtime measurement */
+#if (mainUSE_SOFTWARE_TIMERS == 1)
+    /* Both seats are sampled by one auto-reload timer, so the daemon task wakes once per sensor period */
+    mainCREATE_TIMER(xSensorsTimer, "Sensors", mainSENSOR_TASK_DELAY, prvSensorsTimerCallback);
+    xTimerStart(xSensorsTimer, 0);
+#else
+    mainCREATE_TASK(vDriverSensorProcessTask, "Driver Sensor", mainSENSOR_TASK_STACK_SIZE, 4, &xDriverSensorsProcessHandle);
+    mainCREATE_TASK(vPassengerSensorsProcessTask, "Passenger Sensor", mainSENSOR_TASK_STACK_SIZE, 4, &xPassengerSensorsProcessHandle);
+#endif
+
+#if (FAULT_INJECTION == 1)
+    /* Started by the console "inject run" command, stops itself at the end of the scenario */
+    mainCREATE_TIMER(xFaultInjectTimer, "Fault Inject", pdMS_TO_TICKS(1), prvFaultInjectTimerCallback);
+#endif
+
+    mainCREATE_TASK(vDriverButtonsProcessTask, "Driver Button", mainBUTTON_TASK_STACK_SIZE, 3, &xDriverButtonsProcessHandle);
+    mainCREATE_TASK(vPassengerButtonProcessTask, "Passenger Button", mainBUTTON_TASK_STACK_SIZE, 3, &xPassengerButtonProcessHandle);
+
+    mainCREATE_TASK(vDriverDiagnosticTask, "Driver Diagnostic", mainDIAGNOSTIC_TASK_STACK_SIZE, 2, &xDriverDiagnosticHandle);
+    mainCREATE_TASK(vPassengerDiagnosticTask, "Passenger Diagnostic", mainDIAGNOSTIC_TASK_STACK_SIZE, 2, &xPassengerDiagnosticHandle);
+
+    mainCREATE_TASK(vDriverHeaterProcessTask, "Driver Heater", mainHEATER_TASK_STACK_SIZE, 1, &xDriverHeaterProcessHandle);
+    mainCREATE_TASK(vPassengerHeatersProcessTask, "Passenger Heater", mainHEATER_TASK_STACK_SIZE, 1, &xPassengerHeaterProcessHandle);
+
+    mainCREATE_TASK(vDisplayScreenTask, "Display Screen", mainDISPLAY_TASK_STACK_SIZE, 1, &xDisplayScreenHandle);
+    mainCREATE_TASK(vRunTimeMeasurementsTask, "Run Time", mainRUNTIME_TASK_STACK_SIZE, 1, &xRunTimeMeasurementsHandle);
+    mainCREATE_TASK(vConsoleTask, "Console", mainCONSOLE_TASK_STACK_SIZE, 1, &xConsoleHandle);
+    mainCREATE_TASK(vFaultStoreTask, "Fault Store", mainFAULT_STORE_TASK_STACK_SIZE, tskIDLE_PRIORITY, &xFaultStoreHandle);
+
+    /* Set application task tags for runtime measurement (the timer task is tagged by its startup hook) */
+#if (mainUSE_SOFTWARE_TIMERS == 0)
     vTaskSetApplicationTaskTag(xDriverSensorsProcessHandle, (TaskHookFunction_t) 1);
     vTaskSetApplicationTaskTag(xPassengerSensorsProcessHandle, (TaskHookFunction_t) 2);
+#endif
     vTaskSetApplicationTaskTag(xDriverButtonsProcessHandle, (TaskHookFunction_t) 3);
     vTaskSetApplicationTaskTag(xPassengerButtonProcessHandle, (TaskHookFunction_t) 4);
     vTaskSetApplicationTaskTag(xDriverDiagnosticHandle, (TaskHookFunction_t) 5);
@@ -281,6 +961,29 @@ int main(void)
     vTaskSetApplicationTaskTag(xPassengerHeaterProcessHandle, (TaskHookFunction_t) 8);
     vTaskSetApplicationTaskTag(xDisplayScreenHandle, (TaskHookFunction_t) 9);
     vTaskSetApplicationTaskTag(xRunTimeMeasurementsHandle, (TaskHookFunction_t) 10);
+    vTaskSetApplicationTaskTag(xConsoleHandle, (TaskHookFunction_t) 11);
+    vTaskSetApplicationTaskTag(xFaultStoreHandle, (TaskHookFunction_t) 12);
+
+#if (CPU_LOAD_MONITOR == 1)
+    /* One second windows of kernel ticks */
+    CpuLoad_Init(configTICK_RATE_HZ);
+#endif
+
+#if (mainDEADLINE_MONITOR == 1)
+    /* Periods of the periodic jobs, the jobs that are not periodic in this build are not monitored */
+    JobMonitor_Init(configCPU_CLOCK_HZ / 1000000UL);
+    JobMonitor_SetPeriod(mainJOB_DRIVER_SENSOR, mainSENSOR_TASK_DELAY * mainJOB_CYCLES_PER_TICK);
+#if (mainUSE_SOFTWARE_TIMERS == 0)
+    JobMonitor_SetPeriod(mainJOB_PASSENGER_SENSOR, mainSENSOR_TASK_DELAY * mainJOB_CYCLES_PER_TICK);
+#endif
+#if (mainHEATER_EVENT_DRIVEN == 0)
+    JobMonitor_SetPeriod(mainJOB_DRIVER_HEATER, mainHEATER_TASK_DELAY * mainJOB_CYCLES_PER_TICK);
+    JobMonitor_SetPeriod(mainJOB_PASSENGER_HEATER, mainHEATER_TASK_DELAY * mainJOB_CYCLES_PER_TICK);
+#endif
+    JobMonitor_SetPeriod(mainJOB_DISPLAY, mainDISPLAY_TASK_DELAY * mainJOB_CYCLES_PER_TICK);
+    JobMonitor_SetPeriod(mainJOB_RUNTIME, mainRUNTIME_TASK_DELAY * mainJOB_CYCLES_PER_TICK);
+    JobMonitor_SetPeriod(mainJOB_FAULT_STORE, mainFAULT_STORE_TASK_DELAY * mainJOB_CYCLES_PER_TICK);
+#endif
 
     /*
      * Start the FreeRTOS scheduler to begin task execution.
@@ -292,7 +995,7 @@ int main(void)
     /*
      * If the scheduler starts successfully, this line will never be reached.
      * If execution reaches here, it indicates that there was insufficient heap memory
-     * to create the idle task, which is a critical failure.
+     * to create the idle task (dynamic allocation builds only), which is a critical failure.
      */
     for (;;)
         ; /* Infinite loop to prevent any further execution */
@@ -309,6 +1012,8 @@ int main(void)
  */
 static void prvSetupHardware(void)
 {
+    Std_ReturnType xEepromStatus;
+
     /*
      * Call hardware initialization functions to configure various peripherals.
      * This could involve initializing the microcontroller, setting up port configurations,
@@ -318,820 +1023,3042 @@ static void prvSetupHardware(void)
     Mcu_Init(); /* Initialize the microcontroller settings */
     Port_Init(&Port_Configuration); /* Initialize GPIO ports according to configuration */
     Dio_Init(&Dio_Configuration); /* Initialize digital I/O settings */
+#if (mainHEATER_PWM == 1)
+    PWM_Init(); /* Move the green LEDs to the PWM module to drive the heaters */
+#endif
     GPIO_SetupButtonsInterrupt(); /* Configure interrupt handling for button inputs */
     ADC_Init(); /* Initialize ADC for temperature sensor readings */
     UART0_Init(); /* Initialize UART0 for serial communication */
     GPTM_WTimer0Init(); /* Initialize Timer0 for timing process */
+
+    /* Load the seat settings, the defaults are used if the EEPROM is not usable or holds no valid settings */
+    xEepromStatus = EEPROM_Init();
+    if (xEepromStatus != E_OK)
+    {
+        Settings_InitDefaults(&xDefaultSeatSettings); /* The EEPROM is not read, and the settings can not be saved */
+        UART0_SendString("Seat settings: defaults, EEPROM not usable\r\n");
+    }
+    else if (Settings_Init(&xDefaultSeatSettings) != E_OK)
+    {
+        UART0_SendString("Seat settings: defaults\r\n");
+    }
+    else
+    {
+        UART0_SendString("Seat settings: EEPROM\r\n");
+    }
+
+    /* Find the newest record of the persistent fault log, the faults are not persisted if the EEPROM is not usable */
+    if ((xEepromStatus == E_OK) && (FaultStore_Init() == E_OK))
+    {
+        FaultQuery_Init(xFaultExportDictionary.aucSeat, xFaultExportDictionary.aucCode);
+        UART0_SendString("Fault log: ");
+        UART0_SendInteger(FaultStore_Count());
+        UART0_SendString(" records\r\n");
+    }
+    else
+    {
+        UART0_SendString("Fault log: unavailable\r\n");
+    }
 }
 
 /*-------------------------------------------------------------------------------------------------------------------------------------*/
 
 /*
- * Task function to periodically process sensor data for driver temperature readings.
- * This task retrieves the temperature values from LM35 sensor at regular intervals.
- * - The driver's temperature is read from SENSOR0_CHANNEL_ID.
- * The task runs indefinitely with a delay between each iteration.
+ * Stack overflow hook, called by the kernel when configCHECK_FOR_STACK_OVERFLOW detects
+ * that a task has overflowed its stack. The system can not continue safely, so the heaters
+ * are switched off, the overflowing task is reported over UART and execution stops.
  */
-void vDriverSensorProcessTask(void *pvParameters)
+void vApplicationStackOverflowHook(TaskHandle_t xTask, char *pcTaskName)
 {
-    TickType_t xSensorLastWakeTime = xTaskGetTickCount(); /* Initialize the variable for precise periodic delays */
+    taskDISABLE_INTERRUPTS();
+
+#if (mainHEATER_PWM == 1)
+    PWM_SetDutyCycle(PWM_CHANNEL_GREEN1, 0);
+    PWM_SetDutyCycle(PWM_CHANNEL_GREEN2, 0);
+    PWM_Update();
+#else
+    Led_GREEN1_SetOff();
+    Led_BLUE1_SetOff();
+    Led_GREEN2_SetOff();
+    Led_BLUE2_SetOff();
+#endif
+
+    UART0_SendString("\r\nStack overflow in task: ");
+    UART0_SendString(pcTaskName);
+    UART0_SendString("\r\n");
 
     for (;;)
-    {
-        /*
-         * Retrieve the current temperature for the driver by reading from LM35 sensor
-         * connected to SENSOR0_CHANNEL_ID.
-         * The value is stored in ucDriverTemperatureValue.
-         */
-        xSemaphoreTake(xDriverTempValueMutex, portMAX_DELAY);
+        ;
+}
 
-        ucDriverTemperatureValue = LM35_getTemperature(SENSOR0_CHANNEL_ID);
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
 
-        xSemaphoreGive(xDriverTempValueMutex);
+/*
+ * Timer service task startup hook, called once on the timer service task before it processes any command.
+ * The kernel creates the timer service and idle tasks in vTaskStartScheduler(), so they are tagged here
+ * with their own run time slots; the sensor timer callback is counted in the timer service slot.
+ */
+void vApplicationDaemonTaskStartupHook(void)
+{
+    taskENTER_CRITICAL();
 
-        /*
-         * Check if the driver's temperature is outside the acceptable range (5C to 40C).
-         * If the temperature exceeds 40C or falls below 5C, it indicates a potential fault
-         * in the temperature reading or an abnormal condition.
-         */
-        if (ucDriverTemperatureValue > mainTEMP_MAX_VALID_RANGE || ucDriverTemperatureValue < mainTEMP_MIN_VALID_RANGE)
-        {
-            /* If the condition is met, the semaphore xDriverErrorReportSemaphore is given to signal
-             * that an error condition has occurred for the driver's temperature, allowing error task
-             * waiting on this semaphore to take appropriate action.
-             * */
-            if (!ucDriverErrorFlag)
-            {
-                xFailureLog xlog; /* Create a log for driver failure data */
+    /* The task was switched in under tag 0: close that interval and start one under its own tag */
+    RUN_STATS_SWITCHED_OUT(0, TRUE);
+    vTaskSetApplicationTaskTag(NULL, (TaskHookFunction_t) mainRUNTIME_TAG_TIMER);
+    RUN_STATS_SWITCHED_IN(mainRUNTIME_TAG_TIMER);
 
-                /* Capture the current system timestamp */
-                xlog.uiTimeStamp = GPTM_WTimer0Read();
+    vTaskSetApplicationTaskTag(xTaskGetIdleTaskHandle(), (TaskHookFunction_t) mainRUNTIME_TAG_IDLE);
 
-                /* Log the current driver heating level */
-                xlog.ucHeatingLevel = ucDriverHeatingLevel;
+    taskEXIT_CRITICAL();
+}
 
-                /* Determine if the driver temperature is out of valid range and set failure code */
-                if (ucDriverTemperatureValue > mainTEMP_MAX_VALID_RANGE)
-                {
-                    xlog.ucFailureCode = mainTEMP_OVER_RANGE_FAIL; /* Overheating detected */
-                }
-                else if (ucDriverTemperatureValue < mainTEMP_MIN_VALID_RANGE)
-                {
-                    xlog.ucFailureCode = mainTEMP_UNDER_RANGE_FAIL; /* Temperature too low */
-                }
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
 
-                /* Mark the failure as related to the driver's seat */
-                xlog.ucFailureSeat = mainDRIVER_SEAT_FAIL;
+#if (CPU_LOAD_MONITOR == 1)
 
-                /* Set error flag for the driver */
-                ucDriverErrorFlag = pdTRUE;
+/*
+ * Idle task hook, called on every turn of the idle loop: a counter update only.
+ */
+void vApplicationIdleHook(void)
+{
+    CpuLoad_Idle();
+}
 
-                /* Send the failure log to the driver diagnostic queue */
-                xQueueSend(xDriverDiagnosticQueue, &xlog, portMAX_DELAY);
+/*
+ * Tick hook, called from the SysTick interrupt once per tick. The SysTick counts down from its reload
+ * value since the tick, so the interrupt has run for the difference (the interrupt latency aside).
+ */
+void vApplicationTickHook(void)
+{
+    CpuLoad_Tick(SYSTICK_RELOAD_REG - SYSTICK_CURRENT_REG);
+}
 
-                /* Signal the error reporting task via semaphore */
-                xSemaphoreGive(xDriverErrorReportSemaphore);
+#endif
 
-            }
-        }
-        else if (ucDriverErrorFlag)
-        {
-            ucDriverErrorFlag = pdFALSE;
-            Led_RED1_SetOff();
-        }
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
 
-        /*
-         * Delay until 100ms has passed since the task's last execution to ensure consistent periodic timing.
-         */
-        vTaskDelayUntil(&xSensorLastWakeTime, mainSENSOR_TASK_DELAY); /* 100ms delay */
-    }
+#if (mainSTACK_PROFILING == 1)
+
+/*
+ * Send one stack report line in the format parsed by the stack sizing host tool:
+ * STACK,<stack size macro>,<task name>,<stack depth in words>,<high water mark in words>
+ * The high water mark is the minimum amount of free stack the task has had since it started.
+ */
+static void prvStackReportLine(const char *pcStackSizeMacro, TaskHandle_t xTask, uint32 ulStackDepth)
+{
+    UART0_SendString("STACK,");
+    UART0_SendString(pcStackSizeMacro);
+    UART0_SendString(",");
+    UART0_SendString(pcTaskGetName(xTask));
+    UART0_SendString(",");
+    UART0_SendInteger(ulStackDepth);
+    UART0_SendString(",");
+    UART0_SendInteger(uxTaskGetStackHighWaterMark(xTask));
+    UART0_SendString("\r\n");
+}
+
+/*
+ * Report the stack high water mark of all the application tasks and of the idle and timer tasks.
+ * The caller must hold xDisplayScreenMutex.
+ */
+static void prvStackReportSend(void)
+{
+#if (mainUSE_SOFTWARE_TIMERS == 0)
+    prvStackReportLine("mainSENSOR_TASK_STACK_SIZE", xDriverSensorsProcessHandle, mainSENSOR_TASK_STACK_SIZE);
+    prvStackReportLine("mainSENSOR_TASK_STACK_SIZE", xPassengerSensorsProcessHandle, mainSENSOR_TASK_STACK_SIZE);
+#endif
+    prvStackReportLine("mainBUTTON_TASK_STACK_SIZE", xDriverButtonsProcessHandle, mainBUTTON_TASK_STACK_SIZE);
+    prvStackReportLine("mainBUTTON_TASK_STACK_SIZE", xPassengerButtonProcessHandle, mainBUTTON_TASK_STACK_SIZE);
+    prvStackReportLine("mainDIAGNOSTIC_TASK_STACK_SIZE", xDriverDiagnosticHandle, mainDIAGNOSTIC_TASK_STACK_SIZE);
+    prvStackReportLine("mainDIAGNOSTIC_TASK_STACK_SIZE", xPassengerDiagnosticHandle, mainDIAGNOSTIC_TASK_STACK_SIZE);
+    prvStackReportLine("mainHEATER_TASK_STACK_SIZE", xDriverHeaterProcessHandle, mainHEATER_TASK_STACK_SIZE);
+    prvStackReportLine("mainHEATER_TASK_STACK_SIZE", xPassengerHeaterProcessHandle, mainHEATER_TASK_STACK_SIZE);
+    prvStackReportLine("mainDISPLAY_TASK_STACK_SIZE", xDisplayScreenHandle, mainDISPLAY_TASK_STACK_SIZE);
+    prvStackReportLine("mainRUNTIME_TASK_STACK_SIZE", xRunTimeMeasurementsHandle, mainRUNTIME_TASK_STACK_SIZE);
+    prvStackReportLine("mainCONSOLE_TASK_STACK_SIZE", xConsoleHandle, mainCONSOLE_TASK_STACK_SIZE);
+    prvStackReportLine("mainFAULT_STORE_TASK_STACK_SIZE", xFaultStoreHandle, mainFAULT_STORE_TASK_STACK_SIZE);
+    prvStackReportLine("configMINIMAL_STACK_SIZE", xTaskGetIdleTaskHandle(), configMINIMAL_STACK_SIZE);
+    prvStackReportLine("configTIMER_TASK_STACK_DEPTH", xTimerGetTimerDaemonTaskHandle(), configTIMER_TASK_STACK_DEPTH);
 }
 
+#endif
+
 /*-------------------------------------------------------------------------------------------------------------------------------------*/
 
+#if (mainRUNTIME_PROFILING == 1)
+
 /*
- * Task function to periodically process sensor data for passenger temperature readings.
- * This task retrieves the temperature values from LM35 sensor at regular intervals.
- * - The passenger's temperature is read from SENSOR1_CHANNEL_ID.
- * The task runs indefinitely with a delay between each iteration.
+ * Report the run time of every task, see mainRUNTIME_PROFILING, from the task states of the kernel and
+ * the RunStats slot of each task tag. ullTotalTime is the run time counter the CPU load was computed from.
+ * The caller must hold xDisplayScreenMutex.
  */
-void vPassengerSensorsProcessTask(void *pvParameters)
+static void prvRunTimeReportSend(uint64 ullTotalTime)
 {
-    TickType_t xSensorLastWakeTime = xTaskGetTickCount(); /* Initialize the variable for precise periodic delays */
-
-    for (;;)
+    static TaskStatus_t xTaskStatus[mainRUNTIME_TAG_IDLE]; /* Application, timer service and idle tasks */
+    RunStats_TaskType xStats;
+    UBaseType_t uxTasks;
+    UBaseType_t uxTask;
+    const uint32 ulCyclesPerUs = configCPU_CLOCK_HZ / 1000000UL;
+
+    uxTasks = uxTaskGetSystemState(xTaskStatus, mainRUNTIME_TAG_IDLE, NULL);
+    for (uxTask = 0; uxTask < uxTasks; uxTask++)
     {
-        /*
-         * Retrieve the current temperature for the passenger by reading from LM35 sensor
-         * connected to SENSOR1_CHANNEL_ID.
-         * The value is stored in ucDriverTemperatureValue.
-         */
-        xSemaphoreTake(xPassengerTempValueMutex, portMAX_DELAY);
+        taskENTER_CRITICAL();
+        if (RunStats_Read((uint8) (uint32) xTaskGetApplicationTaskTag(xTaskStatus[uxTask].xHandle), &xStats) != E_OK)
+        {
+            xStats.ulActivations = 0;
+        }
+        taskEXIT_CRITICAL();
+
+        UART0_SendString("RUNTIME,");
+        UART0_SendString(xTaskStatus[uxTask].pcTaskName);
+        UART0_SendString(",");
+        UART0_SendInteger(xTaskStatus[uxTask].ulRunTimeCounter / ulCyclesPerUs);
+        UART0_SendString(",");
+        UART0_SendInteger((xTaskStatus[uxTask].ulRunTimeCounter * 100U) / ullTotalTime);
+        UART0_SendString(",");
+        UART0_SendInteger(xStats.ulActivations);
+        UART0_SendString(",");
+        if (xStats.ulActivations > 0)
+        {
+            UART0_SendInteger(xStats.ulExecutionMin / ulCyclesPerUs);
+            UART0_SendString(",");
+            UART0_SendInteger((xStats.ullExecutionSum / xStats.ulActivations) / ulCyclesPerUs);
+            UART0_SendString(",");
+            UART0_SendInteger(xStats.ulExecutionMax / ulCyclesPerUs);
+            UART0_SendString(",");
+            UART0_SendInteger(xStats.ulResponseMin / ulCyclesPerUs);
+            UART0_SendString(",");
+            UART0_SendInteger((xStats.ullResponseSum / xStats.ulActivations) / ulCyclesPerUs);
+            UART0_SendString(",");
+            UART0_SendInteger(xStats.ulResponseMax / ulCyclesPerUs);
+        }
+        else
+        {
+            /* The idle task never leaves the ready state */
+            UART0_SendString("0,0,0,0,0,0");
+        }
+        UART0_SendString("\r\n");
+    }
+}
 
-        ucPassengerTemperatureValue = LM35_getTemperature(SENSOR1_CHANNEL_ID);
+#endif
 
-        xSemaphoreGive(xPassengerTempValueMutex);
-        /*
-         * Check if the passenger's temperature is outside the acceptable range (5C to 40C).
-         * Similar to the driver check, if the temperature exceeds 40C or falls below 5C,
-         * it indicates a fault or abnormal condition for the passenger's temperature reading.
-         */
-        if (ucPassengerTemperatureValue > mainTEMP_MAX_VALID_RANGE || ucPassengerTemperatureValue < mainTEMP_MIN_VALID_RANGE)
-        {
-            /* If the condition is met, the semaphore xPassengerErrorReportSemaphore is given,
-             * signaling an error condition for the passenger's temperature. This allows error task
-             * that are waiting on this semaphore to respond appropriately.
-             * */
-            if (!ucPassengerErrorFlag)
-            {
-                xFailureLog xlog; /* Create a log to store failure information */
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
 
-                /* Capture the current system time for diagnostics */
-                xlog.uiTimeStamp = GPTM_WTimer0Read();
+#if (mainLATENCY_PROFILING == 1)
 
-                /* Record the current heating level for the passenger */
-                xlog.ucHeatingLevel = ucPassengerHeatingLevel;
+/*
+ * Start a latency path at the current cycle count and arm ucStages.
+ * Called from the port ISRs and from tasks: the FROM_ISR critical section only raises BASEPRI, so it
+ * is valid in both contexts.
+ */
+static void prvLatencyStart(uint8 ucPath, uint8 ucStages)
+{
+    UBaseType_t uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
 
-                /* Check if the passenger's temperature is out of range and set failure code */
-                if (ucPassengerTemperatureValue > mainTEMP_MAX_VALID_RANGE)
-                {
-                    xlog.ucFailureCode = mainTEMP_OVER_RANGE_FAIL; /* Overheating detected */
-                }
-                else if (ucPassengerTemperatureValue < mainTEMP_MIN_VALID_RANGE)
-                {
-                    xlog.ucFailureCode = mainTEMP_UNDER_RANGE_FAIL; /* Temperature too low */
-                }
+    /* Keep the oldest input while its later stages are still pending */
+    if ((xLatencyPaths[ucPath].ucArmedStages & ~ucStages) == 0)
+    {
+        xLatencyPaths[ucPath].ulStartCycles = DWT_CYCCNT_REG;
+        xLatencyPaths[ucPath].ucArmedStages = ucStages;
+    }
 
-                /* Identify the failure as coming from the passenger seat */
-                xlog.ucFailureSeat = mainPASSENGER_SEAT_FAIL;
+    taskEXIT_CRITICAL_FROM_ISR(uxSavedInterruptStatus);
+}
 
-                /* Set error flag for passenger */
-                ucPassengerErrorFlag = pdTRUE;
+/*
+ * Record the latency of ucStage from the start of the path if the stage is armed, then arm ucNextStages.
+ */
+static void prvLatencyMark(uint8 ucPath, uint8 ucStage, uint8 ucNextStages)
+{
+    xLatencyPath *pxPath = &xLatencyPaths[ucPath];
+    xLatencyStats *pxStats = &pxPath->xStages[ucStage];
+    uint32 ulLatency;
+    uint32 ulValue;
+    uint8 ucBucket = 0;
 
-                /* Send the failure log to the diagnostic queue */
-                xQueueSend(xPassengerDiagnosticQueue, &xlog, portMAX_DELAY);
+    UBaseType_t uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
 
-                /* Notify the error reporting task via semaphore */
-                xSemaphoreGive(xPassengerErrorReportSemaphore);
+    if ((pxPath->ucArmedStages & mainLATENCY_BIT(ucStage)) != 0)
+    {
+        ulLatency = (DWT_CYCCNT_REG - pxPath->ulStartCycles) / (configCPU_CLOCK_HZ / 1000000UL); /* in us */
+        pxPath->ucArmedStages = (pxPath->ucArmedStages & ~mainLATENCY_BIT(ucStage)) | ucNextStages;
 
-            }
+        if ((pxStats->ulCount == 0) || (ulLatency < pxStats->ulMin))
+        {
+            pxStats->ulMin = ulLatency;
         }
-        else if (ucPassengerErrorFlag)
+        if (ulLatency > pxStats->ulMax)
         {
-            ucPassengerErrorFlag = pdFALSE;
-            Led_RED2_SetOff();
+            pxStats->ulMax = ulLatency;
         }
+        pxStats->ulCount++;
+        pxStats->ullSum += ulLatency;
 
-        /*
-         * Delay until 100ms has passed since the task's last execution to ensure consistent periodic timing.
-         */
-        vTaskDelayUntil(&xSensorLastWakeTime, mainSENSOR_TASK_DELAY); /* 100ms delay */
+        /* log2 bucket: number of significant bits */
+        for (ulValue = ulLatency; (ulValue != 0) && (ucBucket < (mainLATENCY_HISTOGRAM_SIZE - 1)); ulValue >>= 1)
+        {
+            ucBucket++;
+        }
+        pxStats->usHistogram[ucBucket]++;
     }
-}
 
-/*-------------------------------------------------------------------------------------------------------------------------------------*/
+    taskEXIT_CRITICAL_FROM_ISR(uxSavedInterruptStatus);
+}
 
 /*
- * Task function to periodically process button inputs.
- * This function waits for specific event bits to be set in an event group,
- * which are triggered by external interrupts (button presses).
- * Based on the event bits, the function adjusts the desired temperature
- * settings for driver and based on their respective heating levels.
+ * Drop the armed ucStages of a path, used when the expected stage did not happen (no LED change).
  */
-void vDriverButtonsProcessTask(void *pvParameters)
+static void prvLatencyDisarm(uint8 ucPath, uint8 ucStages)
 {
-    /* Variable to store the event bits that are set when an interrupt occurs */
-    EventBits_t xDriverButtonsEventGroupValue;
+    UBaseType_t uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
 
-    /* Define which event bits we are waiting for (button interrupts) */
-    const EventBits_t xBitsToWaitFor = (mainSW1_INTERRUPT_BIT | mainSW3_INTERRUPT_BIT);
+    xLatencyPaths[ucPath].ucArmedStages &= ~ucStages;
 
-    for (;;)
-    {
-        /*
-         * Wait for any of the specified event bits to be set in the event group.
-         * - xEventGroupWaitBits() will block until one or more of the bits in xBitsToWaitFor is set.
-         * - pdTRUE: Clear the event bits before returning.
-         * - pdFALSE: Wait for any bit to be set, not necessarily all bits.
-         * - portMAX_DELAY: Block indefinitely (no timeout).
-         */
-        xDriverButtonsEventGroupValue = xEventGroupWaitBits(xDriverButtonsEventGroup, /* The event group being waited on */
-                                                            xBitsToWaitFor, /* The bits to wait for */
-                                                            pdTRUE, /* Clear the bits after they are read */
-                                                            pdFALSE, /* Wait for any one of the bits */
-                                                            portMAX_DELAY); /* No timeout */
+    taskEXIT_CRITICAL_FROM_ISR(uxSavedInterruptStatus);
+}
 
-        /*
-         * Check if interrupts related to SW1 (PF4) or SW3 (PB0) have occurred.
-         * These interrupts will trigger adjustments to the driver's desired temperature.
-         */
-        if (((xDriverButtonsEventGroupValue & mainSW1_INTERRUPT_BIT) != 0) || ((xDriverButtonsEventGroupValue & mainSW3_INTERRUPT_BIT) != 0))
+/*
+ * Report the latency statistics of every recorded stage, one line per stage:
+ * LATENCY,<path>,<stage>,<count>,<min us>,<mean us>,<max us>,<histogram buckets up to the last used one>
+ * The caller must hold xDisplayScreenMutex.
+ */
+static void prvLatencyReportSend(void)
+{
+    static const char *const pcPathNames[mainLATENCY_NUMBER_OF_PATHS] = { "Driver Button", "Passenger Button", "Driver Sensor", "Passenger Sensor" };
+    static const char *const pcStageNames[mainLATENCY_NUMBER_OF_STAGES] = { "Wake", "Decision", "Actuator" };
+    xLatencyStats xStats;
+    uint8 ucPath, ucStage, ucBucket, ucLastBucket;
+
+    for (ucPath = 0; ucPath < mainLATENCY_NUMBER_OF_PATHS; ucPath++)
+    {
+        for (ucStage = 0; ucStage < mainLATENCY_NUMBER_OF_STAGES; ucStage++)
         {
-            /*
-             * Adjust the driver's desired temperature based on the current heating level.
-             * The desired temperature is set to a predefined value depending on the heating level:
-             *  - Level 0: Heating feature is off
-             *  - Level 1: Low heating (25C)
-             *  - Level 2: Medium heating (30C)
-             *  - Level 3: High heating (35C)
-             */
-            xSemaphoreTake(xDriverDesiredTempMutex, portMAX_DELAY);
+            /* Take a consistent copy, the probes may update the statistics while the UART is busy */
+            taskENTER_CRITICAL();
+            xStats = xLatencyPaths[ucPath].xStages[ucStage];
+            taskEXIT_CRITICAL();
 
-            if (ucDriverHeatingLevel == mainHEATING_LEVEL_OFF)
-            {
-                ucDriverDesiredTemperature = mainDESIRED_TEMP_OFF; /* Heating feature is off */
-            }
-            else if (ucDriverHeatingLevel == mainHEATING_LEVEL_LOW)
+            if (xStats.ulCount == 0)
             {
-                ucDriverDesiredTemperature = mainDESIRED_TEMP_LOW; /* Low heating: 25C */
+                continue;
             }
-            else if (ucDriverHeatingLevel == mainHEATING_LEVEL_MEDIUM)
+
+            UART0_SendString("LATENCY,");
+            UART0_SendString(pcPathNames[ucPath]);
+            UART0_SendString(",");
+            UART0_SendString(pcStageNames[ucStage]);
+            UART0_SendString(",");
+            UART0_SendInteger(xStats.ulCount);
+            UART0_SendString(",");
+            UART0_SendInteger(xStats.ulMin);
+            UART0_SendString(",");
+            UART0_SendInteger(xStats.ullSum / xStats.ulCount);
+            UART0_SendString(",");
+            UART0_SendInteger(xStats.ulMax);
+
+            ucLastBucket = 0;
+            for (ucBucket = 0; ucBucket < mainLATENCY_HISTOGRAM_SIZE; ucBucket++)
             {
-                ucDriverDesiredTemperature = mainDESIRED_TEMP_MEDIUM; /* Medium heating: 30C */
+                if (xStats.usHistogram[ucBucket] != 0)
+                {
+                    ucLastBucket = ucBucket;
+                }
             }
-            else if (ucDriverHeatingLevel == mainHEATING_LEVEL_HIGH)
+            for (ucBucket = 0; ucBucket <= ucLastBucket; ucBucket++)
             {
-                ucDriverDesiredTemperature = mainDESIRED_TEMP_HIGH; /* High heating: 35C */
+                UART0_SendString(ucBucket == 0 ? "," : " ");
+                UART0_SendInteger(xStats.usHistogram[ucBucket]);
             }
-
-            xSemaphoreGive(xDriverDesiredTempMutex);
+            UART0_SendString("\r\n");
         }
     }
 }
 
+#endif
+
 /*-------------------------------------------------------------------------------------------------------------------------------------*/
 
+#if (mainDEADLINE_MONITOR == 1)
+
 /*
- * Task function to periodically process button inputs.
- * This function waits for specific event bits to be set in an event group,
- * which are triggered by external interrupts (button presses).
- * Based on the event bits, the function adjusts the desired temperature
- * settings for passenger based on their respective heating levels.
+ * Start a job of ucJob released at the tick xRelease. The release is placed on the cycle counter from
+ * the SysTick count of the current tick, a tick that is pending is not counted in the tick count yet.
  */
-void vPassengerButtonProcessTask(void *pvParameters)
+static void prvJobStart(uint8 ucJob, TickType_t xRelease)
 {
-    /* Variable to store the event bits that are set when an interrupt occurs */
-    EventBits_t xPassengerButtonEventGroupValue;
-
-    /* Define which event bits we are waiting for (button interrupts) */
-    const EventBits_t xBitsToWaitFor = (mainSW2_INTERRUPT_BIT);
-
-    for (;;)
+    uint32 ulSinceTick;
+    uint32 ulNow;
+    TickType_t xTicks;
+
+    taskENTER_CRITICAL();
+    ulSinceTick = SYSTICK_RELOAD_REG - SYSTICK_CURRENT_REG;
+    ulNow = DWT_CYCCNT_REG;
+    xTicks = xTaskGetTickCount() - xRelease;
+    if ((NVIC_SYSTEM_INTCTRL & (1UL << 26)) != 0) /* PENDSTSET */
     {
-        /*
-         * Wait for any of the specified event bits to be set in the event group.
-         * - xEventGroupWaitBits() will block until one or more of the bits in xBitsToWaitFor is set.
-         * - pdTRUE: Clear the event bits before returning.
-         * - pdFALSE: Wait for any bit to be set, not necessarily all bits.
-         * - portMAX_DELAY: Block indefinitely (no timeout).
-         */
-        xPassengerButtonEventGroupValue = xEventGroupWaitBits(xPassengerButtonEventGroup, /* The event group being waited on */
-                                                              xBitsToWaitFor, /* The bits to wait for */
-                                                              pdTRUE, /* Clear the bits after they are read */
-                                                              pdFALSE, /* Wait for any one of the bits */
-                                                              portMAX_DELAY); /* No timeout */
-
-        /*
-         * Check if the interrupt related to SW2 (PF0) has occurred.
-         * This interrupt will trigger an adjustment to the passenger's desired temperature.
-         */
-        if ((xPassengerButtonEventGroupValue & mainSW2_INTERRUPT_BIT) != 0)
+        ulSinceTick = SYSTICK_RELOAD_REG - SYSTICK_CURRENT_REG;
+        ulNow = DWT_CYCCNT_REG;
+        xTicks++;
+    }
+    JobMonitor_Start(ucJob, ulNow - ulSinceTick - (xTicks * mainJOB_CYCLES_PER_TICK), ulNow);
+    taskEXIT_CRITICAL();
+}
+
+/*
+ * Complete the running job of ucJob, if one was started.
+ */
+static void prvJobEnd(uint8 ucJob)
+{
+    taskENTER_CRITICAL();
+    JobMonitor_End(ucJob, DWT_CYCCNT_REG);
+    taskEXIT_CRITICAL();
+}
+
+/*
+ * Report the periodic jobs, one line per monitored job:
+ * DEADLINE,<job>,<period ms>,<jobs>,<misses>,<jitter mean us>,<jitter max us>,<response last us>,<response max us>,
+ * <jitter histogram buckets up to the last used one>
+ * The caller must hold xDisplayScreenMutex.
+ */
+static void prvDeadlineReportSend(void)
+{
+    const uint32 ulCyclesPerUs = configCPU_CLOCK_HZ / 1000000UL;
+    JobMonitor_StatsType xStats;
+    uint8 ucJob, ucBucket, ucLastBucket;
+
+    for (ucJob = 0; ucJob < mainNUMBER_OF_JOBS; ucJob++)
+    {
+        /* Take a consistent copy, the jobs may complete while the UART is busy */
+        taskENTER_CRITICAL();
+        JobMonitor_Read(ucJob, &xStats);
+        taskEXIT_CRITICAL();
+
+        if ((xStats.ulPeriod == 0) || (xStats.ulJobs == 0))
         {
-            /*
-             * Adjust the passenger's desired temperature based on the current heating level.
-             * Similar to the driver, the passenger's desired temperature is set according to the heating level:
-             *  - Level 0: Heating feature is off
-             *  - Level 1: Low heating (25C)
-             *  - Level 2: Medium heating (30C)
-             *  - Level 3: High heating (35C)
-             */
-            xSemaphoreTake(xPassengerDesiredTempMutex, portMAX_DELAY);
+            continue;
+        }
 
-            if (ucPassengerHeatingLevel == mainHEATING_LEVEL_OFF)
-            {
-                ucPassengerDesiredTemperature = mainDESIRED_TEMP_OFF; /* Heating feature is off */
-            }
-            else if (ucPassengerHeatingLevel == mainHEATING_LEVEL_LOW)
-            {
-                ucPassengerDesiredTemperature = mainDESIRED_TEMP_LOW; /* Low heating: 25C */
-            }
-            else if (ucPassengerHeatingLevel == mainHEATING_LEVEL_MEDIUM)
-            {
-                ucPassengerDesiredTemperature = mainDESIRED_TEMP_MEDIUM; /* Medium heating: 30C */
-            }
-            else if (ucPassengerHeatingLevel == mainHEATING_LEVEL_HIGH)
+        UART0_SendString("DEADLINE,");
+        UART0_SendString((const uint8 *) pcJobNames[ucJob]);
+        UART0_SendString(",");
+        UART0_SendInteger(xStats.ulPeriod / (ulCyclesPerUs * 1000UL));
+        UART0_SendString(",");
+        UART0_SendInteger(xStats.ulJobs);
+        UART0_SendString(",");
+        UART0_SendInteger(xStats.ulMisses);
+        UART0_SendString(",");
+        UART0_SendInteger((xStats.ullJitterSum / xStats.ulJobs) / ulCyclesPerUs);
+        UART0_SendString(",");
+        UART0_SendInteger(xStats.ulJitterMax / ulCyclesPerUs);
+        UART0_SendString(",");
+        UART0_SendInteger(((xStats.xLast.ulEnd - xStats.xLast.ulRelease) & 0xFFFFFFFFUL) / ulCyclesPerUs);
+        UART0_SendString(",");
+        UART0_SendInteger(((xStats.xWorst.ulEnd - xStats.xWorst.ulRelease) & 0xFFFFFFFFUL) / ulCyclesPerUs);
+
+        ucLastBucket = 0;
+        for (ucBucket = 0; ucBucket < JOB_MONITOR_HISTOGRAM_SIZE; ucBucket++)
+        {
+            if (xStats.ausJitterHistogram[ucBucket] != 0)
             {
-                ucPassengerDesiredTemperature = mainDESIRED_TEMP_HIGH; /* High heating: 35C */
+                ucLastBucket = ucBucket;
             }
-
-            xSemaphoreGive(xPassengerDesiredTempMutex);
         }
+        for (ucBucket = 0; ucBucket <= ucLastBucket; ucBucket++)
+        {
+            UART0_SendString(ucBucket == 0 ? "," : " ");
+            UART0_SendInteger(xStats.ausJitterHistogram[ucBucket]);
+        }
+        UART0_SendString("\r\n");
     }
 }
 
+#endif
+
 /*-------------------------------------------------------------------------------------------------------------------------------------*/
 
+#if (CPU_LOAD_MONITOR == 1)
+
 /*
- * Optimized Task function to periodically control and passenger heating systems.
- * This task manages the heater's intensity based on the difference between the current and desired temperatures.
- * The heating intensity is simulated using LEDs.
- * - Low intensity: Green LED
- * - Medium intensity: Blue LED
- * - High intensity: Both Green and Blue LEDs (Cyan)
- * If the current temperature exceeds the desired temperature, the heater is disabled.
+ * Report the CPU load of the last 1, 10 and 60 seconds, then the part of it in the ISRs, in 0.1 %:
+ * CPULOAD,<load 1 s>,<load 10 s>,<load 60 s>,<ISR 1 s>,<ISR 10 s>,<ISR 60 s>
+ * A window is left empty until that many seconds have passed. The caller must hold xDisplayScreenMutex.
  */
-void vDriverHeaterProcessTask(void *pvParameters)
+static void prvCpuLoadReportSend(void)
 {
-    /* Get the current tick count to set up a periodic delay for the task */
-    TickType_t xDriverHeaterLastWakeTime = xTaskGetTickCount();
-
-    /* Variables to track the previous heater states for driver
-     * This helps to avoid unnecessary updates to the LEDs if the state doesn't change
-     */
-    uint8 ucPrevDriverHeaterState = 0xFF;
+    static const uint8 aucSeconds[] = { 1U, 10U, 60U };
+    CpuLoad_WindowType axWindow[sizeof(aucSeconds)];
+    Std_ReturnType axStatus[sizeof(aucSeconds)];
+    uint8 i;
 
-    for (;;)
+    for (i = 0; i < sizeof(aucSeconds); i++)
     {
-        /* ------------- Process Driver Heating ------------- */
-        xSemaphoreTake(xDriverDesiredTempMutex, portMAX_DELAY);
-        xSemaphoreTake(xDriverHeaterStateMutex, portMAX_DELAY);
-        xSemaphoreTake(xDriverHeatingLevelMutex, portMAX_DELAY);
-        xSemaphoreTake(xDriverTempValueMutex, portMAX_DELAY);
+        axStatus[i] = CpuLoad_Read(aucSeconds[i], &axWindow[i]);
+    }
 
-        /* Check if driver heating is enabled (heating level != 0) */
-        if ((ucDriverHeatingLevel != mainHEATING_LEVEL_OFF) && (ucDriverErrorFlag == pdFALSE))
+    UART0_SendString("CPULOAD");
+    for (i = 0; i < sizeof(aucSeconds); i++)
+    {
+        UART0_SendString(",");
+        if (axStatus[i] == E_OK)
         {
-            /* Check if the desired temperature is greater than or equal to the current temperature */
-            if (ucDriverDesiredTemperature >= ucDriverTemperatureValue)
-            {
-                /* Calculate the temperature difference */
-                uint8 driverTempDiff = ucDriverDesiredTemperature - ucDriverTemperatureValue;
-
-                /* Adjust the heater state based on the temperature difference */
-                if (driverTempDiff >= mainTEMP_DIFF_LOW_THRESHOLD && driverTempDiff < mainTEMP_DIFF_MEDIUM_THRESHOLD)
-                {
-                    /* Small difference, set the heater to low */
-                    ucDriverHeaterState = mainHEATER_STATE_LOW;
-                }
-                else if (driverTempDiff >= mainTEMP_DIFF_MEDIUM_THRESHOLD && driverTempDiff < mainTEMP_DIFF_HIGH_THRESHOLD)
-                {
-                    /* Moderate difference, set the heater to medium */
-                    ucDriverHeaterState = mainHEATER_STATE_MEDIUM;
-                }
-                else if (driverTempDiff >= mainTEMP_DIFF_HIGH_THRESHOLD)
-                {
-                    /* Large difference, set the heater to high */
-                    ucDriverHeaterState = mainHEATER_STATE_HIGH;
-                }
-            }
-            else
-            {
-                /* If the desired temperature is less than the current, turn off the heater */
-                ucDriverHeaterState = mainHEATER_STATE_OFF;
-            }
+            UART0_SendInteger(axWindow[i].usLoad);
         }
-        else
+    }
+    for (i = 0; i < sizeof(aucSeconds); i++)
+    {
+        UART0_SendString(",");
+        if (axStatus[i] == E_OK)
         {
-            /* If heating level is 0, ensure the heater is off */
-            ucDriverHeaterState = mainHEATER_STATE_OFF;
+            UART0_SendInteger(axWindow[i].usIsrLoad);
         }
+    }
+    UART0_SendString("\r\n");
+}
 
-        /* Update the driver's heater LEDs only if the heater state has changed */
-        if ((ucPrevDriverHeaterState != ucDriverHeaterState) || (ucDriverErrorFlag == pdTRUE))
-        {
-            /* Store the new state to prevent redundant updates */
-            ucPrevDriverHeaterState = ucDriverHeaterState;
+#endif
 
-            /* Control the LEDs based on the current heater state */
-            switch (ucDriverHeaterState)
-            {
-            case mainHEATER_STATE_LOW:
-                /* Low heat - turn on the green LED, turn off the blue LED */
-                Led_GREEN1_SetOn();
-                Led_BLUE1_SetOff();
-                break;
-            case mainHEATER_STATE_MEDIUM:
-                /* Medium heat - turn off the green LED, turn on the blue LED */
-                Led_GREEN1_SetOff();
-                Led_BLUE1_SetOn();
-                break;
-            case mainHEATER_STATE_HIGH:
-                /* High heat - turn on both green and blue LEDs */
-                Led_GREEN1_SetOn();
-                Led_BLUE1_SetOn();
-                break;
-            case mainHEATER_STATE_OFF:
-            default:
-                /* Heater off - turn off both LEDs */
-                Led_GREEN1_SetOff();
-                Led_BLUE1_SetOff();
-                break;
-            }
-        }
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
 
-        xSemaphoreGive(xDriverTempValueMutex);
-        xSemaphoreGive(xDriverHeatingLevelMutex);
-        xSemaphoreGive(xDriverHeaterStateMutex);
-        xSemaphoreGive(xDriverDesiredTempMutex);
+#if (LOCK_PROFILER == 1)
 
-        /* Delay the task for a period of 250ms to achieve periodic execution */
-        vTaskDelayUntil(&xDriverHeaterLastWakeTime, mainHEATER_TASK_DELAY);
+/*
+ * Report the mutexes, one line each in their creation order, with their registry name:
+ * LOCK,<mutex>,<acquisitions>,<contended>,<wait total us>,<wait max us>,<hold total us>,<hold max us>,
+ * <priority inheritances>,<timeouts>
+ * The display screen mutex is reported while the caller holds it, that hold is not counted yet.
+ */
+static void prvLockReportSend(void)
+{
+    const uint32 ulCyclesPerUs = configCPU_CLOCK_HZ / 1000000UL;
+    LockProfile_StatsType xStats;
+    void *pvMutex;
+    const char *pcName;
+    uint8 ucIndex;
+
+    for (ucIndex = 0; LockProfile_Read(ucIndex, &pvMutex, &xStats) == E_OK; ucIndex++)
+    {
+        pcName = pcQueueGetName((QueueHandle_t) pvMutex);
+
+        UART0_SendString("LOCK,");
+        UART0_SendString((const uint8 *) ((pcName != NULL) ? pcName : "?"));
+        UART0_SendString(",");
+        UART0_SendInteger(xStats.ulAcquisitions);
+        UART0_SendString(",");
+        UART0_SendInteger(xStats.ulContended);
+        UART0_SendString(",");
+        UART0_SendInteger(xStats.ullWaitSum / ulCyclesPerUs);
+        UART0_SendString(",");
+        UART0_SendInteger(xStats.ulWaitMax / ulCyclesPerUs);
+        UART0_SendString(",");
+        UART0_SendInteger(xStats.ullHoldSum / ulCyclesPerUs);
+        UART0_SendString(",");
+        UART0_SendInteger(xStats.ulHoldMax / ulCyclesPerUs);
+        UART0_SendString(",");
+        UART0_SendInteger(xStats.ulInherits);
+        UART0_SendString(",");
+        UART0_SendInteger(xStats.ulTimeouts);
+        UART0_SendString("\r\n");
     }
 }
 
+#endif
+
 /*-------------------------------------------------------------------------------------------------------------------------------------*/
 
+#if (configSUPPORT_STATIC_ALLOCATION == 1)
+
 /*
- * Optimized Task function to periodically control passenger heating systems.
- * This task manages the heater's intensity based on the difference between the current and desired temperatures.
- * The heating intensity is simulated using LEDs.
- * - Low intensity: Green LED
- * - Medium intensity: Blue LED
- * - High intensity: Both Green and Blue LEDs (Cyan)
- * If the current temperature exceeds the desired temperature, the heater is disabled.
+ * Provide the memory of the idle task, required when configSUPPORT_STATIC_ALLOCATION is 1.
  */
-void vPassengerHeatersProcessTask(void *pvParameters)
+void vApplicationGetIdleTaskMemory(StaticTask_t **ppxIdleTaskTCBBuffer, StackType_t **ppxIdleTaskStackBuffer, uint32_t *pulIdleTaskStackSize)
 {
-    /* Get the current tick count to set up a periodic delay for the task */
-    TickType_t xPassengerHeaterLastWakeTime = xTaskGetTickCount();
+    *ppxIdleTaskTCBBuffer = &xIdleTaskBuffer;
+    *ppxIdleTaskStackBuffer = xIdleTaskStack;
+    *pulIdleTaskStackSize = configMINIMAL_STACK_SIZE;
+}
 
-    /* Variables to track the previous heater states for passenger
-     * This helps to avoid unnecessary updates to the LEDs if the state doesn't change
+/*
+ * Provide the memory of the timer service task, required when configSUPPORT_STATIC_ALLOCATION
+ * and configUSE_TIMERS are both 1.
+ */
+void vApplicationGetTimerTaskMemory(StaticTask_t **ppxTimerTaskTCBBuffer, StackType_t **ppxTimerTaskStackBuffer, uint32_t *pulTimerTaskStackSize)
+{
+    *ppxTimerTaskTCBBuffer = &xTimerTaskBuffer;
+    *ppxTimerTaskStackBuffer = xTimerTaskStack;
+    *pulTimerTaskStackSize = configTIMER_TASK_STACK_DEPTH;
+}
+
+#endif
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+/*
+ * Function to process sensor data for driver temperature readings, called once per sensor period.
+ * It retrieves the temperature value from LM35 sensor.
+ * - The driver's temperature is read from SENSOR0_CHANNEL_ID.
+ * xBlockTime is the maximum time to wait for the temperature mutex and the diagnostic queue;
+ * it must be 0 when called from a software timer callback, which must never block.
+ */
+static void prvDriverSensorProcess(TickType_t xBlockTime)
+{
+#if (mainHEATER_EVENT_DRIVEN == 1) || (mainLATENCY_PROFILING == 1) || (TRACE_RECORDER == 1)
+    static uint8 ucPrevTemperatureValue = 0xFF; /* Last reading reported to the heater task */
+#endif
+
+    /*
+     * Retrieve the current temperature for the driver by reading from LM35 sensor
+     * connected to SENSOR0_CHANNEL_ID.
+     * The value is stored in ucDriverTemperatureValue.
      */
-    uint8 ucPrevPassengerHeaterState = 0xFF;
+    if (xSemaphoreTake(xDriverTempValueMutex, xBlockTime) == pdTRUE)
+    {
+        mainLATENCY_START(mainLATENCY_PATH_DRIVER_SENSOR, mainLATENCY_BIT(mainLATENCY_STAGE_DECISION));
+        ucDriverTemperatureValue = LM35_getTemperature(SENSOR0_CHANNEL_ID);
 
-    for (;;)
+        xSemaphoreGive(xDriverTempValueMutex);
+    }
+
+    /*
+     * Check if the driver's temperature is outside the acceptable range (5C to 40C).
+     * If the temperature exceeds 40C or falls below 5C, it indicates a potential fault
+     * in the temperature reading or an abnormal condition.
+     */
+    if (ucDriverTemperatureValue > mainTEMP_MAX_VALID_RANGE || ucDriverTemperatureValue < mainTEMP_MIN_VALID_RANGE)
     {
-        /* ------------- Process Passenger Heating ------------- */
-        xSemaphoreTake(xPassengerDesiredTempMutex, portMAX_DELAY);
-        xSemaphoreTake(xPassengerHeaterStateMutex, portMAX_DELAY);
-        xSemaphoreTake(xPassengerHeatingLevelMutex, portMAX_DELAY);
-        xSemaphoreTake(xPassengerTempValueMutex, portMAX_DELAY);
-        /* Check if passenger heating is enabled (heating level != 0) */
-        if ((ucPassengerHeatingLevel != mainHEATING_LEVEL_OFF) && (ucPassengerErrorFlag == pdFALSE))
+        /* If the condition is met, the semaphore xDriverErrorReportSemaphore is given to signal
+         * that an error condition has occurred for the driver's temperature, allowing error task
+         * waiting on this semaphore to take appropriate action.
+         * */
+        if (!ucDriverErrorFlag)
         {
-            /* Check if the desired temperature is greater than or equal to the current temperature */
-            if (ucPassengerDesiredTemperature >= ucPassengerTemperatureValue)
-            {
-                /* Calculate the temperature difference */
-                uint8 passengerTempDiff = ucPassengerDesiredTemperature - ucPassengerTemperatureValue;
+            xFailureLog xlog; /* Create a log for driver failure data */
 
-                /* Adjust the heater state based on the temperature difference */
-                if (passengerTempDiff >= mainTEMP_DIFF_LOW_THRESHOLD && passengerTempDiff < mainTEMP_DIFF_MEDIUM_THRESHOLD)
-                {
-                    /* Small difference, set the heater to low */
-                    ucPassengerHeaterState = mainHEATER_STATE_LOW;
-                }
-                else if (passengerTempDiff >= mainTEMP_DIFF_MEDIUM_THRESHOLD && passengerTempDiff < mainTEMP_DIFF_HIGH_THRESHOLD)
-                {
-                    /* Moderate difference, set the heater to medium */
-                    ucPassengerHeaterState = mainHEATER_STATE_MEDIUM;
-                }
-                else if (passengerTempDiff >= mainTEMP_DIFF_HIGH_THRESHOLD)
-                {
-                    /* Large difference, set the heater to high */
-                    ucPassengerHeaterState = mainHEATER_STATE_HIGH;
-                }
+            /* Capture the current system timestamp */
+            xlog.ulTimeStamp = GPTM_WTimer0Read();
+
+            /* Log the current driver heating level */
+            xlog.ucHeatingLevel = ucDriverHeatingLevel;
+
+            /* Determine if the driver temperature is out of valid range and set failure code */
+            if (ucDriverTemperatureValue > mainTEMP_MAX_VALID_RANGE)
+            {
+                xlog.ucFailureCode = mainTEMP_OVER_RANGE_FAIL; /* Overheating detected */
             }
-            else
+            else if (ucDriverTemperatureValue < mainTEMP_MIN_VALID_RANGE)
             {
-                /* If the desired temperature is less than the current, turn off the heater */
-                ucPassengerHeaterState = mainHEATER_STATE_OFF;
+                xlog.ucFailureCode = mainTEMP_UNDER_RANGE_FAIL; /* Temperature too low */
             }
-        }
-        else
-        {
-            /* If heating level is 0, ensure the heater is off */
-            ucPassengerHeaterState = mainHEATER_STATE_OFF;
-        }
 
-        /* Update the passenger's heater LEDs only if the heater state has changed */
-        if ((ucPrevPassengerHeaterState != ucPassengerHeaterState) || (ucPassengerErrorFlag == pdTRUE))
-        {
-            /* Store the new state to prevent redundant updates */
-            ucPrevPassengerHeaterState = ucPassengerHeaterState;
+            /* Mark the failure as related to the driver's seat */
+            xlog.ucFailureSeat = mainDRIVER_SEAT_FAIL;
+            FAULT_INJECT_DETECTED(SENSOR0_CHANNEL_ID, xlog.ulTimeStamp);
 
-            /* Control the LEDs based on the current heater state */
-            switch (ucPassengerHeaterState)
-            {
-            case mainHEATER_STATE_LOW:
-                /* Low heat - turn on the green LED, turn off the blue LED */
-                Led_GREEN2_SetOn();
-                Led_BLUE2_SetOff();
-                break;
-            case mainHEATER_STATE_MEDIUM:
-                /* Medium heat - turn off the green LED, turn on the blue LED */
-                Led_GREEN2_SetOff();
-                Led_BLUE2_SetOn();
-                break;
-            case mainHEATER_STATE_HIGH:
-                /* High heat - turn on both green and blue LEDs */
-                Led_GREEN2_SetOn();
-                Led_BLUE2_SetOn();
-                break;
-            case mainHEATER_STATE_OFF:
-            default:
-                /* Heater off - turn off both LEDs */
-                Led_GREEN2_SetOff();
-                Led_BLUE2_SetOff();
-                break;
-            }
-        }
+            /* Set error flag for the driver */
+            ucDriverErrorFlag = pdTRUE;
 
-        xSemaphoreGive(xPassengerTempValueMutex);
-        xSemaphoreGive(xPassengerHeatingLevelMutex);
-        xSemaphoreGive(xPassengerHeaterStateMutex);
-        xSemaphoreGive(xPassengerDesiredTempMutex);
+            /* Send the failure log to the driver diagnostic queue */
+            xQueueSend(xDriverDiagnosticQueue, &xlog, xBlockTime);
 
-        /* Delay the task for a period of 250ms to achieve periodic execution */
-        vTaskDelayUntil(&xPassengerHeaterLastWakeTime, mainHEATER_TASK_DELAY);
+            /* Signal the error reporting task via semaphore */
+            xSemaphoreGive(xDriverErrorReportSemaphore);
+
+        }
+    }
+    else if (ucDriverErrorFlag)
+    {
+        ucDriverErrorFlag = pdFALSE;
+        prvDtcReportPassed(SETTINGS_SEAT_DRIVER);
+        Led_RED1_SetOff();
     }
-}
 
-/*-------------------------------------------------------------------------------------------------------------------------------------*/
+#if (mainHEATER_EVENT_DRIVEN == 1) || (mainLATENCY_PROFILING == 1) || (TRACE_RECORDER == 1)
+    /* Wake the heater task only when the reading has changed (this also covers error flag changes) */
+    if (ucDriverTemperatureValue != ucPrevTemperatureValue)
+    {
+        ucPrevTemperatureValue = ucDriverTemperatureValue;
+        TRACE_RECORD(TRACE_EVENT_HEATER_INPUT, SETTINGS_SEAT_DRIVER);
+        mainLATENCY_MARK(mainLATENCY_PATH_DRIVER_SENSOR, mainLATENCY_STAGE_DECISION,
+                         mainLATENCY_BIT(mainLATENCY_STAGE_WAKE) | mainLATENCY_BIT(mainLATENCY_STAGE_ACTUATOR));
+#if (mainHEATER_EVENT_DRIVEN == 1)
+        xTaskNotifyGive(xDriverHeaterProcessHandle);
+#endif
+    }
+#endif
+}
 
 /*
- * Task function to handle error reporting for driver temperature sensors.
- * This task monitors error conditions based on semaphores signaling temperature faults.
- * - When an error is detected for the driver, it disables the driver's heater and turns on a red LED.
+ * Task function to periodically process sensor data for driver temperature readings.
+ * The task runs indefinitely with a delay between each iteration.
  */
-void vDriverDiagnosticTask(void *pvParameters)
+void vDriverSensorProcessTask(void *pvParameters)
 {
-    xFailureLog xlog; /* Structure to hold diagnostic information */
+    TickType_t xSensorLastWakeTime = xTaskGetTickCount(); /* Initialize the variable for precise periodic delays */
 
     for (;;)
     {
-        /*
-         * Block indefinitely until the xDriverErrorReportSemaphore is given by another task,
-         * which signals that the driver's temperature sensor has detected a fault (i.e., temperature
-         * outside of the acceptable range defined in the system).
-         */
-        xSemaphoreTake(xDriverErrorReportSemaphore, portMAX_DELAY);
-
-        /*
-         * Upon receiving the semaphore, immediately disable the driver's heater to ensure
-         * that the heating element does not remain active under potentially hazardous conditions.
-         * This ensures the safety of the system in case of temperature sensor faults.
-         */
-        xSemaphoreTake(xDriverHeaterStateMutex, portMAX_DELAY);
-
-        ucDriverHeaterState = mainHEATER_STATE_OFF;
-
-        xSemaphoreGive(xDriverHeaterStateMutex);
-
-        /*
-         * Retrieve diagnostic data from the xDriverDiagnosticQueue to log details about the error.
-         * The queue contains information about the seat where the failure occurred, a failure code,
-         * a timestamp of the error event, and the heating level at the time of the failure.
-         */
-        if (xQueueReceive(xDriverDiagnosticQueue, &xlog, portMAX_DELAY))
-        {
-            /* Store the diagnostic data in the uiDiagnosticArray for future reference and analysis. */
-            xDiagnosticArray[ucDiagnosticIndex].ucFailureSeat = xlog.ucFailureSeat; /* Seat number */
-            xDiagnosticArray[ucDiagnosticIndex].ucFailureCode = xlog.ucFailureCode; /* Failure code */
-            xDiagnosticArray[ucDiagnosticIndex].uiTimeStamp = xlog.uiTimeStamp; /* Timestamp */
-            xDiagnosticArray[ucDiagnosticIndex].ucHeatingLevel = xlog.ucHeatingLevel; /* Heating level */
-            ucDiagnosticIndex++; /* Increment the diagnostic index for the next entry */
-        }
+        prvDriverSensorProcess(portMAX_DELAY);
 
         /*
-         * Turn on the driver's red LED to indicate that an error has occurred in the temperature control system.
-         * This visual indication warns the driver that their heater is no longer active due to a sensor fault,
-         * alerting them to the issue so it can be addressed.
+         * Delay until 100ms has passed since the task's last execution to ensure consistent periodic timing.
          */
-        Led_RED1_SetOn();
+        mainJOB_END(mainJOB_DRIVER_SENSOR);
+        vTaskDelayUntil(&xSensorLastWakeTime, mainSENSOR_TASK_DELAY); /* 100ms delay */
+        mainJOB_START(mainJOB_DRIVER_SENSOR, xSensorLastWakeTime);
     }
 }
 
 /*-------------------------------------------------------------------------------------------------------------------------------------*/
 
 /*
- * Task function to handle error reporting for passenger temperature sensors.
- * This task monitors error conditions based on semaphores signaling temperature faults.
- * - When an error is detected for the passenger, it disables the passenger's heater and turns on a separate red LED.
+ * Function to process sensor data for passenger temperature readings, called once per sensor period.
+ * It retrieves the temperature value from LM35 sensor.
+ * - The passenger's temperature is read from SENSOR1_CHANNEL_ID.
+ * xBlockTime is the maximum time to wait for the temperature mutex and the diagnostic queue;
+ * it must be 0 when called from a software timer callback, which must never block.
  */
-void vPassengerDiagnosticTask(void *pvParameters)
+static void prvPassengerSensorProcess(TickType_t xBlockTime)
 {
-    xFailureLog xlog; /* Structure to store diagnostic information */
+#if (mainHEATER_EVENT_DRIVEN == 1) || (mainLATENCY_PROFILING == 1) || (TRACE_RECORDER == 1)
+    static uint8 ucPrevTemperatureValue = 0xFF; /* Last reading reported to the heater task */
+#endif
 
-    for (;;)
+    /*
+     * Retrieve the current temperature for the passenger by reading from LM35 sensor
+     * connected to SENSOR1_CHANNEL_ID.
+     * The value is stored in ucDriverTemperatureValue.
+     */
+    if (xSemaphoreTake(xPassengerTempValueMutex, xBlockTime) == pdTRUE)
     {
-        /*
-         * Wait indefinitely (blocking) for the xPassengerErrorReportSemaphore to become available.
-         * This semaphore is given by another task when the passenger's temperature sensor detects a fault
-         * (e.g., temperature outside the valid range). The task will not proceed until this event occurs.
-         */
-        xSemaphoreTake(xPassengerErrorReportSemaphore, portMAX_DELAY);
+        mainLATENCY_START(mainLATENCY_PATH_PASSENGER_SENSOR, mainLATENCY_BIT(mainLATENCY_STAGE_DECISION));
+        ucPassengerTemperatureValue = LM35_getTemperature(SENSOR1_CHANNEL_ID);
 
-        /*
-         * Once the semaphore is taken, the system reads diagnostic data from the xPassengerDiagnosticQueue.
-         * The queue contains information like the type of failure (seat and code), the timestamp,
-         * and the last heater level before the fault occurred.
-         */
-        if (xQueueReceive(xPassengerDiagnosticQueue, &xlog, portMAX_DELAY))
+        xSemaphoreGive(xPassengerTempValueMutex);
+    }
+    /*
+     * Check if the passenger's temperature is outside the acceptable range (5C to 40C).
+     * Similar to the driver check, if the temperature exceeds 40C or falls below 5C,
+     * it indicates a fault or abnormal condition for the passenger's temperature reading.
+     */
+    if (ucPassengerTemperatureValue > mainTEMP_MAX_VALID_RANGE || ucPassengerTemperatureValue < mainTEMP_MIN_VALID_RANGE)
+    {
+        /* If the condition is met, the semaphore xPassengerErrorReportSemaphore is given,
+         * signaling an error condition for the passenger's temperature. This allows error task
+         * that are waiting on this semaphore to respond appropriately.
+         * */
+        if (!ucPassengerErrorFlag)
         {
-            /* Store the diagnostic data in the uiDiagnosticArray for future reference and analysis. */
-            xDiagnosticArray[ucDiagnosticIndex].ucFailureSeat = xlog.ucFailureSeat; /* Seat number */
-            xDiagnosticArray[ucDiagnosticIndex].ucFailureCode = xlog.ucFailureCode; /* Failure code */
-            xDiagnosticArray[ucDiagnosticIndex].uiTimeStamp = xlog.uiTimeStamp; /* Timestamp */
-            xDiagnosticArray[ucDiagnosticIndex].ucHeatingLevel = xlog.ucHeatingLevel; /* Heating level */
-            ucDiagnosticIndex++; /* Increment the diagnostic index for the next entry */
-        }
+            xFailureLog xlog; /* Create a log to store failure information */
 
-        /*
-         * Disable the passenger's heater to ensure that no heating continues while the system is
-         * in an error state, preventing any potential safety risks.
-         */
-        xSemaphoreTake(xPassengerHeaterStateMutex, portMAX_DELAY);
+            /* Capture the current system time for diagnostics */
+            xlog.ulTimeStamp = GPTM_WTimer0Read();
 
-        ucPassengerHeaterState = mainHEATER_STATE_OFF;
+            /* Record the current heating level for the passenger */
+            xlog.ucHeatingLevel = ucPassengerHeatingLevel;
+
+            /* Check if the passenger's temperature is out of range and set failure code */
+            if (ucPassengerTemperatureValue > mainTEMP_MAX_VALID_RANGE)
+            {
+                xlog.ucFailureCode = mainTEMP_OVER_RANGE_FAIL; /* Overheating detected */
+            }
+            else if (ucPassengerTemperatureValue < mainTEMP_MIN_VALID_RANGE)
+            {
+                xlog.ucFailureCode = mainTEMP_UNDER_RANGE_FAIL; /* Temperature too low */
+            }
+
+            /* Identify the failure as coming from the passenger seat */
+            xlog.ucFailureSeat = mainPASSENGER_SEAT_FAIL;
+            FAULT_INJECT_DETECTED(SENSOR1_CHANNEL_ID, xlog.ulTimeStamp);
+
+            /* Set error flag for passenger */
+            ucPassengerErrorFlag = pdTRUE;
+
+            /* Send the failure log to the diagnostic queue */
+            xQueueSend(xPassengerDiagnosticQueue, &xlog, xBlockTime);
+
+            /* Notify the error reporting task via semaphore */
+            xSemaphoreGive(xPassengerErrorReportSemaphore);
+
+        }
+    }
+    else if (ucPassengerErrorFlag)
+    {
+        ucPassengerErrorFlag = pdFALSE;
+        prvDtcReportPassed(SETTINGS_SEAT_PASSENGER);
+        Led_RED2_SetOff();
+    }
+
+#if (mainHEATER_EVENT_DRIVEN == 1) || (mainLATENCY_PROFILING == 1) || (TRACE_RECORDER == 1)
+    /* Wake the heater task only when the reading has changed (this also covers error flag changes) */
+    if (ucPassengerTemperatureValue != ucPrevTemperatureValue)
+    {
+        ucPrevTemperatureValue = ucPassengerTemperatureValue;
+        TRACE_RECORD(TRACE_EVENT_HEATER_INPUT, SETTINGS_SEAT_PASSENGER);
+        mainLATENCY_MARK(mainLATENCY_PATH_PASSENGER_SENSOR, mainLATENCY_STAGE_DECISION,
+                         mainLATENCY_BIT(mainLATENCY_STAGE_WAKE) | mainLATENCY_BIT(mainLATENCY_STAGE_ACTUATOR));
+#if (mainHEATER_EVENT_DRIVEN == 1)
+        xTaskNotifyGive(xPassengerHeaterProcessHandle);
+#endif
+    }
+#endif
+}
+
+/*
+ * Task function to periodically process sensor data for passenger temperature readings.
+ * The task runs indefinitely with a delay between each iteration.
+ */
+void vPassengerSensorsProcessTask(void *pvParameters)
+{
+    TickType_t xSensorLastWakeTime = xTaskGetTickCount(); /* Initialize the variable for precise periodic delays */
+
+    for (;;)
+    {
+        prvPassengerSensorProcess(portMAX_DELAY);
 
-        xSemaphoreGive(xPassengerHeaterStateMutex);
         /*
-         * Turn on the red LED to indicate a fault in the passenger's heating system. This visual
-         * notification signals that the passenger heating is deactivated due to an error,
-         * prompting the user to check or fix the issue.
+         * Delay until 100ms has passed since the task's last execution to ensure consistent periodic timing.
          */
-        Led_RED2_SetOn();
+        mainJOB_END(mainJOB_PASSENGER_SENSOR);
+        vTaskDelayUntil(&xSensorLastWakeTime, mainSENSOR_TASK_DELAY); /* 100ms delay */
+        mainJOB_START(mainJOB_PASSENGER_SENSOR, xSensorLastWakeTime);
+    }
+}
+
+#if (mainUSE_SOFTWARE_TIMERS == 1)
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+/*
+ * Software timer callback that replaces both sensor tasks, called every 100ms on the timer service task.
+ * Timer callbacks must never block, so the sensor processing is called with a zero block time:
+ * a reading is skipped for one period if the heater task holds the temperature mutex.
+ */
+static void prvSensorsTimerCallback(TimerHandle_t xTimer)
+{
+    /* The expiry time is already the next one of the auto-reload timer */
+    mainJOB_START(mainJOB_DRIVER_SENSOR, xTimerGetExpiryTime(xTimer) - mainSENSOR_TASK_DELAY);
+
+    prvDriverSensorProcess(0);
+    prvPassengerSensorProcess(0);
+
+    mainJOB_END(mainJOB_DRIVER_SENSOR);
+}
+
+#endif
+
+#if (FAULT_INJECTION == 1)
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+/*
+ * Software timer callback of a fault injection run, called every millisecond on the timer service task.
+ * It moves the time of the injection hooks, and pends the GPIO interrupt of each button whose injected
+ * level changed, so the chatter goes through the same handler, debounce and events as a real bounce.
+ */
+static void prvFaultInjectTimerCallback(TimerHandle_t xTimer)
+{
+    uint8 ucEdges = FaultInject_Tick(GPTM_WTimer0Read());
+
+    if (ucEdges & ((1U << BUTTON_SW1) | (1U << BUTTON_SW2)))
+    {
+        NVIC_SW_TRIG_REG = GPIO_PORTF_IRQ_NUM;
+    }
+    if (ucEdges & (1U << BUTTON_SW3))
+    {
+        NVIC_SW_TRIG_REG = GPIO_PORTB_IRQ_NUM;
+    }
+    if (FaultInject_IsRunning() == FALSE)
+    {
+        xTimerStop(xTimer, 0);
+    }
+}
+
+#endif
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+/*
+ * Returns the next heater state with one lookup in the decision table of the seat, which the Settings
+ * module builds from the thresholds and the hysteresis of the seat.
+ */
+static uint8 prvHeaterState(uint8 ucSeat, uint8 ucHeatingLevel, uint8 ucErrorFlag, uint8 ucDesiredTemperature, uint8 ucTemperature,
+                            uint8 ucHeaterState)
+{
+    uint8 ucEnabled = (uint8) ((ucHeatingLevel != mainHEATING_LEVEL_OFF) && (ucErrorFlag == pdFALSE));
+    uint8 ucTempDiff = (uint8) (ucDesiredTemperature - ucTemperature);
+    uint8 ucColumn;
+
+    ucColumn = (ucTempDiff > SETTINGS_MAX_DIFF) ? SETTINGS_MAX_DIFF : ucTempDiff;
+    ucColumn = ((ucEnabled == pdFALSE) || (ucTemperature > ucDesiredTemperature)) ? SETTINGS_OFF_COLUMN : ucColumn;
+
+    return SETTINGS_NEXT_HEATER_STATE(ucSeat, ucHeaterState, ucColumn);
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+#if (mainPOWER_BUDGET == 1)
+
+/*
+ * Requests power for a seat from the budget and returns the power granted, in W.
+ * In event driven mode, the other heater tasks that must give back power or can take the power
+ * released are woken, so the budget is rebalanced without waiting for their watchdog period.
+ */
+static uint16 prvHeaterPowerGrant(uint8 ucSeat, uint16 usRequested)
+{
+    uint16 usGranted;
+    uint32 ulPending;
+
+    /* Both heater tasks allocate, the allocation is O(seats) */
+    taskENTER_CRITICAL();
+    usGranted = PowerBudget_Allocate(ucSeat, usRequested);
+    ulPending = PowerBudget_PendingSeats() & ~(1UL << ucSeat);
+    taskEXIT_CRITICAL();
+
+#if (mainHEATER_EVENT_DRIVEN == 1)
+    if (ulPending & (1UL << SETTINGS_SEAT_DRIVER))
+    {
+        xTaskNotifyGive(xDriverHeaterProcessHandle);
+    }
+    if (ulPending & (1UL << SETTINGS_SEAT_PASSENGER))
+    {
+        xTaskNotifyGive(xPassengerHeaterProcessHandle);
+    }
+#else
+    (void) ulPending;
+#endif
+
+    return usGranted;
+}
+
+#if (mainHEATER_PWM == 1)
+
+/*
+ * Returns the duty cycle within the power granted to the seat: the requested duty when it is granted
+ * in full, otherwise the duty of the granted power rounded down.
+ */
+static uint8 prvHeaterBudgetDuty(uint8 ucSeat, uint8 ucDuty)
+{
+    uint16 usRequested = (uint16) (((ucDuty * (uint32) mainHEATER_RATED_WATTS) + PWM_DUTY_MAX - 1U) / PWM_DUTY_MAX);
+    uint16 usGranted = prvHeaterPowerGrant(ucSeat, usRequested);
+
+    if (usGranted >= usRequested)
+    {
+        return ucDuty;
+    }
+    return (uint8) ((usGranted * (uint32) PWM_DUTY_MAX) / mainHEATER_RATED_WATTS);
+}
+
+#else
+
+/* Power of a heater state: 1/3, 2/3 and all of the rated power for low, medium and high */
+#define mainHEATER_STATE_WATTS(ucState)     ((uint16) ((((ucState) * (uint32) mainHEATER_RATED_WATTS) + 2U) / 3U))
+
+/*
+ * Returns the highest heater state, up to the requested one, within the power granted to the seat.
+ */
+static uint8 prvHeaterBudgetState(uint8 ucSeat, uint8 ucHeaterState)
+{
+    uint16 usGranted = prvHeaterPowerGrant(ucSeat, mainHEATER_STATE_WATTS(ucHeaterState));
+
+    while ((ucHeaterState > mainHEATER_STATE_OFF) && (mainHEATER_STATE_WATTS(ucHeaterState) > usGranted))
+    {
+        ucHeaterState--;
+    }
+    return ucHeaterState;
+}
+
+#endif
+
+/*
+ * Report the power budget of every seat, one line per seat:
+ * POWER,<seat>,<requested W>,<granted W>,<allocations>,<curtailed allocations>
+ * The caller must hold xDisplayScreenMutex.
+ */
+static void prvPowerReportSend(void)
+{
+    static const char *const pcSeatNames[SETTINGS_NUMBER_OF_SEATS] = { "Driver", "Passenger" };
+    PowerBudget_SeatStatusType xStatus;
+    uint8 ucSeat;
+
+    for (ucSeat = 0; ucSeat < SETTINGS_NUMBER_OF_SEATS; ucSeat++)
+    {
+        /* Take a consistent copy, the heater tasks may allocate while the UART is busy */
+        taskENTER_CRITICAL();
+        xStatus = *PowerBudget_GetStatus(ucSeat);
+        taskEXIT_CRITICAL();
+
+        UART0_SendString("POWER,");
+        UART0_SendString(pcSeatNames[ucSeat]);
+        UART0_SendString(",");
+        UART0_SendInteger(xStatus.usRequested);
+        UART0_SendString(",");
+        UART0_SendInteger(xStatus.usGranted);
+        UART0_SendString(",");
+        UART0_SendInteger(xStatus.ulAllocations);
+        UART0_SendString(",");
+        UART0_SendInteger(xStatus.ulCurtailed);
+        UART0_SendString("\r\n");
+    }
+}
+
+#endif
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+#if (mainHEATER_PWM == 1)
+
+/*
+ * Returns the heater duty cycle of a seat in percent: 0% when the heating is off, the sensor is in error
+ * or the heater state is off, otherwise the holding duty plus 100% / the high threshold of the seat per
+ * degree below the desired temperature, at most 100%. These degrees follow a rise of the difference at
+ * once, and a fall only once it is more than the hysteresis of the seat. The holding duty restarts from
+ * the power of the low state when the heating is turned on, and integrates the temperature difference
+ * over the ticks since the last call, whatever the heater state: the difference is constant in between,
+ * as a new reading or desired temperature wakes the heater task.
+ */
+static uint8 prvHeaterDutyCycle(uint8 ucSeat, uint8 ucHeatingLevel, uint8 ucErrorFlag, uint8 ucDesiredTemperature, uint8 ucTemperature,
+                                uint8 ucHeaterState)
+{
+    xHeaterHold *pxHold = &xHeaterHolds[ucSeat];
+    TickType_t xNow = xTaskGetTickCount();
+    uint8 ucTempDiff = (ucTemperature < ucDesiredTemperature) ? (uint8) (ucDesiredTemperature - ucTemperature) : 0U;
+    sint32 lDuty;
+
+    if ((ucHeatingLevel == mainHEATING_LEVEL_OFF) || (ucErrorFlag == pdTRUE))
+    {
+        pxHold->lDiffTicks = 0;
+        pxHold->cDiff = 0;
+        pxHold->ucDiff = 0;
+        pxHold->xLastUpdate = xNow;
+        return 0;
+    }
+
+    /* Keep the holding duty within 0% to 100% */
+    pxHold->lDiffTicks += (sint32) pxHold->cDiff * (sint32) (xNow - pxHold->xLastUpdate);
+    if (pxHold->lDiffTicks < -((sint32) mainHEATER_HOLD_DUTY * mainHEATER_HOLD_RATE))
+    {
+        pxHold->lDiffTicks = -((sint32) mainHEATER_HOLD_DUTY * mainHEATER_HOLD_RATE);
+    }
+    else if (pxHold->lDiffTicks > ((sint32) (PWM_DUTY_MAX - mainHEATER_HOLD_DUTY) * mainHEATER_HOLD_RATE))
+    {
+        pxHold->lDiffTicks = (sint32) (PWM_DUTY_MAX - mainHEATER_HOLD_DUTY) * mainHEATER_HOLD_RATE;
+    }
+    pxHold->cDiff = (sint8) ((sint32) ucDesiredTemperature - (sint32) ucTemperature);
+    pxHold->xLastUpdate = xNow;
+
+    if (ucHeaterState == mainHEATER_STATE_OFF)
+    {
+        pxHold->ucDiff = 0;
+        return 0;
+    }
+
+    if (ucTempDiff > pxHold->ucDiff)
+    {
+        pxHold->ucDiff = ucTempDiff;
+    }
+    else if ((ucTempDiff + SETTINGS_HYSTERESIS(ucSeat)) < pxHold->ucDiff)
+    {
+        pxHold->ucDiff = ucTempDiff + SETTINGS_HYSTERESIS(ucSeat);
+    }
+
+    lDuty = (sint32) mainHEATER_HOLD_DUTY + (pxHold->lDiffTicks / mainHEATER_HOLD_RATE);
+    lDuty += ((sint32) pxHold->ucDiff * (sint32) PWM_DUTY_MAX) / (sint32) SETTINGS_HIGH_THRESHOLD(ucSeat);
+
+    return (uint8) ((lDuty > (sint32) PWM_DUTY_MAX) ? PWM_DUTY_MAX : lDuty);
+}
+
+/*
+ * Writes the duty cycle of a seat heater. With mainHEATER_STAGGER, the on-times of all the seats are
+ * placed again around the new duty and written together; PWM_Update applies the windows of both seats
+ * at the same period end, and the periods of the outputs are aligned, so no period mixes old and new windows.
+ * The critical section also keeps the interrupts out of PWM_Update.
+ */
+static void prvHeaterSetDuty(uint8 ucSeat, uint8 ucDuty)
+{
+    static const PWM_ChannelType xHeaterChannels[SETTINGS_NUMBER_OF_SEATS] = { PWM_CHANNEL_GREEN1, PWM_CHANNEL_GREEN2 };
+#if (mainHEATER_STAGGER == 1)
+    uint8 aucStart[SETTINGS_NUMBER_OF_SEATS];
+    uint8 i;
+
+    /* Both heater tasks write, and the windows of both seats must be placed from the same duties */
+    taskENTER_CRITICAL();
+    ucHeaterDuty[ucSeat] = ucDuty;
+    PhaseStagger_Place(ucHeaterDuty, SETTINGS_NUMBER_OF_SEATS, aucStart);
+    for (i = 0; i < SETTINGS_NUMBER_OF_SEATS; i++)
+    {
+        PWM_SetDutyWindow(xHeaterChannels[i], aucStart[i], ucHeaterDuty[i]);
+    }
+    PWM_Update();
+    taskEXIT_CRITICAL();
+#else
+    taskENTER_CRITICAL();
+    PWM_SetDutyCycle(xHeaterChannels[ucSeat], ucDuty);
+    PWM_Update();
+    taskEXIT_CRITICAL();
+#endif
+}
+
+#endif
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+#if (mainHEATER_PID == 1)
+
+/*
+ * Returns the heater duty cycle in percent computed by the seat controller, called once per heater
+ * period. The controller is reset while the heating is off or the sensor is in error, so it restarts
+ * without integral windup. A running auto-tune drives the heater with its relay instead, restarts
+ * when interrupted and loads the measured gains once it completes. The controller update is timed
+ * with the DWT cycle counter.
+ */
+static uint8 prvHeaterPidDutyCycle(uint8 ucSeat, Pid_StateType *pxPid, Pid_AutoTuneType *pxTune, uint8 ucHeatingLevel, uint8 ucErrorFlag,
+                                   uint8 ucDesiredTemperature, uint8 ucTemperature)
+{
+    xPidCycles *pxCycles = &xHeaterPidCycles[ucSeat];
+    Pid_Q16Type lSetpoint = PID_INT_TO_Q16(ucDesiredTemperature);
+    Pid_Q16Type lMeasurement = PID_INT_TO_Q16(ucTemperature);
+    Pid_Q16Type lOutput;
+    uint32 ulCycles;
+
+    if ((ucHeatingLevel == mainHEATING_LEVEL_OFF) || (ucErrorFlag == pdTRUE))
+    {
+        Pid_Reset(pxPid, lMeasurement);
+        if (pxTune->eStatus == PID_AUTOTUNE_RUNNING)
+        {
+            Pid_AutoTuneStart(pxTune, pxTune->lOutputLow, pxTune->lOutputHigh, pxTune->lHysteresis);
+        }
+        return 0;
+    }
+
+    if (pxTune->eStatus == PID_AUTOTUNE_RUNNING)
+    {
+        lOutput = Pid_AutoTuneStep(pxTune, lSetpoint, lMeasurement);
+        if (pxTune->eStatus == PID_AUTOTUNE_RUNNING)
+        {
+            return (uint8) PID_Q16_TO_INT(lOutput);
+        }
+
+        /* Auto-tune finished: keep the default gains if it failed, then start the controller bumpless */
+        Pid_AutoTuneApply(pxTune, pxPid);
+        Pid_Reset(pxPid, lMeasurement);
+    }
+
+    ulCycles = DWT_CYCCNT_REG;
+    lOutput = Pid_Update(pxPid, lSetpoint, lMeasurement);
+    ulCycles = DWT_CYCCNT_REG - ulCycles;
+
+    /* The report reads the statistics in a critical section */
+    taskENTER_CRITICAL();
+    if ((pxCycles->ulCount == 0) || (ulCycles < pxCycles->ulMin))
+    {
+        pxCycles->ulMin = ulCycles;
+    }
+    if (ulCycles > pxCycles->ulMax)
+    {
+        pxCycles->ulMax = ulCycles;
+    }
+    pxCycles->ullSum += ulCycles;
+    pxCycles->ulCount++;
+    taskEXIT_CRITICAL();
+
+    return (uint8) PID_Q16_TO_INT(lOutput);
+}
+
+/*
+ * Report the CPU cycles of the controller update of every seat, one line per seat:
+ * PID,<seat>,<updates>,<min cycles>,<mean cycles>,<max cycles>
+ * A call preempted by an interrupt counts the interrupt too, so the minimum is the closest to the
+ * update alone. The caller must hold xDisplayScreenMutex.
+ */
+static void prvPidReportSend(void)
+{
+    static const char *const pcSeatNames[SETTINGS_NUMBER_OF_SEATS] = { "Driver", "Passenger" };
+    xPidCycles xCycles;
+    uint8 ucSeat;
+
+    for (ucSeat = 0; ucSeat < SETTINGS_NUMBER_OF_SEATS; ucSeat++)
+    {
+        taskENTER_CRITICAL();
+        xCycles = xHeaterPidCycles[ucSeat];
+        taskEXIT_CRITICAL();
+
+        if (xCycles.ulCount == 0)
+        {
+            continue;
+        }
+
+        UART0_SendString("PID,");
+        UART0_SendString(pcSeatNames[ucSeat]);
+        UART0_SendString(",");
+        UART0_SendInteger(xCycles.ulCount);
+        UART0_SendString(",");
+        UART0_SendInteger(xCycles.ulMin);
+        UART0_SendString(",");
+        UART0_SendInteger(xCycles.ullSum / xCycles.ulCount);
+        UART0_SendString(",");
+        UART0_SendInteger(xCycles.ulMax);
+        UART0_SendString("\r\n");
+    }
+}
+
+#endif
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+/*
+ * Returns the heating level after a debounced button event.
+ * A click (or an auto-repeat step) cycles through the levels, wrapping back to 0 after level 3:
+ *  - 0: Heating feature is off
+ *  - 1: Low heating (25C)
+ *  - 2: Medium heating (30C)
+ *  - 3: High heating (35C)
+ * A long press turns the heating off directly.
+ */
+static uint8 prvNextHeatingLevel(uint8 ucHeatingLevel, Button_EventType xEvent)
+{
+    switch (xEvent)
+    {
+    case BUTTON_EVENT_CLICK:
+        return (ucHeatingLevel + 1) % mainTOTAL_HEATING_LEVELS;
+    case BUTTON_EVENT_LONG_PRESS:
+        return mainHEATING_LEVEL_OFF;
+    case BUTTON_EVENT_REPEAT:
+#if (mainBUTTON_AUTO_REPEAT == 1)
+        return (ucHeatingLevel + 1) % mainTOTAL_HEATING_LEVELS;
+#else
+        return ucHeatingLevel;
+#endif
+    case BUTTON_EVENT_NONE:
+    default:
+        return ucHeatingLevel;
+    }
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+/*
+ * Task function to process the driver buttons (SW1 and SW3).
+ * The task blocks until the port ISR captures the first edge of a press, then polls the Button module
+ * debounce state machine until both buttons are released and stable again, so contact bounce does not
+ * wake it up. The debounced events update the driver heating level, and the desired temperature
+ * setting follows the new heating level.
+ */
+void vDriverButtonsProcessTask(void *pvParameters)
+{
+    Button_EventType xEvent;
+    uint32 ulNow;
+    uint8 ucHeatingLevel;
+
+    for (;;)
+    {
+        /* Sleep while both buttons are idle, poll while a press is being debounced or held */
+        if ((Button_IsIdle(BUTTON_SW1) == TRUE) && (Button_IsIdle(BUTTON_SW3) == TRUE))
+        {
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            mainLATENCY_MARK(mainLATENCY_PATH_DRIVER_BUTTON, mainLATENCY_STAGE_WAKE, 0);
+        }
+        else
+        {
+            vTaskDelay(mainBUTTON_POLL_DELAY);
+
+            /* Edges captured meanwhile are processed below, drop their notification */
+            ulTaskNotifyTake(pdTRUE, 0);
+        }
+
+        ulNow = GPTM_WTimer0Read();
+
+        /* Only this task writes the heating level, so it is read without the mutex */
+        ucHeatingLevel = ucDriverHeatingLevel;
+        while ((xEvent = Button_Process(BUTTON_SW1, ulNow)) != BUTTON_EVENT_NONE)
+        {
+            FAULT_INJECT_BUTTON_EVENT(BUTTON_SW1, ulNow);
+            if (xEvent != BUTTON_EVENT_CLICK)
+            {
+                /* Hold events are not caused by an edge, their input is the poll that detected them */
+                mainLATENCY_START(mainLATENCY_PATH_DRIVER_BUTTON, mainLATENCY_BIT(mainLATENCY_STAGE_DECISION));
+            }
+            ucHeatingLevel = prvNextHeatingLevel(ucHeatingLevel, xEvent);
+        }
+        while ((xEvent = Button_Process(BUTTON_SW3, ulNow)) != BUTTON_EVENT_NONE)
+        {
+            FAULT_INJECT_BUTTON_EVENT(BUTTON_SW3, ulNow);
+            if (xEvent != BUTTON_EVENT_CLICK)
+            {
+                /* Hold events are not caused by an edge, their input is the poll that detected them */
+                mainLATENCY_START(mainLATENCY_PATH_DRIVER_BUTTON, mainLATENCY_BIT(mainLATENCY_STAGE_DECISION));
+            }
+            ucHeatingLevel = prvNextHeatingLevel(ucHeatingLevel, xEvent);
+        }
+
+        if (ucHeatingLevel != ucDriverHeatingLevel)
+        {
+            xSemaphoreTake(xDriverHeatingLevelMutex, portMAX_DELAY);
+            ucDriverHeatingLevel = ucHeatingLevel;
+            xSemaphoreGive(xDriverHeatingLevelMutex);
+
+            /*
+             * Adjust the driver's desired temperature based on the current heating level.
+             * The desired temperature of each level is a seat setting (defaults: off, 25C, 30C, 35C).
+             */
+            xSemaphoreTake(xDriverDesiredTempMutex, portMAX_DELAY);
+
+#if (mainHEATER_EVENT_DRIVEN == 1) || (TRACE_RECORDER == 1)
+            uint8 ucPrevDesiredTemperature = ucDriverDesiredTemperature;
+#endif
+
+            ucDriverDesiredTemperature = SETTINGS_DESIRED_TEMPERATURE(SETTINGS_SEAT_DRIVER, ucDriverHeatingLevel);
+
+#if (TRACE_RECORDER == 1)
+            if (ucDriverDesiredTemperature != ucPrevDesiredTemperature)
+            {
+                TRACE_RECORD(TRACE_EVENT_HEATER_INPUT, SETTINGS_SEAT_DRIVER);
+            }
+#endif
+
+#if (mainHEATER_EVENT_DRIVEN == 1)
+            /* Let the heater task react to the new setpoint immediately */
+            if (ucDriverDesiredTemperature != ucPrevDesiredTemperature)
+            {
+                xTaskNotifyGive(xDriverHeaterProcessHandle);
+            }
+#endif
+
+            xSemaphoreGive(xDriverDesiredTempMutex);
+
+            mainLATENCY_MARK(mainLATENCY_PATH_DRIVER_BUTTON, mainLATENCY_STAGE_DECISION, mainLATENCY_BIT(mainLATENCY_STAGE_ACTUATOR));
+        }
+    }
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+/*
+ * Task function to process the passenger button (SW2).
+ * Same as the driver buttons task: the task blocks until the first edge of a press and polls the
+ * debounce state machine until the button is released and stable again. The debounced events update
+ * the passenger heating level, and the desired temperature setting follows the new heating level.
+ */
+void vPassengerButtonProcessTask(void *pvParameters)
+{
+    Button_EventType xEvent;
+    uint32 ulNow;
+    uint8 ucHeatingLevel;
+
+    for (;;)
+    {
+        /* Sleep while the button is idle, poll while a press is being debounced or held */
+        if (Button_IsIdle(BUTTON_SW2) == TRUE)
+        {
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            mainLATENCY_MARK(mainLATENCY_PATH_PASSENGER_BUTTON, mainLATENCY_STAGE_WAKE, 0);
+        }
+        else
+        {
+            vTaskDelay(mainBUTTON_POLL_DELAY);
+
+            /* Edges captured meanwhile are processed below, drop their notification */
+            ulTaskNotifyTake(pdTRUE, 0);
+        }
+
+        ulNow = GPTM_WTimer0Read();
+
+        /* Only this task writes the heating level, so it is read without the mutex */
+        ucHeatingLevel = ucPassengerHeatingLevel;
+        while ((xEvent = Button_Process(BUTTON_SW2, ulNow)) != BUTTON_EVENT_NONE)
+        {
+            FAULT_INJECT_BUTTON_EVENT(BUTTON_SW2, ulNow);
+            if (xEvent != BUTTON_EVENT_CLICK)
+            {
+                /* Hold events are not caused by an edge, their input is the poll that detected them */
+                mainLATENCY_START(mainLATENCY_PATH_PASSENGER_BUTTON, mainLATENCY_BIT(mainLATENCY_STAGE_DECISION));
+            }
+            ucHeatingLevel = prvNextHeatingLevel(ucHeatingLevel, xEvent);
+        }
+
+        if (ucHeatingLevel != ucPassengerHeatingLevel)
+        {
+            xSemaphoreTake(xPassengerHeatingLevelMutex, portMAX_DELAY);
+            ucPassengerHeatingLevel = ucHeatingLevel;
+            xSemaphoreGive(xPassengerHeatingLevelMutex);
+
+            /*
+             * Adjust the passenger's desired temperature based on the current heating level.
+             * Similar to the driver, the passenger's desired temperature is the seat setting of the heating level.
+             */
+            xSemaphoreTake(xPassengerDesiredTempMutex, portMAX_DELAY);
+
+#if (mainHEATER_EVENT_DRIVEN == 1) || (TRACE_RECORDER == 1)
+            uint8 ucPrevDesiredTemperature = ucPassengerDesiredTemperature;
+#endif
+
+            ucPassengerDesiredTemperature = SETTINGS_DESIRED_TEMPERATURE(SETTINGS_SEAT_PASSENGER, ucPassengerHeatingLevel);
+
+#if (TRACE_RECORDER == 1)
+            if (ucPassengerDesiredTemperature != ucPrevDesiredTemperature)
+            {
+                TRACE_RECORD(TRACE_EVENT_HEATER_INPUT, SETTINGS_SEAT_PASSENGER);
+            }
+#endif
+
+#if (mainHEATER_EVENT_DRIVEN == 1)
+            /* Let the heater task react to the new setpoint immediately */
+            if (ucPassengerDesiredTemperature != ucPrevDesiredTemperature)
+            {
+                xTaskNotifyGive(xPassengerHeaterProcessHandle);
+            }
+#endif
+
+            xSemaphoreGive(xPassengerDesiredTempMutex);
+
+            mainLATENCY_MARK(mainLATENCY_PATH_PASSENGER_BUTTON, mainLATENCY_STAGE_DECISION, mainLATENCY_BIT(mainLATENCY_STAGE_ACTUATOR));
+        }
+    }
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+/*
+ * Optimized Task function to periodically control and passenger heating systems.
+ * This task manages the heater's intensity based on the difference between the current and desired temperatures.
+ * The heating intensity is simulated using LEDs.
+ * - Low intensity: Green LED
+ * - Medium intensity: Blue LED
+ * - High intensity: Both Green and Blue LEDs (Cyan)
+ * If the current temperature exceeds the desired temperature, the heater is disabled.
+ */
+void vDriverHeaterProcessTask(void *pvParameters)
+{
+#if (mainHEATER_EVENT_DRIVEN == 0)
+    /* Get the current tick count to set up a periodic delay for the task */
+    TickType_t xDriverHeaterLastWakeTime = xTaskGetTickCount();
+#endif
+
+#if (mainHEATER_PWM == 1)
+    /* Previous duty cycle, so the duty register is only written when it changes */
+    uint8 ucPrevDriverHeaterDuty = 0xFF;
+    uint8 ucDriverHeaterDuty;
+#else
+    /* Variables to track the previous heater states for driver
+     * This helps to avoid unnecessary updates to the LEDs if the state doesn't change
+     */
+    uint8 ucPrevDriverHeaterState = 0xFF;
+    uint8 ucDriverHeaterOutput;
+#endif
+
+    for (;;)
+    {
+        mainLATENCY_MARK(mainLATENCY_PATH_DRIVER_SENSOR, mainLATENCY_STAGE_WAKE, 0);
+
+        /* ------------- Process Driver Heating ------------- */
+        xSemaphoreTake(xDriverDesiredTempMutex, portMAX_DELAY);
+        xSemaphoreTake(xDriverHeaterStateMutex, portMAX_DELAY);
+        xSemaphoreTake(xDriverHeatingLevelMutex, portMAX_DELAY);
+        xSemaphoreTake(xDriverTempValueMutex, portMAX_DELAY);
+
+        /* Heater state from the heating level and the temperature difference */
+        ucDriverHeaterState = prvHeaterState(SETTINGS_SEAT_DRIVER, ucDriverHeatingLevel, ucDriverErrorFlag, ucDriverDesiredTemperature, ucDriverTemperatureValue,
+                                             ucDriverHeaterState);
+
+#if (mainHEATER_PWM == 1)
+#if (mainHEATER_PID == 1)
+        ucDriverHeaterDuty = prvHeaterPidDutyCycle(SETTINGS_SEAT_DRIVER, &xDriverHeaterPid, &xDriverHeaterPidTune, ucDriverHeatingLevel, ucDriverErrorFlag,
+                                                  ucDriverDesiredTemperature, ucDriverTemperatureValue);
+#else
+        ucDriverHeaterDuty = prvHeaterDutyCycle(SETTINGS_SEAT_DRIVER, ucDriverHeatingLevel, ucDriverErrorFlag, ucDriverDesiredTemperature,
+                                                ucDriverTemperatureValue, ucDriverHeaterState);
+#endif
+
+#if (mainPOWER_BUDGET == 1)
+        /* Drive only the power granted to the seat */
+        ucDriverHeaterDuty = prvHeaterBudgetDuty(SETTINGS_SEAT_DRIVER, ucDriverHeaterDuty);
+#endif
+
+        /* Write the driver's heater duty register only if the duty cycle has changed */
+        if (ucPrevDriverHeaterDuty != ucDriverHeaterDuty)
+        {
+            ucPrevDriverHeaterDuty = ucDriverHeaterDuty;
+            prvHeaterSetDuty(SETTINGS_SEAT_DRIVER, ucDriverHeaterDuty);
+            TRACE_RECORD(TRACE_EVENT_HEATER_OUTPUT, SETTINGS_SEAT_DRIVER);
+
+            mainLATENCY_MARK(mainLATENCY_PATH_DRIVER_SENSOR, mainLATENCY_STAGE_ACTUATOR, 0);
+            mainLATENCY_MARK(mainLATENCY_PATH_DRIVER_BUTTON, mainLATENCY_STAGE_ACTUATOR, 0);
+        }
+#else
+#if (mainPOWER_BUDGET == 1)
+        /* Show the highest heater state within the power granted to the seat */
+        ucDriverHeaterOutput = prvHeaterBudgetState(SETTINGS_SEAT_DRIVER, ucDriverHeaterState);
+#else
+        ucDriverHeaterOutput = ucDriverHeaterState;
+#endif
+
+        /* Update the driver's heater LEDs only if the heater output has changed */
+        if ((ucPrevDriverHeaterState != ucDriverHeaterOutput) || (ucDriverErrorFlag == pdTRUE))
+        {
+            /* Store the new state to prevent redundant updates */
+            ucPrevDriverHeaterState = ucDriverHeaterOutput;
+
+            /* Set both heater LEDs of the seat in one masked store */
+            mainDRIVER_HEATER_LEDS_REG = ucDriverHeaterLeds[ucDriverHeaterOutput];
+            TRACE_RECORD(TRACE_EVENT_HEATER_OUTPUT, SETTINGS_SEAT_DRIVER);
+
+            mainLATENCY_MARK(mainLATENCY_PATH_DRIVER_SENSOR, mainLATENCY_STAGE_ACTUATOR, 0);
+            mainLATENCY_MARK(mainLATENCY_PATH_DRIVER_BUTTON, mainLATENCY_STAGE_ACTUATOR, 0);
+        }
+#endif
+
+        /* An input that did not change the heater LEDs has no actuator latency */
+        mainLATENCY_DISARM(mainLATENCY_PATH_DRIVER_SENSOR, mainLATENCY_BIT(mainLATENCY_STAGE_ACTUATOR));
+        mainLATENCY_DISARM(mainLATENCY_PATH_DRIVER_BUTTON, mainLATENCY_BIT(mainLATENCY_STAGE_ACTUATOR));
+
+        xSemaphoreGive(xDriverTempValueMutex);
+        xSemaphoreGive(xDriverHeatingLevelMutex);
+        xSemaphoreGive(xDriverHeaterStateMutex);
+        xSemaphoreGive(xDriverDesiredTempMutex);
+
+#if (mainHEATER_EVENT_DRIVEN == 1)
+        /* Sleep until the sensor or button task reports a change, or refresh after the watchdog period */
+        ulTaskNotifyTake(pdTRUE, mainHEATER_WATCHDOG_DELAY);
+#else
+        /* Delay the task for a period of 250ms to achieve periodic execution */
+        mainJOB_END(mainJOB_DRIVER_HEATER);
+        vTaskDelayUntil(&xDriverHeaterLastWakeTime, mainHEATER_TASK_DELAY);
+        mainJOB_START(mainJOB_DRIVER_HEATER, xDriverHeaterLastWakeTime);
+#endif
+    }
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+/*
+ * Optimized Task function to periodically control passenger heating systems.
+ * This task manages the heater's intensity based on the difference between the current and desired temperatures.
+ * The heating intensity is simulated using LEDs.
+ * - Low intensity: Green LED
+ * - Medium intensity: Blue LED
+ * - High intensity: Both Green and Blue LEDs (Cyan)
+ * If the current temperature exceeds the desired temperature, the heater is disabled.
+ */
+void vPassengerHeatersProcessTask(void *pvParameters)
+{
+#if (mainHEATER_EVENT_DRIVEN == 0)
+    /* Get the current tick count to set up a periodic delay for the task */
+    TickType_t xPassengerHeaterLastWakeTime = xTaskGetTickCount();
+#endif
+
+#if (mainHEATER_PWM == 1)
+    /* Previous duty cycle, so the duty register is only written when it changes */
+    uint8 ucPrevPassengerHeaterDuty = 0xFF;
+    uint8 ucPassengerHeaterDuty;
+#else
+    /* Variables to track the previous heater states for passenger
+     * This helps to avoid unnecessary updates to the LEDs if the state doesn't change
+     */
+    uint8 ucPrevPassengerHeaterState = 0xFF;
+    uint8 ucPassengerHeaterOutput;
+#endif
+
+    for (;;)
+    {
+        mainLATENCY_MARK(mainLATENCY_PATH_PASSENGER_SENSOR, mainLATENCY_STAGE_WAKE, 0);
+
+        /* ------------- Process Passenger Heating ------------- */
+        xSemaphoreTake(xPassengerDesiredTempMutex, portMAX_DELAY);
+        xSemaphoreTake(xPassengerHeaterStateMutex, portMAX_DELAY);
+        xSemaphoreTake(xPassengerHeatingLevelMutex, portMAX_DELAY);
+        xSemaphoreTake(xPassengerTempValueMutex, portMAX_DELAY);
+        /* Heater state from the heating level and the temperature difference */
+        ucPassengerHeaterState = prvHeaterState(SETTINGS_SEAT_PASSENGER, ucPassengerHeatingLevel, ucPassengerErrorFlag, ucPassengerDesiredTemperature,
+                                                ucPassengerTemperatureValue, ucPassengerHeaterState);
+
+#if (mainHEATER_PWM == 1)
+#if (mainHEATER_PID == 1)
+        ucPassengerHeaterDuty = prvHeaterPidDutyCycle(SETTINGS_SEAT_PASSENGER, &xPassengerHeaterPid, &xPassengerHeaterPidTune, ucPassengerHeatingLevel, ucPassengerErrorFlag,
+                                                     ucPassengerDesiredTemperature, ucPassengerTemperatureValue);
+#else
+        ucPassengerHeaterDuty = prvHeaterDutyCycle(SETTINGS_SEAT_PASSENGER, ucPassengerHeatingLevel, ucPassengerErrorFlag, ucPassengerDesiredTemperature,
+                                                   ucPassengerTemperatureValue, ucPassengerHeaterState);
+#endif
+
+#if (mainPOWER_BUDGET == 1)
+        /* Drive only the power granted to the seat */
+        ucPassengerHeaterDuty = prvHeaterBudgetDuty(SETTINGS_SEAT_PASSENGER, ucPassengerHeaterDuty);
+#endif
+
+        /* Write the passenger's heater duty register only if the duty cycle has changed */
+        if (ucPrevPassengerHeaterDuty != ucPassengerHeaterDuty)
+        {
+            ucPrevPassengerHeaterDuty = ucPassengerHeaterDuty;
+            prvHeaterSetDuty(SETTINGS_SEAT_PASSENGER, ucPassengerHeaterDuty);
+            TRACE_RECORD(TRACE_EVENT_HEATER_OUTPUT, SETTINGS_SEAT_PASSENGER);
+
+            mainLATENCY_MARK(mainLATENCY_PATH_PASSENGER_SENSOR, mainLATENCY_STAGE_ACTUATOR, 0);
+            mainLATENCY_MARK(mainLATENCY_PATH_PASSENGER_BUTTON, mainLATENCY_STAGE_ACTUATOR, 0);
+        }
+#else
+#if (mainPOWER_BUDGET == 1)
+        /* Show the highest heater state within the power granted to the seat */
+        ucPassengerHeaterOutput = prvHeaterBudgetState(SETTINGS_SEAT_PASSENGER, ucPassengerHeaterState);
+#else
+        ucPassengerHeaterOutput = ucPassengerHeaterState;
+#endif
+
+        /* Update the passenger's heater LEDs only if the heater output has changed */
+        if ((ucPrevPassengerHeaterState != ucPassengerHeaterOutput) || (ucPassengerErrorFlag == pdTRUE))
+        {
+            /* Store the new state to prevent redundant updates */
+            ucPrevPassengerHeaterState = ucPassengerHeaterOutput;
+
+            /* Set both heater LEDs of the seat in one masked store */
+            mainPASSENGER_HEATER_LEDS_REG = ucPassengerHeaterLeds[ucPassengerHeaterOutput];
+            TRACE_RECORD(TRACE_EVENT_HEATER_OUTPUT, SETTINGS_SEAT_PASSENGER);
+
+            mainLATENCY_MARK(mainLATENCY_PATH_PASSENGER_SENSOR, mainLATENCY_STAGE_ACTUATOR, 0);
+            mainLATENCY_MARK(mainLATENCY_PATH_PASSENGER_BUTTON, mainLATENCY_STAGE_ACTUATOR, 0);
+        }
+#endif
+
+        /* An input that did not change the heater LEDs has no actuator latency */
+        mainLATENCY_DISARM(mainLATENCY_PATH_PASSENGER_SENSOR, mainLATENCY_BIT(mainLATENCY_STAGE_ACTUATOR));
+        mainLATENCY_DISARM(mainLATENCY_PATH_PASSENGER_BUTTON, mainLATENCY_BIT(mainLATENCY_STAGE_ACTUATOR));
+
+        xSemaphoreGive(xPassengerTempValueMutex);
+        xSemaphoreGive(xPassengerHeatingLevelMutex);
+        xSemaphoreGive(xPassengerHeaterStateMutex);
+        xSemaphoreGive(xPassengerDesiredTempMutex);
+
+#if (mainHEATER_EVENT_DRIVEN == 1)
+        /* Sleep until the sensor or button task reports a change, or refresh after the watchdog period */
+        ulTaskNotifyTake(pdTRUE, mainHEATER_WATCHDOG_DELAY);
+#else
+        /* Delay the task for a period of 250ms to achieve periodic execution */
+        mainJOB_END(mainJOB_PASSENGER_HEATER);
+        vTaskDelayUntil(&xPassengerHeaterLastWakeTime, mainHEATER_TASK_DELAY);
+        mainJOB_START(mainJOB_PASSENGER_HEATER, xPassengerHeaterLastWakeTime);
+#endif
+    }
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+/*
+ * Task function to handle error reporting for driver temperature sensors.
+ * This task monitors error conditions based on semaphores signaling temperature faults.
+ * - When an error is detected for the driver, it disables the driver's heater and turns on a red LED.
+ */
+void vDriverDiagnosticTask(void *pvParameters)
+{
+    xFailureLog xlog; /* Structure to hold diagnostic information */
+    uint8 ucHeaterState; /* Heater state before the failure, for the freeze frame */
+    uint8 ucTemperature;
+
+    for (;;)
+    {
+        /*
+         * Block indefinitely until the xDriverErrorReportSemaphore is given by another task,
+         * which signals that the driver's temperature sensor has detected a fault (i.e., temperature
+         * outside of the acceptable range defined in the system).
+         */
+        xSemaphoreTake(xDriverErrorReportSemaphore, portMAX_DELAY);
+
+        /*
+         * Upon receiving the semaphore, immediately disable the driver's heater to ensure
+         * that the heating element does not remain active under potentially hazardous conditions.
+         * This ensures the safety of the system in case of temperature sensor faults.
+         */
+        xSemaphoreTake(xDriverHeaterStateMutex, portMAX_DELAY);
+
+        ucHeaterState = ucDriverHeaterState;
+        ucDriverHeaterState = mainHEATER_STATE_OFF;
+
+        xSemaphoreGive(xDriverHeaterStateMutex);
+
+        /*
+         * Retrieve diagnostic data from the xDriverDiagnosticQueue to log details about the error.
+         * The queue contains information about the seat where the failure occurred, a failure code,
+         * a timestamp of the error event, and the heating level at the time of the failure.
+         */
+        if (xQueueReceive(xDriverDiagnosticQueue, &xlog, portMAX_DELAY))
+        {
+            xSemaphoreTake(xDriverTempValueMutex, portMAX_DELAY);
+            ucTemperature = ucDriverTemperatureValue;
+            xSemaphoreGive(xDriverTempValueMutex);
+
+            /* Update the trouble code, and log the failure if it is a new one */
+            prvDtcReportFailed(SETTINGS_SEAT_DRIVER, &xlog, ucTemperature, ucHeaterState);
+        }
+
+        /*
+         * Turn on the driver's red LED to indicate that an error has occurred in the temperature control system.
+         * This visual indication warns the driver that their heater is no longer active due to a sensor fault,
+         * alerting them to the issue so it can be addressed.
+         */
+        Led_RED1_SetOn();
+    }
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+/*
+ * Task function to handle error reporting for passenger temperature sensors.
+ * This task monitors error conditions based on semaphores signaling temperature faults.
+ * - When an error is detected for the passenger, it disables the passenger's heater and turns on a separate red LED.
+ */
+void vPassengerDiagnosticTask(void *pvParameters)
+{
+    xFailureLog xlog; /* Structure to store diagnostic information */
+    BaseType_t xReceived;
+    uint8 ucHeaterState; /* Heater state before the failure, for the freeze frame */
+    uint8 ucTemperature;
+
+    for (;;)
+    {
+        /*
+         * Wait indefinitely (blocking) for the xPassengerErrorReportSemaphore to become available.
+         * This semaphore is given by another task when the passenger's temperature sensor detects a fault
+         * (e.g., temperature outside the valid range). The task will not proceed until this event occurs.
+         */
+        xSemaphoreTake(xPassengerErrorReportSemaphore, portMAX_DELAY);
+
+        /*
+         * Once the semaphore is taken, the system reads diagnostic data from the xPassengerDiagnosticQueue.
+         * The queue contains information like the type of failure (seat and code), the timestamp,
+         * and the last heater level before the fault occurred.
+         */
+        xReceived = xQueueReceive(xPassengerDiagnosticQueue, &xlog, portMAX_DELAY);
+
+        /*
+         * Disable the passenger's heater to ensure that no heating continues while the system is
+         * in an error state, preventing any potential safety risks.
+         */
+        xSemaphoreTake(xPassengerHeaterStateMutex, portMAX_DELAY);
+
+        ucHeaterState = ucPassengerHeaterState;
+        ucPassengerHeaterState = mainHEATER_STATE_OFF;
+
+        xSemaphoreGive(xPassengerHeaterStateMutex);
+
+        if (xReceived)
+        {
+            xSemaphoreTake(xPassengerTempValueMutex, portMAX_DELAY);
+            ucTemperature = ucPassengerTemperatureValue;
+            xSemaphoreGive(xPassengerTempValueMutex);
+
+            /* Update the trouble code, and log the failure if it is a new one */
+            prvDtcReportFailed(SETTINGS_SEAT_PASSENGER, &xlog, ucTemperature, ucHeaterState);
+        }
+        /*
+         * Turn on the red LED to indicate a fault in the passenger's heating system. This visual
+         * notification signals that the passenger heating is deactivated due to an error,
+         * prompting the user to check or fix the issue.
+         */
+        Led_RED2_SetOn();
+    }
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+/*
+ * Reports a sensor failure of a seat to its trouble code, with a freeze frame of the conditions, and
+ * stores the failure in the diagnostic log for future reference and analysis only when the trouble code
+ * is new: a flapping sensor then counts its occurrences in one record instead of overwriting the log.
+ * The other diagnostic task appends to the same log, the log itself handles that without a lock, and
+ * overwrites the oldest failure once it is full.
+ */
+static void prvDtcReportFailed(uint8 ucSeat, const xFailureLog *pxLog, uint8 ucTemperature, uint8 ucHeaterState)
+{
+    Dtc_FreezeFrameType xFreezeFrame;
+    uint8 ucCode = (pxLog->ucFailureCode == mainTEMP_OVER_RANGE_FAIL) ? DTC_CODE_OVER_RANGE : DTC_CODE_UNDER_RANGE;
+    boolean bNew;
+
+    xFreezeFrame.ucTemperature = ucTemperature;
+    xFreezeFrame.ucHeatingLevel = pxLog->ucHeatingLevel;
+    xFreezeFrame.ucHeaterState = ucHeaterState;
+    xFreezeFrame.ucCpuLoad = ucCpuLoad;
+
+    /* Both diagnostic tasks, the sensor processing and the fault store task update the trouble codes, O(1) */
+    taskENTER_CRITICAL();
+    bNew = Dtc_ReportFailed(ucSeat, ucCode, pxLog->ulTimeStamp, &xFreezeFrame);
+    taskEXIT_CRITICAL();
+
+    if (bNew == TRUE)
+    {
+        DiagLog_Append(&xDiagnosticLog, pxLog);
+    }
+}
+
+/* The reading of a seat is back in the valid range, both of its trouble codes start aging */
+static void prvDtcReportPassed(uint8 ucSeat)
+{
+    taskENTER_CRITICAL();
+    Dtc_ReportPassed(ucSeat, DTC_CODE_OVER_RANGE);
+    Dtc_ReportPassed(ucSeat, DTC_CODE_UNDER_RANGE);
+    taskEXIT_CRITICAL();
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+/*
+ * Task function to periodically update and display system status on the UART screen.
+ * The displayed information includes desired and current temperatures for both driver and passenger,
+ * as well as the current state of the heater (Off, Low, Medium, High).
+ * This task uses a mutex (xDisplayScreenMutex) to ensure exclusive access to the UART for sending data.
+ */
+void vDisplayScreenTask(void *pvParameters)
+{
+    TickType_t xDisplayLastWakeTime = xTaskGetTickCount(); /* Initialize for periodic delay */
+    uint8 ucPrevDriverHeaterState = 0xFF, ucPrevPassengerHeaterState = 0xFF;
+    uint8 ucPrevDriverTemp = 0xFF, ucPrevPassengerTemp = 0xFF;
+    uint8 ucPrevDriverHeatingLevel = 0xFF, ucPrevPassengerHeatingLevel = 0xFF;
+
+    for (;;)
+    {
+        /* Check if any data has changed before sending updates */
+        if ((ucDriverHeatingLevel != ucPrevDriverHeatingLevel) || (ucDriverTemperatureValue != ucPrevDriverTemp) || (ucDriverHeaterState != ucPrevDriverHeaterState)
+                || (ucPassengerHeatingLevel != ucPrevPassengerHeatingLevel) || (ucPassengerTemperatureValue != ucPrevPassengerTemp) || (ucPassengerHeaterState != ucPrevPassengerHeaterState))
+        {
+            /* Attempt to take the mutex for screen display to ensure exclusive access to the UART. */
+            xSemaphoreTake(xDisplayScreenMutex, portMAX_DELAY);
+
+            /* Display the header line for separating display updates. */
+            UART0_SendString("------------------------------------------------------------\r\n");
+
+            /* Display the driver's current temperature. */
+            UART0_SendString("Driver Current Temperature: ");
+            UART0_SendInteger(ucDriverTemperatureValue); /* Send the temperature value. */
+            UART0_SendString("C\r\n");
+
+            /* Display the driver's heating level. */
+            UART0_SendString("Driver Heating Level: ");
+            switch (ucDriverHeatingLevel)
+            {
+            case mainHEATING_LEVEL_OFF:
+                UART0_SendString("Off");
+                break;
+            case mainHEATING_LEVEL_LOW:
+                UART0_SendString("Low");
+                break;
+            case mainHEATING_LEVEL_MEDIUM:
+                UART0_SendString("Medium");
+                break;
+            case mainHEATING_LEVEL_HIGH:
+                UART0_SendString("High");
+                break;
+            } /* Send the heating level. */
+            UART0_SendString("\r\n");
+
+            /* Display the driver's heater state. */
+            UART0_SendString("Driver Heater State: ");
+            switch (ucDriverHeaterState)
+            {
+            case mainHEATER_STATE_OFF: /* Heater is off */
+                UART0_SendString("Off");
+                break;
+            case mainHEATER_STATE_LOW: /* Heater is set to low intensity */
+                UART0_SendString("Low");
+                break;
+            case mainHEATER_STATE_MEDIUM: /* Heater is set to medium intensity */
+                UART0_SendString("Medium");
+                break;
+            case mainHEATER_STATE_HIGH: /* Heater is set to high intensity */
+                UART0_SendString("High");
+                break;
+            }
+
+            UART0_SendString("\r\n\r\n"); /* Double newline to separate driver and passenger sections */
+
+            /* Display the passenger's current temperature. */
+            UART0_SendString("Passenger Current Temperature: ");
+            UART0_SendInteger(ucPassengerTemperatureValue); /* Send the temperature value. */
+            UART0_SendString("C\r\n");
+
+            /* Display the passenger's heating level. */
+            UART0_SendString("Passenger Heating Level: ");
+            switch (ucPassengerHeatingLevel)
+            {
+            case mainHEATING_LEVEL_OFF:
+                UART0_SendString("Off");
+                break;
+            case mainHEATING_LEVEL_LOW:
+                UART0_SendString("Low");
+                break;
+            case mainHEATING_LEVEL_MEDIUM:
+                UART0_SendString("Medium");
+                break;
+            case mainHEATING_LEVEL_HIGH:
+                UART0_SendString("High");
+                break;
+            } /* Send the heating level. */
+            UART0_SendString("\r\n");
+
+            /* Display the passenger's heater state. */
+            UART0_SendString("Passenger Heater State: ");
+            switch (ucPassengerHeaterState)
+            {
+            case mainHEATER_STATE_OFF: /* Heater is off */
+                UART0_SendString("Off");
+                break;
+            case mainHEATER_STATE_LOW: /* Heater is set to low intensity */
+                UART0_SendString("Low");
+                break;
+            case mainHEATER_STATE_MEDIUM: /* Heater is set to medium intensity */
+                UART0_SendString("Medium");
+                break;
+            case mainHEATER_STATE_HIGH: /* Heater is set to high intensity */
+                UART0_SendString("High");
+                break;
+            }
+            UART0_SendString("\r\n"); /* End of the display update */
+
+            /* Release the mutex to allow other tasks to access the UART. */
+            xSemaphoreGive(xDisplayScreenMutex);
+
+            /* Save current states to detect future changes */
+            ucPrevDriverHeatingLevel = ucDriverHeatingLevel;
+            ucPrevDriverTemp = ucDriverTemperatureValue;
+            ucPrevDriverHeaterState = ucDriverHeaterState;
+            ucPrevPassengerHeatingLevel = ucPassengerHeatingLevel;
+            ucPrevPassengerTemp = ucPassengerTemperatureValue;
+            ucPrevPassengerHeaterState = ucPassengerHeaterState;
+        }
+
+        /* Delay for 500ms before checking for updates again */
+        mainJOB_END(mainJOB_DISPLAY);
+        vTaskDelayUntil(&xDisplayLastWakeTime, mainDISPLAY_TASK_DELAY);
+        mainJOB_START(mainJOB_DISPLAY, xDisplayLastWakeTime);
+    }
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+/*
+ * Task function to measure and report CPU load in real-time.
+ * The task calculates the CPU load by comparing the time spent in the idle task to the total
+ * runtime of the system, both 64 bit cycle counts of the kernel run time statistics, and
+ * periodically reports the result via UART.
+ * This task runs indefinitely with a delay between each measurement.
+ */
+void vRunTimeMeasurementsTask(void *pvParameters)
+{
+    TickType_t xRunTimeLastWakeTime = xTaskGetTickCount(); /* Capture the current tick count for accurate periodic delay. */
+
+    for (;;)
+    {
+        uint64 ullTotalTime; /* Cycles since the scheduler started */
+        uint64 ullIdleTime; /* Cycles spent in the idle task */
+
+        /* Delay to maintain consistent runtime measurements. */
+        mainJOB_END(mainJOB_RUNTIME);
+        vTaskDelayUntil(&xRunTimeLastWakeTime, mainRUNTIME_TASK_DELAY);
+        mainJOB_START(mainJOB_RUNTIME, xRunTimeLastWakeTime);
+
+        /* Attempt to take the mutex for screen display to ensure exclusive access to the UART. */
+        xSemaphoreTake(xDisplayScreenMutex, portMAX_DELAY);
+
+        /* Display the header line for separating display updates. */
+        UART0_SendString("------------------------------------------------------------\r\n");
+
+        /*
+         * Calculate CPU load as the percentage of the system's total elapsed time since startup
+         * not spent in the idle task. The idle counter is up to date, as this task is running.
+         */
+        ullTotalTime = portGET_RUN_TIME_COUNTER_VALUE();
+        ullIdleTime = ulTaskGetIdleRunTimeCounter();
+        uint8 ucCPU_Load = (uint8) (((ullTotalTime - ullIdleTime) * 100U) / ullTotalTime);
+        ucCpuLoad = ucCPU_Load;
+
+        UART0_SendString("\r\nCPU Load is ");
+        UART0_SendInteger(ucCPU_Load);
+        UART0_SendString("% \r\n");
+
+#if (CPU_LOAD_MONITOR == 1)
+        /* Report the recent load, the load since startup above hardly moves after a few minutes */
+        prvCpuLoadReportSend();
+#endif
+
+#if (mainRUNTIME_PROFILING == 1)
+        /* Report the run time of every task */
+        prvRunTimeReportSend(ullTotalTime);
+#endif
+
+#if (mainSTACK_PROFILING == 1)
+        /* Report the stack high water mark of every task */
+        prvStackReportSend();
+#endif
+
+#if (mainLATENCY_PROFILING == 1)
+        /* Report the input to actuator latencies */
+        prvLatencyReportSend();
+#endif
+
+#if (mainDEADLINE_MONITOR == 1)
+        /* Report the deadline misses and the release jitter of the periodic jobs */
+        prvDeadlineReportSend();
+#endif
+
+#if (LOCK_PROFILER == 1)
+        /* Report the waits and holds of every mutex */
+        prvLockReportSend();
+#endif
+
+#if (mainPOWER_BUDGET == 1)
+        /* Report the requested and granted heater power of every seat */
+        prvPowerReportSend();
+#endif
+
+#if (mainHEATER_PID == 1)
+        /* Report the cycles of the heater controller updates */
+        prvPidReportSend();
+#endif
+
+        /* Release the mutex to allow other tasks to access the UART. */
+        xSemaphoreGive(xDisplayScreenMutex);
+    }
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+/*
+ * Task function of the settings console.
+ * The UART0 receive ISR queues the received characters, the task collects them into a line and runs
+ * the command at the end of the line (see mainCONSOLE_LINE_SIZE). Characters beyond the line size
+ * are dropped. The reply is sent with the display mutex taken, so it does not mix with the display
+ * and run time reports.
+ */
+void vConsoleTask(void *pvParameters)
+{
+    char cLine[mainCONSOLE_LINE_SIZE];
+    uint8 ucLength = 0;
+    uint8 ucByte;
+    Std_ReturnType xStatus;
+
+    for (;;)
+    {
+        xQueueReceive(xConsoleRxQueue, &ucByte, portMAX_DELAY);
+
+        if ((ucByte != '\r') && (ucByte != '\n'))
+        {
+            if (ucLength < (mainCONSOLE_LINE_SIZE - 1))
+            {
+                cLine[ucLength++] = (char) ucByte;
+            }
+        }
+        else if (ucLength > 0)
+        {
+            cLine[ucLength] = '\0';
+            ucLength = 0;
+
+            if (strcmp(cLine, "faults") == 0)
+            {
+                prvConsoleFaults();
+                continue;
+            }
+            if (strcmp(cLine, "dtc") == 0)
+            {
+                prvConsoleDtc();
+                continue;
+            }
+            if (strcmp(cLine, "export") == 0)
+            {
+                prvConsoleExport();
+                continue;
+            }
+            if ((strncmp(cLine, "query ", 6) == 0) || (strncmp(cLine, "count ", 6) == 0))
+            {
+                prvConsoleQuery(cLine);
+                continue;
+            }
+            if (strcmp(cLine, "summary") == 0)
+            {
+                prvConsoleSummary();
+                continue;
+            }
+#if (mainDEADLINE_MONITOR == 1)
+            if (strcmp(cLine, "deadlines") == 0)
+            {
+                xSemaphoreTake(xDisplayScreenMutex, portMAX_DELAY);
+                prvDeadlineReportSend();
+                UART0_SendString("DEADLINE,END\r\n");
+                xSemaphoreGive(xDisplayScreenMutex);
+                continue;
+            }
+#endif
+#if (CPU_LOAD_MONITOR == 1)
+            if (strcmp(cLine, "load") == 0)
+            {
+                xSemaphoreTake(xDisplayScreenMutex, portMAX_DELAY);
+                prvCpuLoadReportSend();
+                xSemaphoreGive(xDisplayScreenMutex);
+                continue;
+            }
+#endif
+#if (LOCK_PROFILER == 1)
+            if ((strcmp(cLine, "locks") == 0) || (strcmp(cLine, "locks clear") == 0))
+            {
+                xSemaphoreTake(xDisplayScreenMutex, portMAX_DELAY);
+                prvLockReportSend();
+                UART0_SendString("LOCK,END\r\n");
+                xSemaphoreGive(xDisplayScreenMutex);
+                if (cLine[5] != '\0')
+                {
+                    LockProfile_Clear();
+                }
+                continue;
+            }
+#endif
+#if (FAULT_INJECTION == 1)
+            if (strncmp(cLine, "inject ", 7) == 0)
+            {
+                prvConsoleInject(cLine);
+                continue;
+            }
+#endif
+#if (TRACE_RECORDER == 1)
+            if (strncmp(cLine, "trace ", 6) == 0)
+            {
+                prvConsoleTrace(cLine);
+                continue;
+            }
+#endif
+
+            xStatus = prvConsoleCommand(cLine);
+
+            xSemaphoreTake(xDisplayScreenMutex, portMAX_DELAY);
+            prvConsoleReport(xStatus);
+            xSemaphoreGive(xDisplayScreenMutex);
+        }
+    }
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+/* Returns the next space separated token of a console line, an empty string at the end of the line */
+static char *prvConsoleToken(char **ppcCursor)
+{
+    char *pcToken;
+
+    while (**ppcCursor == ' ')
+    {
+        (*ppcCursor)++;
+    }
+    pcToken = *ppcCursor;
+    while ((**ppcCursor != ' ') && (**ppcCursor != '\0'))
+    {
+        (*ppcCursor)++;
+    }
+    if (**ppcCursor == ' ')
+    {
+        **ppcCursor = '\0';
+        (*ppcCursor)++;
+    }
+    return pcToken;
+}
+
+/*
+ * Runs a console command line, see mainCONSOLE_LINE_SIZE for the commands.
+ * Returns E_NOT_OK for an unknown command, a value out of range or a failed EEPROM write.
+ */
+static Std_ReturnType prvConsoleCommand(char *pcLine)
+{
+    char *pcCursor = pcLine;
+    char *pcCommand = prvConsoleToken(&pcCursor);
+    char *pcSeat;
+    char *pcField;
+    char *pcValue;
+    uint16 usValue = 0;
+    uint8 ucSeat;
+    uint8 *pucField;
+    Settings_SeatType xSeat;
+
+    if (strcmp(pcCommand, "get") == 0)
+    {
+        return E_OK;
+    }
+
+    if (strcmp(pcCommand, "defaults") == 0)
+    {
+        for (ucSeat = 0; ucSeat < SETTINGS_NUMBER_OF_SEATS; ucSeat++)
+        {
+            prvConsoleApply(ucSeat, &xDefaultSeatSettings);
+        }
+        return prvConsoleSave();
+    }
+
+    if (strcmp(pcCommand, "set") != 0)
+    {
+        return E_NOT_OK;
+    }
+
+    pcSeat = prvConsoleToken(&pcCursor);
+    pcField = prvConsoleToken(&pcCursor);
+    pcValue = prvConsoleToken(&pcCursor);
+
+    if (strcmp(pcSeat, "d") == 0)
+    {
+        ucSeat = SETTINGS_SEAT_DRIVER;
+    }
+    else if (strcmp(pcSeat, "p") == 0)
+    {
+        ucSeat = SETTINGS_SEAT_PASSENGER;
+    }
+    else
+    {
+        return E_NOT_OK;
+    }
+
+    xSeat = Settings_axSeat[ucSeat];
+    if (strcmp(pcField, "low") == 0)
+    {
+        pucField = &xSeat.aucDesiredTemperature[mainHEATING_LEVEL_LOW];
+    }
+    else if (strcmp(pcField, "medium") == 0)
+    {
+        pucField = &xSeat.aucDesiredTemperature[mainHEATING_LEVEL_MEDIUM];
+    }
+    else if (strcmp(pcField, "high") == 0)
+    {
+        pucField = &xSeat.aucDesiredTemperature[mainHEATING_LEVEL_HIGH];
+    }
+    else if (strcmp(pcField, "tlow") == 0)
+    {
+        pucField = &xSeat.aucThreshold[0];
+    }
+    else if (strcmp(pcField, "tmedium") == 0)
+    {
+        pucField = &xSeat.aucThreshold[1];
+    }
+    else if (strcmp(pcField, "thigh") == 0)
+    {
+        pucField = &xSeat.aucThreshold[2];
+    }
+    else if (strcmp(pcField, "hyst") == 0)
+    {
+        pucField = &xSeat.ucHysteresis;
+    }
+    else
+    {
+        return E_NOT_OK;
+    }
+
+    /* Decimal value of at most 3 digits, with nothing after it */
+    if ((*pcValue == '\0') || (strlen(pcValue) > 3) || (*prvConsoleToken(&pcCursor) != '\0'))
+    {
+        return E_NOT_OK;
+    }
+    for (; *pcValue != '\0'; pcValue++)
+    {
+        if ((*pcValue < '0') || (*pcValue > '9'))
+        {
+            return E_NOT_OK;
+        }
+        usValue = (usValue * 10U) + (uint16) (*pcValue - '0');
+    }
+    if (usValue > 0xFFU)
+    {
+        return E_NOT_OK;
+    }
+    *pucField = (uint8) usValue;
+
+    if (prvConsoleApply(ucSeat, &xSeat) != E_OK)
+    {
+        return E_NOT_OK;
+    }
+    return prvConsoleSave();
+}
+
+/* Saves the live settings, the fault store task may be writing the EEPROM. Refused if the EEPROM is not usable */
+static Std_ReturnType prvConsoleSave(void)
+{
+    Std_ReturnType xStatus;
+
+    xSemaphoreTake(xEepromMutex, portMAX_DELAY);
+    xStatus = Settings_Save();
+    xSemaphoreGive(xEepromMutex);
+
+    return xStatus;
+}
+
+/*
+ * Applies new settings to a seat and moves its desired temperature to the new value of its heating level.
+ * The decision tables are rebuilt with the scheduler suspended, so a heater task never reads a half
+ * built table. The desired temperature mutex is taken before the heating level one, in the order of
+ * the heater tasks.
+ */
+static Std_ReturnType prvConsoleApply(uint8 ucSeat, const Settings_SeatType *pxSeat)
+{
+    Std_ReturnType xStatus;
+
+    if (Settings_Validate(pxSeat) != E_OK)
+    {
+        return E_NOT_OK;
+    }
+
+    vTaskSuspendAll();
+    xStatus = Settings_Apply(ucSeat, pxSeat);
+    xTaskResumeAll();
+
+    if (ucSeat == SETTINGS_SEAT_DRIVER)
+    {
+        xSemaphoreTake(xDriverDesiredTempMutex, portMAX_DELAY);
+        xSemaphoreTake(xDriverHeatingLevelMutex, portMAX_DELAY);
+        ucDriverDesiredTemperature = SETTINGS_DESIRED_TEMPERATURE(SETTINGS_SEAT_DRIVER, ucDriverHeatingLevel);
+        xSemaphoreGive(xDriverHeatingLevelMutex);
+        xSemaphoreGive(xDriverDesiredTempMutex);
+#if (mainHEATER_EVENT_DRIVEN == 1)
+        xTaskNotifyGive(xDriverHeaterProcessHandle);
+#endif
+    }
+    else
+    {
+        xSemaphoreTake(xPassengerDesiredTempMutex, portMAX_DELAY);
+        xSemaphoreTake(xPassengerHeatingLevelMutex, portMAX_DELAY);
+        ucPassengerDesiredTemperature = SETTINGS_DESIRED_TEMPERATURE(SETTINGS_SEAT_PASSENGER, ucPassengerHeatingLevel);
+        xSemaphoreGive(xPassengerHeatingLevelMutex);
+        xSemaphoreGive(xPassengerDesiredTempMutex);
+#if (mainHEATER_EVENT_DRIVEN == 1)
+        xTaskNotifyGive(xPassengerHeaterProcessHandle);
+#endif
+    }
+
+    return xStatus;
+}
+
+/* Console reply: one line per seat, "SETTINGS,<seat>,<low>,<medium>,<high>,<tlow>,<tmedium>,<thigh>,<hyst>", or ERROR */
+static void prvConsoleReport(Std_ReturnType xStatus)
+{
+    uint8 ucSeat;
+    uint8 ucIndex;
+
+    if (xStatus != E_OK)
+    {
+        UART0_SendString("ERROR\r\n");
+        return;
+    }
+
+    for (ucSeat = 0; ucSeat < SETTINGS_NUMBER_OF_SEATS; ucSeat++)
+    {
+        UART0_SendString((ucSeat == SETTINGS_SEAT_DRIVER) ? "SETTINGS,driver" : "SETTINGS,passenger");
+        for (ucIndex = mainHEATING_LEVEL_LOW; ucIndex < SETTINGS_NUMBER_OF_LEVELS; ucIndex++)
+        {
+            UART0_SendString(",");
+            UART0_SendInteger(Settings_axSeat[ucSeat].aucDesiredTemperature[ucIndex]);
+        }
+        for (ucIndex = 0; ucIndex < SETTINGS_NUMBER_OF_THRESHOLDS; ucIndex++)
+        {
+            UART0_SendString(",");
+            UART0_SendInteger(Settings_axSeat[ucSeat].aucThreshold[ucIndex]);
+        }
+        UART0_SendString(",");
+        UART0_SendInteger(Settings_axSeat[ucSeat].ucHysteresis);
+        UART0_SendString("\r\n");
+    }
+}
+
+/*
+ * Console "faults" reply. The EEPROM and the UART are taken for one record at a time, so the whole log
+ * (a few seconds at 9600 baud) does not hold off the fault store task and the display for that long.
+ */
+static void prvConsoleFaults(void)
+{
+    DiagLog_RecordType xRecord;
+    Std_ReturnType xStatus;
+    uint16 usCount;
+    uint16 usIndex;
+
+    xSemaphoreTake(xEepromMutex, portMAX_DELAY);
+    usCount = FaultStore_Count();
+    xSemaphoreGive(xEepromMutex);
+
+    xSemaphoreTake(xDisplayScreenMutex, portMAX_DELAY);
+    UART0_SendString("FAULTS,");
+    UART0_SendInteger(usCount);
+    UART0_SendString(",");
+    UART0_SendInteger(ulFaultStoreLost);
+    UART0_SendString("\r\n");
+    xSemaphoreGive(xDisplayScreenMutex);
+
+    for (usIndex = 0; usIndex < usCount; usIndex++)
+    {
+        xSemaphoreTake(xEepromMutex, portMAX_DELAY);
+        xStatus = FaultStore_Read(usIndex, &xRecord);
+        xSemaphoreGive(xEepromMutex);
+
+        /* A record torn by a reset is skipped */
+        if (xStatus != E_OK)
+        {
+            continue;
+        }
+
+        xSemaphoreTake(xDisplayScreenMutex, portMAX_DELAY);
+        prvConsoleFaultLine(&xRecord);
+        xSemaphoreGive(xDisplayScreenMutex);
+    }
+}
+
+/* Sends a record as a "FAULT,<sequence>,<timestamp>,<seat code>,<failure code>,<heating level>" line */
+static void prvConsoleFaultLine(const DiagLog_RecordType *pxRecord)
+{
+    UART0_SendString("FAULT,");
+    UART0_SendInteger(pxRecord->ulSequence);
+    UART0_SendString(",");
+    UART0_SendInteger(pxRecord->xEntry.ulTimeStamp);
+    UART0_SendString(",");
+    UART0_SendInteger(pxRecord->xEntry.ucFailureSeat);
+    UART0_SendString(",");
+    UART0_SendInteger(pxRecord->xEntry.ucFailureCode);
+    UART0_SendString(",");
+    UART0_SendInteger(pxRecord->xEntry.ucHeatingLevel);
+    UART0_SendString("\r\n");
+}
+
+/* Console "dtc" reply, each record is copied in a critical section then sent */
+static void prvConsoleDtc(void)
+{
+    Dtc_RecordType xRecord;
+    Std_ReturnType xStatus;
+    uint8 ucSeat;
+    uint8 ucCode;
+
+    xSemaphoreTake(xDisplayScreenMutex, portMAX_DELAY);
+    for (ucSeat = 0; ucSeat < DTC_NUMBER_OF_SEATS; ucSeat++)
+    {
+        for (ucCode = 0; ucCode < DTC_NUMBER_OF_CODES; ucCode++)
+        {
+            taskENTER_CRITICAL();
+            xStatus = Dtc_Read(ucSeat, ucCode, &xRecord);
+            taskEXIT_CRITICAL();
+
+            if (xStatus != E_OK)
+            {
+                continue;
+            }
+
+            UART0_SendString("DTC,");
+            UART0_SendInteger(ucSeat);
+            UART0_SendString(",");
+            UART0_SendInteger(ucCode);
+            UART0_SendString(",");
+            UART0_SendInteger(xRecord.ucStatus);
+            UART0_SendString(",");
+            UART0_SendInteger(xRecord.usOccurrences);
+            UART0_SendString(",");
+            UART0_SendInteger(xRecord.ulFirstTimeStamp);
+            UART0_SendString(",");
+            UART0_SendInteger(xRecord.ulLastTimeStamp);
+            UART0_SendString(",");
+            UART0_SendInteger(xRecord.ucAgingCounter);
+            UART0_SendString(",");
+            UART0_SendInteger(xRecord.xFreezeFrame.ucTemperature);
+            UART0_SendString(",");
+            UART0_SendInteger(xRecord.xFreezeFrame.ucHeatingLevel);
+            UART0_SendString(",");
+            UART0_SendInteger(xRecord.xFreezeFrame.ucHeaterState);
+            UART0_SendString(",");
+            UART0_SendInteger(xRecord.xFreezeFrame.ucCpuLoad);
+            UART0_SendString("\r\n");
+        }
+    }
+    UART0_SendString("DTC,END\r\n");
+    xSemaphoreGive(xDisplayScreenMutex);
+}
+
+/*
+ * Console "export" reply. The display mutex is held for the whole export, so no text lands between the
+ * binary blocks; it takes about 0.4 s for a full log at 9600 baud. The EEPROM is taken for one record at a time.
+ */
+static void prvConsoleExport(void)
+{
+    static FaultExport_BlockType xBlock; /* Kept off the console task stack */
+    DiagLog_RecordType xRecord;
+    Std_ReturnType xStatus;
+    uint16 usCount;
+    uint16 usIndex;
+
+    xSemaphoreTake(xEepromMutex, portMAX_DELAY);
+    usCount = FaultStore_Count();
+    xSemaphoreGive(xEepromMutex);
+
+    xSemaphoreTake(xDisplayScreenMutex, portMAX_DELAY);
+    UART0_SendString("EXPORT,");
+    UART0_SendInteger(usCount);
+    UART0_SendString(",");
+    UART0_SendInteger(xFaultExportDictionary.aucSeat[0]);
+    UART0_SendString(",");
+    UART0_SendInteger(xFaultExportDictionary.aucSeat[1]);
+    UART0_SendString(",");
+    UART0_SendInteger(xFaultExportDictionary.aucCode[0]);
+    UART0_SendString(",");
+    UART0_SendInteger(xFaultExportDictionary.aucCode[1]);
+    UART0_SendString("\r\n");
+
+    FaultExport_Start(&xBlock, &xFaultExportDictionary);
+    for (usIndex = 0; usIndex < usCount; usIndex++)
+    {
+        xSemaphoreTake(xEepromMutex, portMAX_DELAY);
+        xStatus = FaultStore_Read(usIndex, &xRecord);
+        xSemaphoreGive(xEepromMutex);
+
+        /* A record torn by a reset is skipped, the next block starts after the gap */
+        if ((xStatus == E_OK) && (FaultExport_Add(&xBlock, &xRecord) != E_OK) && (xBlock.ucCount > 0))
+        {
+            prvConsoleExportBlock(&xBlock);
+            FaultExport_Add(&xBlock, &xRecord);
+        }
+    }
+    if (xBlock.ucCount > 0)
+    {
+        prvConsoleExportBlock(&xBlock);
+    }
+
+    /* A block of 0 entries ends the export */
+    UART0_SendByte(0);
+    xSemaphoreGive(xDisplayScreenMutex);
+}
+
+/* Sends a finished export block */
+static void prvConsoleExportBlock(FaultExport_BlockType *pxBlock)
+{
+    const uint8 *pucBytes;
+    uint16 usLength = FaultExport_Finish(pxBlock, &pucBytes);
+
+    for (; usLength > 0; usLength--)
+    {
+        UART0_SendByte(*pucBytes++);
+    }
+}
+
+/*
+ * Console "query" and "count" replies, see mainCONSOLE_LINE_SIZE. Like "faults", the EEPROM and the UART
+ * are taken for one record at a time; the records overwritten by the fault store task meanwhile are skipped.
+ */
+static void prvConsoleQuery(char *pcLine)
+{
+    static FaultQuery_CursorType xCursor; /* Kept off the console task stack */
+    DiagLog_RecordType xRecord;
+    char *pcCursor = pcLine;
+    char *pcCommand = prvConsoleToken(&pcCursor);
+    char *pcSeat = prvConsoleToken(&pcCursor);
+    char *pcCode = prvConsoleToken(&pcCursor);
+    char *pcFrom = prvConsoleToken(&pcCursor);
+    char *pcTo = prvConsoleToken(&pcCursor);
+    Std_ReturnType xStatus;
+    uint32 ulFrom = 0;
+    uint32 ulTo = 0xFFFFFFFFUL;
+    uint16 usCount = 0;
+    uint8 ucSeat;
+    uint8 ucCode;
+
+    xStatus = prvConsoleFilter(pcSeat, pcCode, &ucSeat, &ucCode);
+    if ((xStatus == E_OK) && ((*pcFrom != '\0') || (*pcTo != '\0')))
+    {
+        if ((prvConsoleNumber(pcFrom, &ulFrom) != E_OK) || (prvConsoleNumber(pcTo, &ulTo) != E_OK))
+        {
+            xStatus = E_NOT_OK;
+        }
+    }
+    if (*prvConsoleToken(&pcCursor) != '\0')
+    {
+        xStatus = E_NOT_OK;
+    }
+
+    if ((xStatus == E_OK) && (strcmp(pcCommand, "count") == 0))
+    {
+        xSemaphoreTake(xEepromMutex, portMAX_DELAY);
+        xStatus = FaultQuery_Count(ucSeat, ucCode, ulFrom, ulTo, &usCount);
+        xSemaphoreGive(xEepromMutex);
+
+        xSemaphoreTake(xDisplayScreenMutex, portMAX_DELAY);
+        if (xStatus == E_OK)
+        {
+            UART0_SendString("COUNT,");
+            UART0_SendInteger(usCount);
+            UART0_SendString("\r\n");
+        }
+        else
+        {
+            prvConsoleReport(xStatus);
+        }
+        xSemaphoreGive(xDisplayScreenMutex);
+        return;
+    }
+
+    if (xStatus == E_OK)
+    {
+        xSemaphoreTake(xEepromMutex, portMAX_DELAY);
+        xStatus = FaultQuery_First(ucSeat, ucCode, ulFrom, ulTo, &xCursor);
+        xSemaphoreGive(xEepromMutex);
+    }
+    if (xStatus != E_OK)
+    {
+        xSemaphoreTake(xDisplayScreenMutex, portMAX_DELAY);
+        prvConsoleReport(xStatus);
+        xSemaphoreGive(xDisplayScreenMutex);
+        return;
+    }
+
+    for (;;)
+    {
+        xSemaphoreTake(xEepromMutex, portMAX_DELAY);
+        xStatus = FaultQuery_Next(&xCursor, &xRecord);
+        xSemaphoreGive(xEepromMutex);
+
+        if (xStatus != E_OK)
+        {
+            break;
+        }
+
+        xSemaphoreTake(xDisplayScreenMutex, portMAX_DELAY);
+        prvConsoleFaultLine(&xRecord);
+        xSemaphoreGive(xDisplayScreenMutex);
+        usCount++;
+    }
+
+    xSemaphoreTake(xDisplayScreenMutex, portMAX_DELAY);
+    UART0_SendString("QUERY,");
+    UART0_SendInteger(usCount);
+    UART0_SendString("\r\n");
+    xSemaphoreGive(xDisplayScreenMutex);
+}
+
+/* Seat (d, p or *) and failure code (o, u or *) filter of a query, as FaultQuery seat and code numbers */
+static Std_ReturnType prvConsoleFilter(const char *pcSeat, const char *pcCode, uint8 *pucSeat, uint8 *pucCode)
+{
+    if (strcmp(pcSeat, "d") == 0)
+    {
+        *pucSeat = 0;
+    }
+    else if (strcmp(pcSeat, "p") == 0)
+    {
+        *pucSeat = 1;
+    }
+    else if (strcmp(pcSeat, "*") == 0)
+    {
+        *pucSeat = FAULT_QUERY_ALL;
+    }
+    else
+    {
+        return E_NOT_OK;
+    }
+
+    if (strcmp(pcCode, "o") == 0)
+    {
+        *pucCode = 0;
+    }
+    else if (strcmp(pcCode, "u") == 0)
+    {
+        *pucCode = 1;
+    }
+    else if (strcmp(pcCode, "*") == 0)
+    {
+        *pucCode = FAULT_QUERY_ALL;
+    }
+    else
+    {
+        return E_NOT_OK;
+    }
+
+    return E_OK;
+}
+
+/* Decimal value of a console token, up to 0xFFFFFFFF */
+static Std_ReturnType prvConsoleNumber(const char *pcValue, uint32 *pulValue)
+{
+    uint32 ulValue = 0;
+    uint32 ulDigit;
+
+    if (*pcValue == '\0')
+    {
+        return E_NOT_OK;
+    }
+    for (; *pcValue != '\0'; pcValue++)
+    {
+        if ((*pcValue < '0') || (*pcValue > '9'))
+        {
+            return E_NOT_OK;
+        }
+        ulDigit = (uint32) (*pcValue - '0');
+        if (ulValue > ((0xFFFFFFFFUL - ulDigit) / 10U))
+        {
+            return E_NOT_OK;
+        }
+        ulValue = (ulValue * 10U) + ulDigit;
+    }
+
+    *pulValue = ulValue;
+    return E_OK;
+}
+
+/* Console "summary" reply, one line per seat */
+static void prvConsoleSummary(void)
+{
+    FaultQuery_SummaryType xSummary;
+    Std_ReturnType xStatus;
+    uint8 ucSeat;
+
+    for (ucSeat = 0; ucSeat < FAULT_QUERY_MAX_SEATS; ucSeat++)
+    {
+        xSemaphoreTake(xEepromMutex, portMAX_DELAY);
+        xStatus = FaultQuery_Summary(ucSeat, &xSummary);
+        xSemaphoreGive(xEepromMutex);
+
+        xSemaphoreTake(xDisplayScreenMutex, portMAX_DELAY);
+        if (xStatus == E_OK)
+        {
+            UART0_SendString("SUMMARY,");
+            UART0_SendInteger(ucSeat);
+            UART0_SendString(",");
+            UART0_SendInteger(xSummary.ausCount[0]);
+            UART0_SendString(",");
+            UART0_SendInteger(xSummary.ausCount[1]);
+            UART0_SendString(",");
+            UART0_SendInteger(xSummary.ulFirstTimeStamp);
+            UART0_SendString(",");
+            UART0_SendInteger(xSummary.ulLastTimeStamp);
+            UART0_SendString("\r\n");
+        }
+        else
+        {
+            prvConsoleReport(xStatus);
+        }
+        xSemaphoreGive(xDisplayScreenMutex);
     }
 }
 
-/*-------------------------------------------------------------------------------------------------------------------------------------*/
+#if (FAULT_INJECTION == 1)
 
-/*
- * Task function to periodically update and display system status on the UART screen.
- * The displayed information includes desired and current temperatures for both driver and passenger,
- * as well as the current state of the heater (Off, Low, Medium, High).
- * This task uses a mutex (xDisplayScreenMutex) to ensure exclusive access to the UART for sending data.
- */
-void vDisplayScreenTask(void *pvParameters)
+/* Console names of the fault injection targets and faults, in the order of their FaultInject types */
+static const char *const pcInjectTargets[FAULT_INJECT_TARGET_COUNT] = { "adc0", "adc1", "lm0", "lm1", "sw1", "sw2", "sw3" };
+static const char *const pcInjectFaults[FAULT_INJECT_FAULT_COUNT] = { "stuck", "spike", "noise", "drop", "chatter" };
+
+/* Console "inject" commands, see mainCONSOLE_LINE_SIZE */
+static void prvConsoleInject(char *pcLine)
 {
-    TickType_t xDisplayLastWakeTime = xTaskGetTickCount(); /* Initialize for periodic delay */
-    uint8 ucPrevDriverHeaterState = 0xFF, ucPrevPassengerHeaterState = 0xFF;
-    uint8 ucPrevDriverTemp = 0xFF, ucPrevPassengerTemp = 0xFF;
-    uint8 ucPrevDriverHeatingLevel = 0xFF, ucPrevPassengerHeatingLevel = 0xFF;
+    char *pcCursor = pcLine + 7;
+    char *pcCommand = prvConsoleToken(&pcCursor);
+    char *apcArgument[6];
+    FaultInject_StepType xStep;
+    Std_ReturnType xStatus = E_NOT_OK;
+    uint32 aulNumber[4];
+    uint32 ulSeed = 0;
+    uint32 ulNow;
+    uint8 ucTarget;
+    uint8 ucFault;
+    uint8 i;
+
+    for (i = 0; i < 6; i++)
+    {
+        apcArgument[i] = prvConsoleToken(&pcCursor);
+    }
 
-    for (;;)
+    if (strcmp(pcCommand, "report") == 0)
     {
-        /* Check if any data has changed before sending updates */
-        if ((ucDriverHeatingLevel != ucPrevDriverHeatingLevel) || (ucDriverTemperatureValue != ucPrevDriverTemp) || (ucDriverHeaterState != ucPrevDriverHeaterState)
-                || (ucPassengerHeatingLevel != ucPrevPassengerHeatingLevel) || (ucPassengerTemperatureValue != ucPrevPassengerTemp) || (ucPassengerHeaterState != ucPrevPassengerHeaterState))
+        if ((*apcArgument[0] == '\0') && (FaultInject_IsRunning() == FALSE))
         {
-            /* Attempt to take the mutex for screen display to ensure exclusive access to the UART. */
+            prvConsoleInjectReport();
+            return;
+        }
+    }
+    else if (strcmp(pcCommand, "clear") == 0)
+    {
+        if (*apcArgument[0] == '\0')
+        {
+            xTimerStop(xFaultInjectTimer, portMAX_DELAY);
+            FaultInject_Clear();
+            xStatus = E_OK;
+        }
+    }
+    else if (strcmp(pcCommand, "run") == 0)
+    {
+        if (((*apcArgument[0] == '\0') || (prvConsoleNumber(apcArgument[0], &ulSeed) == E_OK)) && (*apcArgument[1] == '\0')
+            && (FaultInject_IsRunning() == FALSE) && (FaultInject_StepCount() > 0))
+        {
+            ulNow = GPTM_WTimer0Read();
+            FaultInject_Run(ulNow, ulSeed);
+            xTimerStart(xFaultInjectTimer, portMAX_DELAY);
+
             xSemaphoreTake(xDisplayScreenMutex, portMAX_DELAY);
+            UART0_SendString("INJECT,RUN,");
+            UART0_SendInteger(ulNow);
+            UART0_SendString("\r\n");
+            xSemaphoreGive(xDisplayScreenMutex);
+            return;
+        }
+    }
+    else if (strcmp(pcCommand, "add") == 0)
+    {
+        for (ucTarget = 0; (ucTarget < FAULT_INJECT_TARGET_COUNT) && (strcmp(apcArgument[0], pcInjectTargets[ucTarget]) != 0); ucTarget++)
+        {
+        }
+        for (ucFault = 0; (ucFault < FAULT_INJECT_FAULT_COUNT) && (strcmp(apcArgument[1], pcInjectFaults[ucFault]) != 0); ucFault++)
+        {
+        }
+        xStatus = ((ucTarget < FAULT_INJECT_TARGET_COUNT) && (ucFault < FAULT_INJECT_FAULT_COUNT)
+                   && (*prvConsoleToken(&pcCursor) == '\0')) ? E_OK : E_NOT_OK;
+        for (i = 0; (i < 4) && (xStatus == E_OK); i++)
+        {
+            xStatus = prvConsoleNumber(apcArgument[i + 2], &aulNumber[i]);
+        }
+        if ((xStatus == E_OK) && (aulNumber[0] <= 0xFFFFU))
+        {
+            xStep.ucTarget = ucTarget;
+            xStep.ucFault = ucFault;
+            xStep.usValue = (uint16) aulNumber[0];
+            xStep.ulPeriod = aulNumber[1];
+            xStep.ulAt = aulNumber[2];
+            xStep.ulDuration = aulNumber[3];
+            xStatus = FaultInject_Add(&xStep);
+        }
+        else
+        {
+            xStatus = E_NOT_OK;
+        }
+    }
 
-            /* Display the header line for separating display updates. */
-            UART0_SendString("------------------------------------------------------------\r\n");
+    xSemaphoreTake(xDisplayScreenMutex, portMAX_DELAY);
+    if (xStatus == E_OK)
+    {
+        UART0_SendString("INJECT,");
+        UART0_SendInteger(FaultInject_StepCount());
+        UART0_SendString("\r\n");
+    }
+    else
+    {
+        prvConsoleReport(xStatus);
+    }
+    xSemaphoreGive(xDisplayScreenMutex);
+}
 
-            /* Display the driver's current temperature. */
-            UART0_SendString("Driver Current Temperature: ");
-            UART0_SendInteger(ucDriverTemperatureValue); /* Send the temperature value. */
-            UART0_SendString("C\r\n");
+/* Console "inject report" reply, one line per step and the false positives */
+static void prvConsoleInjectReport(void)
+{
+    FaultInject_StepType xStep;
+    FaultInject_ResultType xResult;
+    FaultInject_SummaryType xSummary;
+    uint8 ucStep;
 
-            /* Display the driver's heating level. */
-            UART0_SendString("Driver Heating Level: ");
-            switch (ucDriverHeatingLevel)
-            {
-            case mainHEATING_LEVEL_OFF:
-                UART0_SendString("Off");
-                break;
-            case mainHEATING_LEVEL_LOW:
-                UART0_SendString("Low");
-                break;
-            case mainHEATING_LEVEL_MEDIUM:
-                UART0_SendString("Medium");
-                break;
-            case mainHEATING_LEVEL_HIGH:
-                UART0_SendString("High");
-                break;
-            } /* Send the heating level. */
-            UART0_SendString("\r\n");
+    xSemaphoreTake(xDisplayScreenMutex, portMAX_DELAY);
+    for (ucStep = 0; FaultInject_Result(ucStep, &xStep, &xResult) == E_OK; ucStep++)
+    {
+        UART0_SendString("INJECT,STEP,");
+        UART0_SendInteger(ucStep);
+        UART0_SendString(",");
+        UART0_SendString((const uint8 *) pcInjectTargets[xStep.ucTarget]);
+        UART0_SendString(",");
+        UART0_SendString((const uint8 *) pcInjectFaults[xStep.ucFault]);
+        UART0_SendString(",");
+        UART0_SendInteger(xResult.bStarted);
+        UART0_SendString(",");
+        UART0_SendInteger(xResult.ulStart);
+        UART0_SendString(",");
+        UART0_SendInteger(xResult.usDetections);
+        UART0_SendString(",");
+        /* Chatter steps report their false presses, there is no latency to measure */
+        UART0_SendInteger(((xResult.usDetections > 0) && (xStep.ucFault != FAULT_INJECT_CHATTER))
+                          ? ((xResult.ulDetection - xResult.ulStart) & 0xFFFFFFFFUL) : 0);
+        UART0_SendString("\r\n");
+    }
 
-            /* Display the driver's heater state. */
-            UART0_SendString("Driver Heater State: ");
-            switch (ucDriverHeaterState)
-            {
-            case mainHEATER_STATE_OFF: /* Heater is off */
-                UART0_SendString("Off");
-                break;
-            case mainHEATER_STATE_LOW: /* Heater is set to low intensity */
-                UART0_SendString("Low");
-                break;
-            case mainHEATER_STATE_MEDIUM: /* Heater is set to medium intensity */
-                UART0_SendString("Medium");
-                break;
-            case mainHEATER_STATE_HIGH: /* Heater is set to high intensity */
-                UART0_SendString("High");
-                break;
-            }
+    FaultInject_Summary(&xSummary);
+    UART0_SendString("INJECT,END,");
+    UART0_SendInteger(xSummary.ulFalsePositives);
+    UART0_SendString(",");
+    UART0_SendInteger(xSummary.ulCleanSamples);
+    UART0_SendString("\r\n");
+    xSemaphoreGive(xDisplayScreenMutex);
+}
 
-            UART0_SendString("\r\n\r\n"); /* Double newline to separate driver and passenger sections */
+#endif
 
-            /* Display the passenger's current temperature. */
-            UART0_SendString("Passenger Current Temperature: ");
-            UART0_SendInteger(ucPassengerTemperatureValue); /* Send the temperature value. */
-            UART0_SendString("C\r\n");
+#if (TRACE_RECORDER == 1)
 
-            /* Display the passenger's heating level. */
-            UART0_SendString("Passenger Heating Level: ");
-            switch (ucPassengerHeatingLevel)
-            {
-            case mainHEATING_LEVEL_OFF:
-                UART0_SendString("Off");
-                break;
-            case mainHEATING_LEVEL_LOW:
-                UART0_SendString("Low");
-                break;
-            case mainHEATING_LEVEL_MEDIUM:
-                UART0_SendString("Medium");
-                break;
-            case mainHEATING_LEVEL_HIGH:
-                UART0_SendString("High");
-                break;
-            } /* Send the heating level. */
-            UART0_SendString("\r\n");
+/* IRQ numbers and names of the ISRs that record their entry and exit, sent with the trace */
+#define mainTRACE_ISRS                  3U
+static const uint8 ucTraceIrqs[mainTRACE_ISRS] = { GPIO_PORTF_IRQ_NUM, GPIO_PORTB_IRQ_NUM, UART0_IRQ_NUM };
+static const char *const pcTraceIrqNames[mainTRACE_ISRS] = { "GPIO_PORTF", "GPIO_PORTB", "UART0" };
 
-            /* Display the passenger's heater state. */
-            UART0_SendString("Passenger Heater State: ");
-            switch (ucPassengerHeaterState)
-            {
-            case mainHEATER_STATE_OFF: /* Heater is off */
-                UART0_SendString("Off");
-                break;
-            case mainHEATER_STATE_LOW: /* Heater is set to low intensity */
-                UART0_SendString("Low");
-                break;
-            case mainHEATER_STATE_MEDIUM: /* Heater is set to medium intensity */
-                UART0_SendString("Medium");
-                break;
-            case mainHEATER_STATE_HIGH: /* Heater is set to high intensity */
-                UART0_SendString("High");
-                break;
-            }
-            UART0_SendString("\r\n"); /* End of the display update */
+/* Console "trace" commands */
+static void prvConsoleTrace(char *pcLine)
+{
+    char *pcCursor = pcLine + 6;
+    char *pcCommand = prvConsoleToken(&pcCursor);
+    Std_ReturnType xStatus = E_OK;
+    uint32 ulLost;
+    uint16 usCount;
 
-            /* Release the mutex to allow other tasks to access the UART. */
-            xSemaphoreGive(xDisplayScreenMutex);
+    if (strcmp(pcCommand, "start") == 0)
+    {
+        Trace_Start();
+    }
+    else if (strcmp(pcCommand, "stop") == 0)
+    {
+        Trace_Stop();
+    }
+    else if (strcmp(pcCommand, "dump") == 0)
+    {
+        /* The trace of the dump itself would only fill the buffer */
+        Trace_Stop();
+        prvConsoleTraceDump();
+        return;
+    }
+    else
+    {
+        xStatus = E_NOT_OK;
+    }
 
-            /* Save current states to detect future changes */
-            ucPrevDriverHeatingLevel = ucDriverHeatingLevel;
-            ucPrevDriverTemp = ucDriverTemperatureValue;
-            ucPrevDriverHeaterState = ucDriverHeaterState;
-            ucPrevPassengerHeatingLevel = ucPassengerHeatingLevel;
-            ucPrevPassengerTemp = ucPassengerTemperatureValue;
-            ucPrevPassengerHeaterState = ucPassengerHeaterState;
-        }
+    xSemaphoreTake(xDisplayScreenMutex, portMAX_DELAY);
+    if (xStatus == E_OK)
+    {
+        usCount = Trace_Count(&ulLost);
+        UART0_SendString("TRACE,");
+        UART0_SendInteger(Trace_IsRunning());
+        UART0_SendString(",");
+        UART0_SendInteger(usCount);
+        UART0_SendString(",");
+        UART0_SendInteger(ulLost);
+        UART0_SendString("\r\n");
+    }
+    else
+    {
+        prvConsoleReport(xStatus);
+    }
+    xSemaphoreGive(xDisplayScreenMutex);
+}
 
-        /* Delay for 500ms before checking for updates again */
-        vTaskDelayUntil(&xDisplayLastWakeTime, mainDISPLAY_TASK_DELAY);
+/* Console "trace dump" reply, the names of the recorded objects then the records */
+static void prvConsoleTraceDump(void)
+{
+    static TaskStatus_t xTaskStatus[mainRUNTIME_TAG_IDLE]; /* Application, timer service and idle tasks */
+    Trace_RecordType xRecord;
+    const char *pcName;
+    UBaseType_t uxTasks;
+    UBaseType_t uxTask;
+    uint32 ulLost;
+    uint16 usCount;
+    uint16 usIndex;
+    uint8 ucQueue;
+    uint8 ucType;
+    uint8 i;
+
+    usCount = Trace_Count(&ulLost);
+    uxTasks = uxTaskGetSystemState(xTaskStatus, mainRUNTIME_TAG_IDLE, NULL);
+
+    xSemaphoreTake(xDisplayScreenMutex, portMAX_DELAY);
+    UART0_SendString("TRACE,DUMP,");
+    UART0_SendInteger(usCount);
+    UART0_SendString(",");
+    UART0_SendInteger(ulLost);
+    UART0_SendString(",");
+    UART0_SendInteger(configCPU_CLOCK_HZ);
+    UART0_SendString(",");
+    UART0_SendInteger(TRACE_TIME_SHIFT);
+    UART0_SendString("\r\n");
+
+    for (uxTask = 0; uxTask < uxTasks; uxTask++)
+    {
+        UART0_SendString("TRACE,TASK,");
+        UART0_SendInteger((uint32) xTaskGetApplicationTaskTag(xTaskStatus[uxTask].xHandle));
+        UART0_SendString(",");
+        UART0_SendString((const uint8 *) xTaskStatus[uxTask].pcTaskName);
+        UART0_SendString("\r\n");
+    }
+    for (ucQueue = 1; Trace_QueueInfo(ucQueue, &ucType, &pcName) == E_OK; ucQueue++)
+    {
+        UART0_SendString("TRACE,QUEUE,");
+        UART0_SendInteger(ucQueue);
+        UART0_SendString(",");
+        UART0_SendInteger(ucType);
+        UART0_SendString(",");
+        UART0_SendString((const uint8 *) ((pcName != NULL_PTR) ? pcName : ""));
+        UART0_SendString("\r\n");
+    }
+    for (i = 0; i < mainTRACE_ISRS; i++)
+    {
+        UART0_SendString("TRACE,ISR,");
+        UART0_SendInteger(ucTraceIrqs[i]);
+        UART0_SendString(",");
+        UART0_SendString((const uint8 *) pcTraceIrqNames[i]);
+        UART0_SendString("\r\n");
+    }
+#if (mainDEADLINE_MONITOR == 1)
+    for (i = 0; i < mainNUMBER_OF_JOBS; i++)
+    {
+        UART0_SendString("TRACE,JOB,");
+        UART0_SendInteger(i);
+        UART0_SendString(",");
+        UART0_SendString((const uint8 *) pcJobNames[i]);
+        UART0_SendString("\r\n");
+    }
+#endif
+
+    UART0_SendString("TRACE,DATA,");
+    UART0_SendInteger(usCount);
+    UART0_SendString("\r\n");
+    for (usIndex = 0; Trace_Read(usIndex, &xRecord) == E_OK; usIndex++)
+    {
+        /* Little endian delta, then the event and the object */
+        UART0_SendByte((uint8) (xRecord.usDelta & 0xFFU));
+        UART0_SendByte((uint8) (xRecord.usDelta >> 8));
+        UART0_SendByte(xRecord.ucEvent);
+        UART0_SendByte(xRecord.ucObject);
     }
+    UART0_SendString("TRACE,END\r\n");
+    xSemaphoreGive(xDisplayScreenMutex);
 }
 
+#endif
+
 /*-------------------------------------------------------------------------------------------------------------------------------------*/
 
 /*
- * Task function to measure and report CPU load in real-time.
- * The task calculates the CPU load by comparing the total time spent in all tasks
- * to the total runtime of the system, and periodically reports the result via UART.
- * This task runs indefinitely with a delay between each measurement.
+ * Task function of the persistent fault log.
+ * Every mainFAULT_STORE_TASK_DELAY it copies the diagnostic log entries appended since its last run to
+ * the EEPROM, at most mainFAULT_STORE_BATCH of them, so the diagnostic tasks only append to the RAM log.
+ * It runs at the idle priority, so the EEPROM program cycles are busy waited in idle time only. While it
+ * holds the EEPROM mutex, a console save waiting for it raises it to the console priority.
+ * An entry overwritten in the RAM log before it was copied is counted in ulFaultStoreLost.
+ * Each run also ends an aging cycle of the trouble codes.
  */
-void vRunTimeMeasurementsTask(void *pvParameters)
+void vFaultStoreTask(void *pvParameters)
 {
-    TickType_t xRunTimeLastWakeTime = xTaskGetTickCount(); /* Capture the current tick count for accurate periodic delay. */
+    TickType_t xLastWakeTime = xTaskGetTickCount();
+    uint32 ulSequence = DIAG_LOG_FIRST_SEQUENCE; /* Next diagnostic log entry to copy */
+    DiagLog_EntryType xEntry;
+    uint8 ucBatch;
 
     for (;;)
     {
-        uint8 ucCounter; /* Variable to store task index. */
-        uint32 ullTotalTasksTime = 0; /* Variable to accumulate the total runtime for all tasks. */
-
-        /* Delay to maintain consistent runtime measurements. */
-        vTaskDelayUntil(&xRunTimeLastWakeTime, mainRUNTIME_TASK_DELAY);
-
-        /* Attempt to take the mutex for screen display to ensure exclusive access to the UART. */
-        xSemaphoreTake(xDisplayScreenMutex, portMAX_DELAY);
+        mainJOB_END(mainJOB_FAULT_STORE);
+        vTaskDelayUntil(&xLastWakeTime, mainFAULT_STORE_TASK_DELAY);
+        mainJOB_START(mainJOB_FAULT_STORE, xLastWakeTime);
 
-        /* Display the header line for separating display updates. */
-        UART0_SendString("------------------------------------------------------------\r\n");
+        taskENTER_CRITICAL();
+        Dtc_Age();
+        taskEXIT_CRITICAL();
 
-        /* Sum the total execution time for tasks (excluding Idle Task) */
-        for (ucCounter = 1; ucCounter <= mainTOTAL_NUMBER_OF_TASKS; ucCounter++)
+        ucBatch = 0;
+        while ((ucBatch < mainFAULT_STORE_BATCH) && (ulSequence != DiagLog_Head(&xDiagnosticLog)))
         {
-            ullTotalTasksTime += ullTasksTotalTime[ucCounter];
+            if (DiagLog_Read(&xDiagnosticLog, ulSequence, &xEntry) == E_OK)
+            {
+                xSemaphoreTake(xEepromMutex, portMAX_DELAY);
+                if (FaultStore_Append(&xEntry) == E_OK)
+                {
+                    FaultQuery_Insert(FaultStore_NextSequence() - 1U, &xEntry);
+                }
+                xSemaphoreGive(xEepromMutex);
+                ucBatch++;
+            }
+            else if (((DiagLog_Head(&xDiagnosticLog) - ulSequence) & DIAG_LOG_SEQUENCE_MASK) <= mainDIAGNOSTIC_SIZE)
+            {
+                /* Still being written by a diagnostic task, copied at the next run */
+                break;
+            }
+            else
+            {
+                ulFaultStoreLost++;
+            }
+            ulSequence = DIAG_LOG_NEXT(ulSequence);
         }
-
-        /*
-         * Calculate CPU load as a percentage of the total tasks runtime compared to the system's total elapsed time
-         * since startup, as measured by the wide timer.
-         */
-        uint32 ulCurrentSystemTime = GPTM_WTimer0Read(); // Get the current system time for CPU load calculation
-        uint8 ucCPU_Load = (ullTotalTasksTime * 100) / ulCurrentSystemTime;
-
-        UART0_SendString("\r\nCPU Load is ");
-        UART0_SendInteger(ucCPU_Load);
-        UART0_SendString("% \r\n");
-
-        /* Release the mutex to allow other tasks to access the UART. */
-        xSemaphoreGive(xDisplayScreenMutex);
     }
 }
 
@@ -1139,66 +4066,52 @@ void vRunTimeMeasurementsTask(void *pvParameters)
 
 /*
  * ISR for handling interrupts from Port F.
- * This handler manages button presses for PF0 and PF4, which control the passenger and driver heating levels respectively.
- * When either button is pressed, the heating level is cycled through predefined settings, and an event group bit is set to notify tasks.
+ * This handler captures the edges of PF0 (SW2, passenger) and PF4 (SW1, driver).
+ * Each edge is only timestamped and queued in the Button module, the debounce and the heating level
+ * update run in the button tasks. A task is notified only by the first edge after its queue was
+ * drained, so the bounce edges of a press do not cause extra wakeups.
  */
 void GPIO_PORTF_Handler(void)
 {
-    /* Variable to indicate if a higher priority task was woken by the event group operation */
+    /* Variable to indicate if a higher priority task was woken by the notification */
     BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    uint32 ulTimeStamp = GPTM_WTimer0Read();
+    uint32 ulStatus = GPIO_PORTF_RIS_REG;
 
-    /* Check if PF0 (SW2 button) triggered the interrupt */
-    if (GPIO_PORTF_RIS_REG & PF0)
-    {
-        /*
-         * Increment the passenger heating level control.
-         * The heating levels are cycled through:
-         *  - 0: Heating feature is off
-         *  - 1: Low heating (25C)
-         *  - 2: Medium heating (30C)
-         *  - 3: High heating (35C)
-         * Modulo 4 is used to wrap back to 0 after reaching level 3.
-         */
-        ucPassengerHeatingLevel = (ucPassengerHeatingLevel + 1) % mainTOTAL_HEATING_LEVELS;
+    CPU_LOAD_ISR_ENTER();
+    TRACE_ISR_ENTER(GPIO_PORTF_IRQ_NUM);
 
-        /*
-         * Set the event group bit associated with SW2.
-         * This will notify the task waiting on this event that the button was pressed.
-         */
-        xEventGroupSetBitsFromISR(xPassengerButtonEventGroup, mainSW2_INTERRUPT_BIT, &xHigherPriorityTaskWoken);
+    /* Clear the handled interrupt flags first, so an edge arriving while capturing is not lost */
+    GPIO_PORTF_ICR_REG = ulStatus & (PF0 | PF4);
 
-        /* Clear the interrupt flag for PF0 to acknowledge that the interrupt has been handled */
-        GPIO_PORTF_ICR_REG |= PF0;
+    /* Check if PF0 (SW2 button) triggered the interrupt, or an injected edge */
+    if ((ulStatus & PF0) || FAULT_INJECT_BUTTON_EDGE(BUTTON_SW2))
+    {
+        mainLATENCY_START(mainLATENCY_PATH_PASSENGER_BUTTON, mainLATENCY_BIT(mainLATENCY_STAGE_WAKE) | mainLATENCY_BIT(mainLATENCY_STAGE_DECISION));
+
+        if (Button_CaptureEdge(BUTTON_SW2, ulTimeStamp) == TRUE)
+        {
+            vTaskNotifyGiveFromISR(xPassengerButtonProcessHandle, &xHigherPriorityTaskWoken);
+        }
     }
 
-    /* Check if PF4 (SW1 button) triggered the interrupt */
-    if (GPIO_PORTF_RIS_REG & PF4)
+    /* Check if PF4 (SW1 button) triggered the interrupt, or an injected edge */
+    if ((ulStatus & PF4) || FAULT_INJECT_BUTTON_EDGE(BUTTON_SW1))
     {
-        /*
-         * Increment the driver heating level control.
-         * The heating levels are cycled through the same steps as the passenger heating:
-         *  - 0: Heating feature is off
-         *  - 1: Low heating (25C)
-         *  - 2: Medium heating (30C)
-         *  - 3: High heating (35C)
-         * Modulo 4 is used to reset to 0 after reaching level 3.
-         */
-        ucDriverHeatingLevel = (ucDriverHeatingLevel + 1) % mainTOTAL_HEATING_LEVELS;
-
-        /*
-         * Set the event group bit associated with SW1.
-         * This will notify the task waiting on this event that the button was pressed.
-         */
-        xEventGroupSetBitsFromISR(xDriverButtonsEventGroup, mainSW1_INTERRUPT_BIT, &xHigherPriorityTaskWoken);
+        mainLATENCY_START(mainLATENCY_PATH_DRIVER_BUTTON, mainLATENCY_BIT(mainLATENCY_STAGE_WAKE) | mainLATENCY_BIT(mainLATENCY_STAGE_DECISION));
 
-        /* Clear the interrupt flag for PF4 to acknowledge that the interrupt has been handled */
-        GPIO_PORTF_ICR_REG |= PF4;
+        if (Button_CaptureEdge(BUTTON_SW1, ulTimeStamp) == TRUE)
+        {
+            vTaskNotifyGiveFromISR(xDriverButtonsProcessHandle, &xHigherPriorityTaskWoken);
+        }
     }
 
     /*
-     * If setting the event group bit caused a higher priority task to be woken, yield to that task.
+     * If the notification caused a higher priority task to be woken, yield to that task.
      * portYIELD_FROM_ISR() ensures the FreeRTOS scheduler switches context if needed.
      */
+    TRACE_ISR_EXIT(GPIO_PORTF_IRQ_NUM);
+    CPU_LOAD_ISR_EXIT();
     portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
 }
 
@@ -1206,42 +4119,63 @@ void GPIO_PORTF_Handler(void)
 
 /*
  * ISR for handling interrupts from Port B.
- * This handler manages the button press for PB0, which controls the driver heating level.
- * When the button is pressed, the heating level is cycled, and an event group bit is set to notify tasks.
+ * This handler captures the edges of PB1 (SW3, driver) the same way as the Port F handler.
  */
 void GPIO_PORTB_Handler(void)
 {
-    /* Variable to indicate if a higher priority task was woken by the event group operation */
+    /* Variable to indicate if a higher priority task was woken by the notification */
     BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    uint32 ulTimeStamp = GPTM_WTimer0Read();
+
+    CPU_LOAD_ISR_ENTER();
+    TRACE_ISR_ENTER(GPIO_PORTB_IRQ_NUM);
 
-    /* Check if PB0 (SW3 button) triggered the interrupt */
-    if (GPIO_PORTB_RIS_REG & PB1)
+    /* Check if PB1 (SW3 button) triggered the interrupt, or an injected edge */
+    if ((GPIO_PORTB_RIS_REG & PB1) || FAULT_INJECT_BUTTON_EDGE(BUTTON_SW3))
     {
-        /*
-         * Increment the driver heating level control.
-         * The heating levels are cycled through:
-         *  - 0: Heating feature is off
-         *  - 1: Low heating (25C)
-         *  - 2: Medium heating (30C)
-         *  - 3: High heating (35C)
-         * Modulo 4 is used to cycle the levels back to 0 after reaching 3.
-         */
-        ucDriverHeatingLevel = (ucDriverHeatingLevel + 1) % mainTOTAL_HEATING_LEVELS;
+        /* Clear the interrupt flag for PB1 to acknowledge that the interrupt has been handled */
+        GPIO_PORTB_ICR_REG = PB1;
 
-        /*
-         * Set the event group bit associated with SW3.
-         * This will notify the task waiting on this event that the button was pressed.
-         */
-        xEventGroupSetBitsFromISR(xDriverButtonsEventGroup, mainSW3_INTERRUPT_BIT, &xHigherPriorityTaskWoken);
+        mainLATENCY_START(mainLATENCY_PATH_DRIVER_BUTTON, mainLATENCY_BIT(mainLATENCY_STAGE_WAKE) | mainLATENCY_BIT(mainLATENCY_STAGE_DECISION));
 
-        /* Clear the interrupt flag for PB0 to acknowledge that the interrupt has been handled */
-        GPIO_PORTB_ICR_REG |= PB1;
+        if (Button_CaptureEdge(BUTTON_SW3, ulTimeStamp) == TRUE)
+        {
+            vTaskNotifyGiveFromISR(xDriverButtonsProcessHandle, &xHigherPriorityTaskWoken);
+        }
     }
 
     /*
-     * Yield to a higher priority task if setting the event group bit caused it to be woken.
+     * Yield to a higher priority task if the notification caused it to be woken.
      * This ensures that FreeRTOS schedules the higher priority task to run.
      */
+    TRACE_ISR_EXIT(GPIO_PORTB_IRQ_NUM);
+    CPU_LOAD_ISR_EXIT();
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+/*
+ * ISR for handling the UART0 receive interrupt.
+ * Each received character is queued for the console task. Characters arriving while the queue is
+ * full are dropped.
+ */
+void UART0_Handler(void)
+{
+    /* Variable to indicate if a higher priority task was woken by the queue send */
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    uint8 ucByte;
+
+    CPU_LOAD_ISR_ENTER();
+    TRACE_ISR_ENTER(UART0_IRQ_NUM);
+
+    while (UART0_TryReceiveByte(&ucByte) == TRUE)
+    {
+        xQueueSendFromISR(xConsoleRxQueue, &ucByte, &xHigherPriorityTaskWoken);
+    }
+
+    TRACE_ISR_EXIT(UART0_IRQ_NUM);
+    CPU_LOAD_ISR_EXIT();
     portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
 }
 
@@ -61,6 +61,7 @@ extern void vPortSVCHandler(void);
 extern void xPortSysTickHandler(void);
 extern void GPIO_PORTF_Handler(void);
 extern void GPIO_PORTB_Handler(void);
+extern void UART0_Handler(void);
 
 //*****************************************************************************
 //
@@ -94,7 +95,7 @@ void (*const g_pfnVectors[])(void) =
         IntDefaultHandler,// GPIO Port C
         IntDefaultHandler,// GPIO Port D
         IntDefaultHandler,// GPIO Port E
-        IntDefaultHandler,// UART0 Rx and Tx
+        UART0_Handler,// UART0 Rx and Tx
         IntDefaultHandler,// UART1 Rx and Tx
         IntDefaultHandler,// SSI0 Rx and Tx
         IntDefaultHandler,// I2C0 Master and Slave
@@ -0,0 +1,429 @@
+/*
+ ============================================================================
+ Name        : button_replay.cpp
+ Module Name : Button Debounce Replay
+ Description : Host test of the button debounce state machine (firmware HAL/Button/Button.c).
+               A random history of presses of SW1 is turned into bouncy edge traces: clicks
+               and long presses with contact bounce on the press and on the release, holds
+               with short release glitches, and spikes shorter than the debounce time. The
+               edges go through Button_CaptureEdge at their time, as the port ISR does, and
+               the task of main.c is modelled: it blocks until the ISR reports the first
+               edge, then calls Button_Process every 10 ms until Button_IsIdle.
+               Each press must give exactly the events of its debounced hold: a click
+               when released before the long press time, otherwise a long press and one
+               repeat per repeat time held after it, and each spike none. Each event must
+               be reported within a poll period of its due time, and the task must wake
+               once per press or spike, never for the bounce. The history is replayed again
+               with polls late by up to -l ms, which must give the same events, then a burst
+               of edges overflows the edge queue and the button must resynchronize.
+
+ Build       : FW="../../1- Application project/FreeRTOS_Final_Project_WS/Seat_Heater_Control_System"
+               INC=(-I"$FW/Common" -I"$FW/HAL/Button")
+               gcc -O2 -DBUTTON_HOST "${INC[@]}" -c "$FW/HAL/Button/Button.c"
+               g++ -std=c++17 -O2 "${INC[@]}" -o button_replay button_replay.cpp Button.o
+ Usage       : button_replay [options]
+               -n <presses>      Presses and spikes of the history, default 500.
+               -l <ms>           Largest delay of a late poll, default 300.
+               -s <seed>         Random seed, default 1.
+
+ Exit status : 0 when every press gives its events, 2 otherwise, 1 on input errors.
+ ============================================================================
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+extern "C"
+{
+#include "Std_Types.h"
+#include "Button.h"
+
+uint8 Button_HostLevel(Button_IdType xButton);
+}
+
+namespace
+{
+
+/* Pin levels of Button.c */
+constexpr std::uint8_t kReleased = 0U;
+constexpr std::uint8_t kPressed = 1U;
+
+/* Times in edge timestamp ticks (0.1 ms), the task of main.c polls every mainBUTTON_POLL_DELAY */
+constexpr std::uint64_t kPollTicks = BUTTON_MS_TO_TICKS(10);
+constexpr std::uint64_t kWakeTicks = 1U; /* From the ISR to the timer read of the woken task */
+constexpr std::uint64_t kBounceTicks = 30U; /* Largest time between two bounce edges */
+constexpr std::uint64_t kGlitchTicks = 150U; /* Longest release glitch or spike, under the debounce time */
+constexpr int kMaxBounces = 3; /* Extra edge pairs of a bouncy press or release, at most 7 edges */
+
+enum class Kind
+{
+    Click,
+    LongPress,
+    GlitchyHold,
+    Spike
+};
+
+struct Edge
+{
+    std::uint64_t time = 0;
+    std::uint8_t level = kReleased;
+};
+
+/* An event and when the debounced hold makes it due */
+struct Expected
+{
+    Button_EventType event = BUTTON_EVENT_NONE;
+    std::uint64_t due = 0;
+};
+
+struct Reported
+{
+    Button_EventType event = BUTTON_EVENT_NONE;
+    std::uint64_t time = 0;
+};
+
+struct History
+{
+    std::vector<Edge> edges;
+    std::vector<Expected> expected;
+    unsigned long bursts = 0; /* Presses and spikes, each wakes the task once */
+    unsigned long kinds[4] = { 0, 0, 0, 0 };
+};
+
+struct Replay
+{
+    std::vector<Reported> events;
+    unsigned long wakeups = 0;
+    unsigned long notifications = 0; /* Button_CaptureEdge returned TRUE */
+    bool idle = true;
+};
+
+std::uint8_t hostLevel = kReleased;
+
+const char *eventName(Button_EventType event)
+{
+    switch (event)
+    {
+    case BUTTON_EVENT_CLICK: return "click";
+    case BUTTON_EVENT_LONG_PRESS: return "long press";
+    case BUTTON_EVENT_REPEAT: return "repeat";
+    default: return "none";
+    }
+}
+
+/* Edges of a bouncy change to level, the last one at the returned time */
+std::uint64_t addBouncyEdge(std::mt19937 &random, std::vector<Edge> &edges, std::uint64_t time, std::uint8_t level)
+{
+    const int bounces = static_cast<int>(random() % (kMaxBounces + 1));
+
+    edges.push_back({ time, level });
+    for (int i = 0; i < bounces; i++)
+    {
+        time += 1U + random() % kBounceTicks;
+        edges.push_back({ time, static_cast<std::uint8_t>(kPressed - level) });
+        time += 1U + random() % kBounceTicks;
+        edges.push_back({ time, level });
+    }
+    return time;
+}
+
+/*
+ * A press is accepted BUTTON_DEBOUNCE_TIME after its last press edge, and held until its last release
+ * edge: the hold time only stops while the raw level is released, so the release bounce and the
+ * glitches do not shorten it.
+ */
+History makeHistory(unsigned long presses, unsigned seed)
+{
+    std::mt19937 random(seed);
+    History history;
+    std::uint64_t time = 1000U;
+
+    for (unsigned long i = 0; i < presses; i++)
+    {
+        const Kind kind = static_cast<Kind>(random() % 4);
+        history.kinds[static_cast<int>(kind)]++;
+        history.bursts++;
+
+        if (kind == Kind::Spike)
+        {
+            history.edges.push_back({ time, kPressed });
+            time += 1U + random() % kGlitchTicks;
+            history.edges.push_back({ time, kReleased });
+        }
+        else
+        {
+            std::vector<Edge> release;
+            std::vector<std::pair<std::uint64_t, std::uint64_t>> glitches;
+            const std::uint64_t pressed = addBouncyEdge(random, history.edges, time, kPressed);
+            const std::uint64_t accepted = pressed + BUTTON_DEBOUNCE_TIME;
+            const std::uint64_t span = addBouncyEdge(random, release, 0U, kReleased);
+            /* The release starts after the press is accepted */
+            const std::uint64_t hold = (kind == Kind::Click) ? (span + random() % (BUTTON_LONG_PRESS_TIME - span))
+                                                             : (BUTTON_LONG_PRESS_TIME + random() % (6U * BUTTON_REPEAT_TIME));
+            const std::uint64_t released = accepted + hold; /* Last release edge */
+
+            /* Release glitches, clear of the debounce of the press and of the release bounce */
+            if (kind == Kind::GlitchyHold)
+            {
+                std::uint64_t glitch = accepted + BUTTON_DEBOUNCE_TIME;
+                for (int g = static_cast<int>(1U + random() % 3U); g > 0; g--)
+                {
+                    glitch += random() % (hold / 4U);
+                    if ((glitch + kGlitchTicks + 2U * BUTTON_DEBOUNCE_TIME) >= released)
+                    {
+                        break;
+                    }
+                    history.edges.push_back({ glitch, kReleased });
+                    glitches.push_back({ glitch, 0U });
+                    glitch += 1U + random() % kGlitchTicks;
+                    history.edges.push_back({ glitch, kPressed });
+                    glitches.back().second = glitch;
+                }
+            }
+
+            /* The release bounce ends at the last release edge, its bounces are glitches of the hold */
+            for (std::size_t e = 0; e < release.size(); e++)
+            {
+                history.edges.push_back({ released - span + release[e].time, release[e].level });
+                if (release[e].level == kPressed)
+                {
+                    glitches.push_back({ released - span + release[e - 1U].time, released - span + release[e].time });
+                }
+            }
+
+            if (hold < BUTTON_LONG_PRESS_TIME)
+            {
+                history.expected.push_back({ BUTTON_EVENT_CLICK, released + BUTTON_DEBOUNCE_TIME });
+            }
+            else
+            {
+                const std::size_t first = history.expected.size();
+                history.expected.push_back({ BUTTON_EVENT_LONG_PRESS, accepted + BUTTON_LONG_PRESS_TIME });
+                for (std::uint64_t repeat = BUTTON_LONG_PRESS_TIME + BUTTON_REPEAT_TIME; repeat <= hold; repeat += BUTTON_REPEAT_TIME)
+                {
+                    history.expected.push_back({ BUTTON_EVENT_REPEAT, accepted + repeat });
+                }
+                /* A hold event that falls in a glitch is seen at the edge that presses the button again */
+                for (std::size_t e = first; e < history.expected.size(); e++)
+                {
+                    for (const auto &g : glitches)
+                    {
+                        if ((history.expected[e].due > g.first) && (history.expected[e].due <= g.second))
+                        {
+                            history.expected[e].due = g.second;
+                        }
+                    }
+                }
+            }
+            time = released;
+        }
+        /* Far enough apart that a late poll sees one burst at a time */
+        time += 4000U + random() % 11000U;
+    }
+    return history;
+}
+
+/*
+ * Runs the edges through the ISR entry of the Button module and the task model of main.c. The ISR runs
+ * before a poll due at the same time. lateTicks > 0 delays each poll by a random time up to it.
+ */
+Replay replay(const std::vector<Edge> &edges, std::uint64_t lateTicks, std::mt19937 &random)
+{
+    Replay result;
+    std::uint64_t nextPoll = std::numeric_limits<std::uint64_t>::max();
+    std::size_t next = 0;
+
+    while ((next < edges.size()) || (nextPoll != std::numeric_limits<std::uint64_t>::max()))
+    {
+        if ((next < edges.size()) && (edges[next].time <= nextPoll))
+        {
+            hostLevel = edges[next].level;
+            if (Button_CaptureEdge(BUTTON_SW1, static_cast<uint32>(edges[next].time)) == TRUE)
+            {
+                result.notifications++;
+                if (nextPoll == std::numeric_limits<std::uint64_t>::max())
+                {
+                    result.wakeups++;
+                    nextPoll = edges[next].time + kWakeTicks;
+                }
+            }
+            next++;
+            continue;
+        }
+
+        Button_EventType event;
+        while ((event = Button_Process(BUTTON_SW1, static_cast<uint32>(nextPoll))) != BUTTON_EVENT_NONE)
+        {
+            result.events.push_back({ event, nextPoll });
+        }
+        if (Button_IsIdle(BUTTON_SW1) == TRUE)
+        {
+            nextPoll = std::numeric_limits<std::uint64_t>::max();
+        }
+        else
+        {
+            nextPoll += kPollTicks + ((lateTicks == 0U) ? 0U : (random() % (lateTicks + 1U)));
+        }
+    }
+    result.idle = (Button_IsIdle(BUTTON_SW1) == TRUE);
+    return result;
+}
+
+/* Compares the reported events with the expected ones, and with lateness their due times */
+int check(const char *name, const History &history, const Replay &result, bool timely)
+{
+    int errors = 0;
+    std::uint64_t worst = 0;
+
+    if (result.events.size() != history.expected.size())
+    {
+        std::cerr << name << ": " << result.events.size() << " events reported for " << history.expected.size() << " expected\n";
+        errors++;
+    }
+    for (std::size_t i = 0; i < std::min(result.events.size(), history.expected.size()); i++)
+    {
+        const Reported &got = result.events[i];
+        const Expected &want = history.expected[i];
+        const bool late = timely && ((got.time < want.due) || ((got.time - want.due) > (kPollTicks + kWakeTicks)));
+
+        if (got.time >= want.due)
+        {
+            worst = std::max(worst, got.time - want.due);
+        }
+        if ((got.event != want.event) || late)
+        {
+            if (errors++ < 5)
+            {
+                std::cerr << name << ": event " << i << " is a " << eventName(got.event) << " at " << got.time / 10U << " ms, expected a "
+                          << eventName(want.event) << " due at " << want.due / 10U << " ms\n";
+            }
+        }
+    }
+    if (timely && (result.wakeups != history.bursts))
+    {
+        std::cerr << name << ": the task woke " << result.wakeups << " times for " << history.bursts << " presses and spikes\n";
+        errors++;
+    }
+    if (!result.idle)
+    {
+        std::cerr << name << ": the button is not idle at the end\n";
+        errors++;
+    }
+    std::cout << name << ": " << result.events.size() << " events, " << result.wakeups << " task wakeups, " << result.notifications
+              << " ISR notifications, latest event " << worst / 10U << "." << worst % 10U << " ms after it was due\n";
+    return errors;
+}
+
+/* A burst of more edges than the queue holds while the task waits for its next poll, then a press */
+int overflowTest()
+{
+    std::vector<Edge> edges;
+    std::mt19937 random(7U);
+    std::uint64_t time = 1000000000ULL;
+    int errors = 0;
+
+    for (int i = 0; i < 3 * BUTTON_EDGE_QUEUE_SIZE; i++)
+    {
+        edges.push_back({ time, static_cast<std::uint8_t>((i % 2 == 0) ? kPressed : kReleased) });
+        time += 1U;
+    }
+    edges.push_back({ time, kPressed });
+    edges.push_back({ time + BUTTON_MS_TO_TICKS(300), kReleased });
+
+    const Replay result = replay(edges, 0U, random);
+    const bool clickOnly = (result.events.size() <= 1U) && (result.events.empty() || (result.events[0].event == BUTTON_EVENT_CLICK));
+    if (!clickOnly || !result.idle)
+    {
+        std::cerr << "Overflow: " << result.events.size() << " events, the button " << (result.idle ? "is" : "is not")
+                  << " idle at the end\n";
+        errors++;
+    }
+
+    /* The next press is debounced normally again */
+    edges.clear();
+    time += BUTTON_MS_TO_TICKS(1000);
+    edges.push_back({ time, kPressed });
+    edges.push_back({ time + BUTTON_MS_TO_TICKS(200), kReleased });
+    const Replay after = replay(edges, 0U, random);
+    if ((after.events.size() != 1U) || (after.events[0].event != BUTTON_EVENT_CLICK) || !after.idle)
+    {
+        std::cerr << "Overflow: the press after the overflow gave " << after.events.size() << " events\n";
+        errors++;
+    }
+    std::cout << "Overflow: " << 3 * BUTTON_EDGE_QUEUE_SIZE << " edges in " << 3 * BUTTON_EDGE_QUEUE_SIZE / 10
+              << " ms, resynchronized with " << result.events.size() << " event, the next press gave "
+              << after.events.size() << "\n";
+    return errors;
+}
+
+} /* namespace */
+
+uint8 Button_HostLevel(Button_IdType xButton)
+{
+    (void) xButton;
+    return hostLevel;
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned long presses = 500;
+    unsigned long lateMs = 300;
+    unsigned seed = 1;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const std::string arg = argv[i];
+        if ((arg == "-n") && (i + 1 < argc))
+        {
+            presses = std::strtoul(argv[++i], nullptr, 10);
+        }
+        else if ((arg == "-l") && (i + 1 < argc))
+        {
+            lateMs = std::strtoul(argv[++i], nullptr, 10);
+        }
+        else if ((arg == "-s") && (i + 1 < argc))
+        {
+            seed = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else
+        {
+            std::cerr << "Usage: button_replay [-n <presses>] [-l <ms>] [-s <seed>]\n";
+            return 1;
+        }
+    }
+    if ((presses == 0) || (lateMs > 390))
+    {
+        std::cerr << "button_replay: no presses, or late polls over 390 ms (the presses are 400 ms apart)\n";
+        return 1;
+    }
+
+    std::mt19937 random(seed);
+    History history = makeHistory(presses, seed);
+    std::cout << presses << " presses: " << history.kinds[0] << " clicks, " << history.kinds[1] << " long presses, "
+              << history.kinds[2] << " holds with glitches, " << history.kinds[3] << " spikes, " << history.edges.size()
+              << " edges, " << history.expected.size() << " events expected\n";
+
+    int errors = check("10 ms polls", history, replay(history.edges, 0U, random), true);
+
+    /* The same history later in time, the state of the button carries over as it is idle */
+    const std::uint64_t shift = history.edges.back().time + BUTTON_MS_TO_TICKS(1000);
+    for (Edge &edge : history.edges)
+    {
+        edge.time += shift;
+    }
+    for (Expected &expected : history.expected)
+    {
+        expected.due += shift;
+    }
+    errors += check("Late polls", history, replay(history.edges, BUTTON_MS_TO_TICKS(lateMs), random), false);
+    errors += overflowTest();
+
+    std::cout << ((errors == 0) ? "PASS" : "FAIL") << "\n";
+    return (errors == 0) ? 0 : 2;
+}
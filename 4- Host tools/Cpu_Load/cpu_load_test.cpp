@@ -0,0 +1,306 @@
+/*
+ ============================================================================
+ Name        : cpu_load_test.cpp
+ Module Name : CPU Load Test
+ Description : Host test bench of the sliding window CPU load measurement (firmware
+               Control/CpuLoad.c). A 16 MHz CPU with a 1 ms tick is simulated cycle by cycle
+               of its activity: the idle loop calls the idle hook once per turn of a fixed
+               number of cycles, the tasks run whole chunks of the ticks, the tick interrupt
+               calls the tick hook before its last cycles and the application ISRs
+               interrupt the tasks and the idle loop at random. The task load follows a
+               profile of steps, and the cycle counter wraps during the run.
+               At the end of every second the 1, 10 and 60 second windows of CpuLoad must
+               match the simulated load and ISR load of the same seconds within the
+               tolerance, also right after a step of the load, where the load since
+               startup (printed for comparison) lags far behind. Only until CpuLoad has
+               timed its idle loop may the windows be missing.
+
+ Build       : FW="../../1- Application project/FreeRTOS_Final_Project_WS/Seat_Heater_Control_System"
+               INC=(-I"$FW/Common" -I"$FW/Control")
+               gcc -O2 -DCPU_LOAD_HOST "${INC[@]}" -c "$FW/Control/CpuLoad.c"
+               g++ -std=c++17 -O2 "${INC[@]}" -o cpu_load_test cpu_load_test.cpp CpuLoad.o
+ Usage       : cpu_load_test [options]
+               -p <profile>      Task load steps "<seconds>:<percent>,...", default
+                                 40:20,30:75,60:35,20:5.
+               -k <cycles>       Cycles of an idle loop turn, default 37.
+               -t <0.1 %>        Tolerance of the windows, default 5 (0.5 %).
+               -r <seed>         Random seed, default 1.
+
+ Exit status : 0 when every window is within the tolerance, 2 otherwise, 1 on input errors.
+ ============================================================================
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+extern "C"
+{
+#include "Std_Types.h"
+#include "CpuLoad.h"
+}
+
+namespace
+{
+
+constexpr std::uint64_t kCyclesPerTick = 16000U;
+constexpr std::uint32_t kTicksPerSecond = 1000U;
+constexpr std::uint64_t kTickTail = 24U; /* Cycles of the tick interrupt after the tick hook */
+
+/* The cycle counter wraps 3 s into the run */
+std::uint64_t now = 0x100000000ULL - 3U * kTicksPerSecond * kCyclesPerTick;
+
+/* Cumulative simulated times, cycles is the cycle count of a snapshot */
+struct Totals
+{
+    std::uint64_t cycles = 0;
+    std::uint64_t idle = 0;
+    std::uint64_t isr = 0;
+};
+
+struct Cpu
+{
+    std::uint64_t loopCycles = 37;
+    std::uint64_t loopProgress = 0; /* Cycles of the current idle loop turn already run */
+    Totals totals;
+
+    /* The idle loop runs for the given cycles */
+    void idle(std::uint64_t cycles)
+    {
+        totals.idle += cycles;
+        while (cycles > 0)
+        {
+            const std::uint64_t step = std::min(cycles, loopCycles - loopProgress);
+            now += step;
+            cycles -= step;
+            loopProgress += step;
+            if (loopProgress == loopCycles)
+            {
+                loopProgress = 0;
+                CpuLoad_Idle();
+            }
+        }
+    }
+
+    void task(std::uint64_t cycles)
+    {
+        now += cycles;
+    }
+
+    void isr(std::uint64_t cycles)
+    {
+        CpuLoad_IsrEnter();
+        now += cycles;
+        CpuLoad_IsrExit();
+        totals.isr += cycles;
+    }
+};
+
+bool parseProfile(const std::string &text, std::vector<std::pair<unsigned, unsigned>> &profile)
+{
+    std::stringstream list(text);
+    std::string step;
+    while (std::getline(list, step, ','))
+    {
+        const std::size_t colon = step.find(':');
+        if (colon == std::string::npos)
+        {
+            return false;
+        }
+        const unsigned seconds = static_cast<unsigned>(std::strtoul(step.substr(0, colon).c_str(), nullptr, 10));
+        const unsigned percent = static_cast<unsigned>(std::strtoul(step.substr(colon + 1).c_str(), nullptr, 10));
+        if ((seconds == 0) || (percent > 100))
+        {
+            return false;
+        }
+        profile.emplace_back(seconds, percent);
+    }
+    return !profile.empty();
+}
+
+/* Load and ISR load in 0.1 % between two totals */
+std::pair<long, long> load(const Totals &from, const Totals &to)
+{
+    const double cycles = static_cast<double>(to.cycles - from.cycles);
+    const double idle = static_cast<double>(to.idle - from.idle);
+    const double isr = static_cast<double>(to.isr - from.isr);
+    return { std::lround(1000.0 * (cycles - idle) / cycles), std::lround(1000.0 * isr / cycles) };
+}
+
+}
+
+/* Cycle counter of the host build of the CpuLoad module */
+extern "C" uint32 CpuLoad_HostCycles(void)
+{
+    return static_cast<uint32>(now & 0xFFFFFFFFULL);
+}
+
+int main(int argc, char *argv[])
+{
+    std::string profileText = "40:20,30:75,60:35,20:5";
+    long tolerance = 5;
+    std::uint32_t seed = 1U;
+    Cpu cpu;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        if (arg == "-p" && i + 1 < argc)
+        {
+            profileText = argv[++i];
+        }
+        else if (arg == "-k" && i + 1 < argc)
+        {
+            cpu.loopCycles = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (arg == "-t" && i + 1 < argc)
+        {
+            tolerance = std::strtol(argv[++i], nullptr, 10);
+        }
+        else if (arg == "-r" && i + 1 < argc)
+        {
+            seed = static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else
+        {
+            std::cerr << "usage: cpu_load_test [-p profile] [-k loop cycles] [-t tolerance] [-r seed]\n";
+            return 1;
+        }
+    }
+    std::vector<std::pair<unsigned, unsigned>> profile;
+    if (!parseProfile(profileText, profile) || (cpu.loopCycles < 4) || (cpu.loopCycles > 1000) || (tolerance < 0))
+    {
+        std::cerr << "cpu_load_test: bad profile, loop cycles (4 to 1000) or tolerance\n";
+        return 1;
+    }
+
+    std::mt19937 random(seed);
+    std::uniform_int_distribution<unsigned> percent(0, 99);
+    std::vector<Totals> snapshots; /* At the tick hooks that close a second in CpuLoad */
+    const unsigned windows[] = { 1U, 10U, 60U };
+    unsigned long tick = 0;
+    unsigned long checks = 0;
+    unsigned long untimed = 0; /* Windows not read before CpuLoad has timed its idle loop */
+    bool timed = false;
+    int errors = 0;
+
+    CpuLoad_Init(kTicksPerSecond);
+    for (const auto &step : profile)
+    {
+        for (unsigned long end = tick + step.first * kTicksPerSecond; tick < end; ++tick)
+        {
+            /* The tick interrupt, its hook runs before its last cycles */
+            const std::uint64_t tickIsr = 150U + random() % 100U;
+            now += tickIsr - kTickTail;
+            cpu.totals.isr += tickIsr - kTickTail;
+            CpuLoad_Tick(static_cast<uint32>(tickIsr - kTickTail));
+
+            if ((tick % kTicksPerSecond) == 0U)
+            {
+                /* CpuLoad takes its reference at the first tick, then closes a second every kTicksPerSecond */
+                Totals snapshot = cpu.totals;
+                snapshot.cycles = now;
+                snapshots.push_back(snapshot);
+
+                const std::size_t closed = snapshots.size() - 1U;
+                for (unsigned window : windows)
+                {
+                    CpuLoad_WindowType measured;
+                    const Std_ReturnType status = CpuLoad_Read(static_cast<uint8>(window), &measured);
+                    if (window > closed)
+                    {
+                        if (status == E_OK)
+                        {
+                            std::cerr << "second " << closed << ": window " << window << " s available too early\n";
+                            ++errors;
+                        }
+                        continue;
+                    }
+                    if ((status != E_OK) && !timed)
+                    {
+                        ++untimed;
+                        continue;
+                    }
+                    timed = true;
+                    const std::pair<long, long> truth = load(snapshots[closed - window], snapshots[closed]);
+                    ++checks;
+                    if ((status != E_OK) || (std::labs(measured.usLoad - truth.first) > tolerance) ||
+                        (std::labs(measured.usIsrLoad - truth.second) > tolerance))
+                    {
+                        std::cerr << "second " << closed << ": window " << window << " s load " << measured.usLoad << " ISR "
+                                  << measured.usIsrLoad << ", simulated " << truth.first << " ISR " << truth.second << "\n";
+                        ++errors;
+                    }
+                }
+            }
+            now += kTickTail;
+            cpu.totals.isr += kTickTail;
+
+            /* A task runs a chunk of the tick with the profile probability, an ISR may come anywhere */
+            const std::uint64_t rest = kCyclesPerTick - tickIsr;
+            const std::uint64_t busy = (percent(random) < step.second) ? (rest * (70U + random() % 30U)) / 100U : 0U;
+            std::uint64_t isrAt = rest;
+            std::uint64_t isrCycles = 0;
+            if ((random() % 4U) == 0U)
+            {
+                isrCycles = 200U + random() % 1800U;
+                isrAt = random() % (rest - isrCycles);
+            }
+
+            /* The task runs first, the idle loop after it, the ISR interrupts either */
+            std::uint64_t done = 0;
+            auto run = [&](std::uint64_t until)
+            {
+                if (done < std::min(until, busy))
+                {
+                    cpu.task(std::min(until, busy) - done);
+                    done = std::min(until, busy);
+                }
+                if (done < until)
+                {
+                    cpu.idle(until - done);
+                    done = until;
+                }
+            };
+            run(isrAt);
+            if (isrCycles > 0)
+            {
+                cpu.isr(isrCycles);
+                run(rest - isrCycles);
+            }
+            else
+            {
+                run(rest);
+            }
+        }
+
+        /* The load of the windows at the end of the step, and the load since startup */
+        const std::size_t last = snapshots.size() - 1U;
+        std::cout << std::setw(4) << step.first << " s at " << std::setw(3) << step.second << " %:";
+        for (unsigned window : windows)
+        {
+            CpuLoad_WindowType measured;
+            if (CpuLoad_Read(static_cast<uint8>(window), &measured) == E_OK)
+            {
+                std::cout << "  " << window << " s " << std::setw(4) << measured.usLoad << " (ISR " << std::setw(3) << measured.usIsrLoad << ")";
+            }
+        }
+        std::cout << "  since startup " << std::setw(4) << load(snapshots.front(), snapshots[last]).first << " (0.1 %)\n";
+    }
+
+    if (!timed)
+    {
+        std::cerr << "the idle loop was never timed\n";
+        ++errors;
+    }
+    std::cout << checks << " windows checked, " << untimed << " before the idle loop was timed, " << errors << " errors\n";
+    return (errors == 0) ? 0 : 2;
+}
@@ -0,0 +1,418 @@
+/*
+ ============================================================================
+ Name        : deadline_test.cpp
+ Module Name : Deadline Monitor Test
+ Description : Host test bench of the deadline miss and release jitter monitor of the periodic
+               jobs (firmware Control/JobMonitor.c). The tasks of the schedulability task
+               table run on a simulated CPU under fixed priority preemptive scheduling, the
+               tasks of equal priority in FIFO order and to completion (the priority 1 tasks
+               hold the DisplayScreen mutex for most of their job). The execution times are
+               random, up to the task table WCET scaled by a factor.
+               The firmware periodic jobs (the tasks of main.c pcJobNames whose deadline is
+               their period) are released as with vTaskDelayUntil, one period after the
+               previous release, and report to JobMonitor like main.c does, with a 32 bit
+               cycle counter at 16 MHz that wraps during the run. The other tasks are
+               sporadic and only interfere. For every factor the statistics of JobMonitor
+               must match the simulated schedule:
+               - the jobs, the deadline misses, the longest jitter and the longest response,
+               - the jitter histogram, bucket by bucket.
+               The smallest factor must have no miss and the largest must have some.
+
+ Build       : FW="../../1- Application project/FreeRTOS_Final_Project_WS/Seat_Heater_Control_System"
+               INC=(-I"$FW/Common" -I"$FW/Control")
+               gcc -O2 "${INC[@]}" -c "$FW/Control/JobMonitor.c"
+               g++ -std=c++17 -O2 "${INC[@]}" -o deadline_test deadline_test.cpp JobMonitor.o
+ Usage       : deadline_test [options] task_table.csv
+               -f <factors>      WCET factors separated by ',', default 0.25,1,1.5.
+               -d <seconds>      Simulated time per factor, default 60.
+               -r <seed>         Random seed, default 1.
+
+ Exit status : 0 when the statistics match, 2 otherwise, 1 on input errors.
+ ============================================================================
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+extern "C"
+{
+#include "Std_Types.h"
+#include "JobMonitor.h"
+}
+
+namespace
+{
+
+constexpr std::uint64_t kCyclesPerMs = 16000U;
+constexpr std::uint32_t kCyclesPerUs = 16U;
+
+/* The cycle counter wraps one second into the run */
+constexpr std::uint64_t kCounterBase = 0x100000000ULL - 1000U * kCyclesPerMs;
+
+/* Job numbers of main.c (mainJOB_...), the heaters are only periodic when mainHEATER_EVENT_DRIVEN is 0 */
+const char *const jobNames[] = { "Driver Sensor", "Passenger Sensor", "Driver Heater", "Passenger Heater",
+                                 "Display Screen", "Run Time", "Fault Store" };
+
+struct Task
+{
+    std::string name;
+    std::uint64_t period = 0; /* Cycles */
+    std::uint64_t deadline = 0;
+    double wcet = 0.0; /* ms */
+    int priority = 0;
+    int job = -1; /* Job number when monitored */
+};
+
+/* Expected statistics of a job, from the simulated schedule */
+struct Expected
+{
+    unsigned long jobs = 0;
+    unsigned long misses = 0;
+    std::uint64_t jitterMax = 0;
+    std::uint64_t responseMax = 0;
+    unsigned long histogram[JOB_MONITOR_HISTOGRAM_SIZE] = {};
+};
+
+/* A task of the simulated CPU */
+struct Runnable
+{
+    const Task *task = nullptr;
+    bool active = false;
+    bool started = false;
+    std::uint64_t nextRelease = 0;
+    std::uint64_t release = 0;
+    std::uint64_t start = 0;
+    std::uint64_t remaining = 0;
+    unsigned long completed = 0;
+};
+
+std::string trim(const std::string &text)
+{
+    const std::size_t first = text.find_first_not_of(" \t\r");
+    if (first == std::string::npos)
+    {
+        return "";
+    }
+    const std::size_t last = text.find_last_not_of(" \t\r");
+    return text.substr(first, last - first + 1);
+}
+
+bool readTaskTable(const std::string &path, std::vector<Task> &tasks)
+{
+    std::ifstream file(path);
+    if (!file)
+    {
+        std::cerr << "deadline_test: cannot open " << path << "\n";
+        return false;
+    }
+
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line))
+    {
+        ++lineNumber;
+        line = trim(line);
+        if (line.empty() || line[0] == '#')
+        {
+            continue;
+        }
+
+        std::vector<std::string> fields;
+        std::stringstream ss(line);
+        std::string field;
+        while (std::getline(ss, field, ','))
+        {
+            fields.push_back(trim(field));
+        }
+        if (fields.size() < 5)
+        {
+            std::cerr << path << ":" << lineNumber << ": expected 5 or 6 fields\n";
+            return false;
+        }
+
+        Task task;
+        task.name = fields[0];
+        task.period = static_cast<std::uint64_t>(std::llround(std::strtod(fields[1].c_str(), nullptr) * kCyclesPerMs));
+        task.deadline = static_cast<std::uint64_t>(std::llround(std::strtod(fields[2].c_str(), nullptr) * kCyclesPerMs));
+        task.wcet = std::strtod(fields[3].c_str(), nullptr);
+        task.priority = std::atoi(fields[4].c_str());
+        if (task.period == 0 || task.deadline == 0 || task.wcet <= 0.0)
+        {
+            std::cerr << path << ":" << lineNumber << ": period, deadline and WCET must be positive\n";
+            return false;
+        }
+        for (int job = 0; job < static_cast<int>(sizeof(jobNames) / sizeof(jobNames[0])); ++job)
+        {
+            if ((task.name == jobNames[job]) && (task.deadline == task.period))
+            {
+                task.job = job;
+            }
+        }
+        tasks.push_back(task);
+    }
+
+    if (tasks.empty())
+    {
+        std::cerr << "deadline_test: " << path << " has no tasks\n";
+        return false;
+    }
+    return true;
+}
+
+uint32 counter(std::uint64_t time)
+{
+    return static_cast<uint32>((kCounterBase + time) & 0xFFFFFFFFULL);
+}
+
+unsigned bucket(std::uint64_t jitter)
+{
+    unsigned bits = 0;
+    for (std::uint64_t value = jitter / kCyclesPerUs; value != 0; value >>= 1)
+    {
+        ++bits;
+    }
+    return std::min(bits, JOB_MONITOR_HISTOGRAM_SIZE - 1U);
+}
+
+/* The next task to run: the highest priority, then the one already running, then the first released */
+Runnable *pick(std::vector<Runnable> &cpu)
+{
+    Runnable *best = nullptr;
+    for (Runnable &runnable : cpu)
+    {
+        if (!runnable.active)
+        {
+            continue;
+        }
+        if ((best == nullptr) || (runnable.task->priority > best->task->priority) ||
+            ((runnable.task->priority == best->task->priority) &&
+             ((runnable.started && !best->started) || ((runnable.started == best->started) && (runnable.release < best->release)))))
+        {
+            best = &runnable;
+        }
+    }
+    return best;
+}
+
+/* Simulates one factor, returns the number of mismatches and adds the misses to totalMisses */
+int simulate(const std::vector<Task> &tasks, double factor, std::uint64_t duration, std::mt19937 &random, unsigned long &totalMisses)
+{
+    std::vector<Runnable> cpu(tasks.size());
+    std::vector<Expected> expected(JOB_MONITOR_MAX_JOBS);
+    std::uniform_real_distribution<double> execution(0.5, 1.0);
+
+    JobMonitor_Init(kCyclesPerUs);
+    for (std::size_t i = 0; i < tasks.size(); ++i)
+    {
+        cpu[i].task = &tasks[i];
+        cpu[i].nextRelease = (random() % (tasks[i].period / kCyclesPerMs)) * kCyclesPerMs;
+        if (tasks[i].job >= 0)
+        {
+            JobMonitor_SetPeriod(static_cast<uint8>(tasks[i].job), static_cast<uint32>(tasks[i].period));
+        }
+    }
+
+    std::uint64_t now = 0;
+    while (now < duration)
+    {
+        for (Runnable &runnable : cpu)
+        {
+            if (!runnable.active && (runnable.nextRelease <= now))
+            {
+                const double wcet = runnable.task->wcet * factor * static_cast<double>(kCyclesPerMs);
+                runnable.active = true;
+                runnable.started = false;
+                runnable.release = runnable.nextRelease;
+                runnable.remaining = std::max<std::uint64_t>(1U, static_cast<std::uint64_t>(wcet * execution(random)));
+            }
+        }
+
+        std::uint64_t nextEvent = UINT64_MAX;
+        for (const Runnable &runnable : cpu)
+        {
+            if (!runnable.active)
+            {
+                nextEvent = std::min(nextEvent, runnable.nextRelease);
+            }
+        }
+
+        Runnable *running = pick(cpu);
+        if (running == nullptr)
+        {
+            now = nextEvent;
+            continue;
+        }
+
+        const int job = running->task->job;
+        if (!running->started)
+        {
+            running->started = true;
+            running->start = now;
+            /* As main.c: the first job of a task is not counted */
+            if ((job >= 0) && (running->completed > 0))
+            {
+                JobMonitor_Start(static_cast<uint8>(job), counter(running->release), counter(now));
+            }
+        }
+
+        const std::uint64_t slice = std::min(running->remaining, nextEvent - now);
+        now += slice;
+        running->remaining -= slice;
+        if (running->remaining > 0)
+        {
+            continue;
+        }
+
+        /* Completed, the next job is released one period after this one, or later for a sporadic task */
+        running->active = false;
+        if (job >= 0)
+        {
+            const bool missed = (JobMonitor_End(static_cast<uint8>(job), counter(now)) == TRUE);
+            if (running->completed > 0)
+            {
+                Expected &stats = expected[job];
+                const std::uint64_t jitter = running->start - running->release;
+                const std::uint64_t response = now - running->release;
+                const bool late = (response > running->task->period);
+                ++stats.jobs;
+                stats.misses += late ? 1U : 0U;
+                stats.jitterMax = std::max(stats.jitterMax, jitter);
+                stats.responseMax = std::max(stats.responseMax, response);
+                ++stats.histogram[bucket(jitter)];
+                if (missed != late)
+                {
+                    std::cerr << running->task->name << ": job ending at " << now << " reported " << (missed ? "late" : "in time") << "\n";
+                    return 1;
+                }
+            }
+            running->nextRelease = running->release + running->task->period;
+        }
+        else
+        {
+            running->nextRelease = std::max(running->release + running->task->period, now) +
+                                   (random() % (running->task->period / kCyclesPerMs / 2U + 1U)) * kCyclesPerMs;
+        }
+        ++running->completed;
+    }
+
+    int errors = 0;
+    std::cout << "factor " << factor << ":\n";
+    for (const Task &task : tasks)
+    {
+        if (task.job < 0)
+        {
+            continue;
+        }
+        JobMonitor_StatsType stats;
+        JobMonitor_Read(static_cast<uint8>(task.job), &stats);
+        const Expected &want = expected[task.job];
+        const std::uint64_t worst = (stats.xWorst.ulEnd - stats.xWorst.ulRelease) & 0xFFFFFFFFUL;
+        unsigned long histogramSum = 0;
+        bool histogramOk = true;
+        for (unsigned i = 0; i < JOB_MONITOR_HISTOGRAM_SIZE; ++i)
+        {
+            histogramSum += stats.ausJitterHistogram[i];
+            histogramOk = histogramOk && (stats.ausJitterHistogram[i] == want.histogram[i]);
+        }
+
+        const bool ok = (stats.ulJobs == want.jobs) && (stats.ulMisses == want.misses) && (stats.ulJitterMax == want.jitterMax) &&
+                        ((want.jobs == 0) || (worst == want.responseMax)) && histogramOk && (histogramSum == want.jobs);
+        std::cout << "  " << std::left << std::setw(18) << task.name << std::right << " jobs " << std::setw(5) << stats.ulJobs
+                  << "  misses " << std::setw(5) << stats.ulMisses << "  jitter max " << std::setw(7) << stats.ulJitterMax / kCyclesPerUs
+                  << " us  response max " << std::setw(8) << worst / kCyclesPerUs << " us" << (ok ? "" : "  MISMATCH") << "\n";
+        if (!ok)
+        {
+            std::cerr << "  expected jobs " << want.jobs << " misses " << want.misses << " jitter max " << want.jitterMax
+                      << " response max " << want.responseMax << "\n";
+            ++errors;
+        }
+        totalMisses += want.misses;
+    }
+    return errors;
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+    std::vector<double> factors = { 0.25, 1.0, 1.5 };
+    double seconds = 60.0;
+    std::uint32_t seed = 1U;
+    std::string path;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        if (arg == "-f" && i + 1 < argc)
+        {
+            factors.clear();
+            std::stringstream list(argv[++i]);
+            std::string factor;
+            while (std::getline(list, factor, ','))
+            {
+                factors.push_back(std::strtod(factor.c_str(), nullptr));
+            }
+        }
+        else if (arg == "-d" && i + 1 < argc)
+        {
+            seconds = std::strtod(argv[++i], nullptr);
+        }
+        else if (arg == "-r" && i + 1 < argc)
+        {
+            seed = static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else if (path.empty() && arg[0] != '-')
+        {
+            path = arg;
+        }
+        else
+        {
+            path.clear();
+            break;
+        }
+    }
+    if (path.empty() || factors.empty() || (seconds <= 0.0) ||
+        std::any_of(factors.begin(), factors.end(), [](double factor) { return factor <= 0.0; }))
+    {
+        std::cerr << "usage: deadline_test [-f factors] [-d seconds] [-r seed] task_table.csv\n";
+        return 1;
+    }
+
+    std::vector<Task> tasks;
+    if (!readTaskTable(path, tasks))
+    {
+        return 1;
+    }
+    std::sort(factors.begin(), factors.end());
+
+    std::mt19937 random(seed);
+    const std::uint64_t duration = static_cast<std::uint64_t>(seconds * 1000.0) * kCyclesPerMs;
+    int errors = 0;
+    std::vector<unsigned long> misses(factors.size(), 0);
+    for (std::size_t i = 0; i < factors.size(); ++i)
+    {
+        errors += simulate(tasks, factors[i], duration, random, misses[i]);
+    }
+
+    if (misses.front() != 0)
+    {
+        std::cerr << "deadline_test: " << misses.front() << " misses at the smallest factor " << factors.front() << "\n";
+        ++errors;
+    }
+    if ((factors.size() > 1) && (misses.back() == 0))
+    {
+        std::cerr << "deadline_test: no miss at the largest factor " << factors.back() << "\n";
+        ++errors;
+    }
+    std::cout << errors << " errors\n";
+    return (errors == 0) ? 0 : 2;
+}
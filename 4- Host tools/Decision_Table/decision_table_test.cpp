@@ -0,0 +1,235 @@
+/*
+ ============================================================================
+ Name        : decision_table_test.cpp
+ Module Name : Decision Table Test
+ Description : Exhaustive host check of the heater decision table (firmware Control/Settings.c,
+               looked up by prvHeaterState of main.c) against the if/else threshold ladder the
+               heater tasks of main.c used before it. The table is built by the firmware
+               Settings module, and the lookup is the one of prvHeaterState:
+               - the default thresholds with no hysteresis, for every heating level, error
+                 flag, desired and current temperature (0 to 255) and current heater state:
+                 the table must give the state of the ladder;
+               - every valid threshold triple (0 < low < medium < high <= SETTINGS_MAX_DIFF)
+                 with no hysteresis, for desired and current temperatures of 0 to 63;
+               - the default thresholds with every hysteresis up to SETTINGS_MAX_HYSTERESIS,
+                 against the ladder with the step down rule of Settings.h: step up as the
+                 ladder does, step down only to the state of the difference plus the
+                 hysteresis.
+               The EEPROM driver is replaced by a stub that holds no settings, so
+               Settings_Init builds the tables from the defaults of main.c (copied here).
+
+ Build       : FW="../../1- Application project/FreeRTOS_Final_Project_WS/Seat_Heater_Control_System"
+               INC=(-I"$FW/Common" -I"$FW/Control" -I"$FW/MCAL/EEPROM")
+               gcc -O2 "${INC[@]}" -c "$FW/Control/Settings.c"
+               g++ -std=c++17 -O2 "${INC[@]}" -o decision_table_test decision_table_test.cpp Settings.o
+ Usage       : decision_table_test
+
+ Exit status : 0 when the table matches the ladder everywhere, 2 otherwise.
+ ============================================================================
+ */
+
+#include <cstdint>
+#include <iostream>
+
+extern "C"
+{
+#include "Std_Types.h"
+#include "Settings.h"
+#include "eeprom.h"
+}
+
+namespace
+{
+
+/* Heater states and heating level of main.c */
+constexpr std::uint8_t kStateOff = 0U;
+constexpr std::uint8_t kStateLow = 1U;
+constexpr std::uint8_t kStateMedium = 2U;
+constexpr std::uint8_t kStateHigh = 3U;
+constexpr std::uint8_t kLevelOff = 0U;
+
+/* Defaults of main.c (xDefaultSeatSettings) */
+const Settings_SeatType kDefaults = { { 0U, 25U, 30U, 35U }, { 2U, 5U, 10U }, 1U };
+
+/* prvHeaterState of main.c */
+std::uint8_t tableState(std::uint8_t seat, std::uint8_t level, std::uint8_t errorFlag, std::uint8_t desired, std::uint8_t temperature,
+                        std::uint8_t state)
+{
+    const std::uint8_t enabled = ((level != kLevelOff) && (errorFlag == FALSE)) ? 1U : 0U;
+    const std::uint8_t diff = static_cast<std::uint8_t>(desired - temperature);
+    std::uint8_t column;
+
+    column = (diff > SETTINGS_MAX_DIFF) ? static_cast<std::uint8_t>(SETTINGS_MAX_DIFF) : diff;
+    column = ((enabled == 0U) || (temperature > desired)) ? static_cast<std::uint8_t>(SETTINGS_OFF_COLUMN) : column;
+
+    return SETTINGS_NEXT_HEATER_STATE(seat, state, column);
+}
+
+/* The threshold ladder of the heater tasks of main.c, as it was before the decision table */
+std::uint8_t ladderState(const std::uint8_t threshold[3], std::uint8_t level, std::uint8_t errorFlag, std::uint8_t desired,
+                         std::uint8_t temperature, std::uint8_t state)
+{
+    if ((level != kLevelOff) && (errorFlag == FALSE))
+    {
+        if (desired >= temperature)
+        {
+            const std::uint8_t diff = desired - temperature;
+
+            if ((diff >= threshold[0]) && (diff < threshold[1]))
+            {
+                state = kStateLow;
+            }
+            else if ((diff >= threshold[1]) && (diff < threshold[2]))
+            {
+                state = kStateMedium;
+            }
+            else if (diff >= threshold[2])
+            {
+                state = kStateHigh;
+            }
+        }
+        else
+        {
+            state = kStateOff;
+        }
+    }
+    else
+    {
+        state = kStateOff;
+    }
+    return state;
+}
+
+/* The ladder with the hysteresis of Settings.h: a lower state only when the difference plus the hysteresis gives it */
+std::uint8_t hysteresisState(const std::uint8_t threshold[3], std::uint8_t hysteresis, std::uint8_t level, std::uint8_t errorFlag,
+                             std::uint8_t desired, std::uint8_t temperature, std::uint8_t state)
+{
+    const std::uint8_t next = ladderState(threshold, level, errorFlag, desired, temperature, state);
+
+    if ((next >= state) || (next == kStateOff))
+    {
+        return next;
+    }
+    const unsigned diff = static_cast<unsigned>(desired - temperature) + hysteresis;
+    const std::uint8_t down = (diff >= threshold[2]) ? kStateHigh : ((diff >= threshold[1]) ? kStateMedium : kStateLow);
+    return (down < state) ? down : state;
+}
+
+/* Compares every input combination of the given temperature range, returns the mismatches */
+unsigned long compare(const char *name, const Settings_SeatType &seat, unsigned maxTemperature, unsigned long &cases)
+{
+    unsigned long mismatches = 0;
+
+    if (Settings_Apply(SETTINGS_SEAT_DRIVER, &seat) != E_OK)
+    {
+        std::cerr << name << ": the settings are not valid\n";
+        return 1;
+    }
+    for (unsigned level = 0; level < SETTINGS_NUMBER_OF_LEVELS; level++)
+    {
+        for (unsigned errorFlag = 0; errorFlag <= 1U; errorFlag++)
+        {
+            for (unsigned desired = 0; desired <= maxTemperature; desired++)
+            {
+                for (unsigned temperature = 0; temperature <= maxTemperature; temperature++)
+                {
+                    for (unsigned state = 0; state < SETTINGS_NUMBER_OF_STATES; state++)
+                    {
+                        const std::uint8_t l = static_cast<std::uint8_t>(level);
+                        const std::uint8_t e = static_cast<std::uint8_t>(errorFlag);
+                        const std::uint8_t d = static_cast<std::uint8_t>(desired);
+                        const std::uint8_t t = static_cast<std::uint8_t>(temperature);
+                        const std::uint8_t s = static_cast<std::uint8_t>(state);
+                        const std::uint8_t got = tableState(SETTINGS_SEAT_DRIVER, l, e, d, t, s);
+                        const std::uint8_t want = (seat.ucHysteresis == 0U) ? ladderState(seat.aucThreshold, l, e, d, t, s)
+                                                                            : hysteresisState(seat.aucThreshold, seat.ucHysteresis, l, e, d, t, s);
+                        cases++;
+                        if (got != want)
+                        {
+                            if (mismatches++ < 5U)
+                            {
+                                std::cerr << name << ": level " << level << ", error " << errorFlag << ", desired " << desired
+                                          << ", temperature " << temperature << ", state " << state << ": table " << static_cast<int>(got)
+                                          << ", expected " << static_cast<int>(want) << "\n";
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+    return mismatches;
+}
+
+} /* namespace */
+
+/* EEPROM stub holding no settings */
+extern "C" Std_ReturnType EEPROM_Read(uint16 address, uint32 *data, uint16 count)
+{
+    (void) address;
+    (void) data;
+    (void) count;
+    return E_NOT_OK;
+}
+
+extern "C" Std_ReturnType EEPROM_Write(uint16 address, const uint32 *data, uint16 count)
+{
+    (void) address;
+    (void) data;
+    (void) count;
+    return E_NOT_OK;
+}
+
+int main()
+{
+    unsigned long mismatches = 0;
+    unsigned long cases = 0;
+    unsigned long triples = 0;
+
+    if (Settings_Init(&kDefaults) == E_OK)
+    {
+        std::cerr << "Settings_Init loaded settings from the EEPROM stub\n";
+        return 2;
+    }
+
+    /* The defaults as the ladder had them, without hysteresis */
+    Settings_SeatType seat = kDefaults;
+    seat.ucHysteresis = 0U;
+    mismatches += compare("Default thresholds", seat, 255U, cases);
+    std::cout << "Default thresholds, no hysteresis: " << cases << " combinations, " << mismatches << " mismatches\n";
+
+    /* Every valid threshold triple */
+    const unsigned long before = mismatches;
+    cases = 0;
+    for (unsigned low = 1; low <= SETTINGS_MAX_DIFF; low++)
+    {
+        for (unsigned medium = low + 1U; medium <= SETTINGS_MAX_DIFF; medium++)
+        {
+            for (unsigned high = medium + 1U; high <= SETTINGS_MAX_DIFF; high++)
+            {
+                seat.aucThreshold[0] = static_cast<uint8>(low);
+                seat.aucThreshold[1] = static_cast<uint8>(medium);
+                seat.aucThreshold[2] = static_cast<uint8>(high);
+                mismatches += compare("Thresholds", seat, 63U, cases);
+                triples++;
+            }
+        }
+    }
+    std::cout << "All " << triples << " threshold triples, no hysteresis: " << cases << " combinations, " << mismatches - before
+              << " mismatches\n";
+
+    /* The hysteresis on the default thresholds */
+    for (unsigned hysteresis = 1; hysteresis <= SETTINGS_MAX_HYSTERESIS; hysteresis++)
+    {
+        const unsigned long start = mismatches;
+        seat = kDefaults;
+        seat.ucHysteresis = static_cast<uint8>(hysteresis);
+        cases = 0;
+        mismatches += compare("Hysteresis", seat, 255U, cases);
+        std::cout << "Default thresholds, hysteresis " << hysteresis << ": " << cases << " combinations, " << mismatches - start
+                  << " mismatches\n";
+    }
+
+    std::cout << ((mismatches == 0U) ? "PASS" : "FAIL") << "\n";
+    return (mismatches == 0U) ? 0 : 2;
+}
@@ -0,0 +1,444 @@
+/*
+ ============================================================================
+ Name        : diag_log_stress.cpp
+ Module Name : Diagnostic Log Stress Test
+ Description : Multi-threaded host stress test of the lock-free circular log of the diagnostic
+               failures (firmware Control/DiagLog.c, built with the GCC atomic builtins).
+               Producer threads append entries at the same time while reader threads take
+               snapshots and read single entries. Every entry is built from its producer and
+               its index, so a torn entry (words of two different appends) is recognised.
+               - Below capacity: every round sets up a log and the producers append as many
+                 entries as it holds between them. Afterwards every sequence number from the
+                 first one must read back, each entry exactly once, under the sequence number
+                 its append returned, and in the order each producer appended.
+               - Overwrite: the producers append many times the capacity of a log of
+                 mainDIAGNOSTIC_SIZE entries (copied from main.c). Afterwards the last entries
+                 must all read back but for the sequence numbers skipped by a producer that
+                 found its slot still taken.
+               In both phases, no reader may get a torn entry, an entry under another sequence
+               number, or a snapshot that is not in increasing sequence order.
+
+ Build       : FW="../../1- Application project/FreeRTOS_Final_Project_WS/Seat_Heater_Control_System"
+               INC=(-I"$FW/Common" -I"$FW/Control")
+               gcc -O2 "${INC[@]}" -c "$FW/Control/DiagLog.c"
+               g++ -std=c++17 -O2 -pthread "${INC[@]}" -o diag_log_stress diag_log_stress.cpp DiagLog.o
+ Usage       : diag_log_stress [options]
+               -p <threads>      Producer threads, default 4.
+               -r <threads>      Reader threads, default 2.
+               -c <capacity>     Capacity of the below capacity log, a power of two, default 1024.
+               -n <rounds>       Rounds below capacity, default 500.
+               -a <appends>      Appends per producer in the overwrite phase, default 1000000.
+
+ Exit status : 0 when no entry is lost or torn, 2 otherwise, 1 on input errors.
+ ============================================================================
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+extern "C"
+{
+#include "Std_Types.h"
+#include "DiagLog.h"
+}
+
+namespace
+{
+
+/* mainDIAGNOSTIC_SIZE of main.c */
+constexpr std::uint32_t kFirmwareCapacity = 16U;
+
+/* Observations a reader keeps to check their sequence numbers after the round */
+constexpr std::size_t kMaxObservations = 1U << 20;
+
+struct Options
+{
+    unsigned producers = 4;
+    unsigned readers = 2;
+    std::uint32_t capacity = 1024;
+    unsigned long rounds = 500;
+    unsigned long appends = 1000000;
+};
+
+bool parseOptions(int argc, char *argv[], Options &options)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        if ((i + 1) >= argc)
+        {
+            return false;
+        }
+        const unsigned long value = std::strtoul(argv[i + 1], nullptr, 10);
+        if (std::strcmp(argv[i], "-p") == 0)
+        {
+            options.producers = static_cast<unsigned>(value);
+        }
+        else if (std::strcmp(argv[i], "-r") == 0)
+        {
+            options.readers = static_cast<unsigned>(value);
+        }
+        else if (std::strcmp(argv[i], "-c") == 0)
+        {
+            options.capacity = static_cast<std::uint32_t>(value);
+        }
+        else if (std::strcmp(argv[i], "-n") == 0)
+        {
+            options.rounds = value;
+        }
+        else if (std::strcmp(argv[i], "-a") == 0)
+        {
+            options.appends = value;
+        }
+        else
+        {
+            return false;
+        }
+        i++;
+    }
+    return (options.producers > 0U) && (options.producers < 256U) && (options.capacity >= options.producers) &&
+           ((options.capacity & (options.capacity - 1U)) == 0U) && (options.appends < (1UL << 24));
+}
+
+/* The entry of a producer and index, every field depends on both */
+DiagLog_EntryType makeEntry(unsigned producer, unsigned long index)
+{
+    DiagLog_EntryType entry;
+    entry.ulTimeStamp = (static_cast<uint32>(producer) << 24) | static_cast<uint32>(index);
+    entry.ucFailureCode = static_cast<uint8>(index);
+    entry.ucFailureSeat = static_cast<uint8>(producer);
+    entry.ucHeatingLevel = static_cast<uint8>((index >> 8) ^ (producer * 37U));
+    return entry;
+}
+
+/* Producer and index of an entry, false when its fields do not come from the same append */
+bool decodeEntry(const DiagLog_EntryType &entry, unsigned &producer, unsigned long &index)
+{
+    producer = static_cast<unsigned>((entry.ulTimeStamp >> 24) & 0xFFU);
+    index = static_cast<unsigned long>(entry.ulTimeStamp & 0xFFFFFFU);
+    const DiagLog_EntryType expected = makeEntry(producer, index);
+    return (expected.ucFailureCode == entry.ucFailureCode) && (expected.ucFailureSeat == entry.ucFailureSeat) &&
+           (expected.ucHeatingLevel == entry.ucHeatingLevel);
+}
+
+struct Observation
+{
+    std::uint32_t sequence;
+    unsigned producer;
+    unsigned long index;
+};
+
+/* One round: producers and readers on a log, then the checks of the readers */
+class Round
+{
+public:
+    Round(DiagLog_Type &log, std::uint32_t capacity, unsigned producers, unsigned long perProducer)
+        : log_(log), capacity_(capacity), sequences_(producers, std::vector<std::uint32_t>(perProducer, 0U))
+    {
+    }
+
+    void run(unsigned readers)
+    {
+        std::vector<std::thread> threads;
+        std::atomic<unsigned> started { 0 };
+        const unsigned total = static_cast<unsigned>(sequences_.size()) + readers;
+
+        for (unsigned p = 0; p < sequences_.size(); p++)
+        {
+            threads.emplace_back([this, p, &started, total] {
+                started++;
+                while (started.load() < total)
+                {
+                }
+                produce(p);
+            });
+        }
+        for (unsigned r = 0; r < readers; r++)
+        {
+            threads.emplace_back([this, r, &started, total] {
+                started++;
+                while (started.load() < total)
+                {
+                }
+                read(r);
+            });
+        }
+        for (unsigned p = 0; p < sequences_.size(); p++)
+        {
+            threads[p].join();
+        }
+        done_.store(true);
+        for (unsigned i = static_cast<unsigned>(sequences_.size()); i < threads.size(); i++)
+        {
+            threads[i].join();
+        }
+
+        /* Every entry a reader got must be the one appended under its sequence number */
+        for (const Observation &observation : observations_)
+        {
+            if (sequences_[observation.producer][observation.index] != observation.sequence)
+            {
+                fail("entry read under sequence number " + std::to_string(observation.sequence) + ", appended under " +
+                     std::to_string(sequences_[observation.producer][observation.index]));
+            }
+        }
+    }
+
+    const std::vector<std::vector<std::uint32_t>> &sequences() const
+    {
+        return sequences_;
+    }
+
+    unsigned long readerRecords() const
+    {
+        return records_.load();
+    }
+
+    void fail(const std::string &message)
+    {
+        std::lock_guard<std::mutex> lock(failMutex_);
+        if (failures_++ < 10U)
+        {
+            std::cerr << "  " << message << "\n";
+        }
+    }
+
+    unsigned long failures() const
+    {
+        return failures_;
+    }
+
+private:
+    void produce(unsigned producer)
+    {
+        std::vector<std::uint32_t> &sequences = sequences_[producer];
+
+        for (unsigned long i = 0; i < sequences.size(); i++)
+        {
+            const DiagLog_EntryType entry = makeEntry(producer, i);
+            sequences[i] = DiagLog_Append(&log_, &entry);
+        }
+    }
+
+    bool check(std::uint32_t sequence, const DiagLog_EntryType &entry, std::vector<Observation> &observations)
+    {
+        unsigned producer;
+        unsigned long index;
+
+        if (!decodeEntry(entry, producer, index) || (producer >= sequences_.size()) || (index >= sequences_[producer].size()))
+        {
+            fail("torn entry under sequence number " + std::to_string(sequence));
+            return false;
+        }
+        if (observations.size() < kMaxObservations)
+        {
+            observations.push_back({ sequence, producer, index });
+        }
+        return true;
+    }
+
+    void read(unsigned reader)
+    {
+        std::vector<DiagLog_RecordType> records(capacity_);
+        std::vector<Observation> observations;
+        unsigned long count = 0;
+        std::uint32_t probe = reader;
+
+        while (!done_.load())
+        {
+            const std::uint32_t taken = DiagLog_Snapshot(&log_, records.data(), capacity_);
+            for (std::uint32_t i = 0; i < taken; i++)
+            {
+                if ((i > 0U) && (records[i].ulSequence <= records[i - 1U].ulSequence))
+                {
+                    fail("snapshot out of order: " + std::to_string(records[i - 1U].ulSequence) + " then " +
+                         std::to_string(records[i].ulSequence));
+                }
+                check(static_cast<std::uint32_t>(records[i].ulSequence), records[i].xEntry, observations);
+            }
+            count += taken;
+
+            /* Single reads of the slots the producers are writing */
+            const std::uint32_t head = static_cast<std::uint32_t>(DiagLog_Head(&log_));
+            for (unsigned i = 0; i < 8U; i++)
+            {
+                const std::uint32_t sequence = head - (probe++ % capacity_) - 1U;
+                DiagLog_EntryType entry;
+                if ((sequence >= DIAG_LOG_FIRST_SEQUENCE) && (sequence < head) && (DiagLog_Read(&log_, sequence, &entry) == E_OK))
+                {
+                    check(sequence, entry, observations);
+                    count++;
+                }
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(failMutex_);
+        observations_.insert(observations_.end(), observations.begin(), observations.end());
+        records_ += count;
+    }
+
+    DiagLog_Type &log_;
+    std::uint32_t capacity_;
+    std::vector<std::vector<std::uint32_t>> sequences_;
+    std::vector<Observation> observations_;
+    std::atomic<bool> done_ { false };
+    std::atomic<unsigned long> records_ { 0 };
+    std::mutex failMutex_;
+    unsigned long failures_ = 0;
+};
+
+/* Below capacity: nothing may be lost */
+unsigned long belowCapacity(const Options &options, unsigned long &readerRecords)
+{
+    std::vector<DiagLog_SlotType> slots(options.capacity);
+    DiagLog_Type log;
+    unsigned long failures = 0;
+    const unsigned long perProducer = options.capacity / options.producers;
+    const std::uint32_t total = static_cast<std::uint32_t>(perProducer * options.producers);
+
+    for (unsigned long round = 0; round < options.rounds; round++)
+    {
+        if (DiagLog_Init(&log, slots.data(), options.capacity) != E_OK)
+        {
+            std::cerr << "  DiagLog_Init rejected a capacity of " << options.capacity << "\n";
+            return failures + 1U;
+        }
+
+        Round run(log, options.capacity, options.producers, perProducer);
+        run.run(options.readers);
+        readerRecords += run.readerRecords();
+
+        if (DiagLog_Head(&log) != (DIAG_LOG_FIRST_SEQUENCE + total))
+        {
+            run.fail("head " + std::to_string(DiagLog_Head(&log)) + " after " + std::to_string(total) + " appends");
+        }
+
+        /* Every sequence number reads back the entry appended under it, each entry once */
+        std::vector<std::vector<bool>> seen(options.producers, std::vector<bool>(perProducer, false));
+        for (std::uint32_t sequence = DIAG_LOG_FIRST_SEQUENCE; sequence < (DIAG_LOG_FIRST_SEQUENCE + total); sequence++)
+        {
+            DiagLog_EntryType entry;
+            unsigned producer;
+            unsigned long index;
+
+            if (DiagLog_Read(&log, sequence, &entry) != E_OK)
+            {
+                run.fail("entry " + std::to_string(sequence) + " lost");
+            }
+            else if (!decodeEntry(entry, producer, index) || (producer >= options.producers) || (index >= perProducer))
+            {
+                run.fail("entry " + std::to_string(sequence) + " torn");
+            }
+            else if (seen[producer][index] || (run.sequences()[producer][index] != sequence))
+            {
+                run.fail("entry " + std::to_string(sequence) + " duplicated or under another sequence number");
+            }
+            else
+            {
+                seen[producer][index] = true;
+            }
+        }
+
+        /* Each producer got increasing sequence numbers */
+        for (const auto &sequences : run.sequences())
+        {
+            if (!std::is_sorted(sequences.begin(), sequences.end()) ||
+                (std::adjacent_find(sequences.begin(), sequences.end()) != sequences.end()))
+            {
+                run.fail("a producer got sequence numbers out of order");
+            }
+        }
+
+        if (run.failures() != 0U)
+        {
+            std::cerr << "  round " << round << " failed\n";
+        }
+        failures += run.failures();
+    }
+    return failures;
+}
+
+/* Overwrite: the log of the firmware size wraps many times */
+unsigned long overwrite(const Options &options, unsigned long &readerRecords, std::uint32_t &skipped)
+{
+    std::vector<DiagLog_SlotType> slots(kFirmwareCapacity);
+    DiagLog_Type log;
+
+    DiagLog_Init(&log, slots.data(), kFirmwareCapacity);
+    Round run(log, kFirmwareCapacity, options.producers, options.appends);
+    run.run(options.readers);
+    readerRecords += run.readerRecords();
+
+    /* Sequence numbers taken but not used, because their slot was still taken */
+    const std::uint32_t appended = static_cast<std::uint32_t>(options.producers * options.appends);
+    const std::uint32_t head = static_cast<std::uint32_t>(DiagLog_Head(&log));
+    skipped = head - DIAG_LOG_FIRST_SEQUENCE - appended;
+
+    std::vector<bool> used(head, false);
+    for (const auto &sequences : run.sequences())
+    {
+        for (std::uint32_t sequence : sequences)
+        {
+            if ((sequence < DIAG_LOG_FIRST_SEQUENCE) || (sequence >= head) || used[sequence])
+            {
+                run.fail("sequence number " + std::to_string(sequence) + " returned twice or out of range");
+                continue;
+            }
+            used[sequence] = true;
+        }
+    }
+
+    /* The last capacity of sequence numbers read back unless they were skipped */
+    for (std::uint32_t sequence = head - kFirmwareCapacity; sequence < head; sequence++)
+    {
+        DiagLog_EntryType entry;
+        unsigned producer;
+        unsigned long index;
+        const bool read = (DiagLog_Read(&log, sequence, &entry) == E_OK);
+
+        if (read != used[sequence])
+        {
+            run.fail("entry " + std::to_string(sequence) + (read ? " read back but never appended" : " lost"));
+        }
+        else if (read && (!decodeEntry(entry, producer, index) || (run.sequences()[producer][index] != sequence)))
+        {
+            run.fail("entry " + std::to_string(sequence) + " torn or under another sequence number");
+        }
+    }
+    return run.failures();
+}
+
+} /* namespace */
+
+int main(int argc, char *argv[])
+{
+    Options options;
+
+    if (!parseOptions(argc, argv, options))
+    {
+        std::cerr << "Usage: diag_log_stress [-p producers] [-r readers] [-c capacity] [-n rounds] [-a appends]\n";
+        return 1;
+    }
+
+    unsigned long readerRecords = 0;
+    unsigned long failures = belowCapacity(options, readerRecords);
+    std::cout << "Below capacity: " << options.rounds << " rounds of " << options.producers << " producers filling " << options.capacity
+              << " entries, " << options.readers << " readers, " << readerRecords << " records read, " << failures << " failures\n";
+
+    std::uint32_t skipped = 0;
+    readerRecords = 0;
+    const unsigned long overwriteFailures = overwrite(options, readerRecords, skipped);
+    std::cout << "Overwrite: " << options.producers * options.appends << " appends into " << kFirmwareCapacity << " entries, "
+              << readerRecords << " records read, " << skipped << " sequence numbers skipped, " << overwriteFailures << " failures\n";
+    failures += overwriteFailures;
+
+    std::cout << ((failures == 0U) ? "PASS" : "FAIL") << "\n";
+    return (failures == 0U) ? 0 : 2;
+}
@@ -0,0 +1,399 @@
+/*
+ ============================================================================
+ Name        : dtc_flapping_test.cpp
+ Module Name : Trouble Code Flapping Test
+ Description : Host replay of flapping sensor fault traces through the firmware trouble code
+               manager (Control/Dtc.c) and diagnostic log (Control/DiagLog.c), wired as main.c
+               wires them: every 100 ms sample out of the valid range while the seat has no
+               error flag reports a failure with a freeze frame, and appends it to the log
+               when the trouble code is new; the first sample back in range reports both
+               codes of the seat passed; every 5 s the fault store task ends an aging cycle.
+               The traces:
+               - chatter: the reading flips between valid and over range every sample;
+               - intermittent: random fault bursts and gaps on both seats;
+               - range swap: over and under range without a valid sample in between;
+               - slow flap: gaps of one cycle less, exactly, and one cycle more than the
+                 aging of the trouble codes;
+               - stuck: a failure present for hours, then healed.
+               After every sample the records of Dtc_Read must match a reference model of
+               the behaviour documented in Dtc.h (first and last timestamps, occurrences
+               saturating at DTC_MAX_OCCURRENCES, first freeze frame, status and aging), and
+               the diagnostic log must hold one entry per new trouble code only. The older
+               entries of the log must survive the chatter trace.
+
+ Build       : FW="../../1- Application project/FreeRTOS_Final_Project_WS/Seat_Heater_Control_System"
+               INC=(-I"$FW/Common" -I"$FW/Control")
+               gcc -O2 "${INC[@]}" -c "$FW/Control/Dtc.c" "$FW/Control/DiagLog.c"
+               g++ -std=c++17 -O2 "${INC[@]}" -o dtc_flapping_test dtc_flapping_test.cpp Dtc.o DiagLog.o
+ Usage       : dtc_flapping_test [-s seed]
+
+ Exit status : 0 when every trace matches the model, 2 otherwise, 1 on input errors.
+ ============================================================================
+ */
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+
+extern "C"
+{
+#include "Std_Types.h"
+#include "Dtc.h"
+#include "DiagLog.h"
+}
+
+namespace
+{
+
+/* Configuration of main.c */
+constexpr unsigned kMaxValid = 40U; /* mainTEMP_MAX_VALID_RANGE */
+constexpr unsigned kMinValid = 5U; /* mainTEMP_MIN_VALID_RANGE */
+constexpr std::uint32_t kSampleMs = 100U; /* mainSENSOR_TASK_DELAY */
+constexpr std::uint32_t kAgingMs = 5000U; /* mainFAULT_STORE_TASK_DELAY */
+constexpr unsigned kAgingCycles = 120U; /* mainDTC_AGING_CYCLES */
+constexpr std::uint32_t kLogSize = 16U; /* mainDIAGNOSTIC_SIZE */
+constexpr unsigned kSamplesPerCycle = kAgingMs / kSampleMs;
+
+/* Entries appended before every trace, as older history */
+constexpr unsigned kHistory = 8U;
+
+/* Reference record of one trouble code, from the behaviour documented in Dtc.h */
+struct Model
+{
+    bool stored = false;
+    bool failed = false;
+    std::uint32_t first = 0;
+    std::uint32_t last = 0;
+    unsigned occurrences = 0;
+    unsigned aging = 0;
+    Dtc_FreezeFrameType freezeFrame = {};
+};
+
+class Bench
+{
+public:
+    explicit Bench(const std::string &name) : name_(name)
+    {
+        Dtc_Init(static_cast<uint8>(kAgingCycles));
+        DiagLog_Init(&log_, slots_, kLogSize);
+        for (unsigned i = 0; i < kHistory; i++)
+        {
+            const DiagLog_EntryType entry = { i, 0U, 0xFFU, 0U };
+            DiagLog_Append(&log_, &entry);
+        }
+    }
+
+    /* One sample of both seats, then the aging cycle when the fault store task runs */
+    void sample(const unsigned temperature[DTC_NUMBER_OF_SEATS])
+    {
+        now_ += kSampleMs;
+        samples_++;
+        for (unsigned seat = 0; seat < DTC_NUMBER_OF_SEATS; seat++)
+        {
+            sensor(seat, temperature[seat]);
+        }
+        if ((samples_ % kSamplesPerCycle) == 0U)
+        {
+            Dtc_Age();
+            age();
+        }
+        compare();
+    }
+
+    bool finish()
+    {
+        /* The older history is still in the log unless the trace logged more than the rest of it */
+        if (logged_ <= (kLogSize - kHistory))
+        {
+            for (unsigned i = 0; i < kHistory; i++)
+            {
+                DiagLog_EntryType entry;
+                if ((DiagLog_Read(&log_, DIAG_LOG_FIRST_SEQUENCE + i, &entry) != E_OK) || (entry.ulTimeStamp != i))
+                {
+                    fail() << "history entry " << i << " was overwritten\n";
+                }
+            }
+        }
+        std::cout << name_ << ": " << samples_ << " samples, " << failures_ << " failures reported, " << logged_ << " logged, "
+                  << clears_ << " cleared by aging, " << (mismatches_ == 0U ? "ok" : "MISMATCH") << "\n";
+        return mismatches_ == 0U;
+    }
+
+    const Model &model(unsigned seat, unsigned code) const
+    {
+        return model_[seat][code];
+    }
+
+    unsigned long logged() const
+    {
+        return logged_;
+    }
+
+    std::ostream &fail()
+    {
+        static std::ostream null(nullptr);
+        return (mismatches_++ < 10U) ? (std::cerr << "  " << name_ << " at " << now_ << " ms: ") : null;
+    }
+
+private:
+    /* The sensor processing and diagnostic task of main.c */
+    void sensor(unsigned seat, unsigned temperature)
+    {
+        if ((temperature > kMaxValid) || (temperature < kMinValid))
+        {
+            if (!errorFlag_[seat])
+            {
+                const unsigned code = (temperature > kMaxValid) ? DTC_CODE_OVER_RANGE : DTC_CODE_UNDER_RANGE;
+                const DiagLog_EntryType entry = { now_, static_cast<uint8>(code == DTC_CODE_OVER_RANGE ? 0x44U : 0x55U),
+                                                  static_cast<uint8>(seat), static_cast<uint8>(samples_ % 4U) };
+                const Dtc_FreezeFrameType freezeFrame = { static_cast<uint8>(temperature), entry.ucHeatingLevel,
+                                                          static_cast<uint8>((samples_ / 3U) % 4U), static_cast<uint8>(samples_ % 101U) };
+
+                if (Dtc_ReportFailed(static_cast<uint8>(seat), static_cast<uint8>(code), now_, &freezeFrame) == TRUE)
+                {
+                    DiagLog_Append(&log_, &entry);
+                }
+                failed(seat, code, freezeFrame);
+                errorFlag_[seat] = true;
+                failures_++;
+            }
+        }
+        else if (errorFlag_[seat])
+        {
+            errorFlag_[seat] = false;
+            Dtc_ReportPassed(static_cast<uint8>(seat), DTC_CODE_OVER_RANGE);
+            Dtc_ReportPassed(static_cast<uint8>(seat), DTC_CODE_UNDER_RANGE);
+            model_[seat][DTC_CODE_OVER_RANGE].failed = false;
+            model_[seat][DTC_CODE_UNDER_RANGE].failed = false;
+        }
+    }
+
+    void failed(unsigned seat, unsigned code, const Dtc_FreezeFrameType &freezeFrame)
+    {
+        Model &model = model_[seat][code];
+
+        if (!model.stored)
+        {
+            model = Model();
+            model.stored = true;
+            model.first = now_;
+            model.freezeFrame = freezeFrame;
+            logged_++;
+        }
+        if (!model.failed && (model.occurrences < DTC_MAX_OCCURRENCES))
+        {
+            model.occurrences++;
+        }
+        model.failed = true;
+        model.last = now_;
+        model.aging = 0;
+    }
+
+    void age()
+    {
+        for (auto &seat : model_)
+        {
+            for (Model &model : seat)
+            {
+                if (model.stored && !model.failed && (++model.aging >= kAgingCycles))
+                {
+                    model.stored = false;
+                    clears_++;
+                }
+            }
+        }
+    }
+
+    void compare()
+    {
+        const std::uint32_t head = static_cast<std::uint32_t>(DiagLog_Head(&log_));
+
+        if (head != (DIAG_LOG_FIRST_SEQUENCE + kHistory + logged_))
+        {
+            fail() << (head - DIAG_LOG_FIRST_SEQUENCE - kHistory) << " log entries, expected " << logged_ << "\n";
+        }
+        for (unsigned seat = 0; seat < DTC_NUMBER_OF_SEATS; seat++)
+        {
+            for (unsigned code = 0; code < DTC_NUMBER_OF_CODES; code++)
+            {
+                const Model &model = model_[seat][code];
+                Dtc_RecordType record;
+                const bool stored = (Dtc_Read(static_cast<uint8>(seat), static_cast<uint8>(code), &record) == E_OK);
+
+                if (stored != model.stored)
+                {
+                    fail() << "seat " << seat << " code " << code << (stored ? " stored" : " not stored") << "\n";
+                    continue;
+                }
+                if (!stored)
+                {
+                    continue;
+                }
+                const unsigned status = DTC_STATUS_CONFIRMED | (model.failed ? DTC_STATUS_TEST_FAILED : 0U);
+                if ((record.ulFirstTimeStamp != model.first) || (record.ulLastTimeStamp != model.last) ||
+                    (record.usOccurrences != model.occurrences) || (record.ucStatus != status) || (record.ucAgingCounter != model.aging) ||
+                    (std::memcmp(&record.xFreezeFrame, &model.freezeFrame, sizeof(Dtc_FreezeFrameType)) != 0))
+                {
+                    fail() << "seat " << seat << " code " << code << ": first " << record.ulFirstTimeStamp << "/" << model.first << ", last "
+                           << record.ulLastTimeStamp << "/" << model.last << ", occurrences " << record.usOccurrences << "/"
+                           << model.occurrences << ", status " << static_cast<int>(record.ucStatus) << "/" << status << ", aging "
+                           << static_cast<int>(record.ucAgingCounter) << "/" << model.aging << "\n";
+                }
+            }
+        }
+    }
+
+    std::string name_;
+    DiagLog_SlotType slots_[kLogSize];
+    DiagLog_Type log_;
+    Model model_[DTC_NUMBER_OF_SEATS][DTC_NUMBER_OF_CODES];
+    bool errorFlag_[DTC_NUMBER_OF_SEATS] = {};
+    std::uint32_t now_ = 0;
+    unsigned long samples_ = 0;
+    unsigned long failures_ = 0;
+    unsigned long logged_ = 0;
+    unsigned long clears_ = 0;
+    unsigned long mismatches_ = 0;
+};
+
+constexpr unsigned kValid = 25U;
+constexpr unsigned kOver = 45U;
+constexpr unsigned kUnder = 2U;
+
+/* Runs a trace given as the temperatures of both seats at every sample */
+void run(Bench &bench, unsigned long samples, const std::function<void(unsigned long, unsigned *)> &trace)
+{
+    unsigned temperature[DTC_NUMBER_OF_SEATS];
+
+    for (unsigned long i = 0; i < samples; i++)
+    {
+        trace(i, temperature);
+        bench.sample(temperature);
+    }
+}
+
+/* Valid readings for a number of aging cycles */
+void settle(Bench &bench, unsigned cycles)
+{
+    run(bench, static_cast<unsigned long>(cycles) * kSamplesPerCycle, [](unsigned long, unsigned *t) { t[0] = kValid; t[1] = kValid; });
+}
+
+} /* namespace */
+
+int main(int argc, char *argv[])
+{
+    unsigned seed = 1;
+
+    if (argc == 3 && std::strcmp(argv[1], "-s") == 0)
+    {
+        seed = static_cast<unsigned>(std::strtoul(argv[2], nullptr, 10));
+    }
+    else if (argc != 1)
+    {
+        std::cerr << "Usage: dtc_flapping_test [-s seed]\n";
+        return 1;
+    }
+
+    std::mt19937 random(seed);
+    bool pass = true;
+
+    /* Chatter: one log entry, the occurrences saturate and the first freeze frame stays */
+    {
+        Bench bench("Chatter");
+        run(bench, 200000UL, [](unsigned long i, unsigned *t) { t[0] = ((i & 1UL) == 0U) ? kOver : kValid; t[1] = kValid; });
+        if ((bench.logged() != 1U) || (bench.model(0, DTC_CODE_OVER_RANGE).occurrences != DTC_MAX_OCCURRENCES))
+        {
+            bench.fail() << "chatter logged " << bench.logged() << " entries\n";
+        }
+        settle(bench, kAgingCycles);
+        pass = bench.finish() && pass;
+    }
+
+    /* Intermittent: random bursts and gaps on both seats, over and under range */
+    {
+        Bench bench("Intermittent");
+        unsigned long remaining[DTC_NUMBER_OF_SEATS] = {};
+        unsigned current[DTC_NUMBER_OF_SEATS] = { kValid, kValid };
+
+        run(bench, 2000000UL, [&](unsigned long, unsigned *t) {
+            for (unsigned seat = 0; seat < DTC_NUMBER_OF_SEATS; seat++)
+            {
+                if (remaining[seat] == 0U)
+                {
+                    /* Faults of 1 to 30 samples, gaps of 1 sample to a little over the aging time */
+                    const bool fault = (current[seat] == kValid);
+                    current[seat] = fault ? ((random() & 1U) ? kOver : kUnder) : kValid;
+                    remaining[seat] = fault ? std::uniform_int_distribution<unsigned long>(1U, 30U)(random)
+                                            : std::uniform_int_distribution<unsigned long>(1U, (kAgingCycles + 5U) * kSamplesPerCycle)(random);
+                }
+                remaining[seat]--;
+                t[seat] = current[seat];
+            }
+        });
+        settle(bench, kAgingCycles + 1U);
+        pass = bench.finish() && pass;
+    }
+
+    /* Range swap: the flag stays set, so only the first range is reported */
+    {
+        Bench bench("Range swap");
+        run(bench, 10000UL, [](unsigned long i, unsigned *t) { t[0] = ((i / 3U) & 1U) ? kUnder : kOver; t[1] = (i % 7U) ? kUnder : kValid; });
+        if (bench.model(0, DTC_CODE_UNDER_RANGE).stored || !bench.model(0, DTC_CODE_OVER_RANGE).stored)
+        {
+            bench.fail() << "range swap stored the wrong code\n";
+        }
+        settle(bench, kAgingCycles);
+        pass = bench.finish() && pass;
+    }
+
+    /* Slow flap: gaps around the aging time, only the ones of a whole aging time clear the code */
+    {
+        Bench bench("Slow flap");
+        const unsigned long gaps[] = { (kAgingCycles - 1U) * kSamplesPerCycle, kAgingCycles * kSamplesPerCycle,
+                                       (kAgingCycles + 1U) * kSamplesPerCycle, (kAgingCycles - 1U) * kSamplesPerCycle };
+        for (unsigned long gap : gaps)
+        {
+            run(bench, 1U, [](unsigned long, unsigned *t) { t[0] = kOver; t[1] = kValid; });
+            run(bench, gap, [](unsigned long, unsigned *t) { t[0] = kValid; t[1] = kValid; });
+        }
+        run(bench, 1U, [](unsigned long, unsigned *t) { t[0] = kOver; t[1] = kValid; });
+        if (bench.logged() != 3U)
+        {
+            bench.fail() << "slow flap logged " << bench.logged() << " entries, expected 3\n";
+        }
+        settle(bench, kAgingCycles);
+        pass = bench.finish() && pass;
+    }
+
+    /* Stuck: a failure present for 3 hours does not age, then heals */
+    {
+        Bench bench("Stuck");
+        run(bench, 3UL * 3600UL * 1000UL / kSampleMs, [](unsigned long, unsigned *t) { t[0] = kUnder; t[1] = kOver; });
+        if ((bench.model(0, DTC_CODE_UNDER_RANGE).occurrences != 1U) || (bench.model(1, DTC_CODE_OVER_RANGE).occurrences != 1U))
+        {
+            bench.fail() << "a stuck failure counted more than one occurrence\n";
+        }
+        settle(bench, kAgingCycles);
+        pass = bench.finish() && pass;
+    }
+
+    /* Out of range indices */
+    {
+        const Dtc_FreezeFrameType freezeFrame = {};
+        Dtc_RecordType record;
+        if ((Dtc_ReportFailed(DTC_NUMBER_OF_SEATS, 0U, 0U, &freezeFrame) != FALSE) ||
+            (Dtc_ReportFailed(0U, DTC_NUMBER_OF_CODES, 0U, &freezeFrame) != FALSE) ||
+            (Dtc_Read(DTC_NUMBER_OF_SEATS, 0U, &record) != E_NOT_OK) || (Dtc_Read(0U, DTC_NUMBER_OF_CODES, &record) != E_NOT_OK))
+        {
+            std::cerr << "  out of range indices were accepted\n";
+            pass = false;
+        }
+    }
+
+    std::cout << (pass ? "PASS" : "FAIL") << "\n";
+    return pass ? 0 : 2;
+}
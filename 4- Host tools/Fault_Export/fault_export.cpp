@@ -0,0 +1,428 @@
+/*
+ ============================================================================
+ Name        : fault_export.cpp
+ Module Name : Fault Export Decoder
+ Description : Decoder of the binary fault log export (console command "export", firmware
+               Control/FaultExport.c). It finds the "EXPORT," line in a UART capture, decodes
+               the blocks after it and prints one line per record, in the format of the
+               "faults" console command. A block that fails its CRC is reported and skipped,
+               the decoder resynchronizes on the next byte where a block passes its CRC.
+               With -g it builds a synthetic fault log instead, encodes it with the firmware
+               module, decodes it again and checks the round trip, then reports the export
+               size against the 8 byte struct and the "faults" text lines.
+
+ Build       : FW="../../1- Application project/FreeRTOS_Final_Project_WS/Seat_Heater_Control_System"
+               INC=(-I"$FW/Common" -I"$FW/Control")
+               gcc -O2 "${INC[@]}" -c "$FW/Control/FaultExport.c"
+               g++ -std=c++17 -O2 "${INC[@]}" -o fault_export fault_export.cpp FaultExport.o
+ Usage       : fault_export [options] [capture file]
+               capture file      UART capture holding an export, default stdin.
+               -g <records>      Round trip a synthetic log of this many records instead.
+               -c <bytes>        With -g, corrupt this many random bytes of the export, default 0.
+               -o <file>         With -g, also write the synthetic capture to this file.
+               -r <seed>         Random seed, default 1.
+
+ Exit status : 0 when every block decodes (and with -g the records match), 2 otherwise, 1 on input errors.
+ ============================================================================
+ */
+
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+extern "C"
+{
+#include "Std_Types.h"
+#include "FaultExport.h"
+}
+
+namespace
+{
+
+struct Record
+{
+    std::uint32_t sequence;
+    std::uint32_t timeStamp;
+    unsigned seat;
+    unsigned code;
+    unsigned level;
+};
+
+struct Dictionary
+{
+    unsigned seat[2];
+    unsigned code[2];
+};
+
+struct DecodeResult
+{
+    std::vector<Record> records;
+    unsigned long blocks = 0;
+    unsigned long badBlocks = 0;
+    unsigned long bytes = 0;
+    bool ended = false;
+};
+
+bool readVarint(const std::vector<unsigned char> &data, std::size_t &pos, std::uint32_t &value)
+{
+    value = 0;
+    for (unsigned shift = 0; shift < 35U; shift += 7U)
+    {
+        if (pos >= data.size())
+        {
+            return false;
+        }
+        const unsigned char byte = data[pos++];
+        value |= static_cast<std::uint32_t>(byte & 0x7FU) << shift;
+        if ((byte & 0x80U) == 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* Parse the block at pos, false if it is truncated or fails its CRC */
+bool decodeBlock(const std::vector<unsigned char> &data, std::size_t &pos, const Dictionary &dictionary, std::vector<Record> &records)
+{
+    const std::size_t start = pos;
+    const unsigned count = data[pos++];
+    std::uint32_t sequence;
+    std::uint32_t timeStamp;
+    std::vector<Record> block;
+
+    if (count == 0 || count > FAULT_EXPORT_BLOCK_ENTRIES || !readVarint(data, pos, sequence) || !readVarint(data, pos, timeStamp))
+    {
+        return false;
+    }
+    for (unsigned i = 0; i < count; ++i)
+    {
+        if (pos >= data.size())
+        {
+            return false;
+        }
+        const unsigned char entry = data[pos++];
+        std::uint32_t delta = (entry >> FAULT_EXPORT_DELTA_SHIFT) & ((1U << FAULT_EXPORT_DELTA_BITS) - 1U);
+        if (entry & FAULT_EXPORT_MORE_BIT)
+        {
+            std::uint32_t more;
+            if (!readVarint(data, pos, more))
+            {
+                return false;
+            }
+            delta |= more << FAULT_EXPORT_DELTA_BITS;
+        }
+        timeStamp += delta;
+        block.push_back({sequence + i, timeStamp, dictionary.seat[(entry & FAULT_EXPORT_SEAT_BIT) ? 1 : 0],
+                         dictionary.code[(entry & FAULT_EXPORT_CODE_BIT) ? 1 : 0], entry & FAULT_EXPORT_LEVEL_MASK});
+    }
+    if (pos + FAULT_EXPORT_CRC_BYTES > data.size())
+    {
+        return false;
+    }
+
+    std::vector<uint8> bytes(data.begin() + start, data.begin() + pos);
+    const unsigned crc = (static_cast<unsigned>(data[pos]) << 8) | data[pos + 1];
+    pos += FAULT_EXPORT_CRC_BYTES;
+    if (FaultExport_Crc16(bytes.data(), static_cast<uint16>(bytes.size())) != crc)
+    {
+        return false;
+    }
+    records.insert(records.end(), block.begin(), block.end());
+    return true;
+}
+
+/* Decode the export that follows the "EXPORT," line of a capture */
+bool decodeCapture(const std::vector<unsigned char> &capture, DecodeResult &result, std::string &error)
+{
+    const std::string text(capture.begin(), capture.end());
+    const std::size_t line = text.find("EXPORT,");
+    const std::size_t end = (line == std::string::npos) ? std::string::npos : text.find("\r\n", line);
+    if (end == std::string::npos)
+    {
+        error = "no EXPORT line";
+        return false;
+    }
+
+    Dictionary dictionary;
+    unsigned long records;
+    char comma;
+    std::istringstream header(text.substr(line + 7, end - line - 7));
+    if (!(header >> records >> comma >> dictionary.seat[0] >> comma >> dictionary.seat[1] >> comma >> dictionary.code[0] >> comma >>
+          dictionary.code[1]))
+    {
+        error = "bad EXPORT line";
+        return false;
+    }
+
+    const std::vector<unsigned char> data(capture.begin() + static_cast<long>(end + 2), capture.end());
+    std::size_t pos = 0;
+    while (pos < data.size())
+    {
+        if (data[pos] == 0)
+        {
+            result.ended = true;
+            ++pos;
+            break;
+        }
+        std::size_t next = pos;
+        if (decodeBlock(data, next, dictionary, result.records))
+        {
+            ++result.blocks;
+            pos = next;
+        }
+        else
+        {
+            /*
+             * Resynchronize on the next byte where a block passes its CRC, a wrong block start passes it once
+             * in 65536 tries. Without one, the end of the export is the last 0 byte.
+             */
+            ++result.badBlocks;
+            const std::size_t bad = pos;
+            for (++pos; pos < data.size(); ++pos)
+            {
+                next = pos;
+                std::vector<Record> probe;
+                if (decodeBlock(data, next, dictionary, probe))
+                {
+                    break;
+                }
+            }
+            if (pos == data.size())
+            {
+                for (pos = data.size(); pos > bad + 1 && data[pos - 1] != 0; --pos)
+                {
+                }
+                result.ended = (pos > bad + 1);
+                break;
+            }
+        }
+    }
+    result.bytes = static_cast<unsigned long>(end + 2 - line + pos);
+    return true;
+}
+
+std::string faultLine(const Record &record)
+{
+    return "FAULT," + std::to_string(record.sequence) + "," + std::to_string(record.timeStamp) + "," + std::to_string(record.seat) + "," +
+           std::to_string(record.code) + "," + std::to_string(record.level) + "\r\n";
+}
+
+/*
+ * Synthetic log in timer ticks of 0.1 ms: quiet periods of minutes, then bursts of a flapping sensor
+ * failing every few sensor periods, and now and then a record torn by a reset (a sequence gap).
+ */
+std::vector<Record> syntheticLog(long count, std::mt19937 &generator)
+{
+    std::vector<Record> log;
+    std::uniform_int_distribution<int> percent(0, 99);
+    std::uniform_int_distribution<std::uint32_t> quiet(600000U, 36000000U);
+    std::uniform_int_distribution<std::uint32_t> flap(2000U, 20000U);
+    std::uniform_int_distribution<unsigned> level(0U, 3U);
+    std::uint32_t sequence = 1U + generator() % 1000U;
+    std::uint32_t timeStamp = generator();
+    unsigned seat = 0x66U;
+    unsigned code = 0x44U;
+
+    for (long i = 0; i < count; ++i)
+    {
+        const int roll = percent(generator);
+        if (roll < 10)
+        {
+            timeStamp += quiet(generator);
+            seat = (percent(generator) < 50) ? 0x66U : 0x77U;
+            code = (percent(generator) < 50) ? 0x44U : 0x55U;
+        }
+        else
+        {
+            timeStamp += flap(generator) + (generator() % 16U);
+        }
+        sequence += (roll == 99) ? 2U : 1U;
+        log.push_back({sequence, timeStamp, seat, code, level(generator)});
+    }
+    return log;
+}
+
+/* The export the console sends for a log */
+std::vector<unsigned char> encode(const std::vector<Record> &log, const FaultExport_DictionaryType &dictionary)
+{
+    std::ostringstream header;
+    header << "EXPORT," << log.size() << "," << unsigned(dictionary.aucSeat[0]) << "," << unsigned(dictionary.aucSeat[1]) << ","
+           << unsigned(dictionary.aucCode[0]) << "," << unsigned(dictionary.aucCode[1]) << "\r\n";
+    const std::string text = header.str();
+    std::vector<unsigned char> capture(text.begin(), text.end());
+
+    FaultExport_BlockType block;
+    const uint8 *bytes;
+    FaultExport_Start(&block, &dictionary);
+    for (const Record &record : log)
+    {
+        DiagLog_RecordType in;
+        in.ulSequence = record.sequence;
+        in.xEntry.ulTimeStamp = record.timeStamp;
+        in.xEntry.ucFailureSeat = static_cast<uint8>(record.seat);
+        in.xEntry.ucFailureCode = static_cast<uint8>(record.code);
+        in.xEntry.ucHeatingLevel = static_cast<uint8>(record.level);
+        if (FaultExport_Add(&block, &in) != E_OK && block.ucCount > 0)
+        {
+            const uint16 length = FaultExport_Finish(&block, &bytes);
+            capture.insert(capture.end(), bytes, bytes + length);
+            FaultExport_Add(&block, &in);
+        }
+    }
+    if (block.ucCount > 0)
+    {
+        const uint16 length = FaultExport_Finish(&block, &bytes);
+        capture.insert(capture.end(), bytes, bytes + length);
+    }
+    capture.push_back(0);
+    return capture;
+}
+
+int roundTrip(long count, long corrupt, const std::string &outPath, std::uint32_t seed)
+{
+    const FaultExport_DictionaryType dictionary = {{0x66U, 0x77U}, {0x44U, 0x55U}};
+    std::mt19937 generator(seed);
+    const std::vector<Record> log = syntheticLog(count, generator);
+    std::vector<unsigned char> capture = encode(log, dictionary);
+
+    const std::size_t headerBytes = std::string(capture.begin(), capture.end()).find("\r\n") + 2;
+    for (long i = 0; i < corrupt; ++i)
+    {
+        const std::size_t at = headerBytes + generator() % (capture.size() - headerBytes - 1);
+        capture[at] ^= static_cast<unsigned char>(1U + generator() % 255U);
+    }
+    if (!outPath.empty())
+    {
+        std::ofstream(outPath, std::ios::binary).write(reinterpret_cast<const char *>(capture.data()), static_cast<long>(capture.size()));
+    }
+
+    DecodeResult result;
+    std::string error;
+    if (!decodeCapture(capture, result, error))
+    {
+        std::cerr << "fault_export: " << error << "\n";
+        return 2;
+    }
+
+    /* Every decoded record must be one of the log, in order */
+    unsigned long mismatches = 0;
+    std::size_t next = 0;
+    for (const Record &record : result.records)
+    {
+        while (next < log.size() && log[next].sequence != record.sequence)
+        {
+            ++next;
+        }
+        if (next == log.size() || log[next].timeStamp != record.timeStamp || log[next].seat != record.seat ||
+            log[next].code != record.code || log[next].level != record.level)
+        {
+            ++mismatches;
+            continue;
+        }
+        ++next;
+    }
+
+    unsigned long textBytes = 0;
+    for (const Record &record : log)
+    {
+        textBytes += faultLine(record).size();
+    }
+    const double perRecord = static_cast<double>(result.bytes) / static_cast<double>(log.size());
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "records: " << log.size() << ", decoded " << result.records.size() << ", mismatches " << mismatches << ", blocks "
+              << result.blocks << ", bad blocks " << result.badBlocks << "\n";
+    std::cout << "export: " << result.bytes << " bytes, " << perRecord << " per record, " << 8.0 / perRecord << "x smaller than 8 byte structs, "
+              << static_cast<double>(textBytes) / static_cast<double>(result.bytes) << "x smaller than \"faults\" text\n";
+    std::cout << "full log of " << FAULT_EXPORT_BLOCK_ENTRIES << " entry blocks at 9600 baud: " << result.bytes / 960.0 << " s, text "
+              << textBytes / 960.0 << " s\n";
+
+    const bool clean = (corrupt == 0) ? (result.records.size() == log.size()) : true;
+    return (mismatches == 0 && result.ended && clean) ? 0 : 2;
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+    long generate = 0;
+    long corrupt = 0;
+    std::string outPath;
+    std::string inPath;
+    std::uint32_t seed = 1U;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        if (arg == "-g" && i + 1 < argc)
+        {
+            generate = std::strtol(argv[++i], nullptr, 10);
+        }
+        else if (arg == "-c" && i + 1 < argc)
+        {
+            corrupt = std::strtol(argv[++i], nullptr, 10);
+        }
+        else if (arg == "-o" && i + 1 < argc)
+        {
+            outPath = argv[++i];
+        }
+        else if (arg == "-r" && i + 1 < argc)
+        {
+            seed = static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else if (arg[0] != '-' && inPath.empty())
+        {
+            inPath = arg;
+        }
+        else
+        {
+            std::cerr << "usage: fault_export [-g records [-c bytes] [-o file]] [-r seed] [capture file]\n";
+            return 1;
+        }
+    }
+
+    if (generate > 0)
+    {
+        return roundTrip(generate, corrupt, outPath, seed);
+    }
+
+    std::vector<unsigned char> capture;
+    if (inPath.empty())
+    {
+        capture.assign(std::istreambuf_iterator<char>(std::cin), std::istreambuf_iterator<char>());
+    }
+    else
+    {
+        std::ifstream file(inPath, std::ios::binary);
+        if (!file)
+        {
+            std::cerr << "fault_export: cannot open " << inPath << "\n";
+            return 1;
+        }
+        capture.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+
+    DecodeResult result;
+    std::string error;
+    if (!decodeCapture(capture, result, error))
+    {
+        std::cerr << "fault_export: " << error << "\n";
+        return 1;
+    }
+
+    std::cout << "FAULTS," << result.records.size() << "\r\n";
+    for (const Record &record : result.records)
+    {
+        std::cout << faultLine(record);
+    }
+    std::cerr << result.blocks << " blocks, " << result.badBlocks << " bad blocks, " << result.bytes << " bytes"
+              << (result.ended ? "" : ", export truncated") << "\n";
+    return (result.badBlocks == 0 && result.ended) ? 0 : 2;
+}
@@ -0,0 +1,536 @@
+/*
+ ============================================================================
+ Name        : fault_inject.cpp
+ Module Name : Fault Injection
+ Description : Scenario front end of the firmware fault injection (Control/FaultInject.c,
+               built with FAULT_INJECTION = 1). Three modes:
+               - Default: writes the console commands that load and start a scenario, to be
+                 sent to UART0 ("inject clear", one "inject add" per row, "inject run").
+               - -a: reads a UART capture of the "inject report" reply and reports, per fault
+                 type, the detection rate and the detection latency, the false positive rate
+                 of the fault free samples, and the false presses of the chatter steps.
+               - -s: runs the scenario on the host through the firmware FaultInject and LM35
+                 modules: the ADC driver is replaced by a constant temperature per seat with
+                 the ADC hook of adc.c, and each seat is sampled every sensor period, from a
+                 random phase, with the range check of main.c. The buttons are not simulated,
+                 the false presses of their chatter steps are not counted. A stuck or spike
+                 step outside the valid range must be detected.
+
+ Build       : FW="../../1- Application project/FreeRTOS_Final_Project_WS/Seat_Heater_Control_System"
+               INC=(-I"$FW/Common" -I"$FW/Control" -I"$FW/MCAL/ADC" -I"$FW/HAL/Temperatrue Sensor")
+               gcc -O2 -DFAULT_INJECTION=1 "${INC[@]}" -c "$FW/Control/FaultInject.c" "$FW/HAL/Temperatrue Sensor/lm35.c"
+               g++ -std=c++17 -O2 -DFAULT_INJECTION=1 "${INC[@]}" -o fault_inject fault_inject.cpp FaultInject.o lm35.o
+ Usage       : fault_inject [options] [scenario.csv | capture]
+               -a                Analyze a capture (file or standard input) of "inject report".
+               -s                Simulate the scenario on the host.
+               -r <seed>         Noise seed of "inject run" and of the simulation, default 1.
+               -P <ms>           Sensor period of the simulation, default 100 (mainSENSOR_TASK_DELAY).
+               -T <deg C,deg C>  Driver and passenger temperatures of the simulation, default 25,25.
+               -t <ticks>        Timer value at the start of the simulation, default 0.
+
+ Every scenario row is a step, times in ms from "inject run":
+   <at ms>,<target>,<fault>,<value>,<period ms>,<duration ms>
+ with the target adc0, adc1, lm0, lm1, sw1, sw2 or sw3 and the fault stuck, spike, noise,
+ drop or chatter (see FaultInject_FaultType for the value and the period).
+
+ Exit status : 0, 2 when a simulated step outside the valid range is not detected or a
+               fault free sample is reported as a failure, 1 on input errors
+               and on commands longer than the console line.
+ ============================================================================
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+extern "C"
+{
+#include "Std_Types.h"
+#include "adc.h"
+#include "lm35.h"
+#include "FaultInject.h"
+}
+
+namespace
+{
+
+/* Firmware timing and limits (main.c, lm35.h) */
+constexpr int kTempMinValid = 5; /* mainTEMP_MIN_VALID_RANGE */
+constexpr int kTempMaxValid = 40; /* mainTEMP_MAX_VALID_RANGE */
+constexpr double kTicksPerMs = FAULT_INJECT_TICKS_PER_MS;
+constexpr std::size_t kConsoleLineSize = 48; /* mainCONSOLE_LINE_SIZE, with the terminating 0 */
+
+/* Console names, in the order of FaultInject_TargetType and FaultInject_FaultType */
+const std::vector<std::string> kTargets = { "adc0", "adc1", "lm0", "lm1", "sw1", "sw2", "sw3" };
+const std::vector<std::string> kFaults = { "stuck", "spike", "noise", "drop", "chatter" };
+
+/* Outcome of a step, from the firmware report or from the simulation */
+struct StepReport
+{
+    int target = 0;
+    int fault = 0;
+    bool started = false;
+    unsigned long detections = 0;
+    double latencyMs = 0.0;
+    bool expected = false; /* Simulation only: the step must be detected */
+};
+
+struct RunReport
+{
+    std::vector<StepReport> steps;
+    unsigned long falsePositives = 0;
+    unsigned long cleanSamples = 0;
+    bool ended = false;
+    bool simulated = false; /* No button events */
+};
+
+/* ADC codes of the seats in the simulation, replaced by the ADC hook like ADC_ReadChannel() of adc.c */
+std::uint16_t simAdc[FAULT_INJECT_CHANNELS] = { 0, 0 };
+
+int nameIndex(const std::vector<std::string> &names, const std::string &name)
+{
+    const auto it = std::find(names.begin(), names.end(), name);
+    return (it == names.end()) ? -1 : static_cast<int>(it - names.begin());
+}
+
+std::vector<std::string> splitFields(const std::string &line)
+{
+    std::vector<std::string> fields;
+    std::stringstream ss(line);
+    std::string field;
+    while (std::getline(ss, field, ','))
+    {
+        const std::size_t first = field.find_first_not_of(" \t\r");
+        const std::size_t last = field.find_last_not_of(" \t\r");
+        fields.push_back((first == std::string::npos) ? std::string() : field.substr(first, last - first + 1));
+    }
+    return fields;
+}
+
+bool readScenario(const std::string &path, std::vector<FaultInject_StepType> &steps)
+{
+    std::ifstream file(path);
+    if (!file)
+    {
+        std::cerr << "fault_inject: cannot open " << path << "\n";
+        return false;
+    }
+
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line))
+    {
+        ++lineNumber;
+        const std::size_t first = line.find_first_not_of(" \t\r");
+        if (first == std::string::npos || line[first] == '#')
+        {
+            continue;
+        }
+
+        const std::vector<std::string> fields = splitFields(line);
+        if (fields.size() != 6)
+        {
+            std::cerr << path << ":" << lineNumber << ": expected 6 fields\n";
+            return false;
+        }
+
+        FaultInject_StepType step;
+        const int target = nameIndex(kTargets, fields[1]);
+        const int fault = nameIndex(kFaults, fields[2]);
+        const unsigned long value = std::strtoul(fields[3].c_str(), nullptr, 10);
+        if (target < 0 || fault < 0 || value > 0xFFFFUL)
+        {
+            std::cerr << path << ":" << lineNumber << ": unknown target or fault, or value above 65535\n";
+            return false;
+        }
+        step.ulAt = std::strtoul(fields[0].c_str(), nullptr, 10);
+        step.ucTarget = static_cast<uint8>(target);
+        step.ucFault = static_cast<uint8>(fault);
+        step.usValue = static_cast<uint16>(value);
+        step.ulPeriod = std::strtoul(fields[4].c_str(), nullptr, 10);
+        step.ulDuration = std::strtoul(fields[5].c_str(), nullptr, 10);
+        steps.push_back(step);
+    }
+
+    if (steps.empty() || steps.size() > FAULT_INJECT_MAX_STEPS)
+    {
+        std::cerr << "fault_inject: " << path << " needs 1 to " << FAULT_INJECT_MAX_STEPS << " steps\n";
+        return false;
+    }
+    return true;
+}
+
+bool writeCommands(const std::vector<FaultInject_StepType> &steps, std::uint32_t seed)
+{
+    std::ostringstream commands;
+    bool fits = true;
+
+    commands << "inject clear\r\n";
+    for (const FaultInject_StepType &step : steps)
+    {
+        std::ostringstream line;
+        line << "inject add " << kTargets[step.ucTarget] << " " << kFaults[step.ucFault] << " " << step.usValue << " " << step.ulPeriod << " "
+             << step.ulAt << " " << step.ulDuration;
+        if (line.str().size() >= kConsoleLineSize)
+        {
+            std::cerr << "fault_inject: \"" << line.str() << "\" is longer than the console line\n";
+            fits = false;
+        }
+        commands << line.str() << "\r\n";
+    }
+    commands << "inject run " << seed << "\r\n";
+
+    std::cout << commands.str();
+    return fits;
+}
+
+/* Reads the INJECT,STEP and INJECT,END lines of a capture, the other lines are skipped */
+bool readCapture(std::istream &in, RunReport &report)
+{
+    std::string line;
+    while (std::getline(in, line))
+    {
+        const std::vector<std::string> fields = splitFields(line);
+        if (fields.size() == 9 && fields[0] == "INJECT" && fields[1] == "STEP")
+        {
+            StepReport step;
+            step.target = nameIndex(kTargets, fields[3]);
+            step.fault = nameIndex(kFaults, fields[4]);
+            if (step.target < 0 || step.fault < 0)
+            {
+                std::cerr << "fault_inject: bad step line: " << line << "\n";
+                return false;
+            }
+            step.started = (fields[5] == "1");
+            step.detections = std::strtoul(fields[7].c_str(), nullptr, 10);
+            step.latencyMs = std::strtod(fields[8].c_str(), nullptr) / kTicksPerMs;
+            report.steps.push_back(step);
+        }
+        else if (fields.size() == 4 && fields[0] == "INJECT" && fields[1] == "END")
+        {
+            report.falsePositives = std::strtoul(fields[2].c_str(), nullptr, 10);
+            report.cleanSamples = std::strtoul(fields[3].c_str(), nullptr, 10);
+            report.ended = true;
+        }
+    }
+
+    if (!report.ended)
+    {
+        std::cerr << "fault_inject: no INJECT,END line in the capture\n";
+        return false;
+    }
+    return true;
+}
+
+/* Temperature read by the LM35 driver for an ADC code, the formula of LM35_getTemperature() */
+int adcTemperature(unsigned code)
+{
+    return static_cast<int>((static_cast<double>(code) * SENSOR_MAX_TEMPERATURE * ADC_REFERENCE_VOLTAGE) /
+                            (ADC_MAXIMUM_VALUE * SENSOR_MAX_VOLT_VALUE));
+}
+
+/* A stuck or spike step at a value outside the valid range is a failure the sensor task must see */
+bool mustDetect(const FaultInject_StepType &step)
+{
+    if (step.ucFault != FAULT_INJECT_STUCK && step.ucFault != FAULT_INJECT_SPIKE)
+    {
+        return false;
+    }
+    const int temperature = (step.ucTarget <= FAULT_INJECT_TARGET_ADC1) ? adcTemperature(step.usValue) : step.usValue;
+    return temperature < kTempMinValid || temperature > kTempMaxValid;
+}
+
+void simulate(const std::vector<FaultInject_StepType> &steps, std::uint32_t seed, int periodMs, const int temperature[],
+              std::uint32_t startTicks, RunReport &report)
+{
+    bool errorFlag[FAULT_INJECT_CHANNELS] = { false, false };
+    std::uint32_t phase[FAULT_INJECT_CHANNELS];
+    std::mt19937 random(seed);
+
+    /* The sensor tasks do not run in step with "inject run" */
+    for (std::uint32_t &channelPhase : phase)
+    {
+        channelPhase = std::uniform_int_distribution<std::uint32_t>(0U, static_cast<std::uint32_t>(periodMs) - 1U)(random);
+    }
+
+    FaultInject_Clear();
+    for (const FaultInject_StepType &step : steps)
+    {
+        if (FaultInject_Add(&step) != E_OK)
+        {
+            std::cerr << "fault_inject: step " << kTargets[step.ucTarget] << " " << kFaults[step.ucFault] << " rejected\n";
+        }
+    }
+    for (unsigned channel = 0; channel < FAULT_INJECT_CHANNELS; ++channel)
+    {
+        /* Middle of the code range of the temperature */
+        simAdc[channel] = static_cast<std::uint16_t>(((temperature[channel] + 0.5) * ADC_MAXIMUM_VALUE * SENSOR_MAX_VOLT_VALUE) /
+                                                     (SENSOR_MAX_TEMPERATURE * ADC_REFERENCE_VOLTAGE));
+    }
+
+    FaultInject_Run(startTicks, seed);
+    for (std::uint32_t ms = 0; FaultInject_IsRunning() == TRUE; ++ms)
+    {
+        const std::uint32_t now = static_cast<std::uint32_t>(startTicks + ms * FAULT_INJECT_TICKS_PER_MS);
+        FaultInject_Tick(now);
+
+        /* prvDriverSensorProcess() and prvPassengerSensorProcess() */
+        for (uint8 channel = 0; channel < FAULT_INJECT_CHANNELS; ++channel)
+        {
+            if (ms % static_cast<std::uint32_t>(periodMs) != phase[channel])
+            {
+                continue;
+            }
+            const int reading = LM35_getTemperature(channel);
+            if (reading > kTempMaxValid || reading < kTempMinValid)
+            {
+                if (!errorFlag[channel])
+                {
+                    FaultInject_Detected(channel, now);
+                    errorFlag[channel] = true;
+                }
+            }
+            else
+            {
+                errorFlag[channel] = false;
+            }
+        }
+    }
+
+    FaultInject_StepType step;
+    FaultInject_ResultType result;
+    for (uint8 index = 0; FaultInject_Result(index, &step, &result) == E_OK; ++index)
+    {
+        StepReport out;
+        out.target = step.ucTarget;
+        out.fault = step.ucFault;
+        out.started = (result.bStarted == TRUE);
+        out.detections = result.usDetections;
+        out.latencyMs = (result.usDetections > 0) ? static_cast<double>(static_cast<std::uint32_t>(result.ulDetection - result.ulStart)) / kTicksPerMs : 0.0;
+        out.expected = mustDetect(step);
+        report.steps.push_back(out);
+    }
+
+    FaultInject_SummaryType summary;
+    FaultInject_Summary(&summary);
+    report.falsePositives = summary.ulFalsePositives;
+    report.cleanSamples = summary.ulCleanSamples;
+    report.ended = true;
+    report.simulated = true;
+}
+
+/* Prints the steps and the figures per fault type, returns the exit status */
+int printReport(const RunReport &report)
+{
+    struct FaultFigures
+    {
+        unsigned steps = 0;
+        unsigned detected = 0;
+        double latencySum = 0.0;
+        double latencyMax = 0.0;
+        unsigned long falsePresses = 0;
+    };
+    std::map<int, FaultFigures> figures;
+    unsigned missed = 0;
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "step target fault    started detections latency_ms\n";
+    for (std::size_t i = 0; i < report.steps.size(); ++i)
+    {
+        const StepReport &step = report.steps[i];
+        std::cout << std::setw(4) << i << " " << std::left << std::setw(6) << kTargets[step.target] << " " << std::setw(8) << kFaults[step.fault]
+                  << " " << std::setw(7) << (step.started ? "yes" : "no") << " " << std::right << std::setw(10) << step.detections << " ";
+        if (step.fault == FAULT_INJECT_CHATTER)
+        {
+            std::cout << (report.simulated ? "         -  (buttons not simulated)" : "         -  (false presses)");
+        }
+        else if (step.detections > 0)
+        {
+            std::cout << std::setw(10) << step.latencyMs;
+        }
+        else
+        {
+            std::cout << "         -";
+        }
+        if (step.expected && step.detections == 0)
+        {
+            std::cout << "  MISSED";
+            ++missed;
+        }
+        std::cout << "\n";
+
+        if (!step.started)
+        {
+            continue;
+        }
+        FaultFigures &fault = figures[step.fault];
+        ++fault.steps;
+        if (step.fault == FAULT_INJECT_CHATTER)
+        {
+            fault.falsePresses += step.detections;
+        }
+        else if (step.detections > 0)
+        {
+            ++fault.detected;
+            fault.latencySum += step.latencyMs;
+            fault.latencyMax = std::max(fault.latencyMax, step.latencyMs);
+        }
+    }
+
+    std::cout << "\nfault    steps detected  rate_% mean_latency_ms max_latency_ms\n";
+    for (const auto &[fault, figure] : figures)
+    {
+        std::cout << std::left << std::setw(8) << kFaults[fault] << std::right << std::setw(6) << figure.steps << " ";
+        if (fault == FAULT_INJECT_CHATTER)
+        {
+            if (report.simulated)
+            {
+                std::cout << "  buttons not simulated\n";
+            }
+            else
+            {
+                std::cout << "  " << figure.falsePresses << " false presses\n";
+            }
+            continue;
+        }
+        std::cout << std::setw(8) << figure.detected << " " << std::setw(7) << (100.0 * figure.detected / figure.steps) << " ";
+        if (figure.detected > 0)
+        {
+            std::cout << std::setw(15) << (figure.latencySum / figure.detected) << " " << std::setw(14) << figure.latencyMax << "\n";
+        }
+        else
+        {
+            std::cout << std::setw(15) << "-" << " " << std::setw(14) << "-" << "\n";
+        }
+    }
+
+    std::cout << "\nfalse positives: " << report.falsePositives << " of " << report.cleanSamples << " fault free samples";
+    if (report.cleanSamples > 0)
+    {
+        std::cout << std::setprecision(3) << " (" << (100.0 * report.falsePositives / report.cleanSamples) << " %)";
+    }
+    std::cout << "\n";
+    if (missed > 0)
+    {
+        std::cout << missed << " step(s) outside the valid range not detected\n";
+    }
+
+    return (missed == 0 && report.falsePositives == 0) ? 0 : 2;
+}
+
+}
+
+/* Replaces the firmware ADC driver (MCAL/ADC/adc.c) on the host, with its fault injection hook */
+extern "C" uint16 ADC_ReadChannel(uint8 channel_num)
+{
+    return FAULT_INJECT_ADC(channel_num, (channel_num < FAULT_INJECT_CHANNELS) ? simAdc[channel_num] : 0U);
+}
+
+int main(int argc, char *argv[])
+{
+    bool analyze = false;
+    bool simulation = false;
+    std::uint32_t seed = 1U;
+    int periodMs = 100;
+    int temperature[FAULT_INJECT_CHANNELS] = { 25, 25 };
+    std::uint32_t startTicks = 0U;
+    std::string path;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        if (arg == "-a")
+        {
+            analyze = true;
+        }
+        else if (arg == "-s")
+        {
+            simulation = true;
+        }
+        else if (arg == "-r" && i + 1 < argc)
+        {
+            seed = static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else if (arg == "-P" && i + 1 < argc)
+        {
+            periodMs = std::max(1, std::atoi(argv[++i]));
+        }
+        else if (arg == "-T" && i + 1 < argc)
+        {
+            const std::vector<std::string> fields = splitFields(argv[++i]);
+            if (fields.size() != FAULT_INJECT_CHANNELS)
+            {
+                std::cerr << "fault_inject: -T needs the driver and passenger temperatures\n";
+                return 1;
+            }
+            temperature[0] = std::atoi(fields[0].c_str());
+            temperature[1] = std::atoi(fields[1].c_str());
+        }
+        else if (arg == "-t" && i + 1 < argc)
+        {
+            startTicks = static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 0));
+        }
+        else if (arg[0] != '-' && path.empty())
+        {
+            path = arg;
+        }
+        else
+        {
+            std::cerr << "usage: fault_inject [-a | -s [-P ms] [-T deg,deg] [-t ticks]] [-r seed] [scenario.csv | capture]\n";
+            return 1;
+        }
+    }
+
+    RunReport report;
+    if (analyze)
+    {
+        if (path.empty())
+        {
+            if (!readCapture(std::cin, report))
+            {
+                return 1;
+            }
+        }
+        else
+        {
+            std::ifstream file(path);
+            if (!file)
+            {
+                std::cerr << "fault_inject: cannot open " << path << "\n";
+                return 1;
+            }
+            if (!readCapture(file, report))
+            {
+                return 1;
+            }
+        }
+        return printReport(report);
+    }
+
+    std::vector<FaultInject_StepType> steps;
+    if (path.empty())
+    {
+        std::cerr << "fault_inject: a scenario file is needed\n";
+        return 1;
+    }
+    if (!readScenario(path, steps))
+    {
+        return 1;
+    }
+
+    if (!simulation)
+    {
+        return writeCommands(steps, seed) ? 0 : 1;
+    }
+
+    simulate(steps, seed, periodMs, temperature, startTicks, report);
+    return printReport(report);
+}
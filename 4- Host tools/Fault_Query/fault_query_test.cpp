@@ -0,0 +1,419 @@
+/*
+ ============================================================================
+ Name        : fault_query_test.cpp
+ Module Name : Fault Query Test
+ Description : Host test bench of the time indexed queries over the persistent fault log
+               (firmware Control/FaultQuery.c over Control/FaultStore.c). The EEPROM driver is
+               replaced by a word array that counts the reads. A long synthetic fault history
+               is appended, each seat in time order with bursts, quiet periods and equal
+               timestamps, and after every append a random query (seat, failure code or all,
+               and a time window) is checked against a full scan of the store:
+               - the count and the records returned, in sequence order,
+               - the summary of each seat,
+               - the EEPROM reads of the query, at most 2 binary searches per seat and code
+                 plus one read per returned record (O(log n + k)).
+               Some queries are interleaved with half a ring of appends, the records
+               overwritten meanwhile must be skipped and the others still returned.
+
+ Build       : FW="../../1- Application project/FreeRTOS_Final_Project_WS/Seat_Heater_Control_System"
+               INC=(-I"$FW/Common" -I"$FW/Control" -I"$FW/MCAL/EEPROM")
+               gcc -O2 "${INC[@]}" -c "$FW/Control/FaultStore.c" "$FW/Control/FaultQuery.c"
+               g++ -std=c++17 -O2 "${INC[@]}" -o fault_query_test fault_query_test.cpp FaultStore.o FaultQuery.o
+ Usage       : fault_query_test [options]
+               -n <records>      Records appended, default 200000.
+               -p <records>      Records in the store before the index starts (not indexed), default 50.
+               -r <seed>         Random seed, default 1.
+
+ Exit status : 0 when every query matches the scan, 2 otherwise, 1 on input errors.
+ ============================================================================
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+extern "C"
+{
+#include "Std_Types.h"
+#include "eeprom.h"
+#include "FaultStore.h"
+#include "FaultQuery.h"
+}
+
+namespace
+{
+
+/* The image holds the words as the firmware uint32, which is wider than 32 bits on 64 bit hosts */
+std::vector<uint32> eepromWords(EEPROM_SIZE_WORDS, FAULT_STORE_ERASED);
+unsigned long eepromReads = 0;
+
+}
+
+/* Replacement of the firmware EEPROM driver (MCAL/EEPROM/eeprom.c) on the host */
+extern "C" Std_ReturnType EEPROM_Init(void)
+{
+    return E_OK;
+}
+
+extern "C" Std_ReturnType EEPROM_Read(uint16 address, uint32 *data, uint16 count)
+{
+    if ((static_cast<unsigned>(address) + count) > EEPROM_SIZE_WORDS)
+    {
+        return E_NOT_OK;
+    }
+    ++eepromReads;
+    for (uint16 i = 0; i < count; ++i)
+    {
+        data[i] = eepromWords[address + i];
+    }
+    return E_OK;
+}
+
+extern "C" Std_ReturnType EEPROM_Write(uint16 address, const uint32 *data, uint16 count)
+{
+    if ((static_cast<unsigned>(address) + count) > EEPROM_SIZE_WORDS)
+    {
+        return E_NOT_OK;
+    }
+    for (uint16 i = 0; i < count; ++i)
+    {
+        eepromWords[address + i] = data[i];
+    }
+    return E_OK;
+}
+
+namespace
+{
+
+/* Raw seat and failure codes of the firmware (main.c), plus one of each the index leaves out */
+const uint8 seats[FAULT_QUERY_MAX_SEATS] = { 0x11, 0x22 };
+const uint8 codes[FAULT_QUERY_MAX_CODES] = { 0x44, 0x55 };
+const uint8 otherSeat = 0x33;
+const uint8 otherCode = 0x66;
+
+struct Record
+{
+    std::uint32_t sequence;
+    std::uint32_t timeStamp;
+    unsigned seat; /* Index of the query, FAULT_QUERY_ALL when out of the index */
+    unsigned code;
+};
+
+/*
+ * Synthetic history: each seat has its own clock, bursts of close faults between quiet periods.
+ * The clocks do not wrap before about 4 million records, as the firmware timer does not within a drive.
+ */
+class History
+{
+public:
+    explicit History(std::uint32_t seed) : generator(seed)
+    {
+    }
+
+    DiagLog_EntryType next()
+    {
+        std::uniform_int_distribution<unsigned> pick(0, 99);
+        const unsigned seat = pick(generator) % 3U; /* 2 is the seat out of the index */
+        std::uint32_t &clock = clocks[seat];
+
+        const unsigned gap = pick(generator);
+        if (gap < 10)
+        {
+            /* Same timestamp as the previous fault of the seat */
+        }
+        else if (gap < 80)
+        {
+            clock += 1U + pick(generator) * 37U; /* Burst, less than 0.4 s apart */
+        }
+        else
+        {
+            clock += 2000U + pick(generator) * 100U; /* Quiet period of 0.2 s to 1.2 s, the timer counts 0.1 ms */
+        }
+
+        DiagLog_EntryType entry;
+        entry.ulTimeStamp = clock;
+        entry.ucFailureSeat = (seat < 2U) ? seats[seat] : otherSeat;
+        entry.ucFailureCode = (pick(generator) < 5U) ? otherCode : codes[pick(generator) % 2U];
+        entry.ucHeatingLevel = static_cast<uint8>(pick(generator) % 4U);
+        return entry;
+    }
+
+    std::mt19937 generator;
+
+private:
+    std::uint32_t clocks[3] = { 1000U, 1000U, 1000U };
+};
+
+unsigned indexOf(const uint8 *values, unsigned count, uint8 value)
+{
+    for (unsigned i = 0; i < count; ++i)
+    {
+        if (values[i] == value)
+        {
+            return i;
+        }
+    }
+    return FAULT_QUERY_ALL;
+}
+
+/* Full scan of the store, the indexed records from the first indexed sequence number */
+std::vector<Record> scan(std::uint32_t firstIndexed)
+{
+    std::vector<Record> records;
+    for (uint16 i = 0; i < FaultStore_Count(); ++i)
+    {
+        DiagLog_RecordType record;
+        if (FaultStore_Read(i, &record) != E_OK || record.ulSequence < firstIndexed)
+        {
+            continue;
+        }
+        const unsigned seat = indexOf(seats, FAULT_QUERY_MAX_SEATS, record.xEntry.ucFailureSeat);
+        const unsigned code = indexOf(codes, FAULT_QUERY_MAX_CODES, record.xEntry.ucFailureCode);
+        if (seat != FAULT_QUERY_ALL && code != FAULT_QUERY_ALL)
+        {
+            records.push_back({ static_cast<std::uint32_t>(record.ulSequence), static_cast<std::uint32_t>(record.xEntry.ulTimeStamp), seat, code });
+        }
+    }
+    return records;
+}
+
+bool matches(const Record &record, unsigned seat, unsigned code, std::uint32_t from, std::uint32_t to)
+{
+    return (seat == FAULT_QUERY_ALL || record.seat == seat) && (code == FAULT_QUERY_ALL || record.code == code) &&
+           record.timeStamp >= from && record.timeStamp <= to;
+}
+
+struct Stats
+{
+    unsigned long queries = 0;
+    unsigned long returned = 0;
+    unsigned long failures = 0;
+    unsigned long maxCountReads = 0;
+    unsigned long maxExtraReads = 0; /* Reads of a query beyond one per returned record */
+};
+
+void fail(Stats &stats, const std::string &error)
+{
+    if (stats.failures++ < 10)
+    {
+        std::cerr << error << "\n";
+    }
+}
+
+/* Binary searches of a query: 2 per list, each over at most FAULT_STORE_RECORDS records */
+unsigned long readBound()
+{
+    return 2UL * FAULT_QUERY_KEYS * static_cast<unsigned long>(std::ceil(std::log2(FAULT_STORE_RECORDS + 1.0)));
+}
+
+void checkQuery(Stats &stats, const std::vector<Record> &live, unsigned seat, unsigned code, std::uint32_t from, std::uint32_t to)
+{
+    std::vector<Record> expected;
+    for (const Record &record : live)
+    {
+        if (matches(record, seat, code, from, to))
+        {
+            expected.push_back(record);
+        }
+    }
+    ++stats.queries;
+
+    uint16 count = 0;
+    eepromReads = 0;
+    if (FaultQuery_Count(static_cast<uint8>(seat), static_cast<uint8>(code), from, to, &count) != E_OK || count != expected.size())
+    {
+        fail(stats, "count seat " + std::to_string(seat) + " code " + std::to_string(code) + " [" + std::to_string(from) + ", " +
+                        std::to_string(to) + "]: " + std::to_string(count) + ", expected " + std::to_string(expected.size()));
+        return;
+    }
+    stats.maxCountReads = std::max(stats.maxCountReads, eepromReads);
+
+    FaultQuery_CursorType cursor;
+    DiagLog_RecordType record;
+    std::vector<Record> returned;
+    eepromReads = 0;
+    if (FaultQuery_First(static_cast<uint8>(seat), static_cast<uint8>(code), from, to, &cursor) != E_OK)
+    {
+        fail(stats, "first failed");
+        return;
+    }
+    while (FaultQuery_Next(&cursor, &record) == E_OK)
+    {
+        returned.push_back({ static_cast<std::uint32_t>(record.ulSequence), static_cast<std::uint32_t>(record.xEntry.ulTimeStamp), 0U, 0U });
+    }
+    stats.returned += returned.size();
+    stats.maxExtraReads = std::max(stats.maxExtraReads, eepromReads - returned.size());
+
+    bool same = returned.size() == expected.size();
+    for (std::size_t i = 0; same && i < returned.size(); ++i)
+    {
+        same = returned[i].sequence == expected[i].sequence && returned[i].timeStamp == expected[i].timeStamp;
+    }
+    if (!same)
+    {
+        fail(stats, "records of seat " + std::to_string(seat) + " code " + std::to_string(code) + ": " + std::to_string(returned.size()) +
+                        " returned, expected " + std::to_string(expected.size()));
+    }
+}
+
+void checkSummary(Stats &stats, const std::vector<Record> &live)
+{
+    for (unsigned seat = 0; seat < FAULT_QUERY_MAX_SEATS; ++seat)
+    {
+        FaultQuery_SummaryType expected = {};
+        bool any = false;
+        for (const Record &record : live)
+        {
+            if (record.seat != seat)
+            {
+                continue;
+            }
+            ++expected.ausCount[record.code];
+            expected.ulFirstTimeStamp = any ? std::min<std::uint32_t>(expected.ulFirstTimeStamp, record.timeStamp) : record.timeStamp;
+            expected.ulLastTimeStamp = any ? std::max<std::uint32_t>(expected.ulLastTimeStamp, record.timeStamp) : record.timeStamp;
+            any = true;
+        }
+
+        FaultQuery_SummaryType summary;
+        if (FaultQuery_Summary(static_cast<uint8>(seat), &summary) != E_OK || summary.ulFirstTimeStamp != expected.ulFirstTimeStamp ||
+            summary.ulLastTimeStamp != expected.ulLastTimeStamp || summary.ausCount[0] != expected.ausCount[0] ||
+            summary.ausCount[1] != expected.ausCount[1])
+        {
+            fail(stats, "summary of seat " + std::to_string(seat) + " does not match");
+        }
+    }
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+    long records = 200000;
+    long preloaded = 50;
+    std::uint32_t seed = 1U;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        if (arg == "-n" && i + 1 < argc)
+        {
+            records = std::strtol(argv[++i], nullptr, 10);
+        }
+        else if (arg == "-p" && i + 1 < argc)
+        {
+            preloaded = std::strtol(argv[++i], nullptr, 10);
+        }
+        else if (arg == "-r" && i + 1 < argc)
+        {
+            seed = static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else
+        {
+            std::cerr << "usage: fault_query_test [-n records] [-p preloaded records] [-r seed]\n";
+            return 1;
+        }
+    }
+
+    History history(seed);
+    if (FaultStore_Init() != E_OK)
+    {
+        return 2;
+    }
+    for (long i = 0; i < preloaded; ++i)
+    {
+        const DiagLog_EntryType entry = history.next();
+        FaultStore_Append(&entry);
+    }
+
+    /* As at boot: the records already in the store are left out of the index */
+    if (FaultStore_Init() != E_OK)
+    {
+        return 2;
+    }
+    const std::uint32_t firstIndexed = static_cast<std::uint32_t>(FaultStore_NextSequence());
+    FaultQuery_Init(seats, codes);
+
+    Stats stats;
+    std::uniform_int_distribution<unsigned> filter(0, FAULT_QUERY_MAX_SEATS);
+    std::uniform_int_distribution<unsigned> percent(0, 99);
+
+    for (long i = 0; i < records; ++i)
+    {
+        const DiagLog_EntryType entry = history.next();
+        if (FaultStore_Append(&entry) != E_OK)
+        {
+            return 2;
+        }
+        FaultQuery_Insert(FaultStore_NextSequence() - 1U, &entry);
+
+        const std::vector<Record> live = scan(firstIndexed);
+        const unsigned seat = (filter(history.generator) == FAULT_QUERY_MAX_SEATS) ? FAULT_QUERY_ALL : filter(history.generator) % FAULT_QUERY_MAX_SEATS;
+        const unsigned code = (filter(history.generator) == FAULT_QUERY_MAX_CODES) ? FAULT_QUERY_ALL : filter(history.generator) % FAULT_QUERY_MAX_CODES;
+
+        /* Windows around the live records, with bounds on, between and beyond their timestamps */
+        std::uint32_t from = 0U;
+        std::uint32_t to = 0xFFFFFFFFU;
+        if (!live.empty() && percent(history.generator) < 90U)
+        {
+            std::uniform_int_distribution<std::size_t> pick(0, live.size() - 1U);
+            from = live[pick(history.generator)].timeStamp - percent(history.generator) % 3U;
+            to = live[pick(history.generator)].timeStamp + percent(history.generator) % 3U;
+        }
+        checkQuery(stats, live, seat, code, from, to);
+        checkSummary(stats, live);
+
+        /* A query read slowly while half a ring of records is appended */
+        if (i % 5000 == 4999)
+        {
+            FaultQuery_CursorType cursor;
+            DiagLog_RecordType record;
+            const std::vector<Record> before = scan(firstIndexed);
+            FaultQuery_First(FAULT_QUERY_ALL, FAULT_QUERY_ALL, 0U, 0xFFFFFFFFU, &cursor);
+            for (long j = 0; j < FAULT_STORE_RECORDS / 2L; ++j)
+            {
+                const DiagLog_EntryType more = history.next();
+                FaultStore_Append(&more);
+                FaultQuery_Insert(FaultStore_NextSequence() - 1U, &more);
+            }
+
+            /* The records of First still in the store, none appended after it */
+            const std::vector<Record> after = scan(firstIndexed);
+            std::vector<std::uint32_t> expected;
+            for (const Record &r : before)
+            {
+                if (std::any_of(after.begin(), after.end(), [&](const Record &a) { return a.sequence == r.sequence; }))
+                {
+                    expected.push_back(r.sequence);
+                }
+            }
+            std::vector<std::uint32_t> returned;
+            while (FaultQuery_Next(&cursor, &record) == E_OK)
+            {
+                returned.push_back(static_cast<std::uint32_t>(record.ulSequence));
+            }
+            if (returned != expected)
+            {
+                fail(stats, "query across appends: " + std::to_string(returned.size()) + " records returned, expected " + std::to_string(expected.size()));
+            }
+        }
+    }
+
+    const unsigned long bound = readBound();
+    std::cout << "fault query: " << records << " records appended over " << FAULT_STORE_RECORDS << " slots, " << stats.queries << " queries, "
+              << stats.returned << " records returned\n";
+    std::cout << "EEPROM reads per count: max " << stats.maxCountReads << ", per query beyond the returned records: max " << stats.maxExtraReads
+              << " (bound " << bound << ", full scan " << FAULT_STORE_RECORDS << ")\n";
+    std::cout << stats.failures << " failures\n";
+
+    if (stats.maxCountReads > bound || stats.maxExtraReads > bound)
+    {
+        std::cerr << "a query read more than its bound\n";
+        return 2;
+    }
+    return stats.failures == 0 ? 0 : 2;
+}
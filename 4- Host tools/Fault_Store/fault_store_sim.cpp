@@ -0,0 +1,356 @@
+/*
+ ============================================================================
+ Name        : fault_store_sim.cpp
+ Module Name : Fault Store Simulator
+ Description : Host test bench of the firmware persistent fault log (Control/FaultStore.c).
+               The EEPROM driver is replaced by a memory mapped file with the size and the
+               erased value of the TM4C123 EEPROM, so the store survives the process like the
+               EEPROM survives a reset. Two runs:
+               - Power loss: the supply is cut after a random number of word programs, the
+                 store is recovered from the file, and every record appended before the cut
+                 must be read back with its sequence number, the sequence numbers continuing.
+               - Endurance: records are appended and the programs of every word are counted,
+                 to report the wear spread and the lifetime at a given fault rate.
+
+ Build       : FW="../../1- Application project/FreeRTOS_Final_Project_WS/Seat_Heater_Control_System"
+               INC=(-I"$FW/Common" -I"$FW/Control" -I"$FW/MCAL/EEPROM")
+               gcc -O2 "${INC[@]}" -c "$FW/Control/FaultStore.c"
+               g++ -std=c++17 -O2 "${INC[@]}" -o fault_store_sim fault_store_sim.cpp FaultStore.o
+ Usage       : fault_store_sim [options]
+               -f <file>         EEPROM image, default fault_store.eeprom (created erased).
+               -p <trials>       Power loss trials, default 1000.
+               -n <records>      Endurance records, default 100000.
+               -e <cycles>       Word endurance in programs, default 500000 (TM4C123 datasheet).
+               -F <per hour>     Fault rate for the lifetime estimate, default 10.
+               -r <seed>         Random seed, default 1.
+
+ Exit status : 0 when every recovery is correct, 2 otherwise, 1 on input errors.
+ ============================================================================
+ */
+
+#include <algorithm>
+#include <csetjmp>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+extern "C"
+{
+#include "Std_Types.h"
+#include "eeprom.h"
+#include "FaultStore.h"
+}
+
+namespace
+{
+
+/* The image holds the words as the firmware uint32, which is wider than 32 bits on 64 bit hosts */
+uint32 *eepromWords = nullptr;
+std::vector<unsigned long> programs(EEPROM_SIZE_WORDS, 0UL);
+
+/* Word programs left before the supply is cut, negative for no cut */
+long programsBeforeCut = -1;
+std::jmp_buf powerCut;
+
+bool mapImage(const std::string &path)
+{
+    const int fd = open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd < 0)
+    {
+        std::cerr << "fault_store_sim: cannot open " << path << "\n";
+        return false;
+    }
+
+    const off_t bytes = EEPROM_SIZE_WORDS * sizeof(uint32);
+    const bool fresh = lseek(fd, 0, SEEK_END) != bytes;
+    if (fresh && ftruncate(fd, bytes) != 0)
+    {
+        close(fd);
+        return false;
+    }
+
+    void *image = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (image == MAP_FAILED)
+    {
+        return false;
+    }
+    eepromWords = static_cast<uint32 *>(image);
+    if (fresh)
+    {
+        std::fill(eepromWords, eepromWords + EEPROM_SIZE_WORDS, FAULT_STORE_ERASED);
+    }
+    return true;
+}
+
+void eraseImage()
+{
+    std::fill(eepromWords, eepromWords + EEPROM_SIZE_WORDS, FAULT_STORE_ERASED);
+    msync(eepromWords, EEPROM_SIZE_WORDS * sizeof(uint32), MS_SYNC);
+}
+
+}
+
+/* Replacement of the firmware EEPROM driver (MCAL/EEPROM/eeprom.c) on the host */
+extern "C" Std_ReturnType EEPROM_Init(void)
+{
+    return (eepromWords != nullptr) ? E_OK : E_NOT_OK;
+}
+
+extern "C" Std_ReturnType EEPROM_Read(uint16 address, uint32 *data, uint16 count)
+{
+    if ((static_cast<unsigned>(address) + count) > EEPROM_SIZE_WORDS)
+    {
+        return E_NOT_OK;
+    }
+    for (uint16 i = 0; i < count; ++i)
+    {
+        data[i] = eepromWords[address + i];
+    }
+    return E_OK;
+}
+
+/* A word is programmed whole or not at all, the cut happens between two words like on the target */
+extern "C" Std_ReturnType EEPROM_Write(uint16 address, const uint32 *data, uint16 count)
+{
+    if ((static_cast<unsigned>(address) + count) > EEPROM_SIZE_WORDS)
+    {
+        return E_NOT_OK;
+    }
+    for (uint16 i = 0; i < count; ++i)
+    {
+        const uint32 value = data[i];
+        if (eepromWords[address + i] == value)
+        {
+            continue;
+        }
+        if (programsBeforeCut == 0)
+        {
+            std::longjmp(powerCut, 1);
+        }
+        if (programsBeforeCut > 0)
+        {
+            --programsBeforeCut;
+        }
+        eepromWords[address + i] = value;
+        ++programs[address + i];
+    }
+    return E_OK;
+}
+
+namespace
+{
+
+DiagLog_EntryType entryFor(std::uint32_t serial)
+{
+    DiagLog_EntryType entry;
+    entry.ulTimeStamp = serial * 2654435761U;
+    entry.ucFailureCode = static_cast<uint8>((serial & 1U) ? 0x44 : 0x55);
+    entry.ucFailureSeat = static_cast<uint8>((serial & 2U) ? 0x66 : 0x77);
+    entry.ucHeatingLevel = static_cast<uint8>(serial % 4U);
+    return entry;
+}
+
+/* Every record of the store must match the appended serial of its sequence number */
+bool verify(const std::vector<std::uint32_t> &serialOfSequence, std::uint32_t newestSequence, std::string &error)
+{
+    const uint16 count = FaultStore_Count();
+    const std::uint32_t expected = std::min<std::uint32_t>(newestSequence, FAULT_STORE_RECORDS);
+    if (count != expected)
+    {
+        error = "record count " + std::to_string(count) + ", expected " + std::to_string(expected);
+        return false;
+    }
+
+    std::uint32_t previous = 0;
+    std::uint32_t valid = 0;
+    for (uint16 i = 0; i < count; ++i)
+    {
+        DiagLog_RecordType record;
+        if (FaultStore_Read(i, &record) != E_OK)
+        {
+            continue; /* The record torn by the cut */
+        }
+        ++valid;
+        const std::uint32_t sequence = static_cast<std::uint32_t>(record.ulSequence);
+        if (sequence <= previous || sequence >= serialOfSequence.size() || sequence + FAULT_STORE_RECORDS <= newestSequence)
+        {
+            error = "sequence " + std::to_string(sequence) + " out of order";
+            return false;
+        }
+        previous = sequence;
+        const DiagLog_EntryType want = entryFor(serialOfSequence[sequence]);
+        if (record.xEntry.ulTimeStamp != want.ulTimeStamp || record.xEntry.ucFailureCode != want.ucFailureCode ||
+            record.xEntry.ucFailureSeat != want.ucFailureSeat || record.xEntry.ucHeatingLevel != want.ucHeatingLevel)
+        {
+            error = "record " + std::to_string(sequence) + " does not match";
+            return false;
+        }
+    }
+
+    /* Every completed append survives, except the oldest one overwritten by the torn record */
+    if (newestSequence > 0 && previous != newestSequence)
+    {
+        error = "newest record " + std::to_string(newestSequence) + " lost, store ends at " + std::to_string(previous);
+        return false;
+    }
+    if (valid + 1U < expected)
+    {
+        error = std::to_string(valid) + " valid records, expected " + std::to_string(expected);
+        return false;
+    }
+    return true;
+}
+
+/* State of the power loss run, kept in memory across the longjmp() of a cut */
+struct PowerLossRun
+{
+    std::vector<std::uint32_t> serialOfSequence = std::vector<std::uint32_t>(1, 0U); /* Index 0 unused, sequences start at 1 */
+    std::uint32_t serial = 0;
+    std::uint32_t newestSequence = 0;
+    unsigned long appended = 0;
+};
+
+/* Append records until the supply is cut after programsLeft word programs, false if an append fails */
+bool appendUntilCut(PowerLossRun &run, long programsLeft)
+{
+    programsBeforeCut = programsLeft;
+    if (setjmp(powerCut) == 0)
+    {
+        for (;;)
+        {
+            const DiagLog_EntryType entry = entryFor(++run.serial);
+            run.serialOfSequence.push_back(run.serial);
+            if (FaultStore_Append(&entry) != E_OK)
+            {
+                return false;
+            }
+            run.newestSequence = static_cast<std::uint32_t>(run.serialOfSequence.size() - 1);
+            ++run.appended;
+        }
+    }
+
+    /* The sequence number of the interrupted append is given again after the recovery */
+    run.serialOfSequence.resize(run.newestSequence + 1);
+    programsBeforeCut = -1;
+    return true;
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+    std::string path = "fault_store.eeprom";
+    long trials = 1000;
+    long records = 100000;
+    double endurance = 500000.0;
+    double faultsPerHour = 10.0;
+    std::uint32_t seed = 1U;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        if (arg == "-f" && i + 1 < argc)
+        {
+            path = argv[++i];
+        }
+        else if (arg == "-p" && i + 1 < argc)
+        {
+            trials = std::strtol(argv[++i], nullptr, 10);
+        }
+        else if (arg == "-n" && i + 1 < argc)
+        {
+            records = std::strtol(argv[++i], nullptr, 10);
+        }
+        else if (arg == "-e" && i + 1 < argc)
+        {
+            endurance = std::strtod(argv[++i], nullptr);
+        }
+        else if (arg == "-F" && i + 1 < argc)
+        {
+            faultsPerHour = std::strtod(argv[++i], nullptr);
+        }
+        else if (arg == "-r" && i + 1 < argc)
+        {
+            seed = static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else
+        {
+            std::cerr << "usage: fault_store_sim [-f file] [-p trials] [-n records] [-e cycles] [-F faults per hour] [-r seed]\n";
+            return 1;
+        }
+    }
+
+    if (!mapImage(path))
+    {
+        return 1;
+    }
+
+    /* Power loss: append until the cut, then recover from the image and check it */
+    eraseImage();
+    std::mt19937 generator(seed);
+    std::uniform_int_distribution<long> cutDistribution(0, 3L * FAULT_STORE_RECORDS * FAULT_STORE_RECORD_WORDS);
+    PowerLossRun run;
+    long failures = 0;
+
+    for (long trial = 0; trial < trials; ++trial)
+    {
+        if (FaultStore_Init() != E_OK)
+        {
+            std::cerr << "trial " << trial << ": recovery failed\n";
+            return 2;
+        }
+
+        std::string error;
+        if (!verify(run.serialOfSequence, run.newestSequence, error))
+        {
+            std::cerr << "trial " << trial << ": " << error << "\n";
+            ++failures;
+        }
+
+        if (!appendUntilCut(run, cutDistribution(generator)))
+        {
+            std::cerr << "trial " << trial << ": append failed\n";
+            return 2;
+        }
+    }
+
+    std::cout << "power loss: " << trials << " cuts, " << run.appended << " records appended, " << failures << " bad recoveries\n";
+
+    /* Endurance */
+    eraseImage();
+    std::fill(programs.begin(), programs.end(), 0UL);
+    if (FaultStore_Init() != E_OK)
+    {
+        return 2;
+    }
+    for (long i = 0; i < records; ++i)
+    {
+        const DiagLog_EntryType entry = entryFor(static_cast<std::uint32_t>(i));
+        FaultStore_Append(&entry);
+    }
+
+    unsigned long maxPrograms = 0;
+    unsigned long minPrograms = ~0UL;
+    for (unsigned word = FAULT_STORE_EEPROM_ADDRESS; word < EEPROM_SIZE_WORDS; ++word)
+    {
+        maxPrograms = std::max(maxPrograms, programs[word]);
+        minPrograms = std::min(minPrograms, programs[word]);
+    }
+    const double recordsToWearOut = endurance * records / std::max(maxPrograms, 1UL);
+    std::cout << "endurance: " << records << " records over " << FAULT_STORE_RECORDS << " slots, word programs min " << minPrograms
+              << " max " << maxPrograms << "\n";
+    std::cout << "wear out after " << std::fixed << std::setprecision(0) << recordsToWearOut << " records, " << std::setprecision(1)
+              << recordsToWearOut / faultsPerHour / 24.0 / 365.0 << " years at " << faultsPerHour << " faults per hour\n";
+
+    munmap(eepromWords, EEPROM_SIZE_WORDS * sizeof(uint32));
+    return failures == 0 ? 0 : 2;
+}
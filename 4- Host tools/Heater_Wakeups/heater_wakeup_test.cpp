@@ -0,0 +1,757 @@
+/*
+ ============================================================================
+ Name        : heater_wakeup_test.cpp
+ Module Name : Heater Wakeup Test
+ Description : Counts the heater task wakeups and measures the latency from a heater input
+               change to the heater task and to the actuator write, from the kernel event
+               trace of the firmware (Control/Trace.c, TRACE_RECORDER = 1). The sensor and
+               button tasks record TRACE_EVENT_HEATER_INPUT when a temperature reading or a
+               desired temperature changes, and the heater tasks record
+               TRACE_EVENT_HEATER_OUTPUT when they write a new duty cycle or new heater LEDs.
+               A heater task pass runs from its first switch in after it blocked to its next
+               delay or notification wait; an input is handled by the next pass, and its
+               actuator latency ends at the first output write of that pass.
+               - Default: the driver seat scheduling of main.c is simulated for 10 minutes
+                 (warm up, a stable phase, then a lower heating level), once with the polling
+                 heater task (mainHEATER_EVENT_DRIVEN 0, a pass every 250 ms) and once with
+                 the event driven one (woken by the notifications of the sensor and button
+                 tasks, or by the 2500 ms watchdog). Every job is recorded through the
+                 firmware Trace module with a host cycle counter and dumped every 10 s in the
+                 "trace dump" format, and each capture is decoded and measured like a board
+                 capture. The event driven task must wake at least 5 times less often in the
+                 stable phase, reach the actuator within 5 ms of every input, never sleep
+                 more than the watchdog period, and every capture must be complete.
+               - <capture>: the measures of a "trace dump" capture of the board, per seat.
+
+ Build       : FW="../../1- Application project/FreeRTOS_Final_Project_WS/Seat_Heater_Control_System"
+               INC=(-I"$FW/Common" -I"$FW/Control")
+               gcc -O2 -DTRACE_HOST -DTRACE_RECORDER=1 "${INC[@]}" -c "$FW/Control/Trace.c"
+               g++ -std=c++17 -O2 -DTRACE_RECORDER=1 "${INC[@]}" -o heater_wakeup_test heater_wakeup_test.cpp Trace.o
+ Usage       : heater_wakeup_test [options] [capture]
+               -o <file>         Write the simulated capture of the stable phase, at 300 s, for the
+                                 trace converter (trace_to_json).
+               -p                With -o, the capture of the polling run instead of the event driven one.
+               -s <seed>         Seed of the simulated temperature readings, default 1.
+
+ Exit status : 0, 2 when a check of the simulation fails, 1 on input errors.
+ ============================================================================
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+extern "C"
+{
+#include "Std_Types.h"
+#include "Trace.h"
+
+uint32 Trace_HostCycles(void);
+}
+
+namespace
+{
+
+/* Task tags of main.c (vTaskSetApplicationTaskTag), the idle task is mainRUNTIME_TAG_IDLE */
+constexpr int kDriverSensorTag = 1;
+constexpr int kDriverButtonTag = 3;
+constexpr int kDriverHeaterTag = 7;
+constexpr int kPassengerHeaterTag = 8;
+constexpr int kIdleTag = 14;
+constexpr int kSeats = 2;
+
+/* Scheduling of main.c, in ms */
+constexpr unsigned long kRunMs = 600000UL;
+constexpr unsigned long kSensorPeriodMs = 100UL;     /* mainSENSOR_TASK_DELAY */
+constexpr unsigned long kHeaterPeriodMs = 250UL;     /* mainHEATER_TASK_DELAY */
+constexpr unsigned long kHeaterWatchdogMs = 2500UL;  /* mainHEATER_WATCHDOG_DELAY */
+constexpr unsigned long kCaptureMs = 10000UL;        /* A dump at the first heater pass after 10 s */
+constexpr unsigned long kStableStartMs = 120000UL;
+constexpr unsigned long kStableEndMs = 480000UL;
+constexpr unsigned long kCaptureAtMs = 300000UL;     /* Capture written by -o */
+constexpr std::uint64_t kCyclesPerUs = 16U;          /* 16 MHz */
+constexpr std::uint64_t kCyclesPerMs = 16000U;
+
+/* Execution times of the jobs, in cycles */
+constexpr std::uint64_t kSwitchCycles = 5U * kCyclesPerUs;
+constexpr std::uint64_t kSensorCycles = 80U * kCyclesPerUs;
+constexpr std::uint64_t kButtonCycles = 30U * kCyclesPerUs;
+constexpr std::uint64_t kHeaterCycles = 40U * kCyclesPerUs;
+constexpr std::uint64_t kOutputCycles = 10U * kCyclesPerUs;
+
+/* Limits of the checks */
+constexpr double kWakeupRatio = 5.0;
+constexpr double kEventLatencyLimitMs = 5.0;
+
+/* Desired temperatures of the heating levels (Settings defaults: off, 25, 30, 35 C) */
+constexpr int kDesiredHigh = 35;
+constexpr int kDesiredLow = 25;
+
+struct Record
+{
+    std::uint16_t delta = 0;
+    std::uint8_t event = 0;
+    std::uint8_t object = 0;
+};
+
+/* A "trace dump" reply, only the task names are kept */
+struct Dump
+{
+    unsigned long lost = 0;
+    unsigned long cpuHz = 16000000UL;
+    unsigned shift = TRACE_TIME_SHIFT;
+    std::map<int, std::string> tasks;
+    std::vector<Record> records;
+};
+
+/* A decoded record, its time in units since "trace start" (since the oldest record when records were lost) */
+struct Event
+{
+    unsigned long long time = 0;
+    int event = 0;
+    int object = 0;
+};
+
+/* Minimum, mean and maximum of a latency, in ms */
+struct Latency
+{
+    unsigned long count = 0;
+    double sum = 0.0;
+    double min = 0.0;
+    double max = 0.0;
+
+    void add(double ms)
+    {
+        min = (count == 0) ? ms : std::min(min, ms);
+        max = (count == 0) ? ms : std::max(max, ms);
+        sum += ms;
+        count++;
+    }
+
+    void merge(const Latency &other)
+    {
+        if (other.count != 0)
+        {
+            min = (count == 0) ? other.min : std::min(min, other.min);
+            max = (count == 0) ? other.max : std::max(max, other.max);
+            sum += other.sum;
+            count += other.count;
+        }
+    }
+};
+
+/* Measures of a heater task in one or more captures */
+struct SeatStats
+{
+    double durationMs = 0.0;
+    unsigned long wakeups = 0;       /* Heater task passes */
+    unsigned long notifications = 0; /* Notifications given to the heater task */
+    unsigned long inputs = 0;
+    unsigned long outputs = 0;
+    unsigned long unchanged = 0;     /* Passes that handled an input without writing the output */
+    unsigned long unhandled = 0;     /* Inputs still waiting for a pass at the end of a capture */
+    double longestSleepMs = 0.0;     /* Between the starts of two passes */
+    Latency wake;                    /* Input to the start of the pass */
+    Latency actuator;                /* Input to the output write */
+
+    void merge(const SeatStats &other)
+    {
+        durationMs += other.durationMs;
+        wakeups += other.wakeups;
+        notifications += other.notifications;
+        inputs += other.inputs;
+        outputs += other.outputs;
+        unchanged += other.unchanged;
+        unhandled += other.unhandled;
+        longestSleepMs = std::max(longestSleepMs, other.longestSleepMs);
+        wake.merge(other.wake);
+        actuator.merge(other.actuator);
+    }
+
+    double wakeupsPerMinute() const
+    {
+        return (durationMs > 0.0) ? (static_cast<double>(wakeups) * 60000.0 / durationMs) : 0.0;
+    }
+};
+
+/* Cycle counter of the simulation, read by the Trace module */
+std::uint32_t hostCycles = 0;
+
+std::vector<std::string> splitFields(const std::string &line)
+{
+    std::vector<std::string> fields;
+    std::stringstream ss(line);
+    std::string field;
+    while (std::getline(ss, field, ','))
+    {
+        fields.push_back(field);
+    }
+    return fields;
+}
+
+/* Reads the line starting at pos, without its end of line, and moves pos after it */
+bool nextLine(const std::string &data, std::size_t &pos, std::string &line)
+{
+    if (pos >= data.size())
+    {
+        return false;
+    }
+    std::size_t end = data.find('\n', pos);
+    if (end == std::string::npos)
+    {
+        end = data.size();
+    }
+    line = data.substr(pos, end - pos);
+    if (!line.empty() && (line.back() == '\r'))
+    {
+        line.pop_back();
+    }
+    pos = end + 1;
+    return true;
+}
+
+bool parseDump(const std::string &data, Dump &dump)
+{
+    std::size_t pos = data.find("TRACE,DUMP,");
+    std::string line;
+    unsigned long count = 0;
+
+    if (pos == std::string::npos)
+    {
+        std::cerr << "No \"TRACE,DUMP\" line in the capture\n";
+        return false;
+    }
+    nextLine(data, pos, line);
+    std::vector<std::string> fields = splitFields(line);
+    if (fields.size() < 6)
+    {
+        std::cerr << "Bad line: " << line << "\n";
+        return false;
+    }
+    dump.lost = std::stoul(fields[3]);
+    dump.cpuHz = std::stoul(fields[4]);
+    dump.shift = static_cast<unsigned>(std::stoul(fields[5]));
+
+    for (;;)
+    {
+        if (!nextLine(data, pos, line))
+        {
+            std::cerr << "No \"TRACE,DATA\" line in the capture\n";
+            return false;
+        }
+        fields = splitFields(line);
+        if ((fields.size() >= 4) && (fields[1] == "TASK"))
+        {
+            dump.tasks[std::stoi(fields[2])] = fields[3];
+        }
+        else if ((fields.size() >= 3) && (fields[1] == "DATA"))
+        {
+            count = std::stoul(fields[2]);
+            break;
+        }
+    }
+
+    if (data.size() - pos < count * 4UL)
+    {
+        std::cerr << "Capture ends after " << (data.size() - pos) / 4 << " of " << count << " records\n";
+        return false;
+    }
+    for (unsigned long i = 0; i < count; i++, pos += 4)
+    {
+        Record record;
+        record.delta = static_cast<std::uint16_t>(static_cast<unsigned char>(data[pos]) |
+                                                  (static_cast<unsigned char>(data[pos + 1]) << 8));
+        record.event = static_cast<std::uint8_t>(data[pos + 2]);
+        record.object = static_cast<std::uint8_t>(data[pos + 3]);
+        dump.records.push_back(record);
+    }
+    return true;
+}
+
+/* Times of the records, as the trace converter decodes them */
+std::vector<Event> decode(const Dump &dump)
+{
+    std::vector<Event> events;
+    unsigned long long time = 0;
+    bool first = true;
+
+    for (const Record &record : dump.records)
+    {
+        if (record.event == TRACE_EVENT_TIME)
+        {
+            if (!first || (dump.lost == 0))
+            {
+                time += static_cast<unsigned long long>(record.delta) << 16;
+            }
+            continue;
+        }
+        if (!first || (dump.lost == 0))
+        {
+            time += record.delta;
+        }
+        first = false;
+        events.push_back({ time, record.event, record.object });
+    }
+    return events;
+}
+
+/* Seat of a heater task tag, -1 for the other tasks */
+int heaterSeat(int tag)
+{
+    return (tag == kDriverHeaterTag) ? 0 : ((tag == kPassengerHeaterTag) ? 1 : -1);
+}
+
+/*
+ * Measures the heater tasks of a capture. The first pass of a capture may have started before it, and
+ * only the inputs recorded after the start of a pass wait for the next one.
+ */
+void analyze(const Dump &dump, const std::vector<Event> &events, SeatStats stats[kSeats])
+{
+    const double msPerUnit = static_cast<double>(1UL << dump.shift) * 1e3 / static_cast<double>(dump.cpuHz);
+    bool inPass[kSeats] = { false, false };
+    bool pending[kSeats] = { false, false };  /* An input waits for the next pass */
+    bool handling[kSeats] = { false, false }; /* The running pass handles an input */
+    double pendingMs[kSeats] = { 0.0, 0.0 };
+    double handlingMs[kSeats] = { 0.0, 0.0 };
+    double passMs[kSeats] = { -1.0, -1.0 };
+
+    for (const Event &event : events)
+    {
+        const double ms = static_cast<double>(event.time) * msPerUnit;
+        const int seat = ((event.event == TRACE_EVENT_HEATER_INPUT) || (event.event == TRACE_EVENT_HEATER_OUTPUT)) ? event.object
+                                                                                                                  : heaterSeat(event.object);
+        if ((seat < 0) || (seat >= kSeats))
+        {
+            continue;
+        }
+        SeatStats &seatStats = stats[seat];
+
+        switch (event.event)
+        {
+        case TRACE_EVENT_HEATER_INPUT:
+            seatStats.inputs++;
+            if (!pending[seat])
+            {
+                pending[seat] = true;
+                pendingMs[seat] = ms;
+            }
+            break;
+        case TRACE_EVENT_TASK_NOTIFY:
+            seatStats.notifications++;
+            break;
+        case TRACE_EVENT_TASK_SWITCHED_IN:
+            if (!inPass[seat])
+            {
+                inPass[seat] = true;
+                if (passMs[seat] >= 0.0)
+                {
+                    seatStats.longestSleepMs = std::max(seatStats.longestSleepMs, ms - passMs[seat]);
+                }
+                passMs[seat] = ms;
+                handling[seat] = pending[seat];
+                handlingMs[seat] = pendingMs[seat];
+                if (pending[seat])
+                {
+                    seatStats.wake.add(ms - pendingMs[seat]);
+                }
+                pending[seat] = false;
+            }
+            break;
+        case TRACE_EVENT_HEATER_OUTPUT:
+            seatStats.outputs++;
+            if (handling[seat])
+            {
+                seatStats.actuator.add(ms - handlingMs[seat]);
+                handling[seat] = false;
+            }
+            break;
+        case TRACE_EVENT_TASK_DELAY:
+        case TRACE_EVENT_TASK_NOTIFY_WAIT:
+            if (inPass[seat])
+            {
+                seatStats.wakeups++;
+                seatStats.unchanged += handling[seat] ? 1U : 0U;
+            }
+            inPass[seat] = false;
+            handling[seat] = false;
+            break;
+        default:
+            break;
+        }
+    }
+
+    for (int seat = 0; seat < kSeats; seat++)
+    {
+        stats[seat].unhandled += pending[seat] ? 1U : 0U;
+        stats[seat].durationMs += events.empty() ? 0.0 : (static_cast<double>(events.back().time - events.front().time) * msPerUnit);
+    }
+}
+
+void printStats(const std::string &title, const SeatStats &stats)
+{
+    std::cout << title << ": " << stats.wakeups << " heater task wakeups in " << std::setprecision(1) << stats.durationMs / 1000.0
+              << " s, " << stats.wakeupsPerMinute() << " per minute, longest sleep " << stats.longestSleepMs << " ms\n";
+    std::cout << "  " << stats.inputs << " input changes, " << stats.notifications << " notifications, " << stats.outputs
+              << " output writes, " << stats.unchanged << " passes without a new output, " << stats.unhandled
+              << " inputs not handled in the capture\n";
+    std::cout << std::setprecision(2);
+    if (stats.wake.count != 0)
+    {
+        std::cout << "  input to wakeup:   min " << stats.wake.min << " ms, mean " << stats.wake.sum / stats.wake.count << " ms, max "
+                  << stats.wake.max << " ms (" << stats.wake.count << ")\n";
+    }
+    if (stats.actuator.count != 0)
+    {
+        std::cout << "  input to actuator: min " << stats.actuator.min << " ms, mean " << stats.actuator.sum / stats.actuator.count
+                  << " ms, max " << stats.actuator.max << " ms (" << stats.actuator.count << ")\n";
+    }
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+/* Reply of "trace dump" for the records of the Trace module, as main.c sends it */
+std::string hostDump()
+{
+    static const std::map<int, std::string> tasks = {
+        { kDriverSensorTag, "Driver Sensor" }, { kDriverButtonTag, "Driver Button" }, { kDriverHeaterTag, "Driver Heater" }, { kIdleTag, "IDLE" }
+    };
+    std::ostringstream out;
+    Trace_RecordType record;
+    uint32 lost = 0;
+    const uint16 count = Trace_Count(&lost);
+
+    out << "TRACE,DUMP," << count << "," << lost << ",16000000," << TRACE_TIME_SHIFT << "\r\n";
+    for (const auto &task : tasks)
+    {
+        out << "TRACE,TASK," << task.first << "," << task.second << "\r\n";
+    }
+    out << "TRACE,DATA," << count << "\r\n";
+    for (uint16 i = 0; Trace_Read(i, &record) == E_OK; i++)
+    {
+        out << static_cast<char>(record.usDelta & 0xFFU) << static_cast<char>(record.usDelta >> 8)
+            << static_cast<char>(record.ucEvent) << static_cast<char>(record.ucObject);
+    }
+    out << "TRACE,END\r\n";
+    return out.str();
+}
+
+/* Inputs of the driver seat, the same in both runs */
+struct Profile
+{
+    std::vector<int> readings;                          /* LM35 reading of each sensor period */
+    std::vector<std::pair<unsigned long, int>> presses; /* Time in ms and new desired temperature */
+};
+
+/*
+ * The seat warms from 12 to 34 C in the first 90 s, then the reading moves between 34 and 35 C about
+ * every 15 s (the stable phase is 120 s to 480 s), and from 510 s the seat cools to 26 C on the low level.
+ */
+Profile makeProfile(unsigned seed)
+{
+    std::mt19937 random(seed);
+    Profile profile;
+    int held = 34;
+
+    for (unsigned long ms = 0; ms < kRunMs; ms += kSensorPeriodMs)
+    {
+        const double s = static_cast<double>(ms) / 1000.0;
+        if (s < 90.0)
+        {
+            profile.readings.push_back(12 + static_cast<int>(22.0 * s / 90.0));
+        }
+        else if (s < 510.0)
+        {
+            held = ((random() % 150U) == 0U) ? (69 - held) : held;
+            profile.readings.push_back(held);
+        }
+        else
+        {
+            profile.readings.push_back(34 - static_cast<int>(8.0 * (s - 510.0) / 90.0));
+        }
+    }
+    profile.presses = { { 1003UL, kDesiredHigh }, { 510007UL, kDesiredLow } };
+    return profile;
+}
+
+/* Heater output of a pass, a stand-in of the heater state table of the Settings module */
+int heaterOutput(int desired, int reading)
+{
+    const int diff = desired - reading;
+    return (diff <= 0) ? 0 : ((diff >= 10) ? 3 : ((diff >= 5) ? 2 : 1));
+}
+
+/*
+ * Runs the driver sensor, button and heater tasks of main.c on a simulated 16 MHz CPU and measures the
+ * captures. The tick readies the delayed tasks at the start of a ms, then the ready tasks run by priority
+ * (sensor 4, button 3, heater 1) to completion: the jobs take tens of us, none is released while one runs.
+ */
+void simulate(const Profile &profile, bool eventDriven, SeatStats &all, SeatStats &stable, std::string *capture, bool &complete)
+{
+    std::uint64_t now = 0;
+    std::uint64_t captureStart = 0;
+    unsigned long watchdogMs = kHeaterWatchdogMs;
+    int reading = 0;
+    int desired = 0;
+    int output = -1;
+    bool notified = true; /* The first pass runs at the start */
+    std::size_t press = 0;
+
+    auto record = [&now](unsigned event, int object) {
+        hostCycles = static_cast<std::uint32_t>(now);
+        Trace_Record(static_cast<uint8>(event), static_cast<uint8>(object));
+    };
+    auto notifyHeater = [&]() {
+        if (eventDriven)
+        {
+            record(TRACE_EVENT_TASK_NOTIFY, kDriverHeaterTag);
+            record(TRACE_EVENT_TASK_READY, kDriverHeaterTag);
+            notified = true;
+        }
+    };
+    auto dump = [&](unsigned long ms) {
+        Dump parsed;
+        SeatStats stats[kSeats];
+
+        Trace_Stop();
+        const std::string data = hostDump();
+        if (!parseDump(data, parsed) || (parsed.lost != 0))
+        {
+            std::cerr << (eventDriven ? "Event driven" : "Polling") << " capture at " << ms << " ms: " << parsed.lost
+                      << " records overwritten\n";
+            complete = false;
+        }
+        analyze(parsed, decode(parsed), stats);
+        all.merge(stats[0]);
+        if ((captureStart >= kStableStartMs * kCyclesPerMs) && (ms <= kStableEndMs))
+        {
+            stable.merge(stats[0]);
+        }
+        if ((capture != nullptr) && (captureStart <= kCaptureAtMs * kCyclesPerMs) && (ms >= kCaptureAtMs))
+        {
+            *capture = data;
+        }
+        captureStart = now;
+        Trace_Start();
+    };
+
+    hostCycles = 0;
+    Trace_Start();
+    for (unsigned long ms = 0; ms < kRunMs; ms++)
+    {
+        const bool sensor = (ms % kSensorPeriodMs) == 0U;
+        const bool button = (press < profile.presses.size()) && (profile.presses[press].first == ms);
+        const bool heaterTick = eventDriven ? (ms == watchdogMs) : ((ms % kHeaterPeriodMs) == 0U);
+        bool ran = false;
+
+        now = static_cast<std::uint64_t>(ms) * kCyclesPerMs;
+        if (sensor)
+        {
+            record(TRACE_EVENT_TASK_READY, kDriverSensorTag);
+        }
+        if (button)
+        {
+            record(TRACE_EVENT_TASK_READY, kDriverButtonTag);
+        }
+        if (heaterTick)
+        {
+            record(TRACE_EVENT_TASK_READY, kDriverHeaterTag);
+        }
+
+        if (sensor)
+        {
+            now += kSwitchCycles;
+            record(TRACE_EVENT_TASK_SWITCHED_IN, kDriverSensorTag);
+            now += kSensorCycles;
+            if (profile.readings[ms / kSensorPeriodMs] != reading)
+            {
+                reading = profile.readings[ms / kSensorPeriodMs];
+                record(TRACE_EVENT_HEATER_INPUT, 0);
+                notifyHeater();
+            }
+            record(TRACE_EVENT_TASK_DELAY, kDriverSensorTag);
+            ran = true;
+        }
+        if (button)
+        {
+            now += kSwitchCycles;
+            record(TRACE_EVENT_TASK_SWITCHED_IN, kDriverButtonTag);
+            now += kButtonCycles;
+            desired = profile.presses[press++].second;
+            record(TRACE_EVENT_HEATER_INPUT, 0);
+            notifyHeater();
+            record(TRACE_EVENT_TASK_DELAY, kDriverButtonTag);
+            ran = true;
+        }
+        if (heaterTick || (eventDriven && notified))
+        {
+            now += kSwitchCycles;
+            record(TRACE_EVENT_TASK_SWITCHED_IN, kDriverHeaterTag);
+            now += kHeaterCycles;
+            if (heaterOutput(desired, reading) != output)
+            {
+                output = heaterOutput(desired, reading);
+                now += kOutputCycles;
+                record(TRACE_EVENT_HEATER_OUTPUT, 0);
+            }
+            record(eventDriven ? TRACE_EVENT_TASK_NOTIFY_WAIT : TRACE_EVENT_TASK_DELAY, kDriverHeaterTag);
+            notified = false;
+            watchdogMs = ms + kHeaterWatchdogMs;
+            if ((now - captureStart) >= kCaptureMs * kCyclesPerMs)
+            {
+                dump(ms);
+            }
+            ran = true;
+        }
+        if (ran)
+        {
+            now += kSwitchCycles;
+            record(TRACE_EVENT_TASK_SWITCHED_IN, kIdleTag);
+        }
+    }
+    dump(kRunMs);
+    Trace_Stop();
+}
+
+int runSimulation(unsigned seed, const std::string &outputPath, bool polling)
+{
+    const Profile profile = makeProfile(seed);
+    SeatStats all[2];
+    SeatStats stable[2];
+    std::string capture;
+    bool complete = true;
+    int errors = 0;
+
+    simulate(profile, false, all[0], stable[0], polling ? &capture : nullptr, complete);
+    simulate(profile, true, all[1], stable[1], polling ? nullptr : &capture, complete);
+
+    std::cout << std::fixed;
+    printStats("Polling, whole run", all[0]);
+    printStats("Polling, stable phase", stable[0]);
+    printStats("Event driven, whole run", all[1]);
+    printStats("Event driven, stable phase", stable[1]);
+
+    if (!complete)
+    {
+        std::cerr << "FAIL: records were overwritten, the captures are too long for the trace buffer\n";
+        errors++;
+    }
+    if ((all[0].unhandled + all[1].unhandled) != 0U)
+    {
+        std::cerr << "FAIL: " << all[0].unhandled + all[1].unhandled << " inputs were not handled by a heater pass\n";
+        errors++;
+    }
+    if ((stable[1].wakeupsPerMinute() * kWakeupRatio) > stable[0].wakeupsPerMinute())
+    {
+        std::cerr << "FAIL: the event driven heater task wakes " << stable[1].wakeupsPerMinute() << " times per minute in the stable phase, "
+                  << "not " << kWakeupRatio << " times less than polling (" << stable[0].wakeupsPerMinute() << ")\n";
+        errors++;
+    }
+    if ((all[1].actuator.count == 0) || (all[1].actuator.max > kEventLatencyLimitMs))
+    {
+        std::cerr << "FAIL: event driven input to actuator latency up to " << all[1].actuator.max << " ms, over " << kEventLatencyLimitMs << " ms\n";
+        errors++;
+    }
+    if (all[1].longestSleepMs > static_cast<double>(kHeaterWatchdogMs) + 1.0)
+    {
+        std::cerr << "FAIL: the event driven heater task slept " << all[1].longestSleepMs << " ms, over the " << kHeaterWatchdogMs
+                  << " ms watchdog\n";
+        errors++;
+    }
+
+    if (!outputPath.empty())
+    {
+        std::ofstream file(outputPath, std::ios::binary);
+        if (!file)
+        {
+            std::cerr << "Cannot write " << outputPath << "\n";
+            return 1;
+        }
+        file << capture;
+    }
+    std::cout << ((errors == 0) ? "PASS" : "FAIL") << "\n";
+    return (errors == 0) ? 0 : 2;
+}
+
+void usage()
+{
+    std::cerr << "Usage: heater_wakeup_test [-o <file>] [-p] [-s <seed>] [capture]\n";
+}
+
+} /* namespace */
+
+uint32 Trace_HostCycles(void)
+{
+    return hostCycles;
+}
+
+int main(int argc, char *argv[])
+{
+    std::string outputPath;
+    std::string inputPath;
+    bool polling = false;
+    unsigned seed = 1;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const std::string arg = argv[i];
+        if ((arg == "-o") && (i + 1 < argc))
+        {
+            outputPath = argv[++i];
+        }
+        else if (arg == "-p")
+        {
+            polling = true;
+        }
+        else if ((arg == "-s") && (i + 1 < argc))
+        {
+            seed = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else if ((arg[0] != '-') && inputPath.empty())
+        {
+            inputPath = arg;
+        }
+        else
+        {
+            usage();
+            return 1;
+        }
+    }
+
+    if (inputPath.empty())
+    {
+        return runSimulation(seed, outputPath, polling);
+    }
+
+    std::ifstream file(inputPath, std::ios::binary);
+    std::string data;
+    Dump dump;
+    SeatStats stats[kSeats];
+    if (!file)
+    {
+        std::cerr << "Cannot open " << inputPath << "\n";
+        return 1;
+    }
+    data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    if (!parseDump(data, dump))
+    {
+        return 1;
+    }
+    if (dump.lost != 0)
+    {
+        std::cerr << "Warning: " << dump.lost << " records overwritten, the first pass of each heater task may be partial\n";
+    }
+    analyze(dump, decode(dump), stats);
+    std::cout << std::fixed;
+    printStats("Driver heater", stats[0]);
+    printStats("Passenger heater", stats[1]);
+    return 0;
+}
@@ -0,0 +1,339 @@
+/*
+ ============================================================================
+ Name        : lock_profile_test.cpp
+ Module Name : Lock Profile Test
+ Description : Host test bench of the mutex contention and blocking time profiler (firmware
+               Control/LockProfile.c). A random history of tasks taking and giving mutexes is
+               played through the kernel hooks in the order queue.c calls them, with a 32 bit
+               cycle counter that wraps during the run:
+               - a free mutex is taken at once, a held one blocks the task (and the holder
+                 inherits its priority when it is lower), or fails at once for a poll,
+               - a give hands the mutex to the highest priority waiter, or another task takes
+                 it first and the woken waiter blocks again in the same take,
+               - a waiting task may time out.
+               The statistics of every profiled mutex must match the history: acquisitions,
+               contended acquisitions, total and longest wait and hold, inheritances and
+               timeouts, also after a clear in the middle of the run. The mutexes created
+               once the profiler is full must be ignored.
+
+ Build       : FW="../../1- Application project/FreeRTOS_Final_Project_WS/Seat_Heater_Control_System"
+               INC=(-I"$FW/Common" -I"$FW/Control")
+               gcc -O2 -DLOCK_PROFILE_HOST "${INC[@]}" -c "$FW/Control/LockProfile.c"
+               g++ -std=c++17 -O2 "${INC[@]}" -o lock_profile_test lock_profile_test.cpp LockProfile.o
+ Usage       : lock_profile_test [options]
+               -n <steps>        Steps of the history, default 200000.
+               -t <tasks>        Tasks, default 6.
+               -r <seed>         Random seed, default 1.
+
+ Exit status : 0 when the statistics match, 2 otherwise, 1 on input errors.
+ ============================================================================
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+extern "C"
+{
+#include "Std_Types.h"
+#include "LockProfile.h"
+}
+
+namespace
+{
+
+/* The cycle counter wraps shortly after the start */
+std::uint64_t now = 0x100000000ULL - 16000000ULL;
+
+/* Mutexes used, two more than the profiler keeps */
+constexpr unsigned kMutexes = LOCK_PROFILE_MAX_MUTEXES + 2U;
+
+struct Expected
+{
+    std::uint64_t waitSum = 0;
+    std::uint64_t holdSum = 0;
+    unsigned long acquisitions = 0;
+    unsigned long contended = 0;
+    unsigned long timeouts = 0;
+    unsigned long inherits = 0;
+    std::uint64_t waitMax = 0;
+    std::uint64_t holdMax = 0;
+};
+
+struct Mutex
+{
+    int handle = 0; /* Its address is the mutex handle */
+    int holder = -1;
+    std::uint64_t takenAt = 0;
+    std::vector<int> waiters;
+    Expected stats;
+};
+
+struct Task
+{
+    std::uint32_t tag = 0;
+    int priority = 0;
+    int waitingOn = -1;
+    std::uint64_t waitSince = 0;
+    std::vector<int> held;
+};
+
+std::vector<Mutex> mutexes(kMutexes);
+std::vector<Task> tasks;
+
+void *handle(int mutex)
+{
+    return &mutexes[mutex].handle;
+}
+
+void take(int task, int mutex)
+{
+    Mutex &m = mutexes[mutex];
+    Task &t = tasks[task];
+
+    LockProfile_Taken(handle(mutex), t.tag);
+    ++m.stats.acquisitions;
+    if (t.waitingOn == mutex)
+    {
+        const std::uint64_t wait = now - t.waitSince;
+        ++m.stats.contended;
+        m.stats.waitSum += wait;
+        m.stats.waitMax = std::max(m.stats.waitMax, wait);
+        t.waitingOn = -1;
+        m.waiters.erase(std::find(m.waiters.begin(), m.waiters.end(), task));
+    }
+    m.holder = task;
+    m.takenAt = now;
+    t.held.push_back(mutex);
+}
+
+/* The task blocks on a held mutex, its wait starts unless it already waits for it */
+void block(int task, int mutex)
+{
+    Mutex &m = mutexes[mutex];
+    Task &t = tasks[task];
+
+    LockProfile_Blocking(handle(mutex), t.tag);
+    if (t.waitingOn != mutex)
+    {
+        t.waitingOn = mutex;
+        t.waitSince = now;
+        m.waiters.push_back(task);
+    }
+    if (t.priority > tasks[m.holder].priority)
+    {
+        LockProfile_Inherited();
+        ++m.stats.inherits;
+    }
+}
+
+void give(int task, int mutex, std::mt19937 &random)
+{
+    Mutex &m = mutexes[mutex];
+    Task &t = tasks[task];
+
+    LockProfile_Given(handle(mutex));
+    const std::uint64_t hold = now - m.takenAt;
+    m.stats.holdSum += hold;
+    m.stats.holdMax = std::max(m.stats.holdMax, hold);
+    m.holder = -1;
+    t.held.erase(std::find(t.held.begin(), t.held.end(), mutex));
+
+    if (m.waiters.empty())
+    {
+        return;
+    }
+
+    /* The kernel wakes the highest priority waiter, the first one among equals */
+    int woken = m.waiters.front();
+    for (int waiter : m.waiters)
+    {
+        if (tasks[waiter].priority > tasks[woken].priority)
+        {
+            woken = waiter;
+        }
+    }
+
+    /* Before the woken task runs, another one may take the mutex: the woken one blocks again */
+    const int other = static_cast<int>(random() % tasks.size());
+    if (((random() % 5U) == 0U) && (tasks[other].waitingOn < 0) &&
+        (std::find(tasks[other].held.begin(), tasks[other].held.end(), mutex) == tasks[other].held.end()))
+    {
+        take(other, mutex);
+        block(woken, mutex);
+    }
+    else
+    {
+        take(woken, mutex);
+    }
+}
+
+void clearExpected()
+{
+    for (Mutex &m : mutexes)
+    {
+        m.stats = Expected();
+    }
+}
+
+int check()
+{
+    int errors = 0;
+
+    if (LockProfile_Count() != LOCK_PROFILE_MAX_MUTEXES)
+    {
+        std::cerr << "profiled mutexes " << static_cast<unsigned>(LockProfile_Count()) << "\n";
+        ++errors;
+    }
+    for (unsigned i = 0; i < LOCK_PROFILE_MAX_MUTEXES; ++i)
+    {
+        void *pvMutex = nullptr;
+        LockProfile_StatsType stats;
+        const Expected &want = mutexes[i].stats;
+
+        if ((LockProfile_Read(static_cast<uint8>(i), &pvMutex, &stats) != E_OK) || (pvMutex != handle(static_cast<int>(i))))
+        {
+            std::cerr << "mutex " << i << ": not readable\n";
+            ++errors;
+            continue;
+        }
+        if ((stats.ulAcquisitions != want.acquisitions) || (stats.ulContended != want.contended) || (stats.ulTimeouts != want.timeouts) ||
+            (stats.ulInherits != want.inherits) || (stats.ullWaitSum != want.waitSum) || (stats.ulWaitMax != want.waitMax) ||
+            (stats.ullHoldSum != want.holdSum) || (stats.ulHoldMax != want.holdMax))
+        {
+            std::cerr << "mutex " << i << ": got " << stats.ulAcquisitions << "/" << stats.ulContended << "/" << stats.ulTimeouts << "/"
+                      << stats.ulInherits << " wait " << stats.ullWaitSum << "/" << stats.ulWaitMax << " hold " << stats.ullHoldSum << "/"
+                      << stats.ulHoldMax << ", expected " << want.acquisitions << "/" << want.contended << "/" << want.timeouts << "/"
+                      << want.inherits << " wait " << want.waitSum << "/" << want.waitMax << " hold " << want.holdSum << "/"
+                      << want.holdMax << "\n";
+            ++errors;
+        }
+    }
+    return errors;
+}
+
+}
+
+/* Cycle counter of the host build of the LockProfile module */
+extern "C" uint32 LockProfile_HostCycles(void)
+{
+    return static_cast<uint32>(now & 0xFFFFFFFFULL);
+}
+
+int main(int argc, char *argv[])
+{
+    long steps = 200000;
+    long taskCount = 6;
+    std::uint32_t seed = 1U;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        if (arg == "-n" && i + 1 < argc)
+        {
+            steps = std::strtol(argv[++i], nullptr, 10);
+        }
+        else if (arg == "-t" && i + 1 < argc)
+        {
+            taskCount = std::strtol(argv[++i], nullptr, 10);
+        }
+        else if (arg == "-r" && i + 1 < argc)
+        {
+            seed = static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else
+        {
+            std::cerr << "usage: lock_profile_test [-n steps] [-t tasks] [-r seed]\n";
+            return 1;
+        }
+    }
+    if ((steps <= 0) || (taskCount < 2) || (taskCount > static_cast<long>(LOCK_PROFILE_MAX_TASKS)))
+    {
+        std::cerr << "lock_profile_test: 2 to " << LOCK_PROFILE_MAX_TASKS << " tasks\n";
+        return 1;
+    }
+
+    std::mt19937 random(seed);
+    tasks.resize(static_cast<std::size_t>(taskCount));
+    for (std::size_t i = 0; i < tasks.size(); ++i)
+    {
+        /* The last task has a tag out of range, it uses slot 0 */
+        tasks[i].tag = (i + 1 < tasks.size()) ? static_cast<std::uint32_t>(i + 1U) : 99U;
+        tasks[i].priority = 1 + static_cast<int>(random() % 4U);
+    }
+
+    /* As the kernel: each mutex is given once at its creation */
+    for (unsigned i = 0; i < kMutexes; ++i)
+    {
+        LockProfile_Created(handle(static_cast<int>(i)));
+        LockProfile_Given(handle(static_cast<int>(i)));
+    }
+
+    for (long step = 0; step < steps; ++step)
+    {
+        now += ((random() % 2000U) == 0U) ? 8000000U : (random() % 5000U);
+        if (step == steps / 2)
+        {
+            LockProfile_Clear();
+            clearExpected();
+        }
+
+        const int task = static_cast<int>(random() % tasks.size());
+        Task &t = tasks[task];
+
+        if (t.waitingOn >= 0)
+        {
+            if ((random() % 5U) == 0U)
+            {
+                Mutex &m = mutexes[t.waitingOn];
+                LockProfile_TakeFailed(handle(t.waitingOn), t.tag);
+                ++m.stats.timeouts;
+                m.waiters.erase(std::find(m.waiters.begin(), m.waiters.end(), task));
+                t.waitingOn = -1;
+            }
+            continue;
+        }
+
+        if (!t.held.empty() && ((random() % 2U) == 0U))
+        {
+            give(task, t.held.back(), random);
+            continue;
+        }
+
+        /* Most takes go to a few busy mutexes */
+        const int mutex = static_cast<int>(((random() % 10U) < 7U) ? (random() % 3U) : (random() % kMutexes));
+        if (std::find(t.held.begin(), t.held.end(), mutex) != t.held.end())
+        {
+            continue;
+        }
+        if (mutexes[mutex].holder < 0)
+        {
+            take(task, mutex);
+        }
+        else if ((random() % 10U) == 0U)
+        {
+            /* A take without a block time fails at once */
+            LockProfile_TakeFailed(handle(mutex), t.tag);
+        }
+        else
+        {
+            block(task, mutex);
+        }
+    }
+
+    const int errors = check();
+    unsigned long contended = 0;
+    unsigned long inherits = 0;
+    for (unsigned i = 0; i < LOCK_PROFILE_MAX_MUTEXES; ++i)
+    {
+        contended += mutexes[i].stats.contended;
+        inherits += mutexes[i].stats.inherits;
+    }
+    std::cout << steps << " steps, " << contended << " contended acquisitions and " << inherits << " inheritances since the clear, "
+              << errors << " errors\n";
+    return (errors == 0) ? 0 : 2;
+}
@@ -0,0 +1,219 @@
+/*
+ ============================================================================
+ Name        : phase_stagger.cpp
+ Module Name : Phase Stagger
+ Description : Host simulation of the supply current of N seat heaters driven by the firmware
+               PWM outputs. Every heater draws its rated current while its output is high, and
+               the total current is sampled at every PWM clock of one period, with all the
+               on-times starting with the period (aligned) and with the on-times placed by the
+               firmware PhaseStagger module (staggered). Peak and RMS totals are reported for
+               one set of duties, or averaged over random duty sets.
+
+ Build       : FW="../../1- Application project/FreeRTOS_Final_Project_WS/Seat_Heater_Control_System"
+               INC=(-I"$FW/Common" -I"$FW/Control")
+               gcc -O2 "${INC[@]}" -c "$FW/Control/PhaseStagger.c"
+               g++ -std=c++17 -O2 "${INC[@]}" -o phase_stagger phase_stagger.cpp PhaseStagger.o
+ Usage       : phase_stagger [options] [duty,duty,...]
+               -n <seats>        Number of seats for random duty sets, default 2.
+               -a <amps>         Heater current of each seat, default 5 (60 W at 12 V).
+               -s <sets>         Number of random duty sets, default 10000.
+               -r <seed>         Random seed, default 1.
+ With a duty list (percent, one per seat) only that set is simulated.
+
+ Exit status : 0, or 1 on input errors.
+ ============================================================================
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+extern "C"
+{
+#include "Std_Types.h"
+#include "PhaseStagger.h"
+}
+
+namespace
+{
+
+/* Firmware PWM timing (pwm.h): 16 MHz system clock, 1 kHz period */
+constexpr int kPeriodClocks = 16000; /* PWM_LOAD_VALUE + 1 */
+constexpr int kDutyMax = 100; /* PWM_DUTY_MAX */
+
+struct Current
+{
+    double peak = 0.0;
+    double rms = 0.0;
+    double mean = 0.0;
+};
+
+/* Same rounding as PWM_GeneratorAction() in pwm.c: the edges fall on whole PWM clocks */
+int clocksOf(int percent)
+{
+    return (kPeriodClocks * percent) / kDutyMax;
+}
+
+/* Total supply current over one PWM period, with the on-time of each seat from start to start + duty */
+Current simulate(const std::vector<int> &duty, const std::vector<int> &start, double amps)
+{
+    std::vector<int> seatsOn(kPeriodClocks + 1, 0);
+
+    for (std::size_t i = 0; i < duty.size(); ++i)
+    {
+        const int width = clocksOf(std::min(duty[i], kDutyMax));
+        const int rise = clocksOf(start[i] % kDutyMax);
+        const int fall = rise + width;
+
+        /* Difference array, an on-time past the end of the period wraps to its start */
+        ++seatsOn[rise];
+        --seatsOn[std::min(fall, kPeriodClocks)];
+        if (fall > kPeriodClocks)
+        {
+            ++seatsOn[0];
+            --seatsOn[fall - kPeriodClocks];
+        }
+    }
+
+    Current current;
+    double sumSquares = 0.0;
+    int on = 0;
+    for (int clock = 0; clock < kPeriodClocks; ++clock)
+    {
+        on += seatsOn[clock];
+        const double total = on * amps;
+        current.peak = std::max(current.peak, total);
+        current.mean += total;
+        sumSquares += total * total;
+    }
+    current.mean /= kPeriodClocks;
+    current.rms = std::sqrt(sumSquares / kPeriodClocks);
+    return current;
+}
+
+Current staggered(const std::vector<int> &duty, double amps)
+{
+    std::vector<uint8> firmwareDuty(duty.begin(), duty.end());
+    std::vector<uint8> firmwareStart(duty.size());
+    PhaseStagger_Place(firmwareDuty.data(), static_cast<uint8>(duty.size()), firmwareStart.data());
+    return simulate(duty, std::vector<int>(firmwareStart.begin(), firmwareStart.end()), amps);
+}
+
+Current aligned(const std::vector<int> &duty, double amps)
+{
+    return simulate(duty, std::vector<int>(duty.size(), 0), amps);
+}
+
+void printRow(const std::string &name, const Current &current)
+{
+    std::cout << std::left << std::setw(10) << name << std::right << std::fixed << std::setprecision(2) << std::setw(9) << current.peak
+              << std::setw(9) << current.rms << std::setw(9) << current.mean << "\n";
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+    int seats = 2;
+    double amps = 5.0;
+    long sets = 10000;
+    std::uint32_t seed = 1U;
+    std::vector<int> duties;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        if (arg == "-n" && i + 1 < argc)
+        {
+            seats = std::atoi(argv[++i]);
+        }
+        else if (arg == "-a" && i + 1 < argc)
+        {
+            amps = std::strtod(argv[++i], nullptr);
+        }
+        else if (arg == "-s" && i + 1 < argc)
+        {
+            sets = std::strtol(argv[++i], nullptr, 10);
+        }
+        else if (arg == "-r" && i + 1 < argc)
+        {
+            seed = static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else if (arg[0] != '-')
+        {
+            std::stringstream list(arg);
+            std::string field;
+            while (std::getline(list, field, ','))
+            {
+                duties.push_back(std::atoi(field.c_str()));
+            }
+        }
+        else
+        {
+            std::cerr << "usage: phase_stagger [-n seats] [-a amps] [-s sets] [-r seed] [duty,duty,...]\n";
+            return 1;
+        }
+    }
+
+    if (!duties.empty())
+    {
+        seats = static_cast<int>(duties.size());
+    }
+    if (seats < 1 || seats > 255 || sets < 1 || amps <= 0.0 ||
+        std::any_of(duties.begin(), duties.end(), [](int duty) { return duty < 0 || duty > kDutyMax; }))
+    {
+        std::cerr << "phase_stagger: seats 1 to 255, duties 0 to 100, positive current and sets\n";
+        return 1;
+    }
+
+    std::cout << "switching  peak A    rms A    mean A\n";
+
+    if (!duties.empty())
+    {
+        printRow("aligned", aligned(duties, amps));
+        printRow("staggered", staggered(duties, amps));
+        return 0;
+    }
+
+    /* Random duty sets: average of the per set figures, and the worst peak */
+    std::mt19937 generator(seed);
+    std::uniform_int_distribution<int> distribution(0, kDutyMax);
+    Current alignedSum, staggeredSum, alignedWorst, staggeredWorst;
+    std::vector<int> duty(seats);
+
+    for (long set = 0; set < sets; ++set)
+    {
+        std::generate(duty.begin(), duty.end(), [&]() { return distribution(generator); });
+
+        const Current a = aligned(duty, amps);
+        const Current s = staggered(duty, amps);
+        alignedSum.peak += a.peak;
+        alignedSum.rms += a.rms;
+        alignedSum.mean += a.mean;
+        staggeredSum.peak += s.peak;
+        staggeredSum.rms += s.rms;
+        staggeredSum.mean += s.mean;
+        alignedWorst.peak = std::max(alignedWorst.peak, a.peak);
+        staggeredWorst.peak = std::max(staggeredWorst.peak, s.peak);
+    }
+
+    for (Current *sum : {&alignedSum, &staggeredSum})
+    {
+        sum->peak /= sets;
+        sum->rms /= sets;
+        sum->mean /= sets;
+    }
+
+    std::cout << "average of " << sets << " random duty sets, " << seats << " seats at " << amps << " A\n";
+    printRow("aligned", alignedSum);
+    printRow("staggered", staggeredSum);
+    std::cout << "worst peak: aligned " << alignedWorst.peak << " A, staggered " << staggeredWorst.peak << " A\n";
+    return 0;
+}
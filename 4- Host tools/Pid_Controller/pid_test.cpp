@@ -0,0 +1,381 @@
+/*
+ ============================================================================
+ Name        : pid_test.cpp
+ Module Name : PID Controller Test
+ Description : Host test of the fixed point PID controller of the firmware (Control/Pid.c).
+               - Q16 update: over random samples, the output of Pid_Update must follow a double
+                 precision model of the same law (derivative on measurement, clamped and
+                 conditional integrator) within 0.05 % of duty, and a setpoint step must move the
+                 output by the same amount with and without a derivative gain.
+               - Closed loop: the seat model of the thermal simulator
+                 (../Thermal_Simulator/thermal_plant.cpp) is read through the firmware LM35
+                 driver every 100 ms and the PID runs every 250 ms like the heater task. A cold
+                 start with the main.c gains, a relay auto-tune followed by its gains, and a
+                 heat up from a -10 deg C cabin (the output saturates for minutes, so the
+                 integrator must not wind up) must each settle within the settling limit,
+                 with the overshoot and the steady state error within their limits, and the
+                 integrator must stay within the output range.
+               - Cycles per iteration: Pid_Update is timed over many calls on the host. On the
+                 target the heater tasks time it with the DWT cycle counter (the PID lines of the
+                 run time report, mainHEATER_PID 1).
+
+ Build       : FW="../../1- Application project/FreeRTOS_Final_Project_WS/Seat_Heater_Control_System"
+               INC=(-I"$FW/Common" -I"$FW/Control" -I"$FW/MCAL/ADC" -I"$FW/HAL/Temperatrue Sensor" -I../Thermal_Simulator)
+               gcc -O2 "${INC[@]}" -c "$FW/Control/Pid.c" "$FW/HAL/Temperatrue Sensor/lm35.c"
+               g++ -std=c++17 -O2 "${INC[@]}" -o pid_test pid_test.cpp ../Thermal_Simulator/thermal_plant.cpp Pid.o lm35.o
+ Usage       : pid_test [options]
+               -k <kp,ki,kd>     PID gains per 250 ms sample, default the main.c values 15,0.02,0.
+               -O <deg C>        Overshoot limit, default 2.
+               -E <deg C>        Steady state error limit, default 1.
+               -S <seconds>      Settling limit (within 1 deg C of the setpoint for good), default 900.
+               -r <seed>         Seed of the sensor noise and the random samples, default 1.
+
+ Exit status : 0 when every check passes, 2 otherwise, 1 on input errors.
+ ============================================================================
+ */
+
+#include "thermal_plant.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define PID_TEST_HAS_TSC 1
+#endif
+
+extern "C"
+{
+#include "Std_Types.h"
+#include "adc.h"
+#include "lm35.h"
+#include "Pid.h"
+}
+
+namespace
+{
+
+/* Firmware timing (main.c) */
+constexpr int kTickMs = 50;
+constexpr int kSensorPeriodMs = 100; /* mainSENSOR_TASK_DELAY */
+constexpr int kHeaterPeriodMs = 250; /* mainHEATER_TASK_DELAY */
+constexpr int kDutyMax = 100; /* PWM_DUTY_MAX */
+
+/* Steady state error averaged over the last kSteadyWindow seconds of a run */
+constexpr double kSteadyWindow = 300.0;
+
+struct Limits
+{
+    double overshoot = 2.0;
+    double error = 1.0;
+    double settling = 900.0;
+};
+
+struct Gains
+{
+    double kp = 15.0;
+    double ki = 0.02;
+    double kd = 0.0;
+};
+
+double q16(Pid_Q16Type value)
+{
+    return static_cast<double>(value) / 65536.0;
+}
+
+/* Pid_Update in double precision, the reference of the Q16 arithmetic */
+struct PidModel
+{
+    double kp, ki, kd, outMin, outMax;
+    double integrator = 0.0;
+    double derivative = 0.0;
+    double previous = 0.0;
+
+    double update(double setpoint, double measurement)
+    {
+        const double error = setpoint - measurement;
+        derivative += q16(PID_DERIVATIVE_ALPHA) * (-kd * (measurement - previous) - derivative);
+        previous = measurement;
+
+        double next = std::clamp(integrator + ki * error, outMin, outMax);
+        const double output = kp * error + next + derivative;
+        if (((output > outMax) && (error > 0.0)) || ((output < outMin) && (error < 0.0)))
+        {
+            next = integrator;
+        }
+        integrator = next;
+        return std::clamp(output, outMin, outMax);
+    }
+};
+
+int checkQ16Update(const Gains &gains, std::mt19937 &random)
+{
+    std::uniform_real_distribution<double> temperature(5.0, 40.0);
+    std::uniform_int_distribution<int> step(-2, 2);
+    int errors = 0;
+    double worst = 0.0;
+
+    /* A derivative gain too, the default gains have none */
+    Pid_StateType pid;
+    PidModel model = { gains.kp, gains.ki, 20.0, 0.0, static_cast<double>(kDutyMax) };
+    Pid_Init(&pid, PID_Q16(model.kp), PID_Q16(model.ki), PID_Q16(model.kd), 0, PID_INT_TO_Q16(kDutyMax));
+    model.kp = q16(pid.lKp);
+    model.ki = q16(pid.lKi);
+    model.kd = q16(pid.lKd);
+
+    double measurement = 20.0;
+    double setpoint = 30.0;
+    for (int i = 0; i < 100000; ++i)
+    {
+        /* Sensor steps of whole degrees, a new setpoint now and then */
+        measurement = std::clamp(measurement + step(random), 5.0, 40.0);
+        if ((random() % 500U) == 0U)
+        {
+            setpoint = std::round(temperature(random));
+        }
+        const double expected = model.update(setpoint, measurement);
+        const double output = q16(Pid_Update(&pid, PID_Q16(setpoint), PID_Q16(measurement)));
+        worst = std::max(worst, std::fabs(output - expected));
+        if ((std::fabs(output - expected) > 0.05) && (errors++ < 5))
+        {
+            std::cerr << "Q16 update " << i << ": output " << output << ", double model " << expected << "\n";
+        }
+    }
+
+    /* Derivative on measurement: a setpoint step alone moves the output the same with any Kd */
+    Pid_StateType withKd;
+    Pid_StateType withoutKd;
+    Pid_Init(&withKd, PID_Q16(gains.kp), PID_Q16(gains.ki), PID_Q16(20.0), 0, PID_INT_TO_Q16(kDutyMax));
+    Pid_Init(&withoutKd, PID_Q16(gains.kp), PID_Q16(gains.ki), 0, 0, PID_INT_TO_Q16(kDutyMax));
+    Pid_Reset(&withKd, PID_INT_TO_Q16(30));
+    Pid_Reset(&withoutKd, PID_INT_TO_Q16(30));
+    const Pid_Q16Type kick = Pid_Update(&withKd, PID_INT_TO_Q16(33), PID_INT_TO_Q16(30));
+    if (kick != Pid_Update(&withoutKd, PID_INT_TO_Q16(33), PID_INT_TO_Q16(30)))
+    {
+        std::cerr << "setpoint step: the derivative term kicks the output\n";
+        errors++;
+    }
+
+    std::cout << "Q16 update: largest difference to the double model " << std::setprecision(4) << worst << " % duty\n";
+    return errors;
+}
+
+/*
+ * Closed loop run of the seat from the cabin temperature to the setpoint. Auto-tunes first when
+ * autoTune is set. Returns the errors.
+ */
+int checkClosedLoop(const std::string &name, const Gains &gains, bool autoTune, double ambient, double duration,
+                    const Limits &limits, std::uint32_t seed)
+{
+    constexpr int kSetpoint = 35;
+    constexpr double kOccupant = 1.5;
+    SeatThermalPlant plant(SeatParameters(), ambient, seed);
+    plant.setNoise(0.3);
+    attachAdcChannel(SENSOR0_CHANNEL_ID, &plant);
+
+    Pid_StateType pid;
+    Pid_AutoTuneType tune;
+    Pid_Init(&pid, PID_Q16(gains.kp), PID_Q16(gains.ki), PID_Q16(gains.kd), 0, PID_INT_TO_Q16(kDutyMax));
+    Pid_AutoTuneStart(&tune, 0, PID_INT_TO_Q16(kDutyMax), PID_INT_TO_Q16(1));
+    if (!autoTune)
+    {
+        tune.eStatus = PID_AUTOTUNE_DONE;
+    }
+
+    double controlStart = 0.0; /* The settling time counts from the end of the auto-tune */
+    double settled = -1.0;
+    double peak = -100.0;
+    double errorSum = 0.0;
+    long errorSamples = 0;
+    bool windup = false;
+    int reading = 0;
+    int duty = 0;
+    int errors = 0;
+
+    for (long ms = 0; ms < static_cast<long>(duration * 1000.0); ms += kTickMs)
+    {
+        const double now = ms / 1000.0;
+
+        if ((ms % kSensorPeriodMs) == 0)
+        {
+            reading = LM35_getTemperature(SENSOR0_CHANNEL_ID);
+        }
+        if ((ms % kHeaterPeriodMs) == 0)
+        {
+            if (tune.eStatus == PID_AUTOTUNE_RUNNING)
+            {
+                duty = PID_Q16_TO_INT(Pid_AutoTuneStep(&tune, PID_INT_TO_Q16(kSetpoint), PID_INT_TO_Q16(reading)));
+                if (tune.eStatus != PID_AUTOTUNE_RUNNING)
+                {
+                    if (Pid_AutoTuneApply(&tune, &pid) != E_OK)
+                    {
+                        std::cerr << name << ": the auto-tune failed\n";
+                        return 1;
+                    }
+                    Pid_Reset(&pid, PID_INT_TO_Q16(reading));
+                    controlStart = now;
+                    std::cout << name << ": auto-tune done at " << std::setprecision(0) << std::fixed << now << " s, kp "
+                              << std::setprecision(2) << q16(pid.lKp) << " ki " << std::setprecision(4) << q16(pid.lKi) << " kd "
+                              << q16(pid.lKd) << std::defaultfloat << "\n";
+                }
+            }
+            else
+            {
+                duty = PID_Q16_TO_INT(Pid_Update(&pid, PID_INT_TO_Q16(kSetpoint), PID_INT_TO_Q16(reading)));
+                windup = windup || (pid.lIntegrator < pid.lOutMin) || (pid.lIntegrator > pid.lOutMax);
+            }
+        }
+
+        plant.step(kTickMs / 1000.0, duty, ambient, kOccupant);
+
+        if ((tune.eStatus != PID_AUTOTUNE_RUNNING) && ((ms % 1000) == 0))
+        {
+            const double seat = plant.seatTemperature();
+            const bool inside = std::fabs(seat - kSetpoint) <= 1.0;
+            if (!inside)
+            {
+                settled = -1.0;
+            }
+            else if (settled < 0.0)
+            {
+                settled = now - controlStart;
+            }
+            peak = std::max(peak, seat);
+            if (now >= duration - kSteadyWindow)
+            {
+                errorSum += std::fabs(seat - kSetpoint);
+                errorSamples++;
+            }
+        }
+    }
+    attachAdcChannel(SENSOR0_CHANNEL_ID, nullptr);
+
+    if (tune.eStatus == PID_AUTOTUNE_RUNNING)
+    {
+        std::cerr << name << ": the auto-tune did not complete\n";
+        return 1;
+    }
+    const double overshoot = std::max(0.0, peak - kSetpoint);
+    const double steady = (errorSamples > 0) ? errorSum / static_cast<double>(errorSamples) : 0.0;
+    std::cout << std::fixed << std::setprecision(2) << name << ": settled in " << std::setprecision(0) << settled << " s, overshoot "
+              << std::setprecision(2) << overshoot << ", steady error " << steady << std::defaultfloat << "\n";
+
+    if ((settled < 0.0) || (settled > limits.settling))
+    {
+        std::cerr << name << ": not settled within " << limits.settling << " s\n";
+        errors++;
+    }
+    if (overshoot > limits.overshoot)
+    {
+        std::cerr << name << ": overshoot " << overshoot << " above " << limits.overshoot << "\n";
+        errors++;
+    }
+    if (steady > limits.error)
+    {
+        std::cerr << name << ": steady error " << steady << " above " << limits.error << "\n";
+        errors++;
+    }
+    if (windup)
+    {
+        std::cerr << name << ": the integrator left the output range\n";
+        errors++;
+    }
+    return errors;
+}
+
+/* Mean time of Pid_Update over a sensor like sequence of inputs */
+void benchmark(const Gains &gains)
+{
+    constexpr long kCalls = 20000000;
+    Pid_StateType pid;
+    Pid_Q16Type inputs[64];
+    Pid_Q16Type sink = 0;
+
+    Pid_Init(&pid, PID_Q16(gains.kp), PID_Q16(gains.ki), PID_Q16(20.0), 0, PID_INT_TO_Q16(kDutyMax));
+    for (int i = 0; i < 64; ++i)
+    {
+        inputs[i] = PID_INT_TO_Q16(30 + (i % 7) - 3);
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+#ifdef PID_TEST_HAS_TSC
+    const unsigned long long tscStart = __rdtsc();
+#endif
+    for (long i = 0; i < kCalls; ++i)
+    {
+        sink += Pid_Update(&pid, PID_INT_TO_Q16(32), inputs[i & 63]);
+    }
+#ifdef PID_TEST_HAS_TSC
+    const unsigned long long tscCycles = __rdtsc() - tscStart;
+#endif
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "Pid_Update on the host: " << std::fixed << std::setprecision(1) << seconds * 1e9 / kCalls << " ns per iteration";
+#ifdef PID_TEST_HAS_TSC
+    std::cout << ", " << static_cast<double>(tscCycles) / kCalls << " TSC cycles per iteration";
+#endif
+    std::cout << std::defaultfloat << " (checksum " << (sink & 0xFF) << ")\n";
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+    Gains gains;
+    Limits limits;
+    std::uint32_t seed = 1U;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        if (arg == "-k" && i + 1 < argc)
+        {
+            char comma;
+            std::stringstream list(argv[++i]);
+            if (!(list >> gains.kp >> comma >> gains.ki >> comma >> gains.kd))
+            {
+                std::cerr << "pid_test: -k expects kp,ki,kd\n";
+                return 1;
+            }
+        }
+        else if (arg == "-O" && i + 1 < argc)
+        {
+            limits.overshoot = std::strtod(argv[++i], nullptr);
+        }
+        else if (arg == "-E" && i + 1 < argc)
+        {
+            limits.error = std::strtod(argv[++i], nullptr);
+        }
+        else if (arg == "-S" && i + 1 < argc)
+        {
+            limits.settling = std::strtod(argv[++i], nullptr);
+        }
+        else if (arg == "-r" && i + 1 < argc)
+        {
+            seed = static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else
+        {
+            std::cerr << "usage: pid_test [-k kp,ki,kd] [-O overshoot] [-E error] [-S settling s] [-r seed]\n";
+            return 1;
+        }
+    }
+
+    std::mt19937 random(seed);
+    int errors = checkQ16Update(gains, random);
+    errors += checkClosedLoop("main.c gains, 10 deg C cabin", gains, false, 10.0, 1800.0, limits, seed);
+    errors += checkClosedLoop("auto-tune, 10 deg C cabin", gains, true, 10.0, 3600.0, limits, seed);
+    errors += checkClosedLoop("main.c gains, -10 deg C cabin", gains, false, -10.0, 2400.0, limits, seed);
+    benchmark(gains);
+
+    std::cout << errors << " errors\n";
+    return (errors == 0) ? 0 : 2;
+}
@@ -0,0 +1,389 @@
+/*
+ ============================================================================
+ Name        : power_budget_test.cpp
+ Module Name : Power Budget Test
+ Description : Randomised host check of the firmware PowerBudget module (Control/PowerBudget.c)
+               with up to POWER_BUDGET_MAX_SEATS seats. Every scenario draws the number of
+               seats, their rated power and priority class and the budget, then runs control
+               periods in which every seat requests a random power, in a random order, as the
+               heater tasks of main.c do. After a period, the seats returned by
+               PowerBudget_PendingSeats reallocate as main.c wakes them in event driven mode.
+               Checks:
+               - the grants never add up above the budget, after any allocation;
+               - a grant never exceeds the request, nor the rated power of the seat;
+               - the pending seats settle within two reallocation rounds, on the share of a
+                 reference model: the priority classes are served in order, the first class
+                 that does not fit shares the rest in proportion to its requests (rounded
+                 down) and the classes after it get nothing;
+               - the allocation and curtailed counters of PowerBudget_GetStatus;
+               - PowerBudget_Init rejects too many seats and a priority out of range;
+               - with the defaults of main.c (copied here), two seats at high (low, medium
+                 and high are 1/3, 2/3 and all of the rated power) are never curtailed.
+
+ Build       : FW="../../1- Application project/FreeRTOS_Final_Project_WS/Seat_Heater_Control_System"
+               INC=(-I"$FW/Common" -I"$FW/Control")
+               gcc -O2 "${INC[@]}" -c "$FW/Control/PowerBudget.c"
+               g++ -std=c++17 -O2 "${INC[@]}" -o power_budget_test power_budget_test.cpp PowerBudget.o
+ Usage       : power_budget_test [-n scenarios] [-p periods] [-s seed]
+
+ Exit status : 0 when every check passes, 2 when one fails, 1 on bad arguments.
+ ============================================================================
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <vector>
+
+extern "C"
+{
+#include "Std_Types.h"
+#include "PowerBudget.h"
+}
+
+namespace
+{
+
+/* Defaults of main.c */
+constexpr unsigned kDefaultBudget = 120U; /* mainPOWER_BUDGET_WATTS */
+constexpr unsigned kDefaultRated = 60U; /* mainHEATER_RATED_WATTS */
+constexpr unsigned kDefaultPriority = 0U; /* mainDRIVER_POWER_PRIORITY, mainPASSENGER_POWER_PRIORITY */
+
+/* Reallocation rounds allowed after a period before the grants must be settled */
+constexpr unsigned kSettleRounds = 2U;
+
+struct Options
+{
+    unsigned long scenarios = 2000;
+    unsigned periods = 50;
+    unsigned seed = 1;
+};
+
+bool parseOptions(int argc, char *argv[], Options &options)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        if ((i + 1) >= argc)
+        {
+            return false;
+        }
+        if (std::strcmp(argv[i], "-n") == 0)
+        {
+            options.scenarios = std::strtoul(argv[++i], nullptr, 10);
+        }
+        else if (std::strcmp(argv[i], "-p") == 0)
+        {
+            options.periods = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else if (std::strcmp(argv[i], "-s") == 0)
+        {
+            options.seed = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else
+        {
+            return false;
+        }
+    }
+    return (options.scenarios > 0U) && (options.periods > 0U);
+}
+
+/* The share of every seat for the given requests, by priority class then in proportion */
+std::vector<unsigned> referenceShares(const std::vector<PowerBudget_SeatConfigType> &seats, const std::vector<unsigned> &requests,
+                                      unsigned budget)
+{
+    std::vector<unsigned> shares(seats.size(), 0U);
+    unsigned remaining = budget;
+
+    for (unsigned priority = 0; priority < POWER_BUDGET_PRIORITIES; priority++)
+    {
+        unsigned long classRequests = 0;
+
+        for (std::size_t i = 0; i < seats.size(); i++)
+        {
+            if (seats[i].ucPriority == priority)
+            {
+                classRequests += requests[i];
+            }
+        }
+        for (std::size_t i = 0; i < seats.size(); i++)
+        {
+            if (seats[i].ucPriority == priority)
+            {
+                shares[i] = (classRequests <= remaining) ? requests[i]
+                                                         : static_cast<unsigned>((requests[i] * static_cast<unsigned long>(remaining)) / classRequests);
+            }
+        }
+        remaining = (classRequests <= remaining) ? static_cast<unsigned>(remaining - classRequests) : 0U;
+    }
+    return shares;
+}
+
+class Checker
+{
+public:
+    Checker(const std::vector<PowerBudget_SeatConfigType> &seats, unsigned budget) : seats_(seats), budget_(budget), requests_(seats.size(), 0U),
+                                                                                     allocations_(seats.size(), 0U), curtailed_(seats.size(), 0U)
+    {
+    }
+
+    /* One allocation, checked against the budget, the request and the rated power */
+    void allocate(unsigned seat, unsigned requested)
+    {
+        const unsigned granted = PowerBudget_Allocate(static_cast<uint8>(seat), static_cast<uint16>(requested));
+        const unsigned limited = std::min(requested, static_cast<unsigned>(seats_[seat].usRatedPower));
+
+        requests_[seat] = limited;
+        allocations_[seat]++;
+        if (granted < limited)
+        {
+            curtailed_[seat]++;
+        }
+        if (granted > limited)
+        {
+            fail() << "seat " << seat << " granted " << granted << " W for a request of " << requested << " W (rated "
+                   << seats_[seat].usRatedPower << " W)\n";
+        }
+        if (PowerBudget_GetStatus(static_cast<uint8>(seat))->usGranted != granted)
+        {
+            fail() << "seat " << seat << " status does not hold the grant\n";
+        }
+        const unsigned total = totalGranted();
+        if (total > budget_)
+        {
+            fail() << total << " W granted over a budget of " << budget_ << " W\n";
+        }
+    }
+
+    /* Reallocates the pending seats as main.c wakes them, then compares the grants with the reference */
+    void settle()
+    {
+        unsigned round = 0;
+        std::uint32_t pending = PowerBudget_PendingSeats();
+
+        while ((pending != 0U) && (round < kSettleRounds))
+        {
+            for (unsigned i = 0; i < seats_.size(); i++)
+            {
+                if (pending & (1UL << i))
+                {
+                    allocate(i, requests_[i]);
+                }
+            }
+            pending = PowerBudget_PendingSeats();
+            round++;
+        }
+        if (pending != 0U)
+        {
+            fail() << "seats 0x" << std::hex << pending << std::dec << " still pending after " << kSettleRounds << " rounds\n";
+        }
+
+        const std::vector<unsigned> shares = referenceShares(seats_, requests_, budget_);
+        for (unsigned i = 0; i < seats_.size(); i++)
+        {
+            const unsigned granted = PowerBudget_GetStatus(static_cast<uint8>(i))->usGranted;
+            if (granted != shares[i])
+            {
+                fail() << "seat " << i << " (priority " << static_cast<int>(seats_[i].ucPriority) << ") settled on " << granted
+                       << " W, its share is " << shares[i] << " W\n";
+            }
+        }
+    }
+
+    void checkCounters()
+    {
+        for (unsigned i = 0; i < seats_.size(); i++)
+        {
+            const PowerBudget_SeatStatusType *status = PowerBudget_GetStatus(static_cast<uint8>(i));
+            if ((status->ulAllocations != allocations_[i]) || (status->ulCurtailed != curtailed_[i]))
+            {
+                fail() << "seat " << i << " counted " << status->ulAllocations << " allocations, " << status->ulCurtailed
+                       << " curtailed, expected " << allocations_[i] << " and " << curtailed_[i] << "\n";
+            }
+        }
+    }
+
+    unsigned long curtailed() const
+    {
+        return std::accumulate(curtailed_.begin(), curtailed_.end(), 0UL);
+    }
+
+    unsigned long failures() const
+    {
+        return failures_;
+    }
+
+private:
+    unsigned totalGranted() const
+    {
+        unsigned total = 0;
+        for (unsigned i = 0; i < seats_.size(); i++)
+        {
+            total += PowerBudget_GetStatus(static_cast<uint8>(i))->usGranted;
+        }
+        return total;
+    }
+
+    std::ostream &fail()
+    {
+        static std::ostream null(nullptr);
+        return (failures_++ < 10U) ? (std::cerr << "  ") : null;
+    }
+
+    const std::vector<PowerBudget_SeatConfigType> &seats_;
+    unsigned budget_;
+    std::vector<unsigned> requests_;
+    std::vector<unsigned long> allocations_;
+    std::vector<unsigned long> curtailed_;
+    unsigned long failures_ = 0;
+};
+
+/* Two seats at the defaults of main.c, every pair of heater states: only the states above the budget are curtailed */
+unsigned long checkDefaults()
+{
+    const std::vector<PowerBudget_SeatConfigType> seats(2U, PowerBudget_SeatConfigType { static_cast<uint16>(kDefaultRated),
+                                                                                         static_cast<uint8>(kDefaultPriority) });
+    unsigned long failures = 0;
+
+    for (unsigned driver = 0; driver <= 3U; driver++)
+    {
+        for (unsigned passenger = 0; passenger <= 3U; passenger++)
+        {
+            /* mainHEATER_STATE_WATTS of main.c */
+            const unsigned driverWatts = ((driver * kDefaultRated) + 2U) / 3U;
+            const unsigned passengerWatts = ((passenger * kDefaultRated) + 2U) / 3U;
+
+            PowerBudget_Init(seats.data(), 2U, static_cast<uint16>(kDefaultBudget));
+            Checker checker(seats, kDefaultBudget);
+            for (int period = 0; period < 3; period++)
+            {
+                checker.allocate(0U, driverWatts);
+                checker.allocate(1U, passengerWatts);
+                checker.settle();
+            }
+            /* Two seats at high must fit, as before the budget manager */
+            const bool fits = (driverWatts + passengerWatts) <= kDefaultBudget;
+            if ((driver == 3U) && (passenger == 3U) && !fits)
+            {
+                std::cerr << "  defaults: two seats at high need " << driverWatts + passengerWatts << " W, the budget is " << kDefaultBudget
+                          << " W\n";
+                failures++;
+            }
+            if (fits && (checker.curtailed() != 0U))
+            {
+                std::cerr << "  defaults: driver state " << driver << " and passenger state " << passenger << " were curtailed\n";
+                failures++;
+            }
+            failures += checker.failures();
+        }
+    }
+    return failures;
+}
+
+unsigned long checkInit()
+{
+    PowerBudget_SeatConfigType seats[POWER_BUDGET_MAX_SEATS + 1U] = {};
+    unsigned long failures = 0;
+
+    if (PowerBudget_Init(seats, static_cast<uint8>(POWER_BUDGET_MAX_SEATS + 1U), 100U) != E_NOT_OK)
+    {
+        std::cerr << "  Init accepted " << POWER_BUDGET_MAX_SEATS + 1U << " seats\n";
+        failures++;
+    }
+    seats[1].ucPriority = static_cast<uint8>(POWER_BUDGET_PRIORITIES);
+    if (PowerBudget_Init(seats, 2U, 100U) != E_NOT_OK)
+    {
+        std::cerr << "  Init accepted priority " << POWER_BUDGET_PRIORITIES << "\n";
+        failures++;
+    }
+    seats[1].ucPriority = static_cast<uint8>(POWER_BUDGET_PRIORITIES - 1U);
+    if (PowerBudget_Init(seats, static_cast<uint8>(POWER_BUDGET_MAX_SEATS), 100U) != E_OK)
+    {
+        std::cerr << "  Init rejected " << POWER_BUDGET_MAX_SEATS << " seats\n";
+        failures++;
+    }
+    return failures;
+}
+
+} /* namespace */
+
+int main(int argc, char *argv[])
+{
+    Options options;
+
+    if (!parseOptions(argc, argv, options))
+    {
+        std::cerr << "Usage: power_budget_test [-n scenarios] [-p periods] [-s seed]\n";
+        return 1;
+    }
+
+    std::mt19937 random(options.seed);
+    unsigned long failures = checkInit();
+    unsigned long allocations = 0;
+    unsigned long curtailed = 0;
+    unsigned long bySeats[POWER_BUDGET_MAX_SEATS + 1U] = {};
+
+    failures += checkDefaults();
+
+    for (unsigned long scenario = 0; scenario < options.scenarios; scenario++)
+    {
+        const unsigned count = std::uniform_int_distribution<unsigned>(1U, POWER_BUDGET_MAX_SEATS)(random);
+        std::vector<PowerBudget_SeatConfigType> seats(count);
+        unsigned ratedTotal = 0;
+
+        for (auto &seat : seats)
+        {
+            seat.usRatedPower = static_cast<uint16>(std::uniform_int_distribution<unsigned>(10U, 150U)(random));
+            seat.ucPriority = static_cast<uint8>(std::uniform_int_distribution<unsigned>(0U, POWER_BUDGET_PRIORITIES - 1U)(random));
+            ratedTotal += seat.usRatedPower;
+        }
+        /* From starved to above the rated power of all the seats */
+        const unsigned budget = std::uniform_int_distribution<unsigned>(0U, ratedTotal + 50U)(random);
+
+        if (PowerBudget_Init(seats.data(), static_cast<uint8>(count), static_cast<uint16>(budget)) != E_OK)
+        {
+            std::cerr << "  scenario " << scenario << ": Init rejected a valid configuration\n";
+            failures++;
+            continue;
+        }
+
+        Checker checker(seats, budget);
+        std::vector<unsigned> order(count);
+        std::iota(order.begin(), order.end(), 0U);
+        for (unsigned period = 0; period < options.periods; period++)
+        {
+            std::shuffle(order.begin(), order.end(), random);
+            for (unsigned seat : order)
+            {
+                /* Off some of the time, and sometimes above the rated power */
+                const unsigned requested = (std::uniform_int_distribution<unsigned>(0U, 4U)(random) == 0U)
+                                               ? 0U
+                                               : std::uniform_int_distribution<unsigned>(0U, seats[seat].usRatedPower + 20U)(random);
+                checker.allocate(seat, requested);
+                allocations++;
+            }
+            checker.settle();
+        }
+        checker.checkCounters();
+        if (checker.failures() != 0U)
+        {
+            std::cerr << "  scenario " << scenario << ": " << count << " seats, budget " << budget << " W\n";
+        }
+        failures += checker.failures();
+        curtailed += checker.curtailed();
+        bySeats[count]++;
+    }
+
+    std::cout << "Scenarios: " << options.scenarios << " (";
+    for (unsigned i = 1; i <= POWER_BUDGET_MAX_SEATS; i++)
+    {
+        std::cout << bySeats[i] << " with " << i << ((i < POWER_BUDGET_MAX_SEATS) ? ", " : " seats)\n");
+    }
+    std::cout << "Allocations: " << allocations << " requested, " << curtailed << " curtailed including reallocations\n";
+    std::cout << "Defaults of main.c: " << kDefaultBudget << " W budget, 2 seats of " << kDefaultRated << " W\n";
+    std::cout << ((failures == 0U) ? "PASS" : "FAIL") << "\n";
+    return (failures == 0U) ? 0 : 2;
+}
@@ -0,0 +1,64 @@
+/*
+ ============================================================================
+ Name        : pwm_host_registers.h
+ Module Name : PWM Output Test
+ Description : Host stand-in of the TM4C123GH6PM registers used by the firmware PWM driver
+               (MCAL/PWM/pwm.c). Each register is a variable of the test, so the driver
+               runs unchanged and the test reads back what it programmed. It is force
+               included in the driver build, with the include guard of the target register
+               header defined so that header is skipped.
+ ============================================================================
+ */
+
+#ifndef PWM_HOST_REGISTERS_H_
+#define PWM_HOST_REGISTERS_H_
+
+#include "Std_Types.h"
+
+#define SYSCTL_RCGCPWM_REG      HostReg_SYSCTL_RCGCPWM
+#define SYSCTL_PRPWM_REG        HostReg_SYSCTL_PRPWM
+#define GPIO_PORTB_AFSEL_REG    HostReg_GPIO_PORTB_AFSEL
+#define GPIO_PORTB_PCTL_REG     HostReg_GPIO_PORTB_PCTL
+#define GPIO_PORTF_AFSEL_REG    HostReg_GPIO_PORTF_AFSEL
+#define GPIO_PORTF_PCTL_REG     HostReg_GPIO_PORTF_PCTL
+#define PWM0_CTL_REG            HostReg_PWM0_CTL
+#define PWM0_ENABLE_REG         HostReg_PWM0_ENABLE
+#define PWM0_1_CTL_REG          HostReg_PWM0_1_CTL
+#define PWM0_1_COUNT_REG        HostReg_PWM0_1_COUNT
+#define PWM0_1_LOAD_REG         HostReg_PWM0_1_LOAD
+#define PWM0_1_CMPA_REG         HostReg_PWM0_1_CMPA
+#define PWM0_1_CMPB_REG         HostReg_PWM0_1_CMPB
+#define PWM0_1_GENA_REG         HostReg_PWM0_1_GENA
+#define PWM1_CTL_REG            HostReg_PWM1_CTL
+#define PWM1_ENABLE_REG         HostReg_PWM1_ENABLE
+#define PWM1_3_CTL_REG          HostReg_PWM1_3_CTL
+#define PWM1_3_COUNT_REG        HostReg_PWM1_3_COUNT
+#define PWM1_3_LOAD_REG         HostReg_PWM1_3_LOAD
+#define PWM1_3_CMPA_REG         HostReg_PWM1_3_CMPA
+#define PWM1_3_CMPB_REG         HostReg_PWM1_3_CMPB
+#define PWM1_3_GENB_REG         HostReg_PWM1_3_GENB
+
+extern volatile uint32 HostReg_SYSCTL_RCGCPWM;
+extern volatile uint32 HostReg_SYSCTL_PRPWM;
+extern volatile uint32 HostReg_GPIO_PORTB_AFSEL;
+extern volatile uint32 HostReg_GPIO_PORTB_PCTL;
+extern volatile uint32 HostReg_GPIO_PORTF_AFSEL;
+extern volatile uint32 HostReg_GPIO_PORTF_PCTL;
+extern volatile uint32 HostReg_PWM0_CTL;
+extern volatile uint32 HostReg_PWM0_ENABLE;
+extern volatile uint32 HostReg_PWM0_1_CTL;
+extern volatile uint32 HostReg_PWM0_1_COUNT;
+extern volatile uint32 HostReg_PWM0_1_LOAD;
+extern volatile uint32 HostReg_PWM0_1_CMPA;
+extern volatile uint32 HostReg_PWM0_1_CMPB;
+extern volatile uint32 HostReg_PWM0_1_GENA;
+extern volatile uint32 HostReg_PWM1_CTL;
+extern volatile uint32 HostReg_PWM1_ENABLE;
+extern volatile uint32 HostReg_PWM1_3_CTL;
+extern volatile uint32 HostReg_PWM1_3_COUNT;
+extern volatile uint32 HostReg_PWM1_3_LOAD;
+extern volatile uint32 HostReg_PWM1_3_CMPA;
+extern volatile uint32 HostReg_PWM1_3_CMPB;
+extern volatile uint32 HostReg_PWM1_3_GENB;
+
+#endif /* PWM_HOST_REGISTERS_H_ */
@@ -0,0 +1,505 @@
+/*
+ ============================================================================
+ Name        : pwm_output_test.cpp
+ Module Name : PWM Output Test
+ Description : Host check of the duty cycle and window programming of the firmware PWM
+               driver (MCAL/PWM/pwm.c), the heater output of main.c with mainHEATER_PWM 1.
+               The driver is built against host registers (pwm_host_registers.h), and the
+               generators are simulated clock by clock from what it programmed, as the
+               TM4C123GH6PM PWM module runs them in count-down mode: the counter runs from
+               LOAD to 0, the load, zero, compare A down and compare B down events drive the
+               output by the actions of the generator register, and the compare and action
+               registers are latched together at the end of a period after a global
+               synchronization request of their module, which the module then clears.
+               - PWM_Init: PWM clocks, pin functions of PF3 and PB4 (the other pins are kept),
+                 1 kHz period, global updates, both outputs enabled and low.
+               - PWM_SetDutyWindow and PWM_SetDutyCycle, every start 0 to 99 (and 100, 150,
+                 199, 255) and duty 0 to 101 (and 120, 200, 255) on both channels: the output
+                 must keep the previous window until PWM_Update, then be high exactly from
+                 start percent into the period for duty percent of it (clamped to 100%, and
+                 wrapped to the start of the period), on the generator of its channel only,
+                 and no two events with an action may fall on the same count.
+               - Random sequences of windows written on one or both channels period after
+                 period, with or without PWM_Update: every period must be exactly the window
+                 of the last PWM_Update before it, whatever the previous one was.
+
+ Build       : FW="../../1- Application project/FreeRTOS_Final_Project_WS/Seat_Heater_Control_System"
+               INC=(-I"$FW/Common" -I"$FW/MCAL/PWM")
+               gcc -O2 -DTM4C123GH6PM_REGISTERS -include pwm_host_registers.h "${INC[@]}" -I. -I"$FW/MCAL" -c "$FW/MCAL/PWM/pwm.c"
+               g++ -std=c++17 -O2 "${INC[@]}" -I. -o pwm_output_test pwm_output_test.cpp pwm.o
+ Usage       : pwm_output_test [options]
+               -n <periods>      Periods of the random sequences, default 20000.
+               -s <seed>         Random seed, default 1.
+
+ Exit status : 0, 2 when a check fails, 1 on input errors.
+ ============================================================================
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+extern "C"
+{
+#include "Std_Types.h"
+#include "pwm.h"
+#include "pwm_host_registers.h"
+
+volatile uint32 HostReg_SYSCTL_RCGCPWM;
+volatile uint32 HostReg_SYSCTL_PRPWM;
+volatile uint32 HostReg_GPIO_PORTB_AFSEL;
+volatile uint32 HostReg_GPIO_PORTB_PCTL;
+volatile uint32 HostReg_GPIO_PORTF_AFSEL;
+volatile uint32 HostReg_GPIO_PORTF_PCTL;
+volatile uint32 HostReg_PWM0_CTL;
+volatile uint32 HostReg_PWM0_ENABLE;
+volatile uint32 HostReg_PWM0_1_CTL;
+volatile uint32 HostReg_PWM0_1_COUNT;
+volatile uint32 HostReg_PWM0_1_LOAD;
+volatile uint32 HostReg_PWM0_1_CMPA;
+volatile uint32 HostReg_PWM0_1_CMPB;
+volatile uint32 HostReg_PWM0_1_GENA;
+volatile uint32 HostReg_PWM1_CTL;
+volatile uint32 HostReg_PWM1_ENABLE;
+volatile uint32 HostReg_PWM1_3_CTL;
+volatile uint32 HostReg_PWM1_3_COUNT;
+volatile uint32 HostReg_PWM1_3_LOAD;
+volatile uint32 HostReg_PWM1_3_CMPA;
+volatile uint32 HostReg_PWM1_3_CMPB;
+volatile uint32 HostReg_PWM1_3_GENB;
+}
+
+namespace
+{
+
+constexpr std::uint32_t kPeriodClocks = 16000U; /* 16 MHz system clock, 1 kHz */
+constexpr int kChannels = 2;
+constexpr int kMaxErrorsShown = 10;
+
+/* PWMnCTL fields */
+constexpr std::uint32_t kCtlEnable = 0x001U;
+constexpr std::uint32_t kCtlModeUpDown = 0x002U;
+constexpr std::uint32_t kCtlCmpUpdGlobal = 0x030U; /* CMPAUPD and CMPBUPD, 0 is local */
+constexpr unsigned kCtlGenAUpdShift = 6U;
+constexpr unsigned kCtlGenBUpdShift = 8U;
+constexpr std::uint32_t kGenUpdGlobal = 3U;
+
+/* GLOBALSYNC bits of the module PWMCTL registers */
+constexpr std::uint32_t kGlobalSync1 = 0x02U; /* PWM0 generator 1 */
+constexpr std::uint32_t kGlobalSync3 = 0x08U; /* PWM1 generator 3 */
+
+/* PWMnGENx action fields, 2 bits each: nothing, invert, low, high */
+constexpr unsigned kActZeroShift = 0U;
+constexpr unsigned kActLoadShift = 2U;
+constexpr unsigned kActCmpADShift = 6U;
+constexpr unsigned kActCmpBDShift = 10U;
+constexpr std::uint32_t kActionMask = 0xAFFU; /* No count up actions in count-down mode */
+
+/* Registers of a generator output, latched at the start of a period */
+struct Generator
+{
+    uint32 load = 0;
+    uint32 compareA = 0;
+    uint32 compareB = 0;
+    uint32 action = 0;
+
+    bool operator==(const Generator &other) const
+    {
+        return (load == other.load) && (compareA == other.compareA) && (compareB == other.compareB) && (action == other.action);
+    }
+};
+
+/* Registers the generators run with, the ones written are only latched on a global synchronization */
+Generator active[2];
+
+/* Simulated output of a channel, the level carries from one period to the next */
+struct Output
+{
+    bool level = false;
+    int coincidences = 0; /* Counts where two events with an action fell together */
+};
+
+const char *channelName(int channel)
+{
+    return (channel == PWM_CHANNEL_GREEN1) ? "GREEN1 (PWM1 generator 3 B)" : "GREEN2 (PWM0 generator 1 A)";
+}
+
+/* Registers written to the generator of a channel */
+Generator written(int channel)
+{
+    Generator generator;
+    if (channel == PWM_CHANNEL_GREEN1)
+    {
+        generator = { HostReg_PWM1_3_LOAD, HostReg_PWM1_3_CMPA, HostReg_PWM1_3_CMPB, HostReg_PWM1_3_GENB };
+    }
+    else
+    {
+        generator = { HostReg_PWM0_1_LOAD, HostReg_PWM0_1_CMPA, HostReg_PWM0_1_CMPB, HostReg_PWM0_1_GENA };
+    }
+    return generator;
+}
+
+/* End of a period: the generators with a synchronization request latch their written registers, and the request clears */
+void periodEnd()
+{
+    if ((HostReg_PWM1_CTL & kGlobalSync3) != 0U)
+    {
+        active[PWM_CHANNEL_GREEN1] = written(PWM_CHANNEL_GREEN1);
+        HostReg_PWM1_CTL &= ~kGlobalSync3;
+    }
+    if ((HostReg_PWM0_CTL & kGlobalSync1) != 0U)
+    {
+        active[PWM_CHANNEL_GREEN2] = written(PWM_CHANNEL_GREEN2);
+        HostReg_PWM0_CTL &= ~kGlobalSync1;
+    }
+}
+
+/* Applies an action to the output, true when it did something */
+bool applyAction(std::uint32_t action, bool &level)
+{
+    switch (action & 3U)
+    {
+    case 1U:
+        level = !level;
+        return true;
+    case 2U:
+        level = false;
+        return true;
+    case 3U:
+        level = true;
+        return true;
+    default:
+        return false;
+    }
+}
+
+/*
+ * Runs one period of a generator and returns the output level of each clock, from the time 0 of the period
+ * (counter at LOAD) on. The level only changes on the counts of the events. Of events falling on the same count, the zero, load, compare B down and compare A
+ * down order of the data sheet decides, but the driver must not rely on it.
+ */
+std::vector<bool> runPeriod(const Generator &generator, Output &output)
+{
+    std::vector<bool> levels(generator.load + 1U);
+    std::vector<uint32> times = { 0U, generator.load }; /* Clocks into the period where an event may fall */
+
+    for (uint32 compare : { generator.compareA, generator.compareB })
+    {
+        if (compare <= generator.load)
+        {
+            times.push_back(generator.load - compare);
+        }
+    }
+    std::sort(times.begin(), times.end());
+    times.erase(std::unique(times.begin(), times.end()), times.end());
+    times.push_back(generator.load + 1U);
+
+    for (std::size_t i = 0; (i + 1U) < times.size(); i++)
+    {
+        const uint32 count = generator.load - times[i];
+        int actions = 0;
+        bool applied = false;
+        const struct
+        {
+            bool match;
+            unsigned shift;
+        } events[] = { { count == 0U, kActZeroShift },
+                       { count == generator.load, kActLoadShift },
+                       { count == generator.compareB, kActCmpBDShift },
+                       { count == generator.compareA, kActCmpADShift } };
+
+        for (const auto &event : events)
+        {
+            if (event.match && (((generator.action >> event.shift) & 3U) != 0U))
+            {
+                actions++;
+                if (!applied)
+                {
+                    applied = applyAction(generator.action >> event.shift, output.level);
+                }
+            }
+        }
+        output.coincidences += (actions > 1) ? 1 : 0;
+        std::fill(levels.begin() + times[i], levels.begin() + times[i + 1U], output.level);
+    }
+    return levels;
+}
+
+/* Level the window must have at each clock, with the rounding of pwm.h: edges on whole PWM clocks */
+std::vector<bool> expectedLevels(unsigned start, unsigned duty)
+{
+    const std::uint32_t rise = (kPeriodClocks * (start % 100U)) / 100U;
+    const std::uint32_t on = (kPeriodClocks * std::min(duty, 100U)) / 100U;
+    std::vector<bool> levels(kPeriodClocks);
+
+    for (std::uint32_t t = 0; t < kPeriodClocks; t++)
+    {
+        levels[t] = ((t + kPeriodClocks - rise) % kPeriodClocks) < on;
+    }
+    return levels;
+}
+
+class Checker
+{
+public:
+    void check(bool condition, const std::string &message)
+    {
+        if (!condition)
+        {
+            if (errors_ < kMaxErrorsShown)
+            {
+                std::cerr << "FAIL: " << message << "\n";
+            }
+            errors_++;
+        }
+    }
+
+    /* Compares a simulated period with the window it must show */
+    void checkPeriod(const std::vector<bool> &levels, int channel, unsigned start, unsigned duty, const std::string &context)
+    {
+        const std::vector<bool> expected = expectedLevels(start, duty);
+        if (levels.size() != expected.size())
+        {
+            check(false, std::string(channelName(channel)) + " period of " + std::to_string(levels.size()) + " clocks, not " +
+                             std::to_string(expected.size()));
+            return;
+        }
+        for (std::uint32_t t = 0; t < kPeriodClocks; t++)
+        {
+            if (levels[t] != expected[t])
+            {
+                check(false, std::string(channelName(channel)) + " start " + std::to_string(start) + "% duty " + std::to_string(duty) +
+                                 "%" + context + ": output " + (levels[t] ? "high" : "low") + " at clock " + std::to_string(t));
+                return;
+            }
+        }
+    }
+
+    int errors() const
+    {
+        return errors_;
+    }
+
+private:
+    int errors_ = 0;
+};
+
+/* Registers of the other pins and modules, which the driver must keep */
+constexpr std::uint32_t kOtherAfselB = 0x0CU;
+constexpr std::uint32_t kOtherAfselF = 0x01U;
+constexpr std::uint32_t kOtherPctlB = 0x11000011U;
+constexpr std::uint32_t kOtherPctlF = 0x00000007U;
+constexpr std::uint32_t kOtherRcgc = 0x04U;
+constexpr std::uint32_t kOtherEnable0 = 0x01U;
+constexpr std::uint32_t kOtherEnable1 = 0x10U;
+
+void checkCtl(Checker &checker, std::uint32_t ctl, int channel)
+{
+    const std::string name = channelName(channel);
+    const unsigned shift = (channel == PWM_CHANNEL_GREEN1) ? kCtlGenBUpdShift : kCtlGenAUpdShift;
+
+    checker.check((ctl & kCtlEnable) != 0U, name + ": generator not enabled");
+    checker.check((ctl & kCtlModeUpDown) == 0U, name + ": not in count-down mode");
+    checker.check((ctl & kCtlCmpUpdGlobal) == kCtlCmpUpdGlobal, name + ": compare updates not global");
+    checker.check(((ctl >> shift) & 3U) == kGenUpdGlobal, name + ": generator action updates not global");
+}
+
+void checkInit(Checker &checker)
+{
+    HostReg_SYSCTL_RCGCPWM = kOtherRcgc;
+    HostReg_SYSCTL_PRPWM = 0x03U;
+    HostReg_GPIO_PORTB_AFSEL = kOtherAfselB;
+    HostReg_GPIO_PORTB_PCTL = kOtherPctlB | 0x000F0000U;
+    HostReg_GPIO_PORTF_AFSEL = kOtherAfselF;
+    HostReg_GPIO_PORTF_PCTL = kOtherPctlF | 0x0000F000U;
+    HostReg_PWM0_ENABLE = kOtherEnable0;
+    HostReg_PWM1_ENABLE = kOtherEnable1;
+    HostReg_PWM0_1_GENA = 0xFFFU;
+    HostReg_PWM1_3_GENB = 0xFFFU;
+    HostReg_PWM0_CTL = 0U;
+    HostReg_PWM1_CTL = 0U;
+    HostReg_PWM0_1_COUNT = kPeriodClocks - 1U; /* Away from the end of the period, PWM_Update does not wait */
+    HostReg_PWM1_3_COUNT = kPeriodClocks - 1U;
+
+    PWM_Init();
+
+    checker.check(HostReg_SYSCTL_RCGCPWM == (kOtherRcgc | 0x03U), "PWM_Init: PWM0 and PWM1 clocks not enabled, or other clocks changed");
+    checker.check(HostReg_GPIO_PORTF_AFSEL == (kOtherAfselF | 0x08U), "PWM_Init: PF3 alternate function");
+    checker.check(HostReg_GPIO_PORTF_PCTL == (kOtherPctlF | 0x00005000U), "PWM_Init: PF3 not M1PWM7, or other PCTL fields changed");
+    checker.check(HostReg_GPIO_PORTB_AFSEL == (kOtherAfselB | 0x10U), "PWM_Init: PB4 alternate function");
+    checker.check(HostReg_GPIO_PORTB_PCTL == (kOtherPctlB | 0x00040000U), "PWM_Init: PB4 not M0PWM2, or other PCTL fields changed");
+    checker.check(HostReg_PWM1_ENABLE == (kOtherEnable1 | 0x80U), "PWM_Init: PWM1 output 7 enable");
+    checker.check(HostReg_PWM0_ENABLE == (kOtherEnable0 | 0x04U), "PWM_Init: PWM0 output 2 enable");
+    checkCtl(checker, HostReg_PWM1_3_CTL, PWM_CHANNEL_GREEN1);
+    checkCtl(checker, HostReg_PWM0_1_CTL, PWM_CHANNEL_GREEN2);
+    checker.check(((HostReg_PWM1_CTL & kGlobalSync3) != 0U) && ((HostReg_PWM0_CTL & kGlobalSync1) != 0U),
+                  "PWM_Init: the first values are not synchronized");
+    periodEnd();
+
+    for (int channel = 0; channel < kChannels; channel++)
+    {
+        const Generator generator = active[channel];
+        checker.check(generator.load == kPeriodClocks - 1U, std::string(channelName(channel)) + ": LOAD is not a 1 kHz period");
+        checker.check((generator.action & ~kActionMask) == 0U, std::string(channelName(channel)) + ": count up actions after PWM_Init");
+        Output output;
+        output.level = true;
+        runPeriod(generator, output);
+        checker.checkPeriod(runPeriod(generator, output), channel, 0U, 0U, " after PWM_Init");
+    }
+}
+
+/* Every window on both channels, each settled for a period before it is compared, returns the windows checked */
+unsigned long checkWindows(Checker &checker)
+{
+    unsigned long windows = 0;
+    std::vector<unsigned> starts;
+    std::vector<unsigned> duties;
+    for (unsigned percent = 0; percent <= 101U; percent++)
+    {
+        starts.push_back(percent);
+        duties.push_back(percent);
+    }
+    starts.resize(100U);
+    starts.insert(starts.end(), { 100U, 150U, 199U, 255U });
+    duties.insert(duties.end(), { 120U, 200U, 255U });
+
+    for (int channel = 0; channel < kChannels; channel++)
+    {
+        const int other = 1 - channel;
+        PWM_SetDutyWindow(static_cast<PWM_ChannelType>(other), 37U, 21U);
+        PWM_Update();
+        periodEnd();
+        const Generator otherBefore = active[other];
+
+        for (unsigned start : starts)
+        {
+            for (unsigned duty : duties)
+            {
+                Output output;
+                const Generator previous = active[channel];
+                if (start == 0U)
+                {
+                    PWM_SetDutyCycle(static_cast<PWM_ChannelType>(channel), static_cast<uint8>(duty));
+                }
+                else
+                {
+                    PWM_SetDutyWindow(static_cast<PWM_ChannelType>(channel), static_cast<uint8>(start), static_cast<uint8>(duty));
+                }
+                periodEnd();
+                checker.check(active[channel] == previous, std::string(channelName(channel)) + ": start " + std::to_string(start) +
+                                                               "% duty " + std::to_string(duty) + "% applied without PWM_Update");
+                PWM_Update();
+                periodEnd();
+                const Generator generator = active[channel];
+                checker.check((generator.action & ~kActionMask) == 0U,
+                              std::string(channelName(channel)) + ": count up actions for start " + std::to_string(start) + "% duty " +
+                                  std::to_string(duty) + "%");
+                runPeriod(generator, output);
+                output.coincidences = 0;
+                checker.checkPeriod(runPeriod(generator, output), channel, start, duty, "");
+                windows++;
+                checker.check(output.coincidences == 0, std::string(channelName(channel)) + " start " + std::to_string(start) +
+                                                            "% duty " + std::to_string(duty) + "%: two events with an action on one count");
+            }
+        }
+        checker.check(active[other] == otherBefore, std::string("writes to ") + channelName(channel) + " changed " + channelName(other));
+    }
+    return windows;
+}
+
+/*
+ * Random windows written on one or both channels period after period, with PWM_Update most of the time:
+ * each period must show the window of the last PWM_Update before it, on both channels
+ */
+void checkSequences(Checker &checker, unsigned long periods, unsigned seed)
+{
+    std::mt19937 random(seed);
+    Output outputs[kChannels];
+    unsigned queued[kChannels][2] = { { 0U, 0U }, { 0U, 0U } }; /* Start and duty written */
+    unsigned applied[kChannels][2] = { { 0U, 0U }, { 0U, 0U } };
+
+    for (int channel = 0; channel < kChannels; channel++)
+    {
+        PWM_SetDutyCycle(static_cast<PWM_ChannelType>(channel), 0U);
+    }
+    PWM_Update();
+    periodEnd();
+    for (int channel = 0; channel < kChannels; channel++)
+    {
+        runPeriod(active[channel], outputs[channel]);
+    }
+
+    for (unsigned long period = 0; period < periods; period++)
+    {
+        const int first = static_cast<int>(random() % kChannels);
+        const int count = ((random() % 2U) == 0U) ? 1 : kChannels;
+        for (int i = 0; i < count; i++)
+        {
+            const int channel = (first + i) % kChannels;
+            const unsigned start = static_cast<unsigned>(random() % 100U);
+            unsigned duty = static_cast<unsigned>(random() % 101U);
+            duty = ((random() % 8U) == 0U) ? (((random() % 2U) == 0U) ? 0U : 100U) : duty;
+
+            PWM_SetDutyWindow(static_cast<PWM_ChannelType>(channel), static_cast<uint8>(start), static_cast<uint8>(duty));
+            queued[channel][0] = start;
+            queued[channel][1] = duty;
+        }
+        if ((random() % 4U) != 0U)
+        {
+            PWM_Update();
+            std::copy(&queued[0][0], &queued[0][0] + (2 * kChannels), &applied[0][0]);
+        }
+        periodEnd();
+
+        for (int channel = 0; channel < kChannels; channel++)
+        {
+            checker.checkPeriod(runPeriod(active[channel], outputs[channel]), channel, applied[channel][0], applied[channel][1],
+                                " after another window");
+        }
+    }
+}
+
+void usage()
+{
+    std::cerr << "Usage: pwm_output_test [-n <periods>] [-s <seed>]\n";
+}
+
+} /* namespace */
+
+int main(int argc, char *argv[])
+{
+    unsigned long periods = 20000UL;
+    unsigned seed = 1U;
+    Checker checker;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const std::string arg = argv[i];
+        if ((arg == "-n") && (i + 1 < argc))
+        {
+            periods = std::strtoul(argv[++i], nullptr, 10);
+        }
+        else if ((arg == "-s") && (i + 1 < argc))
+        {
+            seed = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else
+        {
+            usage();
+            return 1;
+        }
+    }
+
+    checkInit(checker);
+    const unsigned long windows = checkWindows(checker);
+    checkSequences(checker, periods, seed);
+
+    std::cout << "PWM_Init, " << windows << " windows and " << periods << " periods of random windows checked, "
+              << checker.errors() << " errors\n";
+    std::cout << ((checker.errors() == 0) ? "PASS" : "FAIL") << "\n";
+    return (checker.errors() == 0) ? 0 : 2;
+}
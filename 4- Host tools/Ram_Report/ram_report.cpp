@@ -0,0 +1,768 @@
+/*
+ ============================================================================
+ Name        : ram_report.cpp
+ Module Name : RAM Report
+ Description : Build time RAM budget report of the statically allocated kernel objects of the
+               firmware (configSUPPORT_STATIC_ALLOCATION = 1). Every mainCREATE_* call of
+               main() in main.c is listed with the RAM of its static buffers: the task control
+               block and stack, the semaphore or timer control block, the queue
+               control block and storage. The idle and timer service tasks owned by the kernel
+               are added, then the total.
+               - The sizes of the FreeRTOS static types (StaticTask_t, StackType_t, ...) and of
+                 the queue items are those of the target: the first build step compiles the
+                 probe part of this file against FreeRTOSConfig.h for a 32 bit ABI with 8 byte
+                 alignment of the 64 bit types, as the ARM EABI, and the sizes of its arrays
+                 are passed to the second step as RAM_SIZE_* definitions.
+               - The calls are read from main.c with the #if/#else/#endif around them, and the
+                 stack depths, queue lengths and options are the #define values of main.c,
+                 FreeRTOSConfig.h and the Control module headers, or the -D options.
+               Every line has the format:
+                 RAM,<task name or handle>,<bytes>
+               and the last one is RAM,Total,<bytes>. With -x, every object is listed with its
+               RAM in both configurations, and the difference of the totals.
+
+ Build       : FW="../../1- Application project/FreeRTOS_Final_Project_WS/Seat_Heater_Control_System"
+               INC=(-I"$FW" -I"$FW/Common" -I"$FW/Control" -I"$FW/FreeRTOS/Source/include"
+                    -I"$FW/FreeRTOS/Source/portable/CCS/ARM_CM4F")
+               gcc -m32 -malign-double -ffreestanding -DRAM_REPORT_PROBE "${INC[@]}" -x c -c ram_report.cpp -o ram_probe.o
+               SIZES=(); while read -r addr size type name; do SIZES+=(-D"$name=$((16#$size))"); done < <(nm -S ram_probe.o)
+               g++ -std=c++17 -O2 "${SIZES[@]}" -o ram_report ram_report.cpp
+ Usage       : ram_report [options] [firmware directory]
+               -D <name>=<value> Value of a main.c option or definition, for example
+                                 -D mainUSE_SOFTWARE_TIMERS=1.
+               -x <name>=<value> Compare with the configuration where the definition has this value.
+               -l <bytes>        Fail when the total is above this budget.
+               The firmware directory defaults to the one of the build line.
+
+ Exit status : 0, 2 when the total is above the -l budget, 1 on input errors.
+ ============================================================================
+ */
+
+#ifdef RAM_REPORT_PROBE
+
+/* Probe built for the target ABI: only the sizes of its arrays are used */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+#include "queue.h"
+#include "semphr.h"
+#include "DiagLog.h"
+
+unsigned char RAM_SIZE_StaticTask_t[sizeof(StaticTask_t)];
+unsigned char RAM_SIZE_StackType_t[sizeof(StackType_t)];
+unsigned char RAM_SIZE_StaticQueue_t[sizeof(StaticQueue_t)];
+unsigned char RAM_SIZE_StaticSemaphore_t[sizeof(StaticSemaphore_t)];
+unsigned char RAM_SIZE_StaticTimer_t[sizeof(StaticTimer_t)];
+unsigned char RAM_SIZE_xFailureLog[sizeof(DiagLog_EntryType)]; /* The diagnostic queue item of main.c */
+
+#else
+
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#if !defined(RAM_SIZE_StaticTask_t) || !defined(RAM_SIZE_StackType_t) || !defined(RAM_SIZE_StaticQueue_t) || \
+    !defined(RAM_SIZE_StaticSemaphore_t) || !defined(RAM_SIZE_StaticTimer_t) || \
+    !defined(RAM_SIZE_xFailureLog)
+#error "Build the probe first and pass its sizes, see the Build lines"
+#endif
+
+namespace
+{
+
+const char kDefaultFirmware[] = "../../1- Application project/FreeRTOS_Final_Project_WS/Seat_Heater_Control_System";
+
+/* Sizes of the queue items of main.c, in bytes on the target */
+const std::map<std::string, unsigned long> kItemSizes = {
+    { "uint8", 1UL },
+    { "xFailureLog", RAM_SIZE_xFailureLog },
+};
+
+struct Object
+{
+    std::string name;
+    unsigned long bytes;
+};
+
+using Definitions = std::map<std::string, std::string>;
+
+bool readFile(const std::string &path, std::string &text)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in)
+    {
+        std::cerr << "Can not open " << path << "\n";
+        return false;
+    }
+    std::ostringstream ss;
+    ss << in.rdbuf();
+    text = ss.str();
+    return true;
+}
+
+std::vector<std::string> splitLines(const std::string &text)
+{
+    std::vector<std::string> lines;
+    std::istringstream ss(text);
+    std::string line;
+
+    while (std::getline(ss, line))
+    {
+        if (!line.empty() && (line.back() == '\r'))
+        {
+            line.pop_back();
+        }
+        lines.push_back(line);
+    }
+    return lines;
+}
+
+/* The object-like #define of a file, the first definition of a name is kept */
+void addDefinitions(const std::string &text, Definitions &definitions)
+{
+    static const std::regex define(R"(^\s*#\s*define\s+([A-Za-z_]\w*)[ \t]+([^/\r\n]*?)\s*(/[*/].*)?$)");
+    std::smatch match;
+
+    for (const std::string &line : splitLines(text))
+    {
+        if (std::regex_match(line, match, define) && (definitions.find(match[1]) == definitions.end()))
+        {
+            definitions[match[1]] = match[2];
+        }
+    }
+}
+
+/* Evaluates the integer expressions of the #if lines and of the creation arguments */
+class Evaluator
+{
+public:
+    Evaluator(const Definitions &definitions) : definitions_(definitions)
+    {
+    }
+
+    bool evaluate(const std::string &expression, long &value)
+    {
+        text_ = expression;
+        pos_ = 0;
+        depth_ = 0;
+        ok_ = true;
+        value = orExpression();
+        skipSpace();
+        return ok_ && (pos_ == text_.size());
+    }
+
+private:
+    void skipSpace()
+    {
+        while ((pos_ < text_.size()) && std::isspace(static_cast<unsigned char>(text_[pos_])))
+        {
+            pos_++;
+        }
+    }
+
+    bool accept(const char *token)
+    {
+        skipSpace();
+        const std::string t(token);
+        if (text_.compare(pos_, t.size(), t) == 0)
+        {
+            pos_ += t.size();
+            return true;
+        }
+        return false;
+    }
+
+    std::string identifier()
+    {
+        skipSpace();
+        const std::size_t start = pos_;
+        while ((pos_ < text_.size()) && (std::isalnum(static_cast<unsigned char>(text_[pos_])) || (text_[pos_] == '_')))
+        {
+            pos_++;
+        }
+        return text_.substr(start, pos_ - start);
+    }
+
+    long orExpression()
+    {
+        long value = andExpression();
+        while (accept("||"))
+        {
+            const long right = andExpression();
+            value = (value || right) ? 1 : 0;
+        }
+        return value;
+    }
+
+    long andExpression()
+    {
+        long value = compareExpression();
+        while (accept("&&"))
+        {
+            const long right = compareExpression();
+            value = (value && right) ? 1 : 0;
+        }
+        return value;
+    }
+
+    long compareExpression()
+    {
+        long value = additive();
+        for (;;)
+        {
+            if (accept("=="))
+            {
+                value = (value == additive()) ? 1 : 0;
+            }
+            else if (accept("!="))
+            {
+                value = (value != additive()) ? 1 : 0;
+            }
+            else if (accept("<="))
+            {
+                value = (value <= additive()) ? 1 : 0;
+            }
+            else if (accept(">="))
+            {
+                value = (value >= additive()) ? 1 : 0;
+            }
+            else if (accept("<"))
+            {
+                value = (value < additive()) ? 1 : 0;
+            }
+            else if (accept(">"))
+            {
+                value = (value > additive()) ? 1 : 0;
+            }
+            else
+            {
+                return value;
+            }
+        }
+    }
+
+    long additive()
+    {
+        long value = multiplicative();
+        for (;;)
+        {
+            if (accept("+"))
+            {
+                value += multiplicative();
+            }
+            else if (accept("-"))
+            {
+                value -= multiplicative();
+            }
+            else
+            {
+                return value;
+            }
+        }
+    }
+
+    long multiplicative()
+    {
+        long value = unary();
+        for (;;)
+        {
+            if (accept("*"))
+            {
+                value *= unary();
+            }
+            else if (accept("/"))
+            {
+                const long right = unary();
+                value = (right != 0) ? (value / right) : (ok_ = false, 0);
+            }
+            else
+            {
+                return value;
+            }
+        }
+    }
+
+    long unary()
+    {
+        if (accept("!"))
+        {
+            return unary() ? 0 : 1;
+        }
+        if (accept("-"))
+        {
+            return -unary();
+        }
+        if (accept("("))
+        {
+            /* A cast such as (size_t) is skipped */
+            const std::size_t start = pos_;
+            const std::string name = identifier();
+            if (!name.empty() && (definitions_.find(name) == definitions_.end()) && accept(")") && isType(name))
+            {
+                return unary();
+            }
+            pos_ = start;
+            const long value = orExpression();
+            if (!accept(")"))
+            {
+                ok_ = false;
+            }
+            return value;
+        }
+        skipSpace();
+        if ((pos_ < text_.size()) && std::isdigit(static_cast<unsigned char>(text_[pos_])))
+        {
+            char *end = nullptr;
+            const long value = std::strtol(text_.c_str() + pos_, &end, 0);
+            pos_ = static_cast<std::size_t>(end - text_.c_str());
+            while ((pos_ < text_.size()) && std::isalpha(static_cast<unsigned char>(text_[pos_])))
+            {
+                pos_++; /* U and L suffixes */
+            }
+            return value;
+        }
+
+        const std::string name = identifier();
+        if (name.empty())
+        {
+            ok_ = false;
+            return 0;
+        }
+        if (name == "defined")
+        {
+            const bool parenthesis = accept("(");
+            const std::string macro = identifier();
+            if (parenthesis && !accept(")"))
+            {
+                ok_ = false;
+            }
+            return (definitions_.find(macro) != definitions_.end()) ? 1 : 0;
+        }
+        if (name == "sizeof")
+        {
+            const bool parenthesis = accept("(");
+            const std::string type = identifier();
+            const auto item = kItemSizes.find(type);
+            if (!parenthesis || !accept(")") || (item == kItemSizes.end()))
+            {
+                std::cerr << "Unknown size of " << type << "\n";
+                ok_ = false;
+                return 0;
+            }
+            return static_cast<long>(item->second);
+        }
+
+        /* A macro is its definition, an unknown name is 0 as for the preprocessor */
+        const auto definition = definitions_.find(name);
+        if (definition == definitions_.end())
+        {
+            return 0;
+        }
+        if (++depth_ > 32)
+        {
+            ok_ = false;
+            return 0;
+        }
+        const std::string saved = text_;
+        const std::size_t savedPos = pos_;
+        long value = 0;
+        text_ = definition->second;
+        pos_ = 0;
+        value = orExpression();
+        skipSpace();
+        if (pos_ != text_.size())
+        {
+            ok_ = false;
+        }
+        text_ = saved;
+        pos_ = savedPos;
+        depth_--;
+        return value;
+    }
+
+    static bool isType(const std::string &name)
+    {
+        return (name == "size_t") || (name == "uint8") || (name == "uint16") || (name == "uint32") || (name == "UBaseType_t") ||
+               (name == "TickType_t");
+    }
+
+    const Definitions &definitions_;
+    std::string text_;
+    std::size_t pos_ = 0;
+    int depth_ = 0;
+    bool ok_ = true;
+};
+
+/* Arguments of a macro call, split at the top level commas */
+std::vector<std::string> splitArguments(const std::string &arguments)
+{
+    std::vector<std::string> result(1);
+    int depth = 0;
+    bool quoted = false;
+
+    for (char c : arguments)
+    {
+        if (c == '"')
+        {
+            quoted = !quoted;
+        }
+        else if (!quoted && (c == '('))
+        {
+            depth++;
+        }
+        else if (!quoted && (c == ')'))
+        {
+            depth--;
+        }
+        else if (!quoted && (depth == 0) && (c == ','))
+        {
+            result.emplace_back();
+            continue;
+        }
+        result.back() += c;
+    }
+    for (std::string &argument : result)
+    {
+        const std::size_t first = argument.find_first_not_of(" \t");
+        const std::size_t last = argument.find_last_not_of(" \t");
+        argument = (first == std::string::npos) ? "" : argument.substr(first, last - first + 1U);
+    }
+    return result;
+}
+
+/* The RAM of one creation call, false when it can not be evaluated */
+bool objectRam(const std::string &kind, const std::vector<std::string> &arguments, Evaluator &evaluator, Object &object)
+{
+    long depth = 0;
+    long length = 0;
+    long item = 0;
+
+    object.name = arguments[0];
+    if (kind == "TASK")
+    {
+        if ((arguments.size() != 5U) || !evaluator.evaluate(arguments[2], depth))
+        {
+            return false;
+        }
+        object.name = arguments[1].substr(1, arguments[1].size() - 2U);
+        object.bytes = (static_cast<unsigned long>(depth) * RAM_SIZE_StackType_t) + RAM_SIZE_StaticTask_t;
+    }
+    else if ((kind == "MUTEX") || (kind == "BINARY_SEMAPHORE"))
+    {
+        object.bytes = RAM_SIZE_StaticSemaphore_t;
+    }
+    else if (kind == "QUEUE")
+    {
+        if ((arguments.size() != 3U) || !evaluator.evaluate(arguments[1], length) || !evaluator.evaluate(arguments[2], item))
+        {
+            return false;
+        }
+        object.bytes = (static_cast<unsigned long>(length) * static_cast<unsigned long>(item)) + RAM_SIZE_StaticQueue_t;
+    }
+    else if (kind == "TIMER")
+    {
+        object.bytes = RAM_SIZE_StaticTimer_t;
+    }
+    else
+    {
+        return false;
+    }
+    return true;
+}
+
+/* The kernel objects created by main() for the given definitions, false on an input error */
+bool listObjects(const std::vector<std::string> &mainLines, const Definitions &definitions, std::vector<Object> &objects)
+{
+    static const std::regex directive(R"(^\s*#\s*(if|ifdef|ifndef|elif|else|endif)\b\s*(.*?)\s*(/[*/].*)?$)");
+    static const std::regex create(R"(mainCREATE_(TASK|MUTEX|BINARY_SEMAPHORE|QUEUE|TIMER)\s*\((.*)\)\s*;)");
+    Evaluator evaluator(definitions);
+    long value = 0;
+
+    if (!evaluator.evaluate("configSUPPORT_STATIC_ALLOCATION", value) || (value != 1))
+    {
+        std::cerr << "configSUPPORT_STATIC_ALLOCATION is not 1, the kernel objects come from the FreeRTOS heap\n";
+        return false;
+    }
+
+    /* Conditions: whether the group is active, and whether one of its branches was taken */
+    struct Condition
+    {
+        bool active;
+        bool taken;
+    };
+    std::vector<Condition> conditions;
+    bool inMain = false;
+
+    for (std::size_t i = 0; i < mainLines.size(); i++)
+    {
+        const std::string &line = mainLines[i];
+        std::smatch match;
+
+        if (!inMain)
+        {
+            inMain = (line.rfind("int main(", 0) == 0);
+            continue;
+        }
+        if (line.rfind("}", 0) == 0)
+        {
+            break;
+        }
+
+        const bool active = conditions.empty() || conditions.back().active;
+        if (std::regex_match(line, match, directive))
+        {
+            const std::string keyword = match[1];
+            const std::string argument = match[2];
+            bool result = false;
+
+            if ((keyword == "if") || (keyword == "elif"))
+            {
+                if (!evaluator.evaluate(argument, value))
+                {
+                    std::cerr << "main.c:" << i + 1U << ": can not evaluate " << argument << "\n";
+                    return false;
+                }
+                result = (value != 0);
+            }
+            else if ((keyword == "ifdef") || (keyword == "ifndef"))
+            {
+                result = ((definitions.find(argument) != definitions.end()) == (keyword == "ifdef"));
+            }
+
+            if ((keyword == "if") || (keyword == "ifdef") || (keyword == "ifndef"))
+            {
+                conditions.push_back({ active && result, result });
+            }
+            else if (conditions.empty())
+            {
+                std::cerr << "main.c:" << i + 1U << ": #" << keyword << " without #if\n";
+                return false;
+            }
+            else
+            {
+                const bool parentActive = (conditions.size() < 2U) || conditions[conditions.size() - 2U].active;
+                Condition &condition = conditions.back();
+                if (keyword == "endif")
+                {
+                    conditions.pop_back();
+                }
+                else
+                {
+                    const bool branch = !condition.taken && ((keyword == "else") || result);
+                    condition.active = parentActive && branch;
+                    condition.taken = condition.taken || branch;
+                }
+            }
+            continue;
+        }
+
+        if (active && std::regex_search(line, match, create))
+        {
+            Object object;
+            if (!objectRam(match[1], splitArguments(match[2]), evaluator, object))
+            {
+                std::cerr << "main.c:" << i + 1U << ": can not evaluate " << line << "\n";
+                return false;
+            }
+            objects.push_back(object);
+        }
+    }
+    if (!inMain)
+    {
+        std::cerr << "main() not found in main.c\n";
+        return false;
+    }
+
+    /* The tasks owned by the kernel, their memory is given by vApplicationGet...TaskMemory() */
+    long idleDepth = 0;
+    long timerDepth = 0;
+    if (!evaluator.evaluate("configMINIMAL_STACK_SIZE", idleDepth) || !evaluator.evaluate("configTIMER_TASK_STACK_DEPTH", timerDepth))
+    {
+        std::cerr << "Can not evaluate the idle and timer task stack depths\n";
+        return false;
+    }
+    objects.push_back({ "IDLE", (static_cast<unsigned long>(idleDepth) * RAM_SIZE_StackType_t) + RAM_SIZE_StaticTask_t });
+    if (evaluator.evaluate("configUSE_TIMERS", value) && (value == 1))
+    {
+        objects.push_back({ "Tmr Svc", (static_cast<unsigned long>(timerDepth) * RAM_SIZE_StackType_t) + RAM_SIZE_StaticTask_t });
+    }
+    return true;
+}
+
+unsigned long total(const std::vector<Object> &objects)
+{
+    unsigned long bytes = 0;
+    for (const Object &object : objects)
+    {
+        bytes += object.bytes;
+    }
+    return bytes;
+}
+
+/* The definitions of a configuration: the options given, then main.c, FreeRTOSConfig.h and the module defaults */
+bool loadDefinitions(const std::string &firmware, const std::string &mainText, Definitions &definitions)
+{
+    std::string text;
+
+    addDefinitions(mainText, definitions);
+    if (!readFile(firmware + "/FreeRTOSConfig.h", text))
+    {
+        return false;
+    }
+    addDefinitions(text, definitions);
+    for (const char *header : { "Common/FaultInject_Hooks.h", "Control/Trace.h", "Control/LockProfile.h", "Control/CpuLoad.h", "Control/RunStats.h",
+                                "Control/DiagLog.h" })
+    {
+        if (!readFile(firmware + "/" + header, text))
+        {
+            return false;
+        }
+        addDefinitions(text, definitions);
+    }
+    return true;
+}
+
+bool parseDefinition(const std::string &text, std::string &name, std::string &value)
+{
+    const std::size_t equal = text.find('=');
+    if ((equal == std::string::npos) || (equal == 0U))
+    {
+        return false;
+    }
+    name = text.substr(0, equal);
+    value = text.substr(equal + 1U);
+    return true;
+}
+
+void usage()
+{
+    std::cerr << "Usage: ram_report [-D name=value]... [-x name=value] [-l bytes] [firmware directory]\n";
+}
+
+} /* namespace */
+
+int main(int argc, char *argv[])
+{
+    std::string firmware = kDefaultFirmware;
+    Definitions overrides;
+    std::string compareName;
+    std::string compareValue;
+    unsigned long limit = 0;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const std::string option = argv[i];
+        std::string name;
+        std::string value;
+
+        if (((option == "-D") || (option == "-x") || (option == "-l")) && ((i + 1) >= argc))
+        {
+            usage();
+            return 1;
+        }
+        if (option == "-D")
+        {
+            if (!parseDefinition(argv[++i], name, value))
+            {
+                usage();
+                return 1;
+            }
+            overrides[name] = value;
+        }
+        else if (option == "-x")
+        {
+            if (!parseDefinition(argv[++i], compareName, compareValue))
+            {
+                usage();
+                return 1;
+            }
+        }
+        else if (option == "-l")
+        {
+            limit = std::strtoul(argv[++i], nullptr, 10);
+        }
+        else if ((option[0] != '-') && (i == (argc - 1)))
+        {
+            firmware = option;
+        }
+        else
+        {
+            usage();
+            return 1;
+        }
+    }
+
+    std::string mainText;
+    Definitions definitions = overrides;
+    if (!readFile(firmware + "/main.c", mainText) || !loadDefinitions(firmware, mainText, definitions))
+    {
+        return 1;
+    }
+
+    const std::vector<std::string> mainLines = splitLines(mainText);
+    std::vector<Object> objects;
+    if (!listObjects(mainLines, definitions, objects))
+    {
+        return 1;
+    }
+    const unsigned long bytes = total(objects);
+
+    if (compareName.empty())
+    {
+        for (const Object &object : objects)
+        {
+            std::cout << "RAM," << object.name << "," << object.bytes << "\n";
+        }
+        std::cout << "RAM,Total," << bytes << "\n";
+    }
+    else
+    {
+        Definitions other = overrides;
+        std::vector<Object> otherObjects;
+        other[compareName] = compareValue;
+        if (!loadDefinitions(firmware, mainText, other) || !listObjects(mainLines, other, otherObjects))
+        {
+            return 1;
+        }
+
+        /* Every object of either configuration, with its RAM in both (0 when it is not created) */
+        std::map<std::string, std::pair<unsigned long, unsigned long>> both;
+        std::vector<std::string> order;
+        for (const Object &object : objects)
+        {
+            both[object.name].first = object.bytes;
+            order.push_back(object.name);
+        }
+        for (const Object &object : otherObjects)
+        {
+            if (both.find(object.name) == both.end())
+            {
+                order.push_back(object.name);
+            }
+            both[object.name].second = object.bytes;
+        }
+        std::cout << "RAM,<object>,<bytes>,<bytes with " << compareName << "=" << compareValue << ">\n";
+        for (const std::string &name : order)
+        {
+            std::cout << "RAM," << name << "," << both[name].first << "," << both[name].second << "\n";
+        }
+        const unsigned long otherBytes = total(otherObjects);
+        std::cout << "RAM,Total," << bytes << "," << otherBytes << "\n";
+        std::cout << "Difference: " << static_cast<long>(otherBytes) - static_cast<long>(bytes) << " bytes\n";
+    }
+
+    if ((limit != 0U) && (bytes > limit))
+    {
+        std::cerr << "The kernel objects use " << bytes << " bytes, the budget is " << limit << "\n";
+        return 2;
+    }
+    return 0;
+}
+
+#endif /* RAM_REPORT_PROBE */
@@ -0,0 +1,374 @@
+/*
+ ============================================================================
+ Name        : schedulability.cpp
+ Module Name : Schedulability Analysis Tool
+ Description : Host tool that reads the Seat Heater Control System task table, runs
+               response time analysis under fixed priority preemptive scheduling with
+               priority inheritance blocking, proposes deadline monotonic priorities and
+               regenerates the SimSo model from the same table.
+
+ Build       : g++ -std=c++17 -O2 -o schedulability schedulability.cpp
+ Usage       : schedulability [options] task_table.csv
+               -l <levels>       Number of application priority levels, default 4 (1..4,
+                                 0 is the idle task).
+               -s <simso.xml>    Regenerate the SimSo model.
+               -p                Use the proposed priorities in the SimSo model instead of
+                                 the ones of the task table.
+
+ Exit status : 0 when every task meets its deadline with the task table priorities,
+               2 when a task can miss its deadline, 1 on input errors.
+ ============================================================================
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+struct Task
+{
+    std::string name;
+    double period = 0.0;
+    double deadline = 0.0;
+    double wcet = 0.0;
+    int priority = 0;
+    int proposedPriority = 0;
+    std::map<std::string, double> criticalSections; /* mutex -> longest critical section */
+};
+
+struct Result
+{
+    double blocking = 0.0;
+    double response = 0.0;
+    bool schedulable = false;
+};
+
+std::string trim(const std::string &text)
+{
+    const std::size_t first = text.find_first_not_of(" \t\r");
+    if (first == std::string::npos)
+    {
+        return "";
+    }
+    const std::size_t last = text.find_last_not_of(" \t\r");
+    return text.substr(first, last - first + 1);
+}
+
+bool readTaskTable(const std::string &path, std::vector<Task> &tasks)
+{
+    std::ifstream file(path);
+    if (!file)
+    {
+        std::cerr << "schedulability: cannot open " << path << "\n";
+        return false;
+    }
+
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line))
+    {
+        ++lineNumber;
+        line = trim(line);
+        if (line.empty() || line[0] == '#')
+        {
+            continue;
+        }
+
+        std::vector<std::string> fields;
+        std::stringstream ss(line);
+        std::string field;
+        while (std::getline(ss, field, ','))
+        {
+            fields.push_back(trim(field));
+        }
+        if (fields.size() < 5 || fields.size() > 6)
+        {
+            std::cerr << path << ":" << lineNumber << ": expected 5 or 6 fields\n";
+            return false;
+        }
+
+        Task task;
+        task.name = fields[0];
+        task.period = std::strtod(fields[1].c_str(), nullptr);
+        task.deadline = std::strtod(fields[2].c_str(), nullptr);
+        task.wcet = std::strtod(fields[3].c_str(), nullptr);
+        task.priority = std::atoi(fields[4].c_str());
+        if (task.period <= 0.0 || task.deadline <= 0.0 || task.wcet <= 0.0)
+        {
+            std::cerr << path << ":" << lineNumber << ": period, deadline and WCET must be positive\n";
+            return false;
+        }
+
+        if (fields.size() == 6)
+        {
+            std::stringstream resources(fields[5]);
+            std::string resource;
+            while (std::getline(resources, resource, ';'))
+            {
+                const std::size_t colon = resource.find(':');
+                if (colon == std::string::npos)
+                {
+                    std::cerr << path << ":" << lineNumber << ": resource '" << resource << "' has no critical section\n";
+                    return false;
+                }
+                const std::string mutex = trim(resource.substr(0, colon));
+                const double section = std::strtod(resource.substr(colon + 1).c_str(), nullptr);
+                task.criticalSections[mutex] = std::max(task.criticalSections[mutex], section);
+            }
+        }
+
+        tasks.push_back(task);
+    }
+
+    if (tasks.empty())
+    {
+        std::cerr << "schedulability: " << path << " has no tasks\n";
+        return false;
+    }
+    return true;
+}
+
+/*
+ * Worst case blocking of a task under the priority inheritance protocol: a task can be blocked
+ * at most once per lower priority task and at most once per mutex whose ceiling is at least
+ * its priority, so the bound is the smaller of the two sums.
+ */
+double blockingTime(const std::vector<Task> &tasks, std::size_t index, const std::vector<int> &priorities)
+{
+    std::map<std::string, int> ceilings;
+    for (std::size_t j = 0; j < tasks.size(); ++j)
+    {
+        for (const auto &section : tasks[j].criticalSections)
+        {
+            int &ceiling = ceilings[section.first];
+            ceiling = std::max(ceiling, priorities[j]);
+        }
+    }
+
+    double perTask = 0.0;
+    std::map<std::string, double> perMutex;
+    for (std::size_t j = 0; j < tasks.size(); ++j)
+    {
+        if (priorities[j] >= priorities[index])
+        {
+            continue; /* Equal priorities are accounted as interference, not blocking */
+        }
+
+        double longest = 0.0;
+        for (const auto &section : tasks[j].criticalSections)
+        {
+            if (ceilings[section.first] >= priorities[index])
+            {
+                longest = std::max(longest, section.second);
+                perMutex[section.first] = std::max(perMutex[section.first], section.second);
+            }
+        }
+        perTask += longest;
+    }
+
+    double mutexSum = 0.0;
+    for (const auto &entry : perMutex)
+    {
+        mutexSum += entry.second;
+    }
+    return std::min(perTask, mutexSum);
+}
+
+/*
+ * Response time analysis: R = C + B + sum(ceil(R / Tj) * Cj) over every other task with a higher
+ * or equal priority. Equal priorities are included because FreeRTOS round-robins between them.
+ */
+Result responseTime(const std::vector<Task> &tasks, std::size_t index, const std::vector<int> &priorities)
+{
+    Result result;
+    const Task &task = tasks[index];
+    result.blocking = blockingTime(tasks, index, priorities);
+
+    double response = task.wcet + result.blocking;
+    for (;;)
+    {
+        double next = task.wcet + result.blocking;
+        for (std::size_t j = 0; j < tasks.size(); ++j)
+        {
+            if (j != index && priorities[j] >= priorities[index])
+            {
+                next += std::ceil(response / tasks[j].period) * tasks[j].wcet;
+            }
+        }
+
+        if (next > task.deadline)
+        {
+            result.response = next;
+            result.schedulable = false;
+            return result;
+        }
+        if (next == response)
+        {
+            result.response = response;
+            result.schedulable = true;
+            return result;
+        }
+        response = next;
+    }
+}
+
+/*
+ * Deadline monotonic priority assignment: the shorter the deadline, the higher the priority.
+ * Tasks with the same deadline share a level; when there are more distinct deadlines than
+ * levels, the longest deadlines are merged into the lowest level.
+ */
+void assignDeadlineMonotonic(std::vector<Task> &tasks, int levels)
+{
+    std::vector<double> deadlines;
+    for (const Task &task : tasks)
+    {
+        deadlines.push_back(task.deadline);
+    }
+    std::sort(deadlines.begin(), deadlines.end());
+    deadlines.erase(std::unique(deadlines.begin(), deadlines.end()), deadlines.end());
+
+    for (Task &task : tasks)
+    {
+        const int rank = static_cast<int>(std::lower_bound(deadlines.begin(), deadlines.end(), task.deadline) - deadlines.begin());
+        task.proposedPriority = std::max(1, levels - rank);
+    }
+}
+
+bool analyse(const std::vector<Task> &tasks, bool proposed)
+{
+    std::vector<int> priorities;
+    for (const Task &task : tasks)
+    {
+        priorities.push_back(proposed ? task.proposedPriority : task.priority);
+    }
+
+    bool allSchedulable = true;
+    double utilisation = 0.0;
+
+    std::cout << (proposed ? "Proposed deadline monotonic priorities\n" : "Task table priorities\n");
+    std::cout << std::left << std::setw(22) << "Task" << std::right << std::setw(5) << "Prio" << std::setw(10) << "T"
+              << std::setw(10) << "D" << std::setw(10) << "C" << std::setw(10) << "B" << std::setw(10) << "R" << "\n";
+
+    for (std::size_t i = 0; i < tasks.size(); ++i)
+    {
+        const Result result = responseTime(tasks, i, priorities);
+        utilisation += tasks[i].wcet / tasks[i].period;
+
+        std::cout << std::left << std::setw(22) << tasks[i].name << std::right << std::setw(5) << priorities[i] << std::fixed
+                  << std::setprecision(2) << std::setw(10) << tasks[i].period << std::setw(10) << tasks[i].deadline << std::setw(10)
+                  << tasks[i].wcet << std::setw(10) << result.blocking << std::setw(10);
+        if (result.schedulable)
+        {
+            std::cout << result.response << "\n";
+        }
+        else
+        {
+            std::cout << (">" + std::to_string(static_cast<long>(tasks[i].deadline))) << "  MISS: can miss its deadline\n";
+            allSchedulable = false;
+        }
+    }
+
+    std::cout << "Utilisation: " << std::setprecision(1) << utilisation * 100.0 << "%, "
+              << (allSchedulable ? "all deadlines met" : "deadline misses possible") << "\n\n";
+    return allSchedulable;
+}
+
+bool writeSimso(const std::string &path, const std::vector<Task> &tasks, bool proposed)
+{
+    std::ofstream file(path);
+    if (!file)
+    {
+        std::cerr << "schedulability: cannot write " << path << "\n";
+        return false;
+    }
+
+    file << "<?xml version=\"1.0\" ?>\n";
+    file << "<simulation cycles_per_ms=\"1000000\" duration=\"1000000000\" etm=\"wcet\">\n";
+    file << "\t<sched class=\"simso.schedulers.FP\" overhead=\"0\" overhead_activate=\"0\" overhead_terminate=\"0\"/>\n";
+    file << "\t<caches memory_access_time=\"100\"/>\n";
+    file << "\t<processors>\n";
+    file << "\t\t<processor cl_overhead=\"0\" cs_overhead=\"0\" id=\"1\" name=\"CPU 1\" speed=\"1.0\"/>\n";
+    file << "\t</processors>\n";
+    file << "\t<tasks>\n";
+    file << "\t\t<field name=\"priority\" type=\"int\"/>\n";
+
+    for (std::size_t i = 0; i < tasks.size(); ++i)
+    {
+        const Task &task = tasks[i];
+        file << "\t\t<task ACET=\"0.0\" WCET=\"" << task.wcet << "\" abort_on_miss=\"yes\" activationDate=\"0.0\" base_cpi=\"1.0\" deadline=\""
+             << std::fixed << std::setprecision(1) << task.deadline << "\" et_stddev=\"0.0\" id=\"" << (i + 1)
+             << "\" instructions=\"0\" list_activation_dates=\"\" mix=\"0.5\" name=\"" << task.name << "\" period=\"" << task.period
+             << "\" preemption_cost=\"0\" priority=\"" << (proposed ? task.proposedPriority : task.priority)
+             << "\" task_type=\"Periodic\"/>\n";
+        file.unsetf(std::ios::fixed);
+        file << std::setprecision(6);
+    }
+
+    file << "\t</tasks>\n";
+    file << "</simulation>\n";
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    int levels = 4;
+    std::string simsoPath;
+    bool simsoProposed = false;
+    std::string tablePath;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        if (arg == "-l" && i + 1 < argc)
+        {
+            levels = std::atoi(argv[++i]);
+        }
+        else if (arg == "-s" && i + 1 < argc)
+        {
+            simsoPath = argv[++i];
+        }
+        else if (arg == "-p")
+        {
+            simsoProposed = true;
+        }
+        else
+        {
+            tablePath = arg;
+        }
+    }
+
+    if (tablePath.empty() || levels < 1)
+    {
+        std::cerr << "usage: schedulability [-l levels] [-s simso.xml] [-p] task_table.csv\n";
+        return 1;
+    }
+
+    std::vector<Task> tasks;
+    if (!readTaskTable(tablePath, tasks))
+    {
+        return 1;
+    }
+
+    assignDeadlineMonotonic(tasks, levels);
+
+    const bool schedulable = analyse(tasks, false);
+    analyse(tasks, true);
+
+    if (!simsoPath.empty() && !writeSimso(simsoPath, tasks, simsoProposed))
+    {
+        return 1;
+    }
+
+    return schedulable ? 0 : 2;
+}
@@ -0,0 +1,642 @@
+/*
+ ============================================================================
+ Name        : sensor_timer_test.cpp
+ Module Name : Sensor Timer Test
+ Description : Counts the context switches of the sensor tasks against the sensor timer of
+               main.c (mainUSE_SOFTWARE_TIMERS), from the kernel event trace of the firmware
+               (Control/Trace.c, TRACE_RECORDER = 1). A context switch is a switch in of a
+               task other than the running one; the sensor job is released at each ready
+               record of the driver sensor task (tag 1) or of the timer service task (tag 13),
+               and starts at the next switch in of that task.
+               - Default: the steady state scheduling of main.c is simulated for 5 minutes,
+                 once with the two sensor tasks (priority 4, every 100 ms) and once with the
+                 sensor processing of both seats as one timer callback on the timer service
+                 task (priority 4, every 100 ms). The other jobs are the same in both runs:
+                 the event driven heater tasks woken by their 2500 ms watchdog, the display
+                 task every 500 ms (an update of 250 ms on the UART every 2 s), the run time
+                 task every 5 s (a 210 ms report) and the fault store task every 5 s. The
+                 buttons, diagnostics and console tasks stay blocked. The ready tasks run by
+                 priority, with time slicing of the equal priorities at the tick. Every
+                 switch is recorded through the firmware Trace module with a host cycle
+                 counter and dumped every 2 s in the "trace dump" format, and each capture is
+                 decoded and counted like a board capture. The timer run must save at least
+                 0.9 context switch per sensor period, release the sensor job every 100 ms
+                 and start it within 1 ms, and every capture must be complete.
+               - <task capture> [timer capture]: the counts of "trace dump" captures of the
+                 board, built with mainUSE_SOFTWARE_TIMERS 0 and 1, and their difference.
+               The static RAM of the two builds is compared by the RAM report tool:
+               ram_report -x mainUSE_SOFTWARE_TIMERS=1 (4- Host tools/Ram_Report).
+
+ Build       : FW="../../1- Application project/FreeRTOS_Final_Project_WS/Seat_Heater_Control_System"
+               INC=(-I"$FW/Common" -I"$FW/Control")
+               gcc -O2 -DTRACE_HOST -DTRACE_RECORDER=1 "${INC[@]}" -c "$FW/Control/Trace.c"
+               g++ -std=c++17 -O2 -DTRACE_RECORDER=1 "${INC[@]}" -o sensor_timer_test sensor_timer_test.cpp Trace.o
+ Usage       : sensor_timer_test [<task capture> [timer capture]]
+
+ Exit status : 0, 2 when a check of the simulation fails, 1 on input errors.
+ ============================================================================
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+extern "C"
+{
+#include "Std_Types.h"
+#include "Trace.h"
+
+uint32 Trace_HostCycles(void);
+}
+
+namespace
+{
+
+/* Task tags of main.c (vTaskSetApplicationTaskTag) */
+constexpr int kDriverSensorTag = 1;
+constexpr int kPassengerSensorTag = 2;
+constexpr int kDriverHeaterTag = 7;
+constexpr int kPassengerHeaterTag = 8;
+constexpr int kDisplayTag = 9;
+constexpr int kRunTimeTag = 10;
+constexpr int kFaultStoreTag = 12;
+constexpr int kTimerTag = 13; /* mainRUNTIME_TAG_TIMER */
+constexpr int kIdleTag = 14;  /* mainRUNTIME_TAG_IDLE */
+constexpr int kMaxTags = 16;
+constexpr int kPriorities = 5; /* configMAX_PRIORITIES */
+
+/* Scheduling of main.c, in ms */
+constexpr unsigned long kRunMs = 300000UL;
+constexpr unsigned long kSensorPeriodMs = 100UL;     /* mainSENSOR_TASK_DELAY */
+constexpr unsigned long kHeaterWatchdogMs = 2500UL;  /* mainHEATER_WATCHDOG_DELAY */
+constexpr unsigned long kDisplayPeriodMs = 500UL;    /* mainDISPLAY_TASK_DELAY */
+constexpr unsigned long kRunTimePeriodMs = 5000UL;   /* mainRUNTIME_TASK_DELAY */
+constexpr unsigned long kFaultStorePeriodMs = 5000UL; /* mainFAULT_STORE_TASK_DELAY */
+constexpr unsigned long kDumpMs = 2000UL;
+constexpr std::uint64_t kCyclesPerUs = 16U;          /* 16 MHz */
+constexpr std::uint64_t kCyclesPerMs = 16000U;
+
+/* Execution times of the jobs, in cycles */
+constexpr std::uint64_t kSwitchCycles = 5U * kCyclesPerUs;
+constexpr std::uint64_t kSensorCycles = 80U * kCyclesPerUs;    /* One seat */
+constexpr std::uint64_t kTimerCycles = 10U * kCyclesPerUs;     /* Timer list and command queue of the timer service task */
+constexpr std::uint64_t kHeaterCycles = 40U * kCyclesPerUs;
+constexpr std::uint64_t kDisplayCheckCycles = 50U * kCyclesPerUs;
+constexpr std::uint64_t kDisplayUpdateCycles = 250U * kCyclesPerMs; /* About 240 characters at 9600 baud */
+constexpr unsigned kDisplayUpdateEvery = 4U;
+constexpr std::uint64_t kRunTimeCycles = 210U * kCyclesPerMs;  /* About 200 characters at 9600 baud */
+constexpr std::uint64_t kFaultStoreCycles = 1U * kCyclesPerMs;
+
+/* Limits of the checks */
+constexpr double kSavedPerPeriod = 0.9;
+constexpr double kSensorLatencyLimitMs = 1.0;
+constexpr double kPeriodToleranceMs = 0.01;
+
+struct Record
+{
+    std::uint16_t delta = 0;
+    std::uint8_t event = 0;
+    std::uint8_t object = 0;
+};
+
+/* A "trace dump" reply, only the task names are kept */
+struct Dump
+{
+    unsigned long lost = 0;
+    unsigned long cpuHz = 16000000UL;
+    unsigned shift = TRACE_TIME_SHIFT;
+    std::map<int, std::string> tasks;
+    std::vector<Record> records;
+};
+
+/* A decoded record, its time in units since "trace start" (since the oldest record when records were lost) */
+struct Event
+{
+    unsigned long long time = 0;
+    int event = 0;
+    int object = 0;
+};
+
+/* Counts of one or more captures, accumulated by analyze */
+struct SwitchStats
+{
+    double durationMs = 0.0;
+    unsigned long switches = 0;
+    unsigned long switchesIn[kMaxTags] = {};
+    unsigned long sensorReleases = 0;
+    double longestPeriodMs = 0.0;     /* Between two releases of the sensor job */
+    double shortestPeriodMs = 0.0;
+    double sensorLatencyMs = 0.0;     /* Longest from a release to the start of the sensor job */
+    std::map<int, std::string> names;
+
+    double switchesPerSecond() const
+    {
+        return (durationMs > 0.0) ? (static_cast<double>(switches) * 1000.0 / durationMs) : 0.0;
+    }
+};
+
+/* Cycle counter of the simulation, read by the Trace module */
+std::uint32_t hostCycles = 0;
+
+std::vector<std::string> splitFields(const std::string &line)
+{
+    std::vector<std::string> fields;
+    std::stringstream ss(line);
+    std::string field;
+    while (std::getline(ss, field, ','))
+    {
+        fields.push_back(field);
+    }
+    return fields;
+}
+
+/* Reads the line starting at pos, without its end of line, and moves pos after it */
+bool nextLine(const std::string &data, std::size_t &pos, std::string &line)
+{
+    if (pos >= data.size())
+    {
+        return false;
+    }
+    std::size_t end = data.find('\n', pos);
+    if (end == std::string::npos)
+    {
+        end = data.size();
+    }
+    line = data.substr(pos, end - pos);
+    if (!line.empty() && (line.back() == '\r'))
+    {
+        line.pop_back();
+    }
+    pos = end + 1;
+    return true;
+}
+
+bool parseDump(const std::string &data, Dump &dump)
+{
+    std::size_t pos = data.find("TRACE,DUMP,");
+    std::string line;
+    unsigned long count = 0;
+
+    if (pos == std::string::npos)
+    {
+        std::cerr << "No \"TRACE,DUMP\" line in the capture\n";
+        return false;
+    }
+    nextLine(data, pos, line);
+    std::vector<std::string> fields = splitFields(line);
+    if (fields.size() < 6)
+    {
+        std::cerr << "Bad line: " << line << "\n";
+        return false;
+    }
+    dump.lost = std::stoul(fields[3]);
+    dump.cpuHz = std::stoul(fields[4]);
+    dump.shift = static_cast<unsigned>(std::stoul(fields[5]));
+
+    for (;;)
+    {
+        if (!nextLine(data, pos, line))
+        {
+            std::cerr << "No \"TRACE,DATA\" line in the capture\n";
+            return false;
+        }
+        fields = splitFields(line);
+        if ((fields.size() >= 4) && (fields[1] == "TASK"))
+        {
+            dump.tasks[std::stoi(fields[2])] = fields[3];
+        }
+        else if ((fields.size() >= 3) && (fields[1] == "DATA"))
+        {
+            count = std::stoul(fields[2]);
+            break;
+        }
+    }
+
+    if (data.size() - pos < count * 4UL)
+    {
+        std::cerr << "Capture ends after " << (data.size() - pos) / 4 << " of " << count << " records\n";
+        return false;
+    }
+    for (unsigned long i = 0; i < count; i++, pos += 4)
+    {
+        Record record;
+        record.delta = static_cast<std::uint16_t>(static_cast<unsigned char>(data[pos]) |
+                                                  (static_cast<unsigned char>(data[pos + 1]) << 8));
+        record.event = static_cast<std::uint8_t>(data[pos + 2]);
+        record.object = static_cast<std::uint8_t>(data[pos + 3]);
+        dump.records.push_back(record);
+    }
+    return true;
+}
+
+/* Times of the records, as the trace converter decodes them */
+std::vector<Event> decode(const Dump &dump)
+{
+    std::vector<Event> events;
+    unsigned long long time = 0;
+    bool first = true;
+
+    for (const Record &record : dump.records)
+    {
+        if (record.event == TRACE_EVENT_TIME)
+        {
+            if (!first || (dump.lost == 0))
+            {
+                time += static_cast<unsigned long long>(record.delta) << 16;
+            }
+            continue;
+        }
+        if (!first || (dump.lost == 0))
+        {
+            time += record.delta;
+        }
+        first = false;
+        events.push_back({ time, record.event, record.object });
+    }
+    return events;
+}
+
+/*
+ * Counts the context switches of a capture. The task running at the start of a capture is not known, so
+ * its first switch in is counted as a switch. The sensor job is released by the ready records of the driver sensor
+ * task or of the timer service task, whichever the capture has.
+ */
+void analyze(const Dump &dump, const std::vector<Event> &events, SwitchStats &stats)
+{
+    const double msPerUnit = static_cast<double>(1UL << dump.shift) * 1e3 / static_cast<double>(dump.cpuHz);
+    bool timerBuild = false;
+    int running = -1;
+    double releaseMs = -1.0;
+    bool waiting = false; /* A released sensor job has not started yet */
+
+    for (const Event &event : events)
+    {
+        timerBuild = timerBuild || ((event.event == TRACE_EVENT_TASK_READY) && (event.object == kTimerTag));
+    }
+    const int sensorTag = timerBuild ? kTimerTag : kDriverSensorTag;
+
+    for (const Event &event : events)
+    {
+        const double ms = static_cast<double>(event.time) * msPerUnit;
+
+        if ((event.event == TRACE_EVENT_TASK_READY) && (event.object == sensorTag))
+        {
+            if (releaseMs >= 0.0)
+            {
+                const double periodMs = ms - releaseMs;
+                stats.shortestPeriodMs = (stats.longestPeriodMs > 0.0) ? std::min(stats.shortestPeriodMs, periodMs) : periodMs;
+                stats.longestPeriodMs = std::max(stats.longestPeriodMs, periodMs);
+            }
+            releaseMs = ms;
+            waiting = true;
+            stats.sensorReleases++;
+        }
+        else if (event.event == TRACE_EVENT_TASK_SWITCHED_IN)
+        {
+            if (waiting && (event.object == sensorTag))
+            {
+                stats.sensorLatencyMs = std::max(stats.sensorLatencyMs, ms - releaseMs);
+                waiting = false;
+            }
+            if ((event.object != running) && (event.object < kMaxTags))
+            {
+                stats.switches++;
+                stats.switchesIn[event.object]++;
+            }
+            running = event.object;
+        }
+    }
+    stats.durationMs += events.empty() ? 0.0 : (static_cast<double>(events.back().time - events.front().time) * msPerUnit);
+    stats.names.insert(dump.tasks.begin(), dump.tasks.end());
+}
+
+void printStats(const std::string &title, const SwitchStats &stats)
+{
+    std::cout << title << ": " << stats.switches << " context switches in " << std::setprecision(1) << stats.durationMs / 1000.0
+              << " s, " << std::setprecision(2) << stats.switchesPerSecond() << " per second\n";
+    std::cout << "  sensor job: " << stats.sensorReleases << " releases, period " << stats.shortestPeriodMs << " to "
+              << stats.longestPeriodMs << " ms, start latency up to " << std::setprecision(3) << stats.sensorLatencyMs << " ms\n";
+    std::cout << std::setprecision(2);
+    for (int tag = 0; tag < kMaxTags; tag++)
+    {
+        if (stats.switchesIn[tag] != 0U)
+        {
+            const auto name = stats.names.find(tag);
+            std::cout << "  " << std::left << std::setw(18) << ((name != stats.names.end()) ? name->second : std::to_string(tag))
+                      << std::right << std::setw(8) << stats.switchesIn[tag] << " switches in, "
+                      << static_cast<double>(stats.switchesIn[tag]) * 1000.0 / stats.durationMs << " per second\n";
+        }
+    }
+}
+
+void printSaving(const SwitchStats &tasks, const SwitchStats &timer)
+{
+    const double saved = tasks.switchesPerSecond() - timer.switchesPerSecond();
+    std::cout << "Timer against tasks: " << std::setprecision(2) << saved << " context switches per second less, "
+              << saved * static_cast<double>(kSensorPeriodMs) / 1000.0 << " per sensor period\n";
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+/* Reply of "trace dump" for the records of the Trace module, as main.c sends it */
+std::string hostDump(bool timerBuild)
+{
+    std::map<int, std::string> tasks = {
+        { kDriverHeaterTag, "Driver Heater" }, { kPassengerHeaterTag, "Passenger Heater" }, { kDisplayTag, "Display" },
+        { kRunTimeTag, "Run Time" },           { kFaultStoreTag, "Fault Store" },           { kIdleTag, "IDLE" }
+    };
+    std::ostringstream out;
+    Trace_RecordType record;
+    uint32 lost = 0;
+    const uint16 count = Trace_Count(&lost);
+
+    if (timerBuild)
+    {
+        tasks[kTimerTag] = "Tmr Svc";
+    }
+    else
+    {
+        tasks[kDriverSensorTag] = "Driver Sensor";
+        tasks[kPassengerSensorTag] = "Passenger Sensor";
+    }
+    out << "TRACE,DUMP," << count << "," << lost << ",16000000," << TRACE_TIME_SHIFT << "\r\n";
+    for (const auto &task : tasks)
+    {
+        out << "TRACE,TASK," << task.first << "," << task.second << "\r\n";
+    }
+    out << "TRACE,DATA," << count << "\r\n";
+    for (uint16 i = 0; Trace_Read(i, &record) == E_OK; i++)
+    {
+        out << static_cast<char>(record.usDelta & 0xFFU) << static_cast<char>(record.usDelta >> 8)
+            << static_cast<char>(record.ucEvent) << static_cast<char>(record.ucObject);
+    }
+    out << "TRACE,END\r\n";
+    return out.str();
+}
+
+/* A periodic job of the simulation, released at offsetMs and every periodMs after it */
+struct Job
+{
+    int tag = 0;
+    int priority = 0;
+    unsigned long periodMs = 0;
+    unsigned long offsetMs = 0;
+    std::uint64_t cycles = 0;         /* Of each release */
+    std::uint64_t longCycles = 0;     /* Of every longEvery-th release, when not 0 */
+    unsigned longEvery = 0;
+    unsigned long releases = 0;
+    std::uint64_t remaining = 0;
+    bool ready = false;
+};
+
+/* The steady state jobs of main.c, the sensors as two tasks or as one timer callback */
+std::vector<Job> makeJobs(bool timerBuild)
+{
+    std::vector<Job> jobs;
+
+    if (timerBuild)
+    {
+        jobs.push_back({ kTimerTag, 4, kSensorPeriodMs, 0UL, kTimerCycles + 2U * kSensorCycles });
+    }
+    else
+    {
+        jobs.push_back({ kDriverSensorTag, 4, kSensorPeriodMs, 0UL, kSensorCycles });
+        jobs.push_back({ kPassengerSensorTag, 4, kSensorPeriodMs, 0UL, kSensorCycles });
+    }
+    jobs.push_back({ kDriverHeaterTag, 1, kHeaterWatchdogMs, 50UL, kHeaterCycles });
+    jobs.push_back({ kPassengerHeaterTag, 1, kHeaterWatchdogMs, 175UL, kHeaterCycles });
+    jobs.push_back({ kDisplayTag, 1, kDisplayPeriodMs, 0UL, kDisplayCheckCycles, kDisplayUpdateCycles, kDisplayUpdateEvery });
+    jobs.push_back({ kRunTimeTag, 1, kRunTimePeriodMs, 300UL, kRunTimeCycles });
+    jobs.push_back({ kFaultStoreTag, 1, kFaultStorePeriodMs, 700UL, kFaultStoreCycles });
+    return jobs;
+}
+
+/*
+ * Runs the jobs on a simulated 16 MHz CPU and counts the captures. The tick readies the released jobs at the
+ * start of a ms and rotates the running task behind the other ready tasks of its priority, then the highest
+ * priority ready task runs until it blocks or the next tick. The display update and the run time report
+ * never overlap, as they take the display mutex of the UART in main.c.
+ */
+void simulate(bool timerBuild, SwitchStats &stats, bool &complete)
+{
+    std::vector<Job> jobs = makeJobs(timerBuild);
+    std::deque<std::size_t> ready[kPriorities];
+    std::uint64_t now = 0;
+    int running = kIdleTag;
+    std::size_t current = jobs.size(); /* The idle task */
+
+    auto record = [&now](unsigned event, int object) {
+        hostCycles = static_cast<std::uint32_t>(now);
+        Trace_Record(static_cast<uint8>(event), static_cast<uint8>(object));
+    };
+    auto dump = [&](unsigned long ms) {
+        Dump parsed;
+
+        Trace_Stop();
+        if (!parseDump(hostDump(timerBuild), parsed) || (parsed.lost != 0))
+        {
+            std::cerr << (timerBuild ? "Timer" : "Task") << " capture at " << ms << " ms: " << parsed.lost << " records overwritten\n";
+            complete = false;
+        }
+        analyze(parsed, decode(parsed), stats);
+        Trace_Start();
+    };
+
+    hostCycles = 0;
+    Trace_Start();
+    record(TRACE_EVENT_TASK_SWITCHED_IN, kIdleTag);
+    for (unsigned long ms = 0; ms < kRunMs; ms++)
+    {
+        const std::uint64_t tickEnd = static_cast<std::uint64_t>(ms + 1U) * kCyclesPerMs;
+
+        now = std::max(now, static_cast<std::uint64_t>(ms) * kCyclesPerMs);
+        if ((ms != 0U) && ((ms % kDumpMs) == 0U))
+        {
+            dump(ms);
+        }
+        for (std::size_t i = 0; i < jobs.size(); i++)
+        {
+            Job &job = jobs[i];
+            if ((ms < job.offsetMs) || (((ms - job.offsetMs) % job.periodMs) != 0U))
+            {
+                continue;
+            }
+            const bool isLong = (job.longEvery != 0U) && ((job.releases % job.longEvery) == 0U);
+            job.remaining += isLong ? job.longCycles : job.cycles;
+            job.releases++;
+            if (!job.ready)
+            {
+                job.ready = true;
+                ready[job.priority].push_back(i);
+                record(TRACE_EVENT_TASK_READY, job.tag);
+            }
+        }
+        if ((current < jobs.size()) && (ready[jobs[current].priority].size() > 1U))
+        {
+            std::deque<std::size_t> &list = ready[jobs[current].priority];
+            list.erase(std::find(list.begin(), list.end(), current));
+            list.push_back(current);
+        }
+
+        while (now < tickEnd)
+        {
+            std::size_t next = jobs.size();
+            for (int priority = kPriorities - 1; priority >= 0; priority--)
+            {
+                if (!ready[priority].empty())
+                {
+                    next = ready[priority].front();
+                    break;
+                }
+            }
+            const int tag = (next < jobs.size()) ? jobs[next].tag : kIdleTag;
+            if (tag != running)
+            {
+                now += kSwitchCycles;
+                running = tag;
+                record(TRACE_EVENT_TASK_SWITCHED_IN, tag);
+            }
+            current = next;
+            if (next == jobs.size())
+            {
+                now = tickEnd;
+                break;
+            }
+            Job &job = jobs[next];
+            const std::uint64_t slice = std::min(job.remaining, (now < tickEnd) ? (tickEnd - now) : 0U);
+            now += slice;
+            job.remaining -= slice;
+            if (job.remaining == 0U)
+            {
+                record(TRACE_EVENT_TASK_DELAY, job.tag);
+                job.ready = false;
+                ready[job.priority].pop_front();
+            }
+        }
+    }
+    dump(kRunMs);
+    Trace_Stop();
+
+    /* The captures end at their last record, not at the next dump */
+    stats.durationMs = static_cast<double>(kRunMs);
+}
+
+int runSimulation()
+{
+    SwitchStats tasks;
+    SwitchStats timer;
+    bool complete = true;
+    int errors = 0;
+
+    simulate(false, tasks, complete);
+    simulate(true, timer, complete);
+
+    std::cout << std::fixed;
+    printStats("Sensor tasks", tasks);
+    printStats("Sensor timer", timer);
+    printSaving(tasks, timer);
+
+    if (!complete)
+    {
+        std::cerr << "FAIL: records were overwritten, the captures are too long for the trace buffer\n";
+        errors++;
+    }
+    const double saved = (tasks.switchesPerSecond() - timer.switchesPerSecond()) * static_cast<double>(kSensorPeriodMs) / 1000.0;
+    if (saved < kSavedPerPeriod)
+    {
+        std::cerr << "FAIL: the sensor timer saves " << saved << " context switches per sensor period, not " << kSavedPerPeriod << "\n";
+        errors++;
+    }
+    for (const SwitchStats *stats : { &tasks, &timer })
+    {
+        const char *name = (stats == &tasks) ? "sensor tasks" : "sensor timer";
+        if ((stats->sensorReleases == 0U) ||
+            (stats->longestPeriodMs > static_cast<double>(kSensorPeriodMs) + kPeriodToleranceMs) ||
+            (stats->shortestPeriodMs < static_cast<double>(kSensorPeriodMs) - kPeriodToleranceMs))
+        {
+            std::cerr << "FAIL: the " << name << " release the sensor job every " << stats->shortestPeriodMs << " to "
+                      << stats->longestPeriodMs << " ms, not " << kSensorPeriodMs << " ms\n";
+            errors++;
+        }
+        if (stats->sensorLatencyMs > kSensorLatencyLimitMs)
+        {
+            std::cerr << "FAIL: the " << name << " start the sensor job " << stats->sensorLatencyMs << " ms after its release, over "
+                      << kSensorLatencyLimitMs << " ms\n";
+            errors++;
+        }
+    }
+    std::cout << ((errors == 0) ? "PASS" : "FAIL") << "\n";
+    return (errors == 0) ? 0 : 2;
+}
+
+bool readCapture(const std::string &path, SwitchStats &stats)
+{
+    std::ifstream file(path, std::ios::binary);
+    std::string data;
+    Dump dump;
+
+    if (!file)
+    {
+        std::cerr << "Cannot open " << path << "\n";
+        return false;
+    }
+    data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    if (!parseDump(data, dump))
+    {
+        return false;
+    }
+    if (dump.lost != 0)
+    {
+        std::cerr << "Warning: " << dump.lost << " records of " << path << " overwritten, the counts start at the oldest record\n";
+    }
+    analyze(dump, decode(dump), stats);
+    return true;
+}
+
+void usage()
+{
+    std::cerr << "Usage: sensor_timer_test [<task capture> [timer capture]]\n";
+}
+
+} /* namespace */
+
+uint32 Trace_HostCycles(void)
+{
+    return hostCycles;
+}
+
+int main(int argc, char *argv[])
+{
+    SwitchStats tasks;
+    SwitchStats timer;
+
+    if (argc == 1)
+    {
+        return runSimulation();
+    }
+    if ((argc > 3) || (argv[1][0] == '-') || ((argc == 3) && (argv[2][0] == '-')))
+    {
+        usage();
+        return 1;
+    }
+    if (!readCapture(argv[1], tasks) || ((argc == 3) && !readCapture(argv[2], timer)))
+    {
+        return 1;
+    }
+    std::cout << std::fixed;
+    printStats(argv[1], tasks);
+    if (argc == 3)
+    {
+        printStats(argv[2], timer);
+        printSaving(tasks, timer);
+    }
+    return 0;
+}
@@ -0,0 +1,41 @@
+/*
+ ============================================================================
+ Name        : eeprom_host_registers.h
+ Module Name : Settings Storage Test
+ Description : Host stand-in of the TM4C123GH6PM registers used by the firmware EEPROM driver
+               (MCAL/EEPROM/eeprom.c). The data register is the word of a RAM array selected
+               by the block and offset registers, and the done register is read through the
+               test, which sees the words programmed since the last read and answers as the
+               EEPROM module would. It is force included in the driver build, with the
+               include guard of the target register header defined so that header is skipped.
+ ============================================================================
+ */
+
+#ifndef EEPROM_HOST_REGISTERS_H_
+#define EEPROM_HOST_REGISTERS_H_
+
+#include "Std_Types.h"
+
+#define SYSCTL_RCGCEEPROM_REG   HostReg_SYSCTL_RCGCEEPROM
+#define SYSCTL_PREEPROM_REG     HostReg_SYSCTL_PREEPROM
+#define SYSCTL_SREEPROM_REG     HostReg_SYSCTL_SREEPROM
+#define EEPROM_EEBLOCK_REG      HostReg_EEPROM_EEBLOCK
+#define EEPROM_EEOFFSET_REG     HostReg_EEPROM_EEOFFSET
+#define EEPROM_EESUPP_REG       HostReg_EEPROM_EESUPP
+#define EEPROM_EERDWR_REG       (*HostEeprom_Word())
+#define EEPROM_EEDONE_REG       (*HostEeprom_Done())
+
+extern volatile uint32 HostReg_SYSCTL_RCGCEEPROM;
+extern volatile uint32 HostReg_SYSCTL_PREEPROM;
+extern volatile uint32 HostReg_SYSCTL_SREEPROM;
+extern volatile uint32 HostReg_EEPROM_EEBLOCK;
+extern volatile uint32 HostReg_EEPROM_EEOFFSET;
+extern volatile uint32 HostReg_EEPROM_EESUPP;
+
+/* Word of the RAM array at the selected block and offset */
+volatile uint32 *HostEeprom_Word(void);
+
+/* Done register, after the words programmed since its last read */
+volatile uint32 *HostEeprom_Done(void);
+
+#endif /* EEPROM_HOST_REGISTERS_H_ */
@@ -0,0 +1,551 @@
+/*
+ ============================================================================
+ Name        : settings_storage_test.cpp
+ Module Name : Settings Storage Test
+ Description : Host test of the EEPROM driver (MCAL/EEPROM/eeprom.c) and of the seat settings
+               kept in it (Control/Settings.c). The driver is built against host registers
+               (eeprom_host_registers.h) over a RAM array of the 512 words of the TM4C123
+               EEPROM, erased to 0xFFFFFFFF. A programmed word keeps the module working for a
+               few reads of the done register, and the words of a locked block are refused
+               (NOPERM), so the driver runs unchanged and every program is counted, as is
+               every wait for a program after a data access (a write of the same value).
+               - Driver: the initialization sequence and its failed recovery, the range
+                 checks, random writes read back, unchanged words not programmed, no access
+                 while a program is in progress, and a refused write reported.
+               - Settings: the defaults on an erased EEPROM, random settings saved and read
+                 back, a second save programming only the changed words, every bit of the
+                 block flipped (checksum failure), another magic, version or number of seats
+                 and invalid seat settings with a valid checksum, and a refused save. Every
+                 failure must load the defaults for both seats and return E_NOT_OK. After
+                 Settings_InitDefaults (EEPROM_Init failed) a save is refused without any
+                 EEPROM access.
+               On the host uint32 is 64 bits, so the block is made of 64 bit words; the
+               checks only rely on the layout of Settings_BlockType, mirrored below.
+
+ Build       : FW="../../1- Application project/FreeRTOS_Final_Project_WS/Seat_Heater_Control_System"
+               INC=(-I"$FW/Common" -I"$FW/Control" -I"$FW/MCAL/EEPROM")
+               gcc -O2 -DTM4C123GH6PM_REGISTERS -include eeprom_host_registers.h "${INC[@]}" -I. -I"$FW/MCAL" -c "$FW/MCAL/EEPROM/eeprom.c"
+               gcc -O2 "${INC[@]}" -c "$FW/Control/Settings.c"
+               g++ -std=c++17 -O2 "${INC[@]}" -I. -o settings_storage_test settings_storage_test.cpp eeprom.o Settings.o
+ Usage       : settings_storage_test [options]
+               -n <rounds>       Random write and save rounds, default 2000.
+               -s <seed>         Random seed, default 1.
+
+ Exit status : 0, 2 when a check fails, 1 on input errors.
+ ============================================================================
+ */
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+extern "C"
+{
+#include "Std_Types.h"
+#include "eeprom.h"
+#include "Settings.h"
+#include "eeprom_host_registers.h"
+
+volatile uint32 HostReg_SYSCTL_RCGCEEPROM;
+volatile uint32 HostReg_SYSCTL_PREEPROM;
+volatile uint32 HostReg_SYSCTL_SREEPROM;
+volatile uint32 HostReg_EEPROM_EEBLOCK;
+volatile uint32 HostReg_EEPROM_EEOFFSET;
+volatile uint32 HostReg_EEPROM_EESUPP;
+}
+
+namespace
+{
+
+constexpr uint32 kErased = 0xFFFFFFFFUL;
+constexpr unsigned kBusyReads = 3U; /* Reads of the done register that see a program in progress */
+constexpr unsigned kBlocks = EEPROM_SIZE_WORDS / EEPROM_BLOCK_WORDS;
+constexpr int kMaxErrorsShown = 10;
+
+/* Layout of the settings block, Settings_BlockType of Settings.c */
+struct SettingsBlock
+{
+    uint16 usMagic;
+    uint8 ucVersion;
+    uint8 ucSeats;
+    Settings_SeatType axSeat[SETTINGS_NUMBER_OF_SEATS];
+    uint32 ulChecksum;
+};
+
+constexpr unsigned kSettingsWords = sizeof(SettingsBlock) / sizeof(uint32);
+
+/* The EEPROM module over a RAM array */
+class HostEeprom
+{
+public:
+    void erase()
+    {
+        for (unsigned i = 0; i < EEPROM_SIZE_WORDS; i++)
+        {
+            words_[i] = kErased;
+            shadow_[i] = kErased;
+        }
+        for (bool &locked : locked_)
+        {
+            locked = false;
+        }
+        busy_ = 0;
+        done_ = 0;
+        dataAccess_ = false;
+    }
+
+    volatile uint32 *word()
+    {
+        const uint32 block = HostReg_EEPROM_EEBLOCK;
+        const uint32 offset = HostReg_EEPROM_EEOFFSET;
+
+        sync();
+        accessesWhileWorking += (busy_ != 0U) ? 1U : 0U;
+        dataAccess_ = true;
+        if ((block >= kBlocks) || (offset >= EEPROM_BLOCK_WORDS))
+        {
+            badSelects++;
+            return &dummy_;
+        }
+        return &words_[block * EEPROM_BLOCK_WORDS + offset];
+    }
+
+    volatile uint32 *done()
+    {
+        sync();
+        writes += dataAccess_ ? 1U : 0U;
+        dataAccess_ = false;
+        if (busy_ != 0U)
+        {
+            busy_--;
+            done_ |= EEPROM_EEDONE_WORKING;
+        }
+        else
+        {
+            done_ &= ~static_cast<uint32>(EEPROM_EEDONE_WORKING);
+        }
+        return &done_;
+    }
+
+    /* Words read and written by the test directly, not counted as programs */
+    uint32 peek(unsigned address) const
+    {
+        return words_[address];
+    }
+
+    void poke(unsigned address, uint32 value)
+    {
+        words_[address] = value;
+        shadow_[address] = value;
+    }
+
+    void lock(unsigned block, bool locked)
+    {
+        locked_[block] = locked;
+    }
+
+    unsigned long programs = 0;
+    unsigned long writes = 0;   /* Data register accesses followed by a wait for the program, the same value or not */
+    unsigned long refused = 0;
+    unsigned long badSelects = 0;
+    unsigned long accessesWhileWorking = 0;
+
+private:
+    /* Takes the words written through the data register since the last access as programs */
+    void sync()
+    {
+        for (unsigned i = 0; i < EEPROM_SIZE_WORDS; i++)
+        {
+            if (words_[i] == shadow_[i])
+            {
+                continue;
+            }
+            if (locked_[i / EEPROM_BLOCK_WORDS])
+            {
+                words_[i] = shadow_[i];
+                done_ = EEPROM_EEDONE_NOPERM;
+                refused++;
+            }
+            else
+            {
+                shadow_[i] = words_[i];
+                busy_ = kBusyReads;
+                done_ = EEPROM_EEDONE_WORKING;
+                programs++;
+            }
+        }
+    }
+
+    volatile uint32 words_[EEPROM_SIZE_WORDS] = {};
+    uint32 shadow_[EEPROM_SIZE_WORDS] = {};
+    bool locked_[kBlocks] = {};
+    volatile uint32 dummy_ = 0;
+    volatile uint32 done_ = 0;
+    unsigned busy_ = 0;
+    bool dataAccess_ = false;
+};
+
+HostEeprom eeprom;
+
+class Checker
+{
+public:
+    void check(bool condition, const std::string &message)
+    {
+        if (!condition)
+        {
+            if (errors_ < kMaxErrorsShown)
+            {
+                std::cerr << "FAIL: " << message << "\n";
+            }
+            errors_++;
+        }
+        checks_++;
+    }
+
+    int errors() const
+    {
+        return errors_;
+    }
+
+    unsigned long checks() const
+    {
+        return checks_;
+    }
+
+private:
+    int errors_ = 0;
+    unsigned long checks_ = 0;
+};
+
+bool sameSeat(const Settings_SeatType &a, const Settings_SeatType &b)
+{
+    return (std::memcmp(a.aucDesiredTemperature, b.aucDesiredTemperature, sizeof(a.aucDesiredTemperature)) == 0) &&
+           (std::memcmp(a.aucThreshold, b.aucThreshold, sizeof(a.aucThreshold)) == 0) && (a.ucHysteresis == b.ucHysteresis);
+}
+
+bool liveSeatsAre(const Settings_SeatType seats[SETTINGS_NUMBER_OF_SEATS])
+{
+    for (unsigned seat = 0; seat < SETTINGS_NUMBER_OF_SEATS; seat++)
+    {
+        if (!sameSeat(Settings_axSeat[seat], seats[seat]))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* A random seat that Settings_Validate accepts */
+Settings_SeatType randomSeat(std::mt19937 &random)
+{
+    Settings_SeatType seat;
+    seat.aucDesiredTemperature[0] = 0U;
+    for (unsigned level = 1; level < SETTINGS_NUMBER_OF_LEVELS; level++)
+    {
+        seat.aucDesiredTemperature[level] = static_cast<uint8>(1U + random() % SETTINGS_MAX_DESIRED_TEMP);
+    }
+    seat.aucThreshold[0] = static_cast<uint8>(1U + random() % (SETTINGS_MAX_DIFF - 2U));
+    seat.aucThreshold[1] = static_cast<uint8>(seat.aucThreshold[0] + 1U + random() % (SETTINGS_MAX_DIFF - 1U - seat.aucThreshold[0]));
+    seat.aucThreshold[2] = static_cast<uint8>(seat.aucThreshold[1] + 1U + random() % (SETTINGS_MAX_DIFF - seat.aucThreshold[1]));
+    seat.ucHysteresis = static_cast<uint8>(random() % (SETTINGS_MAX_HYSTERESIS + 1U));
+    return seat;
+}
+
+/* The settings block as stored, and back with a valid checksum */
+SettingsBlock readBlock()
+{
+    uint32 words[kSettingsWords];
+    SettingsBlock block;
+    for (unsigned i = 0; i < kSettingsWords; i++)
+    {
+        words[i] = eeprom.peek(SETTINGS_EEPROM_ADDRESS + i);
+    }
+    std::memcpy(&block, words, sizeof(block));
+    return block;
+}
+
+void writeBlock(SettingsBlock block)
+{
+    uint32 words[kSettingsWords];
+    uint32 sum = 0;
+
+    std::memcpy(words, &block, sizeof(block));
+    for (unsigned i = 0; (i + 1U) < kSettingsWords; i++)
+    {
+        sum += words[i];
+    }
+    words[kSettingsWords - 1U] = ~sum;
+    for (unsigned i = 0; i < kSettingsWords; i++)
+    {
+        eeprom.poke(SETTINGS_EEPROM_ADDRESS + i, words[i]);
+    }
+}
+
+/* Settings_Init on the stored block must fall back to the defaults */
+void checkFallback(Checker &checker, const Settings_SeatType &defaults, const std::string &context)
+{
+    const Settings_SeatType expected[SETTINGS_NUMBER_OF_SEATS] = { defaults, defaults };
+    checker.check(Settings_Init(&defaults) == E_NOT_OK, "Settings_Init accepted " + context);
+    checker.check(liveSeatsAre(expected), "Settings_Init did not use the defaults for both seats with " + context);
+    for (unsigned seat = 0; seat < SETTINGS_NUMBER_OF_SEATS; seat++)
+    {
+        for (unsigned state = 0; state < SETTINGS_NUMBER_OF_STATES; state++)
+        {
+            checker.check(SETTINGS_NEXT_HEATER_STATE(seat, state, SETTINGS_OFF_COLUMN) == 0U,
+                          "decision table not built with the defaults, " + context);
+        }
+    }
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+void checkInit(Checker &checker)
+{
+    eeprom.erase();
+    HostReg_SYSCTL_RCGCEEPROM = 0x10U;
+    HostReg_SYSCTL_PREEPROM = EEPROM_RCGC_R0;
+    HostReg_SYSCTL_SREEPROM = 0x20U;
+    HostReg_EEPROM_EESUPP = 0U;
+    checker.check(EEPROM_Init() == E_OK, "EEPROM_Init failed on a ready module");
+    checker.check(HostReg_SYSCTL_RCGCEEPROM == (0x10U | EEPROM_RCGC_R0), "EEPROM_Init: EEPROM clock not enabled, or other clocks changed");
+    checker.check(HostReg_SYSCTL_SREEPROM == 0x20U, "EEPROM_Init: the module is left in reset, or other resets changed");
+
+    for (uint32 retry : { static_cast<uint32>(EEPROM_EESUPP_ERETRY), static_cast<uint32>(EEPROM_EESUPP_PRETRY) })
+    {
+        HostReg_EEPROM_EESUPP = retry;
+        checker.check(EEPROM_Init() == E_NOT_OK, "EEPROM_Init accepted a failed power up recovery (EESUPP " + std::to_string(retry) + ")");
+    }
+    HostReg_EEPROM_EESUPP = 0U;
+}
+
+void checkDriver(Checker &checker, unsigned long rounds, std::mt19937 &random)
+{
+    std::vector<uint32> image(EEPROM_SIZE_WORDS, kErased);
+    uint32 data[EEPROM_SIZE_WORDS];
+
+    eeprom.erase();
+
+    /* Ranges */
+    const unsigned long programs = eeprom.programs;
+    checker.check(EEPROM_Read(EEPROM_SIZE_WORDS - 2U, data, 3U) == E_NOT_OK, "EEPROM_Read past the end accepted");
+    checker.check(EEPROM_Write(EEPROM_SIZE_WORDS, data, 1U) == E_NOT_OK, "EEPROM_Write past the end accepted");
+    checker.check(EEPROM_Write(0xFFFFU, data, 2U) == E_NOT_OK, "EEPROM_Write of a wrapping range accepted");
+    checker.check(eeprom.programs == programs, "a refused range programmed words");
+    checker.check(EEPROM_Read(0U, data, EEPROM_SIZE_WORDS) == E_OK, "EEPROM_Read of the whole EEPROM refused");
+
+    /* Random writes read back */
+    for (unsigned long round = 0; round < rounds; round++)
+    {
+        const uint16 count = static_cast<uint16>(1U + random() % 40U);
+        const uint16 address = static_cast<uint16>(random() % (EEPROM_SIZE_WORDS - count + 1U));
+        unsigned changed = 0;
+
+        for (uint16 i = 0; i < count; i++)
+        {
+            /* Some words keep their value, they must not be programmed */
+            data[i] = ((random() % 4U) == 0U) ? image[address + i] : static_cast<uint32>(random());
+            changed += (data[i] != image[address + i]) ? 1U : 0U;
+            image[address + i] = data[i];
+        }
+        const unsigned long before = eeprom.programs;
+        const unsigned long writesBefore = eeprom.writes;
+        checker.check(EEPROM_Write(address, data, count) == E_OK, "EEPROM_Write of " + std::to_string(count) + " words failed");
+        checker.check((eeprom.programs - before == changed) && (eeprom.writes - writesBefore == changed),
+                      "EEPROM_Write wrote " + std::to_string(eeprom.writes - writesBefore) + " words, " + std::to_string(changed) +
+                          " changed");
+        checker.check(EEPROM_Read(address, data, count) == E_OK, "EEPROM_Read failed");
+        for (uint16 i = 0; i < count; i++)
+        {
+            checker.check(data[i] == image[address + i], "word " + std::to_string(address + i) + " read back wrong");
+        }
+    }
+    for (unsigned i = 0; i < EEPROM_SIZE_WORDS; i++)
+    {
+        checker.check(eeprom.peek(i) == image[i], "word " + std::to_string(i) + " of the array wrong after the random writes");
+    }
+
+    /* A refused word stops the write */
+    const uint16 address = static_cast<uint16>(3U * EEPROM_BLOCK_WORDS - 2U);
+    for (uint16 i = 0; i < 4U; i++)
+    {
+        data[i] = ~image[address + i];
+    }
+    eeprom.lock(2U, true);
+    checker.check(EEPROM_Write(address, data, 4U) == E_NOT_OK, "EEPROM_Write into a locked block reported success");
+    checker.check(eeprom.peek(address + 2U) == image[address + 2U], "a refused word changed");
+    eeprom.lock(2U, false);
+    checker.check(EEPROM_Write(address, data, 4U) == E_OK, "EEPROM_Write failed after the block was unlocked");
+
+    checker.check(eeprom.badSelects == 0U, std::to_string(eeprom.badSelects) + " accesses selected a block or offset outside the EEPROM");
+    checker.check(eeprom.accessesWhileWorking == 0U,
+                  std::to_string(eeprom.accessesWhileWorking) + " data accesses while a program was in progress");
+}
+
+void checkSettings(Checker &checker, unsigned long rounds, std::mt19937 &random)
+{
+    const Settings_SeatType defaults = { { 0U, 25U, 30U, 35U }, { 2U, 5U, 10U }, 1U }; /* xDefaultSeatSettings of main.c */
+    Settings_SeatType saved[SETTINGS_NUMBER_OF_SEATS];
+
+    eeprom.erase();
+    checkFallback(checker, defaults, "an erased EEPROM");
+
+    for (unsigned long round = 0; round < rounds; round++)
+    {
+        /* Save and read back */
+        for (unsigned seat = 0; seat < SETTINGS_NUMBER_OF_SEATS; seat++)
+        {
+            saved[seat] = randomSeat(random);
+            checker.check(Settings_Apply(static_cast<uint8>(seat), &saved[seat]) == E_OK, "Settings_Apply refused valid settings");
+        }
+        checker.check(Settings_Save() == E_OK, "Settings_Save failed");
+        const SettingsBlock block = readBlock();
+        checker.check((block.usMagic == SETTINGS_EEPROM_MAGIC) && (block.ucVersion == SETTINGS_EEPROM_VERSION) &&
+                          (block.ucSeats == SETTINGS_NUMBER_OF_SEATS),
+                      "saved block header is not the one of Settings_BlockType");
+        Settings_Apply(SETTINGS_SEAT_DRIVER, &defaults);
+        checker.check(Settings_Init(&defaults) == E_OK, "Settings_Init refused a saved block");
+        checker.check(liveSeatsAre(saved), "Settings_Init did not read back the saved settings");
+
+        /* Only the changed words are programmed */
+        unsigned long before = eeprom.writes;
+        checker.check(Settings_Save() == E_OK, "Settings_Save failed");
+        checker.check(eeprom.writes == before, "Settings_Save of unchanged settings wrote words");
+        saved[SETTINGS_SEAT_PASSENGER].ucHysteresis = static_cast<uint8>((saved[SETTINGS_SEAT_PASSENGER].ucHysteresis + 1U) %
+                                                                         (SETTINGS_MAX_HYSTERESIS + 1U));
+        Settings_Apply(SETTINGS_SEAT_PASSENGER, &saved[SETTINGS_SEAT_PASSENGER]);
+        before = eeprom.writes;
+        checker.check(Settings_Save() == E_OK, "Settings_Save failed");
+        checker.check(eeprom.writes - before <= 2U, "Settings_Save of one changed byte wrote " + std::to_string(eeprom.writes - before) +
+                                                        " words, not the word and the checksum");
+
+        /* Checksum failure, a bit of the block flipped */
+        const unsigned word = static_cast<unsigned>(random() % kSettingsWords);
+        const uint32 value = eeprom.peek(SETTINGS_EEPROM_ADDRESS + word);
+        eeprom.poke(SETTINGS_EEPROM_ADDRESS + word, value ^ (static_cast<uint32>(1U) << (random() % 32U)));
+        checkFallback(checker, defaults, "a bit flipped in word " + std::to_string(word));
+        eeprom.poke(SETTINGS_EEPROM_ADDRESS + word, value);
+        checker.check(Settings_Init(&defaults) == E_OK, "Settings_Init refused the block after the bit was restored");
+    }
+
+    /* Every bit of the block */
+    for (unsigned word = 0; word < kSettingsWords; word++)
+    {
+        const uint32 value = eeprom.peek(SETTINGS_EEPROM_ADDRESS + word);
+        for (unsigned bit = 0; bit < 8U * sizeof(uint32); bit++)
+        {
+            eeprom.poke(SETTINGS_EEPROM_ADDRESS + word, value ^ (static_cast<uint32>(1U) << bit));
+            checkFallback(checker, defaults, "bit " + std::to_string(bit) + " flipped in word " + std::to_string(word));
+        }
+        eeprom.poke(SETTINGS_EEPROM_ADDRESS + word, value);
+    }
+
+    /* Another layout or invalid settings, with a valid checksum */
+    const SettingsBlock good = readBlock();
+    writeBlock(good);
+    checker.check(Settings_Init(&defaults) == E_OK, "Settings_Init refused a block rewritten by the test, the mirrored layout is wrong");
+    SettingsBlock bad = good;
+    bad.usMagic = static_cast<uint16>(SETTINGS_EEPROM_MAGIC ^ 0x0100U);
+    writeBlock(bad);
+    checkFallback(checker, defaults, "another magic");
+    bad = good;
+    bad.ucVersion = static_cast<uint8>(SETTINGS_EEPROM_VERSION + 1U);
+    writeBlock(bad);
+    checkFallback(checker, defaults, "another version");
+    bad = good;
+    bad.ucSeats = static_cast<uint8>(SETTINGS_NUMBER_OF_SEATS + 1U);
+    writeBlock(bad);
+    checkFallback(checker, defaults, "another number of seats");
+    bad = good;
+    bad.axSeat[SETTINGS_SEAT_PASSENGER].aucThreshold[1] = bad.axSeat[SETTINGS_SEAT_PASSENGER].aucThreshold[2];
+    writeBlock(bad);
+    checkFallback(checker, defaults, "invalid passenger thresholds");
+    bad = good;
+    bad.axSeat[SETTINGS_SEAT_DRIVER].aucDesiredTemperature[3] = SETTINGS_MAX_DESIRED_TEMP + 1U;
+    writeBlock(bad);
+    checkFallback(checker, defaults, "an invalid driver desired temperature");
+
+    /* A refused save keeps the stored settings */
+    writeBlock(good);
+    checker.check(Settings_Init(&defaults) == E_OK, "Settings_Init refused the restored block");
+    const Settings_SeatType stored[SETTINGS_NUMBER_OF_SEATS] = { good.axSeat[0], good.axSeat[1] };
+    Settings_SeatType other = randomSeat(random);
+    other.ucHysteresis = static_cast<uint8>((stored[0].ucHysteresis + 1U) % (SETTINGS_MAX_HYSTERESIS + 1U));
+    Settings_Apply(SETTINGS_SEAT_DRIVER, &other);
+    eeprom.lock(SETTINGS_EEPROM_ADDRESS / EEPROM_BLOCK_WORDS, true);
+    checker.check(Settings_Save() == E_NOT_OK, "Settings_Save into a locked block reported success");
+    eeprom.lock(SETTINGS_EEPROM_ADDRESS / EEPROM_BLOCK_WORDS, false);
+    checker.check(Settings_Init(&defaults) == E_OK, "Settings_Init refused the block after a refused save");
+    checker.check(liveSeatsAre(stored), "a refused save changed the stored settings");
+
+    /* No EEPROM access after the defaults only initialization */
+    Settings_InitDefaults(&defaults);
+    const Settings_SeatType both[SETTINGS_NUMBER_OF_SEATS] = { defaults, defaults };
+    checker.check(liveSeatsAre(both), "Settings_InitDefaults did not use the defaults for both seats");
+    const unsigned long writes = eeprom.writes;
+    checker.check(Settings_Save() == E_NOT_OK, "Settings_Save after Settings_InitDefaults reported success");
+    checker.check(eeprom.writes == writes, "Settings_Save after Settings_InitDefaults accessed the EEPROM");
+    checker.check(liveSeatsAre(both), "a save refused after Settings_InitDefaults changed the live settings");
+    checker.check(Settings_Init(&defaults) == E_OK, "Settings_Init refused the stored block after Settings_InitDefaults");
+    checker.check(liveSeatsAre(stored), "a save refused after Settings_InitDefaults changed the stored settings");
+
+    checker.check(eeprom.badSelects == 0U, std::to_string(eeprom.badSelects) + " accesses selected a block or offset outside the EEPROM");
+    checker.check(eeprom.accessesWhileWorking == 0U,
+                  std::to_string(eeprom.accessesWhileWorking) + " data accesses while a program was in progress");
+}
+
+void usage()
+{
+    std::cerr << "Usage: settings_storage_test [-n <rounds>] [-s <seed>]\n";
+}
+
+} /* namespace */
+
+volatile uint32 *HostEeprom_Word(void)
+{
+    return eeprom.word();
+}
+
+volatile uint32 *HostEeprom_Done(void)
+{
+    return eeprom.done();
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned long rounds = 2000UL;
+    unsigned seed = 1U;
+    Checker checker;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const std::string arg = argv[i];
+        if ((arg == "-n") && (i + 1 < argc))
+        {
+            rounds = std::strtoul(argv[++i], nullptr, 10);
+        }
+        else if ((arg == "-s") && (i + 1 < argc))
+        {
+            seed = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else
+        {
+            usage();
+            return 1;
+        }
+    }
+
+    std::mt19937 random(seed);
+    checkInit(checker);
+    checkDriver(checker, rounds, random);
+    checkSettings(checker, rounds, random);
+
+    std::cout << checker.checks() << " checks, " << eeprom.programs << " words programmed, " << eeprom.refused << " refused, "
+              << checker.errors() << " errors\n";
+    std::cout << ((checker.errors() == 0) ? "PASS" : "FAIL") << "\n";
+    return (checker.errors() == 0) ? 0 : 2;
+}
@@ -0,0 +1,168 @@
+/*
+ ============================================================================
+ Name        : stack_sizing.cpp
+ Module Name : Stack Sizing Tool
+ Description : Host tool that reads the stack profiling report of the Seat Heater
+               Control System (mainSTACK_PROFILING = 1) captured from the UART and
+               emits recommended task stack depths with a safety margin.
+
+ Build       : g++ -std=c++17 -O2 -o stack_sizing stack_sizing.cpp
+ Usage       : stack_sizing [-m <margin percent>] [uart_log ...]
+               Reads stdin when no log file is given. The default margin is 25%.
+
+ Every report line has the format:
+   STACK,<stack size macro>,<task name>,<stack depth in words>,<high water mark in words>
+ The lowest high water mark seen for a task gives its peak stack usage; tasks sharing
+ the same macro are sized for the worst of them.
+ ============================================================================
+ */
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+/* Stack depths are rounded up to a multiple of 8 words (32 bytes) */
+constexpr unsigned kStackGranularityWords = 8;
+
+/* Tasks left with less than this many free words during the run are reported as at risk */
+constexpr unsigned kLowWaterWarningWords = 16;
+
+struct TaskUsage
+{
+    std::string macro;
+    unsigned depth = 0;
+    unsigned minFree = ~0U;
+};
+
+struct MacroSizing
+{
+    unsigned depth = 0;
+    unsigned maxUsed = 0;
+};
+
+void parseStream(std::istream &in, std::map<std::string, TaskUsage> &tasks)
+{
+    std::string line;
+    while (std::getline(in, line))
+    {
+        if (!line.empty() && line.back() == '\r')
+        {
+            line.pop_back();
+        }
+        const std::size_t start = line.find("STACK,");
+        if (start == std::string::npos)
+        {
+            continue;
+        }
+
+        std::vector<std::string> fields;
+        std::stringstream ss(line.substr(start));
+        std::string field;
+        while (std::getline(ss, field, ','))
+        {
+            fields.push_back(field);
+        }
+        if (fields.size() != 5)
+        {
+            continue; /* Truncated or corrupted UART line */
+        }
+
+        TaskUsage &task = tasks[fields[2]];
+        task.macro = fields[1];
+        task.depth = static_cast<unsigned>(std::strtoul(fields[3].c_str(), nullptr, 10));
+        const unsigned free = static_cast<unsigned>(std::strtoul(fields[4].c_str(), nullptr, 10));
+        if (free < task.minFree)
+        {
+            task.minFree = free;
+        }
+    }
+}
+
+unsigned recommendedDepth(unsigned used, unsigned marginPercent)
+{
+    const unsigned withMargin = (used * (100U + marginPercent) + 99U) / 100U;
+    return ((withMargin + kStackGranularityWords - 1U) / kStackGranularityWords) * kStackGranularityWords;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    unsigned marginPercent = 25;
+    std::vector<std::string> logs;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        if (arg == "-m" && i + 1 < argc)
+        {
+            marginPercent = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else
+        {
+            logs.push_back(arg);
+        }
+    }
+
+    std::map<std::string, TaskUsage> tasks;
+    if (logs.empty())
+    {
+        parseStream(std::cin, tasks);
+    }
+    for (const std::string &path : logs)
+    {
+        std::ifstream file(path);
+        if (!file)
+        {
+            std::cerr << "stack_sizing: cannot open " << path << "\n";
+            return 1;
+        }
+        parseStream(file, tasks);
+    }
+
+    if (tasks.empty())
+    {
+        std::cerr << "stack_sizing: no STACK report lines found\n";
+        return 1;
+    }
+
+    std::map<std::string, MacroSizing> macros;
+    bool atRisk = false;
+
+    std::cout << "/* Stack usage per task (words) */\n";
+    for (const auto &entry : tasks)
+    {
+        const TaskUsage &task = entry.second;
+        const unsigned used = task.depth - task.minFree;
+        std::cout << "/*   " << entry.first << ": " << used << " of " << task.depth << " used";
+        if (task.minFree < kLowWaterWarningWords)
+        {
+            std::cout << " - WARNING: only " << task.minFree << " words left";
+            atRisk = true;
+        }
+        std::cout << " */\n";
+
+        MacroSizing &sizing = macros[task.macro];
+        sizing.depth = task.depth;
+        if (used > sizing.maxUsed)
+        {
+            sizing.maxUsed = used;
+        }
+    }
+
+    std::cout << "\n/* Recommended stack depths (words), " << marginPercent << "% safety margin */\n";
+    for (const auto &entry : macros)
+    {
+        std::cout << "#define " << entry.first << " " << recommendedDepth(entry.second.maxUsed, marginPercent)
+                  << " /* was " << entry.second.depth << " */\n";
+    }
+
+    return atRisk ? 2 : 0;
+}
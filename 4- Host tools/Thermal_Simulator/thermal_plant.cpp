@@ -0,0 +1,84 @@
+/*
+ ============================================================================
+ Name        : thermal_plant.cpp
+ Module Name : Thermal Simulator
+ Description : Host model of a heated seat and the ADC_ReadChannel() replacement that
+               feeds its sensor codes to the firmware LM35 driver.
+ ============================================================================
+ */
+
+#include "thermal_plant.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+
+/* Firmware ADC: 12 bit, 3.3V reference; the LM35 driver maps 0V-3.3V to 0-45 deg C */
+constexpr double kAdcMaximum = 4095.0;
+constexpr double kSensorMaxTemperature = 45.0;
+
+constexpr int kAdcChannels = 2;
+SeatThermalPlant *adcPlants[kAdcChannels] = {nullptr, nullptr};
+
+}
+
+SeatThermalPlant::SeatThermalPlant(const SeatParameters &parameters, double initialTemperature, std::uint32_t seed)
+    : parameters_(parameters), heaterTemperature_(initialTemperature), seatTemperature_(initialTemperature), generator_(seed),
+      distribution_(0.0, 1.0)
+{
+}
+
+void SeatThermalPlant::step(double dt, double dutyPercent, double ambient, double occupantConductance)
+{
+    const double power = std::clamp(dutyPercent, 0.0, 100.0) * parameters_.maxPower / 100.0;
+
+    /* Explicit Euler with sub steps of at most a fifth of the fastest time constant */
+    const double fastest = std::min(parameters_.heaterCapacity / parameters_.heaterToSeat,
+                                    parameters_.seatCapacity / (parameters_.heaterToSeat + parameters_.seatToAmbient + occupantConductance));
+    const int steps = std::max(1, static_cast<int>(std::ceil(dt / (0.2 * fastest))));
+    const double h = dt / steps;
+
+    for (int i = 0; i < steps; ++i)
+    {
+        const double heaterFlow = parameters_.heaterToSeat * (heaterTemperature_ - seatTemperature_);
+        const double ambientFlow = parameters_.seatToAmbient * (seatTemperature_ - ambient);
+        const double occupantFlow = occupantConductance * (seatTemperature_ - parameters_.occupantSkinTemperature);
+
+        heaterTemperature_ += h * (power - heaterFlow) / parameters_.heaterCapacity;
+        seatTemperature_ += h * (heaterFlow - ambientFlow - occupantFlow) / parameters_.seatCapacity;
+    }
+
+    energy_ += power * dt;
+}
+
+std::uint16_t SeatThermalPlant::adcCode()
+{
+    double temperature = seatTemperature_;
+    if (noise_ > 0.0)
+    {
+        temperature += noise_ * distribution_(generator_);
+    }
+
+    const double code = std::round(temperature * kAdcMaximum / kSensorMaxTemperature);
+    return static_cast<std::uint16_t>(std::clamp(code, 0.0, kAdcMaximum));
+}
+
+void attachAdcChannel(std::uint8_t channel, SeatThermalPlant *plant)
+{
+    if (channel < kAdcChannels)
+    {
+        adcPlants[channel] = plant;
+    }
+}
+
+/* Replaces the firmware ADC driver (MCAL/ADC/adc.c) on the host */
+extern "C" std::uint16_t ADC_ReadChannel(std::uint8_t channel_num)
+{
+    if (channel_num >= kAdcChannels || adcPlants[channel_num] == nullptr)
+    {
+        return 0U;
+    }
+    return adcPlants[channel_num]->adcCode();
+}
@@ -0,0 +1,71 @@
+/*
+ ============================================================================
+ Name        : thermal_plant.h
+ Module Name : Thermal Simulator
+ Description : Host model of a heated seat for closed loop tests of the Seat Heater
+               Control System. Each seat is a two node RC network:
+
+                 heater --Gh--> seat surface --Ga--> cabin (ambient)
+                                      |
+                                      +------Go--> occupant (skin temperature)
+
+               The heater element receives duty * maxPower watts, the LM35 sits on the
+               seat surface. The model produces the 12 bit ADC code the sensor would give,
+               with gaussian noise, and serves it through the firmware ADC_ReadChannel()
+               so the firmware LM35 driver runs unchanged on the host.
+ ============================================================================
+ */
+
+#ifndef THERMAL_PLANT_H_
+#define THERMAL_PLANT_H_
+
+#include <cstdint>
+#include <random>
+
+struct SeatParameters
+{
+    double heaterCapacity = 100.0; /* J/K, heating element and foam next to it */
+    double seatCapacity = 600.0; /* J/K, seat surface layer where the sensor is */
+    double heaterToSeat = 3.0; /* W/K */
+    double seatToAmbient = 1.0; /* W/K */
+    double occupantSkinTemperature = 34.0; /* deg C */
+    double maxPower = 60.0; /* W at 100% duty */
+};
+
+class SeatThermalPlant
+{
+public:
+    explicit SeatThermalPlant(const SeatParameters &parameters = SeatParameters(), double initialTemperature = 20.0,
+                              std::uint32_t seed = 1U);
+
+    /*
+     * Advance the model by dt seconds with the heater at dutyPercent (0 to 100).
+     * occupantConductance is the occupant load in W/K, 0 for an empty seat.
+     * dt is split internally so the explicit integration stays stable for any step.
+     */
+    void step(double dt, double dutyPercent, double ambient, double occupantConductance);
+
+    double seatTemperature() const { return seatTemperature_; }
+    double heaterTemperature() const { return heaterTemperature_; }
+    double energy() const { return energy_; } /* Heater energy since construction, in J */
+
+    /* Standard deviation of the sensor noise, in deg C */
+    void setNoise(double sigma) { noise_ = sigma; }
+
+    /* ADC code of the sensor for the current seat temperature, with the mapping of the LM35 driver */
+    std::uint16_t adcCode();
+
+private:
+    SeatParameters parameters_;
+    double heaterTemperature_;
+    double seatTemperature_;
+    double energy_ = 0.0;
+    double noise_ = 0.0;
+    std::mt19937 generator_;
+    std::normal_distribution<double> distribution_;
+};
+
+/* Serve the ADC codes of plant on an ADC channel (AIN0_CHANNEL, AIN1_CHANNEL), nullptr to detach */
+void attachAdcChannel(std::uint8_t channel, SeatThermalPlant *plant);
+
+#endif /* THERMAL_PLANT_H_ */
@@ -0,0 +1,522 @@
+/*
+ ============================================================================
+ Name        : thermal_sim.cpp
+ Module Name : Thermal Simulator
+ Description : Closed loop host simulation of one seat of the Seat Heater Control System.
+               The seat model (thermal_plant.cpp) is read through the firmware LM35 driver
+               every 100 ms like the sensor task, and the heater duty is computed every
+               250 ms like the heater task, with the firmware PID module or with the
+               default rule of main.c (prvHeaterDutyCycle): the heater state of the firmware
+               decision table (Control/Settings.c, default settings) gates a holding duty plus
+               a proportional part, with the high threshold and the hysteresis of the settings. The holding duty integrates over time, so it behaves the
+               same when the heater task is event driven. A one hour drive runs in a few
+               milliseconds.
+
+ Build       : FW="../../1- Application project/FreeRTOS_Final_Project_WS/Seat_Heater_Control_System"
+               INC=(-I"$FW/Common" -I"$FW/Control" -I"$FW/MCAL/ADC" -I"$FW/MCAL/EEPROM" -I"$FW/HAL/Temperatrue Sensor")
+               gcc -O2 "${INC[@]}" -c "$FW/Control/Pid.c" "$FW/Control/Settings.c" "$FW/HAL/Temperatrue Sensor/lm35.c"
+               g++ -std=c++17 -O2 "${INC[@]}" -o thermal_sim thermal_sim.cpp thermal_plant.cpp Pid.o Settings.o lm35.o
+ Usage       : thermal_sim [options] [scenario.csv]
+               -c <controller>   proportional (default, the main.c rule), pid or autotune (relay
+                                 auto-tune, then PID).
+               -k <kp,ki,kd>     PID gains per 250 ms sample, default the main.c values 15,0.02,0.
+               -d <seconds>      Simulated time, default the last scenario row + 1800 s.
+               -n <sigma>        Sensor noise standard deviation in deg C, default 0.3.
+               -r <seed>         Noise seed, default 1.
+               -t <trace.csv>    Write a trace every simulated second.
+               -O <deg C>        Overshoot limit, default 2.
+               -E <deg C>        Steady state error limit, default 1.
+
+ Every scenario row applies from its time on:
+   <time s>,<ambient deg C>,<occupant load W/K>,<desired temperature deg C, 0 = heating off>
+ Without a scenario the seat heats to 35 deg C in a 10 deg C cabin with an occupant.
+
+ Exit status : 0 when the run stays within the limits, 2 when the overshoot or the
+               steady state error exceeds them, 1 on input errors.
+ ============================================================================
+ */
+
+#include "thermal_plant.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+extern "C"
+{
+#include "Std_Types.h"
+#include "adc.h"
+#include "lm35.h"
+#include "Pid.h"
+#include "Settings.h"
+#include "eeprom.h"
+}
+
+namespace
+{
+
+/* Firmware timing and limits (main.c) */
+constexpr int kTickMs = 50;
+constexpr int kSensorPeriodMs = 100; /* mainSENSOR_TASK_DELAY */
+constexpr int kHeaterPeriodMs = 250; /* mainHEATER_TASK_DELAY */
+constexpr int kTempMinValid = 5; /* mainTEMP_MIN_VALID_RANGE */
+constexpr int kTempMaxValid = 40; /* mainTEMP_MAX_VALID_RANGE */
+constexpr int kDutyMax = 100; /* PWM_DUTY_MAX */
+constexpr long kHoldDuty = kDutyMax / 3; /* mainHEATER_HOLD_DUTY */
+constexpr long kHoldRate = 50L * 1000L; /* mainHEATER_HOLD_RATE, in degree milliseconds (1 ms ticks) */
+constexpr std::uint8_t kStateOff = 0U; /* mainHEATER_STATE_OFF */
+
+/* Default settings of main.c (xDefaultSeatSettings), for the heater decision table */
+const Settings_SeatType kDefaultSeat = { { 0U, 25U, 30U, 35U }, { 2U, 5U, 10U }, 1U };
+
+/* A setpoint is steady after this long, its error is averaged over the last kSteadyWindow seconds */
+constexpr double kSteadyAfter = 1200.0;
+constexpr double kSteadyWindow = 300.0;
+
+struct ScenarioRow
+{
+    double time = 0.0;
+    double ambient = 10.0;
+    double occupant = 1.5;
+    int setpoint = 35;
+};
+
+enum class Controller
+{
+    Proportional,
+    Pid,
+    AutoTune
+};
+
+bool readScenario(const std::string &path, std::vector<ScenarioRow> &rows)
+{
+    std::ifstream file(path);
+    if (!file)
+    {
+        std::cerr << "thermal_sim: cannot open " << path << "\n";
+        return false;
+    }
+
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line))
+    {
+        ++lineNumber;
+        const std::size_t first = line.find_first_not_of(" \t\r");
+        if (first == std::string::npos || line[first] == '#')
+        {
+            continue;
+        }
+
+        std::vector<double> fields;
+        std::stringstream ss(line);
+        std::string field;
+        while (std::getline(ss, field, ','))
+        {
+            fields.push_back(std::strtod(field.c_str(), nullptr));
+        }
+        if (fields.size() != 4)
+        {
+            std::cerr << path << ":" << lineNumber << ": expected 4 fields\n";
+            return false;
+        }
+
+        ScenarioRow row;
+        row.time = fields[0];
+        row.ambient = fields[1];
+        row.occupant = fields[2];
+        row.setpoint = static_cast<int>(fields[3]);
+        if (row.occupant < 0.0 || row.setpoint < 0 || (!rows.empty() && row.time < rows.back().time))
+        {
+            std::cerr << path << ":" << lineNumber << ": occupant load and setpoint must be positive, times increasing\n";
+            return false;
+        }
+        rows.push_back(row);
+    }
+
+    if (rows.empty())
+    {
+        std::cerr << "thermal_sim: " << path << " has no rows\n";
+        return false;
+    }
+    return true;
+}
+
+/* prvHeaterState() then prvHeaterDutyCycle() of main.c, for one seat */
+class HeaterRule
+{
+public:
+    /* Heating off or sensor error */
+    void disable(long nowMs)
+    {
+        state_ = SETTINGS_NEXT_HEATER_STATE(SETTINGS_SEAT_DRIVER, state_, SETTINGS_OFF_COLUMN);
+        diffTicks_ = 0;
+        diff_ = 0;
+        proportionalDiff_ = 0;
+        lastMs_ = nowMs;
+    }
+
+    int duty(int desired, int temperature, long nowMs)
+    {
+        const int diff = desired - temperature;
+        const int column = (temperature > desired) ? static_cast<int>(SETTINGS_OFF_COLUMN) : std::min(diff, static_cast<int>(SETTINGS_MAX_DIFF));
+        state_ = SETTINGS_NEXT_HEATER_STATE(SETTINGS_SEAT_DRIVER, state_, column);
+
+        diffTicks_ += static_cast<long>(diff_) * (nowMs - lastMs_);
+        diffTicks_ = std::clamp(diffTicks_, -kHoldDuty * kHoldRate, (kDutyMax - kHoldDuty) * kHoldRate);
+        diff_ = diff;
+        lastMs_ = nowMs;
+
+        if (state_ == kStateOff)
+        {
+            proportionalDiff_ = 0;
+            return 0;
+        }
+        const int hysteresis = SETTINGS_HYSTERESIS(SETTINGS_SEAT_DRIVER);
+        const int tempDiff = std::max(diff, 0);
+        if (tempDiff > proportionalDiff_)
+        {
+            proportionalDiff_ = tempDiff;
+        }
+        else if (tempDiff + hysteresis < proportionalDiff_)
+        {
+            proportionalDiff_ = tempDiff + hysteresis;
+        }
+        long duty = kHoldDuty + diffTicks_ / kHoldRate;
+        duty += (proportionalDiff_ * kDutyMax) / SETTINGS_HIGH_THRESHOLD(SETTINGS_SEAT_DRIVER);
+        return static_cast<int>(std::min(duty, static_cast<long>(kDutyMax)));
+    }
+
+private:
+    std::uint8_t state_ = kStateOff;
+    long diffTicks_ = 0;
+    long lastMs_ = 0;
+    int diff_ = 0;
+    int proportionalDiff_ = 0; /* After the hysteresis */
+};
+
+/* Error statistics of one setpoint segment */
+struct Segment
+{
+    int setpoint = 0;
+    double start = 0.0;
+    bool heatingUp = false; /* The seat started below the setpoint, so overshoot counts */
+    double peak = -1e9;
+    double settleTime = -1.0; /* Time to first reach setpoint - 1 deg C */
+    std::vector<double> errors; /* Absolute error every second */
+};
+
+}
+
+/* EEPROM stub holding no settings, Settings_Init builds the decision table from the defaults */
+extern "C" Std_ReturnType EEPROM_Read(uint16 address, uint32 *data, uint16 count)
+{
+    (void) address;
+    (void) data;
+    (void) count;
+    return E_NOT_OK;
+}
+
+extern "C" Std_ReturnType EEPROM_Write(uint16 address, const uint32 *data, uint16 count)
+{
+    (void) address;
+    (void) data;
+    (void) count;
+    return E_NOT_OK;
+}
+
+int main(int argc, char *argv[])
+{
+    Controller controller = Controller::Proportional;
+    double kp = 15.0, ki = 0.02, kd = 0.0;
+    double duration = -1.0;
+    double noise = 0.3;
+    std::uint32_t seed = 1U;
+    std::string tracePath;
+    std::string scenarioPath;
+    double overshootLimit = 2.0;
+    double errorLimit = 1.0;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        if (arg == "-c" && i + 1 < argc)
+        {
+            const std::string name = argv[++i];
+            if (name == "proportional")
+            {
+                controller = Controller::Proportional;
+            }
+            else if (name == "pid")
+            {
+                controller = Controller::Pid;
+            }
+            else if (name == "autotune")
+            {
+                controller = Controller::AutoTune;
+            }
+            else
+            {
+                std::cerr << "thermal_sim: unknown controller " << name << "\n";
+                return 1;
+            }
+        }
+        else if (arg == "-k" && i + 1 < argc)
+        {
+            char comma;
+            std::stringstream gains(argv[++i]);
+            if (!(gains >> kp >> comma >> ki >> comma >> kd))
+            {
+                std::cerr << "thermal_sim: -k expects kp,ki,kd\n";
+                return 1;
+            }
+        }
+        else if (arg == "-d" && i + 1 < argc)
+        {
+            duration = std::strtod(argv[++i], nullptr);
+        }
+        else if (arg == "-n" && i + 1 < argc)
+        {
+            noise = std::strtod(argv[++i], nullptr);
+        }
+        else if (arg == "-r" && i + 1 < argc)
+        {
+            seed = static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else if (arg == "-t" && i + 1 < argc)
+        {
+            tracePath = argv[++i];
+        }
+        else if (arg == "-O" && i + 1 < argc)
+        {
+            overshootLimit = std::strtod(argv[++i], nullptr);
+        }
+        else if (arg == "-E" && i + 1 < argc)
+        {
+            errorLimit = std::strtod(argv[++i], nullptr);
+        }
+        else if (arg[0] != '-')
+        {
+            scenarioPath = arg;
+        }
+        else
+        {
+            std::cerr << "usage: thermal_sim [-c proportional|pid|autotune] [-k kp,ki,kd] [-d seconds] [-n sigma] [-r seed]\n"
+                         "                   [-t trace.csv] [-O overshoot] [-E error] [scenario.csv]\n";
+            return 1;
+        }
+    }
+
+    std::vector<ScenarioRow> scenario;
+    if (scenarioPath.empty())
+    {
+        scenario.push_back(ScenarioRow());
+    }
+    else if (!readScenario(scenarioPath, scenario))
+    {
+        return 1;
+    }
+    if (duration < 0.0)
+    {
+        duration = scenario.back().time + 1800.0;
+    }
+
+    std::ofstream trace;
+    if (!tracePath.empty())
+    {
+        trace.open(tracePath);
+        if (!trace)
+        {
+            std::cerr << "thermal_sim: cannot write " << tracePath << "\n";
+            return 1;
+        }
+        trace << "time_s,ambient_c,setpoint_c,seat_c,heater_c,reading_c,duty_percent\n";
+    }
+
+    Settings_Init(&kDefaultSeat);
+    HeaterRule rule;
+
+    SeatThermalPlant plant(SeatParameters(), scenario.front().ambient, seed);
+    plant.setNoise(noise);
+    attachAdcChannel(SENSOR0_CHANNEL_ID, &plant);
+
+    Pid_StateType pid;
+    Pid_AutoTuneType tune;
+    Pid_Init(&pid, PID_Q16(kp), PID_Q16(ki), PID_Q16(kd), 0, PID_INT_TO_Q16(kDutyMax));
+    Pid_AutoTuneStart(&tune, 0, PID_INT_TO_Q16(kDutyMax), PID_INT_TO_Q16(1));
+    if (controller != Controller::AutoTune)
+    {
+        tune.eStatus = PID_AUTOTUNE_DONE;
+    }
+
+    std::vector<Segment> segments;
+    std::size_t row = 0;
+    int reading = 0;
+    int duty = 0;
+    unsigned long dutyWrites = 0;
+    const long ticks = static_cast<long>(duration * 1000.0) / kTickMs;
+
+    const auto wallStart = std::chrono::steady_clock::now();
+
+    for (long tick = 0; tick < ticks; ++tick)
+    {
+        const long ms = tick * kTickMs;
+        const double now = ms / 1000.0;
+
+        while (row + 1 < scenario.size() && scenario[row + 1].time <= now)
+        {
+            ++row;
+        }
+        const ScenarioRow &input = scenario[row];
+
+        if (segments.empty() || segments.back().setpoint != input.setpoint)
+        {
+            Segment segment;
+            segment.setpoint = input.setpoint;
+            segment.start = now;
+            segment.heatingUp = plant.seatTemperature() < input.setpoint;
+            segments.push_back(segment);
+        }
+
+        /* Sensor task */
+        if (ms % kSensorPeriodMs == 0)
+        {
+            reading = LM35_getTemperature(SENSOR0_CHANNEL_ID);
+        }
+
+        /* Heater task: the sensor range check of main.c turns the heater off */
+        if (ms % kHeaterPeriodMs == 0)
+        {
+            const bool error = (reading > kTempMaxValid) || (reading < kTempMinValid);
+            int newDuty = 0;
+
+            if (input.setpoint == 0 || error)
+            {
+                rule.disable(ms);
+                Pid_Reset(&pid, PID_INT_TO_Q16(reading));
+                if (tune.eStatus == PID_AUTOTUNE_RUNNING)
+                {
+                    Pid_AutoTuneStart(&tune, tune.lOutputLow, tune.lOutputHigh, tune.lHysteresis);
+                }
+            }
+            else if (controller == Controller::Proportional)
+            {
+                newDuty = rule.duty(input.setpoint, reading, ms);
+            }
+            else if (tune.eStatus == PID_AUTOTUNE_RUNNING)
+            {
+                newDuty = PID_Q16_TO_INT(Pid_AutoTuneStep(&tune, PID_INT_TO_Q16(input.setpoint), PID_INT_TO_Q16(reading)));
+                if (tune.eStatus != PID_AUTOTUNE_RUNNING)
+                {
+                    const bool applied = Pid_AutoTuneApply(&tune, &pid) == E_OK;
+                    std::cout << "auto-tune " << (applied ? "done" : "failed") << " at " << now << " s: kp " << pid.lKp / 65536.0
+                              << " ki " << pid.lKi / 65536.0 << " kd " << pid.lKd / 65536.0 << "\n";
+                    Pid_Reset(&pid, PID_INT_TO_Q16(reading));
+                }
+            }
+            else
+            {
+                newDuty = PID_Q16_TO_INT(Pid_Update(&pid, PID_INT_TO_Q16(input.setpoint), PID_INT_TO_Q16(reading)));
+            }
+
+            if (newDuty != duty)
+            {
+                duty = newDuty;
+                ++dutyWrites;
+            }
+        }
+
+        plant.step(kTickMs / 1000.0, duty, input.ambient, input.occupant);
+
+        /* Once per simulated second: statistics and trace */
+        if (ms % 1000 == 0)
+        {
+            Segment &segment = segments.back();
+            const double seat = plant.seatTemperature();
+            if (segment.setpoint != 0)
+            {
+                segment.errors.push_back(std::fabs(seat - segment.setpoint));
+                if (segment.settleTime < 0.0 && seat >= segment.setpoint - 1.0)
+                {
+                    segment.settleTime = now - segment.start;
+                }
+                if (segment.settleTime >= 0.0)
+                {
+                    segment.peak = std::max(segment.peak, seat);
+                }
+            }
+
+            if (trace)
+            {
+                trace << now << "," << input.ambient << "," << input.setpoint << "," << std::fixed << std::setprecision(3) << seat << ","
+                      << plant.heaterTemperature() << "," << std::defaultfloat << reading << "," << duty << "\n";
+            }
+        }
+    }
+
+    const double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+
+    double worstOvershoot = 0.0;
+    double worstError = 0.0;
+
+    std::cout << "segment  setpoint  settle s  overshoot  steady error\n";
+    for (const Segment &segment : segments)
+    {
+        if (segment.setpoint == 0)
+        {
+            continue;
+        }
+
+        std::cout << std::setw(7) << segment.start << "  " << std::setw(8) << segment.setpoint << "  ";
+        if (segment.settleTime >= 0.0)
+        {
+            std::cout << std::setw(8) << segment.settleTime;
+        }
+        else
+        {
+            std::cout << std::setw(8) << "-";
+        }
+
+        const double overshoot = (segment.heatingUp && segment.settleTime >= 0.0) ? std::max(0.0, segment.peak - segment.setpoint) : 0.0;
+        worstOvershoot = std::max(worstOvershoot, overshoot);
+        std::cout << "  " << std::setw(9) << std::fixed << std::setprecision(2) << overshoot;
+
+        if (segment.errors.size() >= kSteadyAfter)
+        {
+            const std::size_t window = static_cast<std::size_t>(kSteadyWindow);
+            double sum = 0.0;
+            for (std::size_t i = segment.errors.size() - window; i < segment.errors.size(); ++i)
+            {
+                sum += segment.errors[i];
+            }
+            const double steady = sum / window;
+            worstError = std::max(worstError, steady);
+            std::cout << "  " << std::setw(12) << steady;
+        }
+        else
+        {
+            std::cout << "  " << std::setw(12) << "-";
+        }
+        std::cout << std::defaultfloat << std::setprecision(6) << "\n";
+    }
+
+    std::cout << "heater energy " << std::fixed << std::setprecision(1) << plant.energy() / 3600.0 << " Wh, " << dutyWrites
+              << " duty changes\n";
+    std::cout << "simulated " << std::setprecision(0) << duration << " s in " << std::setprecision(2) << wallSeconds * 1000.0 << " ms ("
+              << std::setprecision(0) << duration / std::max(wallSeconds, 1e-9) << "x real time)\n";
+
+    const bool pass = worstOvershoot <= overshootLimit && worstError <= errorLimit;
+    if (!pass)
+    {
+        std::cout << "FAIL: overshoot " << std::setprecision(2) << worstOvershoot << " (limit " << overshootLimit << "), steady error "
+                  << worstError << " (limit " << errorLimit << ")\n";
+    }
+    return pass ? 0 : 2;
+}
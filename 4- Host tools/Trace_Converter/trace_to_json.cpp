@@ -0,0 +1,764 @@
+/*
+ ============================================================================
+ Name        : trace_to_json.cpp
+ Module Name : Trace Converter
+ Description : Converts the kernel event trace of the firmware (Control/Trace.c, built with
+               TRACE_RECORDER = 1) to the Chrome trace event JSON format, opened by
+               ui.perfetto.dev and chrome://tracing. Two modes:
+               - Default: reads a UART capture of the "trace dump" reply (the names, then the
+                 binary records) and writes one track per task with its running slices, one
+                 track per ISR, and instant events for the task ready, delay and notification
+                 events and for the queue, semaphore and mutex operations (a mutex receive is
+                 a take, a send a give), on the track of the task or ISR that ran them. With
+                 the deadline monitor of main.c, one more track per periodic job shows its
+                 jobs from start to completion and its deadline misses. The heater input changes
+                 and heater output writes are instant events of the task that recorded them.
+               - -g: self test of the recorder and of the converter. A synthetic schedule is
+                 recorded by the firmware Trace module with a host cycle counter, sent through
+                 the dump format and decoded again: every decoded record must have the event,
+                 the object and the time (to the time unit) it was recorded with, including
+                 the long gaps and the records overwritten by a full buffer. A gap of 12 s
+                 before the last 100 events takes the times over 10^7 us. Every "ts" and "dur"
+                 of its JSON must give the time of a decoded event, then the JSON is written
+                 like a capture.
+
+ Build       : FW="../../1- Application project/FreeRTOS_Final_Project_WS/Seat_Heater_Control_System"
+               INC=(-I"$FW/Common" -I"$FW/Control")
+               gcc -O2 -DTRACE_HOST -DTRACE_RECORDER=1 "${INC[@]}" -c "$FW/Control/Trace.c"
+               g++ -std=c++17 -O2 -DTRACE_RECORDER=1 "${INC[@]}" -o trace_to_json trace_to_json.cpp Trace.o
+ Usage       : trace_to_json [options] [capture]
+               -o <file>         JSON output file, default standard output.
+               -g [<events>]     Self test with a synthetic schedule of <events> events, default 3000
+                                 (more than the buffer, so the oldest records are overwritten).
+               -s <seed>         Seed of the synthetic schedule, default 1.
+
+ Exit status : 0, 2 when the self test decodes a record differently, 1 on input errors.
+ ============================================================================
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <random>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+extern "C"
+{
+#include "Std_Types.h"
+#include "Trace.h"
+
+uint32 Trace_HostCycles(void);
+}
+
+namespace
+{
+
+/* Kernel queue types (queueQUEUE_TYPE_... of queue.h) */
+constexpr int kQueueTypeBase = 0;
+constexpr int kQueueTypeMutex = 1;
+constexpr int kQueueTypeRecursiveMutex = 4;
+
+/* Track ids of the JSON, the tasks use their tag */
+constexpr int kIsrTrackBase = 1000;
+constexpr int kKernelTrack = 999;
+constexpr int kJobTrackBase = 2000;
+
+struct QueueInfo
+{
+    int type = kQueueTypeBase;
+    std::string name;
+};
+
+struct Record
+{
+    std::uint16_t delta = 0;
+    std::uint8_t event = 0;
+    std::uint8_t object = 0;
+};
+
+/* A "trace dump" reply */
+struct Dump
+{
+    unsigned long lost = 0;
+    unsigned long cpuHz = 16000000UL;
+    unsigned shift = TRACE_TIME_SHIFT;
+    std::map<int, std::string> tasks;
+    std::map<int, QueueInfo> queues;
+    std::map<int, std::string> isrs;
+    std::map<int, std::string> jobs;
+    std::vector<Record> records;
+};
+
+/* A decoded record, its time in units since "trace start" (since the oldest record when records were lost) */
+struct Event
+{
+    unsigned long long time = 0;
+    int event = 0;
+    int object = 0;
+};
+
+/* Cycle counter of the self test, read by the Trace module */
+std::uint32_t hostCycles = 0;
+
+std::vector<std::string> splitFields(const std::string &line)
+{
+    std::vector<std::string> fields;
+    std::stringstream ss(line);
+    std::string field;
+    while (std::getline(ss, field, ','))
+    {
+        fields.push_back(field);
+    }
+    return fields;
+}
+
+/* Reads the line starting at pos, without its end of line, and moves pos after it */
+bool nextLine(const std::string &data, std::size_t &pos, std::string &line)
+{
+    if (pos >= data.size())
+    {
+        return false;
+    }
+    std::size_t end = data.find('\n', pos);
+    if (end == std::string::npos)
+    {
+        end = data.size();
+    }
+    line = data.substr(pos, end - pos);
+    if (!line.empty() && (line.back() == '\r'))
+    {
+        line.pop_back();
+    }
+    pos = end + 1;
+    return true;
+}
+
+bool parseDump(const std::string &data, Dump &dump)
+{
+    std::size_t pos = data.find("TRACE,DUMP,");
+    std::string line;
+    unsigned long count = 0;
+
+    if (pos == std::string::npos)
+    {
+        std::cerr << "No \"TRACE,DUMP\" line in the capture\n";
+        return false;
+    }
+    nextLine(data, pos, line);
+    std::vector<std::string> fields = splitFields(line);
+    if (fields.size() < 6)
+    {
+        std::cerr << "Bad line: " << line << "\n";
+        return false;
+    }
+    dump.lost = std::stoul(fields[3]);
+    dump.cpuHz = std::stoul(fields[4]);
+    dump.shift = static_cast<unsigned>(std::stoul(fields[5]));
+
+    for (;;)
+    {
+        if (!nextLine(data, pos, line))
+        {
+            std::cerr << "No \"TRACE,DATA\" line in the capture\n";
+            return false;
+        }
+        fields = splitFields(line);
+        if ((fields.size() >= 4) && (fields[1] == "TASK"))
+        {
+            dump.tasks[std::stoi(fields[2])] = fields[3];
+        }
+        else if ((fields.size() >= 4) && (fields[1] == "QUEUE"))
+        {
+            QueueInfo &queue = dump.queues[std::stoi(fields[2])];
+            queue.type = std::stoi(fields[3]);
+            queue.name = (fields.size() >= 5) ? fields[4] : std::string();
+        }
+        else if ((fields.size() >= 4) && (fields[1] == "ISR"))
+        {
+            dump.isrs[std::stoi(fields[2])] = fields[3];
+        }
+        else if ((fields.size() >= 4) && (fields[1] == "JOB"))
+        {
+            dump.jobs[std::stoi(fields[2])] = fields[3];
+        }
+        else if ((fields.size() >= 3) && (fields[1] == "DATA"))
+        {
+            count = std::stoul(fields[2]);
+            break;
+        }
+    }
+
+    if (data.size() - pos < count * 4UL)
+    {
+        std::cerr << "Capture ends after " << (data.size() - pos) / 4 << " of " << count << " records\n";
+        return false;
+    }
+    for (unsigned long i = 0; i < count; i++, pos += 4)
+    {
+        Record record;
+        record.delta = static_cast<std::uint16_t>(static_cast<unsigned char>(data[pos]) |
+                                                  (static_cast<unsigned char>(data[pos + 1]) << 8));
+        record.event = static_cast<std::uint8_t>(data[pos + 2]);
+        record.object = static_cast<std::uint8_t>(data[pos + 3]);
+        dump.records.push_back(record);
+    }
+    if (data.compare(pos, 9, "TRACE,END") != 0)
+    {
+        std::cerr << "Warning: no \"TRACE,END\" after the records\n";
+    }
+    return true;
+}
+
+/*
+ * Times of the records, from "trace start". When records were overwritten the delta of the oldest one
+ * is from a record that is gone, so the oldest event is the time origin.
+ */
+std::vector<Event> decode(const Dump &dump)
+{
+    std::vector<Event> events;
+    unsigned long long time = 0;
+    bool first = true;
+
+    for (const Record &record : dump.records)
+    {
+        if (record.event == TRACE_EVENT_TIME)
+        {
+            if (!first || (dump.lost == 0))
+            {
+                time += static_cast<unsigned long long>(record.delta) << 16;
+            }
+            continue;
+        }
+        if (!first || (dump.lost == 0))
+        {
+            time += record.delta;
+        }
+        first = false;
+        events.push_back({ time, record.event, record.object });
+    }
+    return events;
+}
+
+std::string jsonString(const std::string &text)
+{
+    std::string out = "\"";
+    for (char c : text)
+    {
+        if ((c == '"') || (c == '\\'))
+        {
+            out += '\\';
+        }
+        out += ((static_cast<unsigned char>(c) < 0x20) ? ' ' : c);
+    }
+    return out + "\"";
+}
+
+std::string taskName(const Dump &dump, int tag)
+{
+    const auto it = dump.tasks.find(tag);
+    return (it == dump.tasks.end()) ? ("Task " + std::to_string(tag)) : it->second;
+}
+
+std::string queueName(const Dump &dump, int number)
+{
+    const auto it = dump.queues.find(number);
+    return ((it == dump.queues.end()) || it->second.name.empty()) ? ("Queue " + std::to_string(number)) : it->second.name;
+}
+
+/* Seat number of the heater events (Settings.h) */
+std::string seatName(int seat)
+{
+    return (seat == 0) ? "driver" : ((seat == 1) ? "passenger" : ("seat " + std::to_string(seat)));
+}
+
+/* Name of a queue operation, in the words of the object type */
+std::string queueOperation(const Dump &dump, int event, int number)
+{
+    const auto it = dump.queues.find(number);
+    const int type = (it == dump.queues.end()) ? kQueueTypeBase : it->second.type;
+    const bool mutex = (type == kQueueTypeMutex) || (type == kQueueTypeRecursiveMutex);
+    const bool semaphore = (type != kQueueTypeBase);
+    const std::string send = semaphore ? "give" : "send";
+    const std::string receive = semaphore ? "take" : "receive";
+    std::string operation;
+
+    switch (event)
+    {
+    case TRACE_EVENT_QUEUE_SEND: operation = send; break;
+    case TRACE_EVENT_QUEUE_SEND_FAILED: operation = send + " failed"; break;
+    case TRACE_EVENT_QUEUE_RECEIVE: operation = receive; break;
+    case TRACE_EVENT_QUEUE_RECEIVE_FAILED: operation = receive + " failed"; break;
+    case TRACE_EVENT_QUEUE_BLOCK_SEND: operation = "block on " + send; break;
+    default: operation = "block on " + receive; break;
+    }
+    return (mutex ? "mutex " : (semaphore ? "semaphore " : "queue ")) + operation + " " + queueName(dump, number);
+}
+
+class JsonWriter
+{
+public:
+    JsonWriter(std::ostream &out, double usPerUnit) : out_(out), usPerUnit_(usPerUnit)
+    {
+        /* Fixed notation: the default 6 significant digits round the times of a trace over 10 s */
+        out_ << std::fixed << std::setprecision(3);
+        out_ << "{\"traceEvents\":[\n";
+    }
+
+    void process(const std::string &name)
+    {
+        separator();
+        out_ << "{\"ph\":\"M\",\"pid\":1,\"name\":\"process_name\",\"args\":{\"name\":" << jsonString(name) << "}}";
+    }
+
+    void metadata(int tid, const std::string &name, int sortIndex)
+    {
+        separator();
+        out_ << "{\"ph\":\"M\",\"pid\":1,\"tid\":" << tid << ",\"name\":\"thread_name\",\"args\":{\"name\":"
+             << jsonString(name) << "}},\n";
+        out_ << "{\"ph\":\"M\",\"pid\":1,\"tid\":" << tid << ",\"name\":\"thread_sort_index\",\"args\":{\"sort_index\":"
+             << sortIndex << "}}";
+    }
+
+    void slice(int tid, const std::string &name, unsigned long long start, unsigned long long end)
+    {
+        separator();
+        out_ << "{\"ph\":\"X\",\"pid\":1,\"tid\":" << tid << ",\"name\":" << jsonString(name) << ",\"ts\":"
+             << start * usPerUnit_ << ",\"dur\":" << (end - start) * usPerUnit_ << "}";
+    }
+
+    void instant(int tid, const std::string &name, unsigned long long time)
+    {
+        separator();
+        out_ << "{\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":" << tid << ",\"name\":" << jsonString(name)
+             << ",\"ts\":" << time * usPerUnit_ << "}";
+    }
+
+    void finish(const Dump &dump)
+    {
+        out_ << "\n],\"displayTimeUnit\":\"ms\",\"otherData\":{\"records\":" << dump.records.size()
+             << ",\"lost\":" << dump.lost << "}}\n";
+    }
+
+private:
+    void separator()
+    {
+        if (!first_)
+        {
+            out_ << ",\n";
+        }
+        first_ = false;
+    }
+
+    std::ostream &out_;
+    double usPerUnit_;
+    bool first_ = true;
+};
+
+void writeJson(std::ostream &out, const Dump &dump, const std::vector<Event> &events)
+{
+    JsonWriter json(out, static_cast<double>(1UL << dump.shift) * 1e6 / static_cast<double>(dump.cpuHz));
+    std::map<int, std::vector<unsigned long long>> isrEnter; /* Nesting of each ISR */
+    std::vector<int> isrStack; /* ISR tracks, the innermost last */
+    std::map<int, unsigned long long> jobStart; /* Start of the running job of each periodic job */
+    int running = -1;
+    unsigned long long runningSince = 0;
+    unsigned long long end = events.empty() ? 0 : events.back().time;
+
+    json.process("Seat heater");
+    for (const auto &task : dump.tasks)
+    {
+        json.metadata(task.first, task.second, task.first);
+    }
+    for (const auto &isr : dump.isrs)
+    {
+        json.metadata(kIsrTrackBase + isr.first, "ISR " + isr.second, kIsrTrackBase + isr.first);
+    }
+    json.metadata(kKernelTrack, "Kernel ticks", kKernelTrack);
+    for (const auto &job : dump.jobs)
+    {
+        if (!job.second.empty())
+        {
+            json.metadata(kJobTrackBase + job.first, "Job " + job.second, kJobTrackBase + job.first);
+        }
+    }
+
+    for (const Event &event : events)
+    {
+        /* The instant events go to the ISR or task that ran them */
+        const int context = isrStack.empty() ? running : isrStack.back();
+
+        switch (event.event)
+        {
+        case TRACE_EVENT_TASK_SWITCHED_IN:
+            if (running >= 0)
+            {
+                json.slice(running, taskName(dump, running), runningSince, event.time);
+            }
+            running = event.object;
+            runningSince = event.time;
+            break;
+        case TRACE_EVENT_ISR_ENTER:
+            isrEnter[event.object].push_back(event.time);
+            isrStack.push_back(kIsrTrackBase + event.object);
+            break;
+        case TRACE_EVENT_ISR_EXIT:
+            if (!isrEnter[event.object].empty())
+            {
+                const auto it = dump.isrs.find(event.object);
+                json.slice(kIsrTrackBase + event.object, (it == dump.isrs.end()) ? ("IRQ " + std::to_string(event.object)) : it->second,
+                           isrEnter[event.object].back(), event.time);
+                isrEnter[event.object].pop_back();
+                isrStack.pop_back();
+            }
+            break;
+        case TRACE_EVENT_TASK_READY:
+            json.instant(event.object, "ready", event.time);
+            break;
+        case TRACE_EVENT_TASK_DELAY:
+            json.instant(event.object, "delay", event.time);
+            break;
+        case TRACE_EVENT_TASK_NOTIFY_WAIT:
+            json.instant(event.object, "wait for notification", event.time);
+            break;
+        case TRACE_EVENT_TASK_NOTIFY:
+            json.instant(context, "notify " + taskName(dump, event.object), event.time);
+            break;
+        case TRACE_EVENT_PRIORITY_INHERIT:
+            json.instant(event.object, "priority inherited", event.time);
+            break;
+        case TRACE_EVENT_PRIORITY_DISINHERIT:
+            json.instant(event.object, "priority disinherited", event.time);
+            break;
+        case TRACE_EVENT_TICK:
+            json.instant(kKernelTrack, "tick", event.time);
+            break;
+        case TRACE_EVENT_JOB_START:
+            jobStart[event.object] = event.time;
+            break;
+        case TRACE_EVENT_JOB_END:
+            if (jobStart.count(event.object) != 0)
+            {
+                const auto it = dump.jobs.find(event.object);
+                json.slice(kJobTrackBase + event.object, (it == dump.jobs.end()) ? ("Job " + std::to_string(event.object)) : it->second,
+                           jobStart[event.object], event.time);
+                jobStart.erase(event.object);
+            }
+            break;
+        case TRACE_EVENT_DEADLINE_MISS:
+            json.instant(kJobTrackBase + event.object, "deadline miss", event.time);
+            break;
+        case TRACE_EVENT_HEATER_INPUT:
+            json.instant(context, "heater input " + seatName(event.object), event.time);
+            break;
+        case TRACE_EVENT_HEATER_OUTPUT:
+            json.instant(context, "heater output " + seatName(event.object), event.time);
+            break;
+        default:
+            if ((event.event >= static_cast<int>(TRACE_EVENT_QUEUE_SEND)) && (event.event <= static_cast<int>(TRACE_EVENT_QUEUE_BLOCK_RECEIVE)))
+            {
+                json.instant(context, queueOperation(dump, event.event, event.object), event.time);
+            }
+            break;
+        }
+    }
+    if (running >= 0)
+    {
+        json.slice(running, taskName(dump, running), runningSince, end);
+    }
+    json.finish(dump);
+}
+
+/*-------------------------------------------------------------------------------------------------------------------------------------*/
+
+/* Reply of "trace dump" for the records of the Trace module, as main.c sends it */
+std::string hostDump(const std::map<int, std::string> &tasks, const std::map<int, std::string> &isrs)
+{
+    std::ostringstream out;
+    Trace_RecordType record;
+    const char *name = nullptr;
+    uint32 lost = 0;
+    uint8 type = 0;
+    const uint16 count = Trace_Count(&lost);
+
+    out << "TRACE,DUMP," << count << "," << lost << ",16000000," << TRACE_TIME_SHIFT << "\r\n";
+    for (const auto &task : tasks)
+    {
+        out << "TRACE,TASK," << task.first << "," << task.second << "\r\n";
+    }
+    for (uint8 queue = 1; Trace_QueueInfo(queue, &type, &name) == E_OK; queue++)
+    {
+        out << "TRACE,QUEUE," << static_cast<int>(queue) << "," << static_cast<int>(type) << "," << ((name != nullptr) ? name : "") << "\r\n";
+    }
+    for (const auto &isr : isrs)
+    {
+        out << "TRACE,ISR," << isr.first << "," << isr.second << "\r\n";
+    }
+    out << "TRACE,DATA," << count << "\r\n";
+    for (uint16 i = 0; Trace_Read(i, &record) == E_OK; i++)
+    {
+        out << static_cast<char>(record.usDelta & 0xFFU) << static_cast<char>(record.usDelta >> 8)
+            << static_cast<char>(record.ucEvent) << static_cast<char>(record.ucObject);
+    }
+    out << "TRACE,END\r\n";
+    return out.str();
+}
+
+/*
+ * Every "ts" of the JSON, and "ts" plus "dur" of a slice, must be the time of a decoded event to the
+ * microsecond digits written. Returns the errors.
+ */
+int checkJsonTimes(const std::string &json, const Dump &dump, const std::vector<Event> &events)
+{
+    const double usPerUnit = static_cast<double>(1UL << dump.shift) * 1e6 / static_cast<double>(dump.cpuHz);
+    std::set<unsigned long long> times;
+    double latest = 0.0;
+    unsigned long stamps = 0;
+    int errors = 0;
+
+    for (const Event &event : events)
+    {
+        times.insert(event.time);
+    }
+    auto known = [&](double us)
+    {
+        const unsigned long long time = static_cast<unsigned long long>(std::llround(us / usPerUnit));
+        return (times.count(time) != 0) && (std::fabs(static_cast<double>(time) * usPerUnit - us) < 0.002);
+    };
+
+    for (std::size_t at = json.find("\"ts\":"); at != std::string::npos; at = json.find("\"ts\":", at + 1))
+    {
+        char *next = nullptr;
+        const double ts = std::strtod(json.c_str() + at + 5, &next);
+        bool ok = known(ts);
+        if (std::string(next, 7) == ",\"dur\":")
+        {
+            ok = ok && known(ts + std::strtod(next + 7, nullptr));
+        }
+        if (!ok && (errors++ < 5))
+        {
+            std::cerr << "Self test: JSON time " << json.substr(at, json.find('}', at) - at) << " is not the time of an event\n";
+        }
+        latest = std::max(latest, ts);
+        stamps++;
+    }
+    if (latest < 1e7)
+    {
+        std::cerr << "Self test: the JSON times end at " << latest << " us, below 10^7 us\n";
+        errors++;
+    }
+    std::cerr << "Self test: " << stamps << " JSON times checked, up to " << std::fixed << std::setprecision(0) << latest
+              << " us\n" << std::defaultfloat;
+    return errors;
+}
+
+/*
+ * Records a synthetic schedule: three tasks and the idle task switching, a UART ISR sending to the
+ * console queue, the tasks taking and giving a mutex, and now and then a gap longer than a record
+ * delta. Returns the records and their cycle counts, to be compared with the decoded dump.
+ */
+int selfTest(unsigned long eventCount, unsigned seed, Dump &dump, std::vector<Event> &events)
+{
+    std::mt19937 random(seed);
+    std::vector<std::pair<std::uint32_t, Event>> expected;
+    const std::map<int, std::string> tasks = { { 1, "Driver Sensor" }, { 2, "Driver Heater" }, { 9, "Display" }, { 14, "IDLE" } };
+    const std::map<int, std::string> isrs = { { 5, "UART0" } };
+    const int taskTags[] = { 1, 2, 9, 14 };
+    std::uint32_t start;
+    int errors = 0;
+
+    const uint8 mutex = Trace_QueueCreated(static_cast<uint8>(kQueueTypeMutex));
+    Trace_QueueName(mutex, "xEepromMutex");
+    const uint8 queue = Trace_QueueCreated(static_cast<uint8>(kQueueTypeBase));
+    Trace_QueueName(queue, "xConsoleRxQueue");
+
+    hostCycles = 0xFFF00000UL; /* The cycle counter wraps during the run */
+    Trace_Start();
+    start = hostCycles;
+
+    for (unsigned long i = 0; i < eventCount; i++)
+    {
+        Event event;
+
+        /* Mostly short steps, some over 65536 time units, and one of 12 s near the end */
+        hostCycles += ((random() % 50) == 0) ? (2000000UL + random() % 20000000UL) : (random() % 4000UL);
+        if ((i + 100U) == eventCount)
+        {
+            hostCycles += 12U * 16000000UL;
+        }
+        switch (random() % 6)
+        {
+        case 0: event = { 0, TRACE_EVENT_TASK_SWITCHED_IN, taskTags[random() % 4] }; break;
+        case 1: event = { 0, TRACE_EVENT_TASK_READY, taskTags[random() % 3] }; break;
+        case 2: event = { 0, TRACE_EVENT_QUEUE_RECEIVE, mutex }; break;
+        case 3: event = { 0, TRACE_EVENT_QUEUE_SEND, mutex }; break;
+        case 4: event = { 0, TRACE_EVENT_ISR_ENTER, 5 }; break;
+        default: event = { 0, TRACE_EVENT_QUEUE_BLOCK_RECEIVE, queue }; break;
+        }
+        Trace_Record(static_cast<uint8>(event.event), static_cast<uint8>(event.object));
+        expected.push_back({ hostCycles, event });
+
+        if (event.event == TRACE_EVENT_ISR_ENTER)
+        {
+            hostCycles += 200U + random() % 300U;
+            Trace_Record(TRACE_EVENT_QUEUE_SEND, queue);
+            expected.push_back({ hostCycles, { 0, TRACE_EVENT_QUEUE_SEND, queue } });
+            hostCycles += 100U;
+            Trace_Record(TRACE_EVENT_ISR_EXIT, 5);
+            expected.push_back({ hostCycles, { 0, TRACE_EVENT_ISR_EXIT, 5 } });
+        }
+    }
+    Trace_Stop();
+    Trace_Record(TRACE_EVENT_TICK, 0); /* Not recorded once stopped */
+
+    if (!parseDump(hostDump(tasks, isrs), dump))
+    {
+        return 1;
+    }
+    events = decode(dump);
+    if (events.size() > expected.size())
+    {
+        std::cerr << "Self test: " << events.size() << " records decoded for " << expected.size() << " recorded\n";
+        return 1;
+    }
+
+    /* The buffer keeps the newest records, the time origin is the oldest one once records were lost */
+    const std::size_t first = expected.size() - events.size();
+    const unsigned long long origin = (dump.lost == 0) ? 0 : (((expected[first].first - start) & 0xFFFFFFFFUL) >> TRACE_TIME_SHIFT);
+    for (std::size_t i = 0; i < events.size(); i++)
+    {
+        const Event &want = expected[first + i].second;
+        const unsigned long long time = (((expected[first + i].first - start) & 0xFFFFFFFFUL) >> TRACE_TIME_SHIFT) - origin;
+        if ((events[i].event != want.event) || (events[i].object != want.object) || (events[i].time != time))
+        {
+            if (errors++ < 5)
+            {
+                std::cerr << "Self test: record " << i << " decoded as " << events[i].event << "," << events[i].object
+                          << " at " << events[i].time << ", recorded as " << want.event << "," << want.object << " at "
+                          << time << "\n";
+            }
+        }
+    }
+
+    std::ostringstream json;
+    writeJson(json, dump, events);
+    errors += checkJsonTimes(json.str(), dump, events);
+
+    std::cerr << "Self test: " << expected.size() << " events recorded, " << dump.records.size() << " records kept ("
+              << dump.lost << " overwritten), " << events.size() << " events decoded, " << errors << " errors\n";
+    return (errors == 0) ? 0 : 2;
+}
+
+void usage()
+{
+    std::cerr << "Usage: trace_to_json [-o <file>] [-g [<events>]] [-s <seed>] [capture]\n";
+}
+
+} /* namespace */
+
+uint32 Trace_HostCycles(void)
+{
+    return hostCycles;
+}
+
+int main(int argc, char *argv[])
+{
+    std::string outputPath;
+    std::string inputPath;
+    bool test = false;
+    unsigned long testEvents = 3000;
+    unsigned seed = 1;
+    Dump dump;
+    std::vector<Event> events;
+    int status = 0;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const std::string arg = argv[i];
+        if ((arg == "-o") && (i + 1 < argc))
+        {
+            outputPath = argv[++i];
+        }
+        else if (arg == "-g")
+        {
+            test = true;
+            if ((i + 1 < argc) && (argv[i + 1][0] != '-'))
+            {
+                testEvents = std::strtoul(argv[++i], nullptr, 10);
+            }
+        }
+        else if ((arg == "-s") && (i + 1 < argc))
+        {
+            seed = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else if ((arg[0] != '-') && inputPath.empty())
+        {
+            inputPath = arg;
+        }
+        else
+        {
+            usage();
+            return 1;
+        }
+    }
+
+    if (test)
+    {
+        status = selfTest(testEvents, seed, dump, events);
+        if (status == 1)
+        {
+            return 1;
+        }
+    }
+    else
+    {
+        std::string data;
+        if (inputPath.empty())
+        {
+            std::cin >> std::noskipws;
+            data.assign(std::istreambuf_iterator<char>(std::cin), std::istreambuf_iterator<char>());
+        }
+        else
+        {
+            std::ifstream file(inputPath, std::ios::binary);
+            if (!file)
+            {
+                std::cerr << "Cannot open " << inputPath << "\n";
+                return 1;
+            }
+            data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        }
+        if (!parseDump(data, dump))
+        {
+            return 1;
+        }
+        events = decode(dump);
+        std::cerr << dump.records.size() << " records (" << dump.lost << " overwritten), "
+                  << (events.empty() ? 0.0 : static_cast<double>(events.back().time << dump.shift) * 1e3 / dump.cpuHz)
+                  << " ms\n";
+    }
+
+    if (outputPath.empty())
+    {
+        writeJson(std::cout, dump, events);
+    }
+    else
+    {
+        std::ofstream file(outputPath);
+        if (!file)
+        {
+            std::cerr << "Cannot write " << outputPath << "\n";
+            return 1;
+        }
+        writeJson(file, dump, events);
+    }
+    return status;
+}